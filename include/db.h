@@ -106,6 +106,8 @@
 #define DB_MAX_FIELDS      16
 /* Maximum field name length in schema */
 #define DB_MAX_FIELDNAME   8
+/* Key characters kept in an index (db_index_build) */
+#define DB_KEY_MAX         12
 
 /* =============================================================================
  * Error Codes
@@ -448,6 +450,93 @@ int db_field_count(void);
  */
 int db_recsize(void);
 
+/* =============================================================================
+ * Batched Record I/O
+ * =============================================================================
+ * These functions move many records per call through a caller-supplied
+ * block. A block holds records back to back as they are kept on a pack:
+ * a length byte followed by the record text (TAB-delimited fields).
+ * Selecting the pack and checking the file happen once per block rather
+ * than once per record.
+ *
+ * Workflow (reading):
+ *   1. db_first()                    - Position at the first record
+ *   2. n = db_read_block(buf, size)  - Read up to a buffer full
+ *   3. p += db_load_rec(buf + p)     - Make each record current in turn
+ *   4. db_get_xxx(...)               - Extract field values
+ */
+
+/*
+ * db_read_block - Read records into a block
+ *
+ * Reads records from the current position until the file ends or the
+ * next record does not fit, and leaves the position after the last
+ * record read, as db_next would. Call it again to read the next block.
+ * The record loaded by db_read() is discarded.
+ *
+ * Parameters:
+ *   buffer - Destination block
+ *   size   - Size of the block in bytes
+ *
+ * Returns:
+ *   Number of records read. db_error() is DB_ERR_EOF once the file has
+ *   ended, and DB_ERR_OVERFLOW if the next record is larger than the
+ *   whole block.
+ *
+ * Example:
+ *   char block[256];
+ *   int n, p;
+ *   db_first();
+ *   while ((n = db_read_block(block, 256)) > 0) {
+ *       for (p = 0; n > 0; n--) {
+ *           p += db_load_rec(block + p);
+ *           total += db_get_int("age");
+ *       }
+ *   }
+ */
+int db_read_block(char *buffer, int size);
+
+/*
+ * db_append_many - Append the records of a block
+ *
+ * Parameters:
+ *   buffer - Block of records (length byte followed by text)
+ *   count  - Number of records in the block
+ *
+ * Returns:
+ *   Number of records written. If less than count, db_error() tells why
+ *   (DB_ERR_INVALID for a zero-length record).
+ */
+int db_append_many(char *buffer, int count);
+
+/*
+ * db_load_rec - Make a record from a block the current record
+ *
+ * Copies the record into the record buffer and splits it into fields,
+ * as db_read() does, so db_get_xxx() can be used on it.
+ *
+ * Parameters:
+ *   rec - Record in a block (length byte followed by text)
+ *
+ * Returns:
+ *   Bytes the record takes in the block; add it to reach the next one.
+ */
+int db_load_rec(char *rec);
+
+/*
+ * db_store_rec - Copy the current record into a block
+ *
+ * Stores the record built with db_set_xxx() (or loaded by db_read())
+ * in block form, to collect records for db_append_many().
+ *
+ * Parameters:
+ *   dest - Destination in the block (needs db_recsize() + 1 bytes)
+ *
+ * Returns:
+ *   Bytes stored; add it to reach the next free byte.
+ */
+int db_store_rec(char *dest);
+
 /* =============================================================================
  * Record Navigation Functions
  * =============================================================================
@@ -528,6 +617,77 @@ int db_count(void);
  */
 int db_pos(void);
 
+/* =============================================================================
+ * Key Index
+ * =============================================================================
+ * An index lists the records of a file sorted by one field, so that
+ * db_seek_key can find a record by that field without reading the whole
+ * file. It is kept on the pack as an ordinary data file of
+ * "key<TAB>record number" records, which OPL can read:
+ *
+ *   OPEN "A:CONTACT1", B, key$, rec%
+ *
+ * The index file of field n is named after the data file, its 8th
+ * character (if any) replaced by the field number ('1'-'9', then 'A'-'G'
+ * for fields 10-16): field 1 of CONTACTS is CONTACT1, of DATA is DATA1.
+ * Building an index replaces any file of that name.
+ *
+ * db_append, db_append_many, db_update and db_erase make the index out of
+ * date (erasing renumbers the records after it); the next db_seek_key
+ * rebuilds it. Make a batch of changes before looking records up again.
+ *
+ * Workflow:
+ *   1. db_index_build(db, 1)   - Index the first field
+ *   2. db_seek_key("Smith")    - Move to the record with that key
+ *   3. db_read()               - Load it
+ */
+
+/*
+ * db_index_build - Build the index of a field
+ *
+ * Reads the file and writes its index file. Only the first DB_KEY_MAX
+ * characters of each key are kept. The file is read once for every 16
+ * records, so building is slow on large files; db_seek_key is then fast.
+ * The record loaded by db_read() is discarded; the position is kept.
+ *
+ * Parameters:
+ *   handle - File handle from db_create() or db_open()
+ *   field  - Field to index (1-based)
+ *
+ * Returns:
+ *   DB_OK on success, DB_ERR_FIELD if field is not 1-16,
+ *   DB_ERR_INVALID if the index file would have the data file's name,
+ *   DB_ERR_FULL if the pack is full.
+ *
+ * Example:
+ *   db = db_open('A', "CONTACTS", "name$,phone$,age%");
+ *   db_index_build(db, 1);       // Writes A:CONTACT1
+ */
+int db_index_build(int handle, int field);
+
+/*
+ * db_seek_key - Move to the record with a key
+ *
+ * Looks the key up in the index built by db_index_build() and makes the
+ * first record whose indexed field starts with the same DB_KEY_MAX
+ * characters (is equal, for shorter keys) the current record. Use
+ * db_read() to load it. Rebuilds the index first if the records changed.
+ *
+ * Parameters:
+ *   key - Key to look for (null-terminated)
+ *
+ * Returns:
+ *   DB_OK if found, DB_ERR_NOT_FOUND if no record has the key (the
+ *   position is unchanged), DB_ERR_INVALID if no index was built.
+ *
+ * Example:
+ *   char phone[20];
+ *   if (db_seek_key("Smith") == DB_OK && db_read() == DB_OK) {
+ *       db_get_str("phone", phone, 20);
+ *   }
+ */
+int db_seek_key(char *key);
+
 /* =============================================================================
  * Record Modification Functions
  * =============================================================================
@@ -0,0 +1,134 @@
+/*
+ * =============================================================================
+ * Psion Organiser II Display Frame Buffer Header
+ * =============================================================================
+ *
+ * This header provides an off-screen frame buffer for Small-C programs on
+ * the Psion Organiser II. A program draws a whole screen into the frame,
+ * then fb_flush() puts on the display only the cells that changed since
+ * the last flush, with as few system calls as possible.
+ *
+ * USAGE:
+ *   #include <psion.h>       // Core functions (display, keyboard, etc.)
+ *   #include <fb.h>          // Frame buffer support (this file)
+ *
+ * The compiler will automatically include the necessary runtime code
+ * (fbruntime.inc) when fb.h is included.
+ *
+ * EXAMPLE:
+ *   void main() {
+ *       int i;
+ *       char buf[8];
+ *
+ *       cls();
+ *       for (i = 0; i < 100; i++) {
+ *           fb_begin();
+ *           fb_put(0, 0, "Counter:");
+ *           fb_put(9, 0, itoa(i, buf));
+ *           fb_put(0, 1, "Press a key");
+ *           fb_flush();             // Prints only the changed digits
+ *       }
+ *       getkey();
+ *   }
+ *
+ * HOW IT WORKS:
+ *   The frame holds DISP_ROWS x DISP_COLS characters (2x16 on the CM/XP,
+ *   4x20 on the LA/LZ). fb_flush() compares it with the frame it last put
+ *   on the display. Each run of changed cells costs one cursor move and
+ *   one print call; runs continue across row ends, so a full redraw is a
+ *   single print. Cells that did not change are not sent at all.
+ *
+ * SPEED:
+ *   Every display system call costs hundreds of cycles before it writes
+ *   a character. On an XP, redrawing a two-line status screen in which
+ *   one digit changed costs about 2800 cycles through the frame buffer
+ *   (1000 of them in fb_flush), against 8300 with two at() calls (see
+ *   docs/fb.md for measurements).
+ *
+ * MIXING WITH OTHER OUTPUT:
+ *   fb_flush() only knows what it printed itself. After cls(), print(),
+ *   at() or any other display output, call fb_invalidate() so that the
+ *   next flush redraws the whole screen.
+ *
+ * Author: Hugo José Pinto & Contributors
+ * =============================================================================
+ */
+
+#ifndef _FB_H
+#define _FB_H
+
+/* =============================================================================
+ * Drawing Functions
+ * =============================================================================
+ *
+ * These write into the frame only; nothing appears until fb_flush().
+ * Positions are 0-based, as for locate(). Writes outside the display
+ * are ignored, and strings are cut at the end of their row.
+ *
+ * Characters 32-255 and the user defined graphics 1-7 may be drawn.
+ * Control characters (8-31) must not be put in the frame.
+ */
+
+/*
+ * fb_begin - Start a new frame
+ *
+ * Fills the whole frame with spaces. Call it before drawing a screen
+ * from scratch; to change part of the last frame, skip it and draw over
+ * the cells that change.
+ */
+void fb_begin(void);
+
+/*
+ * fb_put - Write a string into the frame
+ *
+ * Parameters:
+ *   col - Column (0-based, 0 to DISP_COLS-1)
+ *   row - Row (0-based, 0 to DISP_ROWS-1)
+ *   s   - Null-terminated string (cut at the end of the row)
+ *
+ * Example:
+ *   fb_put(0, 1, "Score:");
+ */
+void fb_put(int col, int row, char *s);
+
+/*
+ * fb_putc - Write a character into the frame
+ *
+ * Parameters:
+ *   col - Column (0-based, 0 to DISP_COLS-1)
+ *   row - Row (0-based, 0 to DISP_ROWS-1)
+ *   c   - Character to write
+ *
+ * Example:
+ *   fb_putc(x, y, '*');
+ */
+void fb_putc(int col, int row, char c);
+
+/* =============================================================================
+ * Display Functions
+ * =============================================================================
+ */
+
+/*
+ * fb_flush - Show the frame on the display
+ *
+ * Prints the cells that changed since the last flush. The first flush
+ * (and the first after fb_invalidate) prints the whole frame.
+ *
+ * The cursor is left after the last cell printed; use locate() to move
+ * it somewhere else.
+ *
+ * Returns:
+ *   Number of print calls made (0 if the display was already up to date)
+ */
+int fb_flush(void);
+
+/*
+ * fb_invalidate - Forget what is on the display
+ *
+ * Makes the next fb_flush() redraw every cell. Call it after writing
+ * to the display with anything other than fb_flush().
+ */
+void fb_invalidate(void);
+
+#endif /* _FB_H */
@@ -0,0 +1,387 @@
+/*
+ * =============================================================================
+ * Psion Organiser II Fixed Point Library Header
+ * =============================================================================
+ *
+ * This header provides fast fixed point arithmetic for Small-C programs on
+ * the Psion Organiser II, as an alternative to float.h when a fixed number
+ * of fraction bits is enough (sensor readings, scaled coordinates, money).
+ *
+ * USAGE:
+ *   #include <psion.h>       // Core functions (display, keyboard, etc.)
+ *   #include <fixed.h>       // Fixed point support (this file)
+ *
+ * The compiler will automatically include the necessary runtime code
+ * (fixedruntime.inc) when fixed.h is included.
+ *
+ * EXAMPLE:
+ *   void main() {
+ *       fx_t angle, result;
+ *
+ *       cls();
+ *       fx_from_str(&angle, "0.5236");  // 30 degrees in radians
+ *       fx_sin(&result, &angle);
+ *       print("sin(30 deg) = ");
+ *       fx_print(&result, 4);
+ *       getkey();
+ *   }
+ *
+ * FIXED POINT FORMATS:
+ *   fx_t (Q16.16) - 4 bytes: a signed 16-bit integer part, then a 16-bit
+ *                   binary fraction, most significant byte first
+ *                   - Range: -32768 to 32767.99998
+ *                   - Resolution: 1/65536 (about 0.000015)
+ *   q8_t (Q8.8)   - A plain int holding value * 256
+ *                   - Range: -128 to 127.996
+ *                   - Resolution: 1/256 (about 0.004)
+ *
+ * SPEED:
+ *   The functions are integer code on the HD6303 and never call the ROM
+ *   maths package. Compared with the float.h equivalents, fx_add is
+ *   about 12 times faster, fx_mul 5 times, fx_div 4 times, and fx_sqrt
+ *   and fx_sin 40 to 200 times (see docs/fixed.md for cycle counts).
+ *
+ * ERROR HANDLING:
+ *   There is no error state. Like int arithmetic, results that do not
+ *   fit wrap around. Division by zero gives the largest value with the
+ *   sign of the dividend, and the square root of a negative number is 0.
+ *
+ * FLOATING POINT CONVERSION:
+ *   fx_to_fp() and fx_from_fp() are available when float.h is included
+ *   before fixed.h.
+ *
+ * Author: Hugo José Pinto & Contributors
+ * =============================================================================
+ */
+
+#ifndef _FIXED_H
+#define _FIXED_H
+
+/* =============================================================================
+ * Fixed Point Data Types
+ * =============================================================================
+ *
+ * Since Small-C has no 32-bit type, a Q16.16 number is an array of 4
+ * bytes (fx_t), used through pointers like fp_t.
+ *
+ * IMPORTANT: Always use pointers (&var) when passing fx_t to functions.
+ * You CANNOT assign fx_t directly; use fx_from_int(), fx_from_str(), etc.
+ *
+ * A Q8.8 number fits in an int, so q8_t values are passed and returned
+ * by value. Add, subtract and compare them with the usual int operators.
+ *
+ * Example:
+ *   fx_t x, y, result;
+ *   fx_from_str(&x, "3.14159");
+ *   fx_from_int(&y, 2);
+ *   fx_mul(&result, &x, &y);  // result = x * y
+ *
+ *   q8_t a, b;
+ *   a = q8_from_int(3);
+ *   b = q8_from_str("1.5");
+ *   a = q8_mul(a + b, b);     // a = (3 + 1.5) * 1.5
+ */
+
+/* Q16.16 fixed point number - 4 bytes */
+typedef char fx_t[4];
+
+/* Q8.8 fixed point number - value * 256 */
+typedef int q8_t;
+
+/* Size of a Q16.16 number in bytes */
+#define FX_SIZE 4
+
+/* 1.0 in Q8.8 */
+#define Q8_ONE 256
+
+/* Integer to Q8.8 (-128 to 127) */
+#define q8_from_int(n) ((n) * Q8_ONE)
+
+/* Q8.8 to integer (truncated towards zero) */
+#define q8_to_int(a) ((a) / Q8_ONE)
+
+/* =============================================================================
+ * Conversion Functions
+ * =============================================================================
+ */
+
+/*
+ * fx_from_int - Convert integer to fixed point
+ *
+ * Parameters:
+ *   dest - Pointer to fx_t storage for result
+ *   n    - 16-bit signed integer to convert
+ *
+ * Example:
+ *   fx_t x;
+ *   fx_from_int(&x, -100);  // x = -100.0
+ */
+void fx_from_int(fx_t *dest, int n);
+
+/*
+ * fx_to_int - Convert fixed point to integer (truncated)
+ *
+ * Parameters:
+ *   src - Pointer to fx_t number to convert
+ *
+ * Returns:
+ *   Integer part (truncated towards zero)
+ *
+ * Example:
+ *   fx_from_str(&x, "-3.7");
+ *   n = fx_to_int(&x);  // n = -3
+ */
+int fx_to_int(fx_t *src);
+
+/*
+ * fx_from_str - Convert string to fixed point
+ *
+ * Reads leading spaces, an optional sign, digits and optionally a
+ * decimal point with more digits. The first 5 fraction digits count;
+ * the result is within 1/65536 of the decimal value.
+ *
+ * Parameters:
+ *   dest - Pointer to fx_t storage for result
+ *   s    - Null-terminated string (e.g., "3.14159", "-12")
+ *
+ * Example:
+ *   fx_t pi;
+ *   fx_from_str(&pi, "3.14159");
+ */
+void fx_from_str(fx_t *dest, char *s);
+
+/*
+ * fx_to_str - Convert fixed point to string
+ *
+ * Writes the value rounded to the given number of decimal places,
+ * without exponent.
+ *
+ * Parameters:
+ *   buf    - Output buffer (at least 14 characters)
+ *   src    - Pointer to fx_t number to convert
+ *   places - Decimal places (0-5; more are taken as 5)
+ *
+ * Example:
+ *   char buf[14];
+ *   fx_from_str(&x, "123.456789");
+ *   fx_to_str(buf, &x, 2);  // buf = "123.46"
+ */
+void fx_to_str(char *buf, fx_t *src, int places);
+
+/*
+ * q8_to_fx - Convert Q8.8 to Q16.16 (exact)
+ *
+ * Parameters:
+ *   dest - Pointer to fx_t storage for result
+ *   a    - Q8.8 value
+ */
+void q8_to_fx(fx_t *dest, q8_t a);
+
+/*
+ * q8_from_fx - Convert Q16.16 to Q8.8 (rounded)
+ *
+ * Parameters:
+ *   src - Pointer to fx_t number (-128 to 127.996)
+ *
+ * Returns:
+ *   Q8.8 value
+ */
+q8_t q8_from_fx(fx_t *src);
+
+/*
+ * q8_from_str - Convert string to Q8.8 (rounded)
+ *
+ * Parameters:
+ *   s - Null-terminated string, as for fx_from_str
+ *
+ * Returns:
+ *   Q8.8 value
+ */
+q8_t q8_from_str(char *s);
+
+/*
+ * q8_to_str - Convert Q8.8 to string
+ *
+ * Parameters:
+ *   buf    - Output buffer (at least 14 characters)
+ *   a      - Q8.8 value
+ *   places - Decimal places (0-5; more are taken as 5)
+ */
+void q8_to_str(char *buf, q8_t a, int places);
+
+/* =============================================================================
+ * Arithmetic Functions
+ * =============================================================================
+ *
+ * The fx_t functions follow the float.h pattern:
+ *   fx_op(result, operand1, operand2)
+ * where result = operand1 op operand2
+ *
+ * NOTE: result can be the same variable as an operand:
+ *   fx_add(&x, &x, &y);  // x = x + y  (valid)
+ *
+ * Products and quotients are rounded to the nearest 1/65536 (Q16.16)
+ * or 1/256 (Q8.8).
+ */
+
+/*
+ * fx_add - Add two fixed point numbers
+ *
+ * Parameters:
+ *   result - Pointer to storage for result
+ *   a, b   - Pointers to operands
+ */
+void fx_add(fx_t *result, fx_t *a, fx_t *b);
+
+/*
+ * fx_sub - Subtract two fixed point numbers
+ *
+ * Parameters:
+ *   result - Pointer to storage for result
+ *   a, b   - Pointers to operands
+ */
+void fx_sub(fx_t *result, fx_t *a, fx_t *b);
+
+/*
+ * fx_mul - Multiply two fixed point numbers
+ *
+ * Parameters:
+ *   result - Pointer to storage for result
+ *   a, b   - Pointers to operands
+ */
+void fx_mul(fx_t *result, fx_t *a, fx_t *b);
+
+/*
+ * fx_div - Divide two fixed point numbers
+ *
+ * Parameters:
+ *   result - Pointer to storage for result (a / b)
+ *   a, b   - Pointers to operands
+ *
+ * Division by zero gives the largest value with the sign of a.
+ */
+void fx_div(fx_t *result, fx_t *a, fx_t *b);
+
+/*
+ * fx_neg - Negate fixed point number in place
+ *
+ * Parameters:
+ *   n - Pointer to number to negate
+ */
+void fx_neg(fx_t *n);
+
+/*
+ * q8_mul - Multiply two Q8.8 numbers
+ *
+ * Returns:
+ *   a * b
+ */
+q8_t q8_mul(q8_t a, q8_t b);
+
+/*
+ * q8_div - Divide two Q8.8 numbers
+ *
+ * Returns:
+ *   a / b; for b = 0 the largest value with the sign of a
+ */
+q8_t q8_div(q8_t a, q8_t b);
+
+/* =============================================================================
+ * Mathematical Functions
+ * =============================================================================
+ *
+ * sin and cos take radians and read a 129-entry quarter-wave table with
+ * linear interpolation. They are accurate to about 0.0003 for fx_t and
+ * to 1/256 for q8_t, for any angle.
+ */
+
+/*
+ * fx_sqrt - Square root
+ *
+ * Parameters:
+ *   result - Pointer to storage for result
+ *   x      - Pointer to operand (0 is returned for negative x)
+ */
+void fx_sqrt(fx_t *result, fx_t *x);
+
+/*
+ * fx_sin - Sine
+ *
+ * Parameters:
+ *   result - Pointer to storage for result
+ *   angle  - Pointer to angle in radians
+ */
+void fx_sin(fx_t *result, fx_t *angle);
+
+/*
+ * fx_cos - Cosine
+ *
+ * Parameters:
+ *   result - Pointer to storage for result
+ *   angle  - Pointer to angle in radians
+ */
+void fx_cos(fx_t *result, fx_t *angle);
+
+/* q8_sqrt - Square root of a Q8.8 number (0 for negative a) */
+q8_t q8_sqrt(q8_t a);
+
+/* q8_sin - Sine of a Q8.8 angle in radians */
+q8_t q8_sin(q8_t angle);
+
+/* q8_cos - Cosine of a Q8.8 angle in radians */
+q8_t q8_cos(q8_t angle);
+
+/* =============================================================================
+ * Comparison and Output Functions
+ * =============================================================================
+ */
+
+/*
+ * fx_cmp - Compare two fixed point numbers
+ *
+ * Returns:
+ *   -1 if a < b, 0 if a == b, 1 if a > b
+ */
+int fx_cmp(fx_t *a, fx_t *b);
+
+/*
+ * fx_print - Print fixed point number to display
+ *
+ * Parameters:
+ *   n      - Pointer to number to print
+ *   places - Decimal places (0-5)
+ */
+void fx_print(fx_t *n, int places);
+
+/* =============================================================================
+ * Floating Point Conversion
+ * =============================================================================
+ *
+ * Available when float.h is included before fixed.h. Both directions
+ * go through decimal text with 5 places (the fp_t value is rounded to
+ * 5 places first); values outside the fx_t range do not convert.
+ */
+
+#ifdef _FLOAT_H
+
+/*
+ * fx_to_fp - Convert fixed point to floating point
+ *
+ * Parameters:
+ *   dest - Pointer to fp_t storage for result
+ *   src  - Pointer to fx_t number
+ */
+void fx_to_fp(fp_t *dest, fx_t *src);
+
+/*
+ * fx_from_fp - Convert floating point to fixed point
+ *
+ * Parameters:
+ *   dest - Pointer to fx_t storage for result
+ *   src  - Pointer to fp_t number (-32768 to 32767.99998)
+ */
+void fx_from_fp(fx_t *dest, fp_t *src);
+
+#endif /* _FLOAT_H */
+
+#endif /* _FIXED_H */
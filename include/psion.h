@@ -690,7 +690,11 @@ int strncmp(char *s1, char *s2, int n);
 /*
  * memcpy - Copy memory block
  *
- * Copies n bytes from src to dest.
+ * Copies n bytes from src to dest, a word at a time. Overlapping
+ * blocks are only safe when dest is below src.
+ *
+ * When n is a constant of 16 or less, the compiler expands the copy
+ * inline instead of calling the runtime.
  *
  * Parameters:
  *   dest - Destination buffer
@@ -707,7 +711,8 @@ void *memcpy(void *dest, void *src, int n);
  *
  * Convenience wrapper for memcpy to copy struct values.
  * This is the recommended way to copy structs since by-value
- * struct assignment is not supported.
+ * struct assignment is not supported. Structs of 16 bytes or less
+ * with a sizeof() size are copied inline.
  *
  * Parameters:
  *   dest - Pointer to destination struct
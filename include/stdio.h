@@ -32,10 +32,10 @@
  *
  * NOTE ON SPRINTF:
  *   The sprintf implementation is simplified for the Psion platform:
- *   - Supports %d, %u, %x, %c, %s, %% format specifiers
- *   - Supports width specifiers (e.g., %5d)
- *   - Does NOT support precision, floating point, or long modifiers
- *   - Maximum of 4 format arguments (due to Small-C limitations)
+ *   - Supports %d, %u, %x, %X, %c, %s, %% format specifiers
+ *   - Supports width and flags (e.g., %5d, %-5d, %05d)
+ *   - Supports %ld, %lu, %lx through a pointer to a 4-byte value
+ *   - Does NOT support precision or floating point
  *
  * Author: Hugo José Pinto & Contributors
  * Part of the Psion Organiser II SDK
@@ -145,6 +145,7 @@ char *strncat(char *dest, char *src, int n);
  *   %d  - Signed decimal integer
  *   %u  - Unsigned decimal integer
  *   %x  - Unsigned hexadecimal (lowercase)
+ *   %X  - Unsigned hexadecimal (uppercase)
  *   %c  - Single character
  *   %s  - Null-terminated string
  *   %%  - Literal percent sign
@@ -153,17 +154,26 @@ char *strncat(char *dest, char *src, int n);
  *   %5d   - Right-align in 5-character field (space-padded)
  *   %-5d  - Left-align in 5-character field
  *   %05d  - Right-align with zero padding
+ *   %04x  - Hex with leading zeros (%x alone writes none)
+ *
+ * LONG INTEGERS:
+ *   Small-C has no long type, so %ld, %lu, %lx and %lX take a pointer
+ *   to 4 bytes holding the value, most significant byte first (the
+ *   layout of fx_t in fixed.h):
+ *     char n[4];                           // 100000 = $000186A0
+ *     sprintf(buf, "%ld", n);              // "100000"
  *
  * NOT SUPPORTED (to minimize code size):
  *   %f, %e, %g  - Floating point (use fp_print instead)
  *   %p          - Pointer
- *   %ld, %lx    - Long integers
  *   %.Nd        - Precision specifiers
  *
+ * Unknown specifiers are skipped without reading an argument.
+ *
  * Parameters:
  *   buf  - Destination buffer (must be large enough for result)
  *   fmt  - Format string
- *   ...  - Arguments matching format specifiers (max 4 arguments)
+ *   ...  - Arguments matching format specifiers (any number)
  *
  * Returns:
  *   Number of characters written (excluding null terminator)
@@ -175,8 +185,8 @@ char *strncat(char *dest, char *src, int n);
  *   sprintf(buf, "Name: %s", "Bob");       // "Name: Bob"
  *   sprintf(buf, "%d + %d = %d", 1, 2, 3); // "1 + 2 = 3"
  *
- * IMPORTANT: Due to Small-C limitations, a maximum of 4 format arguments
- * are supported. Additional arguments will be ignored.
+ * Arguments are read from the stack in order, one per specifier, so
+ * more than four may be passed; Small-C does not check the count.
  *
  * Buffer size: Ensure buf is large enough. No bounds checking is performed.
  * As a rule of thumb, allocate at least strlen(fmt) + 10*num_args bytes.
@@ -186,8 +196,9 @@ int sprintf(char *buf, char *fmt, int a1, int a2, int a3, int a4);
 /*
  * sprintf0, sprintf1, sprintf2, sprintf3 - Fixed-argument sprintf variants
  *
- * These are convenience wrappers when you know the exact number of arguments.
- * They generate slightly smaller code than the full sprintf.
+ * These are convenience names for when you know the exact number of
+ * arguments. They run sprintf itself: a call with fewer arguments pushes
+ * fewer words, so the calling code is smaller.
  *
  * Examples:
  *   sprintf0(buf, "Hello");                // No arguments
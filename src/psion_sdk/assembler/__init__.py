@@ -31,6 +31,8 @@ The assembler uses a three-stage pipeline:
    - Apply safe peephole optimizations (e.g., LDAA #0 → CLRA)
    - Eliminate redundant instruction sequences (e.g., PSHA/PULA pairs)
    - Remove unreachable code after unconditional branches
+   - Dataflow pass over the control flow graph: redundant loads and tests,
+     known-branch folding, jump threading, dead stores
 
 3. **Code Generation (CodeGenerator)** (two-pass):
    - Pass 1: Symbol collection, address calculation, branch relaxation
@@ -65,6 +67,7 @@ Supported Features
 - Conditional assembly (#IF, #IFDEF, #IFNDEF, #ELSE, #ENDIF)
 - Expressions with full operator support
 - Peephole optimization (optional, enabled by default)
+- Unused routine removal (optional, strip_unused=True)
 - Listing file generation
 - Symbol table output
 """
@@ -74,10 +77,13 @@ from psion_sdk.assembler.lexer import Lexer, Token, TokenType
 from psion_sdk.assembler.parser import Parser, Statement, Instruction, Directive, LabelDef
 from psion_sdk.assembler.optimizer import (
     PeepholeOptimizer,
+    DataflowOptimizer,
+    ControlFlowGraph,
     OptimizationStats,
     optimize_statements,
 )
 from psion_sdk.assembler.codegen import CodeGenerator
+from psion_sdk.assembler.reachability import ReachabilityAnalyzer
 from psion_sdk.cpu import (
     AddressingMode,
     InstructionInfo,
@@ -104,10 +110,13 @@ __all__ = [
     "LabelDef",
     # Optimizer
     "PeepholeOptimizer",
+    "DataflowOptimizer",
+    "ControlFlowGraph",
     "OptimizationStats",
     "optimize_statements",
     # Code generator
     "CodeGenerator",
+    "ReachabilityAnalyzer",
     # Opcodes
     "AddressingMode",
     "InstructionInfo",
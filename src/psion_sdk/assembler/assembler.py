@@ -49,7 +49,8 @@ Options:
 from pathlib import Path
 from typing import Optional
 
-from psion_sdk.assembler.parser import parse_source
+from psion_sdk.assembler.lexer import FileTokenizer, tokenize_file
+from psion_sdk.assembler.parser import FileParser, parse_file, parse_source
 from psion_sdk.assembler.codegen import CodeGenerator
 from psion_sdk.assembler.optimizer import PeepholeOptimizer, OptimizationStats
 from psion_sdk.errors import AssemblerError
@@ -124,7 +125,10 @@ class Assembler:
                  relocatable: bool = False,
                  target_model: str | None = None,
                  optimize: bool = True,
-                 debug: bool = False):
+                 debug: bool = False,
+                 strip_unused: bool = False,
+                 tokenize_include: FileTokenizer = tokenize_file,
+                 parse_include: Optional[FileParser] = None):
         """
         Initialize the assembler.
 
@@ -145,6 +149,17 @@ class Assembler:
                    symbol definitions and source line mappings for generating a
                    .dbg file alongside the OB3 output. Use write_debug() to output
                    the debug file after assembly.
+            strip_unused: Leave out routines that cannot be reached from the
+                          program entry (e.g. unused runtime library code).
+                          Use get_removed_routines() to see what was dropped.
+            tokenize_include: Reads and tokenizes included files. psbuild
+                              passes a caching version, since the runtime
+                              .inc files are large.
+            parse_include: Reads and parses included files for code
+                           generation (default: parse_file with
+                           tokenize_include). psbuild passes a caching
+                           version, so runtime.inc is neither lexed nor
+                           parsed again by an unchanged SDK.
         """
         self._verbose = verbose
         self._relocatable = relocatable
@@ -153,6 +168,9 @@ class Assembler:
         self._defines: dict[str, int] = {}
         self._source_file: Optional[Path] = None
         self._opt_stats: Optional[OptimizationStats] = None  # Last optimization stats
+        self._tokenize_include = tokenize_include
+        self._parse_include = parse_include
+        self._included_files: set[str] = set()  # Files read by the last assembly
 
         # Target model handling:
         # - _initial_model: Model specified via constructor (from CLI)
@@ -170,7 +188,9 @@ class Assembler:
         self._codegen = CodeGenerator(
             relocatable=relocatable,
             model_callback=self.set_model,
-            target=self._initial_model
+            target=self._initial_model,
+            strip_unused=strip_unused,
+            parse_include=self._parse_included_file,
         )
 
         # Enable debug symbol generation if requested
@@ -394,14 +414,16 @@ class Assembler:
 
         # Parse source (include_paths needed for macro pre-processing)
         include_paths_str = [str(p) for p in self._include_paths]
-        statements = parse_source(source, filename, include_paths=include_paths_str)
+        self._included_files.clear()
+        statements = parse_source(source, filename, include_paths=include_paths_str,
+                                  tokenize_include=self._read_include)
 
         if self._verbose:
             print(f"Parsed {len(statements)} statements")
 
         # Optimize statements if enabled
         if self._optimize:
-            optimizer = PeepholeOptimizer(enabled=True, verbose=self._verbose)
+            optimizer = PeepholeOptimizer(enabled=True, verbose=self._verbose, dataflow=True)
             statements = optimizer.optimize(statements)
             self._opt_stats = optimizer.stats
 
@@ -518,6 +540,37 @@ class Assembler:
         """
         return self._opt_stats
 
+    def get_included_files(self) -> list[str]:
+        """
+        Get the files the last assembly included.
+
+        Returns:
+            Sorted resolved paths of every file read for an INCLUDE,
+            including files only scanned for macro definitions
+        """
+        return sorted(self._included_files)
+
+    def _read_include(self, path: Path) -> list:
+        """Tokenize an included file, recording it for get_included_files()."""
+        self._included_files.add(str(Path(path).resolve()))
+        return self._tokenize_include(path)
+
+    def _parse_included_file(self, path: Path) -> list:
+        """Parse an included file, recording it for get_included_files()."""
+        if self._parse_include is None:
+            return parse_file(path, self._read_include)
+        self._included_files.add(str(Path(path).resolve()))
+        return self._parse_include(path)
+
+    def get_removed_routines(self) -> list[str]:
+        """
+        Get the routines left out because nothing reaches them.
+
+        Returns:
+            Sorted labels (uppercase); empty unless strip_unused is enabled
+        """
+        return self._codegen.get_removed_routines()
+
     def get_fixup_count(self) -> int:
         """
         Get the number of relocation fixups.
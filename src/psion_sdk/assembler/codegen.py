@@ -57,7 +57,7 @@ from psion_sdk.errors import (
     SourceLocation,
     ErrorCollector,
 )
-from psion_sdk.assembler.lexer import Token, TokenType, Lexer
+from psion_sdk.assembler.lexer import Token, TokenType, FileTokenizer, tokenize_file
 from psion_sdk.assembler.parser import (
     Statement,
     LabelDef,
@@ -68,8 +68,11 @@ from psion_sdk.assembler.parser import (
     ConditionalBlock,
     Operand,
     ParsedAddressingMode,
-    Parser,
+    FileParser,
+    parse_file,
+    DATA_DIRECTIVES,
 )
+from psion_sdk.assembler.reachability import ReachabilityAnalyzer
 from psion_sdk.cpu import (
     AddressingMode,
     OPCODE_TABLE,
@@ -317,7 +320,9 @@ class CodeGenerator:
     DEFAULT_TARGET = "XP"
 
     def __init__(self, relocatable: bool = False, model_callback=None,
-                 target: str = "XP"):
+                 target: str = "XP", strip_unused: bool = False,
+                 tokenize_include: FileTokenizer = tokenize_file,
+                 parse_include: Optional[FileParser] = None):
         """
         Initialize the code generator.
 
@@ -331,6 +336,17 @@ class CodeGenerator:
                     whether the STOP+SIN prefix is added for 4-line mode.
                     Valid values: CM, XP, LA (2-line), LZ, LZ64 (4-line),
                     PORTABLE (runs on any model). Default: XP
+            strip_unused: If True, leave out routines the program cannot
+                          reach (see reachability.py).
+            tokenize_include: Reads and tokenizes included files, for
+                              the default parse_include.
+            parse_include: Reads and parses included files. Each file
+                           is parsed once per generate() call, and its
+                           statements are reused by every pass, every
+                           relaxation iteration and the reachability
+                           analysis. A caching parser can also reuse
+                           them across assemblies. Default: parse_file
+                           with tokenize_include.
         """
         self._symbols: dict[str, Symbol] = {}
         self._code = bytearray()
@@ -362,14 +378,17 @@ class CodeGenerator:
         # 4. Repeat until stable (no more branches need relaxation)
         # 5. Pass 2: Generate code with correct branch forms
         #
-        # _long_branches: Set of SourceLocation for branches that need long form.
-        #                 We use SourceLocation (file:line:column) as a stable
-        #                 identifier instead of id(stmt) because statements from
-        #                 included files are re-created on each relaxation iteration.
-        # _branch_locations: Maps SourceLocation to (pc_address, operand, mnemonic)
+        # _long_branches: Set of branch keys for branches that need long form.
+        #                 A key is the SourceLocation (file:line:column) plus the
+        #                 macro invocations the branch was expanded from (see
+        #                 _branch_key). SourceLocation is a stable identifier,
+        #                 unlike id(stmt), because an included file's statements
+        #                 may come from a cache shared by several INCLUDEs of it;
+        #                 the invocations tell apart copies of one macro line.
+        # _branch_locations: Maps branch key to (pc_address, operand, mnemonic)
         #                    for checking branch offsets after pass 1.
-        self._long_branches: set[SourceLocation] = set()  # Locations needing long form
-        self._branch_locations: dict[SourceLocation, tuple[int, Operand, str]] = {}  # loc -> (pc, operand, mnemonic)
+        self._long_branches: set[tuple] = set()  # Branch keys needing long form
+        self._branch_locations: dict[tuple, tuple[int, Operand, str]] = {}  # key -> (pc, operand, mnemonic)
 
         # Model callback for .MODEL directive
         self._model_callback = model_callback
@@ -393,8 +412,29 @@ class CodeGenerator:
         # -------------
         # _macros: Dictionary of macro name -> MacroDef object
         # _macro_invocation_count: Counter for generating unique labels (\@)
+        # _macro_expansions: Invocation numbers of the macros being expanded,
+        #                    outermost first
         self._macros: dict[str, MacroDef] = {}
         self._macro_invocation_count: int = 0
+        self._macro_expansions: tuple[int, ...] = ()
+
+        # Unused routine removal
+        # ----------------------
+        # _live_sections: Section label -> live, from ReachabilityAnalyzer.
+        #                 Empty when removal is disabled.
+        # _in_dead_section: True while the statements being processed
+        #                   belong to a dead section
+        self._strip_unused = strip_unused
+        self._live_sections: dict[str, bool] = {}
+        self._in_dead_section = False
+
+        # Included files
+        # --------------
+        # _include_statements: Path found by _resolve_include_path -> parsed
+        #                      statements, for the current generate() call
+        self._parse_include: FileParser = (
+            parse_include or (lambda path: parse_file(path, tokenize_include)))
+        self._include_statements: dict[str, list[Statement]] = {}
 
     # =========================================================================
     # Public Interface
@@ -475,6 +515,14 @@ class CodeGenerator:
         # (debug info will be re-populated during the final pass 2)
         self._debug_symbols.clear()
         self._source_map.clear()
+        # Included files are read again, in case they changed since the last call
+        self._include_statements.clear()
+
+        # Find the routines the program can reach before assigning addresses
+        self._live_sections.clear()
+        if self._strip_unused:
+            analyzer = ReachabilityAnalyzer(self._load_include_statements)
+            self._live_sections = analyzer.analyze(statements)
 
         # =====================================================================
         # Iterative Branch Relaxation
@@ -513,6 +561,7 @@ class CodeGenerator:
             # Reset macro state for fresh iteration
             self._macros.clear()
             self._macro_invocation_count = 0
+            self._macro_expansions = ()
 
             # Restore predefined symbols from before the iteration loop
             for name, sym in predefined_symbols.items():
@@ -542,8 +591,11 @@ class CodeGenerator:
             )
 
         # Pass 2: Generate code
+        # Start at the address pass 1 started at, not at the last ORG it saw
+        self._origin = 0
         # Reset macro invocation counter to match pass 1
         self._macro_invocation_count = 0
+        self._macro_expansions = ()
         self._pass2(statements)
 
         if self._errors.has_errors():
@@ -639,6 +691,10 @@ class CodeGenerator:
         result.extend(self._code)
         return bytes(result)
 
+    def get_removed_routines(self) -> list[str]:
+        """Labels of the routines left out as unreachable (strip_unused only)."""
+        return sorted(name for name, live in self._live_sections.items() if not live)
+
     def get_origin(self) -> int:
         """Return the origin address."""
         return self._origin
@@ -898,6 +954,7 @@ class CodeGenerator:
         - Processes EQU/SET for constants
         """
         self._pc = self._origin
+        self._in_dead_section = False
 
         for i, stmt in enumerate(statements):
             try:
@@ -916,6 +973,9 @@ class CodeGenerator:
 
     def _pass1_statement(self, stmt: Statement) -> None:
         """Process a single statement in pass 1."""
+        if self._live_sections and self._skip_dead(stmt):
+            return
+
         if isinstance(stmt, LabelDef):
             self._define_label(stmt)
 
@@ -923,9 +983,8 @@ class CodeGenerator:
             mnemonic = stmt.mnemonic.upper()
 
             # Record branch instruction locations for relaxation checking
-            # We use stmt.location (SourceLocation) as a stable identifier
             if mnemonic in BRANCH_INSTRUCTIONS and stmt.operand:
-                self._branch_locations[stmt.location] = (self._pc, stmt.operand, mnemonic)
+                self._branch_locations[self._branch_key(stmt)] = (self._pc, stmt.operand, mnemonic)
 
             size = self._calculate_instruction_size(stmt)
             self._pc += size
@@ -958,9 +1017,9 @@ class CodeGenerator:
         """
         newly_relaxed = False
 
-        for loc, (pc, operand, mnemonic) in self._branch_locations.items():
+        for key, (pc, operand, mnemonic) in self._branch_locations.items():
             # Skip if already marked as needing long form
-            if loc in self._long_branches:
+            if key in self._long_branches:
                 continue
 
             # Evaluate the target address
@@ -973,7 +1032,7 @@ class CodeGenerator:
 
             # Calculate the instruction size for this branch (may already be long)
             # Note: This check is redundant due to the skip above, but kept for clarity
-            if loc in self._long_branches:
+            if key in self._long_branches:
                 inst_size = get_long_branch_size(mnemonic)
             else:
                 inst_size = get_short_branch_size()
@@ -986,12 +1045,23 @@ class CodeGenerator:
 
             # Check if offset is within range for short branch
             if offset < -128 or offset > 127:
-                # Mark this branch as needing long form (by SourceLocation)
-                self._long_branches.add(loc)
+                # Mark this branch as needing long form
+                self._long_branches.add(key)
                 newly_relaxed = True
 
         return newly_relaxed
 
+    def _branch_key(self, inst: Instruction) -> tuple:
+        """
+        Identify a branch instruction the same way in every pass.
+
+        A macro body line is expanded once per invocation, and each copy
+        may branch a different distance, so the key includes the numbers
+        of the invocations being expanded. Invocations are numbered in
+        source order, which is the same in every pass.
+        """
+        return (inst.location, self._macro_expansions)
+
     def _define_label(self, label: LabelDef) -> None:
         """Define a label in the symbol table."""
         # Normalize name to uppercase for case-insensitive matching
@@ -1067,9 +1137,7 @@ class CodeGenerator:
 
         if mode == ParsedAddressingMode.RELATIVE:
             # Check if this branch instruction needs long form
-            # We use inst.location (SourceLocation) to look up whether this
-            # specific instruction was marked as needing relaxation
-            if inst.location in self._long_branches:
+            if self._branch_key(inst) in self._long_branches:
                 return get_long_branch_size(mnemonic)
             return get_short_branch_size()  # Default: 2 bytes (opcode + displacement)
 
@@ -1238,14 +1306,14 @@ class CodeGenerator:
             if cond.condition_tokens:
                 tok = cond.condition_tokens[0]
                 if tok.type == TokenType.IDENTIFIER:
-                    return tok.value in self._symbols
+                    return tok.value.upper() in self._symbols
             return False
 
         if cond.condition_type == "IFNDEF":
             if cond.condition_tokens:
                 tok = cond.condition_tokens[0]
                 if tok.type == TokenType.IDENTIFIER:
-                    return tok.value not in self._symbols
+                    return tok.value.upper() not in self._symbols
             return True
 
         if cond.condition_type == "IF":
@@ -1360,6 +1428,8 @@ class CodeGenerator:
                     source_line=sym.location.line,
                 ))
 
+        self._in_dead_section = False
+
         for i, stmt in enumerate(statements):
             try:
                 # Skip LabelDef if next statement is EQU/SET with same label
@@ -1377,6 +1447,9 @@ class CodeGenerator:
 
     def _pass2_statement(self, stmt: Statement) -> None:
         """Process a single statement in pass 2."""
+        if self._live_sections and self._skip_dead(stmt):
+            return
+
         start_pc = self._pc
         code_start = len(self._code)
 
@@ -1557,8 +1630,8 @@ class CodeGenerator:
         """
         mnemonic = mnemonic.upper()
 
-        # Check if this instruction needs long form (by SourceLocation)
-        needs_long = inst.location in self._long_branches
+        # Check if this instruction needs long form
+        needs_long = self._branch_key(inst) in self._long_branches
 
         if needs_long:
             # Emit long branch sequence
@@ -1844,6 +1917,9 @@ class CodeGenerator:
             for arg_tokens in directive.arguments:
                 value = self._evaluator.evaluate(arg_tokens, directive.location)
                 self._emit_word(value)
+                # Address tables (e.g. switch jump tables) move with the code
+                if self._tokens_need_fixup(arg_tokens):
+                    self._record_fixup()
                 self._pc += 2
 
         elif name == "FCC":
@@ -1914,13 +1990,19 @@ class CodeGenerator:
         param_map = self._build_param_map(macro_def, call)
 
         # Get unique suffix for this invocation
-        unique_suffix = f"_{self._macro_invocation_count:03d}"
+        invocation = self._macro_invocation_count
+        unique_suffix = f"_{invocation:03d}"
         self._macro_invocation_count += 1
 
         # Expand and process each statement in the macro body
-        for stmt in macro_def.body:
-            expanded = self._substitute_macro_tokens(stmt, param_map, unique_suffix)
-            self._pass1_statement(expanded)
+        outer = self._macro_expansions
+        self._macro_expansions = outer + (invocation,)
+        try:
+            for stmt in macro_def.body:
+                expanded = self._substitute_macro_tokens(stmt, param_map, unique_suffix)
+                self._pass1_statement(expanded)
+        finally:
+            self._macro_expansions = outer
 
     def _expand_macro(self, call: MacroCall) -> None:
         """Expand a macro invocation in pass 2."""
@@ -1934,13 +2016,19 @@ class CodeGenerator:
         param_map = self._build_param_map(macro_def, call)
 
         # Get unique suffix for this invocation (must match pass 1)
-        unique_suffix = f"_{self._macro_invocation_count:03d}"
+        invocation = self._macro_invocation_count
+        unique_suffix = f"_{invocation:03d}"
         self._macro_invocation_count += 1
 
         # Expand and process each statement in the macro body
-        for stmt in macro_def.body:
-            expanded = self._substitute_macro_tokens(stmt, param_map, unique_suffix)
-            self._pass2_statement(expanded)
+        outer = self._macro_expansions
+        self._macro_expansions = outer + (invocation,)
+        try:
+            for stmt in macro_def.body:
+                expanded = self._substitute_macro_tokens(stmt, param_map, unique_suffix)
+                self._pass2_statement(expanded)
+        finally:
+            self._macro_expansions = outer
 
     def _build_param_map(self, macro_def: MacroDef, call: MacroCall) -> dict[str, list[Token]]:
         """Build a mapping from parameter names to argument token lists."""
@@ -2135,11 +2223,7 @@ class CodeGenerator:
 
         # Read and parse include file
         try:
-            source = filepath.read_text(encoding='utf-8')
-            lexer = Lexer(source, str(filepath))
-            tokens = list(lexer.tokenize())
-            parser = Parser(tokens, str(filepath))
-            statements = parser.parse()
+            statements = self._include_file_statements(filepath)
 
             # Mark that we're in an include file so constants are marked external
             # (they represent OS addresses/system vars that don't need relocation)
@@ -2172,14 +2256,15 @@ class CodeGenerator:
             return  # Error already reported in pass 1
 
         try:
-            source = filepath.read_text(encoding='utf-8')
-            lexer = Lexer(source, str(filepath))
-            tokens = list(lexer.tokenize())
-            parser = Parser(tokens, str(filepath))
-            statements = parser.parse()
-
-            # Process statements (using same logic as _pass2 to handle EQU labels)
-            for i, stmt in enumerate(statements):
+            statements = self._include_file_statements(filepath)
+        except Exception:
+            return  # Error already reported in pass 1
+
+        # Process statements (using same logic as _pass2 to handle EQU labels).
+        # Errors are recorded per statement, as in _pass2, so that one bad
+        # line is reported instead of silently dropping the rest of the file.
+        for i, stmt in enumerate(statements):
+            try:
                 # Skip LabelDef if next statement is EQU/SET with same label
                 if isinstance(stmt, LabelDef) and i + 1 < len(statements):
                     next_stmt = statements[i + 1]
@@ -2188,9 +2273,8 @@ class CodeGenerator:
                         next_stmt.label == stmt.name):
                         continue
                 self._pass2_statement(stmt)
-
-        except Exception:
-            pass  # Error already reported in pass 1
+            except AssemblerError as e:
+                self._errors.add(e)
 
     def _resolve_include_path(
         self,
@@ -2218,6 +2302,60 @@ class CodeGenerator:
 
         return None
 
+    def _load_include_statements(self, directive: Directive) -> Optional[tuple[str, list[Statement]]]:
+        """Parse an included file for ReachabilityAnalyzer (None if not found)."""
+        filepath = self._resolve_include_path(directive.arguments[0][0].value, directive.location)
+        if filepath is None:
+            return None
+        return str(filepath.resolve()), self._include_file_statements(filepath)
+
+    def _include_file_statements(self, filepath: Path) -> list[Statement]:
+        """Statements of an included file, parsed once per generate() call."""
+        key = str(filepath)
+        statements = self._include_statements.get(key)
+        if statements is None:
+            statements = self._parse_include(filepath)
+            self._include_statements[key] = statements
+        return statements
+
+    # =========================================================================
+    # Unused Routine Removal
+    # =========================================================================
+
+    def _skip_dead(self, stmt: Statement) -> bool:
+        """
+        Track section boundaries and tell whether a statement is dead code.
+
+        Declarations (EQU/SET, macros, INCLUDE, ORG, .MODEL) are always
+        processed, since other sections may use what they define. A
+        conditional block that splits sections is processed so that the
+        labels inside it switch the state themselves.
+        """
+        if isinstance(stmt, LabelDef):
+            live = None if stmt.is_local else self._live_sections.get(stmt.name.upper())
+            if live is not None:
+                self._in_dead_section = not live
+            return self._in_dead_section
+
+        if not self._in_dead_section:
+            return False
+        if isinstance(stmt, (Instruction, MacroCall)):
+            return True
+        if isinstance(stmt, Directive):
+            return stmt.name.upper() in DATA_DIRECTIVES
+        if isinstance(stmt, ConditionalBlock):
+            return not self._has_section_label(stmt.if_body + stmt.else_body)
+        return False
+
+    def _has_section_label(self, statements: list[Statement]) -> bool:
+        """True if the statements (or nested blocks) start a section."""
+        for stmt in statements:
+            if isinstance(stmt, LabelDef) and stmt.name.upper() in self._live_sections:
+                return True
+            if isinstance(stmt, ConditionalBlock) and self._has_section_label(stmt.if_body + stmt.else_body):
+                return True
+        return False
+
     # =========================================================================
     # Relocation Helpers
     # =========================================================================
@@ -2243,6 +2381,10 @@ class CodeGenerator:
         Returns:
             True if the operand needs a relocation fixup
         """
+        return self._tokens_need_fixup(operand.tokens)
+
+    def _tokens_need_fixup(self, tokens: list[Token]) -> bool:
+        """Check if an expression's tokens need relocation (see _needs_fixup)."""
         if not self._relocatable:
             return False
 
@@ -2251,7 +2393,7 @@ class CodeGenerator:
         balance = 0
         sign = 1  # Start in additive context
 
-        for token in operand.tokens:
+        for token in tokens:
             if token.type == TokenType.IDENTIFIER:
                 sym_name = token.value.upper()
                 if sym_name in self._symbols:
@@ -52,7 +52,9 @@ Token(EOF, None, 1, 25)
 
 from dataclasses import dataclass
 from enum import Enum, auto
-from typing import Iterator, Optional
+from pathlib import Path
+from typing import Callable, Iterator, Optional
+import re
 import string
 
 from psion_sdk.errors import AssemblySyntaxError, SourceLocation
@@ -124,13 +126,15 @@ class TokenType(Enum):
 # Token Data Class
 # =============================================================================
 
-@dataclass(frozen=True)
+@dataclass(frozen=True, slots=True)
 class Token:
     """
     Represents a single token from the source code.
 
     This is an immutable data class that stores the token type, value,
-    and location information for error reporting.
+    and location information for error reporting. It uses __slots__:
+    a generated program with its runtime includes is tens of thousands
+    of lines, and every token of it is kept until assembly ends.
 
     Attributes:
         type: The TokenType classification
@@ -211,6 +215,44 @@ class Lexer:
         "=": TokenType.EQUALS,
     }
 
+    # Operators and delimiters matched by the fast path
+    OPERATOR_TOKENS = {
+        **SINGLE_CHAR_TOKENS,
+        "$": TokenType.DOLLAR,
+        "<": TokenType.LT,
+        ">": TokenType.GT,
+        "<<": TokenType.LSHIFT,
+        ">>": TokenType.RSHIFT,
+        "<=": TokenType.LE,
+        ">=": TokenType.GE,
+        "<>": TokenType.NE,
+        "!=": TokenType.NE,
+    }
+
+    # Fast Path
+    # ---------
+    # One alternative per kind of token, tried at the current position.
+    # Each matches exactly what the character scanner would consume for
+    # it. Anything that matches none of them is handed to _scan_token:
+    # literals with escape sequences, a lone '.', '!' or '\\', prefixes
+    # without digits (0x, @8) and unexpected characters.
+    # A '*' from the "op" alternative is a comment at the start of a line.
+    _TOKEN_PATTERN = re.compile(r"""
+          (?P<space>[ \t]+)
+        | (?P<comment>;[^\n]*)
+        | (?P<newline>\n)
+        | (?P<ident>[A-Za-z_][A-Za-z0-9_]*)
+        | (?P<hex>\$[0-9A-Fa-f]+|0[xX][0-9A-Fa-f]+)
+        | (?P<bin>%[01]+|0[bB][01]+)
+        | (?P<oct>@[0-7]+|0[oO][0-7]+)
+        | (?P<dec>(?!0[xXbBoO])[0-9]+)
+        | (?P<local>\.[A-Za-z0-9_]+|@(?![0-9])[A-Za-z0-9_]+)
+        | (?P<string>"[^"\\\n]*")
+        | (?P<char>'[^\\\n]')
+        | (?P<param>\\(?:@|[A-Za-z0-9_]+))
+        | (?P<op><<|<=|<>|>>|>=|!=|[-+*/%&|^~,:#()=<>$])
+    """, re.VERBOSE)
+
     # Escape sequences in strings
     ESCAPE_SEQUENCES = {
         "n": "\n",      # Newline
@@ -249,25 +291,91 @@ class Lexer:
         """
         Generate tokens from the source code.
 
+        Most of the source is matched by one precompiled regular
+        expression (see "Fast Path" below). The character scanner
+        (_scan_token) takes over only for what that expression leaves
+        out, so both paths produce the same tokens and errors.
+
         Yields:
             Token objects representing each lexical element
 
         Raises:
             AssemblySyntaxError: If invalid syntax is encountered
         """
-        while not self._at_end():
-            # Skip whitespace (but not newlines)
-            if self._skip_whitespace():
+        source = self.source
+        filename = self.filename
+        end = len(source)
+        match = self._TOKEN_PATTERN.match
+        operators = self.OPERATOR_TOKENS
+
+        pos = self._pos
+        line = self._line
+        line_start = self._line_start_pos
+        at_line_start = self._at_line_start
+
+        while pos < end:
+            m = match(source, pos)
+            kind = m.lastgroup if m else None
+            column = pos - line_start + 1
+
+            if kind == "space":
+                pos = m.end()
+                continue
+
+            if kind == "newline":
+                yield Token(TokenType.NEWLINE, None, line, column, filename)
+                pos += 1
+                line += 1
+                line_start = pos
+                at_line_start = True
                 continue
 
-            # Check for comments
-            if self._skip_comment():
+            if kind == "comment" or (kind == "op" and at_line_start
+                                     and source[pos] == "*"):
+                pos = source.find("\n", pos)
+                if pos < 0:
+                    pos = end
                 continue
 
-            # Get the next token
-            token = self._scan_token()
-            if token is not None:
-                yield token
+            at_line_start = False
+            if kind is None:
+                # Let the character scanner handle (or report) it
+                self._pos, self._line, self._line_start_pos = pos, line, line_start
+                self._column = column
+                self._at_line_start = False
+                token = self._scan_token()
+                pos, line, line_start = self._pos, self._line, self._line_start_pos
+                if token is not None:
+                    yield token
+                continue
+
+            text = m.group()
+            pos = m.end()
+            if kind == "ident" or kind == "local":
+                yield Token(TokenType.IDENTIFIER, text, line, column, filename)
+            elif kind == "op":
+                yield Token(operators[text], text, line, column, filename)
+            elif kind == "dec":
+                yield Token(TokenType.NUMBER, int(text), line, column, filename)
+            elif kind == "hex":
+                yield Token(TokenType.NUMBER, int(text[1:] if text[0] == "$" else text[2:], 16),
+                            line, column, filename)
+            elif kind == "bin":
+                yield Token(TokenType.NUMBER, int(text[2:] if text[0] == "0" else text[1:], 2),
+                            line, column, filename)
+            elif kind == "oct":
+                yield Token(TokenType.NUMBER, int(text[2:] if text[0] == "0" else text[1:], 8),
+                            line, column, filename)
+            elif kind == "string":
+                yield Token(TokenType.STRING, text[1:-1], line, column, filename)
+            elif kind == "char":
+                yield Token(TokenType.NUMBER, ord(text[1]), line, column, filename)
+            else:  # param
+                yield Token(TokenType.MACRO_PARAM, text[1:], line, column, filename)
+
+        self._pos, self._line, self._line_start_pos = pos, line, line_start
+        self._column = pos - line_start + 1
+        self._at_line_start = at_line_start
 
         # Always end with EOF token
         yield self._make_token(TokenType.EOF, None)
@@ -790,3 +898,23 @@ class Lexer:
         if line_end == -1:
             line_end = len(self.source)
         return self.source[self._line_start_pos:line_end]
+
+
+# =============================================================================
+# File Tokenizing
+# =============================================================================
+
+# Reads a source file and returns its tokens. The code generator and the
+# parser call one for every INCLUDE they follow, so a caller assembling
+# many programs can supply a caching version (see psion_sdk.cli.buildcache).
+FileTokenizer = Callable[[Path], list[Token]]
+
+
+def tokenize_file(path: Path) -> list[Token]:
+    """
+    Read and tokenize a source file (the default FileTokenizer).
+
+    Token filenames are str(path), as given.
+    """
+    source = Path(path).read_text(encoding='utf-8')
+    return list(Lexer(source, str(path)).tokenize())
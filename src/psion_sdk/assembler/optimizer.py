@@ -59,6 +59,12 @@ The optimizer uses a multi-pass peephole approach:
 3. **Dead code elimination**: Remove unreachable code after unconditional
    branches (only within basic blocks)
 
+4. **Dataflow pass** (optional, ``dataflow=True``): Build a control flow
+   graph over the whole file and use register liveness and known register
+   values to remove redundant loads, TSX and tests across labels, fold
+   branches whose outcome is known, thread jumps and delete dead stores
+   (see DataflowOptimizer)
+
 Passes run iteratively until no more changes are made (fixpoint).
 
 Usage
@@ -74,8 +80,12 @@ which returns statements unchanged.
 
 Limitations
 -----------
-- Does not perform data flow analysis (would require full CFG construction)
-- Does not optimize across basic block boundaries (labels)
+- The peephole passes do not optimize across basic block boundaries
+  (labels); only the dataflow pass does
+- The dataflow pass treats a label as closed only when every reference to
+  it is a branch or JMP in the same file; jumps from INCLUDEd files are
+  not seen
+- Byte and cycle savings are static estimates, not measured counts
 - Does not optimize code involving macro expansions (macros expand first)
 - Does not track register values through function calls
 
@@ -100,7 +110,13 @@ from psion_sdk.assembler.parser import (
     ConditionalBlock,
 )
 from psion_sdk.assembler.lexer import Token, TokenType
-from psion_sdk.cpu import UNCONDITIONAL_BRANCHES
+from psion_sdk.cpu import (
+    AddressingMode,
+    OPCODE_TABLE,
+    CONDITIONAL_BRANCHES,
+    UNCONDITIONAL_BRANCHES,
+    get_inverted_branch,
+)
 
 
 # =============================================================================
@@ -120,6 +136,14 @@ class OptimizationStats:
         push_pull_pairs: Count of push/pull pairs eliminated
         redundant_tsx: Count of redundant TSX instructions removed
         dead_code: Count of unreachable instructions removed
+        redundant_test: Count of tests of already-set flags removed
+        dead_store: Count of register writes removed because nothing reads them
+        branch_fold: Count of conditional branches decided at assembly time
+        branch_thread: Count of branches collapsed or retargeted
+        bytes_saved: Estimated code bytes saved
+        cycles_saved: Estimated cycles saved, counting each changed
+            instruction (and each instruction a threaded branch now skips)
+            once - a per-path figure, not a profile
         total_passes: Number of optimization passes run
     """
     compare_zero: int = 0
@@ -127,6 +151,12 @@ class OptimizationStats:
     push_pull_pairs: int = 0
     redundant_tsx: int = 0
     dead_code: int = 0
+    redundant_test: int = 0
+    dead_store: int = 0
+    branch_fold: int = 0
+    branch_thread: int = 0
+    bytes_saved: int = 0
+    cycles_saved: int = 0
     total_passes: int = 0
 
     @property
@@ -137,9 +167,34 @@ class OptimizationStats:
             self.redundant_load +
             self.push_pull_pairs +
             self.redundant_tsx +
-            self.dead_code
+            self.dead_code +
+            self.redundant_test +
+            self.dead_store +
+            self.branch_fold +
+            self.branch_thread
         )
 
+    def add_savings(self, removed, added=(), skipped=()) -> None:
+        """
+        Account for the size and cycles of one rewrite.
+
+        Args:
+            removed: Instructions taken out
+            added: Instructions put in their place
+            skipped: Instructions no longer executed on a rewritten path
+                but still present in the code
+        """
+        for instr in removed:
+            size, cycles = _instruction_cost(instr)
+            self.bytes_saved += size
+            self.cycles_saved += cycles
+        for instr in added:
+            size, cycles = _instruction_cost(instr)
+            self.bytes_saved -= size
+            self.cycles_saved -= cycles
+        for instr in skipped:
+            self.cycles_saved += _instruction_cost(instr)[1]
+
     def __str__(self) -> str:
         """Human-readable summary of optimizations."""
         lines = ["Optimization Statistics:"]
@@ -153,7 +208,17 @@ class OptimizationStats:
             lines.append(f"  Redundant TSX removed: {self.redundant_tsx}")
         if self.dead_code:
             lines.append(f"  Dead code removed: {self.dead_code}")
+        if self.redundant_test:
+            lines.append(f"  Redundant tests removed: {self.redundant_test}")
+        if self.dead_store:
+            lines.append(f"  Dead register writes removed: {self.dead_store}")
+        if self.branch_fold:
+            lines.append(f"  Branches decided: {self.branch_fold}")
+        if self.branch_thread:
+            lines.append(f"  Branches collapsed or threaded: {self.branch_thread}")
         lines.append(f"  Total optimizations: {self.total_optimizations}")
+        if self.bytes_saved or self.cycles_saved:
+            lines.append(f"  Estimated savings: {self.bytes_saved} bytes, {self.cycles_saved} cycles")
         lines.append(f"  Total passes: {self.total_passes}")
         return "\n".join(lines)
 
@@ -246,6 +311,39 @@ def _make_inherent_instruction(mnemonic: str, location) -> Instruction:
     )
 
 
+# Addressing mode used to look up the cost of a parsed instruction
+_COST_MODES = {
+    ParsedAddressingMode.INHERENT: AddressingMode.INHERENT,
+    ParsedAddressingMode.IMMEDIATE: AddressingMode.IMMEDIATE,
+    ParsedAddressingMode.DIRECT_OR_EXTENDED: AddressingMode.EXTENDED,
+    ParsedAddressingMode.INDEXED: AddressingMode.INDEXED,
+    ParsedAddressingMode.RELATIVE: AddressingMode.RELATIVE,
+    ParsedAddressingMode.IMMEDIATE_DIRECT: AddressingMode.DIRECT,
+    ParsedAddressingMode.IMMEDIATE_INDEXED: AddressingMode.INDEXED,
+}
+
+
+def _operand_mode(instr: Instruction) -> ParsedAddressingMode:
+    """Addressing mode of an instruction, INHERENT when it has no operand."""
+    if instr.operand is None:
+        return ParsedAddressingMode.INHERENT
+    return instr.operand.mode
+
+
+def _instruction_cost(instr: Instruction) -> tuple[int, int]:
+    """
+    Size in bytes and execution cycles of an instruction.
+
+    Symbolic addresses are costed as extended, the worst case. Returns
+    (0, 0) when the mnemonic/mode pair isn't in the opcode table.
+    """
+    mode = _COST_MODES.get(_operand_mode(instr))
+    info = OPCODE_TABLE.get((instr.mnemonic, mode))
+    if info is None and mode == AddressingMode.EXTENDED:
+        info = OPCODE_TABLE.get((instr.mnemonic, AddressingMode.DIRECT))
+    return (info.size, info.cycles) if info else (0, 0)
+
+
 # =============================================================================
 # Peephole Optimizer
 # =============================================================================
@@ -261,6 +359,7 @@ class PeepholeOptimizer:
     Attributes:
         enabled: Whether optimization is enabled
         verbose: Whether to print optimization statistics
+        dataflow: Whether each pass also runs the DataflowOptimizer
         stats: Statistics about optimizations performed
         max_passes: Maximum number of optimization passes (prevents infinite loops)
     """
@@ -298,7 +397,8 @@ class PeepholeOptimizer:
         self,
         enabled: bool = True,
         verbose: bool = False,
-        max_passes: int = 10
+        max_passes: int = 10,
+        dataflow: bool = False
     ):
         """
         Initialize the optimizer.
@@ -307,10 +407,13 @@ class PeepholeOptimizer:
             enabled: If False, optimize() returns statements unchanged
             verbose: If True, print optimization statistics
             max_passes: Maximum optimization passes to prevent infinite loops
+            dataflow: If True, also run the CFG-based optimizations
+                (see DataflowOptimizer) in every pass
         """
         self.enabled = enabled
         self.verbose = verbose
         self.max_passes = max_passes
+        self.dataflow = dataflow
         self.stats = OptimizationStats()
 
     def optimize(self, statements: list[Statement]) -> list[Statement]:
@@ -335,6 +438,10 @@ class PeepholeOptimizer:
         # Work on a copy to avoid modifying the original
         result = list(statements)
 
+        dataflow = None
+        if self.dataflow and DataflowOptimizer.applicable(result):
+            dataflow = DataflowOptimizer(result, self.stats)
+
         # Run optimization passes until fixpoint
         for pass_num in range(self.max_passes):
             self.stats.total_passes += 1
@@ -345,6 +452,8 @@ class PeepholeOptimizer:
             result = self._single_instruction_pass(result)
             result = self._two_instruction_pass(result)
             result = self._dead_code_pass(result)
+            if dataflow is not None:
+                result = dataflow.run(result)
 
             # Check for fixpoint (no changes this pass)
             if self.stats.total_optimizations == changes_before:
@@ -398,12 +507,14 @@ class PeepholeOptimizer:
             if mnemonic == "CMPA" and imm_value == 0:
                 result.append(_make_inherent_instruction("TSTA", stmt.location))
                 self.stats.compare_zero += 1
+                self.stats.add_savings([stmt], result[-1:])
                 continue
 
             # CMPB #0 → TSTB (flag-safe: both set N, Z based on B; V=0)
             if mnemonic == "CMPB" and imm_value == 0:
                 result.append(_make_inherent_instruction("TSTB", stmt.location))
                 self.stats.compare_zero += 1
+                self.stats.add_savings([stmt], result[-1:])
                 continue
 
             # No optimization applied - keep original
@@ -477,6 +588,7 @@ class PeepholeOptimizer:
                     # Both have inherent operands by definition
                     # Remove both instructions
                     self.stats.push_pull_pairs += 1
+                    self.stats.add_savings([stmt1, stmt2])
                     i += 2  # Skip both
                     continue
 
@@ -489,6 +601,7 @@ class PeepholeOptimizer:
                     # Second load is redundant
                     result.append(stmt1)
                     self.stats.redundant_load += 1
+                    self.stats.add_savings([stmt2])
                     i += 2  # Skip second instruction
                     continue
 
@@ -497,6 +610,7 @@ class PeepholeOptimizer:
             if stmt1.mnemonic == "TSX" and stmt2.mnemonic == "TSX":
                 # Skip first TSX, keep second
                 self.stats.redundant_tsx += 1
+                self.stats.add_savings([stmt1])
                 i += 1  # Only skip first, second will be kept in next iteration
                 continue
 
@@ -557,6 +671,7 @@ class PeepholeOptimizer:
             if skip_until_label:
                 if isinstance(stmt, Instruction):
                     self.stats.dead_code += 1
+                    self.stats.add_savings([stmt])
                 continue
 
             # Check for unconditional control transfer
@@ -574,6 +689,1238 @@ class PeepholeOptimizer:
         return result
 
 
+# =============================================================================
+# Dataflow Optimization
+# =============================================================================
+#
+# The peephole passes above only ever look at neighbouring instructions.
+# The dataflow stage splits the statement list into basic blocks, links
+# them into a control-flow graph and runs two analyses over it:
+#
+#   - Known values (forward): what A, B, D and X are known to hold - a
+#     constant or a copy of a memory location - which register the N and
+#     Z flags describe, whether C is known, and how far X sits from SP.
+#   - Liveness (backward): which of A, B, X and the H/N/Z/V/C flags may
+#     still be read before they are written again.
+#
+# Known values remove loads of a value the register already holds, TSX
+# when X already equals SP+1 and tests of flags that are already set, and
+# decide some conditional branches at assembly time. Branches are threaded
+# past code whose outcome is known. Liveness removes register writes that
+# are never read.
+#
+# Labels are the main hazard: code outside the file, or a computed jump,
+# may arrive at a label without passing any edge we can see. A label is
+# "closed" only if every reference to it in the file is the target of a
+# branch or a plain JMP. Any other use - JSR, BSR, an address in data or an
+# expression - makes it "open", and nothing is assumed on entry to it.
+
+# Resources tracked by liveness (D is A and B together)
+_REGISTERS = frozenset({"A", "B", "X"})
+_FLAGS = frozenset({"H", "N", "Z", "V", "C"})
+_ALL_RESOURCES = _REGISTERS | _FLAGS
+_NO_RESOURCES: frozenset = frozenset()
+
+
+def _effect_table(table: dict[str, tuple[str, str]]) -> dict[str, tuple[frozenset, frozenset]]:
+    """Turn {"MNEMONIC": ("uses", "defines")} specs into resource sets."""
+    return {
+        mnemonic: (frozenset(uses.split()), frozenset(defines.split()))
+        for mnemonic, (uses, defines) in table.items()
+    }
+
+
+# Instructions that read their operand and write only registers and flags.
+# The operand's own use of X (indexed mode) is added separately.
+_READ_EFFECTS = _effect_table({
+    "LDAA": ("", "A N Z V"), "LDAB": ("", "B N Z V"),
+    "LDD": ("", "A B N Z V"), "LDX": ("", "X N Z V"),
+    "ADDA": ("A", "A H N Z V C"), "ADDB": ("B", "B H N Z V C"),
+    "ADCA": ("A C", "A H N Z V C"), "ADCB": ("B C", "B H N Z V C"),
+    "SUBA": ("A", "A N Z V C"), "SUBB": ("B", "B N Z V C"),
+    "SBCA": ("A C", "A N Z V C"), "SBCB": ("B C", "B N Z V C"),
+    "ANDA": ("A", "A N Z V"), "ANDB": ("B", "B N Z V"),
+    "ORAA": ("A", "A N Z V"), "ORAB": ("B", "B N Z V"),
+    "EORA": ("A", "A N Z V"), "EORB": ("B", "B N Z V"),
+    "BITA": ("A", "N Z V"), "BITB": ("B", "N Z V"),
+    "CMPA": ("A", "N Z V C"), "CMPB": ("B", "N Z V C"),
+    "ADDD": ("A B", "A B N Z V C"), "SUBD": ("A B", "A B N Z V C"),
+    "CPX": ("X", "N Z V C"),
+    "TST": ("", "N Z V C"), "TIM": ("", "N Z V"),
+})
+
+# Inherent instructions that touch nothing but registers and flags
+_REGISTER_EFFECTS = _effect_table({
+    "ABA": ("A B", "A H N Z V C"), "SBA": ("A B", "A N Z V C"),
+    "CBA": ("A B", "N Z V C"),
+    "TAB": ("A", "B N Z V"), "TBA": ("B", "A N Z V"),
+    "TPA": ("H N Z V C", "A"),
+    "ASLD": ("A B", "A B N Z V C"), "LSLD": ("A B", "A B N Z V C"),
+    "LSRD": ("A B", "A B N Z V C"),
+    "MUL": ("A B", "A B C"), "DAA": ("A C H", "A N Z V C"),
+    "XGDX": ("A B X", "A B X"), "ABX": ("B X", "X"),
+    "INX": ("X", "X Z"), "DEX": ("X", "X Z"), "TSX": ("", "X"),
+    "NEGA": ("A", "A N Z V C"), "NEGB": ("B", "B N Z V C"),
+    "COMA": ("A", "A N Z V C"), "COMB": ("B", "B N Z V C"),
+    "LSRA": ("A", "A N Z V C"), "LSRB": ("B", "B N Z V C"),
+    "ASRA": ("A", "A N Z V C"), "ASRB": ("B", "B N Z V C"),
+    "ASLA": ("A", "A N Z V C"), "ASLB": ("B", "B N Z V C"),
+    "LSLA": ("A", "A N Z V C"), "LSLB": ("B", "B N Z V C"),
+    "RORA": ("A C", "A N Z V C"), "RORB": ("B C", "B N Z V C"),
+    "ROLA": ("A C", "A N Z V C"), "ROLB": ("B C", "B N Z V C"),
+    "DECA": ("A", "A N Z V"), "DECB": ("B", "B N Z V"),
+    "INCA": ("A", "A N Z V"), "INCB": ("B", "B N Z V"),
+    "TSTA": ("A", "N Z V C"), "TSTB": ("B", "N Z V C"),
+    "CLRA": ("", "A N Z V C"), "CLRB": ("", "B N Z V C"),
+    "CLC": ("", "C"), "SEC": ("", "C"), "CLV": ("", "V"), "SEV": ("", "V"),
+})
+
+# Instructions that write their operand in memory
+_WRITE_EFFECTS = _effect_table({
+    "STAA": ("A", "N Z V"), "STAB": ("B", "N Z V"),
+    "STD": ("A B", "N Z V"), "STX": ("X", "N Z V"), "STS": ("", "N Z V"),
+    "NEG": ("", "N Z V C"), "COM": ("", "N Z V C"),
+    "LSR": ("", "N Z V C"), "ASR": ("", "N Z V C"),
+    "ASL": ("", "N Z V C"), "LSL": ("", "N Z V C"),
+    "ROR": ("C", "N Z V C"), "ROL": ("C", "N Z V C"),
+    "DEC": ("", "N Z V"), "INC": ("", "N Z V"), "CLR": ("", "N Z V C"),
+    "AIM": ("", "N Z V"), "OIM": ("", "N Z V"), "EIM": ("", "N Z V"),
+})
+
+# Instructions that move SP
+_STACK_EFFECTS = _effect_table({
+    "PSHA": ("A", ""), "PSHB": ("B", ""), "PSHX": ("X", ""),
+    "PULA": ("", "A"), "PULB": ("", "B"), "PULX": ("", "X"),
+    "INS": ("", ""), "DES": ("", ""), "TXS": ("X", ""),
+})
+
+# Flags each branch reads
+_BRANCH_USES = {
+    mnemonic: frozenset(uses.split()) for mnemonic, uses in {
+        "BRA": "", "BRN": "",
+        "BEQ": "Z", "BNE": "Z",
+        "BCC": "C", "BHS": "C", "BCS": "C", "BLO": "C",
+        "BVC": "V", "BVS": "V", "BPL": "N", "BMI": "N",
+        "BHI": "C Z", "BLS": "C Z",
+        "BGE": "N V", "BLT": "N V", "BGT": "N V Z", "BLE": "N V Z",
+    }.items()
+}
+
+# Loads and the register they fill
+_LOADS = {"LDAA": "A", "LDAB": "B", "LDD": "D", "LDX": "X"}
+
+# Stores and the register they write out
+_STORES = {"STAA": "A", "STAB": "B", "STD": "D", "STX": "X"}
+
+# Register that N and Z describe afterwards, with V clear
+_FLAG_SOURCE = {
+    "LDAA": "A", "LDAB": "B", "LDD": "D", "LDX": "X",
+    "STAA": "A", "STAB": "B", "STD": "D", "STX": "X",
+    "TAB": "B", "TBA": "A", "TSTA": "A", "TSTB": "B",
+    "CLRA": "A", "CLRB": "B", "COMA": "A", "COMB": "B",
+    "ANDA": "A", "ORAA": "A", "EORA": "A",
+    "ANDB": "B", "ORAB": "B", "EORB": "B",
+}
+
+# Tests against zero: they set N and Z from the register, clear V and
+# (except TST) clear C, and leave the register itself unchanged
+_ZERO_TESTS = {
+    "TSTA": "A", "TSTB": "B", "CMPA": "A", "CMPB": "B", "SUBD": "D", "CPX": "X",
+}
+
+# Known carry after instructions that always set it the same way
+_CARRY_RESULT = {
+    "CLC": False, "SEC": True, "CLRA": False, "CLRB": False, "CLR": False,
+    "TSTA": False, "TSTB": False, "TST": False,
+    "COMA": True, "COMB": True, "COM": True,
+}
+
+# Directives that emit nothing and don't interrupt the instruction stream
+_TRANSPARENT_DIRECTIVES = frozenset({
+    "EQU", "SET", "MODEL", "LIST", "NOLIST", "PAGE", "TITLE",
+})
+
+# Width in bits of each tracked register, and the registers it is made of
+_REGISTER_BITS = {"A": 8, "B": 8, "D": 16, "X": 16}
+_REGISTER_PARTS = {
+    "A": frozenset("A"), "B": frozenset("B"), "D": frozenset("AB"), "X": frozenset("X"),
+}
+
+def _effects(instr: Instruction) -> tuple[frozenset, frozenset]:
+    """
+    Resources an instruction reads and writes, for liveness.
+
+    Anything not in the tables above (calls, returns, SWI, TAP, LDS, ...)
+    is assumed to read everything and write nothing, which keeps every
+    earlier value alive.
+    """
+    mnemonic = instr.mnemonic
+    for table in (_READ_EFFECTS, _REGISTER_EFFECTS, _WRITE_EFFECTS, _STACK_EFFECTS):
+        if mnemonic in table:
+            uses, defines = table[mnemonic]
+            break
+    else:
+        if mnemonic in _BRANCH_USES:
+            return _BRANCH_USES[mnemonic], _NO_RESOURCES
+        if mnemonic == "JMP":
+            uses = _NO_RESOURCES
+            defines = _NO_RESOURCES
+        else:
+            return _ALL_RESOURCES, _NO_RESOURCES
+    if _operand_mode(instr) in (ParsedAddressingMode.INDEXED, ParsedAddressingMode.IMMEDIATE_INDEXED):
+        uses = uses | {"X"}
+    return uses, defines
+
+
+def _jump_target(instr: Instruction) -> Optional[str]:
+    """
+    Label a branch or JMP goes to, if its operand is just that label.
+
+    BSR is a call, not a jump, and returns None like any computed target.
+    """
+    operand = instr.operand
+    if operand is None or len(operand.tokens) != 1:
+        return None
+    token = operand.tokens[0]
+    if token.type != TokenType.IDENTIFIER:
+        return None
+    mnemonic = instr.mnemonic
+    if mnemonic in _BRANCH_USES and operand.mode == ParsedAddressingMode.RELATIVE:
+        return str(token.value)
+    if (mnemonic == "JMP" and operand.mode == ParsedAddressingMode.DIRECT_OR_EXTENDED
+            and not operand.is_force_direct):
+        return str(token.value)
+    return None
+
+
+def _is_local_name(name: str) -> bool:
+    """Local labels start with '.' or '@' and belong to the last global label."""
+    return name.startswith((".", "@"))
+
+
+def _label_key(name: str, scope: Optional[str]) -> tuple[Optional[str], str]:
+    """Symbol-table identity of a label name as seen from a given scope."""
+    name = name.upper()
+    return (scope, name) if _is_local_name(name) else (None, name)
+
+
+def _identifiers(tokens) -> list[str]:
+    """Upper-cased identifiers in a token list (or nested token lists)."""
+    names = []
+    for item in tokens or ():
+        if isinstance(item, Token):
+            if item.type == TokenType.IDENTIFIER:
+                names.append(str(item.value).upper())
+        elif isinstance(item, (list, tuple)):
+            names.extend(_identifiers(item))
+    return names
+
+
+def _branch_outcome(mnemonic: str, facts: "_Facts") -> Optional[bool]:
+    """
+    Whether a conditional branch is taken, if the flags are known.
+
+    The flags are known when N and Z describe a register holding a known
+    constant (V is then clear); C comes from the carry fact.
+    """
+    if facts.flags_of is None:
+        return None
+    constants = [v[1] for v in facts.values[facts.flags_of] if v[0] == "imm"]
+    if not constants:
+        return None
+    bits = _REGISTER_BITS[facts.flags_of]
+    value = constants[0]
+    n = bool(value >> (bits - 1))
+    z = value == 0
+    v = False
+    c = facts.carry
+
+    conditions = {
+        "BEQ": lambda: z, "BNE": lambda: not z,
+        "BMI": lambda: n, "BPL": lambda: not n,
+        "BVS": lambda: v, "BVC": lambda: not v,
+        "BGE": lambda: n == v, "BLT": lambda: n != v,
+        "BGT": lambda: not z and n == v, "BLE": lambda: z or n != v,
+    }
+    if mnemonic in conditions:
+        return conditions[mnemonic]()
+    if c is None:
+        return None
+    carry_conditions = {
+        "BCS": c, "BLO": c, "BCC": not c, "BHS": not c,
+        "BHI": not c and not z, "BLS": c or z,
+    }
+    return carry_conditions.get(mnemonic)
+
+
+@dataclass
+class _Facts:
+    """
+    What is known about the machine state at one point of the program.
+
+    Attributes:
+        values: For A, B, D and X, the set of things the register is known
+            to equal: ("imm", n), ("sym", tokens) for a symbolic immediate,
+            ("idx", k, width) for the memory at k,X (X pointing into the
+            stack), ("abs", label, k, width) for the memory at label+k
+        xsp: X - (SP + 1), the value TSX would make zero, or None
+        flags_of: Register that N and Z currently describe (with V clear)
+        carry: Known value of C, or None
+    """
+    values: dict = field(default_factory=lambda: {r: frozenset() for r in _REGISTER_BITS})
+    xsp: Optional[int] = None
+    flags_of: Optional[str] = None
+    carry: Optional[bool] = None
+
+    def copy(self) -> "_Facts":
+        return _Facts(dict(self.values), self.xsp, self.flags_of, self.carry)
+
+    def meet(self, other: "_Facts") -> "_Facts":
+        """Facts that hold on both of two incoming paths."""
+        result = _Facts(
+            {r: self.values[r] & other.values[r] for r in _REGISTER_BITS},
+            self.xsp if self.xsp == other.xsp else None,
+            self.flags_of if self.flags_of == other.flags_of else None,
+            self.carry if self.carry == other.carry else None,
+        )
+        if result.xsp is None:
+            result.forget(lambda key: key[0] == "idx")
+        return result
+
+    def forget(self, predicate) -> None:
+        """Drop every value for which predicate(value) is true."""
+        for reg, known in self.values.items():
+            if any(predicate(v) for v in known):
+                self.values[reg] = frozenset(v for v in known if not predicate(v))
+
+    def set_register(self, reg: str, known) -> None:
+        """Record a new value for a register, keeping A/B and D consistent."""
+        known = frozenset(known)
+        if reg == "D":
+            self.values["D"] = known
+            self.values["A"] = frozenset(filter(None, (_half(v, 0) for v in known)))
+            self.values["B"] = frozenset(filter(None, (_half(v, 1) for v in known)))
+        elif reg in ("A", "B"):
+            self.values[reg] = known
+            self.values["D"] = _join(self.values["A"], self.values["B"])
+        else:
+            # Indexed facts are relative to X, so they go with the old X;
+            # callers that know where the new X points set xsp again
+            self.forget(lambda key: key[0] == "idx")
+            self.values["X"] = frozenset(v for v in known if v[0] != "idx")
+            self.xsp = None
+        if self.flags_of is not None and _REGISTER_PARTS[reg] & _REGISTER_PARTS[self.flags_of]:
+            self.flags_of = None
+
+    def learn(self, reg: str, key: tuple) -> None:
+        """Note that a register also equals a memory location (after a store)."""
+        if reg == "D":
+            self.values["D"] = self.values["D"] | {key}
+            self.values["A"] = self.values["A"] | {_half(key, 0)}
+            self.values["B"] = self.values["B"] | {_half(key, 1)}
+        else:
+            self.values[reg] = self.values[reg] | {key}
+            if reg in ("A", "B"):
+                self.values["D"] = self.values["D"] | _join(self.values["A"], self.values["B"])
+
+    def clear(self) -> None:
+        """Forget everything."""
+        self.values = {r: frozenset() for r in _REGISTER_BITS}
+        self.xsp = None
+        self.flags_of = None
+        self.carry = None
+
+
+def _half(value: tuple, part: int) -> Optional[tuple]:
+    """High (part 0) or low (part 1) byte of a 16-bit value fact."""
+    if value[0] == "imm":
+        return ("imm", (value[1] >> 8) & 0xFF if part == 0 else value[1] & 0xFF)
+    if value[0] == "idx" and value[2] == 2:
+        return ("idx", value[1] + part, 1)
+    if value[0] == "abs" and value[3] == 2:
+        return ("abs", value[1], value[2] + part, 1)
+    return None
+
+
+def _join(high: frozenset, low: frozenset) -> frozenset:
+    """D value facts implied by the facts about A and B."""
+    joined = set()
+    for h in high:
+        for lo in low:
+            if h[0] == lo[0] == "imm":
+                joined.add(("imm", (h[1] << 8) | lo[1]))
+            elif h[0] == lo[0] == "idx" and lo[1] == h[1] + 1:
+                joined.add(("idx", h[1], 2))
+            elif h[0] == lo[0] == "abs" and h[1] == lo[1] and lo[2] == h[2] + 1:
+                joined.add(("abs", h[1], h[2], 2))
+    return frozenset(joined)
+
+
+@dataclass
+class BasicBlock:
+    """
+    A run of instructions entered only at the top and left only at the end.
+
+    Attributes:
+        start: Index of the block's first statement
+        labels: Label keys defined at the top of the block
+        instructions: Statement indexes of the block's instructions
+        successors: Blocks control can pass to
+        predecessors: Blocks control can arrive from
+        entry_unknown: Code we can't see may jump here (open label, start
+            of file, after data)
+        exit_unknown: Control may leave to code we can't see
+        falls_into: Block reached by falling off the end, if any
+    """
+    start: int
+    labels: list = field(default_factory=list)
+    instructions: list[int] = field(default_factory=list)
+    successors: set[int] = field(default_factory=set)
+    predecessors: set[int] = field(default_factory=set)
+    entry_unknown: bool = False
+    exit_unknown: bool = False
+    falls_into: Optional[int] = None
+
+
+class ControlFlowGraph:
+    """
+    Basic blocks and control-flow edges of a statement list.
+
+    Blocks start at labels and after branches and jumps. Directives that
+    emit data or change the location counter end the block before them,
+    and the code after them is treated as reachable from anywhere.
+
+    Attributes:
+        statements: The statement list the graph describes
+        blocks: Basic blocks in program order
+        block_of: Statement index of each instruction -> block index
+        label_block: Label key -> index of the block it starts
+        scope: Statement index -> global label in effect there
+    """
+
+    def __init__(self, statements: list[Statement], closed_labels: frozenset):
+        self.statements = statements
+        self.blocks: list[BasicBlock] = []
+        self.block_of: dict[int, int] = {}
+        self.label_block: dict[tuple, int] = {}
+        self.scope: list[Optional[str]] = []
+        self._build(closed_labels)
+
+    def _build(self, closed_labels: frozenset) -> None:
+        current: Optional[BasicBlock] = None
+        after_barrier = True        # Start of file counts as a barrier
+        scope: Optional[str] = None
+
+        def start_block(index: int) -> BasicBlock:
+            nonlocal current, after_barrier
+            block = BasicBlock(start=index, entry_unknown=after_barrier)
+            if current is not None and not after_barrier and self._falls_through(current):
+                current.falls_into = len(self.blocks)
+            self.blocks.append(block)
+            current = block
+            after_barrier = False
+            return block
+
+        for index, stmt in enumerate(self.statements):
+            if isinstance(stmt, LabelDef) and not stmt.is_local:
+                scope = stmt.name.upper()
+            self.scope.append(scope)
+
+            if isinstance(stmt, LabelDef):
+                if current is None or current.instructions or after_barrier:
+                    start_block(index)
+                key = _label_key(stmt.name, scope)
+                current.labels.append(key)
+                self.label_block[key] = len(self.blocks) - 1
+                if stmt.name.upper() not in closed_labels:
+                    current.entry_unknown = True
+
+            elif isinstance(stmt, Instruction):
+                if current is None or after_barrier or (
+                        current.instructions and self._ends_block(
+                            self.statements[current.instructions[-1]])):
+                    start_block(index)
+                current.instructions.append(index)
+                self.block_of[index] = len(self.blocks) - 1
+
+            elif isinstance(stmt, Directive) and stmt.name.upper() in _TRANSPARENT_DIRECTIVES:
+                continue
+
+            else:
+                # Data, ORG, INCLUDE and friends: whatever follows may be
+                # entered from code we can't see
+                if current is not None and self._falls_through(current):
+                    current.exit_unknown = True
+                current = None
+                after_barrier = True
+
+        if current is not None and self._falls_through(current):
+            current.exit_unknown = True
+
+        self._link()
+
+    @staticmethod
+    def _ends_block(instr: Instruction) -> bool:
+        """Branches, jumps and returns end a block."""
+        return instr.mnemonic in _BRANCH_USES or instr.mnemonic in ("JMP", "RTS", "RTI")
+
+    def _falls_through(self, block: BasicBlock) -> bool:
+        """Whether control can run off the end of a block."""
+        if not block.instructions:
+            return True
+        last = self.statements[block.instructions[-1]].mnemonic
+        return last not in ("BRA", "JMP", "RTS", "RTI")
+
+    def _link(self) -> None:
+        for block in self.blocks:
+            if block.falls_into is not None:
+                block.successors.add(block.falls_into)
+            if not block.instructions:
+                continue
+            last = block.instructions[-1]
+            instr = self.statements[last]
+            if instr.mnemonic in _BRANCH_USES or instr.mnemonic == "JMP":
+                target = self.target_block(last)
+                if target is None:
+                    block.exit_unknown = True
+                else:
+                    block.successors.add(target)
+        for number, block in enumerate(self.blocks):
+            for successor in block.successors:
+                self.blocks[successor].predecessors.add(number)
+
+    def target_block(self, index: int) -> Optional[int]:
+        """Block a branch or JMP at a statement index goes to, if known."""
+        name = _jump_target(self.statements[index])
+        if name is None:
+            return None
+        return self.label_block.get(_label_key(name, self.scope[index]))
+
+    def liveness(self, overrides: Optional[dict] = None) -> list[frozenset]:
+        """
+        Resources live on exit from each block.
+
+        Args:
+            overrides: Statement index -> (uses, defines) to use instead of
+                the instruction's own effects
+        """
+        overrides = overrides or {}
+        live_in = [_NO_RESOURCES] * len(self.blocks)
+        live_out = [_NO_RESOURCES] * len(self.blocks)
+        changed = True
+        while changed:
+            changed = False
+            for number in reversed(range(len(self.blocks))):
+                block = self.blocks[number]
+                live = _ALL_RESOURCES if block.exit_unknown else _NO_RESOURCES
+                for successor in block.successors:
+                    live = live | live_in[successor]
+                live_out[number] = live
+                for index in reversed(block.instructions):
+                    uses, defines = overrides.get(index) or _effects(self.statements[index])
+                    live = (live - defines) | uses
+                if live != live_in[number]:
+                    live_in[number] = live
+                    changed = True
+        return live_out
+
+
+def _closed_labels(statements: list[Statement]) -> set[str]:
+    """
+    Labels whose every reference in the file is a branch or JMP target.
+
+    Control can reach these only along edges the graph can see. Labels
+    that are never referenced, or are used in any other way, are open.
+    """
+    jumps: set[str] = set()
+    others: set[str] = set()
+    for stmt in statements:
+        if isinstance(stmt, Instruction):
+            target = _jump_target(stmt)
+            if target is not None:
+                jumps.add(target.upper())
+            elif stmt.operand is not None:
+                others.update(_identifiers(stmt.operand.tokens))
+                others.update(_identifiers(stmt.operand.mask_tokens))
+        elif isinstance(stmt, Directive):
+            others.update(_identifiers(stmt.arguments))
+    return jumps - others
+
+
+def _data_labels(statements: list[Statement]) -> dict[str, int]:
+    """
+    Labels of RMB/FCB/FDB data in the file, with their size in bytes.
+
+    Memory under these labels belongs to the program, so loads from it can
+    be tracked. Data whose size isn't a plain count is left out.
+    """
+    sizes: dict[str, int] = {}
+    for index, stmt in enumerate(statements):
+        if not isinstance(stmt, Directive) or not stmt.label:
+            continue
+        name = stmt.name.upper()
+        args = stmt.arguments
+        if name == "RMB" and len(args) == 1 and len(args[0]) == 1 and args[0][0].type == TokenType.NUMBER:
+            size = args[0][0].value
+        elif name == "FCB":
+            size = len(args)
+        elif name == "FDB":
+            size = 2 * len(args)
+        else:
+            continue
+        sizes[stmt.label.upper()] = size
+    return sizes
+
+
+def _constant_offset(tokens: list[Token]) -> Optional[int]:
+    """Offset of an indexed operand if it is a plain number (or empty)."""
+    if not tokens:
+        return 0
+    if len(tokens) == 1 and tokens[0].type == TokenType.NUMBER:
+        return tokens[0].value
+    return None
+
+
+def _symbol_offset(tokens: list[Token]) -> Optional[tuple[str, int]]:
+    """Split a 'label', 'label+n' or 'label-n' operand into its parts."""
+    if not tokens or tokens[0].type != TokenType.IDENTIFIER:
+        return None
+    name = str(tokens[0].value).upper()
+    if len(tokens) == 1:
+        return name, 0
+    if len(tokens) == 3 and tokens[2].type == TokenType.NUMBER:
+        if tokens[1].type == TokenType.PLUS:
+            return name, tokens[2].value
+        if tokens[1].type == TokenType.MINUS:
+            return name, -tokens[2].value
+    return None
+
+
+class DataflowOptimizer:
+    """
+    Optimizations that need the control-flow graph of the whole file.
+
+    Each call to run() makes one round of three steps, each on a freshly
+    built graph:
+
+    1. Known values: remove loads of a value the register already holds,
+       TSX when X already equals SP+1, and tests whose flags are already
+       set; turn branches whose outcome is known into BRA or nothing.
+    2. Branches: drop branches to the next instruction, turn
+       "Bcc L1 / BRA L2 / L1:" into one inverted branch, replace a jump to
+       RTS by RTS, and thread branches past blocks whose outcome is known
+       from the facts on the branch's own path.
+    3. Dead code: remove register writes that are never read, turn a PULA
+       or PULB of a dead register into INS, and remove blocks no path
+       reaches.
+
+    PeepholeOptimizer calls run() from its fixpoint loop, so rounds repeat
+    until nothing changes. Files with macros or conditional assembly are
+    left alone (see applicable()).
+
+    Attributes:
+        stats: Statistics updated with each rewrite
+        closed_labels: Names of labels only reached along visible edges
+        data_labels: Data label name -> size in bytes
+    """
+
+    # Instructions a thread may skip over per branch
+    MAX_THREAD_LENGTH = 8
+
+    # Rounds of the known-values solver before it gives up and assumes
+    # nothing (never reached on real programs: the facts only shrink)
+    MAX_SOLVER_ROUNDS = 100
+
+    def __init__(self, statements: list[Statement], stats: OptimizationStats):
+        """
+        Prepare to optimize a statement list.
+
+        Args:
+            statements: The statements run() will be given (label uses are
+                collected from them once, up front)
+            stats: Statistics object to update
+        """
+        self.stats = stats
+        self.closed_labels = _closed_labels(statements)
+        self.data_labels = _data_labels(statements)
+        self._set_symbols = {
+            stmt.label.upper() for stmt in statements
+            if isinstance(stmt, Directive) and stmt.name.upper() == "SET" and stmt.label
+        }
+        # New labels are global, which would rescope local labels after them
+        self._can_add_labels = not any(
+            isinstance(stmt, LabelDef) and stmt.is_local for stmt in statements)
+        self._names = {
+            stmt.name.upper() for stmt in statements if isinstance(stmt, LabelDef)
+        } | self.closed_labels
+        self._label_count = 0
+
+    @staticmethod
+    def applicable(statements: list[Statement]) -> bool:
+        """
+        Whether the statement list can be analysed.
+
+        Macro bodies and conditional blocks hide instructions and labels
+        from the graph, so their presence disables the dataflow stage.
+        """
+        return not any(
+            isinstance(stmt, (MacroDef, MacroCall, ConditionalBlock)) for stmt in statements)
+
+    def run(self, statements: list[Statement]) -> list[Statement]:
+        """Apply one round of dataflow optimizations."""
+        statements = self._apply_known_values(statements)
+        statements = self._apply_branch_rewrites(statements)
+        statements = self._apply_dead_code(statements)
+        return statements
+
+    # =========================================================================
+    # Known Values
+    # =========================================================================
+
+    def _solve(self, cfg: ControlFlowGraph) -> tuple[list, list]:
+        """
+        Facts on entry to and exit from every block.
+
+        Blocks no path reaches get None. Blocks that code we can't see may
+        enter start from nothing known.
+        """
+        count = len(cfg.blocks)
+        entry: list[Optional[_Facts]] = [None] * count
+        exit_facts: list[Optional[_Facts]] = [None] * count
+
+        changed = True
+        rounds = 0
+        while changed:
+            changed = False
+            rounds += 1
+            for number, block in enumerate(cfg.blocks):
+                if block.entry_unknown or rounds > self.MAX_SOLVER_ROUNDS:
+                    facts = _Facts()
+                else:
+                    incoming = [exit_facts[p] for p in block.predecessors
+                                if exit_facts[p] is not None]
+                    if not incoming:
+                        continue
+                    facts = incoming[0]
+                    for other in incoming[1:]:
+                        facts = facts.meet(other)
+                if facts == entry[number]:
+                    continue
+                entry[number] = facts
+                facts = facts.copy()
+                for index in block.instructions:
+                    self._transfer(facts, cfg.statements[index])
+                exit_facts[number] = facts
+                changed = True
+        return entry, exit_facts
+
+    def _immediate_key(self, operand: Operand, bits: int) -> Optional[tuple]:
+        """Value fact for an immediate operand, if it is a fixed value."""
+        tokens = operand.tokens
+        if len(tokens) == 1 and tokens[0].type == TokenType.NUMBER:
+            return ("imm", tokens[0].value & ((1 << bits) - 1))
+        if not tokens or any(t.type in (TokenType.STAR, TokenType.DOLLAR) for t in tokens):
+            return None
+        if set(_identifiers(tokens)) & self._set_symbols:
+            return None
+        return ("sym", tuple((t.type.name, str(t.value).upper()) for t in tokens))
+
+    def _memory_key(self, facts: _Facts, operand: Operand, width: int) -> Optional[tuple]:
+        """
+        Value fact for the memory an operand addresses, if it is trackable.
+
+        Only program RAM is tracked: the stack through X when X is known
+        to point into it, and data labels defined in the file. Anything
+        else could be a hardware register.
+        """
+        if operand.mode in (ParsedAddressingMode.INDEXED, ParsedAddressingMode.IMMEDIATE_INDEXED):
+            offset = _constant_offset(operand.tokens)
+            if facts.xsp is None or offset is None:
+                return None
+            return ("idx", offset, width)
+        if operand.mode in (ParsedAddressingMode.DIRECT_OR_EXTENDED, ParsedAddressingMode.IMMEDIATE_DIRECT):
+            parsed = _symbol_offset(operand.tokens)
+            if parsed is None or operand.is_force_direct:
+                return None
+            name, offset = parsed
+            size = self.data_labels.get(name)
+            if size is not None and 0 <= offset and offset + width <= size:
+                return ("abs", name, offset, width)
+        return None
+
+    def _source_key(self, facts: _Facts, instr: Instruction, bits: int) -> Optional[tuple]:
+        """Value fact for what an instruction reads from its operand."""
+        operand = instr.operand
+        if operand is None:
+            return None
+        if operand.mode == ParsedAddressingMode.IMMEDIATE:
+            return self._immediate_key(operand, bits)
+        return self._memory_key(facts, operand, bits // 8)
+
+    def _write_memory(self, facts: _Facts, operand: Operand, width: int) -> Optional[tuple]:
+        """Forget what a memory write may overwrite; return the written key."""
+        key = self._memory_key(facts, operand, width)
+        if key is None:
+            facts.forget(lambda v: v[0] in ("idx", "abs"))
+        elif key[0] == "idx":
+            low, high = key[1], key[1] + width
+            facts.forget(lambda v: v[0] == "idx" and v[1] < high and low < v[1] + v[2])
+        else:
+            facts.forget(lambda v: v[0] == "abs" and v[1] == key[1])
+        return key
+
+    def _transfer(self, facts: _Facts, instr: Instruction) -> None:
+        """Update facts for the effect of one instruction."""
+        mnemonic = instr.mnemonic
+        operand = instr.operand
+
+        if mnemonic in _BRANCH_USES or mnemonic in ("JMP", "NOP", "CLI", "SEI"):
+            return
+
+        if mnemonic in _READ_EFFECTS:
+            defines = _READ_EFFECTS[mnemonic][1]
+            bits = 16 if mnemonic in ("LDD", "LDX", "ADDD", "SUBD", "CPX") else 8
+            source = self._source_key(facts, instr, bits)
+            zero_test = mnemonic in _ZERO_TESTS and source == ("imm", 0)
+            if mnemonic in _LOADS:
+                facts.set_register(_LOADS[mnemonic], [source] if source else [])
+            elif defines & {"A", "B"} and not zero_test:
+                facts.set_register("D" if mnemonic.endswith("D") else mnemonic[-1], [])
+            if zero_test:
+                facts.flags_of = _ZERO_TESTS[mnemonic]
+                facts.carry = False
+                return
+
+        elif mnemonic in _REGISTER_EFFECTS:
+            defines = _REGISTER_EFFECTS[mnemonic][1]
+            values = facts.values
+            if mnemonic == "TAB":
+                facts.set_register("B", values["A"])
+            elif mnemonic == "TBA":
+                facts.set_register("A", values["B"])
+            elif mnemonic in ("CLRA", "CLRB"):
+                facts.set_register(mnemonic[-1], [("imm", 0)])
+            elif mnemonic == "XGDX":
+                d, x = values["D"], values["X"]
+                facts.set_register("X", d)
+                facts.set_register("D", x)
+            elif mnemonic == "TSX":
+                if facts.xsp != 0:
+                    facts.set_register("X", [])
+                    facts.xsp = 0
+            elif mnemonic in ("INX", "DEX", "ABX"):
+                xsp = facts.xsp
+                facts.set_register("X", [])
+                if mnemonic == "ABX" or xsp is None:
+                    facts.xsp = None
+                else:
+                    facts.xsp = xsp + (1 if mnemonic == "INX" else -1)
+            elif {"A", "B"} <= defines:
+                facts.set_register("D", [])
+            elif "A" in defines or "B" in defines:
+                facts.set_register("A" if "A" in defines else "B", [])
+
+        elif mnemonic in _WRITE_EFFECTS:
+            defines = _WRITE_EFFECTS[mnemonic][1]
+            width = 2 if mnemonic in ("STD", "STX", "STS") else 1
+            key = self._write_memory(facts, operand, width)
+            if key is not None and mnemonic in _STORES:
+                facts.learn(_STORES[mnemonic], key)
+
+        elif mnemonic in _STACK_EFFECTS:
+            defines = _NO_RESOURCES
+            self._transfer_stack(facts, mnemonic)
+            return
+
+        else:
+            # Calls, returns, SWI and anything unusual: assume nothing
+            facts.clear()
+            return
+
+        if defines & {"N", "Z", "V"} and mnemonic != "CLV":
+            facts.flags_of = _FLAG_SOURCE.get(mnemonic)
+        if "C" in defines:
+            facts.carry = _CARRY_RESULT.get(mnemonic)
+
+    @staticmethod
+    def _transfer_stack(facts: _Facts, mnemonic: str) -> None:
+        """Update facts for a push, pull or other SP change."""
+        xsp = facts.xsp
+        if mnemonic in ("PSHA", "PSHB", "PSHX"):
+            width = 2 if mnemonic == "PSHX" else 1
+            if xsp is not None:
+                # The pushed bytes land at the new SP+1 onwards
+                xsp += width
+                low, high = -xsp, -xsp + width
+                facts.forget(lambda v: v[0] == "idx" and v[1] < high and low < v[1] + v[2])
+        elif mnemonic in ("PULA", "PULB"):
+            facts.set_register(mnemonic[-1], [])
+            xsp = None if xsp is None else xsp - 1
+        elif mnemonic == "PULX":
+            facts.set_register("X", [])
+            xsp = None
+        elif mnemonic == "INS":
+            xsp = None if xsp is None else xsp - 1
+        elif mnemonic == "DES":
+            xsp = None if xsp is None else xsp + 1
+        elif mnemonic == "TXS":
+            xsp = 0
+        facts.xsp = xsp
+        if xsp is None:
+            facts.forget(lambda v: v[0] == "idx")
+        else:
+            # Memory below SP is overwritten by any interrupt
+            facts.forget(lambda v: v[0] == "idx" and v[1] < -xsp)
+
+    def _known_value_rewrite(self, instr: Instruction, facts: _Facts) -> Optional[tuple]:
+        """
+        Rewrite of one instruction justified by the facts before it.
+
+        Returns (statistic, flags that must be dead afterwards, replacement
+        statements), or None.
+        """
+        mnemonic = instr.mnemonic
+        if mnemonic in _LOADS:
+            reg = _LOADS[mnemonic]
+            source = self._source_key(facts, instr, _REGISTER_BITS[reg])
+            if source is not None and source in facts.values[reg]:
+                needed = _NO_RESOURCES if facts.flags_of == reg else frozenset({"N", "Z", "V"})
+                return ("redundant_load", needed, [])
+        elif mnemonic == "TSX":
+            if facts.xsp == 0:
+                return ("redundant_tsx", _NO_RESOURCES, [])
+        elif mnemonic in _ZERO_TESTS:
+            reg = _ZERO_TESTS[mnemonic]
+            if _is_inherent(instr.operand) or self._source_key(facts, instr, _REGISTER_BITS[reg]) == ("imm", 0):
+                if facts.flags_of == reg:
+                    needed = _NO_RESOURCES if facts.carry is False else frozenset({"C"})
+                    return ("redundant_test", needed, [])
+        elif mnemonic in CONDITIONAL_BRANCHES:
+            taken = _branch_outcome(mnemonic, facts)
+            if taken:
+                return ("branch_fold", _NO_RESOURCES,
+                        [Instruction(location=instr.location, mnemonic="BRA", operand=instr.operand)])
+            if taken is False:
+                return ("branch_fold", _NO_RESOURCES, [])
+        return None
+
+    def _apply_known_values(self, statements: list[Statement]) -> list[Statement]:
+        """Step 1: rewrites justified by known register and flag values."""
+        cfg = ControlFlowGraph(statements, self.closed_labels)
+        entry, _ = self._solve(cfg)
+
+        candidates: dict[int, tuple] = {}
+        for number, block in enumerate(cfg.blocks):
+            if entry[number] is None:
+                continue
+            facts = entry[number].copy()
+            for index in block.instructions:
+                found = self._known_value_rewrite(statements[index], facts)
+                if found is not None:
+                    candidates[index] = found
+                self._transfer(facts, statements[index])
+        if not candidates:
+            return statements
+
+        # A removed instruction no longer sets anything, so measure the
+        # flags each removal needs dead as if all removals had happened
+        overrides = {
+            index: (_effects(statements[index])[0], _NO_RESOURCES)
+            for index, (_, _, replacement) in candidates.items() if not replacement
+        }
+        live_out = cfg.liveness(overrides)
+
+        edits: dict[int, list[Statement]] = {}
+        for number, block in enumerate(cfg.blocks):
+            live = live_out[number]
+            for index in reversed(block.instructions):
+                uses, defines = overrides.get(index) or _effects(statements[index])
+                if index in candidates:
+                    stat, needed, replacement = candidates[index]
+                    if not needed & live:
+                        edits[index] = replacement
+                        self._count(stat, [statements[index]], replacement)
+                live = (live - defines) | uses
+        return self._apply(statements, edits)
+
+    # =========================================================================
+    # Branch Rewrites
+    # =========================================================================
+
+    @staticmethod
+    def _live_in(cfg: ControlFlowGraph, live_out: list[frozenset]) -> list[frozenset]:
+        """Resources live on entry to each block."""
+        live_in = []
+        for number, block in enumerate(cfg.blocks):
+            live = live_out[number]
+            for index in reversed(block.instructions):
+                uses, defines = _effects(cfg.statements[index])
+                live = (live - defines) | uses
+            live_in.append(live)
+        return live_in
+
+    def _skippable(self, instr: Instruction, facts: _Facts) -> bool:
+        """
+        Whether an instruction only computes registers and flags.
+
+        Such instructions can be skipped (or removed) when nothing reads
+        what they write. Memory reads qualify only for program RAM.
+        """
+        mnemonic = instr.mnemonic
+        if mnemonic in _REGISTER_EFFECTS:
+            return True
+        if mnemonic not in _READ_EFFECTS:
+            return False
+        mode = _operand_mode(instr)
+        if mode in (ParsedAddressingMode.INHERENT, ParsedAddressingMode.IMMEDIATE):
+            return True
+        width = 2 if mnemonic in ("LDD", "LDX", "ADDD", "SUBD", "CPX") else 1
+        return self._memory_key(facts, instr.operand, width) is not None
+
+    def _thread(
+        self,
+        cfg: ControlFlowGraph,
+        source: int,
+        start: int,
+        facts: _Facts,
+        live_in: list[frozenset],
+    ) -> Optional[tuple[int, list[Instruction]]]:
+        """
+        Follow the path a branch takes and find a later place to jump to.
+
+        Walks from block `start` through instructions that only compute
+        registers and flags, unconditional branches and conditional
+        branches whose outcome the facts decide. The result is the
+        furthest block reached whose live registers and flags none of the
+        skipped instructions write, with the instructions skipped to get
+        there, or None.
+        """
+        facts = facts.copy()
+        number: Optional[int] = start
+        visited = {source}
+        skipped: list[Instruction] = []
+        defined: set[str] = set()
+        best = None
+
+        while number is not None and number not in visited:
+            visited.add(number)
+            block = cfg.blocks[number]
+            if number != start and not defined & live_in[number]:
+                best = (number, list(skipped))
+
+            following = block.falls_into
+            for index in block.instructions:
+                instr = cfg.statements[index]
+                mnemonic = instr.mnemonic
+                if mnemonic in ("BRA", "JMP"):
+                    following = cfg.target_block(index)
+                elif mnemonic in CONDITIONAL_BRANCHES:
+                    taken = _branch_outcome(mnemonic, facts)
+                    if taken is None:
+                        return best
+                    if taken:
+                        following = cfg.target_block(index)
+                elif mnemonic == "BRN":
+                    pass
+                elif self._skippable(instr, facts) and len(skipped) < self.MAX_THREAD_LENGTH:
+                    defined |= _effects(instr)[1]
+                    self._transfer(facts, instr)
+                else:
+                    return best
+                skipped.append(instr)
+            number = following
+        return best
+
+    def _label_for(self, cfg: ControlFlowGraph, number: int, index: int,
+                   new_labels: dict[int, str]) -> Optional[str]:
+        """
+        Name by which the branch at `index` can reach block `number`.
+
+        Uses a label of the block visible from the branch's scope, or
+        creates one if the block has none.
+        """
+        block = cfg.blocks[number]
+        for scope, name in block.labels:
+            if scope is None or scope == cfg.scope[index]:
+                return name
+        if block.labels or not self._can_add_labels:
+            return None
+        if block.start not in new_labels:
+            while True:
+                self._label_count += 1
+                name = f"__DFO{self._label_count}"
+                if name not in self._names:
+                    break
+            self._names.add(name)
+            self.closed_labels.add(name)
+            new_labels[block.start] = name
+        return new_labels[block.start]
+
+    @staticmethod
+    def _retarget(instr: Instruction, name: str, mnemonic: Optional[str] = None) -> Instruction:
+        """Copy of a branch or JMP with a new target label."""
+        old = instr.operand
+        token = Token(TokenType.IDENTIFIER, name, instr.location.line,
+                      instr.location.column, instr.location.filename)
+        mode = ParsedAddressingMode.RELATIVE if mnemonic else old.mode
+        return Instruction(
+            location=instr.location,
+            mnemonic=mnemonic or instr.mnemonic,
+            operand=Operand(mode=mode, tokens=[token],
+                            is_force_extended=old.is_force_extended and not mnemonic),
+        )
+
+    def _follows(self, cfg: ControlFlowGraph, index: int, number: int) -> bool:
+        """Whether block `number` starts right after the statement at `index`."""
+        start = cfg.blocks[number].start
+        return start > index and all(
+            isinstance(stmt, Directive) and stmt.name.upper() in _TRANSPARENT_DIRECTIVES
+            for stmt in cfg.statements[index + 1:start])
+
+    def _apply_branch_rewrites(self, statements: list[Statement]) -> list[Statement]:
+        """Step 2: collapse and thread branches."""
+        cfg = ControlFlowGraph(statements, self.closed_labels)
+        entry, exit_facts = self._solve(cfg)
+        live_in = self._live_in(cfg, cfg.liveness())
+
+        edits: dict[int, list[Statement]] = {}
+        new_labels: dict[int, str] = {}
+        sources: set[int] = set()
+        targets: set[int] = set()
+
+        for number, block in enumerate(cfg.blocks):
+            if (entry[number] is None or not block.instructions
+                    or number in sources or number in targets):
+                continue
+            last = block.instructions[-1]
+            instr = statements[last]
+            target = cfg.target_block(last)
+            if target is None or instr.mnemonic == "BRN":
+                continue
+
+            # Branch to the very next instruction
+            if self._follows(cfg, last, target):
+                edits[last] = []
+                self._count("branch_thread", [instr])
+                sources.add(number)
+                continue
+
+            # Bcc L1 / BRA L2 / L1:  ->  inverted Bcc L2
+            following = number + 1
+            inverted = get_inverted_branch(instr.mnemonic)
+            if (inverted and following < len(cfg.blocks)
+                    and cfg.blocks[following].start == last + 1
+                    and not cfg.blocks[following].labels
+                    and following not in sources | targets
+                    and self._follows(cfg, last + 1, target)):
+                jump_index = last + 1
+                jump = statements[jump_index]
+                name = _jump_target(jump) if jump.mnemonic in ("BRA", "JMP") else None
+                if name is not None and cfg.block_of.get(jump_index) == following:
+                    replacement = self._retarget(instr, name, inverted)
+                    edits[last] = [replacement]
+                    edits[jump_index] = []
+                    self._count("branch_thread", [instr, jump], [replacement])
+                    sources.update((number, following))
+                    continue
+
+            # BRA/JMP to a block that only returns
+            target_block = cfg.blocks[target]
+            if (instr.mnemonic in ("BRA", "JMP") and len(target_block.instructions) == 1
+                    and statements[target_block.instructions[0]].mnemonic == "RTS"):
+                rts = statements[target_block.instructions[0]]
+                replacement = _make_inherent_instruction("RTS", instr.location)
+                edits[last] = [replacement]
+                self._count("branch_thread", [instr], [replacement], [rts])
+                sources.add(number)
+                continue
+
+            # Thread past code whose outcome is known
+            found = self._thread(cfg, number, target, exit_facts[number], live_in)
+            if found is None:
+                continue
+            destination, skipped = found
+            if destination in sources:
+                continue
+            name = self._label_for(cfg, destination, last, new_labels)
+            if name is None:
+                continue
+            replacement = self._retarget(instr, name)
+            edits[last] = [replacement]
+            self._count("branch_thread", [instr], [replacement], skipped)
+            sources.add(number)
+            targets.add(destination)
+
+        return self._apply(statements, edits, new_labels)
+
+    # =========================================================================
+    # Dead Code
+    # =========================================================================
+
+    def _apply_dead_code(self, statements: list[Statement]) -> list[Statement]:
+        """Step 3: remove dead register writes and unreachable blocks."""
+        cfg = ControlFlowGraph(statements, self.closed_labels)
+        entry, _ = self._solve(cfg)
+        live_out = cfg.liveness()
+
+        edits: dict[int, list[Statement]] = {}
+        for number, block in enumerate(cfg.blocks):
+            if entry[number] is None:
+                # No path reaches it and all its labels are closed
+                for index in block.instructions:
+                    edits[index] = []
+                    self._count("dead_code", [statements[index]])
+                continue
+
+            facts = entry[number].copy()
+            before: dict[int, _Facts] = {}
+            for index in block.instructions:
+                before[index] = facts.copy()
+                self._transfer(facts, statements[index])
+
+            live = live_out[number]
+            for index in reversed(block.instructions):
+                instr = statements[index]
+                uses, defines = _effects(instr)
+                if not defines & live:
+                    if defines & _REGISTERS and self._skippable(instr, before[index]):
+                        edits[index] = []
+                        self._count("dead_store", [instr])
+                        continue
+                    if instr.mnemonic in ("PULA", "PULB"):
+                        replacement = _make_inherent_instruction("INS", instr.location)
+                        edits[index] = [replacement]
+                        self._count("dead_store", [instr], [replacement])
+                live = (live - defines) | uses
+        return self._apply(statements, edits)
+
+    # =========================================================================
+    # Bookkeeping
+    # =========================================================================
+
+    def _count(self, stat: str, removed, added=(), skipped=()) -> None:
+        """Count one rewrite and what it saves."""
+        setattr(self.stats, stat, getattr(self.stats, stat) + 1)
+        self.stats.add_savings(removed, added, skipped)
+
+    @staticmethod
+    def _apply(statements: list[Statement], edits: dict[int, list[Statement]],
+               new_labels: Optional[dict[int, str]] = None) -> list[Statement]:
+        """Build the statement list with edits and new labels applied."""
+        if not edits:
+            return statements
+        new_labels = new_labels or {}
+        result: list[Statement] = []
+        for index, stmt in enumerate(statements):
+            if index in new_labels:
+                result.append(LabelDef(location=stmt.location, name=new_labels[index]))
+            if index in edits:
+                result.extend(edits[index])
+            else:
+                result.append(stmt)
+        return result
+
+
 # =============================================================================
 # Convenience Function
 # =============================================================================
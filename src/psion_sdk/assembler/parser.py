@@ -62,14 +62,15 @@ the value is known. The parser marks these as DIRECT_OR_EXTENDED.
 """
 
 from dataclasses import dataclass, field
-from typing import Optional, Union
+from pathlib import Path
+from typing import Callable, Optional, Union
 from enum import Enum, auto
 
 from psion_sdk.errors import (
     AssemblySyntaxError,
     SourceLocation,
 )
-from psion_sdk.assembler.lexer import Token, TokenType, Lexer
+from psion_sdk.assembler.lexer import Token, TokenType, Lexer, FileTokenizer, tokenize_file
 from psion_sdk.cpu import (
     AddressingMode,
     MNEMONICS,
@@ -1062,10 +1063,35 @@ class Parser:
 # Convenience Functions
 # =============================================================================
 
+# Reads and parses an included file. The code generator calls one for
+# every INCLUDE in each of its passes and for unused routine removal;
+# the statements are only read, never changed, so a caching version can
+# hand out the same list every time (see psion_sdk.cli.buildcache).
+FileParser = Callable[[Path], list[Statement]]
+
+
+def parse_file(path: Path, tokenize: FileTokenizer = tokenize_file) -> list[Statement]:
+    """
+    Tokenize and parse an included file (the default FileParser).
+
+    The file is parsed on its own, without the macros of the file that
+    includes it, as the code generator has always done for includes.
+
+    Args:
+        path: File to parse; statement filenames are str(path)
+        tokenize: Reads and tokenizes the file
+
+    Returns:
+        List of parsed statements
+    """
+    return Parser(tokenize(path), str(path)).parse()
+
+
 def parse_source(
     source: str,
     filename: str = "<input>",
-    include_paths: list[str] | None = None
+    include_paths: list[str] | None = None,
+    tokenize_include: FileTokenizer = tokenize_file,
 ) -> list[Statement]:
     """
     Convenience function to parse assembly source.
@@ -1078,29 +1104,30 @@ def parse_source(
         source: Assembly source text
         filename: Source filename for error messages
         include_paths: List of directories to search for include files
+        tokenize_include: Reads and tokenizes an included file
 
     Returns:
         List of parsed statements
     """
-    from pathlib import Path
+    lexer = Lexer(source, filename)
+    tokens = list(lexer.tokenize())
 
     # Collect macros from include files first
     macros = _collect_macros_from_includes(
-        source, filename, include_paths or [], set()
+        tokens, filename, include_paths or [], set(), tokenize_include
     )
 
     # Now parse the main source with all macros available
-    lexer = Lexer(source, filename)
-    tokens = list(lexer.tokenize())
     parser = Parser(tokens, filename, macros=macros)
     return parser.parse()
 
 
 def _collect_macros_from_includes(
-    source: str,
+    tokens: list[Token],
     filename: str,
     include_paths: list[str],
-    processed: set[str]
+    processed: set[str],
+    tokenize_include: FileTokenizer = tokenize_file,
 ) -> dict[str, MacroDef]:
     """
     Recursively collect macro definitions from include files.
@@ -1110,23 +1137,19 @@ def _collect_macros_from_includes(
     because macros must be known during parsing of the main file.
 
     Args:
-        source: Source code to scan
+        tokens: Tokens of the source to scan
         filename: Source filename for path resolution
         include_paths: Directories to search for includes
         processed: Set of already processed files (for circular detection)
+        tokenize_include: Reads and tokenizes an included file
 
     Returns:
         Dictionary of macro name -> MacroDef
     """
-    from pathlib import Path
-
     macros: dict[str, MacroDef] = {}
 
     # Quick scan for INCLUDE directives
     # We do a simple token-based scan, not a full parse
-    lexer = Lexer(source, filename)
-    tokens = list(lexer.tokenize())
-
     i = 0
     while i < len(tokens):
         tok = tokens[i]
@@ -1147,18 +1170,17 @@ def _collect_macros_from_includes(
 
                     # Recursively collect macros from included file
                     try:
-                        include_source = include_path.read_text(encoding='utf-8')
+                        child_tokens = tokenize_include(include_path)
                         child_macros = _collect_macros_from_includes(
-                            include_source,
+                            child_tokens,
                             str(include_path),
                             include_paths,
-                            processed
+                            processed,
+                            tokenize_include
                         )
                         macros.update(child_macros)
 
                         # Also parse this file for its own macro definitions
-                        child_lexer = Lexer(include_source, str(include_path))
-                        child_tokens = list(child_lexer.tokenize())
                         child_parser = Parser(
                             child_tokens, str(include_path), macros=macros
                         )
@@ -1202,8 +1224,6 @@ def _resolve_include(
     include_paths: list[str]
 ) -> "Path | None":
     """Resolve an include filename to a full path."""
-    from pathlib import Path
-
     # Try relative to current file
     if current_file != "<input>":
         current_dir = Path(current_file).parent
@@ -0,0 +1,373 @@
+"""
+HD6303 Assembly Routine Reachability
+====================================
+
+This module finds the routines a program can actually reach, so that the
+code generator can leave unused library code (runtime.inc, stdio.inc,
+fpruntime.inc, dbruntime.inc, fixedruntime.inc, fbruntime.inc) out of the
+object file.
+
+The Psion OB3 format has no symbol table and psbuild links at assembly
+source level, so dead code has to be removed before the code is
+assembled rather than by a linker afterwards.
+
+Sections
+--------
+Assembly has no functions, so the analysis works on *sections*: the
+statements from one global label up to the next one. Local labels
+(.loop, @done) belong to the section they appear in. Included files are
+followed in place, exactly where the code generator would include them.
+
+A section is live if:
+
+1. It is a root: the statements before the first global label, the
+   first labelled section (where execution starts) and _entry.
+
+2. A live section references one of its labels, in an instruction
+   operand, a data directive or a macro argument. A macro call
+   references everything the macro body does.
+
+3. The section before it is live and falls through into it. A section
+   falls through unless its last statement is RTS, RTI, JMP or BRA; a
+   data-only section is assumed to run on into following data (tables
+   spanning labels) but not into code.
+
+4. An EQU or SET expression names one of its labels. Such references
+   are not owned by any section, so they always count.
+
+Conditional Blocks
+------------------
+A conditional block without global labels is part of the section it
+appears in. A block that defines global labels is walked as if both
+branches were present: each branch starts in the section before the
+block. Which section continues after #ENDIF depends on the condition,
+so if any statements follow before the next global label, the sections
+that end the two branches are tied together (live together).
+
+Usage
+-----
+>>> analyzer = ReachabilityAnalyzer(load_include)
+>>> live = analyzer.analyze(statements)
+>>> live["_STRLEN"]
+False
+
+The result maps every section label (uppercase) to whether it is live.
+CodeGenerator skips the dead ones in both passes.
+
+Copyright (c) 2025-2026 Hugo Jose Pinto & Contributors
+"""
+
+from collections import deque
+from dataclasses import dataclass, field
+from typing import Callable, Optional
+
+from psion_sdk.assembler.lexer import Token, TokenType
+from psion_sdk.assembler.parser import (
+    Statement,
+    Instruction,
+    Directive,
+    LabelDef,
+    MacroDef,
+    MacroCall,
+    ConditionalBlock,
+    DATA_DIRECTIVES,
+)
+
+
+# Instructions after which execution never reaches the next statement
+TERMINATORS = frozenset({"RTS", "RTI", "JMP", "BRA"})
+
+# Label that the C compiler puts on the program entry point
+ENTRY_LABEL = "_ENTRY"
+
+# Loads the statements of an INCLUDE directive: returns the resolved path
+# (used to stop circular includes) and the parsed statements, or None
+IncludeLoader = Callable[[Directive], Optional[tuple[str, list[Statement]]]]
+
+
+@dataclass
+class _Section:
+    """Statements from one global label up to the next."""
+    labels: list[str] = field(default_factory=list)
+    refs: set[str] = field(default_factory=set)
+    macro_calls: set[str] = field(default_factory=set)
+    has_code: bool = False
+    last: Optional[Statement] = None
+
+
+def _identifiers(tokens: list[Token]) -> set[str]:
+    """Uppercase identifiers in a token list."""
+    return {tok.value.upper() for tok in tokens if tok.type == TokenType.IDENTIFIER}
+
+
+def _is_equ_label(statements: list[Statement], index: int) -> bool:
+    """True if the LabelDef at index only names the EQU/SET that follows it."""
+    stmt = statements[index]
+    if index + 1 >= len(statements):
+        return False
+    next_stmt = statements[index + 1]
+    return (isinstance(next_stmt, Directive) and
+            next_stmt.name.upper() in ("EQU", "SET") and
+            next_stmt.label == stmt.name)
+
+
+class ReachabilityAnalyzer:
+    """
+    Finds the live sections of a program.
+
+    Args:
+        load_include: Called for each INCLUDE directive; returns the
+                      resolved path and parsed statements of the file,
+                      or None if it cannot be found (the code generator
+                      reports that error itself).
+    """
+
+    def __init__(self, load_include: IncludeLoader):
+        self._load_include = load_include
+        self._sections: list[_Section] = []
+        self._current = 0
+        self._other_ends: list[int] = []
+        self._adjacent: list[tuple[int, int]] = []
+        self._ties: list[tuple[int, int]] = []
+        self._global_refs: set[str] = set()
+        self._macro_refs: dict[str, set[str]] = {}
+        self._macro_calls: dict[str, set[str]] = {}
+        self._active_includes: set[str] = set()
+
+    def analyze(self, statements: list[Statement]) -> dict[str, bool]:
+        """
+        Analyze a program.
+
+        Args:
+            statements: Top-level statements of the program
+
+        Returns:
+            Dictionary of section label (uppercase) -> live
+        """
+        self._sections = [_Section()]
+        self._current = 0
+        self._other_ends.clear()
+        self._adjacent.clear()
+        self._ties.clear()
+        self._global_refs.clear()
+        self._macro_refs.clear()
+        self._macro_calls.clear()
+        self._active_includes.clear()
+
+        self._walk(statements)
+        live = self._live_sections()
+
+        result: dict[str, bool] = {}
+        for index, section in enumerate(self._sections):
+            for label in section.labels:
+                result[label] = result.get(label, False) or index in live
+        return result
+
+    # =========================================================================
+    # Walking
+    # =========================================================================
+
+    def _walk(self, statements: list[Statement]) -> None:
+        """Assign statements to sections, following includes in place."""
+        for i, stmt in enumerate(statements):
+            if isinstance(stmt, LabelDef):
+                if not stmt.is_local and not _is_equ_label(statements, i):
+                    self._start_section(stmt.name.upper())
+
+            elif isinstance(stmt, Instruction):
+                section = self._section()
+                if stmt.operand:
+                    section.refs |= _identifiers(stmt.operand.tokens)
+                section.has_code = True
+                section.last = stmt
+
+            elif isinstance(stmt, Directive):
+                self._walk_directive(stmt)
+
+            elif isinstance(stmt, MacroDef):
+                refs, calls = self._collect(stmt.body)
+                self._macro_refs[stmt.name.upper()] = refs
+                self._macro_calls[stmt.name.upper()] = calls
+
+            elif isinstance(stmt, MacroCall):
+                section = self._section()
+                for arg in stmt.arguments:
+                    section.refs |= _identifiers(arg)
+                section.macro_calls.add(stmt.name.upper())
+                section.has_code = True
+                section.last = stmt
+
+            elif isinstance(stmt, ConditionalBlock):
+                self._walk_conditional(stmt)
+
+    def _walk_directive(self, directive: Directive) -> None:
+        """Record a directive's references and data."""
+        name = directive.name.upper()
+
+        if name == "INCLUDE":
+            loaded = self._load_include(directive)
+            if loaded is None:
+                return
+            path, statements = loaded
+            if path in self._active_includes:
+                return  # Circular include, reported by the code generator
+            self._active_includes.add(path)
+            try:
+                self._walk(statements)
+            finally:
+                self._active_includes.discard(path)
+
+        elif name in DATA_DIRECTIVES:
+            section = self._section()
+            for arg in directive.arguments:
+                section.refs |= _identifiers(arg)
+            section.last = directive
+
+        else:
+            for arg in directive.arguments:
+                self._global_refs |= _identifiers(arg)
+            # LABEL EQU * names a position in the current section
+            if (name in ("EQU", "SET") and directive.label and
+                    any(tok.type == TokenType.STAR for arg in directive.arguments for tok in arg)):
+                self._section().labels.append(directive.label.upper())
+
+    def _walk_conditional(self, cond: ConditionalBlock) -> None:
+        """Walk a conditional block, splitting sections only if it has global labels."""
+        if not self._defines_global_label(cond.if_body + cond.else_body):
+            section = self._section()
+            refs, calls = self._collect([cond])
+            section.refs |= refs
+            section.macro_calls |= calls
+            section.has_code = True
+            section.last = cond
+            return
+
+        before = self._current
+        before_ends = self._other_ends
+        self._walk(cond.if_body)
+        ends = [self._current] + self._other_ends
+        self._current = before
+        self._other_ends = before_ends
+        self._walk(cond.else_body)
+        ends += [self._current] + self._other_ends
+        self._current = ends[0]
+        self._other_ends = [end for end in dict.fromkeys(ends[1:]) if end != ends[0]]
+
+    def _section(self) -> _Section:
+        """
+        The section that the next statement belongs to.
+
+        After a conditional block that split sections, a statement before
+        the next global label continues whichever branch was assembled,
+        so the branch ends are tied together.
+        """
+        for end in self._other_ends:
+            self._ties.append((self._current, end))
+        self._other_ends = []
+        return self._sections[self._current]
+
+    def _start_section(self, label: str) -> None:
+        """Begin a new section at a global label."""
+        self._sections.append(_Section(labels=[label]))
+        index = len(self._sections) - 1
+        for end in [self._current] + self._other_ends:
+            self._adjacent.append((end, index))
+        self._other_ends = []
+        self._current = index
+
+    def _defines_global_label(self, statements: list[Statement]) -> bool:
+        """True if the statements (or nested blocks) define a global label."""
+        for i, stmt in enumerate(statements):
+            if isinstance(stmt, LabelDef):
+                if not stmt.is_local and not _is_equ_label(statements, i):
+                    return True
+            elif isinstance(stmt, ConditionalBlock):
+                if self._defines_global_label(stmt.if_body + stmt.else_body):
+                    return True
+        return False
+
+    def _collect(self, statements: list[Statement]) -> tuple[set[str], set[str]]:
+        """References and macro calls of statements that do not split sections."""
+        refs: set[str] = set()
+        calls: set[str] = set()
+        for stmt in statements:
+            if isinstance(stmt, Instruction) and stmt.operand:
+                refs |= _identifiers(stmt.operand.tokens)
+            elif isinstance(stmt, Directive):
+                for arg in stmt.arguments:
+                    refs |= _identifiers(arg)
+            elif isinstance(stmt, MacroCall):
+                for arg in stmt.arguments:
+                    refs |= _identifiers(arg)
+                calls.add(stmt.name.upper())
+            elif isinstance(stmt, ConditionalBlock):
+                inner_refs, inner_calls = self._collect(stmt.if_body + stmt.else_body)
+                refs |= inner_refs
+                calls |= inner_calls
+        return refs, calls
+
+    # =========================================================================
+    # Liveness
+    # =========================================================================
+
+    def _expand_macros(self, calls: set[str]) -> set[str]:
+        """Everything referenced by the given macros and the macros they call."""
+        refs: set[str] = set()
+        seen: set[str] = set()
+        pending = list(calls)
+        while pending:
+            name = pending.pop()
+            if name in seen:
+                continue
+            seen.add(name)
+            refs |= self._macro_refs.get(name, set())
+            pending.extend(self._macro_calls.get(name, ()))
+        return refs
+
+    def _falls_through(self, index: int, next_index: int) -> bool:
+        """True if execution (or a data table) can run from one section into the next."""
+        section = self._sections[index]
+        last = section.last
+        if isinstance(last, Instruction) and last.mnemonic.upper() in TERMINATORS:
+            return False
+        # Data runs on into following data, but is not executed into code
+        if last is not None and not section.has_code:
+            return not self._sections[next_index].has_code
+        return True
+
+    def _live_sections(self) -> set[int]:
+        """Indexes of the sections reachable from the roots."""
+        defined: dict[str, list[int]] = {}
+        for index, section in enumerate(self._sections):
+            for label in section.labels:
+                defined.setdefault(label, []).append(index)
+
+        edges: dict[int, set[int]] = {index: set() for index in range(len(self._sections))}
+        for index, section in enumerate(self._sections):
+            refs = section.refs | self._expand_macros(section.macro_calls)
+            for ref in refs:
+                edges[index].update(defined.get(ref, ()))
+        for index, next_index in self._adjacent:
+            if self._falls_through(index, next_index):
+                edges[index].add(next_index)
+        ties = list(self._ties)
+        for indexes in defined.values():
+            ties.extend(zip(indexes, indexes[1:]))
+        for a, b in ties:
+            edges[a].add(b)
+            edges[b].add(a)
+
+        roots = {0}
+        if len(self._sections) > 1:
+            roots.add(1)
+        for ref in self._global_refs | {ENTRY_LABEL}:
+            roots.update(defined.get(ref, ()))
+
+        live = set(roots)
+        queue = deque(roots)
+        while queue:
+            for target in edges[queue.popleft()]:
+                if target not in live:
+                    live.add(target)
+                    queue.append(target)
+        return live
@@ -0,0 +1,248 @@
+"""
+psbuild Build Cache
+===================
+
+Content-addressed cache for the stages of a psbuild run, so that an
+edit-compile-emulate loop only redoes the work for what changed.
+
+What is cached
+--------------
+- **unit**: a C file of a multi-file build: its AST and whether it
+  defines main() (for main() detection and extern checking) and its
+  generated assembly
+- **compile**: the assembly generated for a single-file C build
+- **tokens**: the tokens of an included assembly file (runtime.inc and
+  friends), which the parser reads for macro definitions
+- **statements**: the parsed statements of an included assembly file,
+  which the code generator assembles. Together with the tokens they
+  otherwise dominate assembly time. Both are also kept in memory, for
+  the next assembly of the same run
+- **assemble**: the OB3 image for a program's assembly
+
+How entries are keyed
+---------------------
+Each entry is looked up by a key made from everything the stage reads
+up front: the input's content, the options, and a fingerprint of the
+SDK code that does the work. Any change to the compiler or assembler
+therefore invalidates their entries. The files a stage reads along the
+way, such as #include headers and INCLUDE'd .inc files, are only known
+after it has run. They are stored with the entry as (path, content
+hash) pairs, and the entry is only used if every one of them is
+unchanged. An unchanged translation unit never re-reads psion.h or any
+other header; they are only hashed.
+
+Entries are pickled into one file each and written atomically, so
+parallel psbuild runs (or the parallel compile workers) can share a
+cache directory.
+
+Location
+--------
+$PSION_BUILD_CACHE if set, else $XDG_CACHE_HOME/psion-sdk/psbuild, else
+~/.cache/psion-sdk/psbuild. psbuild --cache-dir overrides it and
+--no-cache disables the cache.
+
+Copyright (c) 2025-2026 Hugo Jose Pinto & Contributors
+"""
+
+import hashlib
+import os
+import pickle
+import tempfile
+from functools import lru_cache
+from pathlib import Path
+from typing import Any, Optional
+
+from psion_sdk import __version__
+from psion_sdk.assembler.lexer import Token, tokenize_file
+from psion_sdk.assembler.parser import Statement, parse_file
+
+
+# Bumped when the entry layout changes
+CACHE_FORMAT = 1
+
+
+def default_cache_dir() -> Path:
+    """Cache directory from the environment (see module docstring)."""
+    if os.environ.get("PSION_BUILD_CACHE"):
+        return Path(os.environ["PSION_BUILD_CACHE"])
+    base = os.environ.get("XDG_CACHE_HOME") or Path.home() / ".cache"
+    return Path(base) / "psion-sdk" / "psbuild"
+
+
+@lru_cache(maxsize=None)
+def sdk_fingerprint(package: str) -> str:
+    """
+    Hash of the SDK sources of one subpackage (e.g. "smallc").
+
+    Cached per process; the package does not change while psbuild runs.
+    """
+    root = Path(__file__).resolve().parent.parent / package
+    digest = hashlib.sha256(__version__.encode())
+    for path in sorted(root.rglob("*.py")):
+        digest.update(path.relative_to(root).as_posix().encode())
+        digest.update(path.read_bytes())
+    return digest.hexdigest()
+
+
+class BuildCache:
+    """
+    Content-addressed store for build stage results.
+
+    Args:
+        directory: Where entries are stored (created on first write)
+
+    Example:
+        cache = BuildCache(default_cache_dir())
+        key = cache.key("compile", source_text, "XP")
+        assembly = cache.get("compile", key)
+        if assembly is None:
+            assembly, headers = compile_it()
+            cache.put("compile", key, assembly, headers)
+    """
+
+    def __init__(self, directory: Path):
+        self.directory = Path(directory)
+        self.hits = 0
+        self.misses = 0
+        # Path -> (mtime_ns, size, digest), so each header is hashed once
+        self._digests: dict[str, tuple[int, int, str]] = {}
+        # (path, digest) -> tokens and statements of an included file
+        self._tokens: dict[tuple[str, str], list[Token]] = {}
+        self._statements: dict[tuple[str, str], list[Statement]] = {}
+
+    @staticmethod
+    def key(*parts: Any) -> str:
+        """Hash key for the given parts (strings, bytes or reprs of values)."""
+        digest = hashlib.sha256(str(CACHE_FORMAT).encode())
+        for part in parts:
+            data = part if isinstance(part, bytes) else str(part).encode("utf-8")
+            digest.update(len(data).to_bytes(8, "big"))
+            digest.update(data)
+        return digest.hexdigest()
+
+    def file_digest(self, path: str | Path) -> Optional[str]:
+        """Content hash of a file, or None if it cannot be read."""
+        path = str(path)
+        try:
+            stat = os.stat(path)
+        except OSError:
+            return None
+        known = self._digests.get(path)
+        if known and known[:2] == (stat.st_mtime_ns, stat.st_size):
+            return known[2]
+        try:
+            digest = hashlib.sha256(Path(path).read_bytes()).hexdigest()
+        except OSError:
+            return None
+        self._digests[path] = (stat.st_mtime_ns, stat.st_size, digest)
+        return digest
+
+    def get(self, stage: str, key: str) -> Optional[Any]:
+        """
+        Look up an entry.
+
+        Returns:
+            The stored value, or None if there is no entry or one of the
+            files it was built from has changed
+        """
+        path = self._entry_path(stage, key)
+        try:
+            with open(path, "rb") as f:
+                dependencies, value = pickle.load(f)
+        except (OSError, pickle.PickleError, EOFError, ValueError, TypeError,
+                AttributeError, ImportError):
+            self.misses += 1
+            return None
+
+        for dep_path, digest in dependencies:
+            if self.file_digest(dep_path) != digest:
+                self.misses += 1
+                return None
+
+        self.hits += 1
+        return value
+
+    def put(self, stage: str, key: str, value: Any, dependencies: list[str] = ()) -> None:
+        """
+        Store an entry.
+
+        Args:
+            stage: Stage name (parse, compile, assemble)
+            key: Key from key()
+            value: Picklable result
+            dependencies: Files the result was built from besides the keyed
+                          input (headers, include files)
+        """
+        deps = []
+        for dep_path in dependencies:
+            digest = self.file_digest(dep_path)
+            if digest is None:
+                return  # Cannot tell later whether it changed
+            deps.append((str(dep_path), digest))
+
+        path = self._entry_path(stage, key)
+        try:
+            path.parent.mkdir(parents=True, exist_ok=True)
+            fd, temp_name = tempfile.mkstemp(dir=path.parent, suffix=".tmp")
+        except OSError:
+            return  # A cache that cannot be written only costs speed
+        try:
+            with os.fdopen(fd, "wb") as f:
+                pickle.dump((deps, value), f, protocol=pickle.HIGHEST_PROTOCOL)
+            os.replace(temp_name, path)
+        except (OSError, pickle.PickleError):
+            Path(temp_name).unlink(missing_ok=True)
+
+    def tokenize_include(self, path: Path) -> list[Token]:
+        """
+        Cached FileTokenizer for Assembler(tokenize_include=...).
+
+        Args:
+            path: Included file, as resolved by the assembler
+
+        Returns:
+            The file's tokens, as tokenize_file() would return them
+        """
+        digest = self.file_digest(path)
+        if digest is None:
+            return tokenize_file(path)  # Let the lexer report the error
+
+        memo_key = (str(path), digest)
+        tokens = self._tokens.get(memo_key)
+        if tokens is None:
+            key = self.key("tokens", sdk_fingerprint("assembler"), str(path), digest)
+            tokens = self.get("tokens", key)
+            if tokens is None:
+                tokens = tokenize_file(path)
+                self.put("tokens", key, tokens)
+            self._tokens[memo_key] = tokens
+        return tokens
+
+    def parse_include(self, path: Path) -> list[Statement]:
+        """
+        Cached FileParser for Assembler(parse_include=...).
+
+        Args:
+            path: Included file, as resolved by the assembler
+
+        Returns:
+            The file's statements, as parse_file() would return them
+        """
+        digest = self.file_digest(path)
+        if digest is None:
+            return parse_file(path)  # Let the lexer report the error
+
+        memo_key = (str(path), digest)
+        statements = self._statements.get(memo_key)
+        if statements is None:
+            key = self.key("statements", sdk_fingerprint("assembler"), str(path), digest)
+            statements = self.get("statements", key)
+            if statements is None:
+                statements = parse_file(path, self.tokenize_include)
+                self.put("statements", key, statements)
+            self._statements[memo_key] = statements
+        return statements
+
+    def _entry_path(self, stage: str, key: str) -> Path:
+        """File holding an entry."""
+        return self.directory / stage / key[:2] / f"{key}.pkl"
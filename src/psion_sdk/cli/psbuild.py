@@ -21,6 +21,10 @@ Key Features
 - **Clean operation**: Uses temp files, cleans up on success
 - **Pass-through flags**: Common options work across all pipeline stages
 - **Multi-file linking**: Build from multiple C and assembly files
+- **Unused code removal**: Only routines reachable from the entry point
+  are assembled (see Unused Routine Removal below)
+- **Incremental builds**: Unchanged files are not recompiled, and the C
+  files of a multi-file build compile in parallel (see Build Cache below)
 
 Usage Examples
 --------------
@@ -108,6 +112,31 @@ This approach works because:
 - Runtime code is included only once (from main file)
 - Constants in psion.inc are idempotent (safe to include multiple times)
 
+Unused Routine Removal
+----------------------
+Linking at source level would put the whole of runtime.inc (and stdio.inc,
+fpruntime.inc, dbruntime.inc) into every program. Before assembling, the
+assembler follows references from the entry point through the program
+and its includes, and leaves out every routine nothing reaches, including
+unused C functions and their data (see psion_sdk.assembler.reachability).
+This is on by default when every input is C; --keep-unused turns it off,
+--strip-unused turns it on for builds with assembly sources.
+
+Build Cache
+-----------
+Compiled C units, the tokens of included .inc files and assembled OB3
+images are kept in a content-hash cache (see psion_sdk.cli.buildcache),
+so a rebuild after editing one file only recompiles that file, and a
+rebuild with nothing changed only hashes the inputs. Each entry records
+the headers and include files it was built from and is discarded when
+any of them changes. The cache lives in $PSION_BUILD_CACHE or
+~/.cache/psion-sdk/psbuild; --cache-dir moves it and --no-cache turns
+it off. Debug builds (-g) are always assembled.
+
+The C files of a multi-file build that are not in the cache are compiled
+in parallel, one process per CPU; -j sets the number of processes and
+-j 1 compiles them one after another.
+
 Include Path Resolution
 -----------------------
 The SDK's include directory is automatically located relative to this module's
@@ -142,7 +171,9 @@ Notes
   files have main() (all assembly), assembly order determines the entry point.
 """
 
+import os
 import tempfile
+from concurrent.futures import ProcessPoolExecutor
 from dataclasses import dataclass, field
 from pathlib import Path
 from typing import Optional
@@ -151,11 +182,18 @@ import click
 
 from psion_sdk import __version__
 from psion_sdk.smallc import SmallCCompiler, CompilerOptions
-from psion_sdk.smallc.compiler import source_has_main, parse_source_with_main_check
+from psion_sdk.smallc.compiler import (
+    source_has_main,
+    parse_source_with_main_check,
+    program_has_main,
+)
 from psion_sdk.smallc.cross_file_checker import validate_extern_signatures
+from psion_sdk.smallc.errors import SmallCError, SmallCCompilationError
 from psion_sdk.smallc.ast import ProgramNode
 from psion_sdk.assembler import Assembler
+from psion_sdk.assembler.lexer import tokenize_file
 from psion_sdk.opk import PackBuilder, validate_ob3
+from psion_sdk.cli.buildcache import BuildCache, default_cache_dir, sdk_fingerprint
 from psion_sdk.cli.errors import handle_cli_exception
 
 
@@ -242,6 +280,28 @@ class MainFileResult:
     parsed_asts: list[tuple[str, ProgramNode]] = field(default_factory=list)
 
 
+@dataclass
+class CompiledUnit:
+    """
+    A C file of a multi-file build, compiled by compile_c_units().
+
+    Attributes:
+        source_file: Path to the .c file
+        ast: Parsed program, for main() detection and extern checking
+        has_main: True if the file defines main()
+        assembly: Generated assembly: normal mode (with runtime and entry
+                  point) if the file defines main(), library mode otherwise
+        dependencies: Resolved paths of the headers the file included
+        cached: True if the unit came from the build cache
+    """
+    source_file: Path
+    ast: ProgramNode
+    has_main: bool
+    assembly: str
+    dependencies: list[str] = field(default_factory=list)
+    cached: bool = False
+
+
 # =============================================================================
 # Multi-File Build Helper Functions
 # =============================================================================
@@ -295,6 +355,7 @@ def find_main_file(
     c_files: list[Path],
     include_paths: list[str],
     verbose: bool = False,
+    units: Optional[list[CompiledUnit]] = None,
 ) -> MainFileResult:
     """
     Find which C file contains the main() function.
@@ -312,6 +373,8 @@ def find_main_file(
         c_files: List of C source file paths to check
         include_paths: Include search paths for preprocessing
         verbose: If True, print progress messages
+        units: Already compiled units for c_files (from compile_c_units),
+               whose ASTs are used instead of parsing the files again
 
     Returns:
         MainFileResult containing:
@@ -335,15 +398,19 @@ def find_main_file(
     """
     result = MainFileResult()
     files_with_main: list[Path] = []
+    compiled = {unit.source_file: unit for unit in units or ()}
 
     for c_file in c_files:
         if verbose:
             click.echo(f"      Checking {c_file.name} for main()...")
 
         try:
-            source = c_file.read_text(encoding='utf-8')
-            # Parse the source and check for main() in one pass
-            ast, has_main = parse_source_with_main_check(source, str(c_file), include_paths)
+            if c_file in compiled:
+                ast, has_main = compiled[c_file].ast, compiled[c_file].has_main
+            else:
+                source = c_file.read_text(encoding='utf-8')
+                # Parse the source and check for main() in one pass
+                ast, has_main = parse_source_with_main_check(source, str(c_file), include_paths)
 
             # Collect the AST for cross-file validation
             result.parsed_asts.append((str(c_file), ast))
@@ -779,6 +846,8 @@ def compile_c_to_asm(
     verbose: bool,
     step_label: str = "[1/3]",
     emit_runtime: bool = True,
+    cache: Optional[BuildCache] = None,
+    opt_level: int = 1,
 ) -> None:
     """
     Compile C source to HD6303 assembly using pscc.
@@ -795,6 +864,10 @@ def compile_c_to_asm(
         step_label: Step label for verbose output (e.g., "[1/3]")
         emit_runtime: If True, emit runtime includes and entry point.
                      Set to False for library mode in multi-file builds.
+        cache: Build cache to reuse the assembly from, if the source and
+               its headers are unchanged
+        opt_level: C code generator optimization level (0-2, see
+                   CompilerOptions)
 
     Raises:
         SmallCError: If compilation fails
@@ -830,18 +903,135 @@ def compile_c_to_asm(
         output_comments=verbose,
         target_model=model.upper() if model else None,
         emit_runtime=emit_runtime,
+        opt_level=opt_level,
     )
 
-    # Read source and compile
+    # Read source and compile, unless the cache has this exact compilation
     source = source_file.read_text(encoding='utf-8')
-    compiler = SmallCCompiler(options)
-    result = compiler.compile_source(source, str(source_file))
+    key = BuildCache.key(
+        "compile", sdk_fingerprint("smallc"), source_file.resolve(), source,
+        include_paths, options.target_model, emit_runtime, verbose, opt_level,
+    )
+    assembly = cache.get("compile", key) if cache else None
+    if assembly is None:
+        compiler = SmallCCompiler(options)
+        result = compiler.compile_source(source, str(source_file))
+        assembly = result.assembly
+        if cache:
+            cache.put("compile", key, assembly, result.dependencies)
+    elif verbose:
+        click.echo("      Unchanged, using cached assembly")
 
     # Write assembly output
-    output_asm.write_text(result.assembly, encoding='utf-8')
+    output_asm.write_text(assembly, encoding='utf-8')
 
     if verbose:
-        click.echo(f"      Generated {len(result.assembly)} bytes of assembly")
+        click.echo(f"      Generated {len(assembly)} bytes of assembly")
+
+
+def _compile_unit(
+    source: str,
+    filename: str,
+    include_paths: list[str],
+    model: Optional[str],
+    output_comments: bool,
+    opt_level: int = 1,
+) -> tuple[str, object]:
+    """
+    Compile one C file of a multi-file build (runs in a worker process).
+
+    The file is compiled in library mode, which is what every file but
+    one needs; if it turns out to define main() it is compiled again with
+    the runtime.
+
+    Returns:
+        ("ok", (ast, has_main, assembly, dependencies)), or ("error",
+        message) if compilation failed. Errors are passed back as their
+        formatted text, since SmallCError does not survive pickling.
+    """
+    try:
+        result = None
+        for emit_runtime in (False, True):
+            options = CompilerOptions(
+                include_paths=include_paths,
+                output_comments=output_comments,
+                target_model=model.upper() if model else None,
+                emit_runtime=emit_runtime,
+                opt_level=opt_level,
+            )
+            result = SmallCCompiler(options).compile_source(source, filename)
+            if not program_has_main(result.ast):
+                break
+        return "ok", (result.ast, emit_runtime, result.assembly, result.dependencies)
+    except SmallCError as e:
+        return "error", str(e)
+
+
+def compile_c_units(
+    c_files: list[Path],
+    include_paths: list[str],
+    model: Optional[str],
+    verbose: bool,
+    cache: Optional[BuildCache] = None,
+    jobs: int = 1,
+    opt_level: int = 1,
+) -> list[CompiledUnit]:
+    """
+    Compile the C files of a multi-file build, in parallel where possible.
+
+    Each file is compiled once: the file that defines main() in normal
+    mode, every other file in library mode. Files whose source and headers
+    are unchanged since a previous build are taken from the cache; the
+    rest are spread over up to `jobs` worker processes.
+
+    Args:
+        c_files: C source files, in command-line order
+        include_paths: List of include search directories
+        model: Target model (CM, XP, LZ, etc.) or None for default
+        verbose: If True, print detailed progress
+        cache: Build cache, or None to compile everything
+        jobs: Maximum number of worker processes
+        opt_level: C code generator optimization level (0-2)
+
+    Returns:
+        One CompiledUnit per file, in the order of c_files
+
+    Raises:
+        SmallCCompilationError: If a file fails to compile (the first
+                                failing file in command-line order)
+    """
+    units: list[Optional[CompiledUnit]] = [None] * len(c_files)
+    pending: list[tuple[int, str, tuple]] = []
+
+    for index, c_file in enumerate(c_files):
+        source = c_file.read_text(encoding='utf-8')
+        args = (source, str(c_file), include_paths, model, verbose, opt_level)
+        key = BuildCache.key("unit", sdk_fingerprint("smallc"), c_file.resolve(), *args)
+        hit = cache.get("unit", key) if cache else None
+        if hit is not None:
+            units[index] = CompiledUnit(c_file, *hit, cached=True)
+        else:
+            pending.append((index, key, args))
+
+    if verbose:
+        click.echo(f"      {len(c_files) - len(pending)} unchanged, "
+                   f"{len(pending)} to compile")
+
+    arguments = [args for _, _, args in pending]
+    if jobs > 1 and len(pending) > 1:
+        with ProcessPoolExecutor(max_workers=min(jobs, len(pending))) as pool:
+            outcomes = list(pool.map(_compile_unit, *zip(*arguments)))
+    else:
+        outcomes = [_compile_unit(*args) for args in arguments]
+
+    for (index, key, _), (status, value) in zip(pending, outcomes):
+        if status == "error":
+            raise SmallCCompilationError(value)
+        units[index] = CompiledUnit(c_files[index], *value)
+        if cache:
+            cache.put("unit", key, value, value[3])
+
+    return units
 
 
 def assemble_to_ob3(
@@ -854,6 +1044,8 @@ def assemble_to_ob3(
     verbose: bool,
     debug: bool = False,
     debug_output: Optional[Path] = None,
+    strip_unused: bool = False,
+    cache: Optional[BuildCache] = None,
 ) -> None:
     """
     Assemble HD6303 source to OB3 object file using psasm.
@@ -868,6 +1060,10 @@ def assemble_to_ob3(
         verbose: If True, print detailed progress
         debug: If True, generate debug symbol file
         debug_output: Path for the .dbg file (only used if debug=True)
+        strip_unused: If True, leave out routines nothing reaches from the
+                      entry point (unused runtime library code)
+        cache: Build cache for the OB3 image and the tokens of included
+               files (not used for the OB3 of debug builds)
 
     Raises:
         AssemblerError: If assembly fails
@@ -880,6 +1076,28 @@ def assemble_to_ob3(
         click.echo(f"[{step}] Assembling {source_asm.name} → {output_ob3.name}")
         click.echo(f"      Relocatable: {relocatable}")
         click.echo(f"      Optimization: {'enabled' if optimize else 'disabled'}")
+        click.echo(f"      Strip unused routines: {strip_unused}")
+
+    # An unchanged program with unchanged includes is not reassembled
+    # (psbuild's own intermediate files live in a new temp directory each
+    # run, so the key is the source text rather than its path)
+    source = source_asm.read_text(encoding='utf-8')
+    key = BuildCache.key(
+        "assemble", sdk_fingerprint("assembler"), source, include_paths,
+        model, relocatable, optimize, strip_unused,
+    )
+    cached = cache.get("assemble", key) if cache and not debug else None
+    if cached is not None:
+        ob3, code_size, removed, fixup_count = cached
+        output_ob3.write_bytes(ob3)
+        if verbose:
+            click.echo("      Unchanged, using cached object code")
+            click.echo(f"      Generated {code_size} bytes of object code")
+            if strip_unused:
+                click.echo(f"      Removed {len(removed)} unused routines")
+            if relocatable:
+                click.echo(f"      Relocations: {fixup_count} fixups")
+        return
 
     # Create assembler instance with debug support if requested
     asm = Assembler(
@@ -888,6 +1106,9 @@ def assemble_to_ob3(
         target_model=model.upper() if model else None,
         optimize=optimize,
         debug=debug,  # Enable debug symbol generation
+        strip_unused=strip_unused,
+        tokenize_include=cache.tokenize_include if cache else tokenize_file,
+        parse_include=cache.parse_include if cache else None,
     )
 
     # Add include paths
@@ -900,6 +1121,14 @@ def assemble_to_ob3(
     # Write OB3 output
     asm.write_ob3(output_ob3)
 
+    if cache and not debug:
+        cache.put(
+            "assemble", key,
+            (output_ob3.read_bytes(), len(asm.get_code()),
+             asm.get_removed_routines(), asm.get_fixup_count()),
+            asm.get_included_files(),
+        )
+
     # Write debug file if requested
     if debug and debug_output:
         asm.write_debug(debug_output)
@@ -910,6 +1139,10 @@ def assemble_to_ob3(
         code_size = len(asm.get_code())
         click.echo(f"      Generated {code_size} bytes of object code")
 
+        if strip_unused:
+            removed = asm.get_removed_routines()
+            click.echo(f"      Removed {len(removed)} unused routines")
+
         # Show relocation info if applicable
         if relocatable:
             fixup_count = asm.get_fixup_count()
@@ -1012,6 +1245,40 @@ def package_to_opk(
     default=True,
     help="Enable/disable peephole optimization. Default: enabled.",
 )
+@click.option(
+    "--opt-level",
+    type=click.IntRange(0, 2),
+    default=1,
+    help="C code generator optimization level: 0 plain stack code, "
+         "1 register-aware code, 2 also inlines small functions and "
+         "drops the frame of leaf functions. Default: 1.",
+)
+@click.option(
+    "--strip-unused/--keep-unused",
+    default=None,
+    help="Leave out runtime and program routines that nothing reachable from "
+         "the entry point calls. Default: enabled when every input is a C "
+         "source, disabled for builds with assembly sources.",
+)
+@click.option(
+    "-j", "--jobs",
+    type=click.IntRange(min=1),
+    default=None,
+    help="Number of processes compiling the C files of a multi-file build. "
+         "Default: one per CPU.",
+)
+@click.option(
+    "--cache-dir",
+    type=click.Path(file_okay=False, path_type=Path),
+    default=None,
+    help="Build cache directory. Default: $PSION_BUILD_CACHE or "
+         "~/.cache/psion-sdk/psbuild.",
+)
+@click.option(
+    "--no-cache",
+    is_flag=True,
+    help="Rebuild everything without reading or writing the build cache",
+)
 @click.option(
     "-v", "--verbose",
     is_flag=True,
@@ -1035,6 +1302,11 @@ def main(
     optimize: bool,
     verbose: bool,
     debug: bool,
+    strip_unused: Optional[bool] = None,
+    jobs: Optional[int] = None,
+    cache_dir: Optional[Path] = None,
+    no_cache: bool = False,
+    opt_level: int = 1,
 ) -> None:
     """
     Build a Psion Organiser II program from C or assembly source(s).
@@ -1074,6 +1346,10 @@ def main(
         psbuild -v hello.c                    # Verbose output
         psbuild -k hello.c                    # Keep intermediate files
         psbuild -r hello.asm                  # Assembly with relocation
+        psbuild --keep-unused hello.c         # Keep the whole runtime
+        psbuild --no-cache hello.c            # Full rebuild
+        psbuild --opt-level 2 hello.c         # Inline small functions
+        psbuild -j 4 main.c a.c b.c c.c       # Compile on 4 processes
         psbuild main.c util.c -o APP.opk      # Multiple C files
         psbuild main.c fast.asm -o APP.opk    # C with assembly helpers
 
@@ -1121,6 +1397,17 @@ def main(
         # Determine if this is a multi-file build
         is_multi_file = classified.is_multi_file
 
+        # Unused routine removal defaults on only when every input is C:
+        # hand-written assembly, including .asm helpers linked into a C
+        # program, may rely on code reached only through computed addresses
+        if strip_unused is None:
+            strip_unused = classified.is_c_only
+
+        # Unchanged files are taken from the build cache; the rest of the
+        # C files compile on one process per CPU unless -j says otherwise
+        cache = None if no_cache else BuildCache(cache_dir or default_cache_dir())
+        jobs = jobs or os.cpu_count() or 1
+
         if verbose:
             if is_multi_file:
                 click.echo(f"Multi-file build: {len(classified.all_files)} input files")
@@ -1175,6 +1462,8 @@ def main(
                         verbose=verbose,
                         step_label="[1/3]",
                         emit_runtime=True,
+                        cache=cache,
+                        opt_level=opt_level,
                     )
 
                     assemble_to_ob3(
@@ -1187,6 +1476,8 @@ def main(
                         verbose=verbose,
                         debug=debug,
                         debug_output=debug_output,
+                        strip_unused=strip_unused,
+                        cache=cache,
                     )
 
                     package_to_opk(
@@ -1208,6 +1499,8 @@ def main(
                         verbose=verbose,
                         debug=debug,
                         debug_output=debug_output,
+                        strip_unused=strip_unused,
+                        cache=cache,
                     )
 
                     package_to_opk(
@@ -1236,19 +1529,21 @@ def main(
                 # MULTI-FILE BUILD
                 # -------------------------------------------------------------
                 # This is a multi-file build. The process is:
-                # 1. Find which C file contains main()
-                # 2. Compile non-main C files in library mode
-                # 3. Compile main C file with runtime
-                # 4. Concatenate all assembly (libraries first, main last)
-                # 5. Assemble merged assembly
-                # 6. Package to OPK
+                # 1. Compile the C files (in parallel), each non-main file
+                #    in library mode and the main file with runtime
+                # 2. Find which C file contains main()
+                # 3. Concatenate all assembly (libraries first, main last)
+                # 4. Assemble merged assembly
+                # 5. Package to OPK
 
                 library_asm_files: list[Path] = []  # From library-mode C compilation
                 main_asm_file: Optional[Path] = None  # From main C compilation
 
                 # Calculate total steps for progress display
-                # Steps: detect main + compile each C file + concatenate + assemble + package
-                total_steps = 1 + len(classified.c_files) + 1 + 1 + 1
+                # Steps: compile C files + extern check + concatenate + assemble + package
+                total_steps = 3
+                if classified.has_c_files:
+                    total_steps += 2 if len(classified.c_files) > 1 else 1
                 current_step = 0
 
                 def step_label() -> str:
@@ -1256,20 +1551,36 @@ def main(
                     return f"[{current_step}/{total_steps}]"
 
                 # ---------------------------------------------------------
-                # Step 3a: Find the main file (for C builds)
+                # Step 3a: Compile the C files and find the main file
                 # ---------------------------------------------------------
                 main_c_file: Optional[Path] = None
                 library_c_files: list[Path] = []
+                units: list[CompiledUnit] = []
 
                 if classified.has_c_files:
                     current_step += 1
                     if verbose:
-                        click.echo(f"{step_label()} Detecting main() function...")
+                        click.echo(f"{step_label()} Compiling {len(classified.c_files)} C files "
+                                   f"(up to {jobs} in parallel)...")
+
+                    units = compile_c_units(
+                        classified.c_files,
+                        include_paths,
+                        model,
+                        verbose,
+                        cache=cache,
+                        jobs=jobs,
+                        opt_level=opt_level,
+                    )
+
+                    if verbose:
+                        click.echo("      Detecting main() function...")
 
                     main_result = find_main_file(
                         classified.c_files,
                         include_paths,
                         verbose=verbose,
+                        units=units,
                     )
 
                     if not main_result.found:
@@ -1318,40 +1629,23 @@ def main(
                             click.echo()
 
                 # ---------------------------------------------------------
-                # Step 3b: Compile library C files (emit_runtime=False)
+                # Step 3b: Write the library (emit_runtime=False) and
+                #          main (emit_runtime=True) assembly files
                 # ---------------------------------------------------------
-                for lib_c in library_c_files:
-                    current_step += 1
-                    lib_asm = temp_path / f"{lib_c.stem.lower()}_lib.asm"
-
-                    compile_c_to_asm(
-                        source_file=lib_c,
-                        output_asm=lib_asm,
-                        include_paths=include_paths,
-                        model=model,
-                        verbose=verbose,
-                        step_label=step_label(),
-                        emit_runtime=False,  # Library mode
-                    )
+                for unit in units:
+                    if unit.has_main:
+                        main_asm_file = temp_path / f"{unit.source_file.stem.lower()}_main.asm"
+                        unit_asm = main_asm_file
+                    else:
+                        unit_asm = temp_path / f"{unit.source_file.stem.lower()}_lib.asm"
+                        library_asm_files.append(unit_asm)
+                    unit_asm.write_text(unit.assembly, encoding='utf-8')
 
-                    library_asm_files.append(lib_asm)
-
-                # ---------------------------------------------------------
-                # Step 3c: Compile main C file (emit_runtime=True)
-                # ---------------------------------------------------------
-                if main_c_file is not None:
-                    current_step += 1
-                    main_asm_file = temp_path / f"{main_c_file.stem.lower()}_main.asm"
-
-                    compile_c_to_asm(
-                        source_file=main_c_file,
-                        output_asm=main_asm_file,
-                        include_paths=include_paths,
-                        model=model,
-                        verbose=verbose,
-                        step_label=step_label(),
-                        emit_runtime=True,  # Full runtime
-                    )
+                    if verbose:
+                        mode_desc = "normal" if unit.has_main else "library"
+                        origin = ", cached" if unit.cached else ""
+                        click.echo(f"      {unit.source_file.name} → {unit_asm.name} "
+                                   f"({mode_desc}{origin}, {len(unit.assembly)} bytes)")
 
                 # ---------------------------------------------------------
                 # Step 3d: Concatenate assembly files
@@ -1392,6 +1686,8 @@ def main(
                     verbose=verbose,
                     debug=debug,
                     debug_output=debug_output,
+                    strip_unused=strip_unused,
+                    cache=cache,
                 )
 
                 # ---------------------------------------------------------
@@ -86,6 +86,14 @@ from psion_sdk.cli.errors import handle_cli_exception
          "is intended to be linked with a main file that provides these. "
          "Use this for helper C files when building with multiple source files.",
 )
+@click.option(
+    "-O", "--opt-level",
+    type=click.IntRange(0, 2),
+    default=1,
+    help="Optimization level: 0 plain stack code, 1 register-aware code "
+         "(default), 2 also inlines small functions and drops the frame "
+         "of leaf functions.",
+)
 @click.version_option(version=__version__, prog_name="pscc")
 def main(
     input_file: Path,
@@ -96,6 +104,7 @@ def main(
     verbose: bool,
     model: Optional[str],
     library: bool,
+    opt_level: int = 1,
 ) -> None:
     """
     Compile Small-C source code for Psion Organiser II.
@@ -113,6 +122,7 @@ def main(
         pscc -E hello.c              # Preprocess only
         pscc -v hello.c              # Verbose output
         pscc --library helper.c      # Library mode (no runtime/entry point)
+        pscc -O 2 hello.c            # Inline small functions
 
     \b
     Multi-file projects:
@@ -158,6 +168,7 @@ def main(
         output_comments=verbose,
         target_model=model.upper() if model else None,
         emit_runtime=not library,  # Library mode disables runtime emission
+        opt_level=opt_level,
     )
 
     try:
@@ -34,6 +34,13 @@ List files on a Psion pack:
     $ pslink list B:
     # Psion must be in COMMS > TRANSMIT mode
 
+Send a file to every Psion on a USB hub at once:
+    $ pslink --ports '/dev/ttyUSB*' send program.opl
+
+Flash a pack image, continuing after a dropped link:
+    $ pslink flash program.opk
+    $ pslink flash --resume program.opk
+
 Hardware Setup
 --------------
 Before using pslink, ensure:
@@ -51,8 +58,9 @@ Exit Codes
 """
 
 import logging
+import threading
 from pathlib import Path
-from typing import Optional
+from typing import Callable, Optional
 
 import click
 
@@ -70,8 +78,17 @@ from psion_sdk.comms import (
     list_serial_ports,
     open_serial_port,
     BootTransfer,
+    FlashState,
+    FleetProgress,
+    ProgressCallback,
+    expand_ports,
+    flash_state_path,
+    format_fleet_summary,
+    run_fleet,
 )
+from psion_sdk.comms.fleet import FleetJob
 from psion_sdk.errors import CommsError, ConnectionError, TransferError
+from psion_sdk.opk import compare_records
 
 # Configure logging
 logger = logging.getLogger(__name__)
@@ -90,6 +107,7 @@ class Context:
 
     def __init__(self) -> None:
         self.port: Optional[str] = None
+        self.ports: tuple[str, ...] = ()
         self.baud: int = DEFAULT_BAUD_RATE
         self.verbose: bool = False
         self.timeout: float = 30.0
@@ -123,6 +141,47 @@ def progress_unknown(current: int) -> None:
     click.echo(f"\rReceived: {current} bytes", nl=False)
 
 
+def run_on_fleet(ctx: Context, job: FleetJob) -> None:
+    """
+    Run a job on every port given with --ports, all at once.
+
+    Shows the combined progress of all devices on one line instead of
+    progress_bar(), then a summary line per device. Exits with status 1
+    if any device failed.
+    """
+    ports = expand_ports(ctx.ports)
+    if not ports:
+        click.echo("Error: --ports matched no serial ports.")
+        raise SystemExit(1)
+
+    click.echo(f"Fleet of {len(ports)} devices: {', '.join(ports)}")
+    progress = FleetProgress(ports, output=lambda line: click.echo(f"\r{line}", nl=False))
+    results = run_fleet(ports, job, progress)
+
+    click.echo()
+    click.echo(format_fleet_summary(results))
+    if not all(result.ok for result in results):
+        raise SystemExit(1)
+
+
+def prompt_once(prompt: Callable[[], bool]) -> Callable[[], bool]:
+    """
+    Share one prompt between the devices of a fleet.
+
+    The first device to get to the prompt asks; the others wait for that
+    answer and get it too.
+    """
+    lock = threading.Lock()
+    answers: list[bool] = []
+
+    def ask() -> bool:
+        with lock:
+            if not answers:
+                answers.append(prompt())
+            return answers[0]
+    return ask
+
+
 def convert_opl_line_endings(data: bytes) -> bytes:
     """
     Convert OPL line endings from NULL to CRLF.
@@ -184,9 +243,16 @@ def convert_pc_line_endings(data: bytes) -> bytes:
     default=30.0,
     help="Connection timeout in seconds (default: 30)",
 )
+@click.option(
+    "--ports",
+    multiple=True,
+    help="Run send/flash on several ports at once: names or globs, "
+         "comma separated or repeated (e.g. '/dev/ttyUSB*')",
+)
 @click.version_option(version=__version__, prog_name="pslink")
 @pass_context
-def main(ctx: Context, port: Optional[str], baud: str, verbose: bool, timeout: float) -> None:
+def main(ctx: Context, port: Optional[str], baud: str, verbose: bool, timeout: float,
+         ports: tuple[str, ...]) -> None:
     """
     Transfer files to/from Psion Organiser II via serial connection.
 
@@ -202,8 +268,12 @@ def main(ctx: Context, port: Optional[str], baud: str, verbose: bool, timeout: f
       2. On Psion: COMMS > SEND > select file
 
     Use 'pslink ports' to list available serial ports.
+
+    With --ports, send and flash run on every listed port at the same
+    time, one thread per device, and end with a summary per device.
     """
     ctx.port = port
+    ctx.ports = ports
     ctx.baud = int(baud)
     ctx.verbose = verbose
     ctx.timeout = timeout
@@ -341,8 +411,13 @@ def list_files(ctx: Context, device: str) -> None:
     default=True,
     help="File type: --opl for program files (default), --odb for data files",
 )
+@click.option(
+    "--pipelined",
+    is_flag=True,
+    help="Prepare each block while the previous one is acknowledged",
+)
 @pass_context
-def send(ctx: Context, file: str, name: Optional[str], is_opl: bool) -> None:
+def send(ctx: Context, file: str, name: Optional[str], is_opl: bool, pipelined: bool) -> None:
     """
     Send a file to the Psion device.
 
@@ -361,6 +436,8 @@ def send(ctx: Context, file: str, name: Optional[str], is_opl: bool) -> None:
         pslink send program.opl
         pslink send hello.opl --name HELLO
         pslink send data.odb --odb
+        pslink send big.opl --pipelined
+        pslink --ports '/dev/ttyUSB*' send program.opl
 
     Workflow:
         $ pslink send myprogram.opl
@@ -372,10 +449,11 @@ def send(ctx: Context, file: str, name: Optional[str], is_opl: bool) -> None:
         Waiting for Psion to request file...
         [==================================] 100% (1234/1234 bytes)
         Transfer complete!
+        1234 bytes in 5 blocks, 2.10 s (588 bytes/s)
     """
     # Get port (auto-detect if not specified)
-    port_device = ctx.port or find_psion_port()
-    if not port_device:
+    port_device = None if ctx.ports else (ctx.port or find_psion_port())
+    if not port_device and not ctx.ports:
         click.echo("Error: No serial port specified and auto-detect failed.")
         click.echo("Use --port option or 'pslink ports' to find available ports.")
         raise SystemExit(1)
@@ -404,6 +482,21 @@ def send(ctx: Context, file: str, name: Optional[str], is_opl: bool) -> None:
         data = convert_pc_line_endings(data)
         click.echo(f"Converted line endings (CRLF -> NULL): {original_size} -> {len(data)} bytes")
 
+    if ctx.ports:
+        def serve(port: str, progress: ProgressCallback) -> str:
+            serial_port = open_serial_port(port, baud_rate=ctx.baud)
+            try:
+                transfer = FileTransfer(LinkProtocol(serial_port), pipelined=pipelined)
+                transfer.serve_file(psion_name, data, file_type=file_type, progress=progress)
+                return str(transfer.last_stats)
+            finally:
+                close_serial_port(serial_port)
+
+        click.echo(f"Ready to serve: {psion_name} ({len(data)} bytes)")
+        click.echo(f"On each Psion: COMMS > RECEIVE > enter \"{psion_name}{ext}\"")
+        run_on_fleet(ctx, serve)
+        return
+
     click.echo(f"Connecting to Psion on {port_device}...")
 
     try:
@@ -421,7 +514,7 @@ def send(ctx: Context, file: str, name: Optional[str], is_opl: bool) -> None:
             click.echo("")
 
             click.echo("Waiting for Psion...")
-            transfer = FileTransfer(link)
+            transfer = FileTransfer(link, pipelined=pipelined)
             transfer.serve_file(
                 psion_name,
                 data,
@@ -431,6 +524,7 @@ def send(ctx: Context, file: str, name: Optional[str], is_opl: bool) -> None:
 
             click.echo("")
             click.echo("Transfer complete!")
+            click.echo(str(transfer.last_stats))
 
         finally:
             close_serial_port(serial_port)
@@ -462,8 +556,14 @@ def send(ctx: Context, file: str, name: Optional[str], is_opl: bool) -> None:
     is_flag=True,
     help="Save raw data without line ending conversion (default: convert NULL to CRLF)",
 )
+@click.option(
+    "--pipelined",
+    is_flag=True,
+    help="Answer each block without waiting for the previous answer to drain",
+)
 @pass_context
-def receive(ctx: Context, output: Optional[str], simple: bool, raw: bool) -> None:
+def receive(ctx: Context, output: Optional[str], simple: bool, raw: bool,
+            pipelined: bool) -> None:
     """
     Receive a file from the Psion device.
 
@@ -523,7 +623,7 @@ def receive(ctx: Context, output: Optional[str], simple: bool, raw: bool) -> Non
             click.echo("")
 
             click.echo("Waiting for Psion...")
-            transfer = FileTransfer(link)
+            transfer = FileTransfer(link, pipelined=pipelined)
 
             if simple:
                 filename, data = transfer.receive_file_simple(
@@ -537,6 +637,7 @@ def receive(ctx: Context, output: Optional[str], simple: bool, raw: bool) -> Non
 
             click.echo()  # Newline after progress
             click.echo(f"Received: {filename} ({len(data)} bytes)")
+            click.echo(str(transfer.last_stats))
 
             # Determine output filename
             if output is None:
@@ -574,6 +675,46 @@ def receive(ctx: Context, output: Optional[str], simple: bool, raw: bool) -> Non
 # Flash Command (Pack Flashing via BOOT Protocol)
 # =============================================================================
 
+def plan_flash(
+    opk_data: bytes,
+    saved: Optional[FlashState],
+    resume: bool,
+    delta: bool,
+) -> tuple[bool, Optional[str]]:
+    """
+    Decide from a pack's saved FlashState whether to flash it.
+
+    Args:
+        opk_data: The OPK to flash
+        saved: The pack's state file contents (None if there is none)
+        resume: --resume was given
+        delta: --delta was given
+
+    Returns:
+        (flash, note): whether to flash (or resume), and a line saying why
+        not or what changed, if there is something to say
+
+    Raises:
+        ValueError: If --resume was given but there is nothing to resume
+    """
+    if resume:
+        if saved is None or not saved.can_resume(opk_data):
+            raise ValueError("no stopped transfer of this pack image to resume")
+        return True, f"Resuming at {saved.acknowledged} of {saved.image_size} bytes"
+
+    if delta and saved is not None and saved.complete:
+        changes = compare_records(saved.records, FlashState.for_opk(opk_data).records)
+        if saved.matches(opk_data) or (saved.records and changes.is_empty):
+            return False, f"Pack is up to date ({changes.summary()})"
+        return True, f"Changed since last flash: {changes.summary()}"
+    return True, None
+
+
+def fleet_state_path(state_path: Path, port: str) -> Path:
+    """The state file of one device of a fleet: the port's name before the suffix."""
+    return state_path.with_name(f"{state_path.stem}.{Path(port).name}{state_path.suffix}")
+
+
 @main.command()
 @click.argument("file", type=click.Path(exists=True, dir_okay=False))
 @click.option(
@@ -581,8 +722,25 @@ def receive(ctx: Context, output: Optional[str], simple: bool, raw: bool) -> Non
     is_flag=True,
     help="Skip the prompt to insert pack (continue automatically)",
 )
+@click.option(
+    "--resume",
+    is_flag=True,
+    help="Continue a transfer that stopped, at the last acknowledged block",
+)
+@click.option(
+    "--delta",
+    is_flag=True,
+    help="Only flash if the records differ from those last flashed",
+)
+@click.option(
+    "--state",
+    "state_file",
+    type=click.Path(dir_okay=False),
+    help="Flash state file (default: FILE.flash)",
+)
 @pass_context
-def flash(ctx: Context, file: str, no_prompt: bool) -> None:
+def flash(ctx: Context, file: str, no_prompt: bool, resume: bool, delta: bool,
+          state_file: Optional[str]) -> None:
     """
     Flash an OPK pack image directly to a Psion datapak/rampack.
 
@@ -602,9 +760,25 @@ def flash(ctx: Context, file: str, no_prompt: bool) -> None:
     4. Insert empty datapak/rampack in slot C when prompted
     5. Transfer completes
 
+    Progress is saved in a state file next to FILE after every block the
+    Psion acknowledges. If the link drops while the Psion still shows the
+    bootloader, run the command again with --resume: it reconnects
+    without repeating phase 1 and sends the rest of the image.
+
+    With --delta, the OPK's records are compared with those of the last
+    complete flash recorded in the state file (use --state to keep one
+    file per pack), and nothing is flashed if none changed. The bootloader
+    always writes the whole image, so a changed pack is flashed in full.
+
     Example:
         pslink flash program.opk
         pslink flash --no-prompt program.opk
+        pslink flash --resume program.opk
+        pslink flash --delta --state pack1.flash program.opk
+        pslink --ports '/dev/ttyUSB*' flash --no-prompt program.opk
+
+    With --ports, every device keeps its own state file, named after
+    its port (program.opk.ttyUSB0.flash).
 
     Workflow:
         $ pslink flash myprogram.opk
@@ -624,8 +798,8 @@ def flash(ctx: Context, file: str, no_prompt: bool) -> None:
         Transfer complete! Pack is ready to use.
     """
     # Get port (auto-detect if not specified)
-    port_device = ctx.port or find_psion_port()
-    if not port_device:
+    port_device = None if ctx.ports else (ctx.port or find_psion_port())
+    if not port_device and not ctx.ports:
         click.echo("Error: No serial port specified and auto-detect failed.")
         click.echo("Use --port option or 'pslink ports' to find available ports.")
         raise SystemExit(1)
@@ -648,7 +822,7 @@ def flash(ctx: Context, file: str, no_prompt: bool) -> None:
         raise SystemExit(2)
 
     pack_size = len(opk_data) - 6  # Size after header
-    click.echo(f"Connecting to Psion on {port_device}...")
+    state_path = flash_state_path(file_path) if state_file is None else Path(state_file)
     click.echo(f"OPK file: {file_path.name} ({len(opk_data)} bytes, pack image: {pack_size} bytes)")
 
     def user_prompt() -> bool:
@@ -667,26 +841,79 @@ def flash(ctx: Context, file: str, no_prompt: bool) -> None:
             click.echo("\nAborted by user")
             return False
 
+    if ctx.ports:
+        shared_prompt = prompt_once(user_prompt)
+
+        def flash_device(port: str, progress: ProgressCallback) -> str:
+            device_state_path = fleet_state_path(state_path, port)
+            device_state = FlashState.load(device_state_path)
+            needed, note = plan_flash(opk_data, device_state, resume, delta)
+            if not needed:
+                return note
+
+            serial_port = open_serial_port(port, baud_rate=ctx.baud)
+            try:
+                boot = BootTransfer(LinkProtocol(serial_port))
+                checkpoint = lambda state: state.save(device_state_path)
+                if resume:
+                    boot.resume_pack(opk_data, device_state, progress, checkpoint)
+                else:
+                    boot.flash_pack(opk_data, progress, shared_prompt, checkpoint)
+            finally:
+                close_serial_port(serial_port)
+            return f"Flashed ({note})" if note else "Flashed"
+
+        click.echo("On each Psion: COMMS > BOOT > press EXE (name can be empty)")
+        try:
+            run_on_fleet(ctx, flash_device)
+        except SystemExit:
+            click.echo("Devices that stopped part way can be continued with --resume.")
+            raise
+        return
+
+    saved = FlashState.load(state_path)
+    try:
+        needed, note = plan_flash(opk_data, saved, resume, delta)
+    except ValueError as e:
+        click.echo(f"Error: {state_path}: {e}")
+        raise SystemExit(2)
+    if note:
+        click.echo(note)
+    if not needed:
+        return
+
+    click.echo(f"Connecting to Psion on {port_device}...")
+
+    boot_transfer = None
     try:
         serial_port = open_serial_port(port_device, baud_rate=ctx.baud)
 
         try:
             link = LinkProtocol(serial_port)
-
-            click.echo("")
-            click.echo("=" * 60)
-            click.echo("On Psion: COMMS > BOOT > press EXE (name can be empty)")
-            click.echo("=" * 60)
-            click.echo("")
-
-            click.echo("Waiting for Psion to enter BOOT mode...")
-
             boot_transfer = BootTransfer(link)
-            boot_transfer.flash_pack(
-                opk_data,
-                progress=progress_bar,
-                user_prompt=user_prompt,
-            )
+
+            if resume:
+                boot_transfer.resume_pack(
+                    opk_data,
+                    saved,
+                    progress=progress_bar,
+                    checkpoint=lambda state: state.save(state_path),
+                )
+            else:
+                click.echo("")
+                click.echo("=" * 60)
+                click.echo("On Psion: COMMS > BOOT > press EXE (name can be empty)")
+                click.echo("=" * 60)
+                click.echo("")
+
+                click.echo("Waiting for Psion to enter BOOT mode...")
+
+                boot_transfer.flash_pack(
+                    opk_data,
+                    progress=progress_bar,
+                    user_prompt=user_prompt,
+                    checkpoint=lambda state: state.save(state_path),
+                )
 
             click.echo("")
             click.echo("Transfer complete! Pack is ready to use.")
@@ -694,14 +921,19 @@ def flash(ctx: Context, file: str, no_prompt: bool) -> None:
         finally:
             close_serial_port(serial_port)
 
-    except ConnectionError as e:
-        click.echo(f"\nConnection error: {e}")
-        raise SystemExit(1)
-    except TransferError as e:
-        click.echo(f"\nTransfer error: {e}")
-        raise SystemExit(1)
-    except CommsError as e:
-        click.echo(f"\nCommunication error: {e}")
+    except (ConnectionError, TransferError, CommsError, OSError) as e:
+        if isinstance(e, ConnectionError):
+            click.echo(f"\nConnection error: {e}")
+        elif isinstance(e, TransferError):
+            click.echo(f"\nTransfer error: {e}")
+        elif isinstance(e, CommsError):
+            click.echo(f"\nCommunication error: {e}")
+        else:
+            click.echo(f"\nSerial port error: {e}")
+        state = boot_transfer.state if boot_transfer else None
+        if state is not None and state.sequence is not None and not state.complete:
+            click.echo(f"{state.acknowledged} of {pack_size} bytes were acknowledged. If the "
+                       f"Psion still shows the bootloader, run again with --resume.")
         raise SystemExit(1)
 
 
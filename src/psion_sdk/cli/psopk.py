@@ -7,7 +7,7 @@ It provides tools for creating, inspecting, and extracting Psion pack images.
 
 Commands
 --------
-- **create**: Create a new OPK file from OB3 files
+- **create**: Create a new OPK file from OB3 files and data tables
 - **list**: List contents of an OPK file
 - **info**: Show detailed pack information
 - **extract**: Extract files from an OPK file
@@ -24,6 +24,9 @@ Create a pack with multiple files:
 Create a Rampak image:
     $ psopk create -o data.opk -t rampak -s 16 program.ob3
 
+Ship a data file already filled from a CSV or JSON table:
+    $ psopk create -o app.opk app.ob3 contacts.csv
+
 List pack contents:
     $ psopk list mypack.opk
 
@@ -52,7 +55,9 @@ from psion_sdk.opk import (
     PackSize,
     ProcedureRecord,
     DataFileRecord,
+    DataRecord,
     validate_ob3,
+    is_table_file,
     OB3File,
 )
 
@@ -112,7 +117,7 @@ def main() -> None:
 
     \b
     Commands:
-      create    Create new OPK from OB3 files
+      create    Create new OPK from OB3 files and data tables
       list      List contents of OPK file
       info      Show detailed pack information
       extract   Extract files from OPK
@@ -160,6 +165,11 @@ def main() -> None:
     default="datapak",
     help="Pack type: datapak, rampak, flashpak (default: datapak)",
 )
+@click.option(
+    "--no-header",
+    is_flag=True,
+    help="First row of CSV files is a record, not field names",
+)
 @click.option(
     "-v", "--verbose",
     is_flag=True,
@@ -170,19 +180,25 @@ def cmd_create(
     output: Path,
     size: str,
     pack_type: PackType,
+    no_header: bool,
     verbose: bool,
 ) -> None:
     """
-    Create a new OPK pack file from OB3 object files.
+    Create a new OPK pack file from OB3 object files and data tables.
 
     INPUT_FILES are one or more OB3 files to include in the pack.
     Each OB3 file becomes a procedure named after the filename.
 
+    CSV and JSON files become data files, also named after the filename,
+    with one record per row: fields joined by TAB, as db.h and OPL read
+    them. The first row of a CSV file names the fields and is skipped.
+
     \b
     Examples:
       psopk create -o hello.opk hello.ob3
       psopk create -o tools.opk -s 32 tool1.ob3 tool2.ob3
       psopk create -o ram.opk -t rampak -s 16 program.ob3
+      psopk create -o app.opk app.ob3 contacts.csv stock.json
     """
     try:
         size_kb = int(size)
@@ -193,11 +209,15 @@ def cmd_create(
         # Create builder
         builder = PackBuilder(size_kb=size_kb, pack_type=pack_type)
 
-        # Add each OB3 file
+        # Add each OB3 file and data table
         for ob3_path in input_files:
             if verbose:
                 click.echo(f"  Adding {ob3_path.name}...")
 
+            if is_table_file(ob3_path):
+                builder.import_data_file(ob3_path, header=not no_header)
+                continue
+
             # Validate OB3 file first
             data = ob3_path.read_bytes()
             if not validate_ob3(data):
@@ -207,7 +227,7 @@ def cmd_create(
 
         # Check if we have any content
         if builder.get_record_count() == 0:
-            click.echo("Error: No procedures to add to pack", err=True)
+            click.echo("Error: No procedures or data files to add to pack", err=True)
             sys.exit(1)
 
         # Check space
@@ -227,6 +247,7 @@ def cmd_create(
 
         # Summary
         procedures = builder.list_procedures()
+        data_files = builder.list_data_files()
         used = builder.get_used_bytes()
         free = builder.get_free_bytes()
 
@@ -235,11 +256,19 @@ def cmd_create(
             click.echo(f"  Procedures: {len(procedures)}")
             for name in procedures:
                 click.echo(f"    - {name}")
+            if data_files:
+                click.echo(f"  Data files: {len(data_files)}")
+                for name, count in data_files:
+                    click.echo(f"    - {name} ({count} records)")
             click.echo(f"  Size: {bytes_written} bytes written")
             click.echo(f"  Used: {used} bytes ({100*used//(size_kb*1024)}%)")
             click.echo(f"  Free: {free} bytes")
         else:
-            click.echo(f"Created {output} ({len(procedures)} procedures, {bytes_written} bytes)")
+            contents = f"{len(procedures)} procedures"
+            if data_files:
+                records = sum(count for _, count in data_files)
+                contents += f", {len(data_files)} data files of {records} records"
+            click.echo(f"Created {output} ({contents}, {bytes_written} bytes)")
 
     except PackSizeError as e:
         click.echo(f"Error: {e}", err=True)
@@ -304,7 +333,10 @@ def cmd_list(opk_file: Path, verbose: bool) -> None:
                 size_str = f"{len(record.object_code)} bytes"
                 click.echo(f"{record.name:<10} {'Procedure':<12} {size_str:>10}")
             elif isinstance(record, DataFileRecord):
-                click.echo(f"{record.name:<10} {'Data File':<12} {'':>10}")
+                size_str = f"{len(parser.get_data_records(record.name))} records"
+                click.echo(f"{record.name:<10} {'Data File':<12} {size_str:>10}")
+            elif isinstance(record, DataRecord):
+                continue    # Counted on its file's line
             else:
                 type_name = f"0x{record.record_type:02X}"
                 click.echo(f"{'':10} {type_name:<12} {'':>10}")
@@ -26,6 +26,8 @@ The comms module is organized into several submodules:
 - **link**: Low-level link protocol (packet framing, handshaking)
 - **serial**: Serial port utilities (detection, configuration)
 - **transfer**: High-level file transfer (FTRAN protocol)
+- **boot**: Pack flashing (BOOT protocol)
+- **fleet**: Running a transfer on several serial ports at once
 
 Quick Start
 -----------
@@ -166,6 +168,7 @@ from psion_sdk.comms.transfer import (
     DirectoryEntry,
     FTRANCommand,
     FileTransfer,
+    TransferStats,
     # Type aliases
     ProgressCallback,
     # Convenience functions
@@ -185,10 +188,21 @@ from psion_sdk.comms.boot import (
     RELOC_OFFSETS,
     # Classes
     BootTransfer,
+    FlashState,
     # Functions
     get_bootloader,
     relocate_bootloader,
     flash_opk,
+    flash_state_path,
+)
+
+# Fleet operations (several ports at once)
+from psion_sdk.comms.fleet import (
+    DeviceResult,
+    FleetProgress,
+    expand_ports,
+    format_fleet_summary,
+    run_fleet,
 )
 
 # Version info
@@ -247,6 +261,7 @@ __all__ = [
     "DirectoryEntry",
     "FTRANCommand",
     "FileTransfer",
+    "TransferStats",
     "ProgressCallback",
     # Transfer Functions
     "send_opk",
@@ -261,8 +276,16 @@ __all__ = [
     "RELOC_OFFSETS",
     # BOOT Protocol Classes
     "BootTransfer",
+    "FlashState",
     # BOOT Protocol Functions
     "get_bootloader",
     "relocate_bootloader",
     "flash_opk",
+    "flash_state_path",
+    # Fleet Operations
+    "DeviceResult",
+    "FleetProgress",
+    "expand_ports",
+    "format_fleet_summary",
+    "run_fleet",
 ]
@@ -27,6 +27,27 @@ User Workflow
 8. Phase 2 executes: Pack image data is written to the pack
 9. Transfer completes
 
+Resuming and Skipping Flashes
+-----------------------------
+The bootloader writes the image it receives to the pack in order,
+starting at pack address 0; there is no address in the phase 2 data
+packets and no way to read the pack back. What can be saved is
+resending data the bootloader already has:
+
+- Every block in phase 2 is answered by a status packet from the
+  bootloader. BootTransfer keeps the number of bytes acknowledged that
+  way, and the sequence number of the last status, in a FlashState.
+  A status with the same sequence number as the last one is a
+  retransmission (the block sent in reply was lost), so that block is
+  sent again instead of the next one being skipped.
+- If the serial link drops, the bootloader keeps waiting for the next
+  block. resume_pack() reconnects to it without repeating phase 1 or
+  the phase 2 negotiation and continues at the last acknowledged block.
+- A FlashState, saved next to the OPK, also records the checksums of the
+  records that were flashed (PackParser.record_checksums()), so pslink
+  can see that a pack already holds the records of an OPK and need not
+  be flashed again.
+
 References
 ----------
 - dev_docs/BOOT_PROTOCOL.md
@@ -34,10 +55,14 @@ References
 """
 
 import base64
+import hashlib
+import json
 import logging
+import os
 import time
+from dataclasses import asdict, dataclass, field
 from pathlib import Path
-from typing import Callable, Final, Optional, Tuple
+from typing import Callable, Final, Optional, Tuple, Union
 
 from psion_sdk.comms.link import (
     LinkProtocol,
@@ -48,6 +73,7 @@ from psion_sdk.comms.link import (
     _find_footer,
 )
 from psion_sdk.errors import ConnectionError, TransferError
+from psion_sdk.opk.parser import PackParser, RecordChecksum
 
 logger = logging.getLogger(__name__)
 
@@ -102,6 +128,9 @@ RELOC_OFFSETS: Final[tuple] = (
     3352,
 )
 
+# Suffix of the file, next to an OPK, that holds its FlashState
+FLASH_STATE_SUFFIX: Final[str] = ".flash"
+
 # Type alias for progress callback
 ProgressCallback = Callable[[int, int], None]
 
@@ -233,6 +262,97 @@ def relocate_bootloader(bootloader: bytes, load_address: int) -> bytes:
     return bytes(relocated)
 
 
+# =============================================================================
+# Flash State
+# =============================================================================
+
+@dataclass
+class FlashState:
+    """
+    Progress of flashing one pack image (see "Resuming and Skipping Flashes").
+
+    Attributes:
+        image_hash: SHA-256 of the pack image (the OPK without its header)
+        image_size: Size of the pack image in bytes
+        acknowledged: Bytes of the image the bootloader has acknowledged
+        sent: Bytes of the image sent (acknowledged + the block in flight)
+        sequence: Sequence number of the bootloader's last status packet
+        complete: True once the whole image has been written
+        records: The image's records, for comparing with another OPK
+    """
+    image_hash: str
+    image_size: int
+    acknowledged: int = 0
+    sent: int = 0
+    sequence: Optional[int] = None
+    complete: bool = False
+    records: list[RecordChecksum] = field(default_factory=list)
+
+    @staticmethod
+    def hash_image(pack_image: bytes) -> str:
+        """The image_hash of a pack image."""
+        return hashlib.sha256(pack_image).hexdigest()
+
+    @classmethod
+    def for_opk(cls, opk_data: bytes) -> "FlashState":
+        """
+        A new state for flashing an OPK.
+
+        Records are only listed if the OPK parses; an image the parser
+        does not understand can still be flashed.
+        """
+        pack_image = opk_data[OPK_HEADER_SIZE:]
+        try:
+            records = PackParser.from_bytes(opk_data).record_checksums()
+        except Exception as e:
+            logger.debug("Cannot list records of pack image: %s", e)
+            records = []
+        return cls(cls.hash_image(pack_image), len(pack_image), records=records)
+
+    def matches(self, opk_data: bytes) -> bool:
+        """True if this state is for the pack image of an OPK."""
+        pack_image = opk_data[OPK_HEADER_SIZE:]
+        return (self.image_size == len(pack_image)
+                and self.image_hash == self.hash_image(pack_image))
+
+    def can_resume(self, opk_data: bytes) -> bool:
+        """True if a transfer of this OPK's image stopped part way."""
+        return not self.complete and self.sequence is not None and self.matches(opk_data)
+
+    @classmethod
+    def load(cls, path: Union[str, Path]) -> Optional["FlashState"]:
+        """
+        Read a saved state.
+
+        Returns:
+            The state, or None if the file is missing or not a state
+        """
+        try:
+            values = json.loads(Path(path).read_text())
+            values["records"] = [RecordChecksum(**r) for r in values.get("records", [])]
+            return cls(**values)
+        except (OSError, ValueError, TypeError) as e:
+            logger.debug("No flash state in %s: %s", path, e)
+            return None
+
+    def save(self, path: Union[str, Path]) -> None:
+        """Write the state, through a temp file that is renamed in place."""
+        path = Path(path)
+        temp = path.with_name(path.name + ".tmp")
+        temp.write_text(json.dumps(asdict(self), indent=1))
+        os.replace(temp, path)
+
+
+def flash_state_path(opk_path: Union[str, Path]) -> Path:
+    """The file that holds the FlashState of an OPK (``<name>.opk.flash``)."""
+    opk_path = Path(opk_path)
+    return opk_path.with_name(opk_path.name + FLASH_STATE_SUFFIX)
+
+
+# Type alias for the callback that saves a FlashState
+CheckpointCallback = Callable[[FlashState], None]
+
+
 # =============================================================================
 # BOOT Protocol Implementation
 # =============================================================================
@@ -275,12 +395,24 @@ class BootTransfer:
         """
         self.link = link
         self._bootloader = get_bootloader()
+        self.state: Optional[FlashState] = None
+        self._checkpoint: Optional[CheckpointCallback] = None
+
+    @staticmethod
+    def _validate_opk(opk_data: bytes) -> None:
+        """Raise ValueError unless the data starts with an OPK header."""
+        if len(opk_data) < OPK_HEADER_SIZE:
+            raise ValueError(f"OPK data too short: {len(opk_data)} bytes")
+
+        if opk_data[:4] != b'OPK\x00':
+            raise ValueError("Invalid OPK file: missing OPK signature")
 
     def flash_pack(
         self,
         opk_data: bytes,
         progress: Optional[ProgressCallback] = None,
         user_prompt: Optional[Callable[[], bool]] = None,
+        checkpoint: Optional[CheckpointCallback] = None,
     ) -> None:
         """
         Flash an OPK pack image to the Psion.
@@ -297,22 +429,22 @@ class BootTransfer:
             user_prompt: Optional callback to prompt user for pack insertion.
                          Should return True to continue, False to abort.
                          If None, continues without prompting.
+            checkpoint: Optional callback given ``self.state`` whenever the
+                        bootloader acknowledges a block and when the
+                        transfer completes, e.g. to save it for resume_pack().
 
         Raises:
             ValueError: If OPK data is invalid.
             ConnectionError: If connection fails.
             TransferError: If transfer fails.
         """
-        # Validate OPK data
-        if len(opk_data) < OPK_HEADER_SIZE:
-            raise ValueError(f"OPK data too short: {len(opk_data)} bytes")
-
-        if opk_data[:4] != b'OPK\x00':
-            raise ValueError("Invalid OPK file: missing OPK signature")
+        self._validate_opk(opk_data)
 
         # Extract pack image (skip OPK header)
         pack_image = opk_data[OPK_HEADER_SIZE:]
         logger.info("Pack image size: %d bytes", len(pack_image))
+        self.state = FlashState.for_opk(opk_data)
+        self._checkpoint = checkpoint
 
         # Phase 1: Upload bootloader
         logger.info("Phase 1: Uploading bootloader...")
@@ -330,6 +462,47 @@ class BootTransfer:
 
         logger.info("BOOT transfer complete!")
 
+    def resume_pack(
+        self,
+        opk_data: bytes,
+        state: FlashState,
+        progress: Optional[ProgressCallback] = None,
+        checkpoint: Optional[CheckpointCallback] = None,
+    ) -> None:
+        """
+        Continue a phase 2 transfer that stopped when the link dropped.
+
+        The bootloader must still be running on the Psion, waiting for the
+        next block. Phase 1 and the phase 2 negotiation are skipped; the
+        bootloader's next (possibly repeated) status packet is answered
+        with the block after the last one it acknowledged.
+
+        Args:
+            opk_data: Complete OPK file contents, the same as before.
+            state: The state of the stopped transfer (see flash_pack's
+                   checkpoint).
+            progress: Optional callback for progress updates (bytes_done, total).
+            checkpoint: Optional callback, as for flash_pack().
+
+        Raises:
+            ValueError: If the OPK data is invalid or the state is not for
+                        a stopped transfer of it.
+            ConnectionError: If the bootloader disconnects.
+            TransferError: If transfer fails.
+        """
+        self._validate_opk(opk_data)
+        if not state.can_resume(opk_data):
+            raise ValueError("Flash state is not for a stopped transfer of this pack image")
+
+        pack_image = opk_data[OPK_HEADER_SIZE:]
+        logger.info("Resuming phase 2 at %d of %d bytes", state.acknowledged, len(pack_image))
+        self.state = state
+        self._checkpoint = checkpoint
+        self.link._connected = True
+        self._phase2_send_pack_data(pack_image, progress, resume=True)
+
+        logger.info("BOOT transfer complete!")
+
     def _phase1_upload_bootloader(
         self,
         progress: Optional[ProgressCallback] = None,
@@ -512,6 +685,7 @@ class BootTransfer:
         self,
         pack_image: bytes,
         progress: Optional[ProgressCallback] = None,
+        resume: bool = False,
     ) -> None:
         """
         Phase 2: Send pack image data to the bootloader.
@@ -524,25 +698,33 @@ class BootTransfer:
         5. Psion sends 0x0101 (ready for data)
         6. Pack data transfer (200-byte chunks, raw data, no address prefix)
         7. Completion handshake: 0x0004 echo exchange, then PC sends empty DATA + DISCONNECT
+
+        With resume=True, steps 1-5 are skipped and the transfer continues
+        from self.state (see resume_pack()).
+
+        The timeout counts from the last packet received, so a large pack
+        can take longer than HANDSHAKE_TIMEOUT as long as the bootloader
+        keeps answering.
         """
         # Build packets for handshake
         link_request = Packet(PacketType.LINK_REQUEST, sequence=0, data=b"")
 
+        if self.state is None:
+            self.state = FlashState(FlashState.hash_image(pack_image), len(pack_image))
+
         # State machine
-        state = 'HANDSHAKE'
+        state = 'CONNECTED' if resume else 'HANDSHAKE'
         buffer = bytearray()
         sync_count = 0
-        negotiation_step = 0  # Track negotiation phase
-        bytes_sent = 0
+        negotiation_step = 3 if resume else 0  # Track negotiation phase
         total_bytes = len(pack_image)
-        data_transfer_started = False
+        data_transfer_started = resume
         waiting_for_final_ack = False
         completion_echo_count = 0  # Track status echo rounds for termination
         first_empty_sent = False  # Track if we've sent the FIRST empty DATA
-        last_data_seq = 0  # Track last data sequence for completion
 
         # Timing
-        start_time = time.time()
+        last_activity = time.time()
         last_link_req_time = 0.0
         READ_TIMEOUT = 0.05
 
@@ -550,7 +732,7 @@ class BootTransfer:
         self.link.port.timeout = READ_TIMEOUT
 
         try:
-            while time.time() - start_time < self.HANDSHAKE_TIMEOUT:
+            while time.time() - last_activity < self.HANDSHAKE_TIMEOUT:
                 now = time.time()
 
                 # Send Link Requests during handshake
@@ -569,6 +751,7 @@ class BootTransfer:
                     buffer = bytearray(remaining)
                     if packet is None:
                         break
+                    last_activity = time.time()
 
                     if state == 'HANDSHAKE' and packet.type == PacketType.LINK_REQUEST:
                         logger.info("Phase 2: Bootloader ready")
@@ -578,8 +761,9 @@ class BootTransfer:
 
                     elif packet.type == PacketType.DISCONNECT:
                         logger.debug("RX: DISCONNECT")
-                        if bytes_sent >= total_bytes:
-                            logger.info("Phase 2 complete: %d bytes sent", bytes_sent)
+                        if self.state.sent >= total_bytes:
+                            logger.info("Phase 2 complete: %d bytes sent", self.state.sent)
+                            self._finish_pack()
                             return
                         raise ConnectionError("Bootloader disconnected during Phase 2")
 
@@ -594,7 +778,8 @@ class BootTransfer:
                             time.sleep(self.PACKET_DELAY)
                             self.link.disconnect(0x00)
                             logger.info("Phase 2 complete: sent DISCONNECT 0x00, %d bytes transferred",
-                                       bytes_sent)
+                                       self.state.sent)
+                            self._finish_pack()
                             time.sleep(0.5)
                             return
 
@@ -663,25 +848,10 @@ class BootTransfer:
                             # The bootloader sends various status values (0x0004, 0x00FF, 0x0014, etc.)
                             status_byte = packet.data[1]
 
-                            if bytes_sent < total_bytes:
-                                # More data to send - status is "send next chunk" signal
-                                self._send_ack(seq)
-                                time.sleep(self.PACKET_DELAY)
-
-                                # Send next chunk with INCREMENTED sequence
-                                next_seq = (seq + 1) & 0x07
-                                chunk_size = min(PACK_DATA_CHUNK_SIZE, total_bytes - bytes_sent)
-                                chunk_data = pack_image[bytes_sent:bytes_sent + chunk_size]
-
-                                self._send_data(next_seq, chunk_data)
-                                bytes_sent += chunk_size
-                                last_data_seq = next_seq
-
+                            if self._send_next_pack_block(seq, pack_image, progress):
+                                # More data to send - status was a "send next chunk" signal
                                 logger.debug("Sent pack data: %d/%d bytes (status=0x%02X)",
-                                            bytes_sent, total_bytes, status_byte)
-
-                                if progress:
-                                    progress(bytes_sent, total_bytes)
+                                            self.state.sent, total_bytes, status_byte)
                             else:
                                 # All data sent - status is completion signal
                                 completion_echo_count += 1
@@ -709,42 +879,17 @@ class BootTransfer:
                             logger.info("Negotiation: received 0x0101 (ready) seq=%d", seq)
                             logger.info("Data transfer: starting, total=%d bytes", total_bytes)
                             data_transfer_started = True
-                            self._send_ack(seq)
-                            time.sleep(self.PACKET_DELAY)
 
-                            # Send first chunk with INCREMENTED sequence
-                            next_seq = (seq + 1) & 0x07
-                            chunk_size = min(PACK_DATA_CHUNK_SIZE, total_bytes)
-                            chunk_data = pack_image[:chunk_size]
-                            logger.info("Data transfer: sending first chunk seq=%d, %d bytes (first 8: %s)",
-                                       next_seq, chunk_size, chunk_data[:8].hex())
-                            self._send_data(next_seq, chunk_data)
-                            bytes_sent = chunk_size
-                            last_data_seq = next_seq
-
-                            if progress:
-                                progress(bytes_sent, total_bytes)
+                            # Send first chunk (or, if this is a repeat, the
+                            # block after the last acknowledged one)
+                            self._send_next_pack_block(seq, pack_image, progress)
                             continue
 
-                        elif data_transfer_started and bytes_sent < total_bytes:
+                        elif data_transfer_started and self.state.sent < total_bytes:
                             # Psion acknowledges data chunk - send next chunk
-                            self._send_ack(seq)
-                            time.sleep(self.PACKET_DELAY)
-
-                            # Send next chunk with INCREMENTED sequence
-                            next_seq = (seq + 1) & 0x07
-                            chunk_size = min(PACK_DATA_CHUNK_SIZE, total_bytes - bytes_sent)
-                            chunk_data = pack_image[bytes_sent:bytes_sent + chunk_size]
-
-                            self._send_data(next_seq, chunk_data)
-                            bytes_sent += chunk_size
-                            last_data_seq = next_seq
-
+                            self._send_next_pack_block(seq, pack_image, progress)
                             logger.debug("Sent pack data: %d/%d bytes",
-                                        bytes_sent, total_bytes)
-
-                            if progress:
-                                progress(bytes_sent, total_bytes)
+                                        self.state.sent, total_bytes)
 
                         else:
                             # Unknown state - respond with ACK and sync
@@ -753,11 +898,75 @@ class BootTransfer:
                             time.sleep(self.PACKET_DELAY)
                             self._send_data(seq, bytes([0x00, 0x00]))
 
-            raise TimeoutError(f"Phase 2 timed out after {self.HANDSHAKE_TIMEOUT}s")
+            raise TimeoutError(
+                f"Phase 2 timed out: no answer for {self.HANDSHAKE_TIMEOUT}s "
+                f"after {self.state.acknowledged} of {total_bytes} bytes"
+            )
 
         finally:
             self.link.port.timeout = old_timeout
 
+    def _send_next_pack_block(
+        self,
+        seq: int,
+        pack_image: bytes,
+        progress: Optional[ProgressCallback] = None,
+    ) -> bool:
+        """
+        Answer a bootloader status packet with the next block of the image.
+
+        A status with the same sequence number as the last one is a
+        retransmission: the block sent in reply to that status did not
+        arrive, and is sent again. Any other status acknowledges everything
+        sent so far. Either way self.state is updated and passed to the
+        checkpoint callback once the block is on its way.
+
+        Args:
+            seq: Sequence number of the status packet.
+            pack_image: The pack image being written.
+            progress: Optional callback for progress updates.
+
+        Returns:
+            True if a block was sent, False if the whole image has been
+            acknowledged.
+        """
+        state = self.state
+        if seq == state.sequence:
+            if state.sent > state.acknowledged:
+                logger.info("Bootloader repeated status seq=%d, resending block at %d",
+                           seq, state.acknowledged)
+            state.sent = state.acknowledged
+        else:
+            state.acknowledged = state.sent
+            state.sequence = seq
+
+        if state.sent >= len(pack_image):
+            if self._checkpoint:
+                self._checkpoint(state)
+            return False
+
+        self._send_ack(seq)
+        time.sleep(self.PACKET_DELAY)
+
+        # Send the block with INCREMENTED sequence
+        next_seq = (seq + 1) & 0x07
+        block = pack_image[state.sent:state.sent + PACK_DATA_CHUNK_SIZE]
+        self._send_data(next_seq, block)
+        state.sent += len(block)
+        if self._checkpoint:
+            self._checkpoint(state)
+
+        if progress:
+            progress(state.sent, len(pack_image))
+        return True
+
+    def _finish_pack(self) -> None:
+        """Record that the whole image was written and pass on the state."""
+        self.state.acknowledged = self.state.sent
+        self.state.complete = True
+        if self._checkpoint:
+            self._checkpoint(self.state)
+
     # -------------------------------------------------------------------------
     # Helper Methods
     # -------------------------------------------------------------------------
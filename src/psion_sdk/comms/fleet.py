@@ -0,0 +1,277 @@
+"""
+Fleet Operations Across Several Serial Ports
+============================================
+
+This module runs the same transfer on many Psion Organisers at once,
+one per serial port, as when a USB hub connects a whole row of them.
+
+Threads
+-------
+Every device gets its own thread with its own serial port and
+LinkProtocol. The links are independent: the Psion drives each of them
+one packet at a time, so a link spends nearly all of its time waiting
+for the serial port, and pyserial releases the interpreter while it
+waits. With one thread per port the fleet finishes in about the time of
+its slowest device instead of the sum of all of them.
+
+Progress and Results
+--------------------
+FleetProgress combines the progress callbacks of all devices into one
+line (bytes done out of the total over all devices, and how many devices
+have finished). run_fleet() returns a DeviceResult per port, in port
+order, with the job's message or the error that stopped it;
+format_fleet_summary() lays them out as a table.
+
+Usage
+-----
+    from psion_sdk.comms.fleet import expand_ports, run_fleet, FleetProgress
+
+    def job(port, progress):
+        serial_port = open_serial_port(port)
+        try:
+            transfer = FileTransfer(LinkProtocol(serial_port))
+            transfer.serve_file("HELLO", data, progress=progress)
+            return str(transfer.last_stats)
+        finally:
+            close_serial_port(serial_port)
+
+    ports = expand_ports(["/dev/ttyUSB*"])
+    results = run_fleet(ports, job, FleetProgress(ports, output=print))
+    print(format_fleet_summary(results))
+"""
+
+import glob
+import logging
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor
+from dataclasses import dataclass
+from typing import Callable, Iterable, Optional
+
+from psion_sdk.comms.transfer import ProgressCallback
+
+logger = logging.getLogger(__name__)
+
+# A job run on one device: given the port and a progress callback, it
+# returns a message for the summary, or raises an exception on failure
+FleetJob = Callable[[str, ProgressCallback], Optional[str]]
+
+# Characters that make a port name a glob pattern
+_GLOB_CHARS = "*?["
+
+
+# =============================================================================
+# Ports
+# =============================================================================
+
+def expand_ports(patterns: Iterable[str]) -> list[str]:
+    """
+    Expand a list of port names and glob patterns.
+
+    Each item may hold several names separated by commas. Patterns such
+    as ``/dev/ttyUSB*`` are replaced by the matching devices, in sorted
+    order; other names (``COM3``) are kept as they are.
+
+    Args:
+        patterns: Port names and patterns
+
+    Returns:
+        The ports, each once, in the order given
+    """
+    ports: list[str] = []
+    for item in patterns:
+        for name in item.split(","):
+            name = name.strip()
+            if not name:
+                continue
+            if any(c in name for c in _GLOB_CHARS):
+                matches = sorted(glob.glob(name))
+                if not matches:
+                    logger.warning("No serial ports match %s", name)
+            else:
+                matches = [name]
+            ports.extend(port for port in matches if port not in ports)
+    return ports
+
+
+# =============================================================================
+# Results and Progress
+# =============================================================================
+
+@dataclass
+class DeviceResult:
+    """
+    Outcome of a fleet job on one device.
+
+    Attributes:
+        port: Serial port of the device
+        ok: True if the job finished without an exception
+        message: The job's message, or the error that stopped it
+        elapsed: Seconds the job ran
+        bytes_done: Bytes reported through the progress callback
+    """
+    port: str
+    ok: bool = False
+    message: str = ""
+    elapsed: float = 0.0
+    bytes_done: int = 0
+
+
+class FleetProgress:
+    """
+    Progress of all devices of a fleet, shown as one line.
+
+    callback(port) gives the progress callback for one device. Every
+    update redraws the line through ``output``, at most every
+    ``interval`` seconds; the callbacks may be called from any thread.
+
+    Example line:
+        [==========----------]  50% 6000/12000 bytes, 2 of 4 devices done
+    """
+
+    BAR_WIDTH = 20
+
+    def __init__(
+        self,
+        ports: Iterable[str],
+        output: Optional[Callable[[str], None]] = None,
+        interval: float = 0.2,
+    ):
+        """
+        Args:
+            ports: The fleet's ports
+            output: Called with each new progress line (None: no output)
+            interval: Shortest time between two lines, in seconds
+        """
+        self._done = {port: 0 for port in ports}
+        self._total = {port: 0 for port in self._done}
+        self._finished: dict[str, bool] = {}
+        self._output = output
+        self._interval = interval
+        self._last_output = 0.0
+        self._lock = threading.Lock()
+        self._output_lock = threading.Lock()
+
+    def callback(self, port: str) -> ProgressCallback:
+        """The progress callback, (bytes_done, total), of one device."""
+        def update(current: int, total: int = 0) -> None:
+            with self._lock:
+                self._done[port] = current
+                self._total[port] = max(total, current)
+            self._show()
+        return update
+
+    def finish(self, result: DeviceResult) -> None:
+        """Record that a device's job has ended."""
+        with self._lock:
+            self._finished[result.port] = result.ok
+        self._show(force=True)
+
+    def bytes_done(self, port: str) -> int:
+        """Bytes a device has reported."""
+        with self._lock:
+            return self._done[port]
+
+    def line(self) -> str:
+        """The current progress line."""
+        with self._lock:
+            done = sum(self._done.values())
+            total = sum(self._total.values())
+            finished = len(self._finished)
+            failed = sum(1 for ok in self._finished.values() if not ok)
+            devices = len(self._done)
+
+        if total:
+            percent = done * 100 // total
+            filled = percent * self.BAR_WIDTH // 100
+            bar = "=" * filled + "-" * (self.BAR_WIDTH - filled)
+            text = f"[{bar}] {percent:3d}% {done}/{total} bytes"
+        else:
+            text = f"{done} bytes"
+        text += f", {finished} of {devices} devices done"
+        if failed:
+            text += f", {failed} failed"
+        return text
+
+    def _show(self, force: bool = False) -> None:
+        """Pass the line to the output, unless one was shown very recently."""
+        if self._output is None:
+            return
+        now = time.monotonic()
+        with self._lock:
+            if not force and now - self._last_output < self._interval:
+                return
+            self._last_output = now
+        with self._output_lock:
+            self._output(self.line())
+
+
+# =============================================================================
+# Running Jobs
+# =============================================================================
+
+def _run_one(port: str, job: FleetJob, progress: FleetProgress) -> DeviceResult:
+    """Run a job on one device, turning an exception into a failed result."""
+    result = DeviceResult(port)
+    start = time.monotonic()
+    try:
+        result.message = job(port, progress.callback(port)) or "done"
+        result.ok = True
+    except Exception as e:
+        logger.debug("Fleet job on %s failed", port, exc_info=True)
+        result.message = f"{type(e).__name__}: {e}"
+    result.elapsed = time.monotonic() - start
+    result.bytes_done = progress.bytes_done(port)
+    progress.finish(result)
+    return result
+
+
+def run_fleet(
+    ports: list[str],
+    job: FleetJob,
+    progress: Optional[FleetProgress] = None,
+    max_workers: Optional[int] = None,
+) -> list[DeviceResult]:
+    """
+    Run a job on every port at once (see "Threads").
+
+    Args:
+        ports: Serial ports, one device each
+        job: Called as job(port, progress_callback) in the device's thread
+        progress: Progress display (default: one without output)
+        max_workers: Most devices handled at a time (default: all)
+
+    Returns:
+        One DeviceResult per port, in the order of ``ports``
+    """
+    if not ports:
+        return []
+    if progress is None:
+        progress = FleetProgress(ports)
+    with ThreadPoolExecutor(max_workers=max_workers or len(ports),
+                            thread_name_prefix="pslink") as pool:
+        futures = [pool.submit(_run_one, port, job, progress) for port in ports]
+        return [future.result() for future in futures]
+
+
+def format_fleet_summary(results: list[DeviceResult]) -> str:
+    """
+    Lay out the results of a fleet run as a table.
+
+    Returns:
+        One line per device and a total line, e.g.
+        ``/dev/ttyUSB0  OK      1234 bytes   12.3 s  done``
+    """
+    if not results:
+        return "No devices"
+    width = max(len(r.port) for r in results)
+    lines = [
+        f"{r.port:<{width}}  {'OK' if r.ok else 'FAILED':<6}  "
+        f"{r.bytes_done:>6} bytes  {r.elapsed:6.1f} s  {r.message}"
+        for r in results
+    ]
+    succeeded = sum(1 for r in results if r.ok)
+    slowest = max(r.elapsed for r in results)
+    lines.append(f"{succeeded} of {len(results)} devices succeeded "
+                 f"(slowest {slowest:.1f} s)")
+    return "\n".join(lines)
@@ -756,17 +756,49 @@ class LinkProtocol:
     # Low-Level Packet I/O
     # -------------------------------------------------------------------------
 
-    def _send_packet(self, packet: Packet) -> None:
+    def _send_packet(self, packet: Packet, flush: bool = True) -> None:
         """
         Send a packet over the serial port.
 
         Args:
             packet: Packet to send.
+            flush: Wait until the packet has been transmitted (see _send_raw).
+        """
+        self._send_raw(packet.to_bytes(), flush)
+
+    def _send_raw(self, wire_bytes: bytes, flush: bool = True) -> None:
+        """
+        Send an already encoded packet over the serial port.
+
+        Args:
+            wire_bytes: Packet bytes as returned by Packet.to_bytes().
+            flush: Wait until the bytes have been transmitted. Without it
+                   the port sends them in the background, while the
+                   caller prepares the next packet.
         """
-        wire_bytes = packet.to_bytes()
         self.port.write(wire_bytes)
-        self.port.flush()
-        logger.debug("Sent %d bytes: %s", len(wire_bytes), wire_bytes.hex())
+        if flush:
+            self.port.flush()
+        if logger.isEnabledFor(logging.DEBUG):
+            logger.debug("Sent %d bytes: %s", len(wire_bytes), wire_bytes.hex())
+
+    def read_available(self, max_bytes: int = 512) -> bytes:
+        """
+        Read the bytes that have arrived, without waiting for more.
+
+        Returns as soon as at least one byte is there, or after the port
+        timeout if none arrives. A plain port.read(512) waits out the
+        whole timeout whenever fewer bytes come in, which at 9600 baud
+        means waiting for every short ACK.
+
+        Args:
+            max_bytes: Maximum number of bytes to return.
+
+        Returns:
+            Received bytes (empty on timeout).
+        """
+        waiting = self.port.in_waiting
+        return self.port.read(min(max(waiting, 1), max_bytes))
 
     def _receive_packet(self, timeout: float) -> Packet:
         """
@@ -853,6 +885,11 @@ class LinkProtocol:
         if self._rx_sequence == 8:
             self._rx_sequence = 0
 
+    @staticmethod
+    def _next_sequence(seq: int) -> int:
+        """Get the sequence number that follows seq (1-7, 0, 1-7, ...)."""
+        return (seq + 1) & 0x07
+
     @staticmethod
     def _previous_sequence(seq: int) -> int:
         """Get the previous sequence number for NAK responses."""
@@ -99,6 +99,29 @@ For ODB files (type=0x00), simpler format:
 - 00: Status OK
 - len_lo len_hi: File length in little-endian
 
+Pipelined Mode
+--------------
+The Psion drives the transfer and handles one packet at a time: it
+sends a command, waits for the ACK + DATA answer, ACKs that and sends
+the next command. There is no window of packets in flight to widen, but
+the PC's side of each round trip can be shortened. With
+``FileTransfer(link, pipelined=True)``:
+
+- The ACK and DATA that answer the next GetData (with the next sequence
+  number, the next bytes of the file and the same length as the last
+  request) are framed and CRC'd during the delay between the current
+  ACK and DATA, instead of after the request arrives. A request that
+  does not match the prediction is answered with freshly encoded packets.
+- DATA packets are not flushed: the port transmits them in the
+  background while the PC goes back to waiting for the Psion.
+- Reads return as soon as bytes arrive instead of waiting out the read
+  timeout, which otherwise adds up to 50 ms to every round trip.
+
+Every transfer records its throughput in ``FileTransfer.last_stats``.
+
+Blocks are as large as the Psion asks for in each GetData; the length
+field is one byte, so they are at most 255 bytes.
+
 References
 ----------
 - FTRAN_PROTOCOL_NOTES.md: Detailed protocol investigation notes
@@ -107,9 +130,9 @@ References
 
 import logging
 import time
-from dataclasses import dataclass
+from dataclasses import dataclass, field
 from enum import IntEnum
-from typing import Callable, Final, Optional, Tuple
+from typing import Callable, Dict, Final, Optional, Tuple
 
 from psion_sdk.comms.link import LinkProtocol, Packet, PacketType
 from psion_sdk.errors import CommsError, ConnectionError, ProtocolError, TransferError
@@ -229,6 +252,52 @@ class DirectoryEntry:
         return self.name
 
 
+@dataclass
+class TransferStats:
+    """
+    Throughput of one file transfer.
+
+    Attributes:
+        total_bytes: File bytes transferred
+        blocks: Number of data blocks (GetData answers or PutData packets)
+        elapsed: Seconds from the first block to the end of the transfer
+        max_block: Largest block, in bytes
+        pipelined: True if the transfer ran in pipelined mode
+    """
+
+    total_bytes: int = 0
+    blocks: int = 0
+    elapsed: float = 0.0
+    max_block: int = 0
+    pipelined: bool = False
+    _started: Optional[float] = field(default=None, repr=False, compare=False)
+
+    @property
+    def bytes_per_second(self) -> float:
+        """Average throughput (0 before the transfer has taken any time)."""
+        return self.total_bytes / self.elapsed if self.elapsed > 0 else 0.0
+
+    def add_block(self, size: int) -> None:
+        """Count a block of size bytes."""
+        now = time.monotonic()
+        if self._started is None:
+            self._started = now
+        self.blocks += 1
+        self.total_bytes += size
+        self.max_block = max(self.max_block, size)
+        self.elapsed = now - self._started
+
+    def finish(self) -> None:
+        """Stop the clock at the end of the transfer."""
+        if self._started is not None:
+            self.elapsed = time.monotonic() - self._started
+
+    def __str__(self) -> str:
+        """Format for display."""
+        return (f"{self.total_bytes} bytes in {self.blocks} blocks, "
+                f"{self.elapsed:.2f} s ({self.bytes_per_second:.0f} bytes/s)")
+
+
 @dataclass
 class FTRANCommand:
     """
@@ -295,7 +364,7 @@ class FileTransfer:
     # Short delay between ACK and DATA response
     RESPONSE_DELAY: Final[float] = 0.02
 
-    def __init__(self, link: LinkProtocol):
+    def __init__(self, link: LinkProtocol, pipelined: bool = False):
         """
         Initialize the file transfer handler.
 
@@ -303,10 +372,19 @@ class FileTransfer:
             link: LinkProtocol instance. For receive operations, the
                   connection is established internally. For send operations,
                   the link should already be connected.
+            pipelined: Prepare answers ahead and don't wait for packets
+                       to drain (see "Pipelined Mode" in the module docs).
         """
         self.link = link
+        self.pipelined = pipelined
         self._current_sequence = 1
 
+        # Throughput of the last serve or receive
+        self.last_stats: Optional[TransferStats] = None
+
+        # Encoded ACK + empty DATA answers, by sequence (pipelined mode)
+        self._empty_answers: Dict[int, Tuple[bytes, bytes]] = {}
+
     # -------------------------------------------------------------------------
     # Low-Level Protocol Helpers
     # -------------------------------------------------------------------------
@@ -352,6 +430,64 @@ class FileTransfer:
         time.sleep(self.RESPONSE_DELAY)
         self._send_data_response(sequence, data)
 
+    def _encode_answer(self, sequence: int, data: bytes = b"") -> Tuple[bytes, bytes]:
+        """
+        Encode the ACK + DATA answer to a Psion DATA packet.
+
+        Args:
+            sequence: Sequence number for both packets.
+            data: Data payload for the DATA packet.
+
+        Returns:
+            Wire bytes of the ACK and of the DATA packet.
+        """
+        return (Packet(PacketType.ACK, sequence=sequence, data=b"").to_bytes(),
+                Packet(PacketType.DATA, sequence=sequence, data=data).to_bytes())
+
+    def _send_answer(
+        self,
+        answer: Tuple[bytes, bytes],
+        prepare_next: Optional[Callable[[], None]] = None,
+    ) -> None:
+        """
+        Send an encoded ACK + DATA answer (see _send_ack_and_data).
+
+        In pipelined mode the DATA packet is not flushed, and prepare_next
+        is called in the delay between the two packets, with only the rest
+        of the delay slept off.
+
+        Args:
+            answer: Wire bytes from _encode_answer().
+            prepare_next: Encodes the answer to the next request.
+        """
+        ack_bytes, data_bytes = answer
+        self.link._send_raw(ack_bytes)
+        if self.pipelined:
+            started = time.monotonic()
+            if prepare_next is not None:
+                prepare_next()
+            time.sleep(max(0.0, self.RESPONSE_DELAY - (time.monotonic() - started)))
+            self.link._send_raw(data_bytes, flush=False)
+        else:
+            time.sleep(self.RESPONSE_DELAY)
+            self.link._send_raw(data_bytes)
+
+    def _send_empty_answer(self, sequence: int) -> None:
+        """Answer a Psion DATA packet with ACK + empty DATA."""
+        if not self.pipelined:
+            self._send_ack_and_data(sequence)
+            return
+        answer = self._empty_answers.get(sequence)
+        if answer is None:
+            answer = self._empty_answers[sequence] = self._encode_answer(sequence)
+        self._send_answer(answer)
+
+    def _read_chunk(self) -> bytes:
+        """Read from the port in the serve and receive loops."""
+        if self.pipelined:
+            return self.link.read_available()
+        return self.link.port.read(512)
+
     def _send_disconnect(self, data: bytes = b"") -> None:
         """
         Send a DISCONNECT packet.
@@ -609,6 +745,11 @@ class FileTransfer:
         buffer = bytearray()
         got_ftran = False
         actual_type = file_type
+        stats = self.last_stats = TransferStats(pipelined=self.pipelined)
+
+        # Pipelined mode: ((sequence, offset, length), answer) prepared for
+        # the GetData expected next
+        prepared: Optional[Tuple[Tuple[int, int, int], Tuple[bytes, bytes]]] = None
 
         # Timing
         start_time = time.time()
@@ -630,7 +771,7 @@ class FileTransfer:
                     last_link_req_time = now
 
                 # Read available data
-                chunk = self.link.port.read(512)
+                chunk = self._read_chunk()
                 if chunk:
                     buffer.extend(chunk)
 
@@ -701,17 +842,37 @@ class FileTransfer:
                                     self._send_ack(seq)
                                     time.sleep(self.RESPONSE_DELAY)
                                     self._send_disconnect(bytes([EOF_DISCONNECT_BYTE]))
-                                    logger.info("Transfer complete: %d bytes sent", bytes_sent)
+                                    stats.finish()
+                                    logger.info("Transfer complete: %s", stats)
                                     return 'complete'
 
-                                # Send next chunk
+                                # Send next chunk, as prepared if it was predicted
+                                request = (seq, bytes_sent, requested_len)
                                 chunk_end = min(bytes_sent + requested_len, total_bytes)
-                                file_chunk = data[bytes_sent:chunk_end]
+                                if prepared is not None and prepared[0] == request:
+                                    answer = prepared[1]
+                                else:
+                                    answer = self._encode_answer(seq, data[bytes_sent:chunk_end])
+                                prepared = None
+                                block_size = chunk_end - bytes_sent
+                                stats.add_block(block_size)
                                 bytes_sent = chunk_end
 
-                                self._send_ack_and_data(seq, file_chunk)
+                                def prepare_next() -> None:
+                                    # The next GetData most likely asks for as
+                                    # much again, with the next sequence number
+                                    nonlocal prepared
+                                    if chunk_end < total_bytes:
+                                        next_seq = LinkProtocol._next_sequence(seq)
+                                        next_end = min(chunk_end + requested_len, total_bytes)
+                                        prepared = (
+                                            (next_seq, chunk_end, requested_len),
+                                            self._encode_answer(next_seq, data[chunk_end:next_end]),
+                                        )
+
+                                self._send_answer(answer, prepare_next)
                                 logger.debug("Sent %d bytes (total: %d/%d)",
-                                            len(file_chunk), bytes_sent, total_bytes)
+                                            block_size, bytes_sent, total_bytes)
 
                                 if progress:
                                     progress(bytes_sent, total_bytes)
@@ -813,6 +974,7 @@ class FileTransfer:
         filename = None
         data = bytearray()
         buffer = bytearray()
+        stats = self.last_stats = TransferStats(pipelined=self.pipelined)
 
         # Timing
         start_time = time.time()
@@ -834,7 +996,7 @@ class FileTransfer:
                     last_link_req_time = now
 
                 # Read any available data (non-blocking style)
-                chunk = self.link.port.read(512)
+                chunk = self._read_chunk()
                 if chunk:
                     buffer.extend(chunk)
 
@@ -860,6 +1022,8 @@ class FileTransfer:
                         self.link._connected = False
                         if connection_count >= expected_connections:
                             # All done
+                            stats.finish()
+                            logger.info("Received %s", stats)
                             return filename, bytes(data)
                         # Go back to handshake for next connection
                         state = 'HANDSHAKE'
@@ -874,7 +1038,7 @@ class FileTransfer:
                         logger.debug("RX: DATA seq=%d len=%d", seq, len(packet.data))
 
                         # Always respond with ACK + empty DATA
-                        self._send_ack_and_data(seq)
+                        self._send_empty_answer(seq)
 
                         # Process content
                         if packet.data == FTRAN_OVERLAY:
@@ -894,6 +1058,7 @@ class FileTransfer:
                             elif cmd.command == CMD_PUT_DATA:
                                 if cmd.data:
                                     data.extend(cmd.data)
+                                    stats.add_block(len(cmd.data))
                                     if progress:
                                         progress(len(data))
 
@@ -67,20 +67,24 @@ Module Structure
 
 - `emulator.py`: Main Emulator class (high-level API)
 - `cpu.py`: HD6303 CPU implementation
+- `blocks.py`: Optional basic-block translation cache
 - `bus.py`: Memory bus and I/O controller
 - `memory.py`: RAM and ROM with bank switching
 - `display.py`: LCD controller
 - `keyboard.py`: Key matrix handling
 - `pack.py`: Pack/cartridge emulation
 - `breakpoints.py`: Debugging support
+- `profiler.py`: Cycle profiler with call graph and flamegraph output
 - `models.py`: Psion model configurations
+- `pool.py`: Boot-once emulator pool with forking
 
 Copyright (c) 2025 Hugo José Pinto & Contributors
 Ported from JAPE by Jaap Scherphuis
 """
 
 # Main entry point
-from .emulator import Emulator, EmulatorConfig
+from .emulator import Emulator, EmulatorConfig, EmulatorImage
+from .pool import EmulatorPool
 
 # CPU components
 from .cpu import HD6303, CPUState, Flags
@@ -117,6 +121,7 @@ from .breakpoints import (
     BreakEvent,
     BreakReason,
 )
+from .profiler import Profiler, SymbolTable, FunctionProfile
 
 # Model configurations
 from .models import (
@@ -139,6 +144,8 @@ __all__ = [
     # Main API
     "Emulator",
     "EmulatorConfig",
+    "EmulatorImage",
+    "EmulatorPool",
 
     # CPU
     "HD6303",
@@ -182,6 +189,9 @@ __all__ = [
     "BreakpointManager",
     "BreakEvent",
     "BreakReason",
+    "Profiler",
+    "SymbolTable",
+    "FunctionProfile",
 
     # Models
     "PsionModel",
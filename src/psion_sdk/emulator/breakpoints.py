@@ -47,6 +47,7 @@ class BreakReason(Enum):
     STEP = auto()              # Single-step mode
     USER_INTERRUPT = auto()    # User requested stop
     MAX_CYCLES = auto()        # Maximum cycle count reached
+    DISPLAY_CHANGE = auto()    # Display contents changed (run with stop_on_display_change)
     ERROR = auto()             # Runtime error occurred
 
 
@@ -88,6 +89,8 @@ class BreakEvent:
                 return "Single step"
             case BreakReason.MAX_CYCLES:
                 return "Maximum cycles reached"
+            case BreakReason.DISPLAY_CHANGE:
+                return "Display changed"
             case BreakReason.ERROR:
                 return "Runtime error"
             case _:
@@ -257,6 +260,47 @@ class BreakpointManager:
         """Number of active watchpoints (read + write)."""
         return len(self._read_watchpoints) + len(self._write_watchpoints)
 
+    @property
+    def is_active(self) -> bool:
+        """
+        Check if any per-instruction or per-access checks are needed.
+
+        False when there are no breakpoints, watchpoints or syscall hooks,
+        and no step or break request is pending. The emulator then runs the
+        CPU's unhooked fast path instead of calling the check functions on
+        every instruction and memory access.
+        """
+        return bool(
+            self._pc_breakpoints or
+            self._read_watchpoints or
+            self._write_watchpoints or
+            self._syscall_hooks or
+            self._step_mode or
+            self._break_requested
+        )
+
+    @property
+    def only_pc_breakpoints(self) -> bool:
+        """
+        Check if PC breakpoints are the only registered checks.
+
+        When True, a break can only happen before an instruction at one of
+        the breakpoint addresses, so execution engines may skip the check
+        everywhere else (see BlockCache.execute).
+        """
+        return not (
+            self._read_watchpoints or
+            self._write_watchpoints or
+            self._syscall_hooks or
+            self._step_mode or
+            self._break_requested
+        )
+
+    @property
+    def breakpoint_addresses(self) -> frozenset:
+        """Addresses of all PC breakpoints."""
+        return frozenset(self._pc_breakpoints)
+
     # =========================================================================
     # PC Breakpoints
     # =========================================================================
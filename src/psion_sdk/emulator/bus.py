@@ -140,6 +140,11 @@ class Bus:
         # Initialize state
         self._state = BusState()
 
+        # Memory's page maps, shared so plain memory accesses skip the
+        # address decoding below (pages $00-$03 are never mapped)
+        self._read_pages = memory.read_pages
+        self._write_pages = memory.write_pages
+
         # Callback for power on/off events
         self.on_switch_on_off: Optional[Callable[[bool], None]] = None
 
@@ -211,6 +216,8 @@ class Bus:
         - $100-$3FF: Semi-custom chip / display
         - $400+: Main memory
 
+        Pages in the memory page map are read straight from their buffer.
+
         Args:
             address: 16-bit address
 
@@ -219,6 +226,11 @@ class Bus:
         """
         address = address & 0xFFFF
 
+        entry = self._read_pages[address >> 8]
+        if entry is not None:
+            buffer, base = entry
+            return buffer[base + address]
+
         if address < 0x40:
             return self._processor_read(address)
         elif address < 0x100:
@@ -241,6 +253,12 @@ class Bus:
         address = address & 0xFFFF
         value = value & 0xFF
 
+        entry = self._write_pages[address >> 8]
+        if entry is not None:
+            buffer, base = entry
+            buffer[base + address] = value
+            return
+
         if address < 0x40:
             self._processor_write(address, value)
         elif address < 0x100:
@@ -526,6 +544,19 @@ class Bus:
         # Track ticks for NMI timing
         self._state.ticks_since_nmi += ticks
 
+    def ticks_until_event(self) -> int:
+        """
+        Number of ticks that can pass before an interrupt may become due.
+
+        Advancing inc_frame() by fewer ticks than this cannot raise OCI or
+        reach the NMI period, so callers can safely batch timing updates.
+        Returns 0 or less if an event is already due.
+        """
+        return min(
+            self._state.timer1_ocr - self._state.timer1_frc,
+            self.TICKS_PER_NMI - self._state.ticks_since_nmi
+        )
+
     def is_oci_due(self) -> bool:
         """
         Check if OCI interrupt is pending.
@@ -22,7 +22,10 @@ Ported from JAPE by Jaap Scherphuis
 
 from dataclasses import dataclass
 from enum import IntFlag
-from typing import Callable, Optional, Protocol
+from typing import TYPE_CHECKING, Callable, Optional, Protocol
+
+if TYPE_CHECKING:
+    from .profiler import Profiler
 
 
 class Flags(IntFlag):
@@ -43,6 +46,36 @@ class Flags(IntFlag):
     H = 0x20  # Half-carry (for BCD)
 
 
+# Plain-int flag masks for the per-instruction paths. IntFlag arithmetic goes
+# through the enum machinery on every operation, which dominates profiles.
+# The clear masks keep only the six defined flag bits, exactly as the
+# IntFlag complement (~Flags.C etc.) does.
+_FLAG_C = 0x01
+_FLAG_V = 0x02
+_FLAG_Z = 0x04
+_FLAG_N = 0x08
+_FLAG_I = 0x10
+_FLAG_H = 0x20
+_FLAGS_DEFINED = 0x3F
+
+# Branches and jumps with no side effect besides PC. One that lands on its
+# own address repeats unchanged until an interrupt, so it can be skipped
+# ahead like SLP (see HD6303.fast_forward_idle).
+_SPIN_OPCODES = frozenset(range(0x20, 0x30)) | {0x6E, 0x7E}
+
+
+# Opcode -> handler method name, filled in by @_opcode as HD6303 is defined
+_OPCODE_HANDLERS: dict[int, str] = {}
+
+
+def _opcode(code: int) -> Callable[[Callable[["HD6303"], int]], Callable[["HD6303"], int]]:
+    """Register the decorated HD6303 method as the handler for an opcode."""
+    def register(handler: Callable[["HD6303"], int]) -> Callable[["HD6303"], int]:
+        _OPCODE_HANDLERS[code] = handler.__name__
+        return handler
+    return register
+
+
 class BusProtocol(Protocol):
     """
     Protocol defining the memory bus interface.
@@ -73,6 +106,10 @@ class BusProtocol(Protocol):
         """Check if system is powered off."""
         ...
 
+    def ticks_until_event(self) -> int:
+        """Ticks before an interrupt may become due (fast_forward_idle only)."""
+        ...
+
 
 @dataclass
 class CPUState:
@@ -137,6 +174,18 @@ class HD6303:
         # Flag set by hooks to request execution stop
         self._memory_break_requested: bool = False
 
+        # Set (e.g. by a device callback) to end the
+        # running execute call at the next instruction boundary
+        self.stop_requested: bool = False
+
+        # Skip SLP and jump-to-self idle loops straight to the next
+        # interrupt. Cycle counts are unchanged; requires
+        # bus.ticks_until_event().
+        self.fast_forward_idle: bool = False
+
+        # Opcode dispatch table (one bound handler per opcode)
+        self._dispatch: list[Callable[[], int]] = self._build_dispatch_table()
+
     # ========================================
     # Register Properties (match JAPE naming)
     # ========================================
@@ -203,74 +252,74 @@ class HD6303:
     @property
     def flag_c(self) -> bool:
         """Carry flag."""
-        return bool(self.state.flags & Flags.C)
+        return (self.state.flags & _FLAG_C) != 0
 
     @flag_c.setter
     def flag_c(self, value: bool) -> None:
         if value:
-            self.state.flags |= Flags.C
+            self.state.flags |= _FLAG_C
         else:
-            self.state.flags &= ~Flags.C
+            self.state.flags &= _FLAGS_DEFINED ^ _FLAG_C
 
     @property
     def flag_v(self) -> bool:
         """Overflow flag."""
-        return bool(self.state.flags & Flags.V)
+        return (self.state.flags & _FLAG_V) != 0
 
     @flag_v.setter
     def flag_v(self, value: bool) -> None:
         if value:
-            self.state.flags |= Flags.V
+            self.state.flags |= _FLAG_V
         else:
-            self.state.flags &= ~Flags.V
+            self.state.flags &= _FLAGS_DEFINED ^ _FLAG_V
 
     @property
     def flag_z(self) -> bool:
         """Zero flag."""
-        return bool(self.state.flags & Flags.Z)
+        return (self.state.flags & _FLAG_Z) != 0
 
     @flag_z.setter
     def flag_z(self, value: bool) -> None:
         if value:
-            self.state.flags |= Flags.Z
+            self.state.flags |= _FLAG_Z
         else:
-            self.state.flags &= ~Flags.Z
+            self.state.flags &= _FLAGS_DEFINED ^ _FLAG_Z
 
     @property
     def flag_n(self) -> bool:
         """Negative flag."""
-        return bool(self.state.flags & Flags.N)
+        return (self.state.flags & _FLAG_N) != 0
 
     @flag_n.setter
     def flag_n(self, value: bool) -> None:
         if value:
-            self.state.flags |= Flags.N
+            self.state.flags |= _FLAG_N
         else:
-            self.state.flags &= ~Flags.N
+            self.state.flags &= _FLAGS_DEFINED ^ _FLAG_N
 
     @property
     def flag_i(self) -> bool:
         """Interrupt mask flag."""
-        return bool(self.state.flags & Flags.I)
+        return (self.state.flags & _FLAG_I) != 0
 
     @flag_i.setter
     def flag_i(self, value: bool) -> None:
         if value:
-            self.state.flags |= Flags.I
+            self.state.flags |= _FLAG_I
         else:
-            self.state.flags &= ~Flags.I
+            self.state.flags &= _FLAGS_DEFINED ^ _FLAG_I
 
     @property
     def flag_h(self) -> bool:
         """Half-carry flag."""
-        return bool(self.state.flags & Flags.H)
+        return (self.state.flags & _FLAG_H) != 0
 
     @flag_h.setter
     def flag_h(self, value: bool) -> None:
         if value:
-            self.state.flags |= Flags.H
+            self.state.flags |= _FLAG_H
         else:
-            self.state.flags &= ~Flags.H
+            self.state.flags &= _FLAGS_DEFINED ^ _FLAG_H
 
     def _get_p(self) -> int:
         """Get processor status byte (flags with bits 6,7 set)."""
@@ -410,6 +459,8 @@ class HD6303:
         Execute instructions for specified number of cycles.
 
         This is the main emulation entry point matching JAPE's execute().
+        When no instrumentation hooks are installed, this delegates to the
+        faster execute_unhooked() loop.
 
         Args:
             ticks_to_execute: Maximum number of CPU cycles to execute
@@ -423,9 +474,18 @@ class HD6303:
             - CPU enters sleep mode
             - Stack error detected
         """
+        if (self.on_instruction is None and self.on_memory_read is None
+                and self.on_memory_write is None):
+            return self.execute_unhooked(ticks_to_execute)
+
+        dispatch = self._dispatch
         total_ticks = 0
 
         while ticks_to_execute > 0:
+            if self.stop_requested:
+                self.stop_requested = False
+                return total_ticks
+
             ticks = 0
 
             # Check for NMI
@@ -446,6 +506,9 @@ class HD6303:
             # Fetch instruction
             if self.state.sleep or self.bus.is_switched_off():
                 inst = 1  # NOP when sleeping
+                if self.fast_forward_idle and ticks == 0:
+                    # Sleep through to the next interrupt in one step
+                    ticks = self._idle_ticks(1, ticks_to_execute) - 1
             else:
                 # Call instruction hook if set
                 if self.on_instruction:
@@ -457,7 +520,7 @@ class HD6303:
                 inst = self._fetch_byte()
 
             ticks += 1
-            ticks += self._execute_instruction(inst)
+            ticks += dispatch[inst]()
 
             # Check if a memory watchpoint was triggered
             if self._memory_break_requested:
@@ -473,10 +536,201 @@ class HD6303:
 
         return total_ticks
 
-    def step(self) -> int:
+    def execute_unhooked(self, ticks_to_execute: int) -> int:
+        """
+        Execute instructions with all instrumentation hooks bypassed.
+
+        Same semantics and cycle counts as execute(), but the instruction
+        and memory hooks are detached for the duration of the call, so no
+        per-instruction breakpoint checks or per-access watchpoint checks
+        are made. Bus methods and CPU state are bound to locals to keep the
+        loop tight.
+
+        Use this when no breakpoints, watchpoints or syscall hooks are
+        registered (see BreakpointManager.is_active).
+
+        Args:
+            ticks_to_execute: Maximum number of CPU cycles to execute
+
+        Returns:
+            Actual number of cycles executed
+        """
+        saved_hooks = (self.on_instruction, self.on_memory_read, self.on_memory_write)
+        self.on_instruction = None
+        self.on_memory_read = None
+        self.on_memory_write = None
+
+        bus = self.bus
+        bus_read = bus.read
+        is_nmi_due = bus.is_nmi_due
+        is_oci_due = bus.is_oci_due
+        is_switched_off = bus.is_switched_off
+        inc_frame = bus.inc_frame
+        do_interrupt = self._do_interrupt
+        dispatch = self._dispatch
+        state = self.state
+        fast_forward = self.fast_forward_idle
+        idle_ticks = self._idle_ticks
+        total_ticks = 0
+        # Cycles of the jump-to-self at PC, or 0 if not spinning
+        spin = 0
+
+        try:
+            while ticks_to_execute > 0:
+                if self.stop_requested:
+                    self.stop_requested = False
+                    break
+
+                ticks = 1
+
+                if is_nmi_due():
+                    ticks += do_interrupt(0xFFFC)
+                    state.sleep = False
+                    spin = 0
+
+                if is_oci_due() and not (state.flags & _FLAG_I):
+                    ticks += do_interrupt(0xFFF4)
+                    state.sleep = False
+                    spin = 0
+
+                sp = state.sp
+                if (0 < sp < 0x00E0) or (0x100 <= sp < 0x400) or sp > 0x8000:
+                    raise RuntimeError(f"Stack error: SP=${sp:04X}")
+
+                if not (state.sleep or is_switched_off()):
+                    if spin:
+                        # Repeat the jump-to-self up to the next interrupt
+                        ticks = idle_ticks(spin, ticks_to_execute)
+                    else:
+                        # Inline _fetch_byte() followed by dispatch
+                        pc = state.pc
+                        state.pc = (pc + 1) & 0xFFFF
+                        opcode = bus_read(pc) & 0xFF
+                        cycles = dispatch[opcode]()
+                        ticks += cycles
+                        if fast_forward and state.pc == pc and opcode in _SPIN_OPCODES:
+                            spin = cycles + 1
+                elif fast_forward and ticks == 1:
+                    # Sleep through to the next interrupt in one step
+                    ticks = idle_ticks(1, ticks_to_execute)
+                # else: NOP when sleeping (handler adds no cycles)
+
+                inc_frame(ticks)
+                ticks_to_execute -= ticks
+                total_ticks += ticks
+        finally:
+            self.on_instruction, self.on_memory_read, self.on_memory_write = saved_hooks
+
+        return total_ticks
+
+    def execute_profiled(self, ticks_to_execute: int, profiler: "Profiler") -> int:
+        """
+        Execute instructions while feeding a cycle profiler.
+
+        Same semantics and cycle counts as execute(), including the
+        instruction and memory hooks. Every instruction and interrupt is
+        reported to the profiler; sleep cycles are charged to the SLP
+        instruction. Idle jump-to-self loops are not fast-forwarded so
+        that each iteration is recorded.
+
+        Args:
+            ticks_to_execute: Maximum number of CPU cycles to execute
+            profiler: Profiler attached to this CPU
+
+        Returns:
+            Actual number of cycles executed
+        """
+        dispatch = self._dispatch
+        record = profiler.record
+        record_interrupt = profiler.interrupt
+        state = self.state
+        total_ticks = 0
+
+        while ticks_to_execute > 0:
+            if self.stop_requested:
+                self.stop_requested = False
+                return total_ticks
+
+            ticks = 0
+
+            # Check for NMI
+            if self.bus.is_nmi_due():
+                cycles = self._do_interrupt(0xFFFC)
+                record_interrupt(0xFFFC, cycles)
+                ticks += cycles
+                state.sleep = False
+
+            # Check for OCI (Output Compare Interrupt)
+            if self.bus.is_oci_due() and not self.flag_i:
+                cycles = self._do_interrupt(0xFFF4)
+                record_interrupt(0xFFF4, cycles)
+                ticks += cycles
+                state.sleep = False
+
+            sp = state.sp
+            if (sp > 0 and sp < 0x00E0) or (sp >= 0x100 and sp < 0x400) or sp > 0x8000:
+                raise RuntimeError(f"Stack error: SP=${sp:04X}")
+
+            if state.sleep or self.bus.is_switched_off():
+                # NOP when sleeping, charged to the SLP before PC
+                pc = (state.pc - 1) & 0xFFFF
+                inst = 0x01
+                cycles = 1
+                if self.fast_forward_idle and ticks == 0:
+                    cycles = self._idle_ticks(1, ticks_to_execute)
+            else:
+                pc = state.pc
+                if self.on_instruction:
+                    next_inst = self._read_byte(pc)
+                    if not self.on_instruction(pc, next_inst):
+                        return total_ticks
+                inst = self._fetch_byte()
+                cycles = 1 + dispatch[inst]()
+
+            record(pc, inst, cycles)
+            ticks += cycles
+
+            # Check if a memory watchpoint was triggered
+            if self._memory_break_requested:
+                self._memory_break_requested = False
+                self.bus.inc_frame(ticks)
+                return total_ticks + ticks
+
+            self.bus.inc_frame(ticks)
+
+            ticks_to_execute -= ticks
+            total_ticks += ticks
+
+        return total_ticks
+
+    def _idle_ticks(self, cycles: int, ticks_to_execute: int) -> int:
+        """
+        Cycles taken by repeating an idle instruction until the next event.
+
+        The instruction (a sleep NOP or a jump-to-self) is repeated until
+        the next OCI/NMI can become due or the budget runs out, exactly as
+        the execute() loop would do one iteration at a time. Must be called
+        after that iteration's interrupt checks.
+
+        Args:
+            cycles: Cycles of one iteration of the idle instruction
+            ticks_to_execute: Remaining cycle budget
+
+        Returns:
+            Total cycles of the repeated iterations (at least one)
+        """
+        until_event = self.bus.ticks_until_event()
+        limit = until_event if until_event < ticks_to_execute else ticks_to_execute
+        repeats = -(-limit // cycles)
+        return cycles * repeats if repeats > 1 else cycles
+
+    def step(self, profiler: Optional["Profiler"] = None) -> int:
         """
         Execute exactly one instruction.
 
+        Args:
+            profiler: Profiler to record the instruction in (optional)
+
         Returns:
             Number of cycles consumed by the instruction
         """
@@ -486,6 +740,8 @@ class HD6303:
 
         try:
             # Execute minimal cycles - will complete one instruction
+            if profiler is not None:
+                return self.execute_profiled(1, profiler)
             return self.execute(1)
         finally:
             self.on_instruction = saved_hook
@@ -737,14 +993,18 @@ class HD6303:
     # ========================================
     # Instruction Execution (ported from JAPE)
     # ========================================
+    #
+    # JAPE implements execution as one large switch statement. Here each
+    # case is its own handler method, registered with @_opcode and looked up
+    # through a 256-entry table that is built once per CPU instance.
 
     def _execute_instruction(self, opcode: int) -> int:
         """
         Execute a single instruction.
 
-        This is a direct port of JAPE's switch statement in execute().
-        Each case returns the additional cycles consumed (beyond the
-        initial fetch cycle).
+        Looks the opcode up in the per-instance dispatch table built by
+        _build_dispatch_table(). Each handler returns the additional cycles
+        consumed (beyond the initial fetch cycle).
 
         Args:
             opcode: The instruction opcode byte
@@ -752,1001 +1012,1708 @@ class HD6303:
         Returns:
             Additional cycles consumed (not including fetch)
         """
-        match opcode:
-            # ============================================
-            # Control Instructions (0x00-0x0F)
-            # ============================================
-            case 0x00:  # TRAP
-                return self._do_interrupt(0xFFEE)
-            case 0x01:  # NOP
-                return 0
-            case 0x04:  # LSRD
-                self.d = self._lsr8(self.d)  # Note: JAPE uses lsr which handles 16-bit
-                return 0
-            case 0x05:  # ASLD
-                self.d = self._asl16(self.d)
-                return 0
-            case 0x06:  # TAP
-                self._set_p(self.a)
-                return 0
-            case 0x07:  # TPA
-                self.a = self._get_p()
-                return 0
-            case 0x08:  # INX
-                self.x = (self.x + 1) & 0xFFFF
-                self.flag_z = self.x == 0
-                return 0
-            case 0x09:  # DEX
-                self.x = (self.x - 1) & 0xFFFF
-                self.flag_z = self.x == 0
-                return 0
-            case 0x0A:  # CLV
-                self.flag_v = False
-                return 0
-            case 0x0B:  # SEV
-                self.flag_v = True
-                return 0
-            case 0x0C:  # CLC
-                self.flag_c = False
-                return 0
-            case 0x0D:  # SEC
-                self.flag_c = True
-                return 0
-            case 0x0E:  # CLI
-                self.flag_i = False
-                return 0
-            case 0x0F:  # SEI
-                self.flag_i = True
-                return 0
-
-            # ============================================
-            # Register Transfer (0x10-0x1B)
-            # ============================================
-            case 0x10:  # SBA
-                self.a = self._sub8(self.a, self.b)
-                return 0
-            case 0x11:  # CBA
-                self._sub8(self.a, self.b)
-                return 0
-            case 0x16:  # TAB
-                self.b = self._ld8(self.a)
-                return 0
-            case 0x17:  # TBA
-                self.a = self._ld8(self.b)
-                return 0
-            case 0x18:  # XGDX (HD6303 specific)
-                tmp = self.x
-                self.x = self.d
-                self.d = tmp
-                return 1
-            case 0x19:  # DAA
-                self._daa()
-                return 1
-            case 0x1A:  # SLP (HD6303 specific)
-                self.state.sleep = True
-                return 3
-            case 0x1B:  # ABA
-                self.a = self._add8(self.a, self.b)
-                return 0
-
-            # ============================================
-            # Branch Instructions (0x20-0x2F)
-            # ============================================
-            case 0x20:  # BRA
-                d = self._fetch_byte()
-                if d >= 0x80:
-                    d -= 0x100
-                self.pc = (self.pc + d) & 0xFFFF
-                return 2
-            case 0x21:  # BRN
-                self._fetch_byte()  # Consume offset but don't branch
-                return 2
-            case 0x22:  # BHI (C=0 and Z=0)
-                d = self._fetch_byte()
-                if not self.flag_c and not self.flag_z:
-                    if d >= 0x80:
-                        d -= 0x100
-                    self.pc = (self.pc + d) & 0xFFFF
-                return 2
-            case 0x23:  # BLS (C=1 or Z=1)
-                d = self._fetch_byte()
-                if self.flag_c or self.flag_z:
-                    if d >= 0x80:
-                        d -= 0x100
-                    self.pc = (self.pc + d) & 0xFFFF
-                return 2
-            case 0x24:  # BCC/BHS (C=0)
-                d = self._fetch_byte()
-                if not self.flag_c:
-                    if d >= 0x80:
-                        d -= 0x100
-                    self.pc = (self.pc + d) & 0xFFFF
-                return 2
-            case 0x25:  # BCS/BLO (C=1)
-                d = self._fetch_byte()
-                if self.flag_c:
-                    if d >= 0x80:
-                        d -= 0x100
-                    self.pc = (self.pc + d) & 0xFFFF
-                return 2
-            case 0x26:  # BNE (Z=0)
-                d = self._fetch_byte()
-                if not self.flag_z:
-                    if d >= 0x80:
-                        d -= 0x100
-                    self.pc = (self.pc + d) & 0xFFFF
-                return 2
-            case 0x27:  # BEQ (Z=1)
-                d = self._fetch_byte()
-                if self.flag_z:
-                    if d >= 0x80:
-                        d -= 0x100
-                    self.pc = (self.pc + d) & 0xFFFF
-                return 2
-            case 0x28:  # BVC (V=0)
-                d = self._fetch_byte()
-                if not self.flag_v:
-                    if d >= 0x80:
-                        d -= 0x100
-                    self.pc = (self.pc + d) & 0xFFFF
-                return 2
-            case 0x29:  # BVS (V=1)
-                d = self._fetch_byte()
-                if self.flag_v:
-                    if d >= 0x80:
-                        d -= 0x100
-                    self.pc = (self.pc + d) & 0xFFFF
-                return 2
-            case 0x2A:  # BPL (N=0)
-                d = self._fetch_byte()
-                if not self.flag_n:
-                    if d >= 0x80:
-                        d -= 0x100
-                    self.pc = (self.pc + d) & 0xFFFF
-                return 2
-            case 0x2B:  # BMI (N=1)
-                d = self._fetch_byte()
-                if self.flag_n:
-                    if d >= 0x80:
-                        d -= 0x100
-                    self.pc = (self.pc + d) & 0xFFFF
-                return 2
-            case 0x2C:  # BGE (N=V)
-                d = self._fetch_byte()
-                if self.flag_n == self.flag_v:
-                    if d >= 0x80:
-                        d -= 0x100
-                    self.pc = (self.pc + d) & 0xFFFF
-                return 2
-            case 0x2D:  # BLT (N!=V)
-                d = self._fetch_byte()
-                if self.flag_n != self.flag_v:
-                    if d >= 0x80:
-                        d -= 0x100
-                    self.pc = (self.pc + d) & 0xFFFF
-                return 2
-            case 0x2E:  # BGT (N=V and Z=0)
-                d = self._fetch_byte()
-                if self.flag_n == self.flag_v and not self.flag_z:
-                    if d >= 0x80:
-                        d -= 0x100
-                    self.pc = (self.pc + d) & 0xFFFF
-                return 2
-            case 0x2F:  # BLE (N!=V or Z=1)
-                d = self._fetch_byte()
-                if self.flag_n != self.flag_v or self.flag_z:
-                    if d >= 0x80:
-                        d -= 0x100
-                    self.pc = (self.pc + d) & 0xFFFF
-                return 2
-
-            # ============================================
-            # Stack/Transfer (0x30-0x3F)
-            # ============================================
-            case 0x30:  # TSX (HD6303: X = SP directly)
-                self.x = self.sp
-                return 0
-            case 0x31:  # INS
-                self.sp = (self.sp + 1) & 0xFFFF
-                return 0
-            case 0x32:  # PULA
-                self.a = self._pop_byte()
-                return 2
-            case 0x33:  # PULB
-                self.b = self._pop_byte()
-                return 2
-            case 0x34:  # DES
-                self.sp = (self.sp - 1) & 0xFFFF
-                return 0
-            case 0x35:  # TXS
-                self.sp = self.x
-                return 0
-            case 0x36:  # PSHA
-                self._push_byte(self.a)
-                return 3
-            case 0x37:  # PSHB
-                self._push_byte(self.b)
-                return 3
-            case 0x38:  # PULX
-                self.x = self._pop_word()
-                return 3
-            case 0x39:  # RTS
-                self.pc = self._pop_word()
-                return 4
-            case 0x3A:  # ABX
-                self.x = (self.x + self.b) & 0xFFFF
-                return 0
-            case 0x3B:  # RTI
-                self._set_p(self._pop_byte())
-                self.b = self._pop_byte()
-                self.a = self._pop_byte()
-                self.x = self._pop_word()
-                self.pc = self._pop_word()
-                return 9
-            case 0x3C:  # PSHX
-                self._push_word(self.x)
-                return 4
-            case 0x3D:  # MUL
-                self.d = self.a * self.b
-                self.flag_c = (self.b & 0x80) != 0
-                return 6
-            case 0x3E:  # WAI
-                return 8
-            case 0x3F:  # SWI
-                return self._do_interrupt(0xFFFA)
-
-            # ============================================
-            # Accumulator A Operations (0x40-0x4F)
-            # ============================================
-            case 0x40:  # NEGA
-                self.a = self._neg8(self.a)
-                return 0
-            case 0x43:  # COMA
-                self.a = self._com8(self.a)
-                return 0
-            case 0x44:  # LSRA
-                self.a = self._lsr8(self.a)
-                return 0
-            case 0x46:  # RORA
-                self.a = self._ror8(self.a)
-                return 0
-            case 0x47:  # ASRA
-                self.a = self._asr8(self.a)
-                return 0
-            case 0x48:  # ASLA
-                self.a = self._asl8(self.a)
-                return 0
-            case 0x49:  # ROLA
-                self.a = self._rol8(self.a)
-                return 0
-            case 0x4A:  # DECA
-                self.a = self._dec8(self.a)
-                return 0
-            case 0x4C:  # INCA
-                self.a = self._inc8(self.a)
-                return 0
-            case 0x4D:  # TSTA
-                self._tst8(self.a)
-                return 0
-            case 0x4F:  # CLRA
-                self.a = self._clr8()
-                return 0
-
-            # ============================================
-            # Accumulator B Operations (0x50-0x5F)
-            # ============================================
-            case 0x50:  # NEGB
-                self.b = self._neg8(self.b)
-                return 0
-            case 0x53:  # COMB
-                self.b = self._com8(self.b)
-                return 0
-            case 0x54:  # LSRB
-                self.b = self._lsr8(self.b)
-                return 0
-            case 0x56:  # RORB
-                self.b = self._ror8(self.b)
-                return 0
-            case 0x57:  # ASRB
-                self.b = self._asr8(self.b)
-                return 0
-            case 0x58:  # ASLB
-                self.b = self._asl8(self.b)
-                return 0
-            case 0x59:  # ROLB
-                self.b = self._rol8(self.b)
-                return 0
-            case 0x5A:  # DECB
-                self.b = self._dec8(self.b)
-                return 0
-            case 0x5C:  # INCB
-                self.b = self._inc8(self.b)
-                return 0
-            case 0x5D:  # TSTB
-                self._tst8(self.b)
-                return 0
-            case 0x5F:  # CLRB
-                self.b = self._clr8()
-                return 0
-
-            # ============================================
-            # Indexed Operations (0x60-0x6F)
-            # ============================================
-            case 0x60:  # NEG d,X
-                m = (self.x + self._fetch_byte()) & 0xFFFF
-                self._write_byte(m, self._neg8(self._read_byte(m)))
-                return 5
-            case 0x61:  # AIM #,d,X (HD6303)
-                imm = self._fetch_byte()
-                m = (self.x + self._fetch_byte()) & 0xFFFF
-                self._write_byte(m, self._and8(imm, self._read_byte(m)))
-                return 6
-            case 0x62:  # OIM #,d,X (HD6303)
-                imm = self._fetch_byte()
-                m = (self.x + self._fetch_byte()) & 0xFFFF
-                self._write_byte(m, self._or8(imm, self._read_byte(m)))
-                return 6
-            case 0x63:  # COM d,X
-                m = (self.x + self._fetch_byte()) & 0xFFFF
-                self._write_byte(m, self._com8(self._read_byte(m)))
-                return 5
-            case 0x64:  # LSR d,X
-                m = (self.x + self._fetch_byte()) & 0xFFFF
-                self._write_byte(m, self._lsr8(self._read_byte(m)))
-                return 5
-            case 0x65:  # EIM #,d,X (HD6303)
-                imm = self._fetch_byte()
-                m = (self.x + self._fetch_byte()) & 0xFFFF
-                self._write_byte(m, self._eor8(imm, self._read_byte(m)))
-                return 6
-            case 0x66:  # ROR d,X
-                m = (self.x + self._fetch_byte()) & 0xFFFF
-                self._write_byte(m, self._ror8(self._read_byte(m)))
-                return 5
-            case 0x67:  # ASR d,X
-                m = (self.x + self._fetch_byte()) & 0xFFFF
-                self._write_byte(m, self._asr8(self._read_byte(m)))
-                return 5
-            case 0x68:  # ASL d,X
-                m = (self.x + self._fetch_byte()) & 0xFFFF
-                self._write_byte(m, self._asl8(self._read_byte(m)))
-                return 5
-            case 0x69:  # ROL d,X
-                m = (self.x + self._fetch_byte()) & 0xFFFF
-                self._write_byte(m, self._rol8(self._read_byte(m)))
-                return 5
-            case 0x6A:  # DEC d,X
-                m = (self.x + self._fetch_byte()) & 0xFFFF
-                self._write_byte(m, self._dec8(self._read_byte(m)))
-                return 5
-            case 0x6B:  # TIM #,d,X (HD6303)
-                imm = self._fetch_byte()
-                m = (self.x + self._fetch_byte()) & 0xFFFF
-                self._and8(imm, self._read_byte(m))
-                return 4
-            case 0x6C:  # INC d,X
-                m = (self.x + self._fetch_byte()) & 0xFFFF
-                self._write_byte(m, self._inc8(self._read_byte(m)))
-                return 5
-            case 0x6D:  # TST d,X
-                m = (self.x + self._fetch_byte()) & 0xFFFF
-                self._tst8(self._read_byte(m))
-                return 3
-            case 0x6E:  # JMP d,X
-                m = (self.x + self._fetch_byte()) & 0xFFFF
-                self.pc = m
-                return 2
-            case 0x6F:  # CLR d,X
-                m = (self.x + self._fetch_byte()) & 0xFFFF
-                self._write_byte(m, self._clr8())
-                return 4
-
-            # ============================================
-            # Extended Operations (0x70-0x7F)
-            # ============================================
-            case 0x70:  # NEG mm
-                m = self._fetch_word()
-                self._write_byte(m, self._neg8(self._read_byte(m)))
-                return 5
-            case 0x71:  # AIM #,0m (HD6303 - direct page)
-                imm = self._fetch_byte()
-                m = self._fetch_byte()
-                self._write_byte(m, self._and8(imm, self._read_byte(m)))
-                return 5
-            case 0x72:  # OIM #,0m (HD6303 - direct page)
-                imm = self._fetch_byte()
-                m = self._fetch_byte()
-                self._write_byte(m, self._or8(imm, self._read_byte(m)))
-                return 5
-            case 0x73:  # COM mm
-                m = self._fetch_word()
-                self._write_byte(m, self._com8(self._read_byte(m)))
-                return 5
-            case 0x74:  # LSR mm
-                m = self._fetch_word()
-                self._write_byte(m, self._lsr8(self._read_byte(m)))
-                return 5
-            case 0x75:  # EIM #,0m (HD6303 - direct page)
-                imm = self._fetch_byte()
-                m = self._fetch_byte()
-                self._write_byte(m, self._eor8(imm, self._read_byte(m)))
-                return 5
-            case 0x76:  # ROR mm
-                m = self._fetch_word()
-                self._write_byte(m, self._ror8(self._read_byte(m)))
-                return 5
-            case 0x77:  # ASR mm
-                m = self._fetch_word()
-                self._write_byte(m, self._asr8(self._read_byte(m)))
-                return 5
-            case 0x78:  # ASL mm
-                m = self._fetch_word()
-                self._write_byte(m, self._asl8(self._read_byte(m)))
-                return 5
-            case 0x79:  # ROL mm
-                m = self._fetch_word()
-                self._write_byte(m, self._rol8(self._read_byte(m)))
-                return 5
-            case 0x7A:  # DEC mm
-                m = self._fetch_word()
-                self._write_byte(m, self._dec8(self._read_byte(m)))
-                return 5
-            case 0x7B:  # TIM #,0m (HD6303 - direct page)
-                imm = self._fetch_byte()
-                m = self._fetch_byte()
-                self._and8(imm, self._read_byte(m))
-                return 3
-            case 0x7C:  # INC mm
-                m = self._fetch_word()
-                self._write_byte(m, self._inc8(self._read_byte(m)))
-                return 5
-            case 0x7D:  # TST mm
-                m = self._fetch_word()
-                self._tst8(self._read_byte(m))
-                return 3
-            case 0x7E:  # JMP mm
-                m = self._fetch_word()
-                self.pc = m
-                return 2
-            case 0x7F:  # CLR mm
-                m = self._fetch_word()
-                self._write_byte(m, self._clr8())
-                return 4
-
-            # ============================================
-            # Accumulator A with Immediate (0x80-0x8F)
-            # ============================================
-            case 0x80:  # SUBA #
-                m = self._fetch_byte()
-                self.a = self._sub8(self.a, m)
-                return 1
-            case 0x81:  # CMPA #
-                m = self._fetch_byte()
-                self._sub8(self.a, m)
-                return 1
-            case 0x82:  # SBCA #
-                m = self._fetch_byte()
-                self.a = self._sbc8(self.a, m)
-                return 1
-            case 0x83:  # SUBD ##
-                m = self._fetch_word()
-                self.d = self._sub16(self.d, m)
-                return 2
-            case 0x84:  # ANDA #
-                m = self._fetch_byte()
-                self.a = self._and8(self.a, m)
-                return 1
-            case 0x85:  # BITA #
-                m = self._fetch_byte()
-                self._and8(self.a, m)
-                return 1
-            case 0x86:  # LDAA #
-                m = self._fetch_byte()
-                self.a = self._ld8(m)
-                return 1
-            case 0x88:  # EORA #
-                m = self._fetch_byte()
-                self.a = self._eor8(self.a, m)
-                return 1
-            case 0x89:  # ADCA #
-                m = self._fetch_byte()
-                self.a = self._adc8(self.a, m)
-                return 1
-            case 0x8A:  # ORAA #
-                m = self._fetch_byte()
-                self.a = self._or8(self.a, m)
-                return 1
-            case 0x8B:  # ADDA #
-                m = self._fetch_byte()
-                self.a = self._add8(self.a, m)
-                return 1
-            case 0x8C:  # CPX ##
-                m = self._fetch_word()
-                self._sub16(self.x, m)
-                return 2
-            case 0x8D:  # BSR d
-                d = self._fetch_byte()
-                self._push_word(self.pc)
-                if d >= 0x80:
-                    d -= 0x100
-                self.pc = (self.pc + d) & 0xFFFF
-                return 4
-            case 0x8E:  # LDS ##
-                m = self._fetch_word()
-                self.sp = self._ld16(m)
-                return 2
-
-            # ============================================
-            # Accumulator A with Direct Page (0x90-0x9F)
-            # ============================================
-            case 0x90:  # SUBA 0m
-                m = self._read_byte(self._fetch_byte())
-                self.a = self._sub8(self.a, m)
-                return 2
-            case 0x91:  # CMPA 0m
-                m = self._read_byte(self._fetch_byte())
-                self._sub8(self.a, m)
-                return 2
-            case 0x92:  # SBCA 0m
-                m = self._read_byte(self._fetch_byte())
-                self.a = self._sbc8(self.a, m)
-                return 2
-            case 0x93:  # SUBD 0m
-                m = self._read_word(self._fetch_byte())
-                self.d = self._sub16(self.d, m)
-                return 3
-            case 0x94:  # ANDA 0m
-                m = self._read_byte(self._fetch_byte())
-                self.a = self._and8(self.a, m)
-                return 2
-            case 0x95:  # BITA 0m
-                m = self._read_byte(self._fetch_byte())
-                self._and8(self.a, m)
-                return 2
-            case 0x96:  # LDAA 0m
-                m = self._read_byte(self._fetch_byte())
-                self.a = self._ld8(m)
-                return 2
-            case 0x97:  # STAA 0m
-                m = self._fetch_byte()
-                self._write_byte(m, self._ld8(self.a))
-                return 2
-            case 0x98:  # EORA 0m
-                m = self._read_byte(self._fetch_byte())
-                self.a = self._eor8(self.a, m)
-                return 2
-            case 0x99:  # ADCA 0m
-                m = self._read_byte(self._fetch_byte())
-                self.a = self._adc8(self.a, m)
-                return 2
-            case 0x9A:  # ORAA 0m
-                m = self._read_byte(self._fetch_byte())
-                self.a = self._or8(self.a, m)
-                return 2
-            case 0x9B:  # ADDA 0m
-                m = self._read_byte(self._fetch_byte())
-                self.a = self._add8(self.a, m)
-                return 2
-            case 0x9C:  # CPX 0m
-                m = self._read_word(self._fetch_byte())
-                self._sub16(self.x, m)
-                return 3
-            case 0x9D:  # JSR 0m
-                m = self._fetch_byte()
-                self._push_word(self.pc)
-                self.pc = m
-                return 4
-            case 0x9E:  # LDS 0m
-                m = self._read_word(self._fetch_byte())
-                self.sp = self._ld16(m)
-                return 3
-            case 0x9F:  # STS 0m
-                m = self._fetch_byte()
-                self._write_word(m, self._ld16(self.sp))
-                return 3
-
-            # ============================================
-            # Accumulator A with Indexed (0xA0-0xAF)
-            # ============================================
-            case 0xA0:  # SUBA d,X
-                m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
-                self.a = self._sub8(self.a, m)
-                return 3
-            case 0xA1:  # CMPA d,X
-                m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
-                self._sub8(self.a, m)
-                return 3
-            case 0xA2:  # SBCA d,X
-                m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
-                self.a = self._sbc8(self.a, m)
-                return 3
-            case 0xA3:  # SUBD d,X
-                m = self._read_word((self.x + self._fetch_byte()) & 0xFFFF)
-                self.d = self._sub16(self.d, m)
-                return 4
-            case 0xA4:  # ANDA d,X
-                m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
-                self.a = self._and8(self.a, m)
-                return 3
-            case 0xA5:  # BITA d,X
-                m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
-                self._and8(self.a, m)
-                return 3
-            case 0xA6:  # LDAA d,X
-                m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
-                self.a = self._ld8(m)
-                return 3
-            case 0xA7:  # STAA d,X
-                m = (self.x + self._fetch_byte()) & 0xFFFF
-                self._write_byte(m, self._ld8(self.a))
-                return 3
-            case 0xA8:  # EORA d,X
-                m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
-                self.a = self._eor8(self.a, m)
-                return 3
-            case 0xA9:  # ADCA d,X
-                m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
-                self.a = self._adc8(self.a, m)
-                return 3
-            case 0xAA:  # ORAA d,X
-                m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
-                self.a = self._or8(self.a, m)
-                return 3
-            case 0xAB:  # ADDA d,X
-                m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
-                self.a = self._add8(self.a, m)
-                return 3
-            case 0xAC:  # CPX d,X
-                m = self._read_word((self.x + self._fetch_byte()) & 0xFFFF)
-                self._sub16(self.x, m)
-                return 4
-            case 0xAD:  # JSR d,X
-                m = (self.x + self._fetch_byte()) & 0xFFFF
-                self._push_word(self.pc)
-                self.pc = m
-                return 4
-            case 0xAE:  # LDS d,X
-                m = self._read_word((self.x + self._fetch_byte()) & 0xFFFF)
-                self.sp = self._ld16(m)
-                return 4
-            case 0xAF:  # STS d,X
-                m = (self.x + self._fetch_byte()) & 0xFFFF
-                self._write_word(m, self._ld16(self.sp))
-                return 4
-
-            # ============================================
-            # Accumulator A with Extended (0xB0-0xBF)
-            # ============================================
-            case 0xB0:  # SUBA mm
-                m = self._read_byte(self._fetch_word())
-                self.a = self._sub8(self.a, m)
-                return 3
-            case 0xB1:  # CMPA mm
-                m = self._read_byte(self._fetch_word())
-                self._sub8(self.a, m)
-                return 3
-            case 0xB2:  # SBCA mm
-                m = self._read_byte(self._fetch_word())
-                self.a = self._sbc8(self.a, m)
-                return 3
-            case 0xB3:  # SUBD mm
-                m = self._read_word(self._fetch_word())
-                self.d = self._sub16(self.d, m)
-                return 4
-            case 0xB4:  # ANDA mm
-                m = self._read_byte(self._fetch_word())
-                self.a = self._and8(self.a, m)
-                return 3
-            case 0xB5:  # BITA mm
-                m = self._read_byte(self._fetch_word())
-                self._and8(self.a, m)
-                return 3
-            case 0xB6:  # LDAA mm
-                m = self._read_byte(self._fetch_word())
-                self.a = self._ld8(m)
-                return 3
-            case 0xB7:  # STAA mm
-                m = self._fetch_word()
-                self._write_byte(m, self._ld8(self.a))
-                return 3
-            case 0xB8:  # EORA mm
-                m = self._read_byte(self._fetch_word())
-                self.a = self._eor8(self.a, m)
-                return 3
-            case 0xB9:  # ADCA mm
-                m = self._read_byte(self._fetch_word())
-                self.a = self._adc8(self.a, m)
-                return 3
-            case 0xBA:  # ORAA mm
-                m = self._read_byte(self._fetch_word())
-                self.a = self._or8(self.a, m)
-                return 3
-            case 0xBB:  # ADDA mm
-                m = self._read_byte(self._fetch_word())
-                self.a = self._add8(self.a, m)
-                return 3
-            case 0xBC:  # CPX mm
-                m = self._read_word(self._fetch_word())
-                self._sub16(self.x, m)
-                return 4
-            case 0xBD:  # JSR mm
-                m = self._fetch_word()
-                self._push_word(self.pc)
-                self.pc = m
-                return 5
-            case 0xBE:  # LDS mm
-                m = self._read_word(self._fetch_word())
-                self.sp = self._ld16(m)
-                return 4
-            case 0xBF:  # STS mm
-                m = self._fetch_word()
-                self._write_word(m, self._ld16(self.sp))
-                return 4
-
-            # ============================================
-            # Accumulator B with Immediate (0xC0-0xCF)
-            # ============================================
-            case 0xC0:  # SUBB #
-                m = self._fetch_byte()
-                self.b = self._sub8(self.b, m)
-                return 1
-            case 0xC1:  # CMPB #
-                m = self._fetch_byte()
-                self._sub8(self.b, m)
-                return 1
-            case 0xC2:  # SBCB #
-                m = self._fetch_byte()
-                self.b = self._sbc8(self.b, m)
-                return 1
-            case 0xC3:  # ADDD ##
-                m = self._fetch_word()
-                self.d = self._add16(self.d, m)
-                return 2
-            case 0xC4:  # ANDB #
-                m = self._fetch_byte()
-                self.b = self._and8(self.b, m)
-                return 1
-            case 0xC5:  # BITB #
-                m = self._fetch_byte()
-                self._and8(self.b, m)
-                return 1
-            case 0xC6:  # LDAB #
-                m = self._fetch_byte()
-                self.b = self._ld8(m)
-                return 1
-            case 0xC8:  # EORB #
-                m = self._fetch_byte()
-                self.b = self._eor8(self.b, m)
-                return 1
-            case 0xC9:  # ADCB #
-                m = self._fetch_byte()
-                self.b = self._adc8(self.b, m)
-                return 1
-            case 0xCA:  # ORAB #
-                m = self._fetch_byte()
-                self.b = self._or8(self.b, m)
-                return 1
-            case 0xCB:  # ADDB #
-                m = self._fetch_byte()
-                self.b = self._add8(self.b, m)
-                return 1
-            case 0xCC:  # LDD ##
-                m = self._fetch_word()
-                self.d = self._ld16(m)
-                return 2
-            case 0xCE:  # LDX ##
-                m = self._fetch_word()
-                self.x = self._ld16(m)
-                return 2
-
-            # ============================================
-            # Accumulator B with Direct Page (0xD0-0xDF)
-            # ============================================
-            case 0xD0:  # SUBB 0m
-                m = self._read_byte(self._fetch_byte())
-                self.b = self._sub8(self.b, m)
-                return 2
-            case 0xD1:  # CMPB 0m
-                m = self._read_byte(self._fetch_byte())
-                self._sub8(self.b, m)
-                return 2
-            case 0xD2:  # SBCB 0m
-                m = self._read_byte(self._fetch_byte())
-                self.b = self._sbc8(self.b, m)
-                return 2
-            case 0xD3:  # ADDD 0m
-                m = self._read_word(self._fetch_byte())
-                self.d = self._add16(self.d, m)
-                return 3
-            case 0xD4:  # ANDB 0m
-                m = self._read_byte(self._fetch_byte())
-                self.b = self._and8(self.b, m)
-                return 2
-            case 0xD5:  # BITB 0m
-                m = self._read_byte(self._fetch_byte())
-                self._and8(self.b, m)
-                return 2
-            case 0xD6:  # LDAB 0m
-                m = self._read_byte(self._fetch_byte())
-                self.b = self._ld8(m)
-                return 2
-            case 0xD7:  # STAB 0m
-                m = self._fetch_byte()
-                self._write_byte(m, self._ld8(self.b))
-                return 2
-            case 0xD8:  # EORB 0m
-                m = self._read_byte(self._fetch_byte())
-                self.b = self._eor8(self.b, m)
-                return 2
-            case 0xD9:  # ADCB 0m
-                m = self._read_byte(self._fetch_byte())
-                self.b = self._adc8(self.b, m)
-                return 2
-            case 0xDA:  # ORAB 0m
-                m = self._read_byte(self._fetch_byte())
-                self.b = self._or8(self.b, m)
-                return 2
-            case 0xDB:  # ADDB 0m
-                m = self._read_byte(self._fetch_byte())
-                self.b = self._add8(self.b, m)
-                return 2
-            case 0xDC:  # LDD 0m
-                m = self._read_word(self._fetch_byte())
-                self.d = self._ld16(m)
-                return 3
-            case 0xDD:  # STD 0m
-                m = self._fetch_byte()
-                self._write_word(m, self._ld16(self.d))
-                return 3
-            case 0xDE:  # LDX 0m
-                m = self._read_word(self._fetch_byte())
-                self.x = self._ld16(m)
-                return 3
-            case 0xDF:  # STX 0m
-                m = self._fetch_byte()
-                self._write_word(m, self._ld16(self.x))
-                return 3
-
-            # ============================================
-            # Accumulator B with Indexed (0xE0-0xEF)
-            # ============================================
-            case 0xE0:  # SUBB d,X
-                m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
-                self.b = self._sub8(self.b, m)
-                return 3
-            case 0xE1:  # CMPB d,X
-                m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
-                self._sub8(self.b, m)
-                return 3
-            case 0xE2:  # SBCB d,X
-                m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
-                self.b = self._sbc8(self.b, m)
-                return 3
-            case 0xE3:  # ADDD d,X
-                m = self._read_word((self.x + self._fetch_byte()) & 0xFFFF)
-                self.d = self._add16(self.d, m)
-                return 4
-            case 0xE4:  # ANDB d,X
-                m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
-                self.b = self._and8(self.b, m)
-                return 3
-            case 0xE5:  # BITB d,X
-                m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
-                self._and8(self.b, m)
-                return 3
-            case 0xE6:  # LDAB d,X
-                m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
-                self.b = self._ld8(m)
-                return 3
-            case 0xE7:  # STAB d,X
-                m = (self.x + self._fetch_byte()) & 0xFFFF
-                self._write_byte(m, self._ld8(self.b))
-                return 3
-            case 0xE8:  # EORB d,X
-                m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
-                self.b = self._eor8(self.b, m)
-                return 3
-            case 0xE9:  # ADCB d,X
-                m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
-                self.b = self._adc8(self.b, m)
-                return 3
-            case 0xEA:  # ORAB d,X
-                m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
-                self.b = self._or8(self.b, m)
-                return 3
-            case 0xEB:  # ADDB d,X
-                m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
-                self.b = self._add8(self.b, m)
-                return 3
-            case 0xEC:  # LDD d,X
-                m = self._read_word((self.x + self._fetch_byte()) & 0xFFFF)
-                self.d = self._ld16(m)
-                return 4
-            case 0xED:  # STD d,X
-                m = (self.x + self._fetch_byte()) & 0xFFFF
-                self._write_word(m, self._ld16(self.d))
-                return 4
-            case 0xEE:  # LDX d,X
-                m = self._read_word((self.x + self._fetch_byte()) & 0xFFFF)
-                self.x = self._ld16(m)
-                return 4
-            case 0xEF:  # STX d,X
-                m = (self.x + self._fetch_byte()) & 0xFFFF
-                self._write_word(m, self._ld16(self.x))
-                return 4
-
-            # ============================================
-            # Accumulator B with Extended (0xF0-0xFF)
-            # ============================================
-            case 0xF0:  # SUBB mm
-                m = self._read_byte(self._fetch_word())
-                self.b = self._sub8(self.b, m)
-                return 3
-            case 0xF1:  # CMPB mm
-                m = self._read_byte(self._fetch_word())
-                self._sub8(self.b, m)
-                return 3
-            case 0xF2:  # SBCB mm
-                m = self._read_byte(self._fetch_word())
-                self.b = self._sbc8(self.b, m)
-                return 3
-            case 0xF3:  # ADDD mm
-                m = self._read_word(self._fetch_word())
-                self.d = self._add16(self.d, m)
-                return 4
-            case 0xF4:  # ANDB mm
-                m = self._read_byte(self._fetch_word())
-                self.b = self._and8(self.b, m)
-                return 3
-            case 0xF5:  # BITB mm
-                m = self._read_byte(self._fetch_word())
-                self._and8(self.b, m)
-                return 3
-            case 0xF6:  # LDAB mm
-                m = self._read_byte(self._fetch_word())
-                self.b = self._ld8(m)
-                return 3
-            case 0xF7:  # STAB mm
-                m = self._fetch_word()
-                self._write_byte(m, self._ld8(self.b))
-                return 3
-            case 0xF8:  # EORB mm
-                m = self._read_byte(self._fetch_word())
-                self.b = self._eor8(self.b, m)
-                return 3
-            case 0xF9:  # ADCB mm
-                m = self._read_byte(self._fetch_word())
-                self.b = self._adc8(self.b, m)
-                return 3
-            case 0xFA:  # ORAB mm
-                m = self._read_byte(self._fetch_word())
-                self.b = self._or8(self.b, m)
-                return 3
-            case 0xFB:  # ADDB mm
-                m = self._read_byte(self._fetch_word())
-                self.b = self._add8(self.b, m)
-                return 3
-            case 0xFC:  # LDD mm
-                m = self._read_word(self._fetch_word())
-                self.d = self._ld16(m)
-                return 4
-            case 0xFD:  # STD mm
-                m = self._fetch_word()
-                self._write_word(m, self._ld16(self.d))
-                return 4
-            case 0xFE:  # LDX mm
-                m = self._read_word(self._fetch_word())
-                self.x = self._ld16(m)
-                return 4
-            case 0xFF:  # STX mm
-                m = self._fetch_word()
-                self._write_word(m, self._ld16(self.x))
-                return 4
-
-            case _:
-                # Invalid/undefined opcodes - switch off (matches JAPE)
-                self.bus.write(0x01C0, 0)  # switchOff address
-                return 0
+        return self._dispatch[opcode]()
+
+    def _build_dispatch_table(self) -> list[Callable[[], int]]:
+        """
+        Build the 256-entry opcode dispatch table.
+
+        Every entry is a bound method, so dispatch costs a single list index
+        instead of walking a match statement. Each handler performs its own
+        addressing-mode fetch inline. Undefined opcodes map to _op_illegal.
+        """
+        table: list[Callable[[], int]] = [self._op_illegal] * 256
+        for opcode, name in _OPCODE_HANDLERS.items():
+            table[opcode] = getattr(self, name)
+        return table
+
+    def _op_illegal(self) -> int:
+        """Invalid/undefined opcode - switch off (matches JAPE)."""
+        self.bus.write(0x01C0, 0)  # switchOff address
+        return 0
+
+    # ============================================
+    # Control Instructions (0x00-0x0F)
+    # ============================================
+
+    @_opcode(0x00)
+    def _op_trap(self) -> int:
+        """TRAP"""
+        return self._do_interrupt(0xFFEE)
+
+    @_opcode(0x01)
+    def _op_nop(self) -> int:
+        """NOP"""
+        return 0
+
+    @_opcode(0x04)
+    def _op_lsrd(self) -> int:
+        """LSRD"""
+        self.d = self._lsr8(self.d)  # Note: JAPE uses lsr which handles 16-bit
+        return 0
+
+    @_opcode(0x05)
+    def _op_asld(self) -> int:
+        """ASLD"""
+        self.d = self._asl16(self.d)
+        return 0
+
+    @_opcode(0x06)
+    def _op_tap(self) -> int:
+        """TAP"""
+        self._set_p(self.a)
+        return 0
+
+    @_opcode(0x07)
+    def _op_tpa(self) -> int:
+        """TPA"""
+        self.a = self._get_p()
+        return 0
+
+    @_opcode(0x08)
+    def _op_inx(self) -> int:
+        """INX"""
+        self.x = (self.x + 1) & 0xFFFF
+        self.flag_z = self.x == 0
+        return 0
+
+    @_opcode(0x09)
+    def _op_dex(self) -> int:
+        """DEX"""
+        self.x = (self.x - 1) & 0xFFFF
+        self.flag_z = self.x == 0
+        return 0
+
+    @_opcode(0x0A)
+    def _op_clv(self) -> int:
+        """CLV"""
+        self.flag_v = False
+        return 0
+
+    @_opcode(0x0B)
+    def _op_sev(self) -> int:
+        """SEV"""
+        self.flag_v = True
+        return 0
+
+    @_opcode(0x0C)
+    def _op_clc(self) -> int:
+        """CLC"""
+        self.flag_c = False
+        return 0
+
+    @_opcode(0x0D)
+    def _op_sec(self) -> int:
+        """SEC"""
+        self.flag_c = True
+        return 0
+
+    @_opcode(0x0E)
+    def _op_cli(self) -> int:
+        """CLI"""
+        self.flag_i = False
+        return 0
+
+    @_opcode(0x0F)
+    def _op_sei(self) -> int:
+        """SEI"""
+        self.flag_i = True
+        return 0
+
+    # ============================================
+    # Register Transfer (0x10-0x1B)
+    # ============================================
+
+    @_opcode(0x10)
+    def _op_sba(self) -> int:
+        """SBA"""
+        self.a = self._sub8(self.a, self.b)
+        return 0
+
+    @_opcode(0x11)
+    def _op_cba(self) -> int:
+        """CBA"""
+        self._sub8(self.a, self.b)
+        return 0
+
+    @_opcode(0x16)
+    def _op_tab(self) -> int:
+        """TAB"""
+        self.b = self._ld8(self.a)
+        return 0
+
+    @_opcode(0x17)
+    def _op_tba(self) -> int:
+        """TBA"""
+        self.a = self._ld8(self.b)
+        return 0
+
+    @_opcode(0x18)
+    def _op_xgdx(self) -> int:
+        """XGDX (HD6303 specific)"""
+        tmp = self.x
+        self.x = self.d
+        self.d = tmp
+        return 1
+
+    @_opcode(0x19)
+    def _op_daa(self) -> int:
+        """DAA"""
+        self._daa()
+        return 1
+
+    @_opcode(0x1A)
+    def _op_slp(self) -> int:
+        """SLP (HD6303 specific)"""
+        self.state.sleep = True
+        return 3
+
+    @_opcode(0x1B)
+    def _op_aba(self) -> int:
+        """ABA"""
+        self.a = self._add8(self.a, self.b)
+        return 0
+
+    # ============================================
+    # Branch Instructions (0x20-0x2F)
+    # ============================================
+
+    @_opcode(0x20)
+    def _op_bra(self) -> int:
+        """BRA"""
+        d = self._fetch_byte()
+        if d >= 0x80:
+            d -= 0x100
+        self.pc = (self.pc + d) & 0xFFFF
+        return 2
+
+    @_opcode(0x21)
+    def _op_brn(self) -> int:
+        """BRN"""
+        self._fetch_byte()  # Consume offset but don't branch
+        return 2
+
+    @_opcode(0x22)
+    def _op_bhi(self) -> int:
+        """BHI (C=0 and Z=0)"""
+        d = self._fetch_byte()
+        if not self.flag_c and not self.flag_z:
+            if d >= 0x80:
+                d -= 0x100
+            self.pc = (self.pc + d) & 0xFFFF
+        return 2
+
+    @_opcode(0x23)
+    def _op_bls(self) -> int:
+        """BLS (C=1 or Z=1)"""
+        d = self._fetch_byte()
+        if self.flag_c or self.flag_z:
+            if d >= 0x80:
+                d -= 0x100
+            self.pc = (self.pc + d) & 0xFFFF
+        return 2
+
+    @_opcode(0x24)
+    def _op_bcc(self) -> int:
+        """BCC/BHS (C=0)"""
+        d = self._fetch_byte()
+        if not self.flag_c:
+            if d >= 0x80:
+                d -= 0x100
+            self.pc = (self.pc + d) & 0xFFFF
+        return 2
+
+    @_opcode(0x25)
+    def _op_bcs(self) -> int:
+        """BCS/BLO (C=1)"""
+        d = self._fetch_byte()
+        if self.flag_c:
+            if d >= 0x80:
+                d -= 0x100
+            self.pc = (self.pc + d) & 0xFFFF
+        return 2
+
+    @_opcode(0x26)
+    def _op_bne(self) -> int:
+        """BNE (Z=0)"""
+        d = self._fetch_byte()
+        if not self.flag_z:
+            if d >= 0x80:
+                d -= 0x100
+            self.pc = (self.pc + d) & 0xFFFF
+        return 2
+
+    @_opcode(0x27)
+    def _op_beq(self) -> int:
+        """BEQ (Z=1)"""
+        d = self._fetch_byte()
+        if self.flag_z:
+            if d >= 0x80:
+                d -= 0x100
+            self.pc = (self.pc + d) & 0xFFFF
+        return 2
+
+    @_opcode(0x28)
+    def _op_bvc(self) -> int:
+        """BVC (V=0)"""
+        d = self._fetch_byte()
+        if not self.flag_v:
+            if d >= 0x80:
+                d -= 0x100
+            self.pc = (self.pc + d) & 0xFFFF
+        return 2
+
+    @_opcode(0x29)
+    def _op_bvs(self) -> int:
+        """BVS (V=1)"""
+        d = self._fetch_byte()
+        if self.flag_v:
+            if d >= 0x80:
+                d -= 0x100
+            self.pc = (self.pc + d) & 0xFFFF
+        return 2
+
+    @_opcode(0x2A)
+    def _op_bpl(self) -> int:
+        """BPL (N=0)"""
+        d = self._fetch_byte()
+        if not self.flag_n:
+            if d >= 0x80:
+                d -= 0x100
+            self.pc = (self.pc + d) & 0xFFFF
+        return 2
+
+    @_opcode(0x2B)
+    def _op_bmi(self) -> int:
+        """BMI (N=1)"""
+        d = self._fetch_byte()
+        if self.flag_n:
+            if d >= 0x80:
+                d -= 0x100
+            self.pc = (self.pc + d) & 0xFFFF
+        return 2
+
+    @_opcode(0x2C)
+    def _op_bge(self) -> int:
+        """BGE (N=V)"""
+        d = self._fetch_byte()
+        if self.flag_n == self.flag_v:
+            if d >= 0x80:
+                d -= 0x100
+            self.pc = (self.pc + d) & 0xFFFF
+        return 2
+
+    @_opcode(0x2D)
+    def _op_blt(self) -> int:
+        """BLT (N!=V)"""
+        d = self._fetch_byte()
+        if self.flag_n != self.flag_v:
+            if d >= 0x80:
+                d -= 0x100
+            self.pc = (self.pc + d) & 0xFFFF
+        return 2
+
+    @_opcode(0x2E)
+    def _op_bgt(self) -> int:
+        """BGT (N=V and Z=0)"""
+        d = self._fetch_byte()
+        if self.flag_n == self.flag_v and not self.flag_z:
+            if d >= 0x80:
+                d -= 0x100
+            self.pc = (self.pc + d) & 0xFFFF
+        return 2
+
+    @_opcode(0x2F)
+    def _op_ble(self) -> int:
+        """BLE (N!=V or Z=1)"""
+        d = self._fetch_byte()
+        if self.flag_n != self.flag_v or self.flag_z:
+            if d >= 0x80:
+                d -= 0x100
+            self.pc = (self.pc + d) & 0xFFFF
+        return 2
+
+    # ============================================
+    # Stack/Transfer (0x30-0x3F)
+    # ============================================
+
+    @_opcode(0x30)
+    def _op_tsx(self) -> int:
+        """TSX (HD6303: X = SP directly)"""
+        self.x = self.sp
+        return 0
+
+    @_opcode(0x31)
+    def _op_ins(self) -> int:
+        """INS"""
+        self.sp = (self.sp + 1) & 0xFFFF
+        return 0
+
+    @_opcode(0x32)
+    def _op_pula(self) -> int:
+        """PULA"""
+        self.a = self._pop_byte()
+        return 2
+
+    @_opcode(0x33)
+    def _op_pulb(self) -> int:
+        """PULB"""
+        self.b = self._pop_byte()
+        return 2
+
+    @_opcode(0x34)
+    def _op_des(self) -> int:
+        """DES"""
+        self.sp = (self.sp - 1) & 0xFFFF
+        return 0
+
+    @_opcode(0x35)
+    def _op_txs(self) -> int:
+        """TXS"""
+        self.sp = self.x
+        return 0
+
+    @_opcode(0x36)
+    def _op_psha(self) -> int:
+        """PSHA"""
+        self._push_byte(self.a)
+        return 3
+
+    @_opcode(0x37)
+    def _op_pshb(self) -> int:
+        """PSHB"""
+        self._push_byte(self.b)
+        return 3
+
+    @_opcode(0x38)
+    def _op_pulx(self) -> int:
+        """PULX"""
+        self.x = self._pop_word()
+        return 3
+
+    @_opcode(0x39)
+    def _op_rts(self) -> int:
+        """RTS"""
+        self.pc = self._pop_word()
+        return 4
+
+    @_opcode(0x3A)
+    def _op_abx(self) -> int:
+        """ABX"""
+        self.x = (self.x + self.b) & 0xFFFF
+        return 0
+
+    @_opcode(0x3B)
+    def _op_rti(self) -> int:
+        """RTI"""
+        self._set_p(self._pop_byte())
+        self.b = self._pop_byte()
+        self.a = self._pop_byte()
+        self.x = self._pop_word()
+        self.pc = self._pop_word()
+        return 9
+
+    @_opcode(0x3C)
+    def _op_pshx(self) -> int:
+        """PSHX"""
+        self._push_word(self.x)
+        return 4
+
+    @_opcode(0x3D)
+    def _op_mul(self) -> int:
+        """MUL"""
+        self.d = self.a * self.b
+        self.flag_c = (self.b & 0x80) != 0
+        return 6
+
+    @_opcode(0x3E)
+    def _op_wai(self) -> int:
+        """WAI"""
+        return 8
+
+    @_opcode(0x3F)
+    def _op_swi(self) -> int:
+        """SWI"""
+        return self._do_interrupt(0xFFFA)
+
+    # ============================================
+    # Accumulator A Operations (0x40-0x4F)
+    # ============================================
+
+    @_opcode(0x40)
+    def _op_nega(self) -> int:
+        """NEGA"""
+        self.a = self._neg8(self.a)
+        return 0
+
+    @_opcode(0x43)
+    def _op_coma(self) -> int:
+        """COMA"""
+        self.a = self._com8(self.a)
+        return 0
+
+    @_opcode(0x44)
+    def _op_lsra(self) -> int:
+        """LSRA"""
+        self.a = self._lsr8(self.a)
+        return 0
+
+    @_opcode(0x46)
+    def _op_rora(self) -> int:
+        """RORA"""
+        self.a = self._ror8(self.a)
+        return 0
+
+    @_opcode(0x47)
+    def _op_asra(self) -> int:
+        """ASRA"""
+        self.a = self._asr8(self.a)
+        return 0
+
+    @_opcode(0x48)
+    def _op_asla(self) -> int:
+        """ASLA"""
+        self.a = self._asl8(self.a)
+        return 0
+
+    @_opcode(0x49)
+    def _op_rola(self) -> int:
+        """ROLA"""
+        self.a = self._rol8(self.a)
+        return 0
+
+    @_opcode(0x4A)
+    def _op_deca(self) -> int:
+        """DECA"""
+        self.a = self._dec8(self.a)
+        return 0
+
+    @_opcode(0x4C)
+    def _op_inca(self) -> int:
+        """INCA"""
+        self.a = self._inc8(self.a)
+        return 0
+
+    @_opcode(0x4D)
+    def _op_tsta(self) -> int:
+        """TSTA"""
+        self._tst8(self.a)
+        return 0
+
+    @_opcode(0x4F)
+    def _op_clra(self) -> int:
+        """CLRA"""
+        self.a = self._clr8()
+        return 0
+
+    # ============================================
+    # Accumulator B Operations (0x50-0x5F)
+    # ============================================
+
+    @_opcode(0x50)
+    def _op_negb(self) -> int:
+        """NEGB"""
+        self.b = self._neg8(self.b)
+        return 0
+
+    @_opcode(0x53)
+    def _op_comb(self) -> int:
+        """COMB"""
+        self.b = self._com8(self.b)
+        return 0
+
+    @_opcode(0x54)
+    def _op_lsrb(self) -> int:
+        """LSRB"""
+        self.b = self._lsr8(self.b)
+        return 0
+
+    @_opcode(0x56)
+    def _op_rorb(self) -> int:
+        """RORB"""
+        self.b = self._ror8(self.b)
+        return 0
+
+    @_opcode(0x57)
+    def _op_asrb(self) -> int:
+        """ASRB"""
+        self.b = self._asr8(self.b)
+        return 0
+
+    @_opcode(0x58)
+    def _op_aslb(self) -> int:
+        """ASLB"""
+        self.b = self._asl8(self.b)
+        return 0
+
+    @_opcode(0x59)
+    def _op_rolb(self) -> int:
+        """ROLB"""
+        self.b = self._rol8(self.b)
+        return 0
+
+    @_opcode(0x5A)
+    def _op_decb(self) -> int:
+        """DECB"""
+        self.b = self._dec8(self.b)
+        return 0
+
+    @_opcode(0x5C)
+    def _op_incb(self) -> int:
+        """INCB"""
+        self.b = self._inc8(self.b)
+        return 0
+
+    @_opcode(0x5D)
+    def _op_tstb(self) -> int:
+        """TSTB"""
+        self._tst8(self.b)
+        return 0
+
+    @_opcode(0x5F)
+    def _op_clrb(self) -> int:
+        """CLRB"""
+        self.b = self._clr8()
+        return 0
+
+    # ============================================
+    # Indexed Operations (0x60-0x6F)
+    # ============================================
+
+    @_opcode(0x60)
+    def _op_neg_idx(self) -> int:
+        """NEG d,X"""
+        m = (self.x + self._fetch_byte()) & 0xFFFF
+        self._write_byte(m, self._neg8(self._read_byte(m)))
+        return 5
+
+    @_opcode(0x61)
+    def _op_aim_idx(self) -> int:
+        """AIM #,d,X (HD6303)"""
+        imm = self._fetch_byte()
+        m = (self.x + self._fetch_byte()) & 0xFFFF
+        self._write_byte(m, self._and8(imm, self._read_byte(m)))
+        return 6
+
+    @_opcode(0x62)
+    def _op_oim_idx(self) -> int:
+        """OIM #,d,X (HD6303)"""
+        imm = self._fetch_byte()
+        m = (self.x + self._fetch_byte()) & 0xFFFF
+        self._write_byte(m, self._or8(imm, self._read_byte(m)))
+        return 6
+
+    @_opcode(0x63)
+    def _op_com_idx(self) -> int:
+        """COM d,X"""
+        m = (self.x + self._fetch_byte()) & 0xFFFF
+        self._write_byte(m, self._com8(self._read_byte(m)))
+        return 5
+
+    @_opcode(0x64)
+    def _op_lsr_idx(self) -> int:
+        """LSR d,X"""
+        m = (self.x + self._fetch_byte()) & 0xFFFF
+        self._write_byte(m, self._lsr8(self._read_byte(m)))
+        return 5
+
+    @_opcode(0x65)
+    def _op_eim_idx(self) -> int:
+        """EIM #,d,X (HD6303)"""
+        imm = self._fetch_byte()
+        m = (self.x + self._fetch_byte()) & 0xFFFF
+        self._write_byte(m, self._eor8(imm, self._read_byte(m)))
+        return 6
+
+    @_opcode(0x66)
+    def _op_ror_idx(self) -> int:
+        """ROR d,X"""
+        m = (self.x + self._fetch_byte()) & 0xFFFF
+        self._write_byte(m, self._ror8(self._read_byte(m)))
+        return 5
+
+    @_opcode(0x67)
+    def _op_asr_idx(self) -> int:
+        """ASR d,X"""
+        m = (self.x + self._fetch_byte()) & 0xFFFF
+        self._write_byte(m, self._asr8(self._read_byte(m)))
+        return 5
+
+    @_opcode(0x68)
+    def _op_asl_idx(self) -> int:
+        """ASL d,X"""
+        m = (self.x + self._fetch_byte()) & 0xFFFF
+        self._write_byte(m, self._asl8(self._read_byte(m)))
+        return 5
+
+    @_opcode(0x69)
+    def _op_rol_idx(self) -> int:
+        """ROL d,X"""
+        m = (self.x + self._fetch_byte()) & 0xFFFF
+        self._write_byte(m, self._rol8(self._read_byte(m)))
+        return 5
+
+    @_opcode(0x6A)
+    def _op_dec_idx(self) -> int:
+        """DEC d,X"""
+        m = (self.x + self._fetch_byte()) & 0xFFFF
+        self._write_byte(m, self._dec8(self._read_byte(m)))
+        return 5
+
+    @_opcode(0x6B)
+    def _op_tim_idx(self) -> int:
+        """TIM #,d,X (HD6303)"""
+        imm = self._fetch_byte()
+        m = (self.x + self._fetch_byte()) & 0xFFFF
+        self._and8(imm, self._read_byte(m))
+        return 4
+
+    @_opcode(0x6C)
+    def _op_inc_idx(self) -> int:
+        """INC d,X"""
+        m = (self.x + self._fetch_byte()) & 0xFFFF
+        self._write_byte(m, self._inc8(self._read_byte(m)))
+        return 5
+
+    @_opcode(0x6D)
+    def _op_tst_idx(self) -> int:
+        """TST d,X"""
+        m = (self.x + self._fetch_byte()) & 0xFFFF
+        self._tst8(self._read_byte(m))
+        return 3
+
+    @_opcode(0x6E)
+    def _op_jmp_idx(self) -> int:
+        """JMP d,X"""
+        m = (self.x + self._fetch_byte()) & 0xFFFF
+        self.pc = m
+        return 2
+
+    @_opcode(0x6F)
+    def _op_clr_idx(self) -> int:
+        """CLR d,X"""
+        m = (self.x + self._fetch_byte()) & 0xFFFF
+        self._write_byte(m, self._clr8())
+        return 4
+
+    # ============================================
+    # Extended Operations (0x70-0x7F)
+    # ============================================
+
+    @_opcode(0x70)
+    def _op_neg_ext(self) -> int:
+        """NEG mm"""
+        m = self._fetch_word()
+        self._write_byte(m, self._neg8(self._read_byte(m)))
+        return 5
+
+    @_opcode(0x71)
+    def _op_aim_dir(self) -> int:
+        """AIM #,0m (HD6303 - direct page)"""
+        imm = self._fetch_byte()
+        m = self._fetch_byte()
+        self._write_byte(m, self._and8(imm, self._read_byte(m)))
+        return 5
+
+    @_opcode(0x72)
+    def _op_oim_dir(self) -> int:
+        """OIM #,0m (HD6303 - direct page)"""
+        imm = self._fetch_byte()
+        m = self._fetch_byte()
+        self._write_byte(m, self._or8(imm, self._read_byte(m)))
+        return 5
+
+    @_opcode(0x73)
+    def _op_com_ext(self) -> int:
+        """COM mm"""
+        m = self._fetch_word()
+        self._write_byte(m, self._com8(self._read_byte(m)))
+        return 5
+
+    @_opcode(0x74)
+    def _op_lsr_ext(self) -> int:
+        """LSR mm"""
+        m = self._fetch_word()
+        self._write_byte(m, self._lsr8(self._read_byte(m)))
+        return 5
+
+    @_opcode(0x75)
+    def _op_eim_dir(self) -> int:
+        """EIM #,0m (HD6303 - direct page)"""
+        imm = self._fetch_byte()
+        m = self._fetch_byte()
+        self._write_byte(m, self._eor8(imm, self._read_byte(m)))
+        return 5
+
+    @_opcode(0x76)
+    def _op_ror_ext(self) -> int:
+        """ROR mm"""
+        m = self._fetch_word()
+        self._write_byte(m, self._ror8(self._read_byte(m)))
+        return 5
+
+    @_opcode(0x77)
+    def _op_asr_ext(self) -> int:
+        """ASR mm"""
+        m = self._fetch_word()
+        self._write_byte(m, self._asr8(self._read_byte(m)))
+        return 5
+
+    @_opcode(0x78)
+    def _op_asl_ext(self) -> int:
+        """ASL mm"""
+        m = self._fetch_word()
+        self._write_byte(m, self._asl8(self._read_byte(m)))
+        return 5
+
+    @_opcode(0x79)
+    def _op_rol_ext(self) -> int:
+        """ROL mm"""
+        m = self._fetch_word()
+        self._write_byte(m, self._rol8(self._read_byte(m)))
+        return 5
+
+    @_opcode(0x7A)
+    def _op_dec_ext(self) -> int:
+        """DEC mm"""
+        m = self._fetch_word()
+        self._write_byte(m, self._dec8(self._read_byte(m)))
+        return 5
+
+    @_opcode(0x7B)
+    def _op_tim_dir(self) -> int:
+        """TIM #,0m (HD6303 - direct page)"""
+        imm = self._fetch_byte()
+        m = self._fetch_byte()
+        self._and8(imm, self._read_byte(m))
+        return 3
+
+    @_opcode(0x7C)
+    def _op_inc_ext(self) -> int:
+        """INC mm"""
+        m = self._fetch_word()
+        self._write_byte(m, self._inc8(self._read_byte(m)))
+        return 5
+
+    @_opcode(0x7D)
+    def _op_tst_ext(self) -> int:
+        """TST mm"""
+        m = self._fetch_word()
+        self._tst8(self._read_byte(m))
+        return 3
+
+    @_opcode(0x7E)
+    def _op_jmp_ext(self) -> int:
+        """JMP mm"""
+        m = self._fetch_word()
+        self.pc = m
+        return 2
+
+    @_opcode(0x7F)
+    def _op_clr_ext(self) -> int:
+        """CLR mm"""
+        m = self._fetch_word()
+        self._write_byte(m, self._clr8())
+        return 4
+
+    # ============================================
+    # Accumulator A with Immediate (0x80-0x8F)
+    # ============================================
+
+    @_opcode(0x80)
+    def _op_suba_imm(self) -> int:
+        """SUBA #"""
+        m = self._fetch_byte()
+        self.a = self._sub8(self.a, m)
+        return 1
+
+    @_opcode(0x81)
+    def _op_cmpa_imm(self) -> int:
+        """CMPA #"""
+        m = self._fetch_byte()
+        self._sub8(self.a, m)
+        return 1
+
+    @_opcode(0x82)
+    def _op_sbca_imm(self) -> int:
+        """SBCA #"""
+        m = self._fetch_byte()
+        self.a = self._sbc8(self.a, m)
+        return 1
+
+    @_opcode(0x83)
+    def _op_subd_imm(self) -> int:
+        """SUBD ##"""
+        m = self._fetch_word()
+        self.d = self._sub16(self.d, m)
+        return 2
+
+    @_opcode(0x84)
+    def _op_anda_imm(self) -> int:
+        """ANDA #"""
+        m = self._fetch_byte()
+        self.a = self._and8(self.a, m)
+        return 1
+
+    @_opcode(0x85)
+    def _op_bita_imm(self) -> int:
+        """BITA #"""
+        m = self._fetch_byte()
+        self._and8(self.a, m)
+        return 1
+
+    @_opcode(0x86)
+    def _op_ldaa_imm(self) -> int:
+        """LDAA #"""
+        m = self._fetch_byte()
+        self.a = self._ld8(m)
+        return 1
+
+    @_opcode(0x88)
+    def _op_eora_imm(self) -> int:
+        """EORA #"""
+        m = self._fetch_byte()
+        self.a = self._eor8(self.a, m)
+        return 1
+
+    @_opcode(0x89)
+    def _op_adca_imm(self) -> int:
+        """ADCA #"""
+        m = self._fetch_byte()
+        self.a = self._adc8(self.a, m)
+        return 1
+
+    @_opcode(0x8A)
+    def _op_oraa_imm(self) -> int:
+        """ORAA #"""
+        m = self._fetch_byte()
+        self.a = self._or8(self.a, m)
+        return 1
+
+    @_opcode(0x8B)
+    def _op_adda_imm(self) -> int:
+        """ADDA #"""
+        m = self._fetch_byte()
+        self.a = self._add8(self.a, m)
+        return 1
+
+    @_opcode(0x8C)
+    def _op_cpx_imm(self) -> int:
+        """CPX ##"""
+        m = self._fetch_word()
+        self._sub16(self.x, m)
+        return 2
+
+    @_opcode(0x8D)
+    def _op_bsr(self) -> int:
+        """BSR d"""
+        d = self._fetch_byte()
+        self._push_word(self.pc)
+        if d >= 0x80:
+            d -= 0x100
+        self.pc = (self.pc + d) & 0xFFFF
+        return 4
+
+    @_opcode(0x8E)
+    def _op_lds_imm(self) -> int:
+        """LDS ##"""
+        m = self._fetch_word()
+        self.sp = self._ld16(m)
+        return 2
+
+    # ============================================
+    # Accumulator A with Direct Page (0x90-0x9F)
+    # ============================================
+
+    @_opcode(0x90)
+    def _op_suba_dir(self) -> int:
+        """SUBA 0m"""
+        m = self._read_byte(self._fetch_byte())
+        self.a = self._sub8(self.a, m)
+        return 2
+
+    @_opcode(0x91)
+    def _op_cmpa_dir(self) -> int:
+        """CMPA 0m"""
+        m = self._read_byte(self._fetch_byte())
+        self._sub8(self.a, m)
+        return 2
+
+    @_opcode(0x92)
+    def _op_sbca_dir(self) -> int:
+        """SBCA 0m"""
+        m = self._read_byte(self._fetch_byte())
+        self.a = self._sbc8(self.a, m)
+        return 2
+
+    @_opcode(0x93)
+    def _op_subd_dir(self) -> int:
+        """SUBD 0m"""
+        m = self._read_word(self._fetch_byte())
+        self.d = self._sub16(self.d, m)
+        return 3
+
+    @_opcode(0x94)
+    def _op_anda_dir(self) -> int:
+        """ANDA 0m"""
+        m = self._read_byte(self._fetch_byte())
+        self.a = self._and8(self.a, m)
+        return 2
+
+    @_opcode(0x95)
+    def _op_bita_dir(self) -> int:
+        """BITA 0m"""
+        m = self._read_byte(self._fetch_byte())
+        self._and8(self.a, m)
+        return 2
+
+    @_opcode(0x96)
+    def _op_ldaa_dir(self) -> int:
+        """LDAA 0m"""
+        m = self._read_byte(self._fetch_byte())
+        self.a = self._ld8(m)
+        return 2
+
+    @_opcode(0x97)
+    def _op_staa_dir(self) -> int:
+        """STAA 0m"""
+        m = self._fetch_byte()
+        self._write_byte(m, self._ld8(self.a))
+        return 2
+
+    @_opcode(0x98)
+    def _op_eora_dir(self) -> int:
+        """EORA 0m"""
+        m = self._read_byte(self._fetch_byte())
+        self.a = self._eor8(self.a, m)
+        return 2
+
+    @_opcode(0x99)
+    def _op_adca_dir(self) -> int:
+        """ADCA 0m"""
+        m = self._read_byte(self._fetch_byte())
+        self.a = self._adc8(self.a, m)
+        return 2
+
+    @_opcode(0x9A)
+    def _op_oraa_dir(self) -> int:
+        """ORAA 0m"""
+        m = self._read_byte(self._fetch_byte())
+        self.a = self._or8(self.a, m)
+        return 2
+
+    @_opcode(0x9B)
+    def _op_adda_dir(self) -> int:
+        """ADDA 0m"""
+        m = self._read_byte(self._fetch_byte())
+        self.a = self._add8(self.a, m)
+        return 2
+
+    @_opcode(0x9C)
+    def _op_cpx_dir(self) -> int:
+        """CPX 0m"""
+        m = self._read_word(self._fetch_byte())
+        self._sub16(self.x, m)
+        return 3
+
+    @_opcode(0x9D)
+    def _op_jsr_dir(self) -> int:
+        """JSR 0m"""
+        m = self._fetch_byte()
+        self._push_word(self.pc)
+        self.pc = m
+        return 4
+
+    @_opcode(0x9E)
+    def _op_lds_dir(self) -> int:
+        """LDS 0m"""
+        m = self._read_word(self._fetch_byte())
+        self.sp = self._ld16(m)
+        return 3
+
+    @_opcode(0x9F)
+    def _op_sts_dir(self) -> int:
+        """STS 0m"""
+        m = self._fetch_byte()
+        self._write_word(m, self._ld16(self.sp))
+        return 3
+
+    # ============================================
+    # Accumulator A with Indexed (0xA0-0xAF)
+    # ============================================
+
+    @_opcode(0xA0)
+    def _op_suba_idx(self) -> int:
+        """SUBA d,X"""
+        m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
+        self.a = self._sub8(self.a, m)
+        return 3
+
+    @_opcode(0xA1)
+    def _op_cmpa_idx(self) -> int:
+        """CMPA d,X"""
+        m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
+        self._sub8(self.a, m)
+        return 3
+
+    @_opcode(0xA2)
+    def _op_sbca_idx(self) -> int:
+        """SBCA d,X"""
+        m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
+        self.a = self._sbc8(self.a, m)
+        return 3
+
+    @_opcode(0xA3)
+    def _op_subd_idx(self) -> int:
+        """SUBD d,X"""
+        m = self._read_word((self.x + self._fetch_byte()) & 0xFFFF)
+        self.d = self._sub16(self.d, m)
+        return 4
+
+    @_opcode(0xA4)
+    def _op_anda_idx(self) -> int:
+        """ANDA d,X"""
+        m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
+        self.a = self._and8(self.a, m)
+        return 3
+
+    @_opcode(0xA5)
+    def _op_bita_idx(self) -> int:
+        """BITA d,X"""
+        m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
+        self._and8(self.a, m)
+        return 3
+
+    @_opcode(0xA6)
+    def _op_ldaa_idx(self) -> int:
+        """LDAA d,X"""
+        m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
+        self.a = self._ld8(m)
+        return 3
+
+    @_opcode(0xA7)
+    def _op_staa_idx(self) -> int:
+        """STAA d,X"""
+        m = (self.x + self._fetch_byte()) & 0xFFFF
+        self._write_byte(m, self._ld8(self.a))
+        return 3
+
+    @_opcode(0xA8)
+    def _op_eora_idx(self) -> int:
+        """EORA d,X"""
+        m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
+        self.a = self._eor8(self.a, m)
+        return 3
+
+    @_opcode(0xA9)
+    def _op_adca_idx(self) -> int:
+        """ADCA d,X"""
+        m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
+        self.a = self._adc8(self.a, m)
+        return 3
+
+    @_opcode(0xAA)
+    def _op_oraa_idx(self) -> int:
+        """ORAA d,X"""
+        m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
+        self.a = self._or8(self.a, m)
+        return 3
+
+    @_opcode(0xAB)
+    def _op_adda_idx(self) -> int:
+        """ADDA d,X"""
+        m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
+        self.a = self._add8(self.a, m)
+        return 3
+
+    @_opcode(0xAC)
+    def _op_cpx_idx(self) -> int:
+        """CPX d,X"""
+        m = self._read_word((self.x + self._fetch_byte()) & 0xFFFF)
+        self._sub16(self.x, m)
+        return 4
+
+    @_opcode(0xAD)
+    def _op_jsr_idx(self) -> int:
+        """JSR d,X"""
+        m = (self.x + self._fetch_byte()) & 0xFFFF
+        self._push_word(self.pc)
+        self.pc = m
+        return 4
+
+    @_opcode(0xAE)
+    def _op_lds_idx(self) -> int:
+        """LDS d,X"""
+        m = self._read_word((self.x + self._fetch_byte()) & 0xFFFF)
+        self.sp = self._ld16(m)
+        return 4
+
+    @_opcode(0xAF)
+    def _op_sts_idx(self) -> int:
+        """STS d,X"""
+        m = (self.x + self._fetch_byte()) & 0xFFFF
+        self._write_word(m, self._ld16(self.sp))
+        return 4
+
+    # ============================================
+    # Accumulator A with Extended (0xB0-0xBF)
+    # ============================================
+
+    @_opcode(0xB0)
+    def _op_suba_ext(self) -> int:
+        """SUBA mm"""
+        m = self._read_byte(self._fetch_word())
+        self.a = self._sub8(self.a, m)
+        return 3
+
+    @_opcode(0xB1)
+    def _op_cmpa_ext(self) -> int:
+        """CMPA mm"""
+        m = self._read_byte(self._fetch_word())
+        self._sub8(self.a, m)
+        return 3
+
+    @_opcode(0xB2)
+    def _op_sbca_ext(self) -> int:
+        """SBCA mm"""
+        m = self._read_byte(self._fetch_word())
+        self.a = self._sbc8(self.a, m)
+        return 3
+
+    @_opcode(0xB3)
+    def _op_subd_ext(self) -> int:
+        """SUBD mm"""
+        m = self._read_word(self._fetch_word())
+        self.d = self._sub16(self.d, m)
+        return 4
+
+    @_opcode(0xB4)
+    def _op_anda_ext(self) -> int:
+        """ANDA mm"""
+        m = self._read_byte(self._fetch_word())
+        self.a = self._and8(self.a, m)
+        return 3
+
+    @_opcode(0xB5)
+    def _op_bita_ext(self) -> int:
+        """BITA mm"""
+        m = self._read_byte(self._fetch_word())
+        self._and8(self.a, m)
+        return 3
+
+    @_opcode(0xB6)
+    def _op_ldaa_ext(self) -> int:
+        """LDAA mm"""
+        m = self._read_byte(self._fetch_word())
+        self.a = self._ld8(m)
+        return 3
+
+    @_opcode(0xB7)
+    def _op_staa_ext(self) -> int:
+        """STAA mm"""
+        m = self._fetch_word()
+        self._write_byte(m, self._ld8(self.a))
+        return 3
+
+    @_opcode(0xB8)
+    def _op_eora_ext(self) -> int:
+        """EORA mm"""
+        m = self._read_byte(self._fetch_word())
+        self.a = self._eor8(self.a, m)
+        return 3
+
+    @_opcode(0xB9)
+    def _op_adca_ext(self) -> int:
+        """ADCA mm"""
+        m = self._read_byte(self._fetch_word())
+        self.a = self._adc8(self.a, m)
+        return 3
+
+    @_opcode(0xBA)
+    def _op_oraa_ext(self) -> int:
+        """ORAA mm"""
+        m = self._read_byte(self._fetch_word())
+        self.a = self._or8(self.a, m)
+        return 3
+
+    @_opcode(0xBB)
+    def _op_adda_ext(self) -> int:
+        """ADDA mm"""
+        m = self._read_byte(self._fetch_word())
+        self.a = self._add8(self.a, m)
+        return 3
+
+    @_opcode(0xBC)
+    def _op_cpx_ext(self) -> int:
+        """CPX mm"""
+        m = self._read_word(self._fetch_word())
+        self._sub16(self.x, m)
+        return 4
+
+    @_opcode(0xBD)
+    def _op_jsr_ext(self) -> int:
+        """JSR mm"""
+        m = self._fetch_word()
+        self._push_word(self.pc)
+        self.pc = m
+        return 5
+
+    @_opcode(0xBE)
+    def _op_lds_ext(self) -> int:
+        """LDS mm"""
+        m = self._read_word(self._fetch_word())
+        self.sp = self._ld16(m)
+        return 4
+
+    @_opcode(0xBF)
+    def _op_sts_ext(self) -> int:
+        """STS mm"""
+        m = self._fetch_word()
+        self._write_word(m, self._ld16(self.sp))
+        return 4
+
+    # ============================================
+    # Accumulator B with Immediate (0xC0-0xCF)
+    # ============================================
+
+    @_opcode(0xC0)
+    def _op_subb_imm(self) -> int:
+        """SUBB #"""
+        m = self._fetch_byte()
+        self.b = self._sub8(self.b, m)
+        return 1
+
+    @_opcode(0xC1)
+    def _op_cmpb_imm(self) -> int:
+        """CMPB #"""
+        m = self._fetch_byte()
+        self._sub8(self.b, m)
+        return 1
+
+    @_opcode(0xC2)
+    def _op_sbcb_imm(self) -> int:
+        """SBCB #"""
+        m = self._fetch_byte()
+        self.b = self._sbc8(self.b, m)
+        return 1
+
+    @_opcode(0xC3)
+    def _op_addd_imm(self) -> int:
+        """ADDD ##"""
+        m = self._fetch_word()
+        self.d = self._add16(self.d, m)
+        return 2
+
+    @_opcode(0xC4)
+    def _op_andb_imm(self) -> int:
+        """ANDB #"""
+        m = self._fetch_byte()
+        self.b = self._and8(self.b, m)
+        return 1
+
+    @_opcode(0xC5)
+    def _op_bitb_imm(self) -> int:
+        """BITB #"""
+        m = self._fetch_byte()
+        self._and8(self.b, m)
+        return 1
+
+    @_opcode(0xC6)
+    def _op_ldab_imm(self) -> int:
+        """LDAB #"""
+        m = self._fetch_byte()
+        self.b = self._ld8(m)
+        return 1
+
+    @_opcode(0xC8)
+    def _op_eorb_imm(self) -> int:
+        """EORB #"""
+        m = self._fetch_byte()
+        self.b = self._eor8(self.b, m)
+        return 1
+
+    @_opcode(0xC9)
+    def _op_adcb_imm(self) -> int:
+        """ADCB #"""
+        m = self._fetch_byte()
+        self.b = self._adc8(self.b, m)
+        return 1
+
+    @_opcode(0xCA)
+    def _op_orab_imm(self) -> int:
+        """ORAB #"""
+        m = self._fetch_byte()
+        self.b = self._or8(self.b, m)
+        return 1
+
+    @_opcode(0xCB)
+    def _op_addb_imm(self) -> int:
+        """ADDB #"""
+        m = self._fetch_byte()
+        self.b = self._add8(self.b, m)
+        return 1
+
+    @_opcode(0xCC)
+    def _op_ldd_imm(self) -> int:
+        """LDD ##"""
+        m = self._fetch_word()
+        self.d = self._ld16(m)
+        return 2
+
+    @_opcode(0xCE)
+    def _op_ldx_imm(self) -> int:
+        """LDX ##"""
+        m = self._fetch_word()
+        self.x = self._ld16(m)
+        return 2
+
+    # ============================================
+    # Accumulator B with Direct Page (0xD0-0xDF)
+    # ============================================
+
+    @_opcode(0xD0)
+    def _op_subb_dir(self) -> int:
+        """SUBB 0m"""
+        m = self._read_byte(self._fetch_byte())
+        self.b = self._sub8(self.b, m)
+        return 2
+
+    @_opcode(0xD1)
+    def _op_cmpb_dir(self) -> int:
+        """CMPB 0m"""
+        m = self._read_byte(self._fetch_byte())
+        self._sub8(self.b, m)
+        return 2
+
+    @_opcode(0xD2)
+    def _op_sbcb_dir(self) -> int:
+        """SBCB 0m"""
+        m = self._read_byte(self._fetch_byte())
+        self.b = self._sbc8(self.b, m)
+        return 2
+
+    @_opcode(0xD3)
+    def _op_addd_dir(self) -> int:
+        """ADDD 0m"""
+        m = self._read_word(self._fetch_byte())
+        self.d = self._add16(self.d, m)
+        return 3
+
+    @_opcode(0xD4)
+    def _op_andb_dir(self) -> int:
+        """ANDB 0m"""
+        m = self._read_byte(self._fetch_byte())
+        self.b = self._and8(self.b, m)
+        return 2
+
+    @_opcode(0xD5)
+    def _op_bitb_dir(self) -> int:
+        """BITB 0m"""
+        m = self._read_byte(self._fetch_byte())
+        self._and8(self.b, m)
+        return 2
+
+    @_opcode(0xD6)
+    def _op_ldab_dir(self) -> int:
+        """LDAB 0m"""
+        m = self._read_byte(self._fetch_byte())
+        self.b = self._ld8(m)
+        return 2
+
+    @_opcode(0xD7)
+    def _op_stab_dir(self) -> int:
+        """STAB 0m"""
+        m = self._fetch_byte()
+        self._write_byte(m, self._ld8(self.b))
+        return 2
+
+    @_opcode(0xD8)
+    def _op_eorb_dir(self) -> int:
+        """EORB 0m"""
+        m = self._read_byte(self._fetch_byte())
+        self.b = self._eor8(self.b, m)
+        return 2
+
+    @_opcode(0xD9)
+    def _op_adcb_dir(self) -> int:
+        """ADCB 0m"""
+        m = self._read_byte(self._fetch_byte())
+        self.b = self._adc8(self.b, m)
+        return 2
+
+    @_opcode(0xDA)
+    def _op_orab_dir(self) -> int:
+        """ORAB 0m"""
+        m = self._read_byte(self._fetch_byte())
+        self.b = self._or8(self.b, m)
+        return 2
+
+    @_opcode(0xDB)
+    def _op_addb_dir(self) -> int:
+        """ADDB 0m"""
+        m = self._read_byte(self._fetch_byte())
+        self.b = self._add8(self.b, m)
+        return 2
+
+    @_opcode(0xDC)
+    def _op_ldd_dir(self) -> int:
+        """LDD 0m"""
+        m = self._read_word(self._fetch_byte())
+        self.d = self._ld16(m)
+        return 3
+
+    @_opcode(0xDD)
+    def _op_std_dir(self) -> int:
+        """STD 0m"""
+        m = self._fetch_byte()
+        self._write_word(m, self._ld16(self.d))
+        return 3
+
+    @_opcode(0xDE)
+    def _op_ldx_dir(self) -> int:
+        """LDX 0m"""
+        m = self._read_word(self._fetch_byte())
+        self.x = self._ld16(m)
+        return 3
+
+    @_opcode(0xDF)
+    def _op_stx_dir(self) -> int:
+        """STX 0m"""
+        m = self._fetch_byte()
+        self._write_word(m, self._ld16(self.x))
+        return 3
+
+    # ============================================
+    # Accumulator B with Indexed (0xE0-0xEF)
+    # ============================================
+
+    @_opcode(0xE0)
+    def _op_subb_idx(self) -> int:
+        """SUBB d,X"""
+        m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
+        self.b = self._sub8(self.b, m)
+        return 3
+
+    @_opcode(0xE1)
+    def _op_cmpb_idx(self) -> int:
+        """CMPB d,X"""
+        m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
+        self._sub8(self.b, m)
+        return 3
+
+    @_opcode(0xE2)
+    def _op_sbcb_idx(self) -> int:
+        """SBCB d,X"""
+        m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
+        self.b = self._sbc8(self.b, m)
+        return 3
+
+    @_opcode(0xE3)
+    def _op_addd_idx(self) -> int:
+        """ADDD d,X"""
+        m = self._read_word((self.x + self._fetch_byte()) & 0xFFFF)
+        self.d = self._add16(self.d, m)
+        return 4
+
+    @_opcode(0xE4)
+    def _op_andb_idx(self) -> int:
+        """ANDB d,X"""
+        m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
+        self.b = self._and8(self.b, m)
+        return 3
+
+    @_opcode(0xE5)
+    def _op_bitb_idx(self) -> int:
+        """BITB d,X"""
+        m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
+        self._and8(self.b, m)
+        return 3
+
+    @_opcode(0xE6)
+    def _op_ldab_idx(self) -> int:
+        """LDAB d,X"""
+        m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
+        self.b = self._ld8(m)
+        return 3
+
+    @_opcode(0xE7)
+    def _op_stab_idx(self) -> int:
+        """STAB d,X"""
+        m = (self.x + self._fetch_byte()) & 0xFFFF
+        self._write_byte(m, self._ld8(self.b))
+        return 3
+
+    @_opcode(0xE8)
+    def _op_eorb_idx(self) -> int:
+        """EORB d,X"""
+        m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
+        self.b = self._eor8(self.b, m)
+        return 3
+
+    @_opcode(0xE9)
+    def _op_adcb_idx(self) -> int:
+        """ADCB d,X"""
+        m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
+        self.b = self._adc8(self.b, m)
+        return 3
+
+    @_opcode(0xEA)
+    def _op_orab_idx(self) -> int:
+        """ORAB d,X"""
+        m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
+        self.b = self._or8(self.b, m)
+        return 3
+
+    @_opcode(0xEB)
+    def _op_addb_idx(self) -> int:
+        """ADDB d,X"""
+        m = self._read_byte((self.x + self._fetch_byte()) & 0xFFFF)
+        self.b = self._add8(self.b, m)
+        return 3
+
+    @_opcode(0xEC)
+    def _op_ldd_idx(self) -> int:
+        """LDD d,X"""
+        m = self._read_word((self.x + self._fetch_byte()) & 0xFFFF)
+        self.d = self._ld16(m)
+        return 4
+
+    @_opcode(0xED)
+    def _op_std_idx(self) -> int:
+        """STD d,X"""
+        m = (self.x + self._fetch_byte()) & 0xFFFF
+        self._write_word(m, self._ld16(self.d))
+        return 4
+
+    @_opcode(0xEE)
+    def _op_ldx_idx(self) -> int:
+        """LDX d,X"""
+        m = self._read_word((self.x + self._fetch_byte()) & 0xFFFF)
+        self.x = self._ld16(m)
+        return 4
+
+    @_opcode(0xEF)
+    def _op_stx_idx(self) -> int:
+        """STX d,X"""
+        m = (self.x + self._fetch_byte()) & 0xFFFF
+        self._write_word(m, self._ld16(self.x))
+        return 4
+
+    # ============================================
+    # Accumulator B with Extended (0xF0-0xFF)
+    # ============================================
+
+    @_opcode(0xF0)
+    def _op_subb_ext(self) -> int:
+        """SUBB mm"""
+        m = self._read_byte(self._fetch_word())
+        self.b = self._sub8(self.b, m)
+        return 3
+
+    @_opcode(0xF1)
+    def _op_cmpb_ext(self) -> int:
+        """CMPB mm"""
+        m = self._read_byte(self._fetch_word())
+        self._sub8(self.b, m)
+        return 3
+
+    @_opcode(0xF2)
+    def _op_sbcb_ext(self) -> int:
+        """SBCB mm"""
+        m = self._read_byte(self._fetch_word())
+        self.b = self._sbc8(self.b, m)
+        return 3
+
+    @_opcode(0xF3)
+    def _op_addd_ext(self) -> int:
+        """ADDD mm"""
+        m = self._read_word(self._fetch_word())
+        self.d = self._add16(self.d, m)
+        return 4
+
+    @_opcode(0xF4)
+    def _op_andb_ext(self) -> int:
+        """ANDB mm"""
+        m = self._read_byte(self._fetch_word())
+        self.b = self._and8(self.b, m)
+        return 3
+
+    @_opcode(0xF5)
+    def _op_bitb_ext(self) -> int:
+        """BITB mm"""
+        m = self._read_byte(self._fetch_word())
+        self._and8(self.b, m)
+        return 3
+
+    @_opcode(0xF6)
+    def _op_ldab_ext(self) -> int:
+        """LDAB mm"""
+        m = self._read_byte(self._fetch_word())
+        self.b = self._ld8(m)
+        return 3
+
+    @_opcode(0xF7)
+    def _op_stab_ext(self) -> int:
+        """STAB mm"""
+        m = self._fetch_word()
+        self._write_byte(m, self._ld8(self.b))
+        return 3
+
+    @_opcode(0xF8)
+    def _op_eorb_ext(self) -> int:
+        """EORB mm"""
+        m = self._read_byte(self._fetch_word())
+        self.b = self._eor8(self.b, m)
+        return 3
+
+    @_opcode(0xF9)
+    def _op_adcb_ext(self) -> int:
+        """ADCB mm"""
+        m = self._read_byte(self._fetch_word())
+        self.b = self._adc8(self.b, m)
+        return 3
+
+    @_opcode(0xFA)
+    def _op_orab_ext(self) -> int:
+        """ORAB mm"""
+        m = self._read_byte(self._fetch_word())
+        self.b = self._or8(self.b, m)
+        return 3
+
+    @_opcode(0xFB)
+    def _op_addb_ext(self) -> int:
+        """ADDB mm"""
+        m = self._read_byte(self._fetch_word())
+        self.b = self._add8(self.b, m)
+        return 3
+
+    @_opcode(0xFC)
+    def _op_ldd_ext(self) -> int:
+        """LDD mm"""
+        m = self._read_word(self._fetch_word())
+        self.d = self._ld16(m)
+        return 4
+
+    @_opcode(0xFD)
+    def _op_std_ext(self) -> int:
+        """STD mm"""
+        m = self._fetch_word()
+        self._write_word(m, self._ld16(self.d))
+        return 4
+
+    @_opcode(0xFE)
+    def _op_ldx_ext(self) -> int:
+        """LDX mm"""
+        m = self._read_word(self._fetch_word())
+        self.x = self._ld16(m)
+        return 4
+
+    @_opcode(0xFF)
+    def _op_stx_ext(self) -> int:
+        """STX mm"""
+        m = self._fetch_word()
+        self._write_word(m, self._ld16(self.x))
+        return 4
 
     # ========================================
     # Snapshot Support
@@ -23,7 +23,8 @@ Ported from JAPE by Jaap Scherphuis
 """
 
 from dataclasses import dataclass
-from typing import Optional, List
+from operator import itemgetter
+from typing import Callable, Dict, List, Optional, Tuple
 
 # =============================================================================
 # CHARACTER BITMAP DATA
@@ -116,6 +117,160 @@ SCREEN2MEM_4LINE = [
     68, 69, 70, 71, 80, 81, 82, 83, 84, 85, 86, 87, 96, 97, 98, 99, 100, 101, 102, 103  # Row 3
 ]
 
+# Character code -> text character: printable ASCII as is, the rest blank
+TEXT_TRANSLATION = bytes(c if 32 <= c < 127 else 32 for c in range(256))
+
+# Character cell size in pixels
+CHAR_WIDTH = 5
+CHAR_HEIGHT = 8
+
+# Bitmap of a blank cell, shown in every cell while the display is off
+BLANK_GLYPH = bytes(CHAR_HEIGHT)
+
+
+class CellRaster:
+    """
+    A rendered image of the display, redrawn one character cell at a time.
+
+    Each cell is copied from a tile: the cell's rows of pixel bytes in
+    the image's format, made from the cell's 8-byte glyph bitmap and
+    cached by that bitmap. Since a glyph bitmap comes either from the
+    font (by character code) or from UDG RAM, a redefined UDG simply
+    gets a new tile. update() only redraws the cells whose bitmap
+    differs from the one drawn there last, so typing a character costs
+    one tile copy instead of rasterizing the whole screen.
+
+    Attributes:
+        frame: Pixel bytes, row-major
+        width: Image width in pixels
+        height: Image height in pixels
+        count: Display change count the frame shows (kept by the owner)
+    """
+
+    def __init__(self, width: int, height: int, frame: bytearray,
+                 cell_offsets: List[int], make_tile: Callable[[bytes], List[bytes]]):
+        """
+        Create a raster.
+
+        Args:
+            width: Image width in pixels
+            height: Image height in pixels
+            frame: Initial pixel bytes (what shows between the cells)
+            cell_offsets: Offset in frame of each cell's top-left pixel,
+                          by screen position
+            make_tile: Glyph bitmap -> the cell's rows of pixel bytes
+        """
+        self.width = width
+        self.height = height
+        self.frame = frame
+        self.count = -1
+        self._row_size = len(frame) // height
+        self._cell_offsets = cell_offsets
+        self._make_tile = make_tile
+        self._tiles: Dict[bytes, List[bytes]] = {}
+        self._drawn: List[Optional[bytes]] = [None] * len(cell_offsets)
+
+    @staticmethod
+    def glyph_pixels(glyph: bytes, on: bytes, off: bytes) -> List[List[bytes]]:
+        """The pixel values of a glyph bitmap, 5 per row (LSB = rightmost pixel)."""
+        return [[on if (row >> (CHAR_WIDTH - 1 - x)) & 1 else off for x in range(CHAR_WIDTH)]
+                for row in glyph]
+
+    @classmethod
+    def for_grid(cls, columns: int, lines: int, scale: int,
+                 on: bytes, off: bytes) -> "CellRaster":
+        """
+        A raster of the bare pixel grid, each pixel scale × scale.
+
+        Args:
+            columns: Display columns
+            lines: Display lines
+            scale: Pixel scale factor
+            on: Pixel value of an "on" pixel
+            off: Pixel value of an "off" pixel
+        """
+        width = columns * CHAR_WIDTH * scale
+        height = lines * CHAR_HEIGHT * scale
+        pixel_size = len(on)
+        row_size = width * pixel_size
+
+        def make_tile(glyph: bytes) -> List[bytes]:
+            rows = []
+            for pixels in cls.glyph_pixels(glyph, on * scale, off * scale):
+                rows.extend([b"".join(pixels)] * scale)
+            return rows
+
+        offsets = [(line * CHAR_HEIGHT * scale) * row_size + col * CHAR_WIDTH * scale * pixel_size
+                   for line in range(lines) for col in range(columns)]
+        return cls(width, height, bytearray(row_size * height), offsets, make_tile)
+
+    @classmethod
+    def for_lcd(cls, columns: int, lines: int, scale: int, pixel_gap: int,
+                char_gap: int, bezel: int, ink: bytes, paper: bytes,
+                grid: bytes, bezel_color: bytes) -> "CellRaster":
+        """
+        An RGB raster that looks like the LCD (see Display.render_image_lcd).
+
+        The gaps between pixels and cells show the grid color, and the
+        display is framed by the bezel.
+        """
+        cell_width = CHAR_WIDTH * scale + (CHAR_WIDTH - 1) * pixel_gap
+        cell_height = CHAR_HEIGHT * scale + (CHAR_HEIGHT - 1) * pixel_gap
+        display_width = columns * cell_width + (columns - 1) * char_gap
+        display_height = lines * cell_height + (lines - 1) * char_gap
+        width = display_width + 2 * bezel
+        height = display_height + 2 * bezel
+        row_size = width * 3
+
+        bezel_row = bezel_color * width
+        display_row = bezel_color * bezel + grid * display_width + bezel_color * bezel
+        frame = bytearray(bezel_row * bezel + display_row * display_height + bezel_row * bezel)
+
+        gap_row = grid * cell_width
+
+        def make_tile(glyph: bytes) -> List[bytes]:
+            rows = []
+            for pixels in cls.glyph_pixels(glyph, ink * scale, paper * scale):
+                row = (grid * pixel_gap).join(pixels)
+                if rows:
+                    rows.extend([gap_row] * pixel_gap)
+                rows.extend([row] * scale)
+            return rows
+
+        offsets = [(bezel + line * (cell_height + char_gap)) * row_size
+                   + (bezel + col * (cell_width + char_gap)) * 3
+                   for line in range(lines) for col in range(columns)]
+        return cls(width, height, frame, offsets, make_tile)
+
+    def update(self, glyphs: List[bytes]) -> int:
+        """
+        Redraw the cells whose glyph changed.
+
+        Args:
+            glyphs: Glyph bitmap of each cell, by screen position
+
+        Returns:
+            Number of cells redrawn
+        """
+        frame = self.frame
+        row_size = self._row_size
+        tiles = self._tiles
+        drawn = self._drawn
+        redrawn = 0
+        for pos, glyph in enumerate(glyphs):
+            if drawn[pos] == glyph:
+                continue
+            tile = tiles.get(glyph)
+            if tile is None:
+                tile = tiles[glyph] = self._make_tile(glyph)
+            offset = self._cell_offsets[pos]
+            for row in tile:
+                frame[offset:offset + len(row)] = row
+                offset += row_size
+            drawn[pos] = glyph
+            redrawn += 1
+        return redrawn
+
 
 @dataclass
 class DisplayState:
@@ -167,6 +322,9 @@ class Display:
     DISPLAY_RAM_SIZE = 128
     UDG_RAM_SIZE = 64
 
+    # Rendering styles (scale, colors...) kept in the caches at a time
+    MAX_CACHED_RENDERINGS = 8
+
     def __init__(self, num_lines: int = 2):
         """
         Initialize display controller.
@@ -191,12 +349,37 @@ class Display:
         for screen_pos, mem_addr in enumerate(self._screen2mem):
             self._mem2screen[mem_addr] = screen_pos
 
+        # Per line, fetches the display RAM bytes shown on it
+        cols = self._num_columns
+        self._line_bytes = [itemgetter(*self._screen2mem[row * cols:(row + 1) * cols])
+                            for row in range(num_lines)]
+
         # Allocate display RAM (128 bytes) and UDG RAM (64 bytes)
         self._display_data = bytearray(self.DISPLAY_RAM_SIZE)
         self._udg_data = bytearray(self.UDG_RAM_SIZE)
 
-        # Track if display needs refresh (for external rendering)
+        # Change tracking. _needs_refresh is the dirty flag: set by every
+        # visible change and cleared when the contents are read.
+        # _change_count only ever grows, so a reader can tell whether
+        # anything changed since it last looked without comparing text.
         self._needs_refresh = True
+        self._change_count = 0
+
+        # Text of the screen as of change _text_count (see get_text_grid)
+        self._text_grid: List[str] = []
+        self._text = ""
+        self._text_count = -1
+
+        # Called after every visible change (see Emulator.run)
+        self.on_change: Optional[Callable[[], None]] = None
+
+        # Rendering caches, all brought up to date from change counts:
+        # the bitmap in each cell, a raster per rendering style and the
+        # last PNG of each style
+        self._glyphs: List[bytes] = []
+        self._glyphs_count = -1
+        self._rasters: Dict[tuple, CellRaster] = {}
+        self._png_cache: Dict[tuple, Tuple[int, bytes]] = {}
 
     @property
     def num_lines(self) -> int:
@@ -218,6 +401,24 @@ class Display:
         """True if display content has changed since last read."""
         return self._needs_refresh
 
+    @property
+    def change_count(self) -> int:
+        """
+        Number of visible changes so far.
+
+        Compare with an earlier value to find out whether the display has
+        changed in between; writes that store the byte already there do
+        not count.
+        """
+        return self._change_count
+
+    def _changed(self) -> None:
+        """Record a visible change and tell the listener."""
+        self._needs_refresh = True
+        self._change_count += 1
+        if self.on_change is not None:
+            self.on_change()
+
     def switch_on(self) -> None:
         """
         Power on the display.
@@ -240,12 +441,12 @@ class Display:
         for i in range(self.DISPLAY_RAM_SIZE):
             self._display_data[i] = 32  # Space character
 
-        self._needs_refresh = True
+        self._changed()
 
     def switch_off(self) -> None:
         """Power off the display."""
         self._state.is_on = False
-        self._needs_refresh = True
+        self._changed()
 
     def reset(self) -> None:
         """Reset display (alias for switch_off)."""
@@ -274,7 +475,7 @@ class Display:
                 self._state.cursor_pos = data & 0x7F
                 self._state.scr_ptr = data & 0x7F
                 if self._state.cursor_state:
-                    self._needs_refresh = True
+                    self._changed()
             self._state.ptr_to_screen = True
 
         elif (data & 0x40) != 0:
@@ -295,7 +496,7 @@ class Display:
                     self._state.cursor_pos = (self._state.cursor_pos + 1) & 0x7F
                 else:
                     self._state.cursor_pos = (self._state.cursor_pos - 1) & 0x7F
-                self._needs_refresh = True
+                self._changed()
             # Display shift ignored for now
 
         elif (data & 0x08) != 0:
@@ -303,7 +504,7 @@ class Display:
             self._state.cursor_state = (data & 0x04) != 0
             self._state.cursor_ul = (data & 0x02) != 0
             self._state.cursor_fl = (data & 0x01) != 0
-            self._needs_refresh = True
+            self._changed()
 
         elif (data & 0x04) != 0:
             # 000001AD - Entry mode set
@@ -313,7 +514,7 @@ class Display:
         elif (data & 0x02) != 0:
             # 0000001x - Return home
             self._state.cursor_pos = 0
-            self._needs_refresh = True
+            self._changed()
 
         elif (data & 0x01) != 0:
             # 00000001 - Clear display
@@ -321,7 +522,7 @@ class Display:
                 self._display_data[i] = 32  # Space
             self._state.cursor_pos = 0
             self._state.scr_ptr = 0
-            self._needs_refresh = True
+            self._changed()
 
     def set_data(self, data: int) -> None:
         """
@@ -337,12 +538,12 @@ class Display:
         data = data & 0xFF
 
         if self._state.ptr_to_screen:
-            # Write to display RAM
-            self._display_data[self._state.scr_ptr] = data
-
-            # Mark refresh if this position is visible
-            if self._state.scr_ptr in self._mem2screen:
-                self._needs_refresh = True
+            # Write to display RAM, marking a change if the byte is new
+            # and this position is visible
+            if self._display_data[self._state.scr_ptr] != data:
+                self._display_data[self._state.scr_ptr] = data
+                if self._state.scr_ptr in self._mem2screen:
+                    self._changed()
 
             if self._state.addr_incr:
                 self._state.scr_ptr += 1
@@ -354,7 +555,7 @@ class Display:
             # Write to UDG RAM
             self._udg_data[self._state.udg_ptr] = data
             self._state.udg_ptr = (self._state.udg_ptr + 1) & 0x3F
-            self._needs_refresh = True
+            self._changed()
 
     def get_data(self) -> int:
         """
@@ -383,35 +584,33 @@ class Display:
         Returns:
             List of strings, one per display line
         """
+        self._needs_refresh = False
+        if self._text_count != self._change_count:
+            self._text_grid = self._build_text_grid()
+            self._text = "\n".join(self._text_grid)
+            self._text_count = self._change_count
+        return list(self._text_grid)
+
+    def _build_text_grid(self) -> List[str]:
+        """Convert the visible display RAM to text."""
         if not self._state.is_on:
             return ["" for _ in range(self._state.num_lines)]
 
-        result = []
-        pos = 0
-        for line in range(self._state.num_lines):
-            line_chars = []
-            for col in range(self._num_columns):
-                addr = self._screen2mem[pos]
-                char_code = self._display_data[addr]
-                # Convert character code to displayable character
-                if 32 <= char_code < 127:
-                    line_chars.append(chr(char_code))
-                else:
-                    line_chars.append(' ')  # Non-printable
-                pos += 1
-            result.append("".join(line_chars))
-
-        self._needs_refresh = False
-        return result
+        data = self._display_data
+        return [bytes(line(data)).translate(TEXT_TRANSLATION).decode("ascii")
+                for line in self._line_bytes]
 
     def get_text(self) -> str:
         """
         Get display contents as single string with newlines.
 
+        The text is only rebuilt after the display has changed.
+
         Returns:
             Display text with '\\n' separating lines
         """
-        return "\n".join(self.get_text_grid())
+        self.get_text_grid()
+        return self._text
 
     def get_char_at(self, row: int, col: int) -> int:
         """
@@ -435,105 +634,120 @@ class Display:
     # Pixel Buffer API (for graphical rendering)
     # =========================================================================
 
-    def get_pixel_buffer(self) -> bytes:
+    def _cell_glyphs(self) -> List[bytes]:
         """
-        Get display as pixel buffer.
+        The 8-byte bitmap shown in each character cell, by screen position.
 
-        Returns:
-            Bytes containing pixel data (1 bit per pixel, packed).
-            Format: Row-major, MSB first.
-            Size: (num_lines * 8) rows × (num_columns * 5 + gaps) columns
+        Codes 0-7 show UDG RAM, codes 8-31 show the glyph of code 32 and
+        every cell is blank while the display is off.
         """
+        if self._glyphs_count == self._change_count:
+            return self._glyphs
+
+        cells = self._screen2mem[:self._state.num_lines * self._num_columns]
         if not self._state.is_on:
-            return bytes(self._state.num_lines * 8 * (self._num_columns * 5))
+            glyphs = [BLANK_GLYPH] * len(cells)
+        else:
+            data = self._display_data
+            udg = bytes(self._udg_data)
+            font = self._char_bitmap
+            glyphs = []
+            for mem_addr in cells:
+                char_code = data[mem_addr]
+                if char_code < 8:
+                    glyph = udg[char_code * 8:char_code * 8 + 8]
+                else:
+                    offset = max(char_code - 32, 0) * 8
+                    glyph = font[offset:offset + 8].ljust(CHAR_HEIGHT, b"\0")
+                glyphs.append(glyph)
 
-        # Calculate dimensions
-        char_width = 5
-        char_height = 8
-        width = self._num_columns * char_width
-        height = self._state.num_lines * char_height
+        self._glyphs = glyphs
+        self._glyphs_count = self._change_count
+        return glyphs
 
-        # Create pixel buffer (1 byte per pixel for simplicity)
-        pixels = bytearray(width * height)
+    def _raster(self, key: tuple, build: Callable[[], "CellRaster"]) -> "CellRaster":
+        """
+        The raster for a rendering style, brought up to date.
 
-        # Render each character
-        for line in range(self._state.num_lines):
-            for col in range(self._num_columns):
-                screen_pos = line * self._num_columns + col
-                mem_addr = self._screen2mem[screen_pos]
-                char_code = self._display_data[mem_addr]
+        Args:
+            key: Rendering style and its parameters
+            build: Creates the raster the first time the style is used
+        """
+        raster = self._rasters.get(key)
+        if raster is None:
+            if len(self._rasters) >= self.MAX_CACHED_RENDERINGS:
+                self._rasters.clear()
+            raster = self._rasters[key] = build()
+        if raster.count != self._change_count:
+            raster.update(self._cell_glyphs())
+            raster.count = self._change_count
+        return raster
+
+    def _cached_png(self, key: tuple) -> Optional[bytes]:
+        """The PNG last encoded for a style, if the display has not changed since."""
+        cached = self._png_cache.get(key)
+        if cached is not None and cached[0] == self._change_count:
+            return cached[1]
+        return None
+
+    def _encode_png(self, key: tuple, mode: str, raster: "CellRaster") -> bytes:
+        """Encode a raster as PNG (PIL must be available) and cache it."""
+        from PIL import Image
+        import io
+
+        img = Image.frombytes(mode, (raster.width, raster.height), bytes(raster.frame))
+        buffer = io.BytesIO()
+        img.save(buffer, format='PNG')
+        png = buffer.getvalue()
 
-                # Get character bitmap
-                if char_code < 8:
-                    # UDG character (0-7)
-                    bitmap_offset = char_code * 8
-                    char_data = self._udg_data
-                else:
-                    # Normal character (map 8-31 to 0)
-                    bitmap_offset = max((char_code - 32), 0) * 8
-                    char_data = self._char_bitmap
-
-                # Render character pixels
-                base_x = col * char_width
-                base_y = line * char_height
-
-                for row_idx in range(char_height):
-                    if bitmap_offset + row_idx < len(char_data):
-                        row_data = char_data[bitmap_offset + row_idx]
-                    else:
-                        row_data = 0
-
-                    for bit_idx in range(char_width):
-                        # LSB = rightmost pixel
-                        pixel_on = (row_data >> bit_idx) & 1
-                        pixel_x = base_x + (char_width - 1 - bit_idx)
-                        pixel_y = base_y + row_idx
-                        pixels[pixel_y * width + pixel_x] = pixel_on * 255
+        if len(self._png_cache) >= self.MAX_CACHED_RENDERINGS:
+            self._png_cache.clear()
+        self._png_cache[key] = (self._change_count, png)
+        return png
 
+    def get_pixel_buffer(self) -> bytes:
+        """
+        Get display as pixel buffer.
+
+        Only the character cells that changed since the last call are
+        redrawn.
+
+        Returns:
+            Bytes containing pixel data (1 byte per pixel, 255 = on, 0 = off).
+            Format: Row-major.
+            Size: (num_lines * 8) rows × (num_columns * 5) columns
+        """
+        raster = self._raster(("pixels",), lambda: CellRaster.for_grid(
+            self._num_columns, self._state.num_lines, 1, bytes([255]), bytes([0])))
         self._needs_refresh = False
-        return bytes(pixels)
+        return bytes(raster.frame)
 
     def render_image(self, scale: int = 2) -> Optional[bytes]:
         """
         Render display as PNG image (requires PIL).
 
+        Only changed character cells are redrawn, and the PNG is reused
+        until the display changes again.
+
         Args:
             scale: Pixel scale factor (default 2)
 
         Returns:
             PNG image bytes, or None if PIL not available
         """
+        key = ("image", scale)
+        png = self._cached_png(key)
+        if png is not None:
+            return png
         try:
-            from PIL import Image
-            import io
+            import PIL  # noqa: F401
         except ImportError:
             return None
 
-        # Get pixel buffer
-        pixels = self.get_pixel_buffer()
-
-        # Calculate dimensions
-        char_width = 5
-        char_height = 8
-        width = self._num_columns * char_width
-        height = self._state.num_lines * char_height
-
-        # Create image
-        img = Image.new('L', (width * scale, height * scale), color=180)  # Gray background
-
-        # Fill pixels
-        for y in range(height):
-            for x in range(width):
-                pixel = pixels[y * width + x]
-                color = 32 if pixel else 180  # Dark gray for on, light for off
-                for sy in range(scale):
-                    for sx in range(scale):
-                        img.putpixel((x * scale + sx, y * scale + sy), color)
-
-        # Export as PNG
-        buffer = io.BytesIO()
-        img.save(buffer, format='PNG')
-        return buffer.getvalue()
+        # Dark gray for on, light gray background for off
+        raster = self._raster(key, lambda: CellRaster.for_grid(
+            self._num_columns, self._state.num_lines, scale, bytes([32]), bytes([180])))
+        return self._encode_png(key, 'L', raster)
 
     def render_image_lcd(
         self,
@@ -551,6 +765,8 @@ class Display:
 
         Creates a realistic LCD display rendering showing the character
         cell boundaries and pixel grid, similar to a real Psion display.
+        Like render_image, it only redraws changed cells and reuses the
+        PNG while the display is unchanged.
 
         Args:
             scale: Pixel scale factor (default 3)
@@ -565,82 +781,20 @@ class Display:
         Returns:
             PNG image bytes, or None if PIL not available
         """
+        key = ("lcd", scale, pixel_gap, char_gap, bezel,
+               tuple(ink_color), tuple(paper_color), tuple(grid_color), tuple(bezel_color))
+        png = self._cached_png(key)
+        if png is not None:
+            return png
         try:
-            from PIL import Image, ImageDraw
-            import io
+            import PIL  # noqa: F401
         except ImportError:
             return None
 
-        # Character dimensions
-        char_width = 5   # pixels per character width
-        char_height = 8  # pixels per character height
-
-        # Calculate scaled pixel size (each LCD pixel becomes scale x scale)
-        pixel_size = scale
-
-        # Calculate character cell size (including pixel gaps)
-        cell_width = char_width * pixel_size + (char_width - 1) * pixel_gap
-        cell_height = char_height * pixel_size + (char_height - 1) * pixel_gap
-
-        # Calculate total display size
-        display_width = (
-            self._num_columns * cell_width +
-            (self._num_columns - 1) * char_gap
-        )
-        display_height = (
-            self._state.num_lines * cell_height +
-            (self._state.num_lines - 1) * char_gap
-        )
-
-        # Total image size with bezel
-        img_width = display_width + 2 * bezel
-        img_height = display_height + 2 * bezel
-
-        # Create RGB image with bezel color
-        img = Image.new('RGB', (img_width, img_height), color=bezel_color)
-        draw = ImageDraw.Draw(img)
-
-        # Fill LCD area with grid color (will show through gaps)
-        draw.rectangle(
-            [bezel, bezel, bezel + display_width - 1, bezel + display_height - 1],
-            fill=grid_color
-        )
-
-        # Get pixel buffer
-        pixels = self.get_pixel_buffer()
-        src_width = self._num_columns * char_width
-
-        # Draw each character cell
-        for char_row in range(self._state.num_lines):
-            for char_col in range(self._num_columns):
-                # Calculate cell top-left position
-                cell_x = bezel + char_col * (cell_width + char_gap)
-                cell_y = bezel + char_row * (cell_height + char_gap)
-
-                # Draw each pixel in the character
-                for py in range(char_height):
-                    for px in range(char_width):
-                        # Get pixel state from buffer
-                        src_x = char_col * char_width + px
-                        src_y = char_row * char_height + py
-                        pixel_on = pixels[src_y * src_width + src_x]
-
-                        # Calculate pixel rectangle position
-                        pixel_x = cell_x + px * (pixel_size + pixel_gap)
-                        pixel_y = cell_y + py * (pixel_size + pixel_gap)
-
-                        # Draw pixel (ink if on, paper if off)
-                        color = ink_color if pixel_on else paper_color
-                        draw.rectangle(
-                            [pixel_x, pixel_y,
-                             pixel_x + pixel_size - 1, pixel_y + pixel_size - 1],
-                            fill=color
-                        )
-
-        # Export as PNG
-        buffer = io.BytesIO()
-        img.save(buffer, format='PNG')
-        return buffer.getvalue()
+        raster = self._raster(key, lambda: CellRaster.for_lcd(
+            self._num_columns, self._state.num_lines, scale, pixel_gap, char_gap, bezel,
+            bytes(ink_color), bytes(paper_color), bytes(grid_color), bytes(bezel_color)))
+        return self._encode_png(key, 'RGB', raster)
 
     # =========================================================================
     # Contrast Control
@@ -650,13 +804,13 @@ class Display:
         """Increase contrast level (max 10)."""
         if self._state.is_on and self._state.contrast < 10:
             self._state.contrast += 1
-            self._needs_refresh = True
+            self._changed()
 
     def decrease_contrast(self) -> None:
         """Decrease contrast level (min 0)."""
         if self._state.is_on and self._state.contrast > 0:
             self._state.contrast -= 1
-            self._needs_refresh = True
+            self._changed()
 
     # =========================================================================
     # Snapshot Support
@@ -699,9 +853,12 @@ class Display:
         Returns:
             Number of bytes consumed
         """
-        # Reinitialize with correct line count
+        # Reinitialize with correct line count, keeping the change count
+        # running and the listener attached
         num_lines = data[offset]
+        change_count, on_change = self._change_count, self.on_change
         self.__init__(num_lines)
+        self._change_count, self.on_change = change_count, on_change
 
         # Restore state
         self._state.cursor_pos = data[offset + 1]
@@ -717,14 +874,12 @@ class Display:
 
         # Restore display RAM
         pos = offset + 11
-        for i in range(self.DISPLAY_RAM_SIZE):
-            self._display_data[i] = data[pos + i]
+        self._display_data[:] = data[pos:pos + self.DISPLAY_RAM_SIZE]
         pos += self.DISPLAY_RAM_SIZE
 
         # Restore UDG RAM
-        for i in range(self.UDG_RAM_SIZE):
-            self._udg_data[i] = data[pos + i]
+        self._udg_data[:] = data[pos:pos + self.UDG_RAM_SIZE]
         pos += self.UDG_RAM_SIZE
 
-        self._needs_refresh = True
+        self._changed()
         return pos - offset
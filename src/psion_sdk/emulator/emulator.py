@@ -29,9 +29,10 @@ Ported from JAPE's psion.js orchestration logic, enhanced with:
 Copyright (c) 2025 Hugo José Pinto & Contributors
 """
 
+import copy
 from dataclasses import dataclass
 from pathlib import Path
-from typing import Optional, Union, List
+from typing import Optional, Union, List, Tuple
 
 from .cpu import HD6303
 from .bus import Bus
@@ -40,6 +41,8 @@ from .display import Display
 from .keyboard import Keyboard
 from .pack import Pack
 from .breakpoints import BreakpointManager, BreakEvent, BreakReason
+from .blocks import BlockCache
+from .profiler import Profiler, SymbolTable
 from .models import PsionModel, get_model, get_rom_path
 
 
@@ -54,13 +57,59 @@ class EmulatorConfig:
         model: Model code ("CM", "XP", "LZ", "LZ64"). Default is "XP" (32KB).
         rom_path: Optional path to a custom ROM file. If not provided,
                   uses the default ROM for the specified model.
+        block_cache: Execute through the basic-block translation cache
+                     (see blocks.py). Cycle counts and breakpoint behavior
+                     are identical to the plain interpreter.
+        fast_forward_idle: Skip ahead to the next timer/NMI interrupt while
+                           the CPU sleeps (SLP, as in the ROM keyboard wait)
+                           or spins on a jump-to-self. Cycle counts and
+                           final state are identical; only wall-clock time
+                           is saved. Default is True.
 
     Example:
         >>> config = EmulatorConfig(model="LZ")  # Use default LZ ROM
         >>> config = EmulatorConfig(model="XP", rom_path=Path("custom.rom"))
+        >>> config = EmulatorConfig(model="XP", block_cache=True)
     """
     model: str = "XP"
     rom_path: Optional[Path] = None
+    block_cache: bool = False
+    fast_forward_idle: bool = True
+
+
+@dataclass(frozen=True)
+class EmulatorImage:
+    """
+    Complete, picklable capture of an emulator's state.
+
+    Unlike a snapshot this also covers pack contents and the emulator
+    configuration, so restore() yields an emulator that behaves exactly
+    like the original from the capture point on. An image can be restored
+    any number of times and sent to worker processes.
+
+    Attributes:
+        config: Configuration of the captured emulator (ROM, model, engine)
+        snapshot: Snapshot data (same format as snapshot())
+        packs: Copies of the three pack slots
+
+    Example:
+        >>> image = booted.capture_image()
+        >>> a, b = image.restore(), image.restore()  # Independent copies
+    """
+    config: "EmulatorConfig"
+    snapshot: bytes
+    packs: Tuple[Pack, ...]
+
+    def restore(self) -> "Emulator":
+        """
+        Create a new emulator in the captured state.
+
+        Returns:
+            Independent Emulator instance
+        """
+        emu = Emulator(self.config)
+        emu.load_image(self)
+        return emu
 
 
 class Emulator:
@@ -139,6 +188,16 @@ class Emulator:
 
         # Initialize CPU with bus
         self.cpu = HD6303(self.bus)
+        self.cpu.fast_forward_idle = self.config.fast_forward_idle
+
+        # Optional basic-block execution engine
+        self._block_cache: Optional[BlockCache] = (
+            BlockCache(self.cpu, self.bus, self._memory)
+            if self.config.block_cache else None
+        )
+
+        # Cycle profiler (None when not profiling)
+        self._profiler: Optional[Profiler] = None
 
         # Initialize breakpoint manager
         self.breakpoints = BreakpointManager()
@@ -155,6 +214,7 @@ class Emulator:
         # State tracking
         self._is_running = False
         self._total_cycles = 0
+        self._last_run_cycles = 0
 
     def _instruction_hook(self, pc: int, opcode: int) -> bool:
         """
@@ -310,7 +370,7 @@ class Emulator:
             >>> print(f"PC after step: ${emu.cpu.pc:04X}")
         """
         # Use CPU's step() method which bypasses hooks to execute exactly one instruction
-        cycles = self.cpu.step()
+        cycles = self.cpu.step(self._profiler)
         self._total_cycles += cycles
 
         # Return a step event
@@ -320,7 +380,8 @@ class Emulator:
             message=f"Step at ${self.cpu.pc:04X}"
         )
 
-    def run(self, max_cycles: int = 1_000_000) -> BreakEvent:
+    def run(self, max_cycles: int = 1_000_000,
+            stop_on_display_change: bool = False) -> BreakEvent:
         """
         Run until breakpoint or max cycles reached.
 
@@ -329,9 +390,15 @@ class Emulator:
         - A register condition is met
         - max_cycles are consumed
         - The system is switched off
+        - The display changes, if stop_on_display_change is set
 
         Args:
             max_cycles: Maximum CPU cycles to execute
+            stop_on_display_change: Also stop after the instruction that
+                changes the display contents (with the block cache, at
+                the end of that block). Used by run_until_text and the
+                testkit's wait_for to wake up as soon as there is
+                something new on screen.
 
         Returns:
             BreakEvent describing why execution stopped
@@ -342,17 +409,66 @@ class Emulator:
             >>> if event.reason == BreakReason.PC_BREAKPOINT:
             ...     print(f"Hit breakpoint at ${event.address:04X}")
         """
+        cpu = self.cpu
+        display = self.display
+        cpu.stop_requested = False
+        changes_before = display.change_count
+        if stop_on_display_change:
+            previous_listener = display.on_change
+
+            def on_change() -> None:
+                cpu.stop_requested = True
+                if previous_listener is not None:
+                    previous_listener()
+            display.on_change = on_change
+
         self._is_running = True
-        cycles = self.cpu.execute(max_cycles)
+        try:
+            if self._profiler is not None:
+                cycles = self._run_profiled(max_cycles)
+            elif self._block_cache is not None and self.breakpoints.only_pc_breakpoints:
+                cycles = self._block_cache.execute(
+                    max_cycles,
+                    self.breakpoints.breakpoint_addresses,
+                    self._instruction_hook
+                )
+            elif self.breakpoints.is_active:
+                cycles = cpu.execute(max_cycles)
+            else:
+                # Nothing to check per instruction - skip the hooks entirely
+                cycles = cpu.execute_unhooked(max_cycles)
+        finally:
+            if stop_on_display_change:
+                display.on_change = previous_listener
+                cpu.stop_requested = False
+            self._is_running = False
         self._total_cycles += cycles
-        self._is_running = False
-
-        # Return last event or max cycles reached
-        return self.breakpoints.last_event or BreakEvent(
+        self._last_run_cycles = cycles
+
+        # Return last event, display change or max cycles reached
+        if self.breakpoints.last_event is not None:
+            return self.breakpoints.last_event
+        if stop_on_display_change and display.change_count != changes_before:
+            return BreakEvent(BreakReason.DISPLAY_CHANGE, address=cpu.pc,
+                              message="Display changed")
+        return BreakEvent(
             BreakReason.MAX_CYCLES,
             message=f"Reached max cycles ({max_cycles})"
         )
 
+    def _run_profiled(self, max_cycles: int) -> int:
+        """Run under the profiler, with hooks only if breakpoints need them."""
+        cpu = self.cpu
+        if self.breakpoints.is_active:
+            return cpu.execute_profiled(max_cycles, self._profiler)
+
+        saved_hooks = (cpu.on_instruction, cpu.on_memory_read, cpu.on_memory_write)
+        cpu.on_instruction = cpu.on_memory_read = cpu.on_memory_write = None
+        try:
+            return cpu.execute_profiled(max_cycles, self._profiler)
+        finally:
+            cpu.on_instruction, cpu.on_memory_read, cpu.on_memory_write = saved_hooks
+
     def run_until_pc(self, address: int, max_cycles: int = 10_000_000) -> bool:
         """
         Run until PC reaches a specific address.
@@ -396,12 +512,16 @@ class Emulator:
         """
         Run until display contains specified text.
 
-        Periodically checks the display buffer for the target text.
+        Runs in bursts that end early when the display changes, and only
+        searches the display text again when it has changed, so the text
+        is found right after the instruction that writes it and an idle
+        screen costs nothing to check.
 
         Args:
             text: Text to search for in display
             max_cycles: Maximum cycles before giving up
-            check_interval: Cycles between display checks
+            check_interval: Longest burst between checks (a display
+                change ends a burst sooner)
 
         Returns:
             True if text was found, False if max_cycles hit first
@@ -412,15 +532,25 @@ class Emulator:
             ...     print("Program displayed greeting")
         """
         cycles_executed = 0
+        checked_changes = None
 
         while cycles_executed < max_cycles:
-            # Run for a short burst
-            self.run(check_interval)
-            cycles_executed += check_interval
-
-            # Check display for target text
-            if text in self.display_text:
-                return True
+            # Run until the display changes, or for at most check_interval
+            self.run(min(check_interval, max_cycles - cycles_executed),
+                     stop_on_display_change=True)
+            cycles = self._last_run_cycles
+            if cycles == 0:
+                # Held at a breakpoint - step over it
+                self.step()
+                cycles = 1
+            cycles_executed += cycles
+
+            # Check display for target text, unless nothing changed
+            changes = self.display.change_count
+            if changes != checked_changes:
+                checked_changes = changes
+                if text in self.display_text:
+                    return True
 
         return False
 
@@ -579,7 +709,7 @@ class Emulator:
         Returns:
             Image data as bytes
         """
-        return self.display.render_image(scale=scale, format=format)
+        return self.display.render_image(scale=scale)
 
     # =========================================================================
     # Memory Access
@@ -712,6 +842,17 @@ class Emulator:
     # Snapshot Support
     # =========================================================================
 
+    # Snapshot layout (all components in their get_snapshot_data() format):
+    #   'SNA' 0x01, CPU, bus, display, memory, then the extension block
+    #   'SNX' 0x01, keyboard, 8-byte cycle counter
+    # Readers that stop after the memory state ignore the extension, and
+    # snapshots without one leave keyboard and cycle counter untouched.
+    # A delta snapshot starts with 'SND' 0x01 and the length of its base
+    # snapshot, and stores only the RAM pages that differ from the base.
+    _SNAPSHOT_MAGIC = b'SNA\x01'
+    _DELTA_MAGIC = b'SND\x01'
+    _EXTENSION_MAGIC = b'SNX\x01'
+
     def save_snapshot(self, path: Union[str, Path]) -> None:
         """
         Save complete emulator state to a file.
@@ -726,31 +867,7 @@ class Emulator:
             Pack contents are NOT saved in the snapshot. To fully restore
             a session, you must also reload the same OPK files.
         """
-        path = Path(path)
-
-        # Build snapshot data
-        data = bytearray()
-
-        # Magic header 'SNA' + version byte
-        data.extend(b'SNA\x01')
-
-        # CPU state
-        cpu_data = self.cpu.get_snapshot_data()
-        data.extend(bytes(cpu_data))
-
-        # Bus state
-        bus_data = self.bus.get_snapshot_data()
-        data.extend(bytes(bus_data))
-
-        # Display state
-        display_data = self.display.get_snapshot_data()
-        data.extend(bytes(display_data))
-
-        # Memory state (this can be large)
-        mem_data = self._memory.get_snapshot_data()
-        data.extend(bytes(mem_data))
-
-        path.write_bytes(bytes(data))
+        Path(path).write_bytes(self.snapshot())
 
     def load_snapshot(self, path: Union[str, Path]) -> None:
         """
@@ -774,26 +891,202 @@ class Emulator:
         if not path.exists():
             raise FileNotFoundError(f"Snapshot file not found: {path}")
 
-        data = list(path.read_bytes())
+        self.restore(path.read_bytes())
+
+    def snapshot(self, base: Optional[bytes] = None) -> bytes:
+        """
+        Capture emulator state in memory.
+
+        Same data as save_snapshot() writes. With a base, only the RAM
+        pages that differ from the base are stored, which makes frequent
+        checkpoints of the same session small and cheap.
+
+        Args:
+            base: Full snapshot from this emulator to take a delta against
+
+        Returns:
+            Snapshot bytes for restore()
+
+        Raises:
+            ValueError: If base is not a full snapshot of the same RAM layout
+
+        Example:
+            >>> start = emu.snapshot()
+            >>> emu.run(100000)
+            >>> step = emu.snapshot(base=start)   # Changed pages only
+            >>> emu.restore(step, base=start)     # Rewind
+        """
+        data = bytearray()
+
+        if base is not None:
+            if base[:4] != self._SNAPSHOT_MAGIC:
+                raise ValueError("Delta base must be a full snapshot")
+            data += self._DELTA_MAGIC
+            data += len(base).to_bytes(4, "big")
+        else:
+            data += self._SNAPSHOT_MAGIC
+
+        data += bytes(self.cpu.get_snapshot_data())
+        data += bytes(self.bus.get_snapshot_data())
+        data += bytes(self.display.get_snapshot_data())
+
+        if base is not None:
+            # Component sizes match the base, so its memory state is at
+            # the same offset once the delta header is accounted for
+            memory_offset = len(data) - len(self._DELTA_MAGIC) - 4 + len(self._SNAPSHOT_MAGIC)
+            self._memory.snapshot_delta_into(data, bytes(base), memory_offset)
+        else:
+            self._memory.snapshot_into(data)
+
+        data += self._EXTENSION_MAGIC
+        data += bytes(self.keyboard.get_snapshot_data())
+        data += self._total_cycles.to_bytes(8, "big")
+
+        return bytes(data)
+
+    def restore(self, snapshot: bytes, base: Optional[bytes] = None) -> None:
+        """
+        Restore emulator state from snapshot().
+
+        Breakpoints, watchpoints and packs are not affected.
+
+        Args:
+            snapshot: Full or delta snapshot bytes
+            base: The base the delta was taken against (delta snapshots only)
 
-        # Validate header
-        if data[:4] != [ord('S'), ord('N'), ord('A'), 0x01]:
+        Raises:
+            ValueError: If snapshot format is invalid or the base is missing
+        """
+        header = bytes(snapshot[:4])
+        if header == self._DELTA_MAGIC:
+            if base is None:
+                raise ValueError("Delta snapshot needs its base snapshot")
+            if int.from_bytes(snapshot[4:8], "big") != len(base):
+                raise ValueError("Delta snapshot does not match this base")
+            self.restore(base)
+            offset = 8
+        elif header == self._SNAPSHOT_MAGIC:
+            offset = 4
+        else:
             raise ValueError("Invalid snapshot format (bad header)")
 
         # Restore each component
-        offset = 4
+        offset += self.cpu.apply_snapshot_data(snapshot, offset)
+        offset += self.bus.apply_snapshot_data(snapshot, offset)
+        offset += self.display.apply_snapshot_data(snapshot, offset)
+        if header == self._DELTA_MAGIC:
+            offset += self._memory.apply_snapshot_delta(snapshot, offset)
+        else:
+            offset += self._memory.apply_snapshot_data(snapshot, offset)
 
-        # CPU state
-        offset += self.cpu.apply_snapshot_data(data, offset)
+        if bytes(snapshot[offset:offset + 4]) == self._EXTENSION_MAGIC:
+            offset += 4
+            offset += self.keyboard.apply_snapshot_data(snapshot, offset)
+            self._total_cycles = int.from_bytes(snapshot[offset:offset + 8], "big")
 
-        # Bus state
-        offset += self.bus.apply_snapshot_data(data, offset)
+        # Cached code no longer matches the restored RAM
+        if self._block_cache is not None:
+            self._block_cache.invalidate_all()
 
-        # Display state
-        offset += self.display.apply_snapshot_data(data, offset)
+    def capture_image(self) -> EmulatorImage:
+        """
+        Capture the complete emulator state.
+
+        Breakpoints and watchpoints are not part of the image.
+
+        Returns:
+            EmulatorImage that can be restored repeatedly or pickled
+        """
+        return EmulatorImage(
+            config=self.config,
+            snapshot=self.snapshot(),
+            packs=tuple(copy.deepcopy(pack) for pack in self._packs),
+        )
+
+    def load_image(self, image: EmulatorImage) -> None:
+        """
+        Put this emulator into a captured state.
+
+        The image should come from an emulator with the same model and ROM.
+        Breakpoints and watchpoints are kept.
+
+        Args:
+            image: Image from capture_image()
+        """
+        self.restore(image.snapshot)
+        for slot, pack in enumerate(image.packs):
+            pack = copy.deepcopy(pack)
+            self._packs[slot] = pack
+            self.bus.set_pack(pack, slot)
+
+    def fork(self) -> "Emulator":
+        """
+        Create an independent copy of this emulator in its current state.
 
-        # Memory state
-        offset += self._memory.apply_snapshot_data(data, offset)
+        Use this to boot once and run many tests from the same starting
+        point (see EmulatorPool).
+
+        Returns:
+            New Emulator with identical state
+
+        Example:
+            >>> emu.reset()
+            >>> emu.run(3_000_000)       # Boot
+            >>> copy = emu.fork()
+            >>> copy.tap_key("EXE")      # Does not affect emu
+        """
+        return self.capture_image().restore()
+
+    # =========================================================================
+    # Profiling
+    # =========================================================================
+
+    def start_profiling(
+        self,
+        symbols: Optional[Union[SymbolTable, str, Path]] = None,
+        load_address: Optional[int] = None
+    ) -> Profiler:
+        """
+        Start recording where execution spends its cycles.
+
+        While profiling, run() and step() use the profiling CPU loop
+        (the block cache is bypassed); cycle counts are unchanged.
+        Calling this again replaces the current profiler.
+
+        Args:
+            symbols: SymbolTable or path to a .dbg file for function names
+            load_address: Runtime address of relocatable code (when
+                          symbols is a .dbg path)
+
+        Returns:
+            The new Profiler
+
+        Example:
+            >>> profiler = emu.start_profiling("prog.dbg")
+            >>> emu.run(1_000_000)
+            >>> print(emu.stop_profiling().report_flat())
+        """
+        if symbols is not None and not isinstance(symbols, SymbolTable):
+            symbols = SymbolTable.from_debug_file(symbols, load_address)
+        self._profiler = Profiler(symbols)
+        self._profiler.attach(self.cpu)
+        return self._profiler
+
+    def stop_profiling(self) -> Optional[Profiler]:
+        """
+        Stop profiling.
+
+        Returns:
+            The profiler with its results, or None if not profiling
+        """
+        profiler = self._profiler
+        self._profiler = None
+        return profiler
+
+    @property
+    def profiler(self) -> Optional[Profiler]:
+        """Active profiler, or None when not profiling."""
+        return self._profiler
 
     # =========================================================================
     # Debug Helpers
@@ -1078,6 +1078,53 @@ class MCPServer:
             }
         )
 
+        self._register_tool(
+            "profile",
+            tools.profile,
+            "Cycle profiler: start it, run the program, then get flat, "
+            "call-graph or flamegraph (collapsed stacks) reports of where "
+            "the CPU cycles went",
+            {
+                "type": "object",
+                "properties": {
+                    "session_id": {
+                        "type": "string",
+                        "description": "Session ID"
+                    },
+                    "action": {
+                        "type": "string",
+                        "enum": ["start", "report", "stop"],
+                        "description": "start profiling, report results, or stop and report (default: report)",
+                        "default": "report"
+                    },
+                    "symbols_file": {
+                        "type": "string",
+                        "description": "start: debug symbol file (.dbg) for function names"
+                    },
+                    "load_address": {
+                        "type": "integer",
+                        "description": "start: load address of relocatable code (required for relocatable .dbg files)"
+                    },
+                    "format": {
+                        "type": "string",
+                        "enum": ["flat", "callgraph", "collapsed"],
+                        "description": "Report format (default: flat)",
+                        "default": "flat"
+                    },
+                    "limit": {
+                        "type": "integer",
+                        "description": "Rows per table (default: 30, max: 1000)",
+                        "default": 30
+                    },
+                    "output_file": {
+                        "type": "string",
+                        "description": "Optional: write the report to this file instead of returning it"
+                    }
+                },
+                "required": ["session_id"]
+            }
+        )
+
     def _register_tool(
         self,
         name: str,
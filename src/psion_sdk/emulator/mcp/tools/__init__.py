@@ -9,7 +9,7 @@ Tools are organized into logical modules:
 - execution: Running the emulator, stepping, waiting
 - display: Screen reading, keyboard input, screenshots
 - memory: Memory read/write/search operations
-- debugging: Breakpoints, disassembly, tracing, registers
+- debugging: Breakpoints, disassembly, tracing, profiling, registers
 
 Helper modules:
 - core: Result helpers (text_content, error_result, success_result)
@@ -98,6 +98,7 @@ from .debugging import (
     run_with_trace,
     step_with_disasm,
     get_opl_state,
+    profile,
 )
 
 # All public exports
@@ -155,4 +156,5 @@ __all__ = [
     "run_with_trace",
     "step_with_disasm",
     "get_opl_state",
+    "profile",
 ]
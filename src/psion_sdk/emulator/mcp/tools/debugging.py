@@ -2,13 +2,16 @@
 MCP Debugging Tools
 ===================
 
-Tools for breakpoints, disassembly, tracing, and register manipulation.
+Tools for breakpoints, disassembly, tracing, profiling, and register
+manipulation.
 
 Copyright (c) 2025 Hugo José Pinto & Contributors
 """
 
+from pathlib import Path
 from typing import Any, Dict
 
+from ...profiler import REPORT_FORMATS
 from ..server import SessionManager, ToolResult
 from .core import error_result, success_result
 from .decorators import mcp_tool, requires_session
@@ -769,3 +772,75 @@ async def get_opl_state(
         result_lines.append(f"  {name}: {desc}")
 
     return success_result('\n'.join(result_lines))
+
+
+@mcp_tool
+@requires_session
+async def profile(
+    session,
+    manager: SessionManager,
+    args: Dict[str, Any]
+) -> ToolResult:
+    """
+    Control the cycle profiler and get its reports.
+
+    Start the profiler, run the program with the execution tools, then ask
+    for a report. Reports show cycles per function (exclusive and
+    inclusive, via JSR/BSR/RTS tracking) and per instruction address.
+
+    Args:
+        session: Emulator session (injected by @requires_session)
+        manager: Session manager
+        args: {
+            "session_id": str,
+            "action": str,         # "start", "report" (default), or "stop"
+            "symbols_file": str,   # start: .dbg file for function names
+            "load_address": int|str,  # start: load address of relocatable code
+            "format": str,         # "flat" (default), "callgraph", "collapsed"
+            "limit": int,          # Rows per table (default: 30)
+            "output_file": str     # Optional: write the report to this file
+        }
+
+    Returns:
+        ToolResult with the report (report/stop) or confirmation (start)
+    """
+    action = args.get("action", "report").lower()
+    report_format = args.get("format", "flat").lower()
+    limit = args.get("limit", 30)
+
+    if report_format not in REPORT_FORMATS:
+        return error_result(
+            f"Unknown format: {report_format}. Use {', '.join(REPORT_FORMATS)}."
+        )
+    if limit < 1 or limit > 1000:
+        return error_result("limit must be 1-1000")
+
+    emu = session.emulator
+
+    if action == "start":
+        symbols_file = args.get("symbols_file")
+        load_address = None
+        if args.get("load_address") is not None:
+            load_address = parse_address(args.get("load_address"), "load_address")
+        profiler = emu.start_profiling(symbols_file, load_address)
+        msg = "Profiling started"
+        if profiler.symbols is not None:
+            msg += f" with {len(profiler.symbols)} symbols from {symbols_file}"
+        return success_result(msg)
+
+    if action not in ("report", "stop"):
+        return error_result(f"Unknown action: {action}. Use start, report, or stop.")
+
+    profiler = emu.stop_profiling() if action == "stop" else emu.profiler
+    if profiler is None:
+        return error_result("Profiler is not running (use action: start)")
+
+    report = profiler.report(report_format, limit)
+    output_file = args.get("output_file")
+    if output_file:
+        profiler.write_report(Path(output_file), report_format, limit)
+        return success_result(
+            f"Wrote {report_format} profile ({profiler.total_cycles:,} cycles) "
+            f"to {output_file}"
+        )
+    return success_result(report)
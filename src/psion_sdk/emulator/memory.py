@@ -25,7 +25,16 @@ Copyright (c) 2025 Hugo José Pinto & Contributors
 Ported from JAPE by Jaap Scherphuis
 """
 
-from typing import Optional
+from typing import Callable, List, Optional, Sequence, Tuple
+
+
+# Page map entry: (backing buffer, base) such that the byte at an address
+# in the page is buffer[base + address]
+PageEntry = Tuple[Sequence[int], int]
+
+# Pages $00-$03 hold processor registers, processor RAM and the
+# semi-custom chip. They are never mapped and always take the slow path.
+FIRST_MAPPED_PAGE = 0x04
 
 
 class Ram:
@@ -143,9 +152,36 @@ class Ram:
         """Reset to first RAM bank."""
         self._current_bank_index = self.BANK_ADDRESS
 
-    def get_snapshot_data(self) -> list[int]:
-        """Get RAM state for snapshot."""
-        result = [
+    @property
+    def current_bank(self) -> int:
+        """Offset into the RAM buffer of the bank mapped at $4000."""
+        return self._current_bank_index
+
+    def map_page(self, page: int) -> Optional[PageEntry]:
+        """
+        Page map entry for a 256-byte page at or above $0400.
+
+        Args:
+            page: Page number ($04-$7F)
+
+        Returns:
+            (buffer, base) for the current bank, or None if the page is
+            outside this RAM configuration
+        """
+        address = page << 8
+        if address < self._low_address or address >= self._high_address:
+            return None
+        if address < self.BANK_ADDRESS:
+            return (self._data, 0)
+        return (self._data, self._current_bank_index - self.BANK_ADDRESS)
+
+    # Snapshot layout: 7 header bytes, processor RAM, then main RAM from
+    # the low address to the end of the buffer (all banks)
+    SNAPSHOT_HEADER_SIZE = 7
+
+    def _snapshot_header(self) -> bytes:
+        """Size, bank and address range bytes that start a RAM snapshot."""
+        return bytes([
             len(self._data) // 1024,  # Size in KB
             (self._current_bank_index >> 8) & 0xFF,
             self._current_bank_index & 0xFF,
@@ -153,30 +189,141 @@ class Ram:
             self._low_address & 0xFF,
             (self._high_address >> 8) & 0xFF,
             self._high_address & 0xFF,
-        ]
-        # Processor RAM
-        result.extend(self._data[self.PROCESSOR_RAM_LOW:self.PROCESSOR_RAM_HIGH])
-        # Main RAM
-        result.extend(self._data[self._low_address:len(self._data)])
-        return result
+        ])
+
+    def get_snapshot_data(self) -> list[int]:
+        """Get RAM state for snapshot."""
+        out = bytearray()
+        self.snapshot_into(out)
+        return list(out)
+
+    def snapshot_into(self, out: bytearray) -> None:
+        """
+        Append RAM state to a snapshot buffer.
+
+        Same layout as get_snapshot_data(), copied as whole slices.
+
+        Args:
+            out: Buffer to extend
+        """
+        out += self._snapshot_header()
+        out += self._data[self.PROCESSOR_RAM_LOW:self.PROCESSOR_RAM_HIGH]
+        out += self._data[self._low_address:]
+
+    def apply_snapshot_data(self, data: Sequence[int], offset: int = 0) -> int:
+        """
+        Restore RAM state from snapshot.
+
+        Args:
+            data: Snapshot data (list of ints or any bytes-like object)
+            offset: Starting offset in data
 
-    def apply_snapshot_data(self, data: list[int], offset: int = 0) -> int:
-        """Restore RAM state from snapshot."""
-        size = data[offset]
-        self._data = bytearray(size * 1024)
+        Returns:
+            Number of bytes consumed
+        """
+        size = data[offset] * 1024
+        if len(self._data) != size:
+            self._data = bytearray(size)
         self._current_bank_index = (data[offset + 1] << 8) | data[offset + 2]
         self._low_address = (data[offset + 3] << 8) | data[offset + 4]
         self._high_address = (data[offset + 5] << 8) | data[offset + 6]
 
-        pos = offset + 7
+        pos = offset + self.SNAPSHOT_HEADER_SIZE
         # Processor RAM
-        for i in range(self.PROCESSOR_RAM_LOW, self.PROCESSOR_RAM_HIGH):
-            self._data[i] = data[pos]
-            pos += 1
+        count = self.PROCESSOR_RAM_HIGH - self.PROCESSOR_RAM_LOW
+        self._data[self.PROCESSOR_RAM_LOW:self.PROCESSOR_RAM_HIGH] = data[pos:pos + count]
+        pos += count
         # Main RAM
-        for i in range(self._low_address, len(self._data)):
-            self._data[i] = data[pos]
-            pos += 1
+        count = size - self._low_address
+        self._data[self._low_address:] = data[pos:pos + count]
+        pos += count
+
+        return pos - offset
+
+    def snapshot_delta_into(
+        self,
+        out: bytearray,
+        base: Sequence[int],
+        offset: int,
+        page_size: int = 0x100
+    ) -> None:
+        """
+        Append the RAM state as a delta against an earlier RAM snapshot.
+
+        Only main RAM pages that differ from the base are stored, each as
+        a 2-byte page number followed by its contents. Comparing slices
+        against the base means writes need no dirty tracking.
+
+        Args:
+            out: Buffer to extend
+            base: Full snapshot bytes containing a RAM snapshot
+            offset: Offset of the RAM snapshot within base
+            page_size: Granularity of the comparison in bytes
+
+        Raises:
+            ValueError: If the base was taken with a different RAM layout
+        """
+        header = self._snapshot_header()
+        size = len(self._data)
+        if bytes(base[offset:offset + 1]) != header[:1] or \
+                bytes(base[offset + 3:offset + 7]) != header[3:]:
+            raise ValueError("Base snapshot has a different RAM layout")
+
+        out += header
+        out += self._data[self.PROCESSOR_RAM_LOW:self.PROCESSOR_RAM_HIGH]
+
+        data = self._data
+        main = offset + self.SNAPSHOT_HEADER_SIZE + \
+            self.PROCESSOR_RAM_HIGH - self.PROCESSOR_RAM_LOW - self._low_address
+        pages = bytearray()
+        count = 0
+        # Skip unchanged regions a chunk at a time, then find the pages
+        chunk_size = page_size * 16
+        for chunk in range(self._low_address, size, chunk_size):
+            chunk_end = min(chunk + chunk_size, size)
+            if data[chunk:chunk_end] == base[main + chunk:main + chunk_end]:
+                continue
+            for start in range(chunk, chunk_end, page_size):
+                end = min(start + page_size, chunk_end)
+                if data[start:end] != base[main + start:main + end]:
+                    pages += (start // page_size).to_bytes(2, "big")
+                    pages += data[start:end]
+                    count += 1
+
+        out += page_size.to_bytes(2, "big")
+        out += count.to_bytes(2, "big")
+        out += pages
+
+    def apply_snapshot_delta(self, data: Sequence[int], offset: int = 0) -> int:
+        """
+        Apply a RAM delta from snapshot_delta_into().
+
+        The base snapshot must have been applied first.
+
+        Args:
+            data: Delta snapshot data
+            offset: Starting offset in data
+
+        Returns:
+            Number of bytes consumed
+        """
+        self._current_bank_index = (data[offset + 1] << 8) | data[offset + 2]
+
+        pos = offset + self.SNAPSHOT_HEADER_SIZE
+        count = self.PROCESSOR_RAM_HIGH - self.PROCESSOR_RAM_LOW
+        self._data[self.PROCESSOR_RAM_LOW:self.PROCESSOR_RAM_HIGH] = data[pos:pos + count]
+        pos += count
+
+        page_size = (data[pos] << 8) | data[pos + 1]
+        pages = (data[pos + 2] << 8) | data[pos + 3]
+        pos += 4
+        size = len(self._data)
+        for _ in range(pages):
+            start = ((data[pos] << 8) | data[pos + 1]) * page_size
+            end = min(start + page_size, size)
+            pos += 2
+            self._data[start:end] = data[pos:pos + end - start]
+            pos += end - start
 
         return pos - offset
 
@@ -249,6 +396,30 @@ class Rom:
         """Reset to first ROM bank."""
         self._current_bank_index = 0
 
+    @property
+    def current_bank(self) -> int:
+        """Offset into the ROM image of the bank mapped at $8000."""
+        return self._current_bank_index
+
+    def map_page(self, page: int) -> Optional[PageEntry]:
+        """
+        Page map entry for a 256-byte page of ROM.
+
+        Args:
+            page: Page number ($80-$FF)
+
+        Returns:
+            (buffer, base) for the current bank, or None if the page is not
+            fully backed by the ROM image
+        """
+        address = page << 8
+        index = address - self.LOW_ADDRESS
+        if index < self.BANK_SIZE and self._current_bank_index != 0:
+            index += self._current_bank_index
+        if index + 0x100 > self._size:
+            return None
+        return (self._data, index - address)
+
     def get_snapshot_data(self) -> list[int]:
         """Get ROM bank state for snapshot (doesn't save ROM data)."""
         return [
@@ -256,7 +427,7 @@ class Rom:
             self._current_bank_index & 0xFF,
         ]
 
-    def apply_snapshot_data(self, data: list[int], offset: int = 0) -> int:
+    def apply_snapshot_data(self, data: Sequence[int], offset: int = 0) -> int:
         """Restore ROM bank state from snapshot."""
         self._current_bank_index = (data[offset] << 8) | data[offset + 1]
         return 2
@@ -276,9 +447,18 @@ class Memory:
     Note: Processor registers ($00-$3F) and semi-custom chip ($100-$3FF)
     are handled by the Bus class, not Memory.
 
+    Accesses go through a 256-entry page map, one entry per 256-byte page,
+    pointing straight at the RAM buffer or ROM image for the current banks.
+    Bank switches only update the affected entries. Pages without an
+    entry (I/O pages, unpopulated RAM, ROM, pages holding cached code for
+    writes) fall back to the Ram/Rom range checks. The map lists are
+    updated in place, so the Bus can share them.
+
     Attributes:
         ram: Ram instance
         rom: Rom instance
+        read_pages: Page map used for reads
+        write_pages: Page map used for writes
     """
 
     def __init__(self, ram_size_kb: int, rom_data: Optional[bytes] = None):
@@ -292,6 +472,15 @@ class Memory:
         self.ram = Ram(ram_size_kb)
         self.rom = Rom(rom_data or bytes(0x8000))
 
+        # Pages holding translated code (see blocks.py). A write to a marked
+        # page is reported through on_code_write(address) before it lands.
+        self._code_pages = bytearray(256)
+        self.on_code_write: Optional[Callable[[int], None]] = None
+
+        self.read_pages: List[Optional[PageEntry]] = [None] * 256
+        self.write_pages: List[Optional[PageEntry]] = [None] * 256
+        self._map_pages(FIRST_MAPPED_PAGE, 0x100)
+
     def read(self, address: int) -> int:
         """
         Read byte from memory.
@@ -302,6 +491,14 @@ class Memory:
         Returns:
             Byte value at address
         """
+        try:
+            entry = self.read_pages[address >> 8]
+        except IndexError:
+            entry = None
+        if entry is not None:
+            buffer, base = entry
+            return buffer[base + address]
+
         if address >= 0x8000:
             return self.rom.read(address)
         return self.ram.read(address)
@@ -316,20 +513,82 @@ class Memory:
             address: 16-bit address
             value: Byte value to write
         """
+        try:
+            entry = self.write_pages[address >> 8]
+        except IndexError:
+            entry = None
+        if entry is not None:
+            buffer, base = entry
+            buffer[base + address] = value & 0xFF
+            return
+
+        if self._code_pages[(address >> 8) & 0xFF] and self.on_code_write:
+            self.on_code_write(address)
         self.ram.write(address, value)
 
     def next_ram(self) -> None:
         """Switch to next RAM bank."""
         self.ram.next_bank()
+        self._map_pages(Ram.BANK_ADDRESS >> 8, 0x80)
 
     def next_rom(self) -> None:
         """Switch to next ROM bank."""
         self.rom.next_bank()
+        self._map_pages(0x80, 0xC0)
 
     def reset_bank(self) -> None:
         """Reset all memory banks to initial state."""
         self.ram.reset_bank()
         self.rom.reset_bank()
+        self._map_pages(FIRST_MAPPED_PAGE, 0x100)
+
+    def _map_pages(self, first: int, last: int) -> None:
+        """
+        Recompute the page map entries for a range of pages.
+
+        Args:
+            first: First page
+            last: One past the last page
+        """
+        for page in range(max(first, FIRST_MAPPED_PAGE), last):
+            if page < 0x80:
+                entry = self.ram.map_page(page)
+                self.read_pages[page] = entry
+                self.write_pages[page] = None if self._code_pages[page] else entry
+            else:
+                self.read_pages[page] = self.rom.map_page(page)
+
+    def bank_at(self, address: int) -> int:
+        """
+        Identify the bank currently mapped at an address.
+
+        Returns the ROM bank offset for $8000-$BFFF, the RAM bank offset for
+        $4000-$7FFF, and 0 for the unbanked regions. Used to key cached code
+        so that the same address in different banks is kept apart.
+        """
+        if 0x8000 <= address < 0xC000:
+            return self.rom.current_bank
+        if 0x4000 <= address < 0x8000:
+            return self.ram.current_bank
+        return 0
+
+    def mark_code_page(self, page: int) -> None:
+        """Report writes to a 256-byte page through on_code_write."""
+        page &= 0xFF
+        self._code_pages[page] = 1
+        # Route writes through the slow path, which does the reporting
+        self.write_pages[page] = None
+
+    def clear_code_page(self, page: int) -> None:
+        """Stop reporting writes to a 256-byte page."""
+        page &= 0xFF
+        self._code_pages[page] = 0
+        self._map_pages(page, page + 1)
+
+    def clear_code_pages(self) -> None:
+        """Stop reporting writes to any page."""
+        self._code_pages = bytearray(256)
+        self._map_pages(FIRST_MAPPED_PAGE, 0x80)
 
     def get_snapshot_data(self) -> list[int]:
         """Get complete memory state for snapshot."""
@@ -338,10 +597,36 @@ class Memory:
         result.extend(self.ram.get_snapshot_data())
         return result
 
-    def apply_snapshot_data(self, data: list[int], offset: int = 0) -> int:
+    def snapshot_into(self, out: bytearray) -> None:
+        """Append complete memory state to a snapshot buffer."""
+        out += bytes(self.rom.get_snapshot_data())
+        self.ram.snapshot_into(out)
+
+    def apply_snapshot_data(self, data: Sequence[int], offset: int = 0) -> int:
         """Restore memory state from snapshot."""
         consumed = self.rom.apply_snapshot_data(data, offset)
         consumed += self.ram.apply_snapshot_data(data, offset + consumed)
+        self._map_pages(FIRST_MAPPED_PAGE, 0x100)
+        return consumed
+
+    def snapshot_delta_into(self, out: bytearray, base: Sequence[int], offset: int) -> None:
+        """
+        Append memory state as a delta against an earlier snapshot.
+
+        Args:
+            out: Buffer to extend
+            base: Full snapshot data
+            offset: Offset of the memory state within base
+        """
+        rom_data = self.rom.get_snapshot_data()
+        out += bytes(rom_data)
+        self.ram.snapshot_delta_into(out, base, offset + len(rom_data))
+
+    def apply_snapshot_delta(self, data: Sequence[int], offset: int = 0) -> int:
+        """Apply a memory delta on top of its (already applied) base."""
+        consumed = self.rom.apply_snapshot_data(data, offset)
+        consumed += self.ram.apply_snapshot_delta(data, offset + consumed)
+        self._map_pages(FIRST_MAPPED_PAGE, 0x100)
         return consumed
 
     def is_ready(self) -> bool:
@@ -0,0 +1,158 @@
+"""
+Emulator Pool for the Psion Organiser II Emulator
+==================================================
+
+Boot once, fork many. An EmulatorPool brings a template emulator to a
+starting state (typically booted to the main menu) a single time, captures
+it as an EmulatorImage, and hands out independent copies in that state.
+Forking costs a RAM copy instead of millions of emulated boot cycles.
+
+Work can also be spread across worker processes with map(). Each worker
+restores the image once; on platforms with fork() the captured image is
+shared copy-on-write with the parent rather than re-sent per task.
+
+Example:
+    >>> pool = EmulatorPool(EmulatorConfig(model="XP"), prepare=boot)
+    >>> emu = pool.fork()                      # Pre-booted, independent
+    >>> results = pool.map(run_case, cases)    # One fork per case
+
+Copyright (c) 2025 Hugo José Pinto & Contributors
+"""
+
+import multiprocessing
+import os
+from typing import Any, Callable, Iterable, List, Optional, Tuple, TypeVar
+
+from .emulator import Emulator, EmulatorConfig, EmulatorImage
+
+
+T = TypeVar("T")
+R = TypeVar("R")
+
+# Image restored by each worker process (set by _init_worker)
+_worker_image: Optional[EmulatorImage] = None
+
+
+def _init_worker(image: EmulatorImage) -> None:
+    """Worker process initializer: keep the pool image for all tasks."""
+    global _worker_image
+    _worker_image = image
+
+
+def _run_task(task: Tuple[Callable[[Emulator, Any], Any], Any]) -> Any:
+    """Run one map() task on a fresh fork inside a worker process."""
+    func, item = task
+    return func(_worker_image.restore(), item)
+
+
+class EmulatorPool:
+    """
+    Source of pre-initialized, independent emulator instances.
+
+    The template is created lazily on first use: a new Emulator is reset,
+    passed to the prepare callback (e.g. to run the boot sequence), and
+    captured. Every fork() restores that capture into a new Emulator.
+
+    Attributes:
+        config: Configuration used for the template and all forks
+        boots: Number of times the template has been prepared (0 or 1)
+        forks: Number of emulators handed out in this process
+    """
+
+    def __init__(
+        self,
+        config: Optional[EmulatorConfig] = None,
+        prepare: Optional[Callable[[Emulator], None]] = None
+    ):
+        """
+        Initialize pool.
+
+        Args:
+            config: Emulator configuration (default XP)
+            prepare: Called once with the reset template emulator to bring
+                     it to the state forks start from. If None, forks
+                     start just after reset.
+        """
+        self.config = config or EmulatorConfig()
+        self._prepare = prepare
+        self._image: Optional[EmulatorImage] = None
+        self.boots = 0
+        self.forks = 0
+
+    @classmethod
+    def from_emulator(cls, emulator: Emulator) -> "EmulatorPool":
+        """
+        Create a pool whose forks start from an emulator's current state.
+
+        Args:
+            emulator: Emulator to capture (not modified)
+
+        Returns:
+            EmulatorPool sharing the emulator's configuration
+        """
+        pool = cls(emulator.config)
+        pool._image = emulator.capture_image()
+        return pool
+
+    @property
+    def image(self) -> EmulatorImage:
+        """Captured template state, preparing the template on first use."""
+        if self._image is None:
+            template = Emulator(self.config)
+            template.reset()
+            if self._prepare is not None:
+                self._prepare(template)
+            self.boots += 1
+            self._image = template.capture_image()
+        return self._image
+
+    def fork(self) -> Emulator:
+        """
+        Get a new emulator in the template state.
+
+        Returns:
+            Independent Emulator instance
+        """
+        emulator = self.image.restore()
+        self.forks += 1
+        return emulator
+
+    def map(
+        self,
+        func: Callable[[Emulator, T], R],
+        items: Iterable[T],
+        processes: Optional[int] = None
+    ) -> List[R]:
+        """
+        Run func(fork, item) for each item, each on its own fork.
+
+        With more than one process, items are distributed over a
+        multiprocessing pool. func, items and results must then be
+        picklable (func defined at module level).
+
+        Args:
+            func: Called with a fresh fork and one item
+            items: Work items
+            processes: Worker processes (default os.cpu_count(); 1 runs
+                       everything in this process)
+
+        Returns:
+            Results in item order
+        """
+        items = list(items)
+        if processes is None:
+            processes = os.cpu_count() or 1
+        processes = min(processes, len(items))
+
+        if processes <= 1:
+            return [func(self.fork(), item) for item in items]
+
+        image = self.image
+        methods = multiprocessing.get_all_start_methods()
+        context = multiprocessing.get_context("fork" if "fork" in methods else None)
+        with context.Pool(processes, initializer=_init_worker, initargs=(image,)) as workers:
+            return workers.map(_run_task, [(func, item) for item in items])
+
+    def __repr__(self) -> str:
+        state = "ready" if self._image is not None else "not booted"
+        return f"EmulatorPool(model={self.config.model}, {state}, forks={self.forks})"
@@ -0,0 +1,555 @@
+"""
+Cycle Profiler for the Psion Organiser II Emulator
+==================================================
+
+Records where emulated code spends its CPU cycles, per instruction address
+and per function, so programs can be tuned for the real Organiser.
+
+Functions are identified by call target. Every JSR/BSR opens a frame, as
+do SWI system calls and NMI/OCI interrupts; a frame closes when the stack
+pointer rises above its return address (RTS, RTI, or code that pops its
+return address). Cycles are charged to the call stack that was
+current when they were spent, which gives:
+
+- Exclusive cycles: spent in the function itself
+- Inclusive cycles: spent in the function and everything it called
+- Call graph edges with call counts and inclusive cycles
+- Collapsed stacks for flamegraph tools (flamegraph.pl, speedscope)
+
+Function names come from the assembler's debug symbol file (.dbg, written
+with psasm -g or psbuild -g). Without symbols, functions are shown by
+address.
+
+Profiling is done by a separate CPU loop (HD6303.execute_profiled), so it
+costs nothing while disabled.
+
+Example:
+    >>> profiler = emu.start_profiling("myprog.dbg")
+    >>> emu.run(5_000_000)
+    >>> print(profiler.report_flat())
+    >>> Path("myprog.folded").write_text(profiler.report_collapsed())
+
+Copyright (c) 2025 Hugo José Pinto & Contributors
+"""
+
+from bisect import bisect_right
+from dataclasses import dataclass
+from pathlib import Path
+from typing import Callable, Dict, Iterable, List, Optional, Tuple, Union
+
+
+# JSR direct/indexed/extended and BSR
+CALL_OPCODES = frozenset({0x9D, 0xAD, 0xBD, 0x8D})
+SWI_OPCODE = 0x3F
+
+# Frame ids: call targets are plain addresses, system calls and interrupts
+# are offset so they never collide with code addresses
+ROOT_FRAME = -1
+SWI_FRAME = 0x10000      # + service number
+INTERRUPT_FRAME = 0x20000  # + vector address
+
+# SWI and interrupts push 7 bytes (PC, X, A, B, CCR). Their frames stay
+# open until SP passes the pushed PC, like a JSR frame, so handlers that
+# drop the saved registers and jump to a service routine still count.
+EXCEPTION_FRAME_SLACK = 5
+
+INTERRUPT_NAMES = {
+    0xFFFC: "<NMI>",
+    0xFFF4: "<OCI>",
+}
+
+REPORT_FORMATS = ("flat", "callgraph", "collapsed")
+
+
+# =============================================================================
+# Symbols
+# =============================================================================
+
+class SymbolTable:
+    """
+    Code symbols for naming profiled addresses.
+
+    Attributes:
+        symbols: Sorted list of (address, name)
+    """
+
+    def __init__(self, symbols: Iterable[Tuple[int, str]] = ()):
+        """
+        Initialize symbol table.
+
+        Args:
+            symbols: (address, name) pairs; the first name seen for an
+                     address wins
+        """
+        by_address: Dict[int, str] = {}
+        for address, name in symbols:
+            by_address.setdefault(address & 0xFFFF, name)
+        self.symbols: List[Tuple[int, str]] = sorted(by_address.items())
+        self._addresses = [address for address, _ in self.symbols]
+        self._names = dict(self.symbols)
+
+    @classmethod
+    def parse(cls, text: str, load_address: Optional[int] = None) -> "SymbolTable":
+        """
+        Read CODE symbols from debug file contents.
+
+        Args:
+            text: Contents of a .dbg file
+            load_address: Runtime address of relocatable code
+
+        Returns:
+            SymbolTable
+
+        Raises:
+            ValueError: If the code is relocatable and no load address
+                        was given
+        """
+        relocatable = False
+        section = None
+        symbols = []
+
+        for line in text.splitlines():
+            line = line.strip()
+            if not line or line.startswith('#'):
+                continue
+            if line.startswith('['):
+                section = line
+                continue
+            parts = line.split()
+            if section is None and parts[0] == 'RELOCATABLE' and len(parts) > 1:
+                relocatable = parts[1].lower() == 'true'
+            elif section == '[SYMBOLS]' and len(parts) >= 3 and parts[2] == 'CODE':
+                symbols.append((int(parts[1].lstrip('$'), 16), parts[0]))
+
+        if relocatable:
+            if load_address is None:
+                raise ValueError("Relocatable debug symbols need a load address")
+            symbols = [(address + load_address, name) for address, name in symbols]
+
+        return cls(symbols)
+
+    @classmethod
+    def from_debug_file(
+        cls,
+        path: Union[str, Path],
+        load_address: Optional[int] = None
+    ) -> "SymbolTable":
+        """
+        Load CODE symbols from a .dbg file.
+
+        Args:
+            path: Debug symbol file from psasm -g / psbuild -g
+            load_address: Runtime address of relocatable code
+
+        Returns:
+            SymbolTable
+        """
+        return cls.parse(Path(path).read_text(encoding="utf-8"), load_address)
+
+    def name_at(self, address: int) -> str:
+        """
+        Name for an address: symbol, symbol+offset, or $hex.
+
+        Args:
+            address: 16-bit address
+
+        Returns:
+            Display name
+        """
+        name = self._names.get(address)
+        if name is not None:
+            return name
+        index = bisect_right(self._addresses, address) - 1
+        if index >= 0:
+            base, name = self.symbols[index]
+            return f"{name}+{address - base}"
+        return f"${address:04X}"
+
+    def __len__(self) -> int:
+        return len(self.symbols)
+
+
+# =============================================================================
+# Results
+# =============================================================================
+
+@dataclass
+class FunctionProfile:
+    """
+    Cycle totals for one function (frame id).
+
+    Attributes:
+        frame: Call target address, or a SWI/interrupt/root frame id
+        name: Display name
+        calls: Number of times the function was entered
+        inclusive: Cycles in the function and its callees
+        exclusive: Cycles in the function itself
+    """
+    frame: int
+    name: str
+    calls: int
+    inclusive: int
+    exclusive: int
+
+
+# =============================================================================
+# Profiler
+# =============================================================================
+
+class Profiler:
+    """
+    Cycle profiler fed by HD6303.execute_profiled().
+
+    Attributes:
+        symbols: Symbol table used for names (may be None)
+        pc_cycles: Cycles spent per instruction address (65536 entries)
+        pc_counts: Instructions executed per address (65536 entries)
+        stack_cycles: Exclusive cycles per call stack (tuple of frame ids)
+        call_counts: Calls per (caller, callee) frame pair
+    """
+
+    def __init__(self, symbols: Optional[SymbolTable] = None):
+        """
+        Initialize profiler.
+
+        Args:
+            symbols: Symbol table for function names
+        """
+        self.symbols = symbols
+        self._state = None
+        self._read: Optional[Callable[[int], int]] = None
+
+        # Shadow call stack: frame ids, and the SP each frame was entered
+        # with (the innermost one in _top_sp)
+        self._stack: Tuple[int, ...] = ()
+        self._stack_sps: List[int] = []
+        self._top_sp = 0x10000
+
+        self.reset()
+
+    def reset(self) -> None:
+        """Discard all samples (the current call stack is kept)."""
+        self.pc_cycles: List[int] = [0] * 0x10000
+        self.pc_counts: List[int] = [0] * 0x10000
+        self.stack_cycles: Dict[Tuple[int, ...], int] = {}
+        self.call_counts: Dict[Tuple[int, int], int] = {}
+        self._pending = 0
+
+    def attach(self, cpu) -> None:
+        """
+        Connect to the CPU whose execution is recorded.
+
+        Args:
+            cpu: HD6303 instance (its state and bus are read)
+        """
+        self._state = cpu.state
+        self._read = cpu.bus.read
+
+    # =========================================================================
+    # Recording (called from the CPU loop)
+    # =========================================================================
+
+    def record(self, pc: int, opcode: int, cycles: int) -> None:
+        """
+        Record one executed instruction.
+
+        Args:
+            pc: Address of the instruction
+            opcode: Its opcode
+            cycles: Cycles it took
+        """
+        self.pc_cycles[pc] += cycles
+        self.pc_counts[pc] += 1
+        self._pending += cycles
+
+        sp = self._state.sp
+        if opcode in CALL_OPCODES:
+            self._push(self._state.pc, sp)
+        elif opcode == SWI_OPCODE:
+            self._push(
+                SWI_FRAME + (self._read((pc + 1) & 0xFFFF) & 0xFF),
+                sp + EXCEPTION_FRAME_SLACK
+            )
+        elif sp > self._top_sp:
+            self._unwind(sp)
+
+    def interrupt(self, vector: int, cycles: int) -> None:
+        """
+        Record an interrupt being taken.
+
+        Args:
+            vector: Interrupt vector address
+            cycles: Cycles taken by the interrupt entry
+        """
+        self._push(INTERRUPT_FRAME + vector, self._state.sp + EXCEPTION_FRAME_SLACK)
+        self._pending += cycles
+
+    def _flush(self) -> None:
+        """Charge pending cycles to the current stack."""
+        if self._pending:
+            stack = self._stack
+            self.stack_cycles[stack] = self.stack_cycles.get(stack, 0) + self._pending
+            self._pending = 0
+
+    def _push(self, frame: int, sp: int) -> None:
+        """Enter a frame whose stack pointer on entry is sp."""
+        self._flush()
+        caller = self._stack[-1] if self._stack else ROOT_FRAME
+        edge = (caller, frame)
+        self.call_counts[edge] = self.call_counts.get(edge, 0) + 1
+        self._stack_sps.append(self._top_sp)
+        self._top_sp = sp
+        self._stack = self._stack + (frame,)
+
+    def _unwind(self, sp: int) -> None:
+        """Leave every frame the stack pointer has risen above."""
+        self._flush()
+        while self._stack and sp > self._top_sp:
+            self._stack = self._stack[:-1]
+            self._top_sp = self._stack_sps.pop()
+
+    # =========================================================================
+    # Results
+    # =========================================================================
+
+    @property
+    def total_cycles(self) -> int:
+        """Total cycles recorded."""
+        self._flush()
+        return sum(self.stack_cycles.values())
+
+    def frame_name(self, frame: int) -> str:
+        """
+        Display name for a frame id.
+
+        Args:
+            frame: Frame id from a call stack
+
+        Returns:
+            Function, system call or interrupt name
+        """
+        if frame == ROOT_FRAME:
+            return "<root>"
+        if frame >= INTERRUPT_FRAME:
+            vector = frame - INTERRUPT_FRAME
+            return INTERRUPT_NAMES.get(vector, f"<IRQ ${vector:04X}>")
+        if frame >= SWI_FRAME:
+            return f"<SWI ${frame - SWI_FRAME:02X}>"
+        if self.symbols is not None:
+            return self.symbols.name_at(frame)
+        return f"${frame:04X}"
+
+    def functions(self) -> List[FunctionProfile]:
+        """
+        Per-function totals, most exclusive cycles first.
+
+        Returns:
+            List of FunctionProfile (includes <root> for cycles outside
+            any call recorded since profiling started)
+        """
+        self._flush()
+        inclusive: Dict[int, int] = {}
+        exclusive: Dict[int, int] = {}
+        for stack, cycles in self.stack_cycles.items():
+            frames = (ROOT_FRAME,) + stack
+            leaf = frames[-1]
+            exclusive[leaf] = exclusive.get(leaf, 0) + cycles
+            for frame in set(frames):
+                inclusive[frame] = inclusive.get(frame, 0) + cycles
+
+        calls: Dict[int, int] = {}
+        for (_, callee), count in self.call_counts.items():
+            calls[callee] = calls.get(callee, 0) + count
+
+        result = [
+            FunctionProfile(
+                frame=frame,
+                name=self.frame_name(frame),
+                calls=calls.get(frame, 0),
+                inclusive=cycles,
+                exclusive=exclusive.get(frame, 0),
+            )
+            for frame, cycles in inclusive.items()
+        ]
+        result.sort(key=lambda f: (-f.exclusive, -f.inclusive, f.name))
+        return result
+
+    def edges(self) -> Dict[Tuple[int, int], int]:
+        """
+        Inclusive cycles per (caller, callee) edge.
+
+        Returns:
+            Dict mapping (caller, callee) frame ids to cycles spent in the
+            callee (and below) when called from the caller
+        """
+        self._flush()
+        result: Dict[Tuple[int, int], int] = {}
+        for stack, cycles in self.stack_cycles.items():
+            frames = (ROOT_FRAME,) + stack
+            for edge in set(zip(frames, frames[1:])):
+                result[edge] = result.get(edge, 0) + cycles
+        return result
+
+    def hot_addresses(self, limit: int = 20) -> List[Tuple[int, int, int]]:
+        """
+        Instruction addresses with the most cycles.
+
+        Args:
+            limit: Maximum entries
+
+        Returns:
+            List of (address, cycles, executions)
+        """
+        pc_cycles = self.pc_cycles
+        hot = sorted(
+            (address for address in range(0x10000) if pc_cycles[address]),
+            key=lambda address: -pc_cycles[address]
+        )[:limit]
+        return [(address, pc_cycles[address], self.pc_counts[address]) for address in hot]
+
+    def _address_name(self, address: int) -> str:
+        """Name for an instruction address."""
+        if self.symbols is not None and len(self.symbols):
+            return self.symbols.name_at(address)
+        return f"${address:04X}"
+
+    # =========================================================================
+    # Reports
+    # =========================================================================
+
+    def report_flat(self, limit: int = 30) -> str:
+        """
+        Flat profile: functions by exclusive cycles, then hot addresses.
+
+        Args:
+            limit: Maximum rows per table
+
+        Returns:
+            Report text
+        """
+        total = self.total_cycles or 1
+        lines = [
+            f"Flat profile ({self.total_cycles:,} cycles)",
+            "",
+            f"{'exclusive':>12} {'%':>6} {'inclusive':>12} {'%':>6} {'calls':>8}  function",
+        ]
+        for func in self.functions()[:limit]:
+            lines.append(
+                f"{func.exclusive:>12,} {100 * func.exclusive / total:>5.1f}% "
+                f"{func.inclusive:>12,} {100 * func.inclusive / total:>5.1f}% "
+                f"{func.calls:>8,}  {func.name}"
+            )
+
+        lines += [
+            "",
+            f"{'cycles':>12} {'%':>6} {'count':>10}  address",
+        ]
+        for address, cycles, count in self.hot_addresses(limit):
+            lines.append(
+                f"{cycles:>12,} {100 * cycles / total:>5.1f}% {count:>10,}  "
+                f"${address:04X} {self._address_name(address)}"
+            )
+        return "\n".join(lines)
+
+    def report_callgraph(self, limit: int = 30) -> str:
+        """
+        Call graph: each function with its callers and callees.
+
+        Args:
+            limit: Maximum functions shown (by inclusive cycles)
+
+        Returns:
+            Report text
+        """
+        total = self.total_cycles or 1
+        edges = self.edges()
+        functions = sorted(self.functions(), key=lambda f: (-f.inclusive, f.name))
+
+        lines = [f"Call graph ({self.total_cycles:,} cycles)"]
+        for func in functions[:limit]:
+            lines += [
+                "",
+                f"{func.name}: {func.inclusive:,} inclusive "
+                f"({100 * func.inclusive / total:.1f}%), "
+                f"{func.exclusive:,} exclusive, {func.calls:,} calls",
+            ]
+            callers = sorted(
+                ((caller, cycles) for (caller, callee), cycles in edges.items()
+                 if callee == func.frame),
+                key=lambda item: -item[1]
+            )
+            for caller, cycles in callers:
+                calls = self.call_counts.get((caller, func.frame), 0)
+                lines.append(
+                    f"    <- {self.frame_name(caller)}: {cycles:,} cycles, {calls:,} calls"
+                )
+            callees = sorted(
+                ((callee, cycles) for (caller, callee), cycles in edges.items()
+                 if caller == func.frame),
+                key=lambda item: -item[1]
+            )
+            for callee, cycles in callees:
+                calls = self.call_counts.get((func.frame, callee), 0)
+                lines.append(
+                    f"    -> {self.frame_name(callee)}: {cycles:,} cycles, {calls:,} calls"
+                )
+        return "\n".join(lines)
+
+    def report_collapsed(self) -> str:
+        """
+        Collapsed stacks ("root;caller;callee cycles" per line).
+
+        Input format for flamegraph.pl, inferno and speedscope.
+
+        Returns:
+            Report text
+        """
+        self._flush()
+        lines = []
+        for stack, cycles in self.stack_cycles.items():
+            names = [self.frame_name(ROOT_FRAME)]
+            names += [self.frame_name(frame) for frame in stack]
+            lines.append(f"{';'.join(names)} {cycles}")
+        lines.sort()
+        return "\n".join(lines)
+
+    def report(self, format: str = "flat", limit: int = 30) -> str:
+        """
+        Report in the given format.
+
+        Args:
+            format: "flat", "callgraph" or "collapsed"
+            limit: Maximum rows (flat and callgraph)
+
+        Returns:
+            Report text
+
+        Raises:
+            ValueError: For an unknown format
+        """
+        if format == "flat":
+            return self.report_flat(limit)
+        if format == "callgraph":
+            return self.report_callgraph(limit)
+        if format == "collapsed":
+            return self.report_collapsed()
+        raise ValueError(f"Unknown report format: {format} (use {', '.join(REPORT_FORMATS)})")
+
+    def write_report(
+        self,
+        path: Union[str, Path],
+        format: str = "flat",
+        limit: int = 30
+    ) -> None:
+        """
+        Write a report to a file.
+
+        Args:
+            path: Output file
+            format: "flat", "callgraph" or "collapsed"
+            limit: Maximum rows (flat and callgraph)
+        """
+        Path(path).write_text(self.report(format, limit) + "\n", encoding="utf-8")
+
+    def __repr__(self) -> str:
+        return f"Profiler(cycles={self.total_cycles:,}, stacks={len(self.stack_cycles)})"
@@ -18,6 +18,7 @@ This module provides:
 - **PackBuilder**: Create new OPK files from object code or OB3 files
 - **PackParser**: Read and extract contents from existing OPK files
 - **OB3File**: Work with individual object files
+- **Data files**: Ship data files already filled from CSV or JSON tables
 - **Record types**: Data structures for procedures, data files, etc.
 - **Checksum utilities**: Validate and calculate pack checksums
 
@@ -108,6 +109,9 @@ from psion_sdk.opk.checksum import (
 # Parser classes and functions
 from psion_sdk.opk.parser import (
     PackParser,
+    RecordChecksum,
+    PackDelta,
+    compare_records,
     validate_ob3,
     parse_ob3,
     parse_ob3_file,
@@ -115,6 +119,13 @@ from psion_sdk.opk.parser import (
     parse_opk_file,
 )
 
+# Data file import (CSV/JSON tables to data file records)
+from psion_sdk.opk.datafile import (
+    encode_record,
+    read_table,
+    is_table_file,
+)
+
 # Builder classes and functions
 from psion_sdk.opk.builder import (
     PackBuilder,
@@ -164,11 +175,18 @@ __all__ = [
     "validate_opk_length",
     # Parser
     "PackParser",
+    "RecordChecksum",
+    "PackDelta",
+    "compare_records",
     "validate_ob3",
     "parse_ob3",
     "parse_ob3_file",
     "parse_opk",
     "parse_opk_file",
+    # Data file import
+    "encode_record",
+    "read_table",
+    "is_table_file",
     # Builder
     "PackBuilder",
     "validate_procedure_name",
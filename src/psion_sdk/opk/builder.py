@@ -25,9 +25,15 @@ Adding a procedure directly:
     >>> builder.add_procedure("TEST", bytes([0x86, 0x41, 0x39]))  # LDAA #$41; RTS
     >>> opk_data = builder.build()
 
+Shipping a data file already filled (from a CSV or JSON table, or rows):
+
+    >>> builder.import_data_file("contacts.csv")         # File CONTACTS
+    >>> builder.add_data_file("CODES", [("A1", 10), ("B2", 20)])
+
 Features
 --------
 - Support for multiple procedures per pack
+- Data files written with their records (see opk/datafile.py)
 - Automatic checksum calculation
 - Size validation to prevent overflow
 - Multiple pack types (Datapak, Rampak, Flashpak)
@@ -41,7 +47,7 @@ Reference
 from dataclasses import dataclass, field
 from datetime import datetime
 from pathlib import Path
-from typing import Optional, Union
+from typing import Any, Iterable, Optional, Sequence, Union
 import logging
 import re
 
@@ -62,6 +68,7 @@ from psion_sdk.opk.checksum import (
     create_opk_header,
 )
 from psion_sdk.opk.parser import validate_ob3, parse_ob3
+from psion_sdk.opk.datafile import encode_record, read_table
 
 # Logger for this module
 logger = logging.getLogger(__name__)
@@ -74,6 +81,11 @@ logger = logging.getLogger(__name__)
 # Valid procedure/file name pattern: 1-8 alphanumeric, starts with letter
 NAME_PATTERN = re.compile(r"^[A-Za-z][A-Za-z0-9]{0,7}$")
 
+# Record types of data files: $90 is MAIN's, the others are given out in
+# order, as the Organiser does when it creates files
+FIRST_FILE_ID = 0x91
+LAST_FILE_ID = 0xFE
+
 
 def validate_procedure_name(name: str) -> bool:
     """
@@ -305,6 +317,108 @@ class PackBuilder:
         ob3 = parse_ob3(data)
         return self.add_procedure(name, ob3.object_code, ob3.source_code)
 
+    def add_data_file(
+        self,
+        name: str,
+        records: Iterable[Union[Sequence[Any], str, bytes]] = (),
+        file_id: Optional[int] = None,
+    ) -> "PackBuilder":
+        """
+        Add a data file and its records to the pack.
+
+        The records are written in the on-pack format db.h and OPL use:
+        fields joined by TAB, numbers as decimal text (see
+        opk/datafile.py). On the Organiser the file is ready to open
+        with db_open() or OPEN, with the schema listing the fields in
+        the same order.
+
+        Args:
+            name: File name (1-8 alphanumeric, starts with letter)
+            records: One entry per record: a sequence of field values,
+                     or the record text with the fields already joined
+            file_id: Record type of the file's records ($91-$FE; default:
+                     the next free one)
+
+        Returns:
+            Self for method chaining
+
+        Raises:
+            OPKError: If the name is invalid or taken, the record type is
+                      invalid or taken, or a record cannot be stored
+
+        Example:
+            >>> builder.add_data_file("CODES", [("A1", 10), ("B2", 20)])
+        """
+        name = name.upper()
+        if not validate_procedure_name(name):
+            raise OPKError(
+                f"Invalid data file name '{name}': must be 1-8 alphanumeric "
+                f"characters starting with a letter"
+            )
+
+        data_files = [r for r in self._records if isinstance(r, DataFileRecord)]
+        if any(r.name == name.ljust(8) for r in data_files):
+            raise OPKError(f"Duplicate data file name: {name}")
+
+        used_ids = {r.file_id for r in data_files}
+        if file_id is None:
+            file_id = next(
+                (i for i in range(FIRST_FILE_ID, LAST_FILE_ID + 1) if i not in used_ids),
+                None,
+            )
+            if file_id is None:
+                raise OPKError("Too many data files in one pack")
+        elif not FIRST_FILE_ID <= file_id <= LAST_FILE_ID or file_id in used_ids:
+            raise OPKError(f"Invalid or duplicate record type 0x{file_id:02X} for {name}")
+
+        # Encode everything before adding anything, so an error leaves
+        # the builder unchanged
+        encoded = []
+        for number, fields in enumerate(records, 1):
+            try:
+                encoded.append(encode_record(fields))
+            except OPKError as e:
+                raise OPKError(f"{name} record {number}: {e}") from None
+
+        self._records.append(DataFileRecord(name=name, file_id=file_id))
+        self._records.extend(DataRecord(record_type=file_id, data=data) for data in encoded)
+
+        logger.debug(f"Added data file '{name}' ({len(encoded)} records, type 0x{file_id:02X})")
+        return self
+
+    def import_data_file(
+        self,
+        filepath: Union[str, Path],
+        name: Optional[str] = None,
+        header: bool = True,
+    ) -> "PackBuilder":
+        """
+        Add a data file with the records of a CSV or JSON table.
+
+        The file name is derived from the filename if not provided. See
+        opk/datafile.py for the table formats.
+
+        Args:
+            filepath: Path to a .csv or .json file
+            name: Optional name override (defaults to filename stem)
+            header: CSV only: True if the first row names the fields
+
+        Returns:
+            Self for method chaining
+
+        Raises:
+            FileNotFoundError: If the file doesn't exist
+            OPKError: If the table cannot be read or stored
+
+        Example:
+            >>> builder.import_data_file("contacts.csv")        # Name = "CONTACTS"
+            >>> builder.import_data_file("stock.json", "ITEMS")  # Name = "ITEMS"
+        """
+        filepath = Path(filepath)
+        if name is None:
+            name = filepath.stem.upper()[:8]
+        return self.add_data_file(name, read_table(filepath, header=header))
+
     def add_record(self, record: PackRecord) -> "PackBuilder":
         """
         Add a generic record to the pack.
@@ -348,6 +462,10 @@ class PackBuilder:
         """Get the number of procedure records."""
         return sum(1 for r in self._records if isinstance(r, ProcedureRecord))
 
+    def get_data_file_count(self) -> int:
+        """Get the number of data files added (MAIN not included)."""
+        return sum(1 for r in self._records if isinstance(r, DataFileRecord))
+
     def get_used_bytes(self) -> int:
         """
         Calculate the total bytes that will be used.
@@ -398,6 +516,23 @@ class PackBuilder:
             if isinstance(record, ProcedureRecord)
         ]
 
+    def list_data_files(self) -> list[tuple[str, int]]:
+        """
+        List the data files added, with their record counts.
+
+        Returns:
+            List of (name, number of records) tuples
+        """
+        counts: dict[int, int] = {}
+        for record in self._records:
+            if isinstance(record, DataRecord):
+                counts[record.record_type] = counts.get(record.record_type, 0) + 1
+        return [
+            (record.get_display_name(), counts.get(record.file_id, 0))
+            for record in self._records
+            if isinstance(record, DataFileRecord)
+        ]
+
     # =========================================================================
     # Building
     # =========================================================================
@@ -477,6 +612,14 @@ class PackBuilder:
         # - Other types: Use exact checksum calculation
         size_indicator = self.size_kb // 8
 
+        # 128K packs are segmented: the Organiser reads past the first
+        # 256-byte page only if the pack says it is paged
+        if self.size_kb >= 128 and not self.pack_type & 0x04:
+            logger.warning(
+                f"{self.size_kb}KB pack without paged addressing: use a paged "
+                f"pack type (e.g. DATAPAK_PAGED) for data beyond the first page"
+            )
+
         # Use a standard timestamp format that works with JAPE and real hardware
         # Format: year, month, day, hour, reserved, frame_counter
         # DATAPAK_SIMPLE uses: 00 00 20 00 00 00 (like fnkey40.opk)
@@ -0,0 +1,263 @@
+"""
+Data File Import
+================
+
+This module turns tables from CSV and JSON files into the records of a
+Psion data file, so that PackBuilder can write the file, already filled,
+into a pack image.
+
+On-Pack Format
+--------------
+A data file is a file header record (type $81) with the file's name and
+record type, followed by one record of that type per entry:
+
+    09 81 "CONTACTS" 91          - Header: name, records use type $91
+    0E 91 "Alice" 09 "555-0101"  - A record: fields joined by TAB
+
+This is the format db.h and OPL read and write (see docs/db.md):
+
+- Fields are separated by TAB ($09); a record holds at most 16 fields
+- Every field is text. Integers are written in decimal, so db_get_int()
+  and OPL's integer fields read them back; floats keep 12 digits, the
+  precision of the Organiser's floating point
+- A record is at most 254 bytes, TABs included
+
+Which field is which is not stored: the program gives the schema when
+it opens the file (db_open, OPEN in OPL), in the column order of the
+table.
+
+Input Tables
+------------
+- **CSV**: One record per row. The first row names the fields and is
+  skipped, unless ``header=False``.
+- **JSON**: A list of records. Each record is a list of values, or an
+  object; the fields of objects are in the order of the first object's
+  keys (or of ``fields``), and a missing key is an empty field.
+
+Usage
+-----
+    >>> from psion_sdk.opk.datafile import read_table
+    >>> records = read_table("contacts.csv")
+    >>> builder.add_data_file("CONTACTS", records)
+
+or directly:
+
+    >>> builder.import_data_file("contacts.csv")   # File CONTACTS
+"""
+
+import csv
+import io
+import json
+from pathlib import Path
+from typing import Any, Optional, Sequence, Union
+
+from psion_sdk.errors import OPKError
+
+# Largest record, in bytes (the length byte $FF is reserved)
+MAX_RECORD_SIZE = 254
+
+# Most fields in a record
+MAX_FIELDS = 16
+
+# Field separator
+FIELD_SEPARATOR = b"\t"
+
+# Table files read_table() understands, by suffix
+TABLE_SUFFIXES = (".csv", ".json")
+
+
+# =============================================================================
+# Records
+# =============================================================================
+
+def format_field(value: Any) -> str:
+    """
+    Format one value as the text of a field.
+
+    Args:
+        value: A string, integer, float, boolean or None
+
+    Returns:
+        The field text: integers in decimal, True and False as 1 and 0,
+        floats with up to 12 significant digits, None as an empty field
+
+    Raises:
+        OPKError: If the value is of another type (a list, an object)
+    """
+    if value is None:
+        return ""
+    if isinstance(value, bool):
+        return "1" if value else "0"
+    if isinstance(value, int):
+        return str(value)
+    if isinstance(value, float):
+        return f"{value:.12G}"
+    if isinstance(value, str):
+        return value
+    raise OPKError(f"Cannot store a {type(value).__name__} in a data file field")
+
+
+def encode_record(fields: Union[Sequence[Any], str, bytes]) -> bytes:
+    """
+    Encode one record: its fields joined by TAB.
+
+    Args:
+        fields: The field values, or the record text (fields already
+                joined by TAB) as str or bytes
+
+    Returns:
+        The record data, as written after the record type byte
+
+    Raises:
+        OPKError: If a field holds a TAB or a line break, or a character
+                  that is not ASCII, or if the record has more than
+                  MAX_FIELDS fields or MAX_RECORD_SIZE bytes
+    """
+    if isinstance(fields, str):
+        try:
+            fields = fields.encode("ascii")
+        except UnicodeEncodeError:
+            raise OPKError(f"Record is not ASCII: {fields!r}") from None
+    if isinstance(fields, bytes):
+        data = fields
+        parts = data.split(FIELD_SEPARATOR)
+    else:
+        parts = []
+        for value in fields:
+            text = format_field(value)
+            if "\t" in text:
+                raise OPKError(f"Field holds a TAB: {text!r}")
+            try:
+                parts.append(text.encode("ascii"))
+            except UnicodeEncodeError:
+                raise OPKError(f"Field is not ASCII: {text!r}") from None
+        data = FIELD_SEPARATOR.join(parts)
+
+    if b"\r" in data or b"\n" in data:
+        raise OPKError(f"Record holds a line break: {data!r}")
+    if len(parts) > MAX_FIELDS:
+        raise OPKError(f"Record has {len(parts)} fields, at most {MAX_FIELDS} allowed")
+    if len(data) > MAX_RECORD_SIZE:
+        raise OPKError(
+            f"Record is {len(data)} bytes, at most {MAX_RECORD_SIZE} allowed"
+        )
+    return data
+
+
+# =============================================================================
+# Tables
+# =============================================================================
+
+def read_csv_records(text: str, header: bool = True) -> list[bytes]:
+    """
+    Encode the rows of a CSV table as records.
+
+    Args:
+        text: The CSV text
+        header: True if the first row names the fields (it is skipped)
+
+    Returns:
+        One record per row; blank rows are skipped
+
+    Raises:
+        OPKError: If a row cannot be stored (see encode_record), with
+                  its line number
+    """
+    reader = csv.reader(io.StringIO(text))
+    records = []
+    for row in reader:
+        if header:
+            header = False
+            continue
+        if not row:
+            continue
+        try:
+            records.append(encode_record(row))
+        except OPKError as e:
+            raise OPKError(f"Line {reader.line_num}: {e}") from None
+    return records
+
+
+def read_json_records(
+    text: str,
+    fields: Optional[Sequence[str]] = None,
+) -> list[bytes]:
+    """
+    Encode the entries of a JSON table as records.
+
+    Args:
+        text: The JSON text: a list of lists or of objects
+        fields: Keys of the fields of objects, in order (default: the
+                keys of the first object)
+
+    Returns:
+        One record per entry
+
+    Raises:
+        OPKError: If the JSON is not a list of lists or objects, or an
+                  entry cannot be stored (see encode_record)
+    """
+    try:
+        table = json.loads(text)
+    except json.JSONDecodeError as e:
+        raise OPKError(f"Invalid JSON: {e}") from None
+    if not isinstance(table, list):
+        raise OPKError("JSON table must be a list of records")
+
+    records = []
+    for number, entry in enumerate(table, 1):
+        if isinstance(entry, dict):
+            if fields is None:
+                fields = list(entry)
+            entry = [entry.get(key) for key in fields]
+        elif not isinstance(entry, list):
+            raise OPKError(f"Record {number}: expected a list or an object")
+        try:
+            records.append(encode_record(entry))
+        except OPKError as e:
+            raise OPKError(f"Record {number}: {e}") from None
+    return records
+
+
+def read_table(
+    filepath: Union[str, Path],
+    header: bool = True,
+    fields: Optional[Sequence[str]] = None,
+) -> list[bytes]:
+    """
+    Read a CSV or JSON table file as data file records.
+
+    Args:
+        filepath: A .csv or .json file
+        header: CSV only: True if the first row names the fields
+        fields: JSON only: keys of the fields of objects, in order
+
+    Returns:
+        One record per row or entry
+
+    Raises:
+        FileNotFoundError: If the file doesn't exist
+        OPKError: If the file is not a table or a record cannot be stored
+    """
+    filepath = Path(filepath)
+    suffix = filepath.suffix.lower()
+    if suffix not in TABLE_SUFFIXES:
+        raise OPKError(
+            f"Unknown table format '{filepath.suffix}': "
+            f"use {' or '.join(TABLE_SUFFIXES)}"
+        )
+
+    # utf-8-sig also accepts the byte order mark spreadsheets write
+    text = filepath.read_text(encoding="utf-8-sig")
+    try:
+        if suffix == ".csv":
+            return read_csv_records(text, header)
+        return read_json_records(text, fields)
+    except OPKError as e:
+        raise OPKError(f"{filepath}: {e}") from None
+
+
+def is_table_file(filepath: Union[str, Path]) -> bool:
+    """True if read_table() reads this file (by its suffix)."""
+    return Path(filepath).suffix.lower() in TABLE_SUFFIXES
+
@@ -17,6 +17,15 @@ The validate_ob3() function validates OB3 object files produced by
 the assembler, ensuring they have the correct format before being
 packaged into OPK files.
 
+Record Checksums
+----------------
+PackParser.record_checksums() gives the position, size and checksum
+(calculate_ob3_checksum() of the record's bytes) of every record.
+compare_records() matches two such lists by record type and name and
+reports which records are unchanged, changed, added or removed, and how
+long the prefix of the pack image is that the two packs share. pslink
+uses this to tell whether a pack needs flashing again.
+
 Usage Examples
 --------------
 Reading an OPK file:
@@ -37,6 +46,12 @@ Validating an OB3 file:
     ...     if validate_ob3(f.read()):
     ...         print("Valid OB3 file")
 
+Comparing two versions of a pack:
+    >>> old = PackParser.from_file("v1.opk").record_checksums()
+    >>> new = PackParser.from_file("v2.opk").record_checksums()
+    >>> delta = compare_records(old, new)
+    >>> print([r.name for r in delta.changed + delta.added])
+
 Reference
 ---------
 - OPK format: https://www.jaapsch.net/psion/fileform.htm
@@ -52,6 +67,7 @@ from psion_sdk.errors import OPKError, OPKFormatError
 from psion_sdk.opk.records import (
     PackHeader,
     PackRecord,
+    FileRecord,
     ProcedureRecord,
     DataFileRecord,
     DiaryRecord,
@@ -68,6 +84,7 @@ from psion_sdk.opk.records import (
 )
 from psion_sdk.opk.checksum import (
     analyze_header_checksum,
+    calculate_ob3_checksum,
     parse_opk_header,
     validate_opk_length,
 )
@@ -186,6 +203,122 @@ def parse_ob3_file(filepath: Union[str, Path]) -> OB3File:
     return parse_ob3(data)
 
 
+# =============================================================================
+# Record Checksums
+# =============================================================================
+
+@dataclass(frozen=True)
+class RecordChecksum:
+    """
+    Position and checksum of one record in a pack image.
+
+    Attributes:
+        record_type: The record type byte
+        name: File name for file records; for other records (such as
+              the records of a data file) "#n", the record's number
+              among the records of its type
+        offset: Offset of the record's length byte in the pack image
+                (0 is the first byte of the pack header)
+        size: Size of the record in bytes, including its length bytes
+        checksum: calculate_ob3_checksum() of the record's bytes
+    """
+    record_type: int
+    name: str
+    offset: int
+    size: int
+    checksum: int
+
+    @property
+    def key(self) -> tuple[int, str]:
+        """The (type, name) pair that identifies the record across packs."""
+        return self.record_type, self.name
+
+    def matches(self, other: "RecordChecksum") -> bool:
+        """True if both records have the same size and checksum."""
+        return self.size == other.size and self.checksum == other.checksum
+
+
+@dataclass
+class PackDelta:
+    """
+    Differences between two packs, record by record.
+
+    Attributes:
+        unchanged: Records in both packs with the same contents
+        changed: Records in both packs whose contents differ (new version)
+        added: Records only in the new pack
+        removed: Records only in the old pack
+        common_prefix: Offset in the pack image at which the first
+                       record starts that is not identical and at the
+                       same offset in both packs (the pack headers are
+                       not compared; 0 if the first records differ)
+    """
+    unchanged: list[RecordChecksum] = field(default_factory=list)
+    changed: list[RecordChecksum] = field(default_factory=list)
+    added: list[RecordChecksum] = field(default_factory=list)
+    removed: list[RecordChecksum] = field(default_factory=list)
+    common_prefix: int = 0
+
+    @property
+    def is_empty(self) -> bool:
+        """True if the two packs hold the same records."""
+        return not (self.changed or self.added or self.removed)
+
+    @property
+    def transfer_bytes(self) -> int:
+        """Bytes of the changed and added records."""
+        return sum(r.size for r in self.changed + self.added)
+
+    def summary(self) -> str:
+        """One line such as "2 unchanged, 1 changed (HELLO), 1 added (NEW)"."""
+        parts = [f"{len(self.unchanged)} unchanged"]
+        for label, records in (("changed", self.changed), ("added", self.added),
+                               ("removed", self.removed)):
+            if records:
+                names = ", ".join(r.name for r in records)
+                parts.append(f"{len(records)} {label} ({names})")
+        return ", ".join(parts)
+
+
+def compare_records(old: list[RecordChecksum], new: list[RecordChecksum]) -> PackDelta:
+    """
+    Compare the records of two packs.
+
+    Records are matched by type and name (see RecordChecksum.key), so a
+    procedure that moved to another offset but did not change counts as
+    unchanged.
+
+    Args:
+        old: Records of the pack as it is (PackParser.record_checksums())
+        new: Records of the pack as it should be
+
+    Returns:
+        A PackDelta; its lists are in the order of ``new`` (``removed``
+        in the order of ``old``)
+    """
+    delta = PackDelta()
+    old_by_key = {record.key: record for record in old}
+    new_keys = {record.key for record in new}
+
+    for record in new:
+        previous = old_by_key.get(record.key)
+        if previous is None:
+            delta.added.append(record)
+        elif previous.matches(record):
+            delta.unchanged.append(record)
+        else:
+            delta.changed.append(record)
+    delta.removed = [record for record in old if record.key not in new_keys]
+
+    prefix_end = 0
+    for before, after in zip(old, new):
+        if before.key != after.key or before.offset != after.offset or not before.matches(after):
+            break
+        prefix_end = after.offset + after.size
+    delta.common_prefix = prefix_end
+    return delta
+
+
 # =============================================================================
 # Pack Parser
 # =============================================================================
@@ -203,6 +336,7 @@ class PackParser:
         data: The raw OPK file bytes
         header: The parsed pack header
         records: List of parsed records
+        record_spans: (offset, size) of each record in the pack image
 
     Example:
         >>> parser = PackParser.from_file("mypack.opk")
@@ -219,6 +353,9 @@ class PackParser:
     # List of parsed records
     records: list[PackRecord] = field(default_factory=list)
 
+    # Where each record is in the pack image (parallel to records)
+    record_spans: list[tuple[int, int]] = field(default_factory=list, repr=False)
+
     # Flag indicating if pack is valid
     is_valid: bool = False
 
@@ -342,6 +479,7 @@ class PackParser:
         - Deleted records: type byte 0x01-0x7F (high bit clear)
         """
         self.records.clear()
+        self.record_spans.clear()
 
         # Records start at offset 16 (6 OPK + 10 pack header)
         pack_data = self.data[6:]
@@ -379,13 +517,14 @@ class PackParser:
                     logger.warning(f"Truncated record at offset {offset}")
                     break
                 record_type = pack_data[offset + 1]
-                total_size = 1 + record_length  # length byte + data (which includes type)
+                total_size = 2 + record_length  # length + type bytes + data
 
             # Parse record based on type
             try:
                 record, size = self._parse_record(pack_data, offset, record_type)
                 if record:
                     self.records.append(record)
+                    self.record_spans.append((offset, size))
                 offset += size
             except Exception as e:
                 logger.warning(f"Error parsing record type 0x{record_type:02X} at offset {offset}: {e}")
@@ -467,7 +606,8 @@ class PackParser:
                 record_length = (data[offset + 2] << 8) | data[offset + 3]
                 size = 4 + record_length
             else:
-                size = 1 + length_byte
+                # The length counts the bytes after the type byte
+                size = 2 + length_byte
             logger.debug(f"Skipping deleted record type 0x{record_type:02X}")
             return None, size
 
@@ -579,6 +719,55 @@ class PackParser:
             if isinstance(record, DataFileRecord):
                 yield record
 
+    def get_data_records(self, name: str) -> list[DataRecord]:
+        """
+        Get the records of a data file, in pack order.
+
+        Args:
+            name: Data file name (case-insensitive)
+
+        Returns:
+            The file's DataRecords (empty if there is no such file)
+
+        Example:
+            >>> for record in parser.get_data_records("CONTACTS"):
+            ...     print(record.get_fields())
+        """
+        name = name.upper()[:8].ljust(8)
+        file_ids = {
+            record.file_id for record in self.records
+            if isinstance(record, DataFileRecord) and record.name == name
+        }
+        return [
+            record for record in self.records
+            if isinstance(record, DataRecord) and record.record_type in file_ids
+        ]
+
+    def record_checksums(self) -> list[RecordChecksum]:
+        """
+        Get the position and checksum of every record (see RecordChecksum).
+
+        Returns:
+            One RecordChecksum per record, in pack order
+        """
+        pack_data = self.data[6:]
+        counts: dict[int, int] = {}
+        result = []
+        for record, (offset, size) in zip(self.records, self.record_spans):
+            if isinstance(record, FileRecord):
+                name = record.get_display_name()
+            else:
+                counts[record.record_type] = counts.get(record.record_type, 0) + 1
+                name = f"#{counts[record.record_type]}"
+            result.append(RecordChecksum(
+                record_type=int(record.record_type),
+                name=name,
+                offset=offset,
+                size=size,
+                checksum=calculate_ob3_checksum(pack_data[offset:offset + size]),
+            ))
+        return result
+
     def get_used_bytes(self) -> int:
         """
         Calculate the total bytes used by records.
@@ -500,7 +500,9 @@ class DataFileRecord(FileRecord):
     Marks the start of an ODB (Organiser Database) file.
     Data records ($90-$FE) follow this header.
 
-    Format: [length=10] [0x81] [name 8 bytes] [file_id]
+    Format: [length=9] [0x81] [name 8 bytes] [file_id]
+
+    As in every record, the length byte counts the bytes after the type.
     """
     record_type: int = field(default=RecordType.DATA_FILE, init=False)
     name: str = ""
@@ -510,7 +512,7 @@ class DataFileRecord(FileRecord):
         """Serialize the data file header."""
         name_bytes = self.name.upper()[:8].ljust(8).encode("ascii")
         data = bytearray()
-        data.append(10)  # Length: type(1) + name(8) + file_id(1) = 10
+        data.append(9)  # Length: name(8) + file_id(1) = 9
         data.append(RecordType.DATA_FILE)
         data.extend(name_bytes)
         data.append(self.file_id)
@@ -828,49 +830,36 @@ class DataRecord(PackRecord):
     Fields within a record are typically tab-separated (0x09).
 
     Format: [length] [type $90-$FE] [field data]
+
+    The length byte counts the field data only, which is at most
+    MAX_DATA_SIZE bytes (a length of $FF would read as the end of the pack).
     """
+    MAX_DATA_SIZE = 254
+
     record_type: int = 0x90
     data: bytes = field(default_factory=bytes)
 
     def to_bytes(self) -> bytes:
-        """Serialize the data record."""
-        content = bytearray()
-        content.append(self.record_type)
-        content.extend(self.data)
+        """
+        Serialize the data record.
 
-        if len(content) <= 254:
-            result = bytearray()
-            result.append(len(content))
-            result.extend(content)
-            return bytes(result)
-        else:
-            result = bytearray()
-            result.append(0x02)
-            result.append(0x80)
-            result.extend(struct.pack(">H", len(content)))
-            result.extend(content)
-            return bytes(result)
+        Raises:
+            ValueError: If the data is longer than MAX_DATA_SIZE bytes
+        """
+        if len(self.data) > self.MAX_DATA_SIZE:
+            raise ValueError(
+                f"Data record of {len(self.data)} bytes "
+                f"(at most {self.MAX_DATA_SIZE})"
+            )
+        return bytes([len(self.data), self.record_type]) + self.data
 
     @classmethod
     def from_bytes(cls, data: bytes, offset: int = 0) -> tuple["DataRecord", int]:
         """Parse a data record from pack data."""
-        start = offset
-
-        if data[offset] == 0x02 and data[offset + 1] == 0x80:
-            length = (data[offset + 2] << 8) | data[offset + 3]
-            offset += 4
-        else:
-            length = data[offset]
-            offset += 1
-
-        rec_type = data[offset]
-        offset += 1
-
-        remaining = length - 1
-        record_data = bytes(data[offset:offset + remaining]) if remaining > 0 else b""
-        offset += remaining
-
-        return cls(record_type=rec_type, data=record_data), offset - start
+        length = data[offset]
+        rec_type = data[offset + 1]
+        record_data = bytes(data[offset + 2:offset + 2 + length])
+        return cls(record_type=rec_type, data=record_data), 2 + length
 
     def get_fields(self, delimiter: bytes = b"\x09") -> list[bytes]:
         """Split the record data into fields (tab-separated)."""
@@ -171,12 +171,15 @@ class VariableDeclaration(Declaration):
         is_extern: True if declared with 'extern' (defined elsewhere).
                    Extern variables don't allocate storage - they reference
                    a variable defined in another translation unit.
+        is_const: True for a global scalar declared 'const'. With a
+                  constant initializer it is a compile-time constant.
     """
     name: str = ""
     var_type: CType = field(default=None)
     initializer: Optional[Expression] = None
     is_global: bool = False
     is_extern: bool = False
+    is_const: bool = False
 
 
 @dataclass
@@ -63,6 +63,44 @@ We use SUBD for all D register comparisons:
 This approach is actually MORE efficient than CPD would be - SUBD #0 is 3 bytes
 vs. 4 bytes for CPD #0, saving code space in boolean tests.
 
+Register-Aware Mode
+-------------------
+At opt_level 1 and above the generator tracks what X holds as it emits
+each instruction:
+
+1. After TSX, X equals SP. Every later push or pull moves SP by a known
+   amount, so X stays a usable frame pointer with an adjusted offset until
+   something writes X (LDX, XGDX, a runtime call, ...) or control can
+   arrive from elsewhere (a label). TSX is only emitted when X is unknown.
+
+2. A binary operation whose right operand is a constant or a scalar
+   variable applies it straight from memory (ADDD 4,X, SUBD _count,
+   LDX #10) instead of pushing it and reloading through TSX. Commutative
+   operators swap their operands when only the left one is simple.
+
+3. Subscripts of a named array or pointer add the scaled index to the
+   base without a push, and a constant index folds into the address.
+
+Calls to C functions defined in the same file preserve X, because their
+epilogue restores it. At opt_level 0 every access refreshes X with TSX
+and every binary operation goes through the stack.
+
+Optimization Levels
+-------------------
+opt_level selects how much work goes into removing overhead:
+
+0. Plain stack-machine code.
+1. The default: register-aware code (see "Register-Aware Mode" above).
+2. Adds function inlining and frameless leaf functions (see inliner.py).
+   A call to a small function whose body is one expression, such as
+   max() or a field accessor, is replaced by that expression with the
+   arguments substituted, so it costs no pushes, JSR or frame. A
+   function that calls nothing and has no locals gets no PSHX/TSX
+   prologue and returns with a plain RTS. A for loop counter that
+   indexes an array of elements other than 1 or 2 bytes also keeps a
+   scaled copy of itself, so a[i] costs an add instead of a multiply
+   (see folding.py).
+
 Generated Assembly Format
 -------------------------
 The generated assembly uses the psasm assembler syntax:
@@ -89,7 +127,7 @@ Usage
 >>> print(asm)
 """
 
-from typing import Optional
+from typing import Optional, Tuple
 from dataclasses import dataclass
 
 from psion_sdk.smallc.ast import (
@@ -139,6 +177,21 @@ from psion_sdk.smallc.types import (
     TYPE_CHAR_PTR, TYPE_VOID_PTR, TYPE_UINT,
 )
 from psion_sdk.smallc.errors import CCodeGenError, CTypeError
+from psion_sdk.smallc.folding import (
+    ScaledIndex,
+    find_scaled_indexes,
+    fold_binary,
+    fold_unary,
+    plan_multiply,
+)
+from psion_sdk.smallc.inliner import (
+    InlineCandidate,
+    find_inline_candidates,
+    is_frameless_leaf,
+    is_pure,
+    is_simple,
+    substitute,
+)
 
 
 # =============================================================================
@@ -157,6 +210,7 @@ class SymbolInfo:
         offset: Stack offset for locals (negative from X)
         is_parameter: True for function parameters
         is_extern: True for extern declarations (no storage allocated)
+        constant: Value of a const global with a constant initializer
     """
     name: str
     sym_type: CType
@@ -164,6 +218,7 @@ class SymbolInfo:
     offset: int = 0
     is_parameter: bool = False
     is_extern: bool = False
+    constant: Optional[int] = None
 
 
 @dataclass
@@ -462,11 +517,62 @@ class CodeGenerator(ASTVisitor):
         "db_erase": TYPE_INT,
         # Catalog - int returns
         "db_catalog": TYPE_INT,
+        # Batched record I/O - int returns
+        "db_read_block": TYPE_INT,
+        "db_append_many": TYPE_INT,
+        "db_load_rec": TYPE_INT,
+        "db_store_rec": TYPE_INT,
+    }
+
+    # fixed.h - Fixed point functions (optional)
+    BUILTIN_TYPES_FIXED = {
+        # Conversion - void returns
+        "fx_from_int": TYPE_VOID,
+        "fx_from_str": TYPE_VOID,
+        "fx_to_str": TYPE_VOID,
+        "q8_to_fx": TYPE_VOID,
+        "q8_to_str": TYPE_VOID,
+        "fx_to_fp": TYPE_VOID,
+        "fx_from_fp": TYPE_VOID,
+        # Conversion - int returns
+        "fx_to_int": TYPE_INT,
+        "q8_from_fx": TYPE_INT,
+        "q8_from_str": TYPE_INT,
+        # Arithmetic and mathematical functions - void returns
+        "fx_add": TYPE_VOID,
+        "fx_sub": TYPE_VOID,
+        "fx_mul": TYPE_VOID,
+        "fx_div": TYPE_VOID,
+        "fx_neg": TYPE_VOID,
+        "fx_sqrt": TYPE_VOID,
+        "fx_sin": TYPE_VOID,
+        "fx_cos": TYPE_VOID,
+        # Q8.8 arithmetic and mathematical functions - int returns
+        "q8_mul": TYPE_INT,
+        "q8_div": TYPE_INT,
+        "q8_sqrt": TYPE_INT,
+        "q8_sin": TYPE_INT,
+        "q8_cos": TYPE_INT,
+        # Comparison - int returns
+        "fx_cmp": TYPE_INT,
+        # Output - void returns
+        "fx_print": TYPE_VOID,
+    }
+
+    # fb.h - Display frame buffer functions (optional)
+    BUILTIN_TYPES_FB = {
+        "fb_begin": TYPE_VOID,
+        "fb_put": TYPE_VOID,
+        "fb_putc": TYPE_VOID,
+        "fb_invalidate": TYPE_VOID,
+        # Number of print calls made
+        "fb_flush": TYPE_INT,
     }
 
     def __init__(self, target_model: str = "XP", has_float_support: bool = False,
                  has_stdio_support: bool = False, has_db_support: bool = False,
-                 emit_runtime: bool = True):
+                 has_fixed_support: bool = False, has_fb_support: bool = False,
+                 emit_runtime: bool = True, opt_level: int = 1):
         """
         Initialize the code generator.
 
@@ -479,12 +585,17 @@ class CodeGenerator(ASTVisitor):
                               True if stdio.h was included, False otherwise.
             has_db_support: Whether to include database file access functions.
                            True if db.h was included, False otherwise.
+            has_fixed_support: Whether to include fixed point functions.
+                              True if fixed.h was included, False otherwise.
+            has_fb_support: Whether to include display frame buffer functions.
+                           True if fb.h was included, False otherwise.
             emit_runtime: Whether to emit runtime library includes and entry point.
                          Defaults to True. Set to False for "library mode" when
                          compiling C files that will be linked with other files.
 
                          When emit_runtime=False:
-                         - No INCLUDE "runtime.inc" (or dbruntime, fpruntime, stdio)
+                         - No INCLUDE "runtime.inc" (or dbruntime, fpruntime,
+                           fixedruntime, fbruntime, stdio)
                          - No _entry: entry point that calls main
                          - psion.inc IS still included (defines constants/macros)
                          - Functions, globals, and strings are still emitted
@@ -493,6 +604,10 @@ class CodeGenerator(ASTVisitor):
                          file includes the runtime, and helper files are compiled
                          in library mode. The assembler resolves forward references
                          to runtime functions when the files are concatenated.
+            opt_level: Optimization level (see "Optimization Levels" above).
+                         Defaults to 1, register-aware code; 0 gives the plain
+                         stack-machine output, and 2 also inlines small
+                         functions and drops the frame of leaf functions.
         """
         # Target model for generated code
         self._target_model = target_model.upper() if target_model else "XP"
@@ -506,11 +621,38 @@ class CodeGenerator(ASTVisitor):
         # Whether to include database file access support (dbruntime.inc)
         self._has_db_support = has_db_support
 
+        # Whether to include fixed point support (fixedruntime.inc)
+        self._has_fixed_support = has_fixed_support
+
+        # Whether to include display frame buffer support (fbruntime.inc)
+        self._has_fb_support = has_fb_support
+
         # Whether to emit runtime includes and entry point (True = normal, False = library mode)
         # Library mode is used for multi-file projects where helper C files are compiled
         # without the runtime, and then concatenated with the main file that has it.
         self._emit_runtime = emit_runtime
 
+        # Register-aware code generation (see module docstring)
+        self._register_aware = opt_level > 0
+
+        # Optimization level (see module docstring)
+        self._opt_level = opt_level
+
+        # Functions whose calls are replaced by their body, and leaf
+        # functions compiled without a frame (opt_level 2, see inliner.py)
+        self._inline_candidates: dict[str, InlineCandidate] = {}
+        self._frameless_funcs: set[str] = set()
+
+        # Loop counters kept multiplied by an element size (opt_level 2,
+        # see folding.py): the loops of the current function that have
+        # them, and counter -> {element size: slot} inside those loops
+        self._scaled_loops: dict[int, list[ScaledIndex]] = {}
+        self._scaled_counters: dict[str, dict[int, str]] = {}
+
+        # X - SP when X is known to hold a stack address, None otherwise.
+        # Kept up to date by _emit_instruction; 0 right after TSX.
+        self._x_sp_delta: Optional[int] = None
+
         # Assembly output lines
         self._output: list[str] = []
 
@@ -532,8 +674,8 @@ class CodeGenerator(ASTVisitor):
         # Loop context for break/continue
         self._loop_stack: list[tuple[str, str]] = []  # (continue_label, break_label)
 
-        # Switch context
-        self._switch_stack: list[str] = []  # break label for switch
+        # Break targets of the enclosing loops and switches, innermost last
+        self._break_stack: list[str] = []
 
         # OPL procedure declarations (Psion-specific)
         # These are procedures declared with 'opl' keyword that exist in
@@ -576,6 +718,10 @@ class CodeGenerator(ASTVisitor):
             self._builtin_function_types.update(self.BUILTIN_TYPES_STDIO)
         if has_db_support:
             self._builtin_function_types.update(self.BUILTIN_TYPES_DB)
+        if has_fixed_support:
+            self._builtin_function_types.update(self.BUILTIN_TYPES_FIXED)
+        if has_fb_support:
+            self._builtin_function_types.update(self.BUILTIN_TYPES_FB)
 
     def generate(self, program: ProgramNode) -> str:
         """
@@ -595,6 +741,8 @@ class CodeGenerator(ASTVisitor):
         self._structs = {}
         self._c_funcs = {}  # Reset user-defined function signatures
         self._last_expr_size = 2  # Reset expression size tracking
+        self._inline_candidates = {}
+        self._frameless_funcs = set()
 
         # Emit header (includes)
         self._emit_header()
@@ -634,6 +782,17 @@ class CodeGenerator(ASTVisitor):
                         is_forward_decl=decl.is_forward_decl,
                     )
 
+        # Inlining and frame elision are decided before any function is
+        # generated: calls to a frameless function do not preserve X
+        if self._opt_level >= 2:
+            self._inline_candidates = find_inline_candidates(program)
+            self._frameless_funcs = {
+                decl.name for decl in program.declarations
+                if isinstance(decl, FunctionNode) and not decl.is_opl
+                and not decl.is_forward_decl
+                and is_frameless_leaf(decl, self._inline_candidates)
+            }
+
         # Collect all functions, separating main from others
         main_func = None
         other_funcs = []
@@ -704,6 +863,11 @@ class CodeGenerator(ASTVisitor):
             if self._has_float_support:
                 self._emit("        INCLUDE \"float.inc\"       ; FP constants and macros")
                 self._emit("        INCLUDE \"fpruntime.inc\"  ; Floating point support")
+            if self._has_fixed_support:
+                # After fpruntime.inc, which enables fx_to_fp/fx_from_fp
+                self._emit("        INCLUDE \"fixedruntime.inc\" ; Fixed point support")
+            if self._has_fb_support:
+                self._emit("        INCLUDE \"fbruntime.inc\"   ; Display frame buffer (fb_begin, fb_put, fb_flush)")
         else:
             # Library mode - runtime will be provided by the main file
             self._emit("; Runtime libraries (runtime.inc, etc.) will be provided by the main file")
@@ -734,6 +898,8 @@ class CodeGenerator(ASTVisitor):
     def _emit_label(self, label: str) -> None:
         """Emit a label definition."""
         self._emit(f"{label}:")
+        # Control can arrive here from anywhere: X is unknown
+        self._x_sp_delta = None
 
     def _emit_instruction(self, mnemonic: str, operand: str = "") -> None:
         """Emit an instruction with optional operand."""
@@ -741,10 +907,135 @@ class CodeGenerator(ASTVisitor):
             self._emit(f"        {mnemonic:<8}{operand}")
         else:
             self._emit(f"        {mnemonic}")
+        self._track_x(mnemonic, operand)
+
+    # =========================================================================
+    # X Register Tracking
+    # =========================================================================
+    # _x_sp_delta holds X - SP while X is known to point into the stack.
+    # Pushes move SP down, so X - SP grows; pulls shrink it. Anything that
+    # writes X, or may (calls, OS traps), forgets it. Functions compiled in
+    # this file save and restore X, so calls to them keep what is known
+    # (except frameless leaf functions, which have nothing to restore).
+
+    # SP change of each stack instruction, for instructions that keep X
+    _SP_ADJUST = {
+        "PSHA": -1, "PSHB": -1, "DES": -1, "PSHX": -2,
+        "PULA": 1, "PULB": 1, "INS": 1,
+    }
+
+    # Instructions that write X or may change it behind our back
+    _X_CLOBBERS = frozenset([
+        "LDX", "XGDX", "INX", "DEX", "ABX", "PULX", "LDS", "TXS",
+        "JSR", "BSR", "JMP", "SWI", "WAI", "RTS", "RTI",
+    ])
+
+    def _track_x(self, mnemonic: str, operand: str = "") -> None:
+        """Update _x_sp_delta for an instruction just emitted."""
+        if mnemonic == "TSX":
+            self._x_sp_delta = 0
+        elif mnemonic == "JSR" and self._preserves_x(operand):
+            pass
+        elif mnemonic in self._X_CLOBBERS:
+            self._x_sp_delta = None
+        elif self._x_sp_delta is not None and mnemonic in self._SP_ADJUST:
+            self._x_sp_delta -= self._SP_ADJUST[mnemonic]
+
+    def _preserves_x(self, target: str) -> bool:
+        """Check if a JSR target is a C function defined in this file with a frame."""
+        func = self._c_funcs.get(target[1:]) if target.startswith("_") else None
+        return (func is not None and not func.is_forward_decl
+                and func.name not in self._frameless_funcs)
 
     def _emit_load_sp(self) -> None:
-        """Load stack pointer into X. On HD6303, TSX gives X=SP directly."""
+        """
+        Load stack pointer into X. On HD6303, TSX gives X=SP directly.
+
+        In register-aware mode the TSX is skipped when X already equals SP.
+        """
+        if self._register_aware and self._x_sp_delta == 0:
+            return
+        self._emit_instruction("TSX", "")
+
+    def _sp_operand(self, offset: int) -> str:
+        """
+        Indexed operand for the byte at SP+offset, refreshing X if needed.
+
+        In register-aware mode a frame pointer left in X by an earlier TSX
+        is reused with the offset adjusted for what was pushed since.
+
+        Args:
+            offset: Offset from the current SP
+
+        Returns:
+            Operand text such as "4,X"
+        """
+        delta = self._x_sp_delta
+        if self._register_aware and delta is not None and 0 <= offset - delta <= 255:
+            return f"{offset - delta},X"
         self._emit_instruction("TSX", "")
+        return f"{offset},X"
+
+    def _emit_sp_address(self, offset: int) -> None:
+        """Load D with the address SP+offset (X is clobbered)."""
+        delta = self._x_sp_delta
+        if not (self._register_aware and delta is not None):
+            self._emit_instruction("TSX", "")
+            delta = 0
+        self._emit_instruction("XGDX", "")
+        if offset - delta:
+            self._emit_instruction("ADDD", f"#{(offset - delta) & 0xFFFF}")
+
+    def _is_direct_operand(self, expr: Expression, size: int) -> bool:
+        """
+        Check if an operand can be used straight from memory.
+
+        Constants and scalar variables of the given size need no
+        evaluation, so a binary operator can address them directly instead
+        of pushing them and reading them back off the stack.
+        """
+        if not self._register_aware:
+            return False
+        if self._try_eval_constant(expr) is not None:
+            return True
+        if not isinstance(expr, IdentifierExpression):
+            return False
+        info = self._lookup(expr.name)
+        return (info is not None and not info.sym_type.is_array
+                and info.sym_type.size == size)
+
+    def _direct_operands(self, expr: Expression) -> Tuple[str, str, str]:
+        """
+        Operands for a 16-bit direct operand (see _is_direct_operand).
+
+        Emits a TSX first if a local is not reachable from X.
+
+        Returns:
+            (word, high byte, low byte) operand texts
+        """
+        value = self._try_eval_constant(expr)
+        if value is not None:
+            value &= 0xFFFF
+            return f"#{value}", f"#{value >> 8}", f"#{value & 0xFF}"
+        info = self._lookup(expr.name)
+        if info.is_global:
+            return f"_{expr.name}", f"_{expr.name}", f"_{expr.name}+1"
+        offset = info.offset + self._arg_push_depth
+        delta = self._x_sp_delta
+        if delta is None or not 0 <= offset - delta <= 254:
+            self._emit_instruction("TSX", "")
+            delta = 0
+        return f"{offset - delta},X", f"{offset - delta},X", f"{offset - delta + 1},X"
+
+    def _direct_char_operand(self, expr: Expression) -> str:
+        """Operand for an 8-bit direct operand (see _is_direct_operand)."""
+        value = self._try_eval_constant(expr)
+        if value is not None:
+            return f"#{value & 0xFF}"
+        info = self._lookup(expr.name)
+        if info.is_global:
+            return f"_{expr.name}"
+        return self._sp_operand(info.offset + self._arg_push_depth)
 
     def _emit_boolean_test(self) -> None:
         """Emit code to test if expression result is zero, setting Z flag.
@@ -784,13 +1075,19 @@ class CodeGenerator(ASTVisitor):
 
         Supports:
         - Number literals and char literals
+        - sizeof(type)
+        - const globals with a constant initializer
         - Binary operations: +, -, *, /, %, &, |, ^, <<, >>
         - Comparison operations: ==, !=, <, >, <=, >=
         - Unary operations: -, ~, !
+        - ?: with a constant condition
         - Nested constant expressions
 
-        This optimization is called "constant folding" and reduces code size
-        by computing values at compile time instead of runtime.
+        The arithmetic is done by folding.fold_unary() and fold_binary(),
+        which give the same results as the generated code (signed
+        division, for instance). This optimization is called "constant
+        folding" and reduces code size by computing values at compile
+        time instead of runtime.
         """
         if isinstance(expr, NumberLiteral):
             return expr.value & 0xFFFF
@@ -798,83 +1095,47 @@ class CodeGenerator(ASTVisitor):
         if isinstance(expr, CharLiteral):
             return expr.value & 0xFF
 
+        if isinstance(expr, IdentifierExpression):
+            info = self._lookup(expr.name)
+            return info.constant if info is not None else None
+
         if isinstance(expr, UnaryExpression):
             operand = self._try_eval_constant(expr.operand)
             if operand is None:
                 return None
-
-            op = expr.operator
-            if op == UnaryOperator.NEGATE:
-                return (-operand) & 0xFFFF
-            elif op == UnaryOperator.POSITIVE:
-                return operand
-            elif op == UnaryOperator.BITWISE_NOT:
-                return (~operand) & 0xFFFF
-            elif op == UnaryOperator.LOGICAL_NOT:
-                return 0 if operand else 1
-            # Other unary ops (address-of, deref, inc/dec) are not constant
-            return None
+            # Address-of, dereference and inc/dec give None
+            return fold_unary(expr.operator, operand)
 
         if isinstance(expr, BinaryExpression):
             left = self._try_eval_constant(expr.left)
             right = self._try_eval_constant(expr.right)
             if left is None or right is None:
                 return None
-
-            op = expr.operator
+            unsigned = False
             try:
-                if op == BinaryOperator.ADD:
-                    result = left + right
-                elif op == BinaryOperator.SUBTRACT:
-                    result = left - right
-                elif op == BinaryOperator.MULTIPLY:
-                    result = left * right
-                elif op == BinaryOperator.DIVIDE:
-                    if right == 0:
-                        return None  # Division by zero - let it fail at runtime
-                    result = left // right
-                elif op == BinaryOperator.MODULO:
-                    if right == 0:
-                        return None
-                    result = left % right
-                elif op == BinaryOperator.BITWISE_AND:
-                    result = left & right
-                elif op == BinaryOperator.BITWISE_OR:
-                    result = left | right
-                elif op == BinaryOperator.BITWISE_XOR:
-                    result = left ^ right
-                elif op == BinaryOperator.LEFT_SHIFT:
-                    result = left << (right & 0xF)  # Limit shift to 0-15
-                elif op == BinaryOperator.RIGHT_SHIFT:
-                    result = left >> (right & 0xF)
-                elif op == BinaryOperator.EQUAL:
-                    result = 1 if left == right else 0
-                elif op == BinaryOperator.NOT_EQUAL:
-                    result = 1 if left != right else 0
-                elif op == BinaryOperator.LESS:
-                    result = 1 if left < right else 0
-                elif op == BinaryOperator.GREATER:
-                    result = 1 if left > right else 0
-                elif op == BinaryOperator.LESS_EQ:
-                    result = 1 if left <= right else 0
-                elif op == BinaryOperator.GREATER_EQ:
-                    result = 1 if left >= right else 0
-                elif op == BinaryOperator.LOGICAL_AND:
-                    result = 1 if (left and right) else 0
-                elif op == BinaryOperator.LOGICAL_OR:
-                    result = 1 if (left or right) else 0
-                else:
-                    return None  # Unknown operator
-                return result & 0xFFFF
-            except (ValueError, OverflowError):
+                if expr.operator in (BinaryOperator.DIVIDE, BinaryOperator.MODULO):
+                    unsigned = self._is_unsigned_division(expr.left, expr.right)
+                elif expr.operator == BinaryOperator.RIGHT_SHIFT:
+                    unsigned = self._is_unsigned_operand(expr.left)
+            except (CCodeGenError, CTypeError):
+                return None  # Reported when the expression is generated
+            return fold_binary(expr.operator, left, right, unsigned)
+
+        if isinstance(expr, TernaryExpression):
+            condition = self._try_eval_constant(expr.condition)
+            if condition is None:
                 return None
+            return self._try_eval_constant(expr.then_expr if condition else expr.else_expr)
+
+        if isinstance(expr, SizeofExpression) and expr.target_type:
+            return self._sizeof_type(expr.target_type) & 0xFFFF
 
         if isinstance(expr, CastExpression):
             value = self._try_eval_constant(expr.expression)
             if value is None:
                 return None
             # Apply cast (char truncates to 8 bits)
-            if expr.target_type.base_type == BaseType.CHAR:
+            if expr.target_type.base_type == BaseType.CHAR and not expr.target_type.is_pointer:
                 return value & 0xFF
             return value & 0xFFFF
 
@@ -966,6 +1227,15 @@ class CodeGenerator(ASTVisitor):
         BinaryOperator.LOGICAL_OR,
     ])
 
+    # =========================================================================
+    # Inline Block Copies
+    # =========================================================================
+    # memcpy() and struct_copy() calls with a constant size of at most
+    # _INLINE_COPY_MAX bytes are expanded in place as LDD/STD word moves,
+    # saving the argument pushes, the call and the runtime loop setup.
+    _INLINE_COPY_FUNCS = frozenset(["memcpy", "struct_copy"])
+    _INLINE_COPY_MAX = 16
+
     def _get_expression_type(self, expr: Expression) -> CType:
         """
         Determine the result type of an expression.
@@ -1426,7 +1696,10 @@ class CodeGenerator(ASTVisitor):
         for name, info in definitions.items():
             size = info.sym_type.total_size
             self._emit_label(f"_{name}")
-            if size == 1:
+            if info.constant is not None:
+                # Still readable through a pointer (&N)
+                self._emit_instruction("FCB" if size == 1 else "FDB", str(info.constant))
+            elif size == 1:
                 self._emit_instruction("RMB", "1")
             elif size == 2:
                 self._emit_instruction("RMB", "2")
@@ -1460,12 +1733,21 @@ class CodeGenerator(ASTVisitor):
 
         For extern declarations, we add to the symbol table for type checking
         but mark is_extern=True so no storage is allocated in _emit_globals().
+
+        A const global with a constant initializer gets its value recorded:
+        reads of it fold to the constant, and its storage is initialized.
         """
+        constant = None
+        if decl.is_const and decl.initializer is not None:
+            constant = self._try_eval_constant(decl.initializer)
+            if constant is not None and decl.var_type.size == 1:
+                constant &= 0xFF
         self._globals[decl.name] = SymbolInfo(
             name=decl.name,
             sym_type=decl.var_type,
             is_global=True,
             is_extern=decl.is_extern,
+            constant=constant,
         )
 
     def _add_struct(self, defn: StructDefinition) -> None:
@@ -1651,6 +1933,18 @@ class CodeGenerator(ASTVisitor):
         local_size = 0
         if func.body:
             local_size = self._calculate_locals_size(func.body)
+
+        # Loop counters kept scaled by an element size get a hidden local
+        # each (opt_level 2, see folding.py)
+        self._scaled_loops = {}
+        self._scaled_counters = {}
+        slots: list[str] = []
+        if func.body and func.name not in self._frameless_funcs:
+            for scaled in self._find_scaled_indexes(func, local_size):
+                self._scaled_loops.setdefault(id(scaled.loop), []).append(scaled)
+                if scaled.slot not in slots:
+                    slots.append(scaled.slot)
+            local_size += 2 * len(slots)
         self._current_local_size = local_size
 
         # Emit function label
@@ -1679,6 +1973,21 @@ class CodeGenerator(ASTVisitor):
             self._emit_comment("MUST be first - captures USR entry SP before any stack changes")
             self._emit_instruction("JSR", "_call_opl_setup")
 
+        # A frameless leaf function (opt_level 2) has no prologue: it has no
+        # locals, and every access is SP-relative, so there is no frame
+        # pointer to save. Parameters start just above the return address.
+        frameless = func.name in self._frameless_funcs
+        if frameless:
+            self._emit_comment("Leaf function: no frame")
+            self._emit_parameters(func, 2)
+            self._generate_block(func.body)
+            body = func.body.statements
+            if not (body and isinstance(body[-1], ReturnStatement)):
+                self._emit_label(f"_{func.name}_exit")
+                self._emit_instruction("RTS", "")
+            self._current_function = None
+            return
+
         # Function prologue - NEW LAYOUT for HD6303
         # Allocate locals FIRST, THEN save X, so locals are at positive offsets
         # HD6303 indexed addressing only supports unsigned 0-255 offsets
@@ -1705,20 +2014,13 @@ class CodeGenerator(ASTVisitor):
 
         # Add parameters to symbol table
         # Params are after: saved_X (2) + locals (N) + return addr (2)
-        param_offset = 4 + local_size  # Start after saved X, locals, and return address
-        for param in func.parameters:
-            self._locals[param.name] = SymbolInfo(
-                name=param.name,
-                sym_type=param.param_type,
-                is_global=False,
-                offset=param_offset,
-                is_parameter=True,
-            )
-            param_offset += param.param_type.size
+        self._emit_parameters(func, 4 + local_size)
 
         # Add local variables to symbol table, generate initializers, then body
         if func.body:
             self._collect_locals(func.body)
+            for slot in slots:
+                self._add_local(slot, TYPE_INT)
             self._generate_local_initializers(func.body)
             self._generate_block(func.body)
 
@@ -1736,6 +2038,68 @@ class CodeGenerator(ASTVisitor):
         self._current_function = None
         self._current_local_size = 0
 
+    def _find_scaled_indexes(self, func: FunctionNode, local_size: int) -> list[ScaledIndex]:
+        """
+        Loop counters of a function worth keeping scaled (opt_level 2).
+
+        Runs before the function's symbols are set up, so types come from
+        its declarations. Nothing is kept scaled when the extra locals
+        would put a parameter out of reach of an 8-bit X offset.
+
+        Args:
+            func: Function definition
+            local_size: Bytes of declared locals
+        """
+        if self._opt_level < 2:
+            return []
+        declared = {p.name: p.param_type for p in func.parameters}
+        declared.update((d.name, d.var_type) for d in func.body.declarations)
+
+        def element_size(node: ArraySubscript) -> int:
+            name = node.array.name
+            ctype = declared.get(name)
+            if ctype is None and name in self._globals:
+                ctype = self._globals[name].sym_type
+            if ctype is not None and (ctype.is_array or ctype.is_pointer):
+                return ctype.dereference().size
+            return 2
+
+        def is_int_local(name: str) -> bool:
+            ctype = declared.get(name)
+            return (ctype is not None and ctype.is_scalar and not ctype.is_pointer
+                    and ctype.size == 2)
+
+        found = find_scaled_indexes(func, element_size, is_int_local)
+        slots = {scaled.slot for scaled in found}
+        if 4 + local_size + 2 * len(slots) + 2 * len(func.parameters) > 255:
+            return []
+        return found
+
+    def _emit_parameters(self, func: FunctionNode, param_offset: int) -> None:
+        """
+        Add a function's parameters to the symbol table.
+
+        Every argument is pushed as a 16-bit word, first argument at the
+        lowest address. A char parameter is the low byte of its word.
+
+        Args:
+            func: The function being generated
+            param_offset: Offset of the first parameter from SP after the
+                          prologue
+        """
+        for param in func.parameters:
+            ptype = param.param_type
+            is_char = (ptype.base_type == BaseType.CHAR and not ptype.is_pointer
+                       and not ptype.is_array)
+            self._locals[param.name] = SymbolInfo(
+                name=param.name,
+                sym_type=ptype,
+                is_global=False,
+                offset=param_offset + 1 if is_char else param_offset,
+                is_parameter=True,
+            )
+            param_offset += 2
+
     def _calculate_locals_size(self, block: BlockStatement) -> int:
         """Calculate total size needed for local variables.
 
@@ -1768,13 +2132,13 @@ class CodeGenerator(ASTVisitor):
                 continue
             # Evaluate the initializer expression (result in D)
             self._generate_expression(decl.initializer)
-            # Refresh frame pointer (expression eval may have corrupted X)
-            self._emit_instruction("TSX", "")
+            # Refresh frame pointer if expression eval may have corrupted X
+            operand = self._sp_operand(info.offset + self._arg_push_depth)
             # Store to local: STAB for char scalars, STD for int/pointer
             if info.sym_type.base_type == BaseType.CHAR and not info.sym_type.is_pointer and not info.sym_type.is_array:
-                self._emit_instruction("STAB", f"{info.offset},X")
+                self._emit_instruction("STAB", operand)
             else:
-                self._emit_instruction("STD", f"{info.offset},X")
+                self._emit_instruction("STD", operand)
 
     # =========================================================================
     # Statement Code Generation
@@ -1845,14 +2209,14 @@ class CodeGenerator(ASTVisitor):
     def _generate_while(self, stmt: WhileStatement) -> None:
         """Generate code for while statement.
 
-        Uses JMP for loop control to handle large loop bodies that
-        exceed the 127-byte limit of relative branches.
+        Uses short branches; the assembler widens any that end up out
+        of range into an inverted branch plus JMP.
         """
         start_label = self._new_label("while")
-        body_label = self._new_label("wbody")
         end_label = self._new_label("wend")
 
         self._loop_stack.append((start_label, end_label))
+        self._break_stack.append(end_label)
 
         self._emit_label(start_label)
 
@@ -1860,22 +2224,19 @@ class CodeGenerator(ASTVisitor):
         self._emit_comment("while condition")
         self._generate_expression(stmt.condition)
 
-        # Test condition - use short forward branch + JMP for long distance
+        # Test condition
         # Use helper for 8-bit optimization when condition is char
         self._emit_boolean_test()
-        self._emit_instruction("BNE", body_label)  # Short forward jump
-        self._emit_instruction("JMP", end_label)   # Long jump if condition false
-
-        self._emit_label(body_label)
+        self._emit_instruction("BEQ", end_label)
 
         # Body
         self._generate_statement(stmt.body)
 
-        # Loop back using JMP (handles any distance)
-        self._emit_instruction("JMP", start_label)
+        self._emit_instruction("BRA", start_label)
         self._emit_label(end_label)
 
         self._loop_stack.pop()
+        self._break_stack.pop()
 
     def _generate_for(self, stmt: ForStatement) -> None:
         """Generate code for for statement."""
@@ -1884,6 +2245,7 @@ class CodeGenerator(ASTVisitor):
         end_label = self._new_label("fend")
 
         self._loop_stack.append((continue_label, end_label))
+        self._break_stack.append(end_label)
 
         # Initializer
         if stmt.initializer:
@@ -1891,6 +2253,20 @@ class CodeGenerator(ASTVisitor):
             if isinstance(stmt.initializer, Expression):
                 self._generate_expression(stmt.initializer)
 
+        # Scaled copies of the counter start out as counter * size; the
+        # initializer left the counter's new value in D
+        scaled = self._scaled_loops.get(id(stmt), [])
+        for index in scaled:
+            counter = IdentifierExpression(location=stmt.location, name=index.variable)
+            if index is not scaled[0]:
+                self._generate_identifier(counter)
+            operand = None
+            if self._is_direct_operand(counter, 2):
+                operand = self._direct_operands(counter)[0]
+            self._emit_index_scale(index.scale, operand)
+            self._generate_store(IdentifierExpression(location=stmt.location, name=index.slot))
+            self._scaled_counters.setdefault(index.variable, {})[index.scale] = index.slot
+
         self._emit_label(start_label)
 
         # Condition
@@ -1911,12 +2287,20 @@ class CodeGenerator(ASTVisitor):
         if stmt.update:
             self._emit_comment("for update")
             self._generate_expression(stmt.update)
+        for index in scaled:
+            slot = IdentifierExpression(location=stmt.location, name=index.slot)
+            self._generate_identifier(slot)
+            self._emit_instruction("ADDD", f"#{(index.step * index.scale) & 0xFFFF}")
+            self._generate_store(slot)
 
         # Loop back
         self._emit_instruction("BRA", start_label)
         self._emit_label(end_label)
+        for index in scaled:
+            del self._scaled_counters[index.variable][index.scale]
 
         self._loop_stack.pop()
+        self._break_stack.pop()
 
     def _generate_do_while(self, stmt: DoWhileStatement) -> None:
         """Generate code for do-while statement."""
@@ -1924,6 +2308,7 @@ class CodeGenerator(ASTVisitor):
         end_label = self._new_label("dend")
 
         self._loop_stack.append((start_label, end_label))
+        self._break_stack.append(end_label)
 
         self._emit_label(start_label)
 
@@ -1942,62 +2327,181 @@ class CodeGenerator(ASTVisitor):
         self._emit_label(end_label)
 
         self._loop_stack.pop()
+        self._break_stack.pop()
+
+    # Switch lowering
+    # ---------------
+    # With constant case values the switch value stays in a register and
+    # the dispatch is picked from the case count and spread:
+    #   - up to _SWITCH_LINEAR_MAX cases: a chain of SUBD/BEQ, each SUBD
+    #     taking the difference from the previous case value
+    #   - values spanning at most _SWITCH_TABLE_SPREAD slots per case (and
+    #     at most 256 slots): a bounds check and a jump table indexed
+    #     through X
+    #   - otherwise: a binary search on X with CPX, ending in short
+    #     linear runs of up to _SWITCH_LEAF_SIZE cases
+
+    _SWITCH_LINEAR_MAX = 4
+    _SWITCH_TABLE_SPREAD = 3
+    _SWITCH_TABLE_MAX_SLOTS = 256
+    _SWITCH_LEAF_SIZE = 3
 
     def _generate_switch(self, stmt: SwitchStatement) -> None:
         """Generate code for switch statement."""
         end_label = self._new_label("swend")
-        self._switch_stack.append(end_label)
+        self._break_stack.append(end_label)
 
-        # Evaluate switch expression
+        # Evaluate switch expression (value in D)
         self._emit_comment("switch expression")
         self._generate_expression(stmt.expression)
-        self._emit_instruction("PSHB", "")
-        self._emit_instruction("PSHA", "")  # Save switch value
 
-        # Generate case comparisons
         case_labels = []
         default_label = None
-
         for i, case in enumerate(stmt.cases):
             label = self._new_label(f"case{i}")
             case_labels.append(label)
             if case.is_default:
                 default_label = label
-            else:
-                # Compare with case value
-                # Note: D is reloaded from stack for each case, so SUBD's
-                # modification doesn't matter - flags are set identically
-                self._emit_load_sp()
-                self._emit_instruction("LDD", "0,X")  # Get switch value
-                if isinstance(case.value, NumberLiteral):
-                    self._emit_instruction("SUBD", f"#{case.value.value}")
-                else:
-                    # Generate case value expression (result in D)
-                    self._generate_expression(case.value)
-                    # Compare D (case value) with stack (switch value)
-                    self._emit_load_sp()
-                    self._emit_instruction("SUBD", "0,X")
-                self._emit_instruction("BEQ", label)
-
-        # Jump to default or end
-        if default_label:
-            self._emit_instruction("BRA", default_label)
+        miss_label = default_label or end_label
+
+        values = [
+            self._try_eval_constant(case.value)
+            for case in stmt.cases if not case.is_default
+        ]
+        if None in values:
+            self._emit_switch_compare_chain(stmt, case_labels, miss_label)
         else:
-            self._emit_instruction("BRA", end_label)
+            # (value, label) per case; a repeated value keeps its first case
+            targets: dict[int, str] = {}
+            for case, label in zip(stmt.cases, case_labels):
+                if not case.is_default:
+                    targets.setdefault(self._try_eval_constant(case.value), label)
+            cases = list(targets.items())
+
+            signed = sorted(v - 0x10000 if v & 0x8000 else v for v, _ in cases)
+            slots = signed[-1] - signed[0] + 1 if signed else 0
+            if len(cases) <= self._SWITCH_LINEAR_MAX:
+                self._emit_switch_linear(cases, miss_label)
+            elif (slots <= self._SWITCH_TABLE_MAX_SLOTS
+                    and slots <= self._SWITCH_TABLE_SPREAD * len(cases)):
+                self._emit_switch_table(cases, signed[0], slots, miss_label)
+            else:
+                self._emit_instruction("XGDX", "")
+                self._emit_switch_search(sorted(cases), miss_label)
 
-        # Generate case bodies
+        # Generate case bodies (fall through from one to the next)
         for i, case in enumerate(stmt.cases):
             self._emit_label(case_labels[i])
             for case_stmt in case.statements:
                 self._generate_statement(case_stmt)
 
         self._emit_label(end_label)
+        self._break_stack.pop()
+
+    def _emit_switch_linear(self, cases: list[tuple[int, str]], miss_label: str) -> None:
+        """
+        Dispatch on D with a SUBD/BEQ chain.
+
+        Each SUBD subtracts the difference from the previous case value,
+        so D never needs reloading.
+        """
+        previous = 0
+        for value, label in cases:
+            self._emit_instruction("SUBD", f"#{(value - previous) & 0xFFFF}")
+            self._emit_instruction("BEQ", label)
+            previous = value
+        self._emit_instruction("BRA", miss_label)
+
+    def _emit_switch_table(self, cases: list[tuple[int, str]], low: int,
+                           slots: int, miss_label: str) -> None:
+        """
+        Dispatch on D through a table of case addresses.
+
+        D - low must fit in B (A zero) and be below the slot count; the
+        entry at twice that offset is the target. Slots without a case
+        go to the default (or the end of the switch).
+        """
+        if low:
+            self._emit_instruction("SUBD", f"#{low & 0xFFFF}")
+        self._emit_instruction("TSTA", "")
+        self._emit_instruction("BNE", miss_label)
+        self._emit_instruction("CMPB", f"#{slots - 1}")
+        self._emit_instruction("BHI", miss_label)
+
+        table_label = self._new_label("swtab")
+        self._emit_instruction("LDX", f"#{table_label}")
+        self._emit_instruction("ABX", "")
+        self._emit_instruction("ABX", "")
+        self._emit_instruction("LDX", "0,X")
+        self._emit_instruction("JMP", "0,X")
+
+        targets = {(value - low) & 0xFFFF: label for value, label in cases}
+        self._emit_label(table_label)
+        for slot in range(slots):
+            self._emit_instruction("FDB", targets.get(slot, miss_label))
+
+    def _emit_switch_search(self, cases: list[tuple[int, str]], miss_label: str) -> None:
+        """
+        Dispatch on X by binary search over cases sorted by value.
+
+        Values are compared unsigned; the order only has to agree with
+        BHI, not with C's signed comparison.
+        """
+        if len(cases) <= self._SWITCH_LEAF_SIZE:
+            for value, label in cases:
+                self._emit_instruction("CPX", f"#{value}")
+                self._emit_instruction("BEQ", label)
+            self._emit_instruction("BRA", miss_label)
+            return
+
+        middle = len(cases) // 2
+        value, label = cases[middle]
+        upper_label = self._new_label("swhi")
+        self._emit_instruction("CPX", f"#{value}")
+        self._emit_instruction("BEQ", label)
+        self._emit_instruction("BHI", upper_label)
+        self._emit_switch_search(cases[:middle], miss_label)
+        self._emit_label(upper_label)
+        self._emit_switch_search(cases[middle + 1:], miss_label)
+
+    def _emit_switch_compare_chain(self, stmt: SwitchStatement, case_labels: list[str],
+                                   miss_label: str) -> None:
+        """
+        Dispatch by comparing with each case value in turn.
+
+        Used when a case value is not a compile-time constant. The switch
+        value is saved on the stack during the comparisons and dropped
+        before control reaches a case body.
+        """
+        self._emit_instruction("PSHB", "")
+        self._emit_instruction("PSHA", "")  # Save switch value
+        self._arg_push_depth += 2
 
-        # Clean up switch value from stack
+        hits = []
+        for case, label in zip(stmt.cases, case_labels):
+            if case.is_default:
+                continue
+            hit_label = self._new_label("swhit")
+            hits.append((hit_label, label))
+            value = self._try_eval_constant(case.value)
+            if value is not None:
+                self._emit_instruction("LDD", self._sp_operand(0))
+                self._emit_instruction("SUBD", f"#{value}")
+            else:
+                # Case value in D, compared with the saved switch value
+                self._generate_expression(case.value)
+                self._emit_instruction("SUBD", self._sp_operand(0))
+            self._emit_instruction("BEQ", hit_label)
+
+        self._arg_push_depth -= 2
         self._emit_instruction("INS", "")
         self._emit_instruction("INS", "")
-
-        self._switch_stack.pop()
+        self._emit_instruction("BRA", miss_label)
+        for hit_label, label in hits:
+            self._emit_label(hit_label)
+            self._emit_instruction("INS", "")
+            self._emit_instruction("INS", "")
+            self._emit_instruction("BRA", label)
 
     def _generate_return(self, stmt: ReturnStatement) -> None:
         """Generate code for return statement."""
@@ -2005,18 +2509,16 @@ class CodeGenerator(ASTVisitor):
             self._emit_comment("return value")
             self._generate_expression(stmt.value)
 
-        # Jump to function epilogue
-        self._emit_instruction("BRA", f"_{self._current_function.name}_exit")
+        # Jump to function epilogue; a frameless function has none
+        if self._current_function.name in self._frameless_funcs:
+            self._emit_instruction("RTS", "")
+        else:
+            self._emit_instruction("BRA", f"_{self._current_function.name}_exit")
 
     def _generate_break(self) -> None:
-        """Generate code for break statement."""
-        if self._switch_stack:
-            # Break out of switch
-            self._emit_instruction("BRA", self._switch_stack[-1])
-        elif self._loop_stack:
-            # Break out of loop
-            _, break_label = self._loop_stack[-1]
-            self._emit_instruction("BRA", break_label)
+        """Generate code for break statement (innermost loop or switch)."""
+        if self._break_stack:
+            self._emit_instruction("BRA", self._break_stack[-1])
 
     def _generate_continue(self) -> None:
         """Generate code for continue statement."""
@@ -2056,6 +2558,11 @@ class CodeGenerator(ASTVisitor):
 
         code = stmt.code
 
+        # Local references are X-relative, so X must hold the frame pointer
+        if self._register_aware and any(
+                name in self._locals for name in re.findall(r'%(\w+)', code)):
+            self._emit_load_sp()
+
         # Find all %varname references and substitute them
         # Pattern: % followed by identifier characters
         def substitute_var(match):
@@ -2081,6 +2588,8 @@ class CodeGenerator(ASTVisitor):
 
         # Emit the assembly code directly
         self._emit(code)
+        # The code may do anything to X
+        self._x_sp_delta = None
 
     # =========================================================================
     # Expression Code Generation
@@ -2097,8 +2606,9 @@ class CodeGenerator(ASTVisitor):
 
         # Constant folding optimization: try to evaluate at compile time
         # Only attempt for compound expressions (binary, unary with const operand)
-        # to avoid redundant work on simple literals
-        if isinstance(expr, (BinaryExpression, UnaryExpression, CastExpression)):
+        # and const globals, to avoid redundant work on simple literals
+        if isinstance(expr, (BinaryExpression, UnaryExpression, CastExpression,
+                             TernaryExpression, IdentifierExpression)):
             const_value = self._try_eval_constant(expr)
             if const_value is not None:
                 # Emit the pre-computed constant
@@ -2178,9 +2688,7 @@ class CodeGenerator(ASTVisitor):
                 # or other operations). Adjust offset for any args currently
                 # pushed on the stack, same pattern as address-of operator.
                 adjusted_offset = info.offset + self._arg_push_depth
-                self._emit_instruction("TSX", "")    # X = current SP
-                self._emit_instruction("XGDX", "")   # D = SP
-                self._emit_instruction("ADDD", f"#{adjusted_offset}")  # D = array address
+                self._emit_sp_address(adjusted_offset)  # D = array address
             self._last_expr_size = 2  # Addresses are always 16-bit
         elif info.is_global:
             # Global scalar variable: direct addressing (load value)
@@ -2197,13 +2705,13 @@ class CodeGenerator(ASTVisitor):
             # (from local array access) or other operations. Adjust offset
             # for any args currently pushed on the stack.
             adjusted_offset = info.offset + self._arg_push_depth
-            self._emit_instruction("TSX", "")
+            operand = self._sp_operand(adjusted_offset)
             if info.sym_type.size == 1:
-                self._emit_instruction("LDAB", f"{adjusted_offset},X")
+                self._emit_instruction("LDAB", operand)
                 self._emit_instruction("CLRA", "")
                 self._last_expr_size = 1  # Char: A=0, value in B
             else:
-                self._emit_instruction("LDD", f"{adjusted_offset},X")
+                self._emit_instruction("LDD", operand)
                 self._last_expr_size = 2  # Int: full D register
 
     # =========================================================================
@@ -2284,6 +2792,16 @@ class CodeGenerator(ASTVisitor):
         When multiplying or dividing by a power of 2 (2, 4, 8, ..., 256),
         we can use shift instructions instead of expensive mul/div routines.
 
+        Unsigned division is a plain logical shift. Signed division must
+        round toward zero, so a negative dividend is first biased by
+        divisor-1 and then shifted arithmetically:
+
+            TSTA            ; dividend sign
+            BPL  pos
+            ADDD #(2^k - 1)
+        pos:
+            ASRA / RORB     ; k times
+
         Args:
             expr: The binary expression
             op: MULTIPLY or DIVIDE operator
@@ -2311,9 +2829,307 @@ class CodeGenerator(ASTVisitor):
         if op == BinaryOperator.MULTIPLY:
             for _ in range(shift_count):
                 self._emit_instruction("ASLD", "")
-        else:  # DIVIDE
+        elif self._is_unsigned_division(expr.left, expr.right):
             for _ in range(shift_count):
                 self._emit_instruction("LSRD", "")
+        elif shift_count > 0:
+            self._emit_signed_shift_divide(shift_count)
+
+        self._last_expr_size = 2
+        return True
+
+    def _emit_signed_shift_divide(self, shift_count: int) -> None:
+        """Divide the signed value in D by 2^shift_count, rounding toward zero."""
+        pos_label = self._new_label("sdpos")
+        self._emit_instruction("TSTA", "")
+        self._emit_instruction("BPL", pos_label)
+        self._emit_instruction("ADDD", f"#{(1 << shift_count) - 1}")
+        self._emit_label(pos_label)
+        for _ in range(shift_count):
+            self._emit_instruction("ASRA", "")
+            self._emit_instruction("RORB", "")
+
+    def _emit_constant_multiply(self, multiplier: int, operand: Optional[str] = None) -> bool:
+        """
+        Multiply D by a constant with shifts and adds (see folding.py).
+
+        Args:
+            multiplier: The constant
+            operand: Where the value in D can be read again, e.g. "_count"
+                     or "4,X". Without it, D is pushed first if the sequence
+                     adds it back.
+
+        Returns:
+            True if emitted, False if the constant needs __mul16
+        """
+        plan = plan_multiply(multiplier)
+        if plan is None:
+            return False
+        pushed = operand is None and plan.uses_operand
+        if pushed:
+            self._emit_instruction("PSHB", "")
+            self._emit_instruction("PSHA", "")
+            self._arg_push_depth += 2
+        for step in plan.steps:
+            if step == "shift":
+                self._emit_instruction("ASLD", "")
+                continue
+            source = self._sp_operand(0) if pushed else operand
+            self._emit_instruction("ADDD" if step == "add" else "SUBD", source)
+        if pushed:
+            self._emit_instruction("INS", "")
+            self._emit_instruction("INS", "")
+            self._arg_push_depth -= 2
+        if plan.negate:
+            self._emit_negate_d()
+        return True
+
+    def _try_generate_constant_multiply(
+        self, expr: BinaryExpression, op: BinaryOperator
+    ) -> bool:
+        """
+        Try to compile x * c or c * x for a constant c without __mul16.
+
+        x * 10 becomes LDD x / ASLD / ASLD / ADDD x / ASLD, reading x again
+        where it lives when it is a variable, from the stack otherwise.
+
+        Returns:
+            True if handled, False to use the runtime multiply
+        """
+        if op != BinaryOperator.MULTIPLY:
+            return False
+        multiplier = self._try_eval_constant(expr.right)
+        operand = expr.left
+        if multiplier is None:
+            multiplier = self._try_eval_constant(expr.left)
+            operand = expr.right
+        if multiplier is None or plan_multiply(multiplier) is None:
+            return False
+
+        self._generate_expression(operand)
+        source = None
+        if self._is_direct_operand(operand, 2):
+            source = self._direct_operands(operand)[0]
+        self._emit_constant_multiply(multiplier, source)
+        self._last_expr_size = 2
+        return True
+
+    def _try_generate_constant_shift(
+        self, expr: BinaryExpression, op: BinaryOperator
+    ) -> bool:
+        """
+        Try to compile x << c and x >> c for a constant c in line.
+
+        A left shift is c ASLDs; by 8 or more the low byte first moves to
+        the high byte (TBA / CLRB). A right shift is LSRD for unsigned
+        values and ASRA / RORB, which keeps the sign, otherwise. As in
+        the runtime, only the low 4 bits of c count.
+
+        Returns:
+            True if handled, False to use the runtime shift
+        """
+        if op not in (BinaryOperator.LEFT_SHIFT, BinaryOperator.RIGHT_SHIFT):
+            return False
+        count = self._try_eval_constant(expr.right)
+        if count is None:
+            return False
+        count &= 0xF
+
+        self._generate_expression(expr.left)
+        if op == BinaryOperator.LEFT_SHIFT:
+            if count >= 8:
+                self._emit_instruction("TBA", "")
+                self._emit_instruction("CLRB", "")
+                count -= 8
+            for _ in range(count):
+                self._emit_instruction("ASLD", "")
+        elif self._is_unsigned_operand(expr.left):
+            for _ in range(count):
+                self._emit_instruction("LSRD", "")
+        else:
+            for _ in range(count):
+                self._emit_instruction("ASRA", "")
+                self._emit_instruction("RORB", "")
+        self._last_expr_size = 2
+        return True
+
+    def _is_unsigned_operand(self, expr: Expression) -> bool:
+        """
+        Check if an operand is unsigned (and shifts right logically).
+
+        Unsigned types and pointers are unsigned, and so is char, which is
+        always zero-extended into D.
+        """
+        ctype = self._get_expression_type(expr)
+        return ctype.is_unsigned or ctype.is_pointer or self._is_char_type(ctype)
+
+    def _is_unsigned_division(self, left: Expression, right: Expression) -> bool:
+        """
+        Check if left / right and left % right divide as unsigned.
+
+        As in C's usual arithmetic conversions, the operation is unsigned
+        when either operand is. A char may only be divided by a char, so
+        both are then zero-extended and unsigned division gives the same
+        result as signed.
+        """
+        return self._is_unsigned_operand(left) or self._is_unsigned_operand(right)
+
+    # =========================================================================
+    # Division by Constant
+    # =========================================================================
+    #
+    # x / c for a constant c is computed as a multiply by a fixed-point
+    # reciprocal of c followed by a right shift:
+    #
+    #     x / c  ==  (x * m) >> (16 + s)
+    #
+    # __umulh16 returns the high word of the 32-bit product, so this costs one
+    # call plus s shifts instead of a 16-step division loop. x % c follows as
+    # x - (x / c) * c.
+    #
+    # Signed dividends are divided by magnitude and the sign is put back on
+    # the quotient afterwards, which gives C's round-toward-zero results.
+    # =========================================================================
+
+    @staticmethod
+    def _division_magic(divisor: int, max_dividend: int) -> tuple[int, int]:
+        """
+        Find the reciprocal multiplier m and extra shift s for a divisor.
+
+        Returns the smallest s for which floor(x * m / 2^(16+s)) equals
+        x // divisor for every 0 <= x <= max_dividend, with
+        m = ceil(2^(16+s) / divisor). m may need 17 bits.
+
+        The error e = m*divisor - 2^(16+s) adds x*e / (divisor * 2^(16+s))
+        to the exact quotient, which cannot reach the next integer while
+        x*e < 2^(16+s).
+        """
+        shift = 0
+        while True:
+            k = 16 + shift
+            multiplier = -(-(1 << k) // divisor)
+            error = multiplier * divisor - (1 << k)
+            if max_dividend * error < (1 << k):
+                return multiplier, shift
+            shift += 1
+
+    def _emit_unsigned_constant_divide(self, divisor: int, max_dividend: int) -> None:
+        """Divide the unsigned value in D by a constant, leaving the quotient in D."""
+        if self._is_power_of_2(divisor):
+            for _ in range(self._log2(divisor)):
+                self._emit_instruction("LSRD", "")
+            return
+
+        multiplier, shift = self._division_magic(divisor, max_dividend)
+        if multiplier <= 0xFFFF:
+            self._emit_instruction("LDX", f"#{multiplier}")
+            self._emit_instruction("JSR", "__umulh16")
+        else:
+            # 17-bit multiplier: (x * m) >> 16 == x + ((x * (m - 2^16)) >> 16),
+            # summed with its carry and shifted once through RORA/RORB
+            self._emit_instruction("PSHB", "")
+            self._emit_instruction("PSHA", "")
+            self._emit_instruction("LDX", f"#{multiplier - 0x10000}")
+            self._emit_instruction("JSR", "__umulh16")
+            self._emit_load_sp()
+            self._emit_instruction("ADDD", "0,X")
+            self._emit_instruction("RORA", "")
+            self._emit_instruction("RORB", "")
+            self._emit_instruction("INS", "")
+            self._emit_instruction("INS", "")
+            shift -= 1
+        for _ in range(shift):
+            self._emit_instruction("LSRD", "")
+
+    def _emit_constant_divide(self, divisor: int, unsigned: bool) -> None:
+        """
+        Divide the value in D by a constant, leaving the quotient in D.
+
+        Args:
+            divisor: The divisor as a 16-bit value (not 0)
+            unsigned: True to divide as unsigned, False for signed int
+        """
+        if unsigned:
+            self._emit_unsigned_constant_divide(divisor, 0xFFFF)
+            return
+
+        negative_divisor = divisor >= 0x8000
+        magnitude = (0x10000 - divisor) if negative_divisor else divisor
+        pos_label = self._new_label("sdpos")
+        end_label = self._new_label("sdend")
+
+        # Divide |x| (at most 32768) and keep the dividend sign on the stack
+        self._emit_instruction("PSHA", "")
+        self._emit_instruction("TSTA", "")
+        self._emit_instruction("BPL", pos_label)
+        self._emit_negate_d()
+        self._emit_label(pos_label)
+        self._emit_unsigned_constant_divide(magnitude, 0x8000)
+
+        # Negate the quotient when exactly one operand was negative
+        self._emit_load_sp()
+        self._emit_instruction("TST", "0,X")
+        self._emit_instruction("INS", "")
+        self._emit_instruction("BMI" if negative_divisor else "BPL", end_label)
+        self._emit_negate_d()
+        self._emit_label(end_label)
+
+    def _emit_negate_d(self) -> None:
+        """Two's complement negate D."""
+        self._emit_instruction("COMA", "")
+        self._emit_instruction("COMB", "")
+        self._emit_instruction("ADDD", "#1")
+
+    def _try_generate_constant_division(
+        self, expr: BinaryExpression, op: BinaryOperator
+    ) -> bool:
+        """
+        Try to compile x / c and x % c for a constant c without __div16.
+
+        Args:
+            expr: The binary expression
+            op: DIVIDE or MODULO operator
+
+        Returns:
+            True if handled, False to use the runtime division
+        """
+        if op not in (BinaryOperator.DIVIDE, BinaryOperator.MODULO):
+            return False
+
+        divisor = self._try_eval_constant(expr.right)
+        unsigned = self._is_unsigned_division(expr.left, expr.right)
+        if divisor is None or divisor == 0:
+            return False
+        if not unsigned and divisor == 0x8000:
+            return False  # -32768 has no positive magnitude
+
+        self._generate_expression(expr.left)
+
+        if op == BinaryOperator.DIVIDE:
+            self._emit_constant_divide(divisor, unsigned)
+            self._last_expr_size = 2
+            return True
+
+        if unsigned and self._is_power_of_2(divisor):
+            # x % 2^k is a mask
+            mask = divisor - 1
+            self._emit_instruction("ANDA", f"#{mask >> 8}")
+            self._emit_instruction("ANDB", f"#{mask & 0xFF}")
+            self._last_expr_size = 2
+            return True
+
+        # x % c = x - (x / c) * c
+        self._emit_instruction("PSHB", "")
+        self._emit_instruction("PSHA", "")
+        self._emit_constant_divide(divisor, unsigned)
+        if not self._emit_constant_multiply(divisor):
+            self._emit_instruction("LDX", f"#{divisor}")
+            self._emit_instruction("JSR", "__mul16")
+        self._emit_negate_d()
+        self._emit_load_sp()
+        self._emit_instruction("ADDD", "0,X")
+        self._emit_instruction("INS", "")
+        self._emit_instruction("INS", "")
 
         self._last_expr_size = 2
         return True
@@ -2394,6 +3210,12 @@ class CodeGenerator(ASTVisitor):
             return
         if self._try_generate_power_of_2_optimization(expr, op):
             return
+        if self._try_generate_constant_multiply(expr, op):
+            return
+        if self._try_generate_constant_shift(expr, op):
+            return
+        if self._try_generate_constant_division(expr, op):
+            return
 
         # Phase 3: Standard code generation path
         self._generate_binary_by_type(expr, op, left_type, right_type)
@@ -2423,6 +3245,26 @@ class CodeGenerator(ASTVisitor):
             expr: The binary expression (both operands must be char)
             op: The operator (must be in _CHAR_SUPPORTED_OPS)
         """
+        char_ops = {
+            BinaryOperator.ADD: "ADDB",
+            BinaryOperator.SUBTRACT: "SUBB",
+            BinaryOperator.BITWISE_AND: "ANDB",
+            BinaryOperator.BITWISE_OR: "ORAB",
+            BinaryOperator.BITWISE_XOR: "EORB",
+        }
+
+        left, right = expr.left, expr.right
+        if not self._is_direct_operand(right, 1) and op != BinaryOperator.SUBTRACT \
+                and self._is_direct_operand(left, 1):
+            left, right = right, left
+        if self._is_direct_operand(right, 1):
+            # Constant or char variable: operate on it in place
+            self._generate_expression(left)
+            self._emit_instruction(char_ops[op], self._direct_char_operand(right))
+            self._emit_instruction("CLRA", "")
+            self._last_expr_size = 1
+            return
+
         # Generate right operand first (result in B, A=0)
         self._generate_expression(expr.right)
         # Push only B (1 byte) - more efficient than 16-bit push
@@ -2558,6 +3400,16 @@ class CodeGenerator(ASTVisitor):
             expr: The binary expression
             op: The operator
         """
+        if op not in (BinaryOperator.LEFT_SHIFT, BinaryOperator.RIGHT_SHIFT):
+            if self._is_direct_operand(expr.right, 2):
+                self._generate_binary_int_direct(expr.left, op, expr.right)
+                return
+            if op in self._SWAPPED_OPS and self._is_direct_operand(expr.left, 2):
+                # e.g. n + f(x): evaluate f(x), then add n in place
+                self._generate_binary_int_direct(
+                    expr.right, self._SWAPPED_OPS[op], expr.left)
+                return
+
         # Generate right operand (result in D)
         self._generate_expression(expr.right)
         # Push 2 bytes to stack
@@ -2581,14 +3433,11 @@ class CodeGenerator(ASTVisitor):
             self._emit_load_sp()
             self._emit_instruction("LDX", "0,X")
             self._emit_instruction("JSR", "__mul16")
-        elif op == BinaryOperator.DIVIDE:
+        elif op in (BinaryOperator.DIVIDE, BinaryOperator.MODULO):
             self._emit_load_sp()
             self._emit_instruction("LDX", "0,X")
-            self._emit_instruction("JSR", "__div16")
-        elif op == BinaryOperator.MODULO:
-            self._emit_load_sp()
-            self._emit_instruction("LDX", "0,X")
-            self._emit_instruction("JSR", "__mod16")
+            self._emit_runtime_division(
+                op, self._is_unsigned_division(expr.left, expr.right))
         elif op == BinaryOperator.BITWISE_AND:
             self._emit_load_sp()
             self._emit_instruction("ANDA", "0,X")   # High byte
@@ -2620,6 +3469,81 @@ class CodeGenerator(ASTVisitor):
         # Mark result as 16-bit
         self._last_expr_size = 2
 
+    def _emit_runtime_division(self, op: BinaryOperator, unsigned: bool) -> None:
+        """
+        Divide D by X with the runtime, leaving the quotient or remainder in D.
+
+        Signed operands use __div16/__mod16. Unsigned ones use __udiv16,
+        which leaves the remainder in __div16_rem.
+        """
+        if not unsigned:
+            helper = "__div16" if op == BinaryOperator.DIVIDE else "__mod16"
+            self._emit_instruction("JSR", helper)
+            return
+        self._emit_instruction("JSR", "__udiv16")
+        if op == BinaryOperator.MODULO:
+            self._emit_instruction("LDD", "__div16_rem")
+
+    # Operators whose operands may be exchanged, with the operator to use
+    # after the exchange
+    _SWAPPED_OPS = {
+        BinaryOperator.ADD: BinaryOperator.ADD,
+        BinaryOperator.MULTIPLY: BinaryOperator.MULTIPLY,
+        BinaryOperator.BITWISE_AND: BinaryOperator.BITWISE_AND,
+        BinaryOperator.BITWISE_OR: BinaryOperator.BITWISE_OR,
+        BinaryOperator.BITWISE_XOR: BinaryOperator.BITWISE_XOR,
+        BinaryOperator.EQUAL: BinaryOperator.EQUAL,
+        BinaryOperator.NOT_EQUAL: BinaryOperator.NOT_EQUAL,
+        BinaryOperator.LESS: BinaryOperator.GREATER,
+        BinaryOperator.GREATER: BinaryOperator.LESS,
+        BinaryOperator.LESS_EQ: BinaryOperator.GREATER_EQ,
+        BinaryOperator.GREATER_EQ: BinaryOperator.LESS_EQ,
+    }
+
+    def _generate_binary_int_direct(
+        self,
+        left: Expression,
+        op: BinaryOperator,
+        right: Expression
+    ) -> None:
+        """
+        Generate 16-bit code for left OP right where right is a constant or
+        an int variable.
+
+        The left operand is evaluated into D and the right one is addressed
+        where it lives, so nothing is pushed:
+
+            LDD  left          LDD  left
+            ADDD 4,X           LDX  _count
+                               JSR  __mul16
+        """
+        self._generate_expression(left)
+        word, high, low = self._direct_operands(right)
+
+        if op == BinaryOperator.ADD:
+            self._emit_instruction("ADDD", word)
+        elif op == BinaryOperator.SUBTRACT:
+            self._emit_instruction("SUBD", word)
+        elif op == BinaryOperator.MULTIPLY:
+            self._emit_instruction("LDX", word)
+            self._emit_instruction("JSR", "__mul16")
+        elif op in (BinaryOperator.DIVIDE, BinaryOperator.MODULO):
+            self._emit_instruction("LDX", word)
+            self._emit_runtime_division(op, self._is_unsigned_division(left, right))
+        elif op == BinaryOperator.BITWISE_AND:
+            self._emit_instruction("ANDA", high)
+            self._emit_instruction("ANDB", low)
+        elif op == BinaryOperator.BITWISE_OR:
+            self._emit_instruction("ORAA", high)
+            self._emit_instruction("ORAB", low)
+        elif op == BinaryOperator.BITWISE_XOR:
+            self._emit_instruction("EORA", high)
+            self._emit_instruction("EORB", low)
+        elif op in self._COMPARISON_OPS:
+            self._generate_comparison(op, word)
+
+        self._last_expr_size = 2
+
     def _generate_comparison_immediate_char(self, op: BinaryOperator, value: int) -> None:
         """
         Generate 8-bit comparison with immediate value.
@@ -2655,16 +3579,21 @@ class CodeGenerator(ASTVisitor):
         self._emit_instruction("LDD", "#1")   # True (16-bit result)
         self._emit_label(end_label)
 
-    def _generate_comparison(self, op: BinaryOperator) -> None:
-        """Generate code for comparison operators."""
+    def _generate_comparison(self, op: BinaryOperator, operand: Optional[str] = None) -> None:
+        """
+        Generate code for comparison operators.
+
+        Compares D with the stack top, or with operand when given.
+        """
         true_label = self._new_label("true")
         end_label = self._new_label("cmpend")
 
-        # Compare D with stack top
         # Note: SUBD sets identical flags as CPD, and D is immediately
         # overwritten with boolean result (0 or 1), so modification is fine
-        self._emit_load_sp()
-        self._emit_instruction("SUBD", "0,X")
+        if operand is None:
+            self._emit_load_sp()
+            operand = "0,X"
+        self._emit_instruction("SUBD", operand)
 
         # Branch on condition
         branch_map = {
@@ -2804,9 +3733,7 @@ class CodeGenerator(ASTVisitor):
                     # we're in the middle of pushing function arguments.
                     # Compensate by adding _arg_push_depth to the offset.
                     adjusted_offset = info.offset + self._arg_push_depth
-                    self._emit_instruction("TSX", "")
-                    self._emit_instruction("XGDX", "")
-                    self._emit_instruction("ADDD", f"#{adjusted_offset}")
+                    self._emit_sp_address(adjusted_offset)
             self._last_expr_size = 2  # Addresses are always 16-bit
 
         elif op == UnaryOperator.DEREFERENCE:
@@ -2847,17 +3774,20 @@ class CodeGenerator(ASTVisitor):
         info = self._lookup(operand.name)
         if info is None:
             raise CCodeGenError(f"undefined variable '{operand.name}'", operand.location)
+        self._check_not_const(info, operand)
 
         # Load current value
+        local_offset = info.offset + self._arg_push_depth
         if info.is_global:
             self._emit_instruction("LDD", f"_{operand.name}")
         else:
-            self._emit_instruction("LDD", f"{info.offset},X")
+            self._emit_instruction("LDD", self._sp_operand(local_offset))
 
         if not is_pre:
-            # Post: save original value
+            # Post: save original value (two bytes further from SP)
             self._emit_instruction("PSHB", "")
             self._emit_instruction("PSHA", "")
+            local_offset += 2
 
         # Increment or decrement
         if is_increment:
@@ -2869,13 +3799,27 @@ class CodeGenerator(ASTVisitor):
         if info.is_global:
             self._emit_instruction("STD", f"_{operand.name}")
         else:
-            self._emit_instruction("STD", f"{info.offset},X")
+            self._emit_instruction("STD", self._sp_operand(local_offset))
 
         if not is_pre:
             # Post: restore original value as result
             self._emit_instruction("PULA", "")
             self._emit_instruction("PULB", "")
 
+    # Binary operator applied by each compound assignment
+    _COMPOUND_OPS = {
+        AssignmentOperator.ADD_ASSIGN: BinaryOperator.ADD,
+        AssignmentOperator.SUB_ASSIGN: BinaryOperator.SUBTRACT,
+        AssignmentOperator.MUL_ASSIGN: BinaryOperator.MULTIPLY,
+        AssignmentOperator.DIV_ASSIGN: BinaryOperator.DIVIDE,
+        AssignmentOperator.MOD_ASSIGN: BinaryOperator.MODULO,
+        AssignmentOperator.AND_ASSIGN: BinaryOperator.BITWISE_AND,
+        AssignmentOperator.OR_ASSIGN: BinaryOperator.BITWISE_OR,
+        AssignmentOperator.XOR_ASSIGN: BinaryOperator.BITWISE_XOR,
+        AssignmentOperator.LSHIFT_ASSIGN: BinaryOperator.LEFT_SHIFT,
+        AssignmentOperator.RSHIFT_ASSIGN: BinaryOperator.RIGHT_SHIFT,
+    }
+
     def _generate_assignment(self, expr: AssignmentExpression) -> None:
         """Generate code for assignment expression."""
         # =========================================================================
@@ -2888,41 +3832,24 @@ class CodeGenerator(ASTVisitor):
         # and produce incorrect code.
         self._get_expression_type(expr.value)
 
-        # Generate the value
-        self._generate_expression(expr.value)
-
-        # For compound assignments, need to combine with current value
-        if expr.operator != AssignmentOperator.ASSIGN:
-            self._emit_instruction("PSHB", "")
-            self._emit_instruction("PSHA", "")
-            self._generate_expression(expr.target)
-
-            # Apply operator
-            op_map = {
-                AssignmentOperator.ADD_ASSIGN: BinaryOperator.ADD,
-                AssignmentOperator.SUB_ASSIGN: BinaryOperator.SUBTRACT,
-                AssignmentOperator.MUL_ASSIGN: BinaryOperator.MULTIPLY,
-                AssignmentOperator.DIV_ASSIGN: BinaryOperator.DIVIDE,
-                AssignmentOperator.MOD_ASSIGN: BinaryOperator.MODULO,
-                AssignmentOperator.AND_ASSIGN: BinaryOperator.BITWISE_AND,
-                AssignmentOperator.OR_ASSIGN: BinaryOperator.BITWISE_OR,
-                AssignmentOperator.XOR_ASSIGN: BinaryOperator.BITWISE_XOR,
-                AssignmentOperator.LSHIFT_ASSIGN: BinaryOperator.LEFT_SHIFT,
-                AssignmentOperator.RSHIFT_ASSIGN: BinaryOperator.RIGHT_SHIFT,
-            }
-
-            # Create temporary binary expression for the operation
-            self._emit_load_sp()
-            bin_op = op_map[expr.operator]
-
-            if bin_op == BinaryOperator.ADD:
-                self._emit_instruction("ADDD", "0,X")
-            elif bin_op == BinaryOperator.SUBTRACT:
-                self._emit_instruction("SUBD", "0,X")
-            # ... other operators handled similarly
-
-            self._emit_instruction("INS", "")
-            self._emit_instruction("INS", "")
+        if expr.operator == AssignmentOperator.ASSIGN:
+            # Generate the value
+            self._generate_expression(expr.value)
+        else:
+            # x op= v is compiled as x = x op v, so it gets the same type
+            # checks and optimizations (x *= 10 needs no __mul16). The
+            # target is evaluated twice and must have no side effects.
+            if not is_pure(expr.target):
+                raise CCodeGenError(
+                    "target of compound assignment must not have side effects",
+                    expr.location,
+                )
+            self._generate_expression(BinaryExpression(
+                location=expr.location,
+                operator=self._COMPOUND_OPS[expr.operator],
+                left=expr.target,
+                right=expr.value,
+            ))
 
         # Store the result
         self._generate_store(expr.target)
@@ -2938,12 +3865,19 @@ class CodeGenerator(ASTVisitor):
         else:
             self._last_expr_size = 2  # Array/pointer deref - assume 16-bit
 
+    def _check_not_const(self, info: SymbolInfo, target: Expression) -> None:
+        """Reject a store to a const global that reads fold to a constant."""
+        if info.constant is not None:
+            raise CCodeGenError(f"cannot assign to const variable '{info.name}'",
+                                target.location)
+
     def _generate_store(self, target: Expression) -> None:
         """Generate code to store D register to target."""
         if isinstance(target, IdentifierExpression):
             info = self._lookup(target.name)
             if info is None:
                 raise CCodeGenError(f"undefined variable '{target.name}'", target.location)
+            self._check_not_const(info, target)
 
             if info.is_global:
                 if info.sym_type.size == 1:
@@ -2951,12 +3885,12 @@ class CodeGenerator(ASTVisitor):
                 else:
                     self._emit_instruction("STD", f"_{target.name}")
             else:
-                # Refresh frame pointer - X may have been corrupted by expression evaluation
-                self._emit_instruction("TSX", "")
+                # Refresh frame pointer if X may have been corrupted by expression evaluation
+                operand = self._sp_operand(info.offset + self._arg_push_depth)
                 if info.sym_type.size == 1:
-                    self._emit_instruction("STAB", f"{info.offset},X")
+                    self._emit_instruction("STAB", operand)
                 else:
-                    self._emit_instruction("STD", f"{info.offset},X")
+                    self._emit_instruction("STD", operand)
 
         elif isinstance(target, ArraySubscript):
             # Store to array element
@@ -3148,6 +4082,14 @@ class CodeGenerator(ASTVisitor):
         # =====================================================================
         # Regular C function call
         # =====================================================================
+        # Small constant-size memcpy()/struct_copy() are expanded inline
+        if self._try_generate_inline_copy(expr):
+            return
+
+        # So are calls to small functions at opt_level 2
+        if self._try_generate_inline_call(expr):
+            return
+
         # Push arguments right-to-left
         # Track push depth so local address calculations can compensate
         saved_push_depth = self._arg_push_depth
@@ -3169,6 +4111,162 @@ class CodeGenerator(ASTVisitor):
         # Function calls return 16-bit values in D
         self._last_expr_size = 2
 
+    def _try_generate_inline_call(self, expr: CallExpression) -> bool:
+        """
+        Replace a call to an inline candidate by the function's body.
+
+        The body is copied with each parameter replaced by its argument,
+        cast to the parameter type when the types differ. An argument the
+        body uses more than once is evaluated first and pushed, like a
+        call would, unless it is a constant or a variable; the body then
+        reads it from the stack. See inliner.py for when inlining keeps
+        the meaning of the call.
+
+        Returns:
+            True if the call was generated inline
+        """
+        candidate = self._inline_candidates.get(expr.function_name)
+        if candidate is None or len(expr.arguments) != len(candidate.parameters):
+            return False
+        # A caller's local would capture a global the body refers to
+        if any(name in self._locals for name in candidate.free_names):
+            return False
+        # Calls to other candidates that return a value have no side effects
+        pure_funcs = {name for name, other in self._inline_candidates.items()
+                      if other.returns_value}
+        if not all(is_pure(arg, pure_funcs) for arg in expr.arguments):
+            return False
+
+        pushed = []
+        replacements = {}
+        for param, arg in zip(candidate.parameters, expr.arguments):
+            if candidate.uses(param.name) > 1 and not is_simple(arg):
+                pushed.append(param)
+                continue
+            arg_type = self._get_expression_type(arg)
+            if arg_type != param.param_type:
+                if not (arg_type.is_integer and not arg_type.is_array
+                        and param.param_type.is_integer):
+                    # Pointer arithmetic, subscripts and member access look at
+                    # the declared type of a named pointer, so it must match
+                    return False
+                arg = CastExpression(location=arg.location,
+                                     target_type=param.param_type, expression=arg)
+            replacements[param.name] = arg
+
+        self._emit_comment(f"Inlined call: {expr.function_name}")
+
+        # Push the arguments used more than once, right-to-left as for a
+        # call, and give each a stack slot the body refers to by name.
+        # The names cannot clash with C identifiers.
+        saved_push_depth = self._arg_push_depth
+        temps = []
+        for param in reversed(pushed):
+            arg = expr.arguments[candidate.parameters.index(param)]
+            self._generate_expression(arg)
+            self._emit_instruction("PSHB", "")
+            self._emit_instruction("PSHA", "")
+            self._arg_push_depth += 2
+            temp = f"{param.name}@{self._new_label(expr.function_name)}"
+            ptype = param.param_type
+            is_char = ptype.base_type == BaseType.CHAR and not ptype.is_pointer
+            self._locals[temp] = SymbolInfo(
+                name=temp,
+                sym_type=ptype,
+                offset=-self._arg_push_depth + (1 if is_char else 0),
+                is_parameter=True,
+            )
+            temps.append(temp)
+            replacements[param.name] = IdentifierExpression(location=arg.location, name=temp)
+
+        if candidate.body is None:
+            self._last_expr_size = 2  # Empty void function: nothing to do
+        else:
+            self._generate_expression(substitute(candidate.body, replacements))
+
+        for temp in temps:
+            self._emit_instruction("INS", "")
+            self._emit_instruction("INS", "")
+            del self._locals[temp]
+        self._arg_push_depth = saved_push_depth
+        return True
+
+    def _try_generate_inline_copy(self, expr: CallExpression) -> bool:
+        """
+        Try to expand memcpy()/struct_copy() with a small constant size inline.
+
+        The source is copied onto the stack a word at a time, last word
+        first, then pulled back off in order and stored through the
+        destination pointer:
+
+            <src>               ; D = src
+            XGDX                ; X = src
+            LDD  n-2,X          ; push words, last first
+            PSHB / PSHA
+            ...
+            <dest>              ; D = dest
+            XGDX                ; X = dest
+            PULA / PULB         ; pull words, first first
+            STD  0,X
+            ...
+            XGDX                ; D = dest (the return value)
+
+        An odd final byte goes through LDAB/PSHB and PULB/STAB. Arguments
+        are evaluated src before dest, as for a real call.
+
+        A program that defines its own memcpy() or struct_copy() always
+        gets a real call.
+
+        Args:
+            expr: The call expression
+
+        Returns:
+            True if handled, False to emit a normal call
+        """
+        name = expr.function_name
+        if name not in self._INLINE_COPY_FUNCS or len(expr.arguments) != 3:
+            return False
+        user_func = self._c_funcs.get(name)
+        if user_func is not None and not user_func.is_forward_decl:
+            return False
+
+        dest, src, size_expr = expr.arguments
+        size = self._try_eval_constant(size_expr)
+        if size is None or not 0 < size <= self._INLINE_COPY_MAX:
+            return False
+
+        self._emit_comment(f"Inline {name}: {size} bytes")
+        words = range(0, size & ~1, 2)
+
+        # Stage the source bytes on the stack
+        self._generate_expression(src)
+        self._emit_instruction("XGDX", "")
+        if size & 1:
+            self._emit_instruction("LDAB", f"{size - 1},X")
+            self._emit_instruction("PSHB", "")
+        for offset in reversed(words):
+            self._emit_instruction("LDD", f"{offset},X")
+            self._emit_instruction("PSHB", "")
+            self._emit_instruction("PSHA", "")
+
+        # Store them through dest; the staged bytes shift local offsets
+        saved_push_depth = self._arg_push_depth
+        self._arg_push_depth += size
+        self._generate_expression(dest)
+        self._arg_push_depth = saved_push_depth
+        self._emit_instruction("XGDX", "")
+        for offset in words:
+            self._emit_instruction("PULA", "")
+            self._emit_instruction("PULB", "")
+            self._emit_instruction("STD", f"{offset},X")
+        if size & 1:
+            self._emit_instruction("PULB", "")
+            self._emit_instruction("STAB", f"{size - 1},X")
+        self._emit_instruction("XGDX", "")
+
+        self._last_expr_size = 2
+        return True
+
     def _generate_subscript(self, expr: ArraySubscript) -> None:
         """Generate code for array subscript (load value)."""
         self._generate_subscript_address(expr)
@@ -3184,6 +4282,9 @@ class CodeGenerator(ASTVisitor):
 
     def _generate_subscript_address(self, expr: ArraySubscript) -> None:
         """Generate address of array element into X register."""
+        if self._register_aware and self._try_generate_subscript_direct(expr):
+            return
+
         # Get array base address
         if isinstance(expr.array, IdentifierExpression):
             info = self._lookup(expr.array.name)
@@ -3200,15 +4301,12 @@ class CodeGenerator(ASTVisitor):
                 if info.sym_type.is_array:
                     # Local array: compute address as frame + offset
                     adjusted_offset = info.offset + self._arg_push_depth
-                    self._emit_instruction("TSX", "")
-                    self._emit_instruction("XGDX", "")
-                    self._emit_instruction("ADDD", f"#{adjusted_offset}")
+                    self._emit_sp_address(adjusted_offset)
                     self._emit_instruction("XGDX", "")
                 else:
                     # Local pointer: load pointer VALUE from stack
                     adjusted_offset = info.offset + self._arg_push_depth
-                    self._emit_instruction("TSX", "")
-                    self._emit_instruction("LDX", f"{adjusted_offset},X")
+                    self._emit_instruction("LDX", self._sp_operand(adjusted_offset))
         else:
             # Pointer expression
             self._generate_expression(expr.array)
@@ -3218,13 +4316,9 @@ class CodeGenerator(ASTVisitor):
         self._emit_instruction("PSHX", "")
         self._arg_push_depth += 2  # Track this temporary push
 
-        # Generate index
-        self._generate_expression(expr.index)
-
-        # Multiply by element size: char=1 (no multiply), int/ptr=2 (ASLD)
-        element_size = self._get_array_element_size(expr)
-        if element_size == 2:
-            self._emit_instruction("ASLD", "")  # * 2 for int/pointer arrays
+        # Index times element size: char=1 (no multiply), int/ptr=2 (ASLD),
+        # structs a shift/add sequence
+        self._generate_scaled_index(expr, self._get_array_element_size(expr))
 
         # Add to base
         self._emit_load_sp()
@@ -3234,6 +4328,83 @@ class CodeGenerator(ASTVisitor):
         self._arg_push_depth -= 2  # Restore push depth
         self._emit_instruction("XGDX", "")
 
+    def _emit_index_scale(self, element_size: int, operand: Optional[str] = None) -> None:
+        """
+        Multiply the index in D by an element size.
+
+        Args:
+            element_size: Bytes per element
+            operand: Where the index can be read again (see
+                     _emit_constant_multiply)
+        """
+        if element_size != 1 and not self._emit_constant_multiply(element_size, operand):
+            self._emit_instruction("LDX", f"#{element_size}")
+            self._emit_instruction("JSR", "__mul16")
+
+    def _generate_scaled_index(self, expr: ArraySubscript, element_size: int) -> None:
+        """
+        Evaluate a subscript's index times the element size into D.
+
+        Inside a loop whose counter is kept scaled (see _generate_for), the
+        scaled copy is loaded instead.
+        """
+        if isinstance(expr.index, IdentifierExpression):
+            slot = self._scaled_counters.get(expr.index.name, {}).get(element_size)
+            if slot is not None:
+                self._generate_identifier(
+                    IdentifierExpression(location=expr.index.location, name=slot))
+                return
+        self._generate_expression(expr.index)
+        operand = None
+        if self._is_direct_operand(expr.index, 2):
+            operand = self._direct_operands(expr.index)[0]
+        self._emit_index_scale(element_size, operand)
+
+    def _try_generate_subscript_direct(self, expr: ArraySubscript) -> bool:
+        """
+        Element address for a named array or pointer without a base push.
+
+        A constant index folds into the base address. Otherwise the index
+        is scaled in D and the base added straight from memory, which works
+        for every named base except a local array (its address is SP
+        relative, and D can't be added to X).
+
+        Returns:
+            True if handled, False to use the general path
+        """
+        if not isinstance(expr.array, IdentifierExpression):
+            return False
+        info = self._lookup(expr.array.name)
+        if info is None:
+            return False
+        element_size = self._get_array_element_size(expr)
+        index = self._try_eval_constant(expr.index)
+
+        if index is not None:
+            byte_offset = (index * element_size) & 0xFFFF
+            if info.sym_type.is_array and info.is_global:
+                target = f"_{expr.array.name}+{byte_offset}" if byte_offset else f"_{expr.array.name}"
+                self._emit_instruction("LDX", f"#{target}")
+                return True
+            if info.sym_type.is_array:
+                self._emit_sp_address(info.offset + self._arg_push_depth + byte_offset)
+            else:
+                self._emit_instruction("LDD", self._direct_operands(expr.array)[0])
+                if byte_offset:
+                    self._emit_instruction("ADDD", f"#{byte_offset}")
+            self._emit_instruction("XGDX", "")
+            return True
+
+        if info.sym_type.is_array and not info.is_global:
+            return False
+        self._generate_scaled_index(expr, element_size)
+        if info.sym_type.is_array:
+            self._emit_instruction("ADDD", f"#_{expr.array.name}")
+        else:
+            self._emit_instruction("ADDD", self._direct_operands(expr.array)[0])
+        self._emit_instruction("XGDX", "")
+        return True
+
     def _generate_ternary(self, expr: TernaryExpression) -> None:
         """Generate code for ternary expression."""
         else_label = self._new_label("tern_e")
@@ -3270,21 +4441,23 @@ class CodeGenerator(ASTVisitor):
         else:
             self._last_expr_size = 2  # Cast to int/ptr: full D register
 
+    def _sizeof_type(self, ctype: CType) -> int:
+        """Size in bytes of a type named in sizeof(type)."""
+        # Use the type's size property, which handles structs via size_resolver
+        if ctype.struct_name and ctype.struct_name in self._structs:
+            # Struct type - get size from our struct table
+            struct_info = self._structs[ctype.struct_name]
+            if ctype.is_array:
+                return struct_info.size * ctype.array_size
+            elif ctype.is_pointer:
+                return 2  # Pointer to struct
+            return struct_info.size
+        return ctype.size
+
     def _generate_sizeof(self, expr: SizeofExpression) -> None:
         """Generate code for sizeof expression."""
         if expr.target_type:
-            # Use the type's size property, which handles structs via size_resolver
-            if expr.target_type.struct_name and expr.target_type.struct_name in self._structs:
-                # Struct type - get size from our struct table
-                struct_info = self._structs[expr.target_type.struct_name]
-                if expr.target_type.is_array:
-                    size = struct_info.size * expr.target_type.array_size
-                elif expr.target_type.is_pointer:
-                    size = 2  # Pointer to struct
-                else:
-                    size = struct_info.size
-            else:
-                size = expr.target_type.size
+            size = self._sizeof_type(expr.target_type)
         else:
             # sizeof(expr) - would need type analysis to determine expression type
             size = 2  # Default to int size
@@ -3336,6 +4509,9 @@ class CodeGenerator(ASTVisitor):
             self._generate_expression(expr.object_expr)
             # Transfer D to X for indexed addressing
             self._emit_instruction("XGDX", "")  # Exchange D and X
+        elif isinstance(expr.object_expr, ArraySubscript):
+            # Array element: its address is computed straight into X
+            self._generate_subscript_address(expr.object_expr)
         else:
             # Dot operator: need address of the struct variable
             self._generate_member_address(expr.object_expr)
@@ -3411,18 +4587,17 @@ class CodeGenerator(ASTVisitor):
                 # Local: compute address from frame pointer
                 # Compensate for any bytes pushed during argument generation
                 adjusted_offset = info.offset + self._arg_push_depth
-                self._emit_instruction("TSX", "")  # X = SP
-                if adjusted_offset == 0:
-                    self._emit_instruction("XGDX", "")  # D = X
-                else:
-                    self._emit_instruction("XGDX", "")  # D = X
-                    self._emit_instruction("ADDD", f"#{adjusted_offset}")  # D = X + offset
+                self._emit_sp_address(adjusted_offset)  # D = SP + offset
         elif isinstance(expr, MemberAccessExpression):
             # Nested member access: compute address of the nested member
             self._generate_member_access_address(expr)
         elif isinstance(expr, ArraySubscript):
-            # Array element: compute address
+            # Array element: the address is computed into X, usually from D
             self._generate_subscript_address(expr)
+            if self._output[-1] == "        XGDX":
+                self._output.pop()  # Leave it in D
+            else:
+                self._emit_instruction("XGDX", "")
         else:
             raise CCodeGenError(
                 "cannot take address of expression", expr.location
@@ -82,6 +82,12 @@ class CompilerOptions:
 
                      This is used by psbuild when compiling multiple C files:
                      only the file containing main() should have emit_runtime=True.
+        opt_level: Code generator optimization level. 0 gives the plain
+                     push/pop code, which can help when debugging codegen.
+                     1 (default) tracks what X holds across expressions,
+                     skipping redundant frame pointer reloads and using
+                     simple operands in place. 2 also inlines small
+                     functions and gives leaf functions no frame.
     """
     include_paths: list[str] = None
     output_comments: bool = True
@@ -89,6 +95,7 @@ class CompilerOptions:
     debug_info: bool = False
     target_model: Optional[str] = None  # None = allow pragma to override, default is XP
     emit_runtime: bool = True  # False = library mode (no runtime includes, no entry point)
+    opt_level: int = 1
 
     def __post_init__(self):
         if self.include_paths is None:
@@ -120,6 +127,7 @@ class SmallCCompiler:
         """
         self.options = options or CompilerOptions()
         self._errors = CErrorCollector()
+        self._dependencies: list[str] = []
 
     def compile_source(self, source: str, filename: str = "<input>") -> "CompilerResult":
         """
@@ -141,9 +149,11 @@ class SmallCCompiler:
         try:
             # Stage 1: Preprocessing
             # Returns preprocessed source, effective target model, and optional library flags
-            preprocessed, effective_model, has_float_support, has_stdio_support, has_db_support = self._preprocess(source, filename)
+            (preprocessed, effective_model, has_float_support, has_stdio_support,
+             has_db_support, has_fixed_support, has_fb_support) = self._preprocess(source, filename)
             result.preprocessed_source = preprocessed
             result.target_model = effective_model
+            result.dependencies = self._dependencies
 
             # Stage 2: Lexical analysis
             tokens = self._lex(preprocessed, filename)
@@ -157,7 +167,8 @@ class SmallCCompiler:
             # emit_runtime=False enables "library mode" for multi-file linking
             assembly = self._generate(
                 ast, effective_model, has_float_support, has_stdio_support,
-                has_db_support, emit_runtime=self.options.emit_runtime
+                has_db_support, has_fixed_support, has_fb_support,
+                emit_runtime=self.options.emit_runtime
             )
             result.assembly = assembly
             result.success = True
@@ -205,7 +216,7 @@ class SmallCCompiler:
 
         return self.compile_source(source, filepath)
 
-    def _preprocess(self, source: str, filename: str) -> tuple[str, str, bool, bool, bool]:
+    def _preprocess(self, source: str, filename: str) -> tuple[str, str, bool, bool, bool, bool, bool]:
         """
         Run the preprocessor on source code.
 
@@ -215,7 +226,8 @@ class SmallCCompiler:
 
         Returns:
             Tuple of (preprocessed_source, effective_model, has_float_support,
-                      has_stdio_support, has_db_support)
+                      has_stdio_support, has_db_support, has_fixed_support,
+                      has_fb_support)
         """
         preprocessor = Preprocessor(
             source,
@@ -224,11 +236,15 @@ class SmallCCompiler:
             target_model=self.options.target_model,
         )
         preprocessed = preprocessor.process()
+        self._dependencies = preprocessor.get_dependencies()
         effective_model = preprocessor.get_effective_model()
         has_float_support = preprocessor.has_float_support()
         has_stdio_support = preprocessor.has_stdio_support()
         has_db_support = preprocessor.has_db_support()
-        return preprocessed, effective_model, has_float_support, has_stdio_support, has_db_support
+        has_fixed_support = preprocessor.has_fixed_support()
+        has_fb_support = preprocessor.has_fb_support()
+        return (preprocessed, effective_model, has_float_support, has_stdio_support,
+                has_db_support, has_fixed_support, has_fb_support)
 
     def _lex(self, source: str, filename: str) -> list:
         """Tokenize preprocessed source."""
@@ -243,7 +259,8 @@ class SmallCCompiler:
     def _generate(
         self, ast: ProgramNode, target_model: str = "XP",
         has_float_support: bool = False, has_stdio_support: bool = False,
-        has_db_support: bool = False, emit_runtime: bool = True
+        has_db_support: bool = False, has_fixed_support: bool = False,
+        has_fb_support: bool = False, emit_runtime: bool = True
     ) -> str:
         """
         Generate assembly from AST.
@@ -254,6 +271,8 @@ class SmallCCompiler:
             has_float_support: Whether float.h was included
             has_stdio_support: Whether stdio.h was included
             has_db_support: Whether db.h was included
+            has_fixed_support: Whether fixed.h was included
+            has_fb_support: Whether fb.h was included
             emit_runtime: Whether to emit runtime includes and entry point.
                          Set False for library mode (multi-file linking).
 
@@ -265,7 +284,10 @@ class SmallCCompiler:
             has_float_support=has_float_support,
             has_stdio_support=has_stdio_support,
             has_db_support=has_db_support,
-            emit_runtime=emit_runtime
+            has_fixed_support=has_fixed_support,
+            has_fb_support=has_fb_support,
+            emit_runtime=emit_runtime,
+            opt_level=self.options.opt_level,
         )
         return generator.generate(ast)
 
@@ -283,6 +305,7 @@ class CompilerResult:
         ast: Abstract syntax tree (if parsing succeeded)
         token_count: Number of tokens lexed
         target_model: Effective target Psion model (CM, XP, LA, LZ, LZ64)
+        dependencies: Resolved paths of the headers the source included
         errors: List of error messages
         warnings: List of warning messages
     """
@@ -293,10 +316,13 @@ class CompilerResult:
     ast: Optional[ProgramNode] = None
     token_count: int = 0
     target_model: str = ""  # Will be set during compilation
+    dependencies: list = None
     errors: list = None
     warnings: list = None
 
     def __post_init__(self):
+        if self.dependencies is None:
+            self.dependencies = []
         if self.errors is None:
             self.errors = []
         if self.warnings is None:
@@ -434,20 +460,27 @@ def parse_source_with_main_check(source: str, filename: str = "<input>",
     Raises:
         SmallCError: If the source has syntax errors
     """
-    from psion_sdk.smallc.ast import FunctionNode, ProgramNode
-
-    # Parse the source
     ast = parse_source(source, filename, include_paths)
+    return ast, program_has_main(ast)
+
+
+def program_has_main(ast: 'ProgramNode') -> bool:
+    """
+    Check whether a parsed program defines main().
+
+    Args:
+        ast: Parsed program, e.g. CompilerResult.ast
+
+    Returns:
+        True if the program has a main() definition (not just a prototype)
+    """
+    from psion_sdk.smallc.ast import FunctionNode
 
-    # Check for main() function definition
-    has_main = False
     for decl in ast.declarations:
         if isinstance(decl, FunctionNode):
             if decl.name == "main" and not decl.is_forward_decl and not decl.is_opl:
-                has_main = True
-                break
-
-    return ast, has_main
+                return True
+    return False
 
 
 def file_has_main(filepath: str) -> bool:
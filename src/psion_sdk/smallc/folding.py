@@ -0,0 +1,417 @@
+"""
+Small-C Constant Folding and Strength Reduction
+===============================================
+
+This module holds the compile-time arithmetic and the cost decisions
+the code generator uses to replace expensive operations by cheap ones.
+
+Constant Folding
+----------------
+fold_unary() and fold_binary() compute an operator on 16-bit constants
+exactly as the generated code would at run time: values wrap at 16
+bits, the comparisons are signed, and /, % and >> are signed unless the
+left operand is unsigned. CodeGenerator._try_eval_constant() uses
+them for literals, sizeof, casts, ?: with a constant condition and
+const globals (a global declared const with a constant initializer),
+so that e.g. ``sizeof(struct entry) * N`` with ``#define N 4`` costs
+a single LDD.
+
+Multiplication by a Constant
+----------------------------
+``x * c`` is otherwise a call to __mul16, a 16-step shift-and-add loop.
+plan_multiply() writes c in binary and in non-adjacent form (digits -1,
+0 and +1, no two adjacent digits non-zero) and turns the cheaper of the
+two into a Horner sequence that starts with D = x and, for each further
+digit, shifts D left once and adds or subtracts x:
+
+    x * 10 = ((x << 2) + x) << 1      LDD x / ASLD / ASLD / ADDD x / ASLD
+    x * 7  = (x << 3) - x             LDD x / ASLD / ASLD / ASLD / SUBD x
+
+Sequences with more than MAX_MULTIPLY_ADDS additions are left to
+__mul16. The same sequences scale array indexes for element sizes that
+are not powers of two, such as arrays of structs.
+
+Induction Variables
+-------------------
+In a loop such as
+
+    for (i = 0; i < n; i++)
+        total += table[i].count * table[i].weight;
+
+every ``table[i]`` multiplies i by the element size. At optimization
+level 2, find_scaled_indexes() picks out the for loops whose counter
+steps by a constant and is not otherwise changed in the loop. The code
+generator then keeps i * size in a hidden local, sets it after the
+loop initializer, adds step * size to it in the update, and indexes
+with it directly. This is only done where the multiplies it saves
+cost more than the extra update (see IV_UPDATE_CYCLES).
+
+Usage
+-----
+>>> from psion_sdk.smallc.folding import fold_binary, plan_multiply
+>>> from psion_sdk.smallc.ast import BinaryOperator
+>>> fold_binary(BinaryOperator.DIVIDE, 0xFFFA, 2)   # -6 / 2
+65533
+>>> plan_multiply(10).steps
+('shift', 'shift', 'add', 'shift')
+"""
+
+from dataclasses import dataclass
+from typing import Callable, Iterator, Optional
+
+from psion_sdk.smallc.ast import (
+    ASTNode,
+    FunctionNode,
+    ForStatement,
+    AsmStatement,
+    Expression,
+    UnaryExpression,
+    UnaryOperator,
+    BinaryOperator,
+    AssignmentExpression,
+    AssignmentOperator,
+    ArraySubscript,
+    IdentifierExpression,
+    NumberLiteral,
+)
+
+
+# Largest number of additions/subtractions in a multiply sequence
+MAX_MULTIPLY_ADDS = 3
+
+# Approximate HD6303 cycle counts used to compare code sequences
+SHIFT_CYCLES = 1           # ASLD
+ADD_CYCLES = 5             # ADDD/SUBD indexed or extended
+PUSH_POP_CYCLES = 11       # PSHB, PSHA, TSX, INS, INS around a sequence
+NEGATE_CYCLES = 5          # COMA, COMB, ADDD #1
+MUL16_CYCLES = 200         # LDX, JSR __mul16 and its loop
+
+# Cost of keeping a scaled copy of a loop counter up to date, per
+# iteration: LDD slot / ADDD #step / STD slot
+IV_UPDATE_CYCLES = 13
+
+
+# =============================================================================
+# Constant Folding
+# =============================================================================
+
+def to_signed(value: int) -> int:
+    """Interpret a 16-bit value as a signed int."""
+    value &= 0xFFFF
+    return value - 0x10000 if value & 0x8000 else value
+
+
+def fold_unary(op: UnaryOperator, value: int) -> Optional[int]:
+    """
+    Apply a unary operator to a constant.
+
+    Returns:
+        The 16-bit result, or None for operators that are not constant
+        (address-of, dereference, increment and decrement)
+    """
+    if op == UnaryOperator.NEGATE:
+        return (-value) & 0xFFFF
+    if op == UnaryOperator.POSITIVE:
+        return value & 0xFFFF
+    if op == UnaryOperator.BITWISE_NOT:
+        return (~value) & 0xFFFF
+    if op == UnaryOperator.LOGICAL_NOT:
+        return 0 if value & 0xFFFF else 1
+    return None
+
+
+def fold_binary(op: BinaryOperator, left: int, right: int,
+                unsigned: bool = False) -> Optional[int]:
+    """
+    Apply a binary operator to two constants.
+
+    Args:
+        op: The operator
+        left: Left operand (16-bit)
+        right: Right operand (16-bit)
+        unsigned: True if the left operand is unsigned, which makes /, %
+                  and >> unsigned (comparisons are always signed, as in
+                  the generated code)
+
+    Returns:
+        The 16-bit result, or None if it is not defined (division by zero)
+    """
+    left &= 0xFFFF
+    right &= 0xFFFF
+    a, b = to_signed(left), to_signed(right)
+
+    if op == BinaryOperator.ADD:
+        result = left + right
+    elif op == BinaryOperator.SUBTRACT:
+        result = left - right
+    elif op == BinaryOperator.MULTIPLY:
+        result = left * right
+    elif op in (BinaryOperator.DIVIDE, BinaryOperator.MODULO):
+        if unsigned:
+            a, b = left, right
+        if b == 0:
+            return None  # Division by zero - let it fail at runtime
+        # C division truncates toward zero; the remainder takes the
+        # dividend's sign
+        quotient = abs(a) // abs(b)
+        if (a < 0) != (b < 0):
+            quotient = -quotient
+        result = quotient if op == BinaryOperator.DIVIDE else a - quotient * b
+    elif op == BinaryOperator.BITWISE_AND:
+        result = left & right
+    elif op == BinaryOperator.BITWISE_OR:
+        result = left | right
+    elif op == BinaryOperator.BITWISE_XOR:
+        result = left ^ right
+    elif op == BinaryOperator.LEFT_SHIFT:
+        result = left << (right & 0xF)  # The runtime shifts by 0-15
+    elif op == BinaryOperator.RIGHT_SHIFT:
+        # Arithmetic for signed values
+        result = (left if unsigned else a) >> (right & 0xF)
+    elif op == BinaryOperator.EQUAL:
+        result = int(a == b)
+    elif op == BinaryOperator.NOT_EQUAL:
+        result = int(a != b)
+    elif op == BinaryOperator.LESS:
+        result = int(a < b)
+    elif op == BinaryOperator.GREATER:
+        result = int(a > b)
+    elif op == BinaryOperator.LESS_EQ:
+        result = int(a <= b)
+    elif op == BinaryOperator.GREATER_EQ:
+        result = int(a >= b)
+    elif op == BinaryOperator.LOGICAL_AND:
+        result = int(bool(left) and bool(right))
+    elif op == BinaryOperator.LOGICAL_OR:
+        result = int(bool(left) or bool(right))
+    else:
+        return None
+    return result & 0xFFFF
+
+
+# =============================================================================
+# Multiplication by a Constant
+# =============================================================================
+
+@dataclass(frozen=True)
+class MultiplyPlan:
+    """
+    Shift/add sequence that multiplies D by a constant.
+
+    Attributes:
+        steps: Applied in order to D, which starts out holding x:
+               "shift" (ASLD), "add" (ADDD x) or "sub" (SUBD x)
+        negate: True if D is negated at the end (negative multipliers)
+    """
+    steps: tuple[str, ...]
+    negate: bool = False
+
+    @property
+    def uses_operand(self) -> bool:
+        """True if the sequence reads x again (x must be kept somewhere)."""
+        return any(step != "shift" for step in self.steps)
+
+    def cycles(self, direct: bool) -> int:
+        """
+        Approximate cost of the sequence.
+
+        Args:
+            direct: True if x can be read where it lives; otherwise it is
+                    pushed first and popped afterwards
+        """
+        adds = sum(1 for step in self.steps if step != "shift")
+        cycles = (len(self.steps) - adds) * SHIFT_CYCLES + adds * ADD_CYCLES
+        if adds and not direct:
+            cycles += PUSH_POP_CYCLES
+        if self.negate:
+            cycles += NEGATE_CYCLES
+        return cycles
+
+
+def _non_adjacent_form(n: int) -> list[int]:
+    """Digits (-1, 0, 1) of n > 0, least significant first."""
+    digits = []
+    while n:
+        if n & 1:
+            digit = 2 - (n & 3)  # 1 if n % 4 == 1, -1 if n % 4 == 3
+            n -= digit
+        else:
+            digit = 0
+        digits.append(digit)
+        n >>= 1
+    return digits
+
+
+def plan_multiply(multiplier: int) -> Optional[MultiplyPlan]:
+    """
+    Find a shift/add sequence for multiplying by a constant.
+
+    The constant is written in binary and in non-adjacent form, and the
+    cheaper of the two sequences is used.
+
+    Args:
+        multiplier: The constant, as a 16-bit value (0x8000 and above are
+                    negative)
+
+    Returns:
+        The plan, or None if the constant is 0 or needs more than
+        MAX_MULTIPLY_ADDS additions (use __mul16)
+    """
+    value = to_signed(multiplier)
+    if value == 0:
+        return None
+    magnitude = abs(value)
+    binary = [(magnitude >> bit) & 1 for bit in range(magnitude.bit_length())]
+    plans = []
+    for digits in (binary, _non_adjacent_form(magnitude)):
+        steps = []
+        for digit in reversed(digits[:-1]):  # The top digit is the initial x
+            steps.append("shift")
+            if digit:
+                steps.append("add" if digit > 0 else "sub")
+        plans.append(MultiplyPlan(tuple(steps), negate=value < 0))
+    # x * 3 is cheaper as (x << 1) + x than as (x << 2) - x
+    plan = min(plans, key=lambda p: p.cycles(direct=True))
+    if sum(1 for step in plan.steps if step != "shift") > MAX_MULTIPLY_ADDS:
+        return None
+    return plan
+
+
+def multiply_cycles(multiplier: int, direct: bool) -> int:
+    """Approximate cost of multiplying D by a constant (either way)."""
+    plan = plan_multiply(multiplier)
+    return plan.cycles(direct) if plan else MUL16_CYCLES
+
+
+# =============================================================================
+# Induction Variables
+# =============================================================================
+
+@dataclass
+class ScaledIndex:
+    """
+    A loop counter kept multiplied by an array element size.
+
+    Attributes:
+        loop: The for statement
+        variable: The counter, a local int
+        step: How much the update adds to the counter
+        scale: The element size
+        slot: Name of the hidden local holding variable * scale
+    """
+    loop: ForStatement
+    variable: str
+    step: int
+    scale: int
+    slot: str
+
+
+def _walk(node) -> Iterator[ASTNode]:
+    """Yield a node and every node below it."""
+    if isinstance(node, list):
+        for item in node:
+            yield from _walk(item)
+        return
+    if not isinstance(node, ASTNode):
+        return
+    yield node
+    for value in node.__dict__.values():
+        if isinstance(value, (ASTNode, list)):
+            yield from _walk(value)
+
+
+_INCREMENTS = {
+    UnaryOperator.PRE_INCREMENT: 1,
+    UnaryOperator.POST_INCREMENT: 1,
+    UnaryOperator.PRE_DECREMENT: -1,
+    UnaryOperator.POST_DECREMENT: -1,
+}
+
+
+def _modified_variable(node: ASTNode) -> Optional[str]:
+    """Name of the variable a node assigns or increments, if any."""
+    if isinstance(node, AssignmentExpression) and isinstance(node.target, IdentifierExpression):
+        return node.target.name
+    if (isinstance(node, UnaryExpression) and node.operator in _INCREMENTS
+            and isinstance(node.operand, IdentifierExpression)):
+        return node.operand.name
+    return None
+
+
+def _counter_step(update: Optional[Expression]) -> Optional[tuple[str, int]]:
+    """(counter, step) for i++, ++i, i--, --i, i += c or i -= c."""
+    if (isinstance(update, UnaryExpression) and update.operator in _INCREMENTS
+            and isinstance(update.operand, IdentifierExpression)):
+        return update.operand.name, _INCREMENTS[update.operator]
+    if (isinstance(update, AssignmentExpression)
+            and update.operator in (AssignmentOperator.ADD_ASSIGN, AssignmentOperator.SUB_ASSIGN)
+            and isinstance(update.target, IdentifierExpression)
+            and isinstance(update.value, NumberLiteral)):
+        step = update.value.value
+        if update.operator == AssignmentOperator.SUB_ASSIGN:
+            step = -step
+        return update.target.name, step
+    return None
+
+
+def find_scaled_indexes(
+    func: FunctionNode,
+    element_size: Callable[[ArraySubscript], int],
+    is_int_local: Callable[[str], bool],
+) -> list[ScaledIndex]:
+    """
+    Find the loop counters worth keeping scaled (see "Induction Variables").
+
+    A for loop qualifies when its initializer assigns a local int
+    counter, its update steps it by a constant, nothing else in the
+    loop changes it, the function never takes its address and has no
+    inline assembly, and its body indexes arrays of an element size that
+    is not a power of two with it.
+
+    Args:
+        func: Function definition
+        element_size: Element size for a subscript whose base is a name
+        is_int_local: True for a 16-bit scalar local or parameter
+
+    Returns:
+        One ScaledIndex per loop and element size
+    """
+    nodes = list(_walk(func.body))
+    if any(isinstance(node, AsmStatement) for node in nodes):
+        return []
+    address_taken = {node.operand.name for node in nodes
+                     if isinstance(node, UnaryExpression)
+                     and node.operator == UnaryOperator.ADDRESS_OF
+                     and isinstance(node.operand, IdentifierExpression)}
+
+    found = []
+    for loop in nodes:
+        if not isinstance(loop, ForStatement):
+            continue
+        init = loop.initializer
+        counter = _counter_step(loop.update)
+        if (counter is None or not isinstance(init, AssignmentExpression)
+                or init.operator != AssignmentOperator.ASSIGN
+                or _modified_variable(init) != counter[0]):
+            continue
+        name, step = counter
+        if name in address_taken or not is_int_local(name):
+            continue
+        inside = list(_walk([loop.condition, loop.body]))
+        if any(_modified_variable(node) == name for node in inside):
+            continue
+
+        uses: dict[int, int] = {}
+        for node in inside:
+            if (isinstance(node, ArraySubscript)
+                    and isinstance(node.array, IdentifierExpression)
+                    and isinstance(node.index, IdentifierExpression)
+                    and node.index.name == name):
+                size = element_size(node)
+                if size > 2 and size & (size - 1):
+                    uses[size] = uses.get(size, 0) + 1
+
+        for size, count in sorted(uses.items()):
+            if count * multiply_cycles(size, direct=True) > IV_UPDATE_CYCLES:
+                found.append(ScaledIndex(loop, name, step, size, f"{name}@{size}"))
+    return found
@@ -0,0 +1,351 @@
+"""
+Small-C Function Inlining and Leaf Analysis
+===========================================
+
+This module finds the functions of a program that the code generator
+can inline at their call sites, and the leaf functions that can run
+without a frame. Both are used at optimization level 2 (see
+CodeGenerator's "Optimization Levels").
+
+Inlining
+--------
+A function is an inline candidate when its whole body is a single
+``return E;`` (or, for void functions, a single assignment or nothing
+at all), it has no locals, and E is small and free of calls, ++/--
+and assignments. Such a function, like min(), max() or a struct field
+accessor, costs far more in argument pushes, JSR, frame setup and
+cleanup than its body does.
+
+At a call site the code generator replaces the call with a copy of E in
+which every parameter is replaced by its argument (substitute()). That
+only keeps the meaning of the call when:
+
+- every argument is pure (no assignments, ++/-- or calls, except calls
+  to other candidates that return a value), so it does not matter that
+  it is evaluated where the parameter is used instead of before the
+  body;
+- an argument that is used more than once is evaluated only once: a
+  constant or a variable is simply read again, anything else is pushed
+  before the body and read back from the stack;
+- arguments whose type differs from their parameter's are wrapped in a
+  cast to the parameter type, so the body is typed as it was in the
+  callee;
+- the caller has no local that hides a global the body refers to.
+
+The runtime's abs(), min() and max() are inlined the same way, from C
+versions of them (RUNTIME_INLINE_SOURCE), unless the program defines
+functions of those names itself.
+
+Candidates contain no calls, so they can never be recursive. The
+callee is still emitted, for calls that could not be inlined and for
+taking its address; psbuild's unused routine removal drops it when
+every call was inlined.
+
+Leaf Functions
+--------------
+A leaf function calls nothing (the runtime helpers an operator such as
+* uses do not count, and neither do calls to inline candidates) and has
+no locals and no inline assembly. All its
+stack accesses are SP-relative, so it needs no saved frame pointer:
+the PSHX/TSX prologue and PULX epilogue are left out, and a return is
+a plain RTS. Because such a function does not restore X, calls to it
+do not keep the caller's X register tracking. A call to a candidate
+that could not be inlined after all is still correct without a frame,
+since nothing the callee does depends on the caller's X.
+
+Usage
+-----
+>>> from psion_sdk.smallc.parser import parse_source
+>>> from psion_sdk.smallc.inliner import find_inline_candidates
+>>> ast = parse_source('int max(int a, int b) { return a > b ? a : b; }')
+>>> sorted(find_inline_candidates(ast))
+['max']
+"""
+
+from dataclasses import dataclass, fields, replace
+from functools import lru_cache
+from typing import Callable, Container, Iterator, Optional
+
+from psion_sdk.smallc.ast import (
+    ASTNode,
+    ProgramNode,
+    FunctionNode,
+    ParameterNode,
+    BlockStatement,
+    ExpressionStatement,
+    ReturnStatement,
+    AsmStatement,
+    Expression,
+    UnaryExpression,
+    UnaryOperator,
+    AssignmentExpression,
+    CallExpression,
+    IdentifierExpression,
+    NumberLiteral,
+    CharLiteral,
+    StringLiteral,
+)
+from psion_sdk.smallc.parser import parse_source
+from psion_sdk.smallc.types import CType
+
+
+# Largest body, in AST nodes, that is copied into a call site
+MAX_INLINE_NODES = 12
+
+# The runtime library's abs(), min() and max() (psion.h), written in C so
+# that calls to them can be inlined like calls to the program's own
+# functions. They compute exactly what the runtime.inc routines return.
+RUNTIME_INLINE_SOURCE = """
+int abs(int n) { return n < 0 ? -n : n; }
+int min(int a, int b) { return b < a ? b : a; }
+int max(int a, int b) { return b > a ? b : a; }
+"""
+
+# Unary operators with side effects
+_SIDE_EFFECT_OPERATORS = frozenset([
+    UnaryOperator.PRE_INCREMENT,
+    UnaryOperator.PRE_DECREMENT,
+    UnaryOperator.POST_INCREMENT,
+    UnaryOperator.POST_DECREMENT,
+])
+
+
+@dataclass
+class InlineCandidate:
+    """
+    A function whose calls can be replaced by its body.
+
+    Attributes:
+        name: Function name
+        return_type: Declared return type
+        parameters: The function's parameters
+        body: The returned expression (or the assignment of a void
+              function), None for an empty void function
+        free_names: Identifiers in the body that are not parameters,
+                    i.e. the globals it refers to
+    """
+    name: str
+    return_type: CType
+    parameters: list[ParameterNode]
+    body: Optional[Expression]
+    free_names: frozenset[str]
+
+    @property
+    def returns_value(self) -> bool:
+        """True for a function that computes a value rather than storing one."""
+        return self.body is not None and not isinstance(self.body, AssignmentExpression)
+
+    def uses(self, param: str) -> int:
+        """Number of times the body refers to a parameter."""
+        return sum(1 for node in walk(self.body)
+                   if isinstance(node, IdentifierExpression) and node.name == param)
+
+
+# =============================================================================
+# Tree Helpers
+# =============================================================================
+
+def walk(node: Optional[ASTNode]) -> Iterator[ASTNode]:
+    """Yield a node and every node below it."""
+    if node is None:
+        return
+    yield node
+    for value in node.__dict__.values():
+        if isinstance(value, ASTNode):
+            yield from walk(value)
+        elif isinstance(value, list):
+            for item in value:
+                if isinstance(item, ASTNode):
+                    yield from walk(item)
+
+
+def is_pure(expr: Expression, pure_functions: Container[str] = ()) -> bool:
+    """
+    Check that evaluating an expression has no side effects.
+
+    Args:
+        expr: Expression to check
+        pure_functions: Functions that may be called (candidates that
+                        return a value, which have no side effects)
+    """
+    for node in walk(expr):
+        if isinstance(node, CallExpression) and node.function_name not in pure_functions:
+            return False
+        if isinstance(node, AssignmentExpression):
+            return False
+        if isinstance(node, UnaryExpression) and node.operator in _SIDE_EFFECT_OPERATORS:
+            return False
+    return True
+
+
+def is_simple(expr: Expression) -> bool:
+    """Check that an expression is a constant or a variable."""
+    return isinstance(expr, (NumberLiteral, CharLiteral, IdentifierExpression))
+
+
+def rewrite(expr: Expression, change: Callable[[Expression], Expression]) -> Expression:
+    """
+    Copy an expression bottom-up, letting a function replace nodes.
+
+    Args:
+        expr: Expression to copy
+        change: Called with each copied node, children first; returns the
+                node to use in its place (or the node itself)
+
+    Returns:
+        The new expression
+    """
+    changes = {}
+    for f in fields(expr):
+        value = getattr(expr, f.name)
+        if isinstance(value, Expression):
+            changes[f.name] = rewrite(value, change)
+        elif isinstance(value, list) and any(isinstance(v, Expression) for v in value):
+            changes[f.name] = [rewrite(v, change) if isinstance(v, Expression) else v
+                               for v in value]
+    return change(replace(expr, **changes))
+
+
+def substitute(expr: Expression, replacements: dict[str, Expression]) -> Expression:
+    """
+    Copy an expression, replacing identifiers by other expressions.
+
+    Nodes are copied rather than shared, so the result can be given to
+    the code generator any number of times.
+
+    Args:
+        expr: Expression to copy
+        replacements: Identifier name -> expression that takes its place
+
+    Returns:
+        The new expression
+    """
+    def change(node: Expression) -> Expression:
+        if isinstance(node, IdentifierExpression) and node.name in replacements:
+            return rewrite(replacements[node.name], lambda copy: copy)
+        return node
+    return rewrite(expr, change)
+
+
+# =============================================================================
+# Analysis
+# =============================================================================
+
+def _inline_body(func: FunctionNode) -> tuple[bool, Optional[Expression]]:
+    """
+    The expression a candidate's calls are replaced with.
+
+    Returns:
+        (True, expression) for a candidate, (False, None) otherwise
+    """
+    body = func.body
+    if body.declarations or len(body.statements) > 1:
+        return False, None
+
+    if not body.statements:
+        return func.return_type.is_void, None
+
+    stmt = body.statements[0]
+    if isinstance(stmt, ReturnStatement) and stmt.value is not None:
+        if func.return_type.is_void or not is_pure(stmt.value):
+            return False, None
+        return True, stmt.value
+
+    if (func.return_type.is_void and isinstance(stmt, ExpressionStatement)
+            and isinstance(stmt.expression, AssignmentExpression)):
+        # A setter: the stored value and the target must be pure, and the
+        # target must not be a parameter (that would assign to the argument)
+        assign = stmt.expression
+        params = {p.name for p in func.parameters}
+        if (is_pure(assign.target) and is_pure(assign.value)
+                and not (isinstance(assign.target, IdentifierExpression)
+                         and assign.target.name in params)):
+            return True, assign
+    return False, None
+
+
+def find_inline_candidates(program: ProgramNode,
+                           runtime: bool = True) -> dict[str, InlineCandidate]:
+    """
+    Find the functions that can be inlined.
+
+    Args:
+        program: Parsed program
+        runtime: Also inline the runtime helpers in RUNTIME_INLINE_SOURCE
+                 the program does not define itself
+
+    Returns:
+        Function name -> InlineCandidate
+    """
+    candidates = {}
+    if runtime:
+        defined = {decl.name for decl in program.declarations
+                   if isinstance(decl, FunctionNode) and not decl.is_forward_decl}
+        for name, candidate in _runtime_candidates().items():
+            if name not in defined:
+                candidates[name] = candidate
+
+    for decl in program.declarations:
+        if (not isinstance(decl, FunctionNode) or decl.is_forward_decl
+                or decl.is_opl or decl.body is None or decl.name == "main"):
+            continue
+        # Only word-sized values are passed and returned in registers
+        if not all(p.param_type.is_scalar for p in decl.parameters):
+            continue
+        if not (decl.return_type.is_void or decl.return_type.is_scalar):
+            continue
+
+        ok, body = _inline_body(decl)
+        if not ok:
+            continue
+        nodes = list(walk(body))
+        if len(nodes) > MAX_INLINE_NODES:
+            continue
+        params = {p.name for p in decl.parameters}
+        if any(isinstance(node, StringLiteral) for node in nodes):
+            continue  # Each copy would add the string to the pool again
+        if any(isinstance(node, UnaryExpression) and node.operator == UnaryOperator.ADDRESS_OF
+               and isinstance(node.operand, IdentifierExpression) and node.operand.name in params
+               for node in nodes):
+            continue  # &param needs the parameter's stack slot
+
+        candidates[decl.name] = InlineCandidate(
+            name=decl.name,
+            return_type=decl.return_type,
+            parameters=list(decl.parameters),
+            body=body,
+            free_names=frozenset(node.name for node in nodes
+                                 if isinstance(node, IdentifierExpression)
+                                 and node.name not in params),
+        )
+    return candidates
+
+
+@lru_cache(maxsize=None)
+def _runtime_candidates() -> dict[str, InlineCandidate]:
+    """Inline candidates for the runtime helpers (parsed once)."""
+    return find_inline_candidates(parse_source(RUNTIME_INLINE_SOURCE), runtime=False)
+
+
+def is_frameless_leaf(func: FunctionNode, inlined: Container[str] = ()) -> bool:
+    """
+    Check whether a function can run without a frame (see "Leaf Functions").
+
+    Args:
+        func: Function definition
+        inlined: Inline candidates, whose calls do not count
+
+    Returns:
+        True if the function calls nothing and has no locals or inline
+        assembly
+    """
+    if func.body is None or func.name == "main":
+        return False
+    for node in walk(func.body):
+        if isinstance(node, BlockStatement) and node.declarations:
+            return False
+        if isinstance(node, CallExpression) and node.function_name not in inlined:
+            return False
+        if isinstance(node, AsmStatement):
+            return False
+    return True
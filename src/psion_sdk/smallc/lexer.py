@@ -113,6 +113,9 @@ class CTokenType(Enum):
     # === Keywords - Storage Class ===
     EXTERN = auto()         # extern (C storage class - external linkage)
 
+    # === Keywords - Type Qualifiers ===
+    CONST = auto()          # const (compile-time constant globals)
+
     # === Keywords - Psion Extensions ===
     OPL = auto()            # opl (OPL procedure declaration - Psion-specific)
 
@@ -215,6 +218,9 @@ KEYWORDS: dict[str, CTokenType] = {
     # Storage class
     "extern": CTokenType.EXTERN,
 
+    # Type qualifiers
+    "const": CTokenType.CONST,
+
     # Psion extensions
     "opl": CTokenType.OPL,
 
@@ -183,6 +183,9 @@ class CParser:
         # we need to know which struct it refers to
         self._struct_typedefs: dict[str, str] = {}
 
+        # Whether the last type specifier started with 'const'
+        self._const_qualified = False
+
     def parse(self) -> ProgramNode:
         """
         Parse the token stream into an AST.
@@ -428,6 +431,12 @@ class CParser:
             For typedef'd types, these carry the typedef's pointer/array info.
             For struct types, base_type is VOID and struct_name contains the struct name.
         """
+        # A leading 'const' is remembered for the declaration being parsed
+        # (see _parse_global_variable); it does not change the type
+        self._const_qualified = False
+        while self._match(CTokenType.CONST):
+            self._const_qualified = True
+
         # =================================================================
         # Check for 'struct' keyword
         # =================================================================
@@ -1520,8 +1529,12 @@ class CParser:
         For struct types:
             struct Point p;     -> allocates struct size
             struct Point *pp;   -> pointer (2 bytes)
+
+        With a leading 'const', every char or int declarator is marked
+        is_const (const int N = 4, M = N * 2;).
         """
         declarations = []
+        is_const = self._const_qualified
 
         # Parse first declarator (name and pointer already parsed by caller)
         array_size = 0
@@ -1560,6 +1573,11 @@ class CParser:
                                           struct_name=struct_name)
             declarations.append(decl)
 
+        for decl in declarations:
+            # const char *p qualifies the characters, not p
+            decl.is_const = (is_const and decl.var_type.is_scalar
+                             and not decl.var_type.is_pointer)
+
         self._expect(CTokenType.SEMICOLON, "';'")
 
         return declarations
@@ -1604,6 +1622,7 @@ class CParser:
             CTokenType.UNSIGNED,
             CTokenType.SIGNED,
             CTokenType.STRUCT,
+            CTokenType.CONST,
         ):
             return True
         # Also check for typedef names (including struct typedefs)
@@ -2170,6 +2189,7 @@ class CParser:
             CTokenType.UNSIGNED,
             CTokenType.SIGNED,
             CTokenType.STRUCT,
+            CTokenType.CONST,
         ):
             return True
         # Also check for typedef names (including struct typedefs)
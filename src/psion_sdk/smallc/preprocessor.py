@@ -204,6 +204,10 @@ class Preprocessor:
         # Set of included file basenames (e.g., "float.h", "psion.h")
         self._included_files: set[str] = set()
 
+        # Resolved paths of every file read by #include, in order
+        # (what the output depends on, for build caching)
+        self._dependencies: list[str] = []
+
         # Output lines
         self._output: list[str] = []
 
@@ -437,6 +441,8 @@ class Preprocessor:
 
         # Track included file basename (e.g., "float.h")
         self._included_files.add(Path(filename).name.lower())
+        if resolved_path not in self._dependencies:
+            self._dependencies.append(resolved_path)
 
         # Read and process the included file
         try:
@@ -691,6 +697,30 @@ class Preprocessor:
         """
         return "db.h" in self._included_files
 
+    def has_fixed_support(self) -> bool:
+        """
+        Return True if the source code uses fixed point support.
+
+        This checks if fixed.h was included during preprocessing.
+        Used by codegen to conditionally include fixedruntime.inc.
+
+        Returns:
+            True if fixed.h was included, False otherwise.
+        """
+        return "fixed.h" in self._included_files
+
+    def has_fb_support(self) -> bool:
+        """
+        Return True if the source code uses the display frame buffer.
+
+        This checks if fb.h was included during preprocessing.
+        Used by codegen to conditionally include fbruntime.inc.
+
+        Returns:
+            True if fb.h was included, False otherwise.
+        """
+        return "fb.h" in self._included_files
+
     def get_included_files(self) -> set[str]:
         """
         Return the set of included file basenames.
@@ -700,6 +730,15 @@ class Preprocessor:
         """
         return self._included_files.copy()
 
+    def get_dependencies(self) -> list[str]:
+        """
+        Return the files the output depends on.
+
+        Returns:
+            Resolved paths of all files read by #include, in first-include order
+        """
+        return list(self._dependencies)
+
     def _expand_macros(self, line: str) -> str:
         """Expand all macros in a line of text."""
         # Track which macros are being expanded to prevent infinite recursion
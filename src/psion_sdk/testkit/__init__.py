@@ -124,6 +124,29 @@ Or via environment variables::
     PSION_TEST_TIMEOUT=20000000
     PSION_TEST_ROM_PATH=/path/to/roms
 
+Profiling
+---------
+
+To see where the emulated code spends its cycles, profile each test body
+(flat/call-graph report in .prof, flamegraph input in .folded)::
+
+    pytest tests/testkit --psion-profile=/tmp/psion_profiles
+
+or set PSION_TEST_PROFILE_DIR=/tmp/psion_profiles.
+
+Benchmarks
+----------
+
+Exact cycle counts and code sizes of runtime library routines, compared
+against a stored baseline (see benchmark.py)::
+
+    from psion_sdk.testkit.benchmark import RuntimeBenchmark, BenchmarkCase
+
+    bench = RuntimeBenchmark()
+    result = bench.measure(BenchmarkCase("mul16", "__mul16", d=3, x=7))
+
+Set PSION_BENCH_UPDATE=1 to rewrite the baselines of the benchmark tests.
+
 Copyright (c) 2025-2026 Hugo José Pinto & Contributors
 """
 
@@ -178,10 +201,13 @@ from .fixtures import (
     test_config,
     fresh_emulator,
     booted_emulator,
+    booted_fork,
     psion_ctx,
     unbooted_ctx,
     compiled_program,
     register_fixtures,
+    get_booted_pool,
+    pytest_addoption,
     pytest_configure,
     pytest_collection_modifyitems,
 )
@@ -218,10 +244,13 @@ __all__ = [
     "test_config",
     "fresh_emulator",
     "booted_emulator",
+    "booted_fork",
     "psion_ctx",
     "unbooted_ctx",
     "compiled_program",
     "register_fixtures",
+    "get_booted_pool",
+    "pytest_addoption",
     "pytest_configure",
     "pytest_collection_modifyitems",
 ]
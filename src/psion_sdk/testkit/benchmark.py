@@ -0,0 +1,673 @@
+"""
+Psion Testing Framework - Runtime Benchmarks
+============================================
+
+Cycle-exact benchmarks for the assembly runtime libraries (runtime.inc,
+fpruntime.inc, dbruntime.inc, ...). A RuntimeBenchmark assembles the
+libraries once, loads them into an emulator and times individual calls:
+
+- Cycles are counted from the routine's first instruction up to and
+  including its final RTS, with the registers and stack arguments set up
+  directly (no caller overhead). Interrupt handler cycles that happen to
+  land inside the call are excluded, so results are exact and
+  reproducible.
+- Code bytes are the size of the routine, from its label to the next
+  label outside it; a C wrapper that just JMPs to the implementation
+  (_memcpy -> __memcpy) includes the implementation.
+
+Pure routines run on a bare CPU. Routines that call the operating system
+(floating point, database) need a booted machine: pass booted=True to
+fork the session's booted emulator pool.
+
+Results are compared against a stored baseline so that a change which
+makes a routine slower or larger fails the run:
+
+    from psion_sdk.testkit.benchmark import (
+        BenchmarkCase, BenchmarkBaseline, RuntimeBenchmark, DATA_BASE,
+    )
+
+    bench = RuntimeBenchmark()
+    results = bench.run([
+        BenchmarkCase("memset/n=64", "_memset", args=(DATA_BASE, 0, 64)),
+        BenchmarkCase("mul16/3*7", "__mul16", d=3, x=7, expect_d=21),
+    ])
+    BenchmarkBaseline.check(results, "runtime_benchmarks.json")
+
+Copyright (c) 2025-2026 Hugo José Pinto & Contributors
+"""
+
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Dict, Iterable, List, Optional, Sequence, Tuple, Union
+import json
+import os
+import tempfile
+
+from psion_sdk.assembler import Assembler
+from psion_sdk.emulator import Emulator, EmulatorConfig, SymbolTable
+from psion_sdk.emulator.profiler import INTERRUPT_FRAME
+
+from .exceptions import ProgramBuildError, TestAssertionError, TestTimeoutError
+
+
+# ═══════════════════════════════════════════════════════════════════════════════
+# MEMORY LAYOUT
+# ═══════════════════════════════════════════════════════════════════════════════
+#
+# Chosen to be free on a booted CM/XP as well as on a bare machine: the OS
+# allocator ends around $2500 after boot, the language stack (RTA_SP)
+# grows down from $7EFF.
+
+# Libraries are assembled here
+CODE_ORIGIN = 0x3000
+
+# Scratch area for case data (strings, buffers, FP operands)
+DATA_BASE = 0x6000
+DATA_SIZE = 0x1000
+
+# Machine stack at the start of each call
+STACK_TOP = 0x7F80
+
+# SDK include directory (runtime.inc and friends)
+SDK_INCLUDE_DIR = Path(__file__).parent.parent.parent.parent / "include"
+
+# Libraries that need psion.inc/float.inc before them
+DEFAULT_LIBRARIES = ("runtime.inc",)
+
+# Opcode of JMP extended, used by C wrappers around the implementations
+_JMP_EXTENDED = 0x7E
+
+
+# ═══════════════════════════════════════════════════════════════════════════════
+# CASES AND RESULTS
+# ═══════════════════════════════════════════════════════════════════════════════
+
+
+@dataclass
+class BenchmarkCase:
+    """
+    One timed call into a runtime routine.
+
+    Stack arguments follow the Small-C convention: args[0] is the first C
+    argument and ends up just above the return address. Register
+    arguments (__mul16, __div16, shifts) are passed in d and x.
+
+    Attributes:
+        name: Unique case name, e.g. "memcpy/n=64"
+        routine: Entry label to call
+        args: 16-bit stack arguments, first C argument first
+        d: Initial D register
+        x: Initial X register
+        memory: Data written before the call {address: bytes}
+        prepare: Untimed calls made first, as (routine, args) pairs
+                 (e.g. converting FP operands)
+        expect_d: Required D on return (None to skip the check)
+        expect_memory: Required memory contents on return
+        max_cycles: Give up if the routine has not returned by then
+    """
+
+    name: str
+    routine: str
+    args: Sequence[int] = ()
+    d: int = 0
+    x: int = 0
+    memory: Dict[int, bytes] = field(default_factory=dict)
+    prepare: Sequence[Tuple[str, Sequence[int]]] = ()
+    expect_d: Optional[int] = None
+    expect_memory: Dict[int, bytes] = field(default_factory=dict)
+    max_cycles: int = 2_000_000
+
+
+@dataclass
+class BenchmarkResult:
+    """
+    Measured cost of one case.
+
+    Attributes:
+        name: Case name
+        routine: Entry label
+        cycles: CPU cycles from entry to return, interrupts excluded
+        code_bytes: Size of the routine in bytes
+    """
+
+    name: str
+    routine: str
+    cycles: int
+    code_bytes: int
+
+
+@dataclass
+class CallResult:
+    """
+    State after a single call().
+
+    Attributes:
+        cycles: CPU cycles from entry to return, interrupts excluded
+        d: D register on return
+        x: X register on return
+    """
+
+    cycles: int
+    d: int
+    x: int
+
+
+# ═══════════════════════════════════════════════════════════════════════════════
+# RUNTIME BENCHMARK
+# ═══════════════════════════════════════════════════════════════════════════════
+
+
+class RuntimeBenchmark:
+    """
+    Runtime libraries loaded into an emulator, ready to be timed.
+
+    Each call starts from the same machine state (captured right after
+    loading), so cases are independent of each other and of their order.
+    """
+
+    def __init__(
+        self,
+        libraries: Sequence[str] = DEFAULT_LIBRARIES,
+        booted: bool = False,
+        model: str = "XP",
+        include_dir: Optional[Path] = None,
+    ):
+        """
+        Assemble the libraries and load them.
+
+        Args:
+            libraries: Include files to assemble, in order. psion.inc is
+                       always included first, and float.inc before
+                       fpruntime.inc.
+            booted: Start from a machine booted to the main menu (needed
+                    for routines that call the OS)
+            model: Psion model to emulate and assemble for
+            include_dir: Directory with the include files (default: SDK)
+
+        Raises:
+            ProgramBuildError: If the libraries do not assemble or do not
+                               fit below DATA_BASE
+        """
+        self.libraries = tuple(libraries)
+        self.booted = booted
+        self.model = model
+        self.include_dir = Path(include_dir) if include_dir else SDK_INCLUDE_DIR
+
+        code, self.symbols, addresses = self._assemble()
+        self.code_size = len(code)
+        self._addresses = addresses
+        self._stop = addresses["__BENCH_STOP"]
+
+        if booted:
+            from .fixtures import get_booted_pool
+            self._emulator = get_booted_pool(model).fork()
+        else:
+            self._emulator = Emulator(EmulatorConfig(model=model))
+            self._emulator.reset()
+        self._emulator.write_bytes(CODE_ORIGIN, code)
+        self._base = self._emulator.snapshot()
+
+    # ═══════════════════════════════════════════════════════════════════════════
+    # ASSEMBLY AND SYMBOLS
+    # ═══════════════════════════════════════════════════════════════════════════
+
+    def _assemble(self) -> Tuple[bytes, SymbolTable, Dict[str, int]]:
+        """Assemble the libraries behind a stop label at CODE_ORIGIN."""
+        lines = [
+            f"        ORG     ${CODE_ORIGIN:04X}",
+            "        INCLUDE \"psion.inc\"",
+            "__bench_stop:",
+            "        BRA     __bench_stop",
+        ]
+        for library in self.libraries:
+            if library == "fpruntime.inc" and "float.inc" not in self.libraries:
+                lines.append("        INCLUDE \"float.inc\"")
+            lines.append(f"        INCLUDE \"{library}\"")
+        source = "\n".join(lines) + "\n"
+
+        # Assembled for the emulated model, so DISP_ROWS/DISP_COLS match it
+        asm = Assembler(include_paths=[str(self.include_dir)], debug=True,
+                        target_model=self.model)
+        try:
+            asm.assemble_string(source, "benchmark.asm")
+        except Exception as e:
+            raise ProgramBuildError(
+                f"Failed to assemble {', '.join(self.libraries)}: {e}",
+            ) from e
+
+        code = asm.get_code()
+        if CODE_ORIGIN + len(code) > DATA_BASE:
+            raise ProgramBuildError(
+                f"Libraries are {len(code)} bytes and overlap the data area "
+                f"at ${DATA_BASE:04X}",
+            )
+
+        with tempfile.TemporaryDirectory() as tmp:
+            debug_path = Path(tmp) / "benchmark.dbg"
+            asm.write_debug(debug_path)
+            symbols = SymbolTable.from_debug_file(debug_path)
+
+        # Labels past the end mean some of the source produced no code
+        end = CODE_ORIGIN + len(code)
+        if symbols.symbols and symbols.symbols[-1][0] > end:
+            address, name = symbols.symbols[-1]
+            raise ProgramBuildError(
+                f"Assembled code ends at ${end:04X} but label {name} is at "
+                f"${address:04X}; part of {', '.join(self.libraries)} was not assembled",
+            )
+
+        addresses = {name.upper(): address for address, name in symbols.symbols}
+        return code, symbols, addresses
+
+    def address(self, routine: str) -> int:
+        """
+        Get the address of a routine.
+
+        Args:
+            routine: Label name (case-insensitive)
+
+        Returns:
+            Address of the label
+
+        Raises:
+            KeyError: If the label does not exist
+        """
+        try:
+            return self._addresses[routine.upper()]
+        except KeyError:
+            raise KeyError(f"Unknown routine '{routine}'") from None
+
+    def routine_size(self, routine: str) -> int:
+        """
+        Get the size of a routine in bytes.
+
+        A routine extends from its label to the next label that is not one
+        of its own (labels starting with the routine name and "_"), which
+        includes its local storage. If it starts with a JMP to another
+        routine, that routine is counted as well.
+
+        Args:
+            routine: Label name
+
+        Returns:
+            Code bytes
+        """
+        start = self.address(routine)
+        prefix = routine.upper() + "_"
+        entries = self.symbols.symbols
+        end = CODE_ORIGIN + self.code_size
+        for address, name in entries:
+            if address > start and not name.upper().startswith(prefix):
+                end = address
+                break
+        size = end - start
+
+        if self._emulator.read_byte(start) == _JMP_EXTENDED:
+            target = self._read_word(start + 1)
+            target_name = self.symbols.name_at(target)
+            if target_name.upper() in self._addresses and target != start:
+                size += self.routine_size(target_name)
+        return size
+
+    def _read_word(self, address: int) -> int:
+        """Read a big-endian word."""
+        return (self._emulator.read_byte(address) << 8) | self._emulator.read_byte(address + 1)
+
+    # ═══════════════════════════════════════════════════════════════════════════
+    # CALLS
+    # ═══════════════════════════════════════════════════════════════════════════
+
+    @property
+    def emulator(self) -> Emulator:
+        """Emulator the routines run on (state of the last call)."""
+        return self._emulator
+
+    def reset(self) -> None:
+        """Return the machine to the state right after loading."""
+        self._emulator.restore(self._base)
+
+    def call(
+        self,
+        routine: str,
+        args: Sequence[int] = (),
+        d: int = 0,
+        x: int = 0,
+        max_cycles: int = 2_000_000,
+    ) -> CallResult:
+        """
+        Call a routine from the current machine state and time it.
+
+        Maskable interrupts are disabled for the call; cycles spent in
+        interrupt handlers (e.g. the NMI on a booted machine) are not
+        counted.
+
+        Args:
+            routine: Entry label
+            args: 16-bit stack arguments, first C argument first
+            d: Initial D register
+            x: Initial X register
+            max_cycles: Give up after this many cycles
+
+        Returns:
+            CallResult with the cycle count and returned registers
+
+        Raises:
+            TestTimeoutError: If the routine does not return in time
+        """
+        emu = self._emulator
+        cpu = emu.cpu
+
+        # As if just called: [SP] return address, [SP+2] first argument
+        # (SP points at the last byte pushed)
+        sp = STACK_TOP - 2 * len(args) - 2
+        frame = bytearray(self._stop.to_bytes(2, "big"))
+        for arg in args:
+            frame += (arg & 0xFFFF).to_bytes(2, "big")
+        emu.write_bytes(sp, bytes(frame))
+
+        cpu.sp = sp
+        cpu.pc = self.address(routine)
+        cpu.d = d & 0xFFFF
+        cpu.x = x & 0xFFFF
+        cpu.flag_i = True
+        # A booted machine is captured asleep in the keyboard wait
+        cpu.state.sleep = False
+
+        profiler = emu.start_profiling()
+        emu.add_breakpoint(self._stop)
+        try:
+            emu.run(max_cycles)
+        finally:
+            emu.remove_breakpoint(self._stop)
+            emu.stop_profiling()
+
+        if cpu.pc != self._stop:
+            raise TestTimeoutError(
+                f"{routine} did not return within {max_cycles:,} cycles "
+                f"(PC=${cpu.pc:04X})",
+                timeout_cycles=max_cycles,
+                total_cycles=emu.total_cycles,
+            )
+
+        interrupt_cycles = sum(
+            cycles for stack, cycles in profiler.stack_cycles.items()
+            if any(frame >= INTERRUPT_FRAME for frame in stack)
+        )
+        return CallResult(profiler.total_cycles - interrupt_cycles, cpu.d, cpu.x)
+
+    def measure(self, case: BenchmarkCase) -> BenchmarkResult:
+        """
+        Run one case from a clean machine and check its results.
+
+        Args:
+            case: Case to run
+
+        Returns:
+            BenchmarkResult
+
+        Raises:
+            TestAssertionError: If the routine returned wrong results
+            TestTimeoutError: If a call does not return
+        """
+        self.reset()
+        emu = self._emulator
+        for address, data in case.memory.items():
+            emu.write_bytes(address, data)
+        for routine, args in case.prepare:
+            self.call(routine, args, max_cycles=case.max_cycles)
+
+        result = self.call(case.routine, case.args, case.d, case.x, case.max_cycles)
+
+        if case.expect_d is not None and result.d != case.expect_d & 0xFFFF:
+            raise TestAssertionError(
+                f"{case.name}: {case.routine} returned D=${result.d:04X}, "
+                f"expected ${case.expect_d & 0xFFFF:04X}",
+                assertion_type="benchmark_result",
+                expected=case.expect_d & 0xFFFF,
+                actual=result.d,
+            )
+        for address, expected in case.expect_memory.items():
+            actual = emu.read_bytes(address, len(expected))
+            if actual != expected:
+                raise TestAssertionError(
+                    f"{case.name}: memory at ${address:04X} is {actual!r}, "
+                    f"expected {expected!r}",
+                    assertion_type="benchmark_memory",
+                    expected=expected,
+                    actual=actual,
+                )
+
+        return BenchmarkResult(
+            case.name, case.routine, result.cycles, self.routine_size(case.routine)
+        )
+
+    def run(self, cases: Iterable[BenchmarkCase]) -> List[BenchmarkResult]:
+        """
+        Measure several cases.
+
+        Args:
+            cases: Cases to run
+
+        Returns:
+            Results in case order
+        """
+        return [self.measure(case) for case in cases]
+
+    def __repr__(self) -> str:
+        mode = "booted" if self.booted else "bare"
+        return (
+            f"RuntimeBenchmark({', '.join(self.libraries)}, {mode} {self.model}, "
+            f"{self.code_size} bytes)"
+        )
+
+
+# ═══════════════════════════════════════════════════════════════════════════════
+# BASELINE
+# ═══════════════════════════════════════════════════════════════════════════════
+
+
+@dataclass
+class Regression:
+    """
+    A metric that got worse than its baseline.
+
+    Attributes:
+        name: Case name
+        metric: "cycles" or "bytes"
+        baseline: Stored value
+        actual: Measured value
+    """
+
+    name: str
+    metric: str
+    baseline: int
+    actual: int
+
+    def __str__(self) -> str:
+        change = (self.actual - self.baseline) / self.baseline * 100 if self.baseline else 0.0
+        return f"{self.name}: {self.metric} {self.baseline:,} -> {self.actual:,} ({change:+.1f}%)"
+
+
+class BenchmarkBaseline:
+    """
+    Stored benchmark results to compare new runs against.
+
+    The file is JSON, one entry per case:
+
+        {"version": 1, "cases": {"memcpy/n=64": {"routine": "_memcpy",
+                                                 "cycles": 2345, "bytes": 52}}}
+
+    Cases that are not in the baseline are reported by regressions() but
+    never counted. Setting the PSION_BENCH_UPDATE environment variable
+    makes update_requested() true, and check() then rewrites the baseline
+    before comparing against it.
+    """
+
+    VERSION = 1
+
+    def __init__(self, entries: Optional[Dict[str, BenchmarkResult]] = None):
+        """
+        Initialize baseline.
+
+        Args:
+            entries: Baseline results by case name
+        """
+        self.entries: Dict[str, BenchmarkResult] = dict(entries or {})
+
+    @classmethod
+    def load(cls, path: Union[str, Path]) -> "BenchmarkBaseline":
+        """
+        Load a baseline file. A missing file gives an empty baseline.
+
+        Args:
+            path: Baseline JSON file
+
+        Returns:
+            BenchmarkBaseline
+        """
+        path = Path(path)
+        if not path.exists():
+            return cls()
+        data = json.loads(path.read_text())
+        return cls({
+            name: BenchmarkResult(name, entry["routine"], entry["cycles"], entry["bytes"])
+            for name, entry in data.get("cases", {}).items()
+        })
+
+    @classmethod
+    def from_results(cls, results: Iterable[BenchmarkResult]) -> "BenchmarkBaseline":
+        """Create a baseline from measured results."""
+        return cls({result.name: result for result in results})
+
+    def save(self, path: Union[str, Path]) -> None:
+        """
+        Write the baseline file.
+
+        Args:
+            path: Baseline JSON file
+        """
+        data = {
+            "version": self.VERSION,
+            "cases": {
+                name: {"routine": entry.routine, "cycles": entry.cycles, "bytes": entry.code_bytes}
+                for name, entry in sorted(self.entries.items())
+            },
+        }
+        Path(path).write_text(json.dumps(data, indent=2) + "\n")
+
+    @staticmethod
+    def update_requested() -> bool:
+        """True if PSION_BENCH_UPDATE asks for baselines to be rewritten."""
+        return os.environ.get("PSION_BENCH_UPDATE", "") not in ("", "0")
+
+    @classmethod
+    def check(
+        cls,
+        results: Iterable[BenchmarkResult],
+        path: Union[str, Path],
+        tolerance: float = 0.0,
+    ) -> str:
+        """
+        Compare results with a baseline file, as a benchmark test does.
+
+        Rewrites the file first if update_requested(), then fails if a case
+        has no baseline or is slower or larger than it. The error message
+        ends with the report.
+
+        Args:
+            results: Measured results
+            path: Baseline JSON file
+            tolerance: Allowed relative increase, as for regressions()
+
+        Returns:
+            The report against the baseline (see report())
+
+        Raises:
+            TestAssertionError: If a case is missing from the baseline
+                or is slower or larger than it
+        """
+        results = list(results)
+        path = Path(path)
+        if cls.update_requested():
+            cls.from_results(results).save(path)
+
+        baseline = cls.load(path)
+        report = baseline.report(results)
+
+        missing = [result.name for result in results if result.name not in baseline.entries]
+        if missing:
+            raise TestAssertionError(
+                f"Not in {path.name}: {missing}\n{report}",
+                assertion_type="benchmark_baseline",
+                actual=missing,
+            )
+        regressions = baseline.regressions(results, tolerance)
+        if regressions:
+            raise TestAssertionError(
+                "\n".join(str(regression) for regression in regressions) + "\n" + report,
+                assertion_type="benchmark_regression",
+                actual=regressions,
+            )
+        return report
+
+    def regressions(
+        self,
+        results: Iterable[BenchmarkResult],
+        tolerance: float = 0.0,
+    ) -> List[Regression]:
+        """
+        Find results that are slower or larger than the baseline.
+
+        Args:
+            results: Measured results
+            tolerance: Allowed relative increase (0.02 = 2%); cycle counts
+                       are exact, so the default allows none
+
+        Returns:
+            Regressions, empty if none
+        """
+        found = []
+        for result in results:
+            entry = self.entries.get(result.name)
+            if entry is None:
+                continue
+            for metric, baseline, actual in (
+                ("cycles", entry.cycles, result.cycles),
+                ("bytes", entry.code_bytes, result.code_bytes),
+            ):
+                if actual > baseline * (1.0 + tolerance):
+                    found.append(Regression(result.name, metric, baseline, actual))
+        return found
+
+    def report(self, results: Iterable[BenchmarkResult]) -> str:
+        """
+        Format results as a table against the baseline.
+
+        Args:
+            results: Measured results
+
+        Returns:
+            Multi-line report
+        """
+        results = list(results)
+        width = max([len(result.name) for result in results] + [4])
+        lines = [
+            f"{'case':<{width}}  {'cycles':>9}  {'baseline':>9}  {'change':>7}  {'bytes':>5}  {'baseline':>8}",
+        ]
+        for result in results:
+            entry = self.entries.get(result.name)
+            if entry is None:
+                lines.append(
+                    f"{result.name:<{width}}  {result.cycles:>9,}  {'new':>9}  {'':>7}  "
+                    f"{result.code_bytes:>5}  {'new':>8}"
+                )
+                continue
+            change = (result.cycles - entry.cycles) / entry.cycles * 100 if entry.cycles else 0.0
+            lines.append(
+                f"{result.name:<{width}}  {result.cycles:>9,}  {entry.cycles:>9,}  "
+                f"{change:>+6.1f}%  {result.code_bytes:>5}  {entry.code_bytes:>8}"
+            )
+        return "\n".join(lines)
+
+    def __len__(self) -> int:
+        return len(self.entries)
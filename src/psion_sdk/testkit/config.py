@@ -38,7 +38,8 @@ class TestConfig:
         default_hold_cycles: How long to hold a key (default: 50,000 ≈ 54ms)
         default_delay_cycles: Delay between keystrokes (default: 150,000 ≈ 163ms)
         default_timeout_cycles: Maximum wait time (default: 10,000,000 ≈ 10.9s)
-        default_poll_interval: How often to check display (default: 10,000 ≈ 11ms)
+        default_poll_interval: Longest run between timeout checks in wait_for;
+            the display is rechecked as soon as it changes (default: 10,000 ≈ 11ms)
         default_idle_threshold: Cycles in idle loop to consider "idle" (default: 1,000)
         boot_cycles: Initial boot cycles (default: 5,000,000 ≈ 5.4s)
         post_boot_cycles: Cycles after language selection (default: 2,000,000 ≈ 2.2s)
@@ -49,6 +50,8 @@ class TestConfig:
         rom_search_paths: Where to look for ROM files
         screenshot_output_dir: Where to save failure screenshots
         compiled_programs_cache: Where to cache compiled programs
+        profile_output_dir: Where to write cycle profiles of each test
+            (None disables profiling)
         default_model: Default emulator model (default: "XP")
         default_models_for_tests: Models for @for_models without arguments
     """
@@ -63,7 +66,7 @@ class TestConfig:
 
     # Wait operation timing
     default_timeout_cycles: int = 10_000_000  # ~10.9s - max wait for operations
-    default_poll_interval: int = 10_000  # ~11ms - how often to check conditions
+    default_poll_interval: int = 10_000  # ~11ms - longest run between condition checks
     default_idle_threshold: int = 1_000  # cycles in same PC region = idle
 
     # Boot sequence timing
@@ -98,6 +101,7 @@ class TestConfig:
     compiled_programs_cache: Path = field(
         default_factory=lambda: Path("/tmp/psion_test_programs")
     )
+    profile_output_dir: Optional[Path] = None  # Set by --psion-profile
 
     # ═══════════════════════════════════════════════════════════════════════════
     # MODEL DEFAULTS
@@ -123,6 +127,7 @@ class TestConfig:
             PSION_TEST_ROM_PATH: Additional ROM search path
             PSION_TEST_SCREENSHOT_DIR: Screenshot output directory
             PSION_TEST_SCREENSHOT_FORMAT: Screenshot format
+            PSION_TEST_PROFILE_DIR: Write cycle profiles of each test here
 
         Returns:
             TestConfig with values from environment variables
@@ -153,6 +158,10 @@ class TestConfig:
             if screenshot_format in ("image", "image_lcd", "text"):
                 config.screenshot_format = screenshot_format
 
+        # Cycle profiles
+        if profile_dir := os.environ.get("PSION_TEST_PROFILE_DIR"):
+            config.profile_output_dir = Path(profile_dir)
+
         return config
 
     @classmethod
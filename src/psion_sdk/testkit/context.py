@@ -421,13 +421,16 @@ class PsionTestContext:
         """
         Wait until text appears on display.
 
-        Polls the display at regular intervals until the specified text
-        appears or timeout is reached.
+        Runs the emulator until the display changes and checks it again,
+        until the specified text appears or timeout is reached. The text
+        is only searched after a change, so waiting on a static screen
+        does not rebuild it over and over.
 
         Args:
             text: Text to wait for
             timeout_cycles: Maximum cycles to wait (default: from config)
-            poll_interval: Cycles between display checks (default: from config)
+            poll_interval: Longest run between timeout checks; a display
+                change ends it sooner (default: from config)
             case_sensitive: Whether to match case (default: True)
 
         Returns:
@@ -445,21 +448,32 @@ class PsionTestContext:
         self._diagnostics.log_action_start("wait_for", f'"{text}"')
         try:
             start_cycles = self.total_cycles
+            text_to_find = text if case_sensitive else text.upper()
+            display = self.emulator.display
+            checked_changes = None
+
+            while True:
+                if display.change_count != checked_changes:
+                    checked_changes = display.change_count
+                    display_text = self.display_text
+                    if not case_sensitive:
+                        display_text = display_text.upper()
+
+                    if text_to_find in display_text:
+                        self._diagnostics.log_action_end("success")
+                        return self
 
-            while (self.total_cycles - start_cycles) < timeout:
-                display_text = self.display_text
-                if not case_sensitive:
-                    display_text = display_text.upper()
-                    text_to_find = text.upper()
-                else:
-                    text_to_find = text
-
-                if text_to_find in display_text:
-                    self._diagnostics.log_action_end("success")
-                    return self
-
-                # Run more cycles
-                self.emulator.run(interval)
+                waited = self.total_cycles - start_cycles
+                if waited >= timeout:
+                    break
+
+                # Run until the display changes (or interval cycles pass)
+                before = self.total_cycles
+                self.emulator.run(min(interval, timeout - waited),
+                                  stop_on_display_change=True)
+                if self.total_cycles == before:
+                    # Held at a breakpoint - step over it
+                    self.emulator.step()
 
             # Timeout
             raise TestTimeoutError(
@@ -116,18 +116,36 @@ def psion_test(
                 pytest.skip("ROM files not available")
                 return
 
-            # Create emulator - let it find the correct ROM for the model
-            try:
-                emu_config = EmulatorConfig(model=model)
-                emulator = Emulator(emu_config)
-                emulator.reset()
-            except Exception as e:
-                raise TestSetupError(
-                    f"Failed to create emulator: {e}",
-                    phase="create_emulator",
-                    model=model,
-                    cause=e,
-                )
+            # Check for _psion_program (from @with_program decorator)
+            program_info = getattr(func, "_psion_program", None)
+
+            # Without packs the booted state is the same for every test,
+            # so fork the session-wide booted emulator instead of booting
+            use_booted_pool = requires_boot and not opk_files and not program_info
+            if use_booted_pool:
+                from .fixtures import get_booted_pool
+                try:
+                    emulator = get_booted_pool(model, config=test_config).fork()
+                except Exception as e:
+                    raise TestSetupError(
+                        f"Boot sequence failed: {e}",
+                        phase="boot",
+                        model=model,
+                        cause=e,
+                    )
+            else:
+                # Create emulator - let it find the correct ROM for the model
+                try:
+                    emu_config = EmulatorConfig(model=model)
+                    emulator = Emulator(emu_config)
+                    emulator.reset()
+                except Exception as e:
+                    raise TestSetupError(
+                        f"Failed to create emulator: {e}",
+                        phase="create_emulator",
+                        model=model,
+                        cause=e,
+                    )
 
             # Load OPK files if specified
             if opk_files:
@@ -148,8 +166,6 @@ def psion_test(
                             cause=e,
                         )
 
-            # Check for _psion_program (from @with_program decorator)
-            program_info = getattr(func, "_psion_program", None)
             if program_info:
                 opk_path = _compile_program(
                     program_info["source_path"],
@@ -172,7 +188,7 @@ def psion_test(
             ctx._diagnostics.set_test_name(func.__name__)
 
             # Boot if required
-            if requires_boot:
+            if requires_boot and not use_booted_pool:
                 try:
                     BootSequence.execute(ctx, verify=True)
                 except Exception as e:
@@ -183,12 +199,19 @@ def psion_test(
                         cause=e,
                     )
 
+            # Profile the test body (not setup) when requested
+            if test_config.profile_output_dir is not None:
+                emulator.start_profiling()
+
             # Run the actual test
             try:
                 return func(ctx, *args, **kwargs)
             finally:
-                # Cleanup (if needed)
-                pass
+                if emulator.profiler is not None:
+                    name = func.__name__
+                    if len(test_models) > 1:
+                        name += f"-{model}"
+                    _write_profile(emulator, test_config.profile_output_dir, name)
 
         # Mark as requiring ROM for pytest collection
         if requires_rom:
@@ -358,6 +381,27 @@ def _find_project_root() -> Path:
     return Path.cwd()
 
 
+def _write_profile(emulator: Emulator, output_dir: Path, name: str) -> None:
+    """
+    Stop profiling and write the test's reports.
+
+    Writes <name>.prof (flat profile and call graph) and <name>.folded
+    (collapsed stacks for flamegraph tools).
+
+    Args:
+        emulator: Emulator being profiled
+        output_dir: Directory for the reports
+        name: Base file name
+    """
+    profiler = emulator.stop_profiling()
+    output_dir.mkdir(parents=True, exist_ok=True)
+    (output_dir / f"{name}.prof").write_text(
+        profiler.report_flat() + "\n\n" + profiler.report_callgraph() + "\n",
+        encoding="utf-8",
+    )
+    profiler.write_report(output_dir / f"{name}.folded", "collapsed")
+
+
 def _compile_program(
     source_path: str,
     build_args: Dict[str, Any],
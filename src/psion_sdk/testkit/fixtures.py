@@ -7,9 +7,13 @@ pre-configured emulator instances at various states:
 
     fresh_emulator   - Reset but not booted
     booted_emulator  - Booted to main menu
+    booted_fork      - Independent fork of a session-wide booted emulator
     psion_ctx        - Full PsionTestContext with booted emulator
     test_config      - Test configuration (session-scoped)
 
+Booting is done once per model and ROM for the whole session (see
+get_booted_pool); booted fixtures start from a fork of that state.
+
 Usage:
     In your conftest.py, register these fixtures:
 
@@ -27,11 +31,11 @@ Copyright (c) 2025-2026 Hugo José Pinto & Contributors
 
 from __future__ import annotations
 from pathlib import Path
-from typing import Generator, Optional
+from typing import Dict, Generator, Optional, Tuple
 
 import pytest
 
-from psion_sdk.emulator import Emulator, EmulatorConfig
+from psion_sdk.emulator import Emulator, EmulatorConfig, EmulatorPool
 
 from .config import TestConfig, get_default_config, set_default_config
 from .context import PsionTestContext
@@ -39,6 +43,47 @@ from .sequences import BootSequence
 from .exceptions import ROMNotAvailableError
 
 
+# ═══════════════════════════════════════════════════════════════════════════════
+# BOOTED EMULATOR POOLS
+# ═══════════════════════════════════════════════════════════════════════════════
+
+
+# (model, rom_path) -> pool whose template is booted to the main menu
+_booted_pools: Dict[Tuple[str, Optional[Path]], EmulatorPool] = {}
+
+
+def get_booted_pool(
+    model: str,
+    rom_path: Optional[Path] = None,
+    config: Optional[TestConfig] = None,
+) -> EmulatorPool:
+    """
+    Get the session-wide pool of emulators booted to the main menu.
+
+    The boot sequence runs once per (model, rom_path) on first use; every
+    later caller forks the captured state instead of booting again.
+
+    Args:
+        model: Psion model code
+        rom_path: Custom ROM (None for the model default)
+        config: Test configuration used for the boot sequence
+
+    Returns:
+        EmulatorPool for the model and ROM
+    """
+    key = (model, rom_path)
+    pool = _booted_pools.get(key)
+    if pool is None:
+        test_config = config or get_default_config()
+
+        def boot(emulator: Emulator) -> None:
+            BootSequence.execute(PsionTestContext(emulator, test_config), verify=True)
+
+        pool = EmulatorPool(EmulatorConfig(model=model, rom_path=rom_path), prepare=boot)
+        _booted_pools[key] = pool
+    return pool
+
+
 # ═══════════════════════════════════════════════════════════════════════════════
 # FIXTURE IMPLEMENTATIONS
 # ═══════════════════════════════════════════════════════════════════════════════
@@ -105,22 +150,46 @@ def booted_emulator(
     """
     Fixture: Emulator booted to main menu.
 
-    Boots the OS and waits until main menu is displayed.
-    Use for tests that interact with the OS.
+    Loads the state of the session's booted emulator for this model (the
+    boot sequence itself runs once per session). Use for tests that
+    interact with the OS.
 
     Example:
         def test_menu_shows_find(booted_emulator):
             assert "FIND" in booted_emulator.display_text
     """
-    # Create a temporary context for booting
-    ctx = PsionTestContext(fresh_emulator, test_config)
-
-    # Execute boot sequence
-    BootSequence.execute(ctx, verify=True)
+    pool = get_booted_pool(
+        fresh_emulator.config.model, fresh_emulator.config.rom_path, test_config
+    )
+    fresh_emulator.load_image(pool.image)
 
     yield fresh_emulator
 
 
+@pytest.fixture(scope="function")
+def booted_fork(request, test_config: TestConfig) -> Generator[Emulator, None, None]:
+    """
+    Fixture: Independent fork of the session's booted emulator.
+
+    Like booted_emulator but without creating a fresh emulator first. The
+    model defaults to the configured one and can be parameterized.
+
+    Example:
+        def test_menu(booted_fork):
+            booted_fork.tap_key("EXE")
+
+        @pytest.mark.parametrize("booted_fork", ["LZ64"], indirect=True)
+        def test_lz_menu(booted_fork):
+            assert booted_fork.model.model_type == "LZ64"
+    """
+    if test_config.find_rom_path() is None:
+        pytest.skip("ROM files not available")
+        return
+
+    model = getattr(request, "param", None) or test_config.default_model
+    yield get_booted_pool(model, config=test_config).fork()
+
+
 @pytest.fixture(scope="function")
 def psion_ctx(
     booted_emulator: Emulator, test_config: TestConfig
@@ -212,6 +281,23 @@ def compiled_program(request, test_config: TestConfig) -> Path:
 # ═══════════════════════════════════════════════════════════════════════════════
 
 
+def pytest_addoption(parser):
+    """
+    Add Psion command line options.
+
+    Options:
+        --psion-profile DIR: Profile the body of each @psion_test and
+            write its flat/call-graph report (.prof) and collapsed stacks
+            (.folded) to DIR
+    """
+    parser.addoption(
+        "--psion-profile",
+        metavar="DIR",
+        default=None,
+        help="Write emulator cycle profiles of each Psion test to DIR",
+    )
+
+
 def pytest_configure(config):
     """
     Configure pytest markers for Psion tests.
@@ -219,12 +305,18 @@ def pytest_configure(config):
     Registers custom markers:
         psion_requires_rom: Test requires ROM files
         psion_slow: Test is slow (>5 seconds)
+
+    Also applies the --psion-profile option to the default TestConfig.
     """
     config.addinivalue_line(
         "markers", "psion_requires_rom: Test requires ROM files to run"
     )
     config.addinivalue_line("markers", "psion_slow: Test is slow (>5 seconds)")
 
+    profile_dir = config.getoption("--psion-profile", default=None)
+    if profile_dir:
+        get_default_config().profile_output_dir = Path(profile_dir)
+
 
 def pytest_collection_modifyitems(config, items):
     """
@@ -278,6 +278,43 @@ __S1:
         # It should NOT be 0 or some small value
         assert symbols["__S1"] > 1000, f"__S1 address {symbols['__S1']} is too small, runtime.inc may not be fully processed"
 
+    def test_include_pass2_error_reported(self, tmp_path):
+        """A bad line in an include file is an error, not the end of the file.
+
+        This is a regression test for a bug where an error in pass 2 of an
+        included file silently dropped the rest of that file from the output.
+        """
+        (tmp_path / "bad.inc").write_text(
+            "_first:\n        STAB    A,X\n_last:\n        RTS\n")
+        source = '        INCLUDE "bad.inc"\n'
+        asm = Assembler(include_paths=[str(tmp_path)])
+        with pytest.raises(AssemblerError, match="bad.inc:2"):
+            asm.assemble(source)
+
+    def test_include_parsed_once_per_assembly(self, tmp_path):
+        """Both passes, relaxation and unused routine removal share one parse."""
+        from psion_sdk.assembler.parser import parse_file
+
+        (tmp_path / "lib.inc").write_text(
+            "_far:\n        RTS\n_unused:\n        RTS\n")
+        source = (
+            "_entry:\n        BEQ _far\n        RMB 200\n        RTS\n"
+            '        INCLUDE "lib.inc"\n'
+        )
+        parsed = []
+
+        def counting_parser(path):
+            parsed.append(str(path))
+            return parse_file(path)
+
+        asm = Assembler(include_paths=[str(tmp_path)], strip_unused=True,
+                        parse_include=counting_parser)
+        result = asm.assemble(source)
+        assert parsed == [str(tmp_path / "lib.inc")]
+        assert result == Assembler(include_paths=[str(tmp_path)],
+                                   strip_unused=True).assemble(source)
+        assert asm.get_included_files() == [str((tmp_path / "lib.inc").resolve())]
+
 
 # =============================================================================
 # Listing Output Tests
@@ -755,7 +792,8 @@ _skip:      SUBD    0,X         ; 2 bytes: A3 00 (sets Z if D==mem)
             BEQ     _end        ; 2 bytes
 _end:       RTS                 ; 1 byte
         """
-        asm = Assembler()
+        # Unoptimized: the dataflow optimizer would fold this constant test
+        asm = Assembler(optimize=False)
         result = asm.assemble(source)
         symbols = asm.get_symbols()
         code = result[7:]  # Skip OB3 header
@@ -1024,6 +1062,18 @@ _code:      LDX     #_data      ; Load address of _data, needs relocation
 
         assert found_ldx_imm, "LDX #label should generate CE opcode"
 
+    def test_relocatable_fdb_label_adds_fixup(self):
+        """FDB of a label (e.g. a jump table) is relocated; FDB of a number is not."""
+        source = """
+_table:     FDB     _one,_two
+            FDB     $1234
+_one:       RTS
+_two:       RTS
+        """
+        asm = Assembler(relocatable=True)
+        asm.assemble(source)
+        assert asm.get_fixup_count() == 2
+
 
 # =============================================================================
 # Model Support Tests
@@ -1164,6 +1214,24 @@ class TestModelSupport:
         assert code[0] == 0x86
         assert code[1] == 0x02
 
+    def test_ifdef_label_case_insensitive(self):
+        """#IFDEF should find a label whatever case it is written in."""
+        asm = Assembler()
+        source = """
+            ORG $8000
+    _fp_from_str:
+            NOP
+            #IFDEF _fp_from_str
+                LDAA #1
+            #ENDIF
+            #IFNDEF _Fp_From_Str
+                LDAA #2
+            #ENDIF
+            END
+        """
+        asm.assemble_string(source)
+        assert asm.get_code() == bytes([0x01, 0x86, 0x01])
+
     def test_disp_rows_in_code(self):
         """DISP_ROWS symbol should be usable in code."""
         asm = Assembler(target_model="LZ")
@@ -1482,6 +1550,30 @@ _target2:   RTS
         # Should compile without error, proving iteration converged
         assert len(result) > 0
 
+    def test_macro_branches_relaxed_per_invocation(self):
+        """Each expansion of a macro branch is relaxed on its own distance."""
+        source = """
+            ORG $8000
+MACRO TESTZ
+            TSTA
+            BEQ _far
+            ENDM
+            TESTZ           ; 203 bytes from _far: needs long form
+            RMB 200
+            TESTZ           ; Just before _far: stays short
+_far:       RTS
+        """
+        asm = Assembler(optimize=False)
+        result = asm.assemble(source)
+        code = result[7:]
+
+        # TSTA; BNE +3; JMP _far
+        assert code[0:3] == bytes([0x4D, 0x26, 0x03])
+        assert code[3] == 0x7E
+        # TSTA; BEQ +0 after the reserved bytes
+        assert code[206:209] == bytes([0x4D, 0x27, 0x00])
+        assert len(code) == 210
+
     def test_edge_case_exactly_128_bytes(self):
         """Branch exactly at -128 byte boundary should still use short form."""
         # -128 is still within range, so should use short branch
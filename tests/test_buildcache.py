@@ -0,0 +1,198 @@
+# =============================================================================
+# test_buildcache.py - psbuild Build Cache Tests
+# =============================================================================
+# Tests for the content-hash build cache and the incremental, parallel
+# compilation of multi-file builds.
+#
+# These tests verify:
+#   - Entries are found by key and survive a new BuildCache instance
+#   - An entry is dropped when a file it was built from changes
+#   - Cached include tokens and statements match a fresh parse
+#   - Unchanged C files are not recompiled, edited ones are
+#   - Parallel and serial compilation produce the same units
+#   - The optimization level is part of a unit's key
+# =============================================================================
+
+from pathlib import Path
+
+import pytest
+from psion_sdk.assembler.lexer import tokenize_file
+from psion_sdk.assembler.parser import parse_file
+from psion_sdk.cli.buildcache import BuildCache
+from psion_sdk.cli.psbuild import (
+    assemble_to_ob3,
+    build_include_paths,
+    compile_c_to_asm,
+    compile_c_units,
+    find_main_file,
+)
+from psion_sdk.smallc.errors import SmallCCompilationError
+
+
+INCLUDE_DIR = Path(__file__).parent.parent / "include"
+
+
+# =============================================================================
+# Cache Tests
+# =============================================================================
+
+class TestBuildCache:
+    """Tests for BuildCache entries."""
+
+    def test_put_then_get(self, tmp_path):
+        """A stored value is returned for the same key, also by a new instance."""
+        cache = BuildCache(tmp_path / "cache")
+        key = BuildCache.key("compile", "int x;", "XP")
+        assert cache.get("compile", key) is None
+        cache.put("compile", key, {"asm": "RTS"})
+        assert cache.get("compile", key) == {"asm": "RTS"}
+        assert BuildCache(tmp_path / "cache").get("compile", key) == {"asm": "RTS"}
+
+    def test_key_depends_on_every_part(self):
+        """Parts are not simply concatenated."""
+        assert BuildCache.key("ab", "c") != BuildCache.key("a", "bc")
+        assert BuildCache.key("a", None) != BuildCache.key("a", "")
+
+    def test_changed_dependency_invalidates(self, tmp_path):
+        """An entry built from a header is dropped when the header changes."""
+        header = tmp_path / "defs.h"
+        header.write_text("#define N 1\n")
+        cache = BuildCache(tmp_path / "cache")
+        cache.put("compile", "k" * 64, "old", [str(header)])
+        assert cache.get("compile", "k" * 64) == "old"
+
+        header.write_text("#define N 22\n")
+        assert BuildCache(tmp_path / "cache").get("compile", "k" * 64) is None
+
+    def test_missing_dependency_invalidates(self, tmp_path):
+        """An entry is dropped when a file it was built from is deleted."""
+        header = tmp_path / "defs.h"
+        header.write_text("#define N 1\n")
+        cache = BuildCache(tmp_path / "cache")
+        cache.put("compile", "k" * 64, "old", [str(header)])
+        header.unlink()
+        assert cache.get("compile", "k" * 64) is None
+
+    def test_corrupt_entry_is_a_miss(self, tmp_path):
+        """A damaged entry file is treated as absent."""
+        cache = BuildCache(tmp_path / "cache")
+        cache.put("compile", "k" * 64, "value")
+        entry = next((tmp_path / "cache").rglob("*.pkl"))
+        entry.write_bytes(b"not a pickle")
+        assert cache.get("compile", "k" * 64) is None
+
+    def test_no_temp_files_left(self, tmp_path):
+        """Entries are written through a temp file that is renamed in place."""
+        cache = BuildCache(tmp_path / "cache")
+        cache.put("compile", "k" * 64, "value")
+        assert not list((tmp_path / "cache").rglob("*.tmp"))
+
+    def test_include_tokens(self, tmp_path):
+        """Cached include tokens equal the lexer's, and come from disk next time."""
+        path = INCLUDE_DIR / "runtime.inc"
+        cache = BuildCache(tmp_path / "cache")
+        assert cache.tokenize_include(path) == tokenize_file(path)
+        again = BuildCache(tmp_path / "cache")
+        assert again.tokenize_include(path) == tokenize_file(path)
+        assert again.hits == 1
+
+    def test_include_statements(self, tmp_path):
+        """Cached include statements equal the parser's, and come from disk next time."""
+        path = INCLUDE_DIR / "runtime.inc"
+        cache = BuildCache(tmp_path / "cache")
+        assert cache.parse_include(path) == parse_file(path)
+        assert cache.parse_include(path) is cache.parse_include(path)
+        again = BuildCache(tmp_path / "cache")
+        assert again.parse_include(path) == parse_file(path)
+        assert again.hits == 1
+
+
+# =============================================================================
+# psbuild Tests
+# =============================================================================
+
+class TestIncrementalBuild:
+    """Tests for cached and parallel compilation in psbuild."""
+
+    HELPER = "#include \"defs.h\"\nint helper() { return LIMIT; }\n"
+    MAIN = "#include <psion.h>\nextern int helper();\nvoid main() { helper(); }\n"
+
+    @pytest.fixture
+    def project(self, tmp_path):
+        """A two-file project with a local header."""
+        (tmp_path / "defs.h").write_text("#define LIMIT 10\n")
+        (tmp_path / "helper.c").write_text(self.HELPER)
+        (tmp_path / "main.c").write_text(self.MAIN)
+        files = [tmp_path / "helper.c", tmp_path / "main.c"]
+        return files, build_include_paths((), files)
+
+    def test_units_compiled_in_right_mode(self, project):
+        """The main() file gets the runtime, the other file library mode."""
+        files, paths = project
+        helper, main = compile_c_units(files, paths, None, False)
+        assert not helper.has_main and "_entry" not in helper.assembly
+        assert main.has_main and "_entry" in main.assembly
+
+    def test_units_reused_until_header_changes(self, project, tmp_path):
+        """A rebuild reuses every unit; editing a header recompiles its users."""
+        files, paths = project
+        cache = BuildCache(tmp_path / "cache")
+        compile_c_units(files, paths, None, False, cache=cache)
+
+        again = compile_c_units(files, paths, None, False, cache=BuildCache(tmp_path / "cache"))
+        assert [unit.cached for unit in again] == [True, True]
+
+        (tmp_path / "defs.h").write_text("#define LIMIT 20\n")
+        edited = compile_c_units(files, paths, None, False, cache=BuildCache(tmp_path / "cache"))
+        assert [unit.cached for unit in edited] == [False, True]
+        assert "20" in edited[0].assembly
+
+    def test_parallel_matches_serial(self, project):
+        """Compiling on several processes gives the same units."""
+        files, paths = project
+        serial = compile_c_units(files, paths, None, False, jobs=1)
+        parallel = compile_c_units(files, paths, None, False, jobs=2)
+        assert [u.assembly for u in serial] == [u.assembly for u in parallel]
+        assert [u.has_main for u in serial] == [u.has_main for u in parallel]
+
+    def test_parallel_error_reported(self, project, tmp_path):
+        """A compile error in a worker process is raised in the build."""
+        files, paths = project
+        (tmp_path / "helper.c").write_text("int helper( { return 1; }\n")
+        with pytest.raises(SmallCCompilationError, match="helper.c"):
+            compile_c_units(files, paths, None, False, jobs=2)
+
+    def test_opt_level_is_part_of_key(self, project, tmp_path):
+        """Units compiled at another optimization level are not reused."""
+        files, paths = project
+        cache = BuildCache(tmp_path / "cache")
+        compile_c_units(files, paths, None, False, cache=cache)
+        inlined = compile_c_units(files, paths, None, False, cache=cache, opt_level=2)
+        assert [unit.cached for unit in inlined] == [False, False]
+        assert "PSHX" not in inlined[0].assembly.split("_helper:")[1]
+
+    def test_find_main_file_uses_units(self, project):
+        """main() detection can reuse compiled units instead of parsing."""
+        files, paths = project
+        units = compile_c_units(files, paths, None, False)
+        result = find_main_file(files, paths, units=units)
+        assert result.found
+        assert result.main_file == files[1]
+        assert [name for name, _ in result.parsed_asts] == [str(f) for f in files]
+
+    def test_single_file_assembly_cached(self, tmp_path):
+        """compile_c_to_asm and assemble_to_ob3 reuse their output."""
+        source = tmp_path / "hello.c"
+        source.write_text('#include <psion.h>\nvoid main() { print("Hi"); }\n')
+        paths = build_include_paths((), [source])
+        cache = BuildCache(tmp_path / "cache")
+        outputs = []
+        for run in range(2):
+            asm = tmp_path / f"hello{run}.asm"
+            ob3 = tmp_path / f"HELLO{run}.ob3"
+            compile_c_to_asm(source, asm, paths, None, False, cache=cache)
+            assemble_to_ob3(asm, ob3, paths, None, relocatable=True, optimize=True,
+                            verbose=False, strip_unused=True, cache=cache)
+            outputs.append((asm.read_text(), ob3.read_bytes()))
+        assert outputs[0] == outputs[1]
+        assert cache.hits >= 2
@@ -21,6 +21,8 @@ Note: Hardware-dependent tests are marked with @pytest.mark.hardware
 and are skipped by default. Run with --hardware flag to include them.
 """
 
+import time
+
 import pytest
 from unittest.mock import Mock, MagicMock, patch
 from io import BytesIO
@@ -57,14 +59,34 @@ from psion_sdk.comms.serial import (
     get_default_port_prefix,
     format_port_list,
 )
+from psion_sdk.comms.boot import (
+    BootTransfer,
+    FlashState,
+    PACK_DATA_CHUNK_SIZE,
+    flash_state_path,
+)
+from psion_sdk.comms.fleet import (
+    DeviceResult,
+    FleetProgress,
+    expand_ports,
+    format_fleet_summary,
+    run_fleet,
+)
 from psion_sdk.comms.transfer import (
     FileTransfer,
     FileType,
     OpenMode,
     ResponseStatus,
+    TransferStats,
     FTRAN_OVERLAY,
     MAX_BLOCK_SIZE,
+    CMD_OPEN,
+    CMD_CLOSE,
+    CMD_PUT_DATA,
+    CMD_GET_DATA,
+    EOF_DISCONNECT_BYTE,
 )
+from psion_sdk.opk import create_opk
 from psion_sdk.errors import (
     CommsError,
     ConnectionError,
@@ -766,6 +788,404 @@ class TestIntegration:
             assert decoded.data == original.data
 
 
+# =============================================================================
+# Simulated Transfer Tests
+# =============================================================================
+
+class FakePsionPort:
+    """
+    Serial port with a simulated Psion in COMMS mode at the other end.
+
+    The Psion answers the PC's Link Request, sends FTRAN, and then, for
+    every DATA answer from the PC, ACKs it and sends the command that
+    next_command(answer) returns, or disconnects when that is None.
+    """
+
+    def __init__(self, next_command):
+        self.timeout = 0.05
+        self.next_command = next_command
+        self.connected = False
+        self.sequence = 0
+        self.answers = []           # DATA payloads from the PC
+        self.flushed_answers = 0    # answers the PC flushed right after writing
+        self.disconnect_data = None
+        self._from_pc = bytearray()
+        self._to_pc = bytearray()
+        self._unflushed_answer = False
+
+    @property
+    def in_waiting(self):
+        return len(self._to_pc)
+
+    def read(self, size=1):
+        chunk = bytes(self._to_pc[:size])
+        del self._to_pc[:size]
+        return chunk
+
+    def flush(self):
+        if self._unflushed_answer:
+            self.flushed_answers += 1
+            self._unflushed_answer = False
+
+    def write(self, data):
+        self._unflushed_answer = False
+        self._from_pc.extend(data)
+        while True:
+            end = _find_footer(bytes(self._from_pc))
+            if end < 0 or end + 4 > len(self._from_pc):
+                break
+            packet = Packet.from_bytes(bytes(self._from_pc[:end + 4]))
+            del self._from_pc[:end + 4]
+            self._handle(packet)
+
+    def _send(self, ptype, sequence, data=b""):
+        self._to_pc.extend(Packet(ptype, sequence, data).to_bytes())
+
+    def _command(self, data):
+        self.sequence = (self.sequence + 1) & 7
+        self._send(PacketType.DATA, self.sequence, data)
+
+    def _handle(self, packet):
+        if packet.type == PacketType.LINK_REQUEST and not self.connected:
+            self._send(PacketType.LINK_REQUEST, 0)
+        elif packet.type == PacketType.ACK and not self.connected:
+            self.connected = True
+            self._command(FTRAN_OVERLAY)
+        elif packet.type == PacketType.DATA:
+            assert packet.sequence == self.sequence
+            self.answers.append(packet.data)
+            self._unflushed_answer = True
+            self._send(PacketType.ACK, packet.sequence)
+            command = self.next_command(packet.data)
+            if command is None:
+                self._send(PacketType.DISCONNECT, 0)
+            else:
+                self._command(command)
+        elif packet.type == PacketType.DISCONNECT:
+            self.disconnect_data = packet.data
+
+
+class TestSimulatedTransfer:
+    """FTRAN transfers against a simulated Psion, stop-and-wait and pipelined."""
+
+    FILE = bytes(range(256)) * 4 + b"\x10" * 100  # Includes bytes that need escaping
+
+    def serving_port(self, lengths):
+        """A Psion in RECEIVE mode that asks for blocks of the given lengths in turn."""
+        def next_command(answer):
+            if len(port.answers) == 1:  # FTRAN answered
+                return bytes([CMD_OPEN, OpenMode.READ_ONLY, FileType.OPL]) + b"TEST\x00"
+            block = len(port.answers) - 2
+            return bytes([CMD_GET_DATA, lengths[block % len(lengths)]])
+        port = FakePsionPort(next_command)
+        return port
+
+    @staticmethod
+    def served_data(port):
+        """File bytes the Psion received (answers after the Open response)."""
+        return b"".join(port.answers[2:])
+
+    @pytest.mark.parametrize("pipelined", [False, True])
+    def test_serve_file(self, pipelined):
+        """The whole file arrives, in blocks as large as the Psion asks for."""
+        port = self.serving_port([200])
+        transfer = FileTransfer(LinkProtocol(port), pipelined=pipelined)
+        transfer.serve_file("TEST", self.FILE)
+
+        assert self.served_data(port) == self.FILE
+        assert port.disconnect_data == bytes([EOF_DISCONNECT_BYTE])
+        stats = transfer.last_stats
+        assert stats.total_bytes == len(self.FILE)
+        assert stats.blocks == 6
+        assert stats.max_block == 200
+        assert stats.pipelined == pipelined
+
+    def test_pipelined_does_not_wait_for_blocks(self):
+        """Pipelined mode leaves data blocks to drain in the background."""
+        port = self.serving_port([255])
+        FileTransfer(LinkProtocol(port)).serve_file("TEST", self.FILE)
+        assert port.flushed_answers == len(port.answers)
+
+        port = self.serving_port([255])
+        FileTransfer(LinkProtocol(port), pipelined=True).serve_file("TEST", self.FILE)
+        assert self.served_data(port) == self.FILE
+        assert port.flushed_answers == 2  # Only the FTRAN and Open answers
+
+    def test_pipelined_changing_block_size(self):
+        """A request that differs from the prepared block is answered as asked."""
+        port = self.serving_port([50, 50, 120, 7])
+        FileTransfer(LinkProtocol(port), pipelined=True).serve_file("TEST", self.FILE)
+        assert [len(a) for a in port.answers[2:6]] == [50, 50, 120, 7]
+        assert self.served_data(port) == self.FILE
+
+    @pytest.mark.parametrize("pipelined", [False, True])
+    def test_receive_file(self, pipelined):
+        """PutData blocks from the Psion are collected and counted."""
+        blocks = [self.FILE[i:i + 100] for i in range(0, len(self.FILE), 100)]
+        commands = iter(
+            [bytes([CMD_OPEN, OpenMode.CREATE_REPLACE, FileType.OPL]) + b"TEST\x00"]
+            + [bytes([CMD_PUT_DATA]) + block for block in blocks]
+            + [bytes([CMD_CLOSE])]
+        )
+        port = FakePsionPort(lambda answer: next(commands, None))
+        transfer = FileTransfer(LinkProtocol(port), pipelined=pipelined)
+
+        name, data = transfer.receive_file_simple()
+        assert (name, data) == ("TEST", self.FILE)
+        assert transfer.last_stats.blocks == len(blocks)
+        assert transfer.last_stats.total_bytes == len(self.FILE)
+
+    def test_stats_format(self):
+        """TransferStats reports bytes per second."""
+        stats = TransferStats(total_bytes=1200, blocks=5, elapsed=2.0)
+        assert stats.bytes_per_second == 600
+        assert str(stats) == "1200 bytes in 5 blocks, 2.00 s (600 bytes/s)"
+        assert TransferStats().bytes_per_second == 0
+
+
+class FakeBootloaderPort:
+    """
+    Serial port with the BOOT bootloader at the other end, ready for pack data.
+
+    The bootloader first sends ``first`` (0x0101 "ready", or a status it
+    repeats after a dropped link), then ACKs every block from the PC and
+    asks for the next one with a status packet. Blocks numbered in
+    ``lost`` do not arrive, and the bootloader repeats its last status.
+    After ``drop_after`` blocks arrive, the status is lost and reads fail
+    like a dropped link.
+    """
+
+    def __init__(self, written=b"", sequence=0, first=b"\x01\x01", lost=(), drop_after=None):
+        self.timeout = 0.05
+        self.written = bytearray(written)
+        self.sequence = sequence
+        self.lost = set(lost)
+        self.drop_after = drop_after
+        self.blocks_sent = 0        # Blocks from the PC, lost ones included
+        self.blocks_received = 0
+        self.empty_blocks = 0
+        self.dropped = False
+        self.disconnect_data = None
+        self._from_pc = bytearray()
+        self._to_pc = bytearray()
+        self._last_status = first
+        self._send(PacketType.DATA, sequence, first)
+
+    def read(self, size=1):
+        if self.dropped and not self._to_pc:
+            raise OSError("link dropped")
+        chunk = bytes(self._to_pc[:size])
+        del self._to_pc[:size]
+        return chunk
+
+    def flush(self):
+        pass
+
+    def write(self, data):
+        self._from_pc.extend(data)
+        while True:
+            end = _find_footer(bytes(self._from_pc))
+            if end < 0 or end + 4 > len(self._from_pc):
+                break
+            packet = Packet.from_bytes(bytes(self._from_pc[:end + 4]))
+            del self._from_pc[:end + 4]
+            self._handle(packet)
+
+    def _send(self, ptype, sequence, data=b""):
+        self._to_pc.extend(Packet(ptype, sequence, data).to_bytes())
+
+    def _handle(self, packet):
+        if packet.type == PacketType.DISCONNECT:
+            self.disconnect_data = packet.data
+        if packet.type != PacketType.DATA or self.dropped:
+            return
+        if not packet.data:
+            # Completion: the first empty DATA gets a status, the second only an ACK
+            self.empty_blocks += 1
+            self._send(PacketType.ACK, packet.sequence)
+            if self.empty_blocks == 1:
+                self.sequence = (packet.sequence + 1) & 7
+                self._send(PacketType.DATA, self.sequence, b"\x00\x04")
+            return
+
+        block = self.blocks_sent
+        self.blocks_sent += 1
+        if block in self.lost:
+            self._send(PacketType.DATA, self.sequence, self._last_status)
+            return
+        assert packet.sequence == (self.sequence + 1) & 7
+        self.written.extend(packet.data)
+        self.blocks_received += 1
+        self._send(PacketType.ACK, packet.sequence)
+        self.sequence = (packet.sequence + 1) & 7
+        self._last_status = b"\x00\x04"
+        if self.blocks_received == self.drop_after:
+            self.dropped = True
+        else:
+            self._send(PacketType.DATA, self.sequence, self._last_status)
+
+
+class TestBootResume:
+    """Phase 2 of the BOOT protocol against a simulated bootloader."""
+
+    OPK = b"OPK\x00\x03\xe8" + bytes(range(250)) * 4  # 5 blocks of pack image
+    IMAGE = OPK[6:]
+
+    def start_data(self, port, checkpoint=None):
+        """Run phase 2 from the bootloader's "ready" packet."""
+        boot = BootTransfer(LinkProtocol(port))
+        boot.link._connected = True
+        boot.state = FlashState.for_opk(self.OPK)
+        boot._checkpoint = checkpoint
+        boot._phase2_send_pack_data(self.IMAGE, resume=True)
+        return boot
+
+    def test_complete_transfer(self):
+        """All blocks are written and the state records completion."""
+        port = FakeBootloaderPort()
+        boot = self.start_data(port)
+        assert bytes(port.written) == self.IMAGE
+        assert port.disconnect_data == b"\x00"
+        assert boot.state.complete
+        assert boot.state.acknowledged == len(self.IMAGE)
+
+    def test_lost_block_is_resent(self):
+        """A repeated status makes the PC resend its block, not skip it."""
+        port = FakeBootloaderPort(lost={0, 3})
+        self.start_data(port)
+        assert bytes(port.written) == self.IMAGE
+        assert port.blocks_sent == 7
+
+    @pytest.mark.parametrize("block_arrived", [True, False])
+    def test_resume_after_drop(self, tmp_path, block_arrived):
+        """
+        After a dropped link, the transfer continues from the saved state.
+
+        Whether or not the block in flight reached the bootloader, its
+        next status tells the PC which block to send.
+        """
+        state_path = tmp_path / "pack.opk.flash"
+        port = FakeBootloaderPort(drop_after=2)
+        with pytest.raises(OSError):
+            self.start_data(port, checkpoint=lambda state: state.save(state_path))
+
+        saved = FlashState.load(state_path)
+        assert saved.can_resume(self.OPK)
+        assert (saved.acknowledged, saved.sent) == (PACK_DATA_CHUNK_SIZE, 2 * PACK_DATA_CHUNK_SIZE)
+
+        if block_arrived:
+            # The bootloader wrote block 2; its status was lost and is sent again
+            resumed = FakeBootloaderPort(port.written, port.sequence, first=b"\x00\x04")
+        else:
+            # Block 2 never arrived; the bootloader repeats its previous status
+            resumed = FakeBootloaderPort(port.written[:saved.acknowledged], saved.sequence,
+                                         first=b"\x00\x04")
+        boot = BootTransfer(LinkProtocol(resumed))
+        boot.resume_pack(self.OPK, saved, checkpoint=lambda state: state.save(state_path))
+
+        assert bytes(resumed.written) == self.IMAGE
+        assert resumed.disconnect_data == b"\x00"
+        assert FlashState.load(state_path).complete
+
+    def test_resume_needs_matching_state(self):
+        """A state for another image, or a finished one, cannot be resumed."""
+        state = FlashState.for_opk(self.OPK)
+        state.sequence = 1
+        assert state.can_resume(self.OPK)
+        assert not state.can_resume(self.OPK[:-1] + b"\x00")
+        state.complete = True
+        with pytest.raises(ValueError):
+            BootTransfer(LinkProtocol(FakeBootloaderPort())).resume_pack(self.OPK, state)
+
+    def test_state_file(self, tmp_path):
+        """The state is kept next to the OPK, with its records; a damaged file reads as none."""
+        path = flash_state_path(tmp_path / "game.opk")
+        assert path.name == "game.opk.flash"
+        assert FlashState.load(path) is None
+
+        state = FlashState.for_opk(create_opk([("GAME", b"\x39")]))
+        assert [r.name for r in state.records] == ["MAIN", "GAME"]
+        state.save(path)
+        assert FlashState.load(path) == state
+
+        path.write_text("{not json")
+        assert FlashState.load(path) is None
+
+
+class TestFleet:
+    """Running a job on several ports at once."""
+
+    def test_expand_ports(self, tmp_path):
+        """Globs expand to sorted matches; names are kept; duplicates dropped."""
+        for name in ("ttyUSB1", "ttyUSB0", "ttyS0"):
+            (tmp_path / name).touch()
+        ports = expand_ports([f"{tmp_path}/ttyUSB*", f"COM3, {tmp_path}/ttyUSB0"])
+        assert ports == [f"{tmp_path}/ttyUSB0", f"{tmp_path}/ttyUSB1", "COM3"]
+        assert expand_ports([f"{tmp_path}/nothing*"]) == []
+
+    def test_devices_run_concurrently(self):
+        """Slow devices overlap, so the fleet takes about one device's time."""
+        def job(port, progress):
+            time.sleep(0.3)
+            return port.lower()
+
+        start = time.monotonic()
+        results = run_fleet([f"COM{i}" for i in range(8)], job)
+        assert time.monotonic() - start < 1.2
+        assert [r.message for r in results] == [f"com{i}" for i in range(8)]
+        assert all(r.ok for r in results)
+
+    def test_failure_is_reported_per_device(self):
+        """An exception fails only its own device."""
+        def job(port, progress):
+            if port == "COM2":
+                raise TransferError("Disk full")
+            progress(100, 100)
+
+        results = run_fleet(["COM1", "COM2"], job)
+        assert [r.ok for r in results] == [True, False]
+        assert results[0].bytes_done == 100
+        assert results[1].message == "TransferError: Disk full"
+        summary = format_fleet_summary(results).splitlines()
+        assert summary[0].split()[:3] == ["COM1", "OK", "100"]
+        assert summary[1].split()[:2] == ["COM2", "FAILED"]
+        assert summary[-1].startswith("1 of 2 devices succeeded")
+
+    def test_progress_line(self):
+        """Progress of all devices adds up to one line."""
+        lines = []
+        progress = FleetProgress(["A", "B"], output=lines.append, interval=0)
+        progress.callback("A")(50, 100)
+        progress.callback("B")(25, 100)
+        assert lines[-1] == "[=======-------------]  37% 75/200 bytes, 0 of 2 devices done"
+        progress.finish(DeviceResult("A", ok=False))
+        assert lines[-1].endswith("1 of 2 devices done, 1 failed")
+
+    def test_serve_file_on_fleet(self):
+        """FTRAN transfers to simulated Psions on four ports all complete."""
+        data = bytes(range(256)) * 3
+        ports = {}
+
+        def serving_port():
+            def next_command(answer):
+                if len(port.answers) == 1:
+                    return bytes([CMD_OPEN, OpenMode.READ_ONLY, FileType.OPL]) + b"TEST\x00"
+                return bytes([CMD_GET_DATA, 200])
+            port = FakePsionPort(next_command)
+            return port
+
+        def job(name, progress):
+            ports[name] = serving_port()
+            transfer = FileTransfer(LinkProtocol(ports[name]))
+            transfer.serve_file("TEST", data, progress=progress)
+            return str(transfer.last_stats)
+
+        results = run_fleet(["P1", "P2", "P3", "P4"], job)
+        assert all(r.ok for r in results)
+        assert all(b"".join(port.answers[2:]) == data for port in ports.values())
+        assert all(r.bytes_done == len(data) for r in results)
+
+
 # =============================================================================
 # Test Markers and Configuration
 # =============================================================================
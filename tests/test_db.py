@@ -7,6 +7,7 @@
 #   - db_read, db_get_str, db_get_int, db_get_idx: Record reading
 #   - db_first, db_next, db_back, db_find, db_eof: Navigation
 #   - db_update, db_erase: Record modification
+#   - db_read_block, db_append_many, db_load_rec, db_store_rec: Batched I/O
 #   - db_error, db_field_count, db_recsize, db_count, db_pos: Status
 #
 # These functions are OPTIONAL - they're only included when the user
@@ -745,6 +746,102 @@ class TestDbErase:
         assert "_db_erase" in asm
 
 
+# =============================================================================
+# Batched Record I/O Compilation Tests
+# =============================================================================
+
+class TestDbBatch:
+    """Tests for db_read_block, db_append_many, db_load_rec, db_store_rec."""
+
+    def test_db_read_block_loop_compiles(self, compiler):
+        """Reading a file a block at a time should compile."""
+        source = """
+        #include <psion.h>
+        #include <db.h>
+
+        char block[256];
+
+        void main() {
+            int n, p, total;
+            total = 0;
+            db_first();
+            while ((n = db_read_block(block, 256)) > 0) {
+                for (p = 0; n > 0; n--) {
+                    p += db_load_rec(block + p);
+                    total += db_get_int("age");
+                }
+            }
+        }
+        """
+        asm = compile_c(source, compiler)
+        assert "_db_read_block" in asm
+        assert "_db_load_rec" in asm
+
+    def test_db_append_many_compiles(self, compiler):
+        """Collecting records with db_store_rec for db_append_many should compile."""
+        source = """
+        #include <psion.h>
+        #include <db.h>
+
+        char block[200];
+
+        void main() {
+            int i, p;
+            p = 0;
+            for (i = 0; i < 10; i++) {
+                db_clear();
+                db_set_int_idx(1, i);
+                p += db_store_rec(block + p);
+            }
+            if (db_append_many(block, 10) < 10)
+                print_int(db_error());
+        }
+        """
+        asm = compile_c(source, compiler)
+        assert "_db_store_rec" in asm
+        assert "_db_append_many" in asm
+
+
+class TestDbIndex:
+    """Tests for db_index_build and db_seek_key."""
+
+    def test_db_index_lookup_compiles(self, compiler):
+        """Building an index and seeking a key should compile."""
+        source = """
+        #include <psion.h>
+        #include <db.h>
+
+        void main() {
+            int db;
+            char phone[16];
+            db = db_open('A', "CONTACTS", "name$,phone$");
+            if (db_index_build(db, 1) != DB_OK)
+                print_int(db_error());
+            if (db_seek_key("Alice") == DB_OK && db_read() == DB_OK)
+                db_get_str("phone", phone, 16);
+        }
+        """
+        asm = compile_c(source, compiler)
+        assert "_db_index_build" in asm
+        assert "_db_seek_key" in asm
+
+    def test_key_max_constant(self, compiler):
+        """DB_KEY_MAX should be usable for key buffers."""
+        source = """
+        #include <psion.h>
+        #include <db.h>
+
+        char key[16];
+
+        void main() {
+            db_get_idx(1, key, DB_KEY_MAX + 1);
+            db_seek_key(key);
+        }
+        """
+        asm = compile_c(source, compiler)
+        assert "_db_seek_key" in asm
+
+
 # =============================================================================
 # Assembly Tests
 # =============================================================================
@@ -766,6 +863,23 @@ class TestDbAssembly:
         assert result is not None
         assert len(result) > 0
 
+    def test_dbruntime_fully_assembled(self, assembler):
+        """Every routine up to the end of dbruntime.inc should be emitted."""
+        source = """
+            ORG $2100
+            INCLUDE "psion.inc"
+            INCLUDE "runtime.inc"
+            INCLUDE "dbruntime.inc"
+END_MARK:   RTS
+        """
+        assembler.assemble(source)
+        symbols = assembler.get_symbols()
+        for name in ("__DB_CATALOG", "__DB_READ_BLOCK", "__DB_APPEND_MANY",
+                     "__DB_LOAD_REC", "__DB_STORE_REC"):
+            assert name in symbols
+        assert symbols["__DB_CATALOG"] < symbols["END_MARK"]
+        assert symbols["END_MARK"] - 0x2100 > 2000
+
     def test_db_create_from_asm(self, assembler):
         """db_create called from assembly should assemble."""
         source = """
@@ -0,0 +1,205 @@
+"""
+Basic-Block Cache Tests
+=======================
+
+Tests for the optional block translation engine, verifying that it is
+exact with respect to the plain interpreter.
+
+These tests ensure:
+- Same registers, memory and cycle counts as the interpreter
+- Exact stops on PC breakpoints
+- Invalidation when cached code is overwritten
+- Timer reads see the same values as in the interpreter
+
+Copyright (c) 2025 Hugo José Pinto & Contributors
+"""
+
+import pytest
+from pathlib import Path
+import tempfile
+
+from psion_sdk.emulator import Emulator, EmulatorConfig, BreakReason
+
+
+# Accumulate 3 into $2100 sixteen times, then spin
+SUM_PROGRAM = bytes([
+    0x0F,              # $2000 SEI
+    0xCE, 0x00, 0x10,  # $2001 LDX #$0010
+    0x86, 0x03,        # $2004 LDAA #$03
+    0xF6, 0x21, 0x00,  # $2006 LDAB $2100
+    0x1B,              # $2009 ABA
+    0xB7, 0x21, 0x00,  # $200A STAA $2100
+    0x09,              # $200D DEX
+    0x26, 0xF4,        # $200E BNE $2004
+    0x20, 0xFE,        # $2010 BRA *
+])
+
+# Sample the free-running counter into a table at $2200
+TIMER_PROGRAM = bytes([
+    0x0F,              # $2000 SEI
+    0xCE, 0x22, 0x00,  # $2001 LDX #$2200
+    0x01,              # $2004 NOP
+    0x01,              # $2005 NOP
+    0xDC, 0x09,        # $2006 LDD $09
+    0xED, 0x00,        # $2008 STD 0,X
+    0x08,              # $200A INX
+    0x08,              # $200B INX
+    0x8C, 0x22, 0x40,  # $200C CPX #$2240
+    0x26, 0xF3,        # $200F BNE $2004
+    0x20, 0xFE,        # $2011 BRA *
+])
+
+
+@pytest.fixture
+def rom_path():
+    """Minimal ROM whose reset vector points at $2000."""
+    rom_data = bytearray([0x00] * 0x8000)
+    rom_data[0x7FFE] = 0x20
+    rom_data[0x7FFF] = 0x00
+
+    with tempfile.NamedTemporaryFile(suffix='.rom', delete=False) as f:
+        f.write(bytes(rom_data))
+        path = Path(f.name)
+    try:
+        yield path
+    finally:
+        path.unlink()
+
+
+def make_emulator(rom_path: Path, block_cache: bool, code: bytes) -> Emulator:
+    """
+    Create an emulator with a program injected at $2000.
+
+    Without the block cache this is the plain reference interpreter, so
+    idle fast-forwarding is turned off as well.
+    """
+    emu = Emulator(EmulatorConfig(
+        rom_path=rom_path,
+        block_cache=block_cache,
+        fast_forward_idle=block_cache,
+    ))
+    emu.reset()
+    emu.inject_program(code, entry_point=0x2000)
+    return emu
+
+
+def machine_state(emu: Emulator) -> tuple:
+    """Registers, cycle count and the program's data area."""
+    cpu = emu.cpu
+    return (
+        emu.total_cycles, cpu.pc, cpu.a, cpu.b, cpu.x, cpu.sp, cpu.state.flags,
+        emu.read_bytes(0x2100, 0x200),
+    )
+
+
+# =============================================================================
+# Equivalence Tests
+# =============================================================================
+
+class TestBlockCacheEquivalence:
+    """Block cache must match the interpreter exactly."""
+
+    def test_disabled_by_default(self, rom_path):
+        """Block cache is opt-in."""
+        emu = make_emulator(rom_path, False, SUM_PROGRAM)
+        assert emu._block_cache is None
+
+    def test_matches_interpreter(self, rom_path):
+        """Same state and cycles after running a loop."""
+        plain = make_emulator(rom_path, False, SUM_PROGRAM)
+        cached = make_emulator(rom_path, True, SUM_PROGRAM)
+
+        plain.run(5000)
+        cached.run(5000)
+
+        assert machine_state(cached) == machine_state(plain)
+        assert cached.read_byte(0x2100) == 48
+        assert cached._block_cache.hits > 0
+
+    def test_exact_cycle_budget(self, rom_path):
+        """Odd cycle budgets are not overshot by whole blocks."""
+        for budget in (1, 7, 13, 50, 101):
+            plain = make_emulator(rom_path, False, SUM_PROGRAM)
+            cached = make_emulator(rom_path, True, SUM_PROGRAM)
+            plain.run(budget)
+            cached.run(budget)
+            assert machine_state(cached) == machine_state(plain)
+
+    def test_timer_reads_match(self, rom_path):
+        """I/O inside a loop sees the same counter values."""
+        plain = make_emulator(rom_path, False, TIMER_PROGRAM)
+        cached = make_emulator(rom_path, True, TIMER_PROGRAM)
+
+        plain.run(5000)
+        cached.run(5000)
+
+        assert machine_state(cached) == machine_state(plain)
+
+
+# =============================================================================
+# Breakpoint Tests
+# =============================================================================
+
+class TestBlockCacheBreakpoints:
+    """Breakpoints inside cached code stop exactly."""
+
+    def test_stops_inside_block(self, rom_path):
+        """Breakpoint in the middle of a straight-line run."""
+        plain = make_emulator(rom_path, False, SUM_PROGRAM)
+        cached = make_emulator(rom_path, True, SUM_PROGRAM)
+
+        # Warm the cache before the breakpoint exists
+        plain.run(200)
+        cached.run(200)
+
+        plain.add_breakpoint(0x2009)
+        cached.add_breakpoint(0x2009)
+        plain_event = plain.run(5000)
+        cached_event = cached.run(5000)
+
+        assert cached_event.reason == BreakReason.PC_BREAKPOINT
+        assert plain_event.reason == cached_event.reason
+        assert cached.cpu.pc == 0x2009
+        assert machine_state(cached) == machine_state(plain)
+
+
+# =============================================================================
+# Invalidation Tests
+# =============================================================================
+
+class TestBlockCacheInvalidation:
+    """Cached blocks are discarded when their code changes."""
+
+    def test_write_byte_invalidates(self, rom_path):
+        """Patching an operand takes effect on the next run."""
+        emu = make_emulator(rom_path, True, SUM_PROGRAM)
+        emu.run(5000)
+        assert emu.read_byte(0x2100) == 48
+
+        emu.write_byte(0x2005, 0x05)  # LDAA #$05
+        emu.write_byte(0x2100, 0x00)
+        emu.cpu.pc = 0x2000
+        emu.run(5000)
+
+        assert emu.read_byte(0x2100) == 80
+
+    def test_self_modifying_code(self, rom_path):
+        """A store into the running block stops it after that store."""
+        code = bytes([
+            0x0F,              # $2000 SEI
+            0x86, 0x07,        # $2001 LDAA #$07
+            0xB7, 0x20, 0x07,  # $2003 STAA $2007
+            0xC6, 0x01,        # $2006 LDAB #$01 (patched to #$07)
+            0x20, 0xFE,        # $2008 BRA *
+        ])
+
+        plain = make_emulator(rom_path, False, code)
+        cached = make_emulator(rom_path, True, code)
+        # Translate the block once before the patch runs
+        cached._block_cache.lookup(0x2000)
+
+        plain.run(100)
+        cached.run(100)
+
+        assert cached.cpu.b == 0x07
+        assert machine_state(cached) == machine_state(plain)
@@ -63,6 +63,29 @@ class TestBreakpointManager:
         mgr.step_mode = False
         assert mgr.step_mode is False
 
+    def test_is_active(self):
+        """is_active reflects whether any checks are registered."""
+        mgr = BreakpointManager()
+        assert mgr.is_active is False
+
+        mgr.add_breakpoint(0x8000)
+        assert mgr.is_active is True
+        mgr.clear_breakpoints()
+
+        mgr.add_write_watchpoint(0x0050)
+        assert mgr.is_active is True
+        mgr.clear_watchpoints()
+
+        mgr.add_syscall_hook(0x10, lambda n, cpu: True)
+        assert mgr.is_active is True
+        mgr.clear_syscall_hooks()
+
+        mgr.request_break()
+        assert mgr.is_active is True
+        mgr.clear_break_request()
+
+        assert mgr.is_active is False
+
 
 # =============================================================================
 # PC Breakpoint Tests
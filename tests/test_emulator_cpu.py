@@ -1356,6 +1356,58 @@ class TestExecutionControl:
 
         assert len(calls) == 5
 
+    def test_unhooked_matches_hooked(self):
+        """execute_unhooked() reaches the same state in the same cycles."""
+        # LDX #$0010; loop: DEX; ADDD #$0003; BNE loop; STD $50; BRA *
+        program = bytes([
+            0xCE, 0x00, 0x10,
+            0x09,
+            0xC3, 0x00, 0x03,
+            0x26, 0xFA,
+            0xDD, 0x50,
+            0x20, 0xFE,
+        ])
+        results = []
+        for hooked in (True, False):
+            bus = MockBus()
+            cpu = HD6303(bus)
+            bus.load_program(0x8000, program)
+            cpu.pc = 0x8000
+            if hooked:
+                cpu.on_instruction = lambda pc, opcode: True
+                cpu.on_memory_read = lambda addr, value: True
+                cpu.on_memory_write = lambda addr, value: True
+                cycles = cpu.execute(500)
+            else:
+                cycles = cpu.execute_unhooked(500)
+            results.append((cycles, cpu.pc, cpu.d, cpu.x, cpu._get_p(), bytes(bus._memory)))
+
+        assert results[0] == results[1]
+
+    def test_unhooked_restores_hooks(self, cpu):
+        """execute_unhooked() bypasses hooks but leaves them installed."""
+        for i in range(100):
+            cpu.bus.write(0x8000 + i, 0x01)
+        cpu.pc = 0x8000
+
+        calls = []
+        def hook(pc, opcode):
+            calls.append(pc)
+            return True
+
+        cpu.on_instruction = hook
+        cpu.execute_unhooked(20)
+
+        assert calls == []
+        assert cpu.on_instruction is hook
+
+    def test_dispatch_table_covers_all_opcodes(self, cpu):
+        """Every opcode has a handler; undefined ones switch off."""
+        assert len(cpu._dispatch) == 256
+        assert cpu._dispatch[0x01] == cpu._op_nop
+        assert cpu._dispatch[0x02] == cpu._op_illegal
+        assert cpu._dispatch[0xFF] == cpu._op_stx_ext
+
 
 # =============================================================================
 # Snapshot Tests
@@ -13,6 +13,7 @@ Copyright (c) 2025 Hugo José Pinto & Contributors
 
 import pytest
 from psion_sdk.emulator import Display, DisplayState
+from psion_sdk.emulator.display import CHAR2_BITMAP, CellRaster
 
 
 # =============================================================================
@@ -216,6 +217,65 @@ class TestDisplayOutput:
         assert len(pixels) > 0
 
 
+# =============================================================================
+# Change Tracking Tests
+# =============================================================================
+
+class TestDisplayChanges:
+    """Test the change counter, dirty flag and cached text."""
+
+    @pytest.fixture
+    def display(self):
+        """Create initialized display."""
+        d = Display(2)
+        d.switch_on()
+        d.command(0x38)
+        d.command(0x0C)
+        d.command(0x06)
+        d.command(0x01)
+        return d
+
+    def test_write_counts_change(self, display):
+        """Writing a new character counts a change and marks the display dirty."""
+        display.get_text()
+        before = display.change_count
+        display.set_data(ord("A"))
+        assert display.change_count == before + 1
+        assert display.needs_refresh
+
+    def test_same_character_not_counted(self, display):
+        """Rewriting the character already shown is not a change."""
+        display.set_data(ord("A"))
+        display.command(0x80)  # Back to the first position
+        before = display.change_count
+        display.set_data(ord("A"))
+        assert display.change_count == before
+
+    def test_listener_called(self, display):
+        """on_change is called for every change."""
+        calls = []
+        display.on_change = lambda: calls.append(display.change_count)
+        display.set_data(ord("A"))
+        display.set_data(ord("B"))
+        assert calls == [display.change_count - 1, display.change_count]
+
+    def test_text_cached_until_change(self, display):
+        """get_text returns the same string until the display changes."""
+        display.set_data(ord("A"))
+        text = display.get_text()
+        assert display.get_text() is text
+        assert not display.needs_refresh
+
+        display.set_data(ord("B"))
+        assert display.get_text().startswith("AB")
+
+    def test_grid_is_a_copy(self, display):
+        """Changing the returned grid does not change the cached text."""
+        display.set_data(ord("A"))
+        display.get_text_grid()[0] = "changed"
+        assert display.get_text_grid()[0].startswith("A")
+
+
 # =============================================================================
 # 4-Line Display Tests
 # =============================================================================
@@ -366,3 +426,71 @@ class TestDisplayRendering:
         img2 = display.render_image(scale=2)
         # Scaled image should be larger
         assert len(img2) > len(img1)
+
+    def test_png_reused_until_change(self, display):
+        """The same PNG is returned until the display changes."""
+        img = display.render_image_lcd()
+        if img is None:
+            pytest.skip("PIL not available")
+        assert display.render_image_lcd() is img
+        display.set_data(ord("!"))
+        assert display.render_image_lcd() != img
+
+
+# =============================================================================
+# Pixel Buffer Tests
+# =============================================================================
+
+class TestPixelBuffer:
+    """Test the pixel buffer and the cell rasters behind it."""
+
+    @pytest.fixture
+    def display(self):
+        d = Display(2)
+        d.switch_on()
+        d.command(0x38)
+        d.command(0x0C)
+        d.command(0x06)
+        d.command(0x01)
+        return d
+
+    @staticmethod
+    def cell(pixels: bytes, col: int) -> list:
+        """The rows of a line-0 cell, as bit patterns like the font's."""
+        rows = []
+        for y in range(8):
+            start = y * 16 * 5 + col * 5
+            rows.append(sum(1 << (4 - x) for x in range(5) if pixels[start + x]))
+        return rows
+
+    def test_glyph_pixels(self, display):
+        """A character cell shows the font's bitmap."""
+        display.set_data(ord("A"))
+        offset = (ord("A") - 32) * 8
+        assert self.cell(display.get_pixel_buffer(), 0) == list(CHAR2_BITMAP[offset:offset + 8])
+
+    def test_udg_redefinition_redrawn(self, display):
+        """Redefining a UDG on screen changes its pixels."""
+        display.set_data(0x00)
+        assert self.cell(display.get_pixel_buffer(), 0) == [0] * 8
+
+        display.command(0x40)  # UDG 0
+        for row in range(8):
+            display.set_data(0x11 if row % 2 else 0x0E)
+        assert self.cell(display.get_pixel_buffer(), 0) == [0x0E, 0x11] * 4
+
+    def test_off_is_blank(self, display):
+        """A switched-off display shows no pixels."""
+        display.set_data(ord("A"))
+        display.switch_off()
+        assert not any(display.get_pixel_buffer())
+
+    def test_only_changed_cells_redrawn(self):
+        """update() redraws just the cells whose glyph changed."""
+        raster = CellRaster.for_grid(4, 1, 2, b"\xFF", b"\x00")
+        blank = bytes(8)
+        assert raster.update([blank] * 4) == 4
+        assert raster.update([blank] * 4) == 0
+        assert raster.update([blank, bytes([0x1F] * 8), blank, blank]) == 1
+        # The changed cell is 10 pixels wide at scale 2, the others stay off
+        assert raster.frame[:40] == bytes(10) + b"\xFF" * 10 + bytes(20)
@@ -380,6 +380,63 @@ class TestSnapshot:
         with pytest.raises(FileNotFoundError):
             emu.load_snapshot(Path("/nonexistent/path.snap"))
 
+    def test_memory_snapshot_roundtrip(self, emu):
+        """snapshot()/restore() rewind without a file."""
+        code = bytes([0x86, 0x42, 0x7C, 0x21, 0x00, 0x20, 0xFB])
+        emu.inject_program(code, entry_point=0x2000)
+        emu.run(100)
+        snapshot = emu.snapshot()
+        cycles = emu.total_cycles
+        counter = emu.read_byte(0x2100)
+
+        emu.run(1000)
+        emu.restore(snapshot)
+
+        assert emu.total_cycles == cycles
+        assert emu.read_byte(0x2100) == counter
+        assert emu.snapshot() == snapshot
+
+    def test_file_matches_memory_snapshot(self, emu):
+        """save_snapshot() writes the same bytes as snapshot()."""
+        with tempfile.NamedTemporaryFile(suffix='.snap', delete=False) as f:
+            snap_path = Path(f.name)
+
+        try:
+            emu.save_snapshot(snap_path)
+            assert snap_path.read_bytes() == emu.snapshot()
+        finally:
+            snap_path.unlink()
+
+    def test_delta_snapshot(self, emu):
+        """A delta stores changed pages only and restores exactly."""
+        base = emu.snapshot()
+        emu.write_byte(0x2100, 0x11)
+        emu.write_byte(0x3000, 0x22)
+        emu.cpu.a = 0x33
+        delta = emu.snapshot(base=base)
+        expected = emu.snapshot()
+
+        assert len(delta) < len(base) // 4
+
+        emu.write_byte(0x2100, 0x00)
+        emu.write_byte(0x2500, 0x44)
+        emu.restore(delta, base=base)
+
+        assert emu.snapshot() == expected
+        assert emu.read_byte(0x2500) == 0x00
+
+    def test_delta_needs_base(self, emu):
+        """A delta cannot be restored on its own or against another base."""
+        base = emu.snapshot()
+        delta = emu.snapshot(base=base)
+
+        with pytest.raises(ValueError):
+            emu.restore(delta)
+        with pytest.raises(ValueError):
+            emu.snapshot(base=delta)
+        with pytest.raises(ValueError):
+            emu.restore(delta, base=base + b"\x00")
+
 
 # =============================================================================
 # Display Integration Tests
@@ -421,6 +478,38 @@ class TestDisplayIntegration:
         pixels = emu.display_pixels
         assert isinstance(pixels, bytes)
 
+    # Set entry mode, count X down from $4000, write "H" then "I"
+    DELAYED_WRITE = bytes([
+        0x86, 0x06, 0xB7, 0x01, 0x80,  # LDAA #$06, STAA $0180   @ 0x2000
+        0xCE, 0x40, 0x00,              # LDX #$4000              @ 0x2005
+        0x09, 0x26, 0xFD,              # DEX, BNE -3             @ 0x2008
+        0x86, 0x48, 0xB7, 0x01, 0x81,  # LDAA #'H', STAA $0181   @ 0x200B
+        0x86, 0x49, 0xB7, 0x01, 0x81,  # LDAA #'I', STAA $0181   @ 0x2010
+        0x20, 0xFE,                    # BRA *                   @ 0x2015
+    ])
+
+    def test_run_stops_on_display_change(self, emu):
+        """run(stop_on_display_change=True) stops after the write."""
+        emu.inject_program(self.DELAYED_WRITE, entry_point=0x2000)
+        event = emu.run(1_000_000, stop_on_display_change=True)
+        assert event.reason == BreakReason.DISPLAY_CHANGE
+        assert emu.cpu.pc == 0x2010
+        assert emu.display_text.startswith("H ")
+        assert emu.display.on_change is None
+
+    def test_run_until_text_wakes_on_change(self, emu):
+        """run_until_text returns right after the text is written."""
+        emu.inject_program(self.DELAYED_WRITE, entry_point=0x2000)
+        assert emu.run_until_text("HI", check_interval=1_000_000)
+        assert emu.cpu.pc == 0x2015
+        assert emu.total_cycles < 100_000
+
+    def test_run_until_text_past_breakpoint(self, emu):
+        """run_until_text steps over a breakpoint it is held at."""
+        emu.inject_program(self.DELAYED_WRITE, entry_point=0x2000)
+        emu.add_breakpoint(0x200B)
+        assert emu.run_until_text("HI", max_cycles=1_000_000)
+
 
 # =============================================================================
 # Keyboard Integration Tests
@@ -535,6 +624,101 @@ class TestDisassembly:
         assert '$2000' in disasm[0].upper()
 
 
+# =============================================================================
+# Idle Fast-Forward Tests
+# =============================================================================
+
+def idle_state(emu):
+    """Everything fast-forwarding must leave unchanged."""
+    cpu = emu.cpu
+    return (
+        emu.total_cycles, cpu.pc, cpu.a, cpu.b, cpu.x, cpu.sp, cpu.state.flags,
+        cpu.state.sleep, emu.bus.get_snapshot_data(),
+        emu.read_bytes(0x2000, 0x6000), emu.display_text,
+    )
+
+
+class TestIdleFastForward:
+    """Skipping SLP and spin loops must not change emulation results."""
+
+    @pytest.fixture
+    def rom_path(self):
+        rom_data = bytearray([0x00] * 0x8000)
+        rom_data[0x7FFE] = 0x20
+        rom_data[0x7FFF] = 0x00
+
+        with tempfile.NamedTemporaryFile(suffix='.rom', delete=False) as f:
+            f.write(bytes(rom_data))
+            rom_path = Path(f.name)
+        try:
+            yield rom_path
+        finally:
+            rom_path.unlink()
+
+    def test_enabled_by_default(self):
+        """Config default turns fast-forward on."""
+        assert EmulatorConfig().fast_forward_idle is True
+
+    def test_config_disables(self, rom_path):
+        """Config flag reaches the CPU."""
+        emu = Emulator(EmulatorConfig(rom_path=rom_path, fast_forward_idle=False))
+        assert emu.cpu.fast_forward_idle is False
+
+    @pytest.mark.parametrize("block_cache", [False, True])
+    def test_spin_loop_matches(self, rom_path, block_cache):
+        """A BRA * loop takes exactly the same cycles."""
+        # SEI, LDAA #$55, BRA *
+        code = bytes([0x0F, 0x86, 0x55, 0x20, 0xFE])
+        results = []
+        for fast_forward in (False, True):
+            emu = Emulator(EmulatorConfig(
+                rom_path=rom_path,
+                fast_forward_idle=fast_forward,
+                block_cache=block_cache and fast_forward,
+            ))
+            emu.reset()
+            emu.inject_program(code, entry_point=0x2000)
+            for budget in (7, 1000, 65537, 100000):
+                emu.run(budget)
+            results.append(idle_state(emu))
+
+        assert results[0] == results[1]
+        assert results[1][1] == 0x2003
+
+    def test_spin_loop_breakpoint(self, rom_path):
+        """A breakpoint on a spin loop is still hit."""
+        code = bytes([0x0F, 0x20, 0xFE])  # SEI, BRA *
+        emu = Emulator(EmulatorConfig(rom_path=rom_path))
+        emu.reset()
+        emu.inject_program(code, entry_point=0x2000)
+        emu.run(100)
+
+        emu.add_breakpoint(0x2001)
+        event = emu.run(100000)
+
+        assert event.reason == BreakReason.PC_BREAKPOINT
+        assert emu.cpu.pc == 0x2001
+
+    @requires_rom
+    @pytest.mark.parametrize("block_cache", [False, True])
+    def test_sleep_matches(self, block_cache):
+        """ROM keyboard wait (SLP) gives identical results."""
+        results = []
+        for fast_forward in (False, True):
+            emu = Emulator(EmulatorConfig(
+                model="XP",
+                fast_forward_idle=fast_forward,
+                block_cache=block_cache and fast_forward,
+            ))
+            emu.reset()
+            emu.run(3_000_000)
+            emu.tap_key("EXE")
+            emu.run(500_000)
+            results.append(idle_state(emu))
+
+        assert results[0] == results[1]
+
+
 # =============================================================================
 # Edge Case Tests
 # =============================================================================
@@ -396,6 +396,38 @@ class TestLowLevelTools:
         text = result.content[0]["text"]
         assert "Display State" in text
 
+    @pytest.mark.asyncio
+    async def test_profile(self, session_manager, temp_rom):
+        """profile starts, reports and stops the cycle profiler."""
+        session = session_manager.create_session(rom_path=temp_rom)
+        code = bytes([0x0F, 0x20, 0xFE])  # SEI, BRA *
+        session.emulator.inject_program(code, entry_point=0x2000)
+        session_id = session.session_id
+
+        result = await tools.profile(
+            session_manager, {"session_id": session_id, "action": "start"}
+        )
+        assert result.is_error is False
+
+        session.emulator.run(1000)
+        result = await tools.profile(
+            session_manager, {"session_id": session_id, "format": "collapsed"}
+        )
+        assert result.is_error is False
+        assert result.content[0]["text"].startswith("<root> ")
+
+        result = await tools.profile(
+            session_manager, {"session_id": session_id, "action": "stop"}
+        )
+        assert result.is_error is False
+        assert "Flat profile" in result.content[0]["text"]
+        assert session.emulator.profiler is None
+
+        result = await tools.profile(
+            session_manager, {"session_id": session_id}
+        )
+        assert result.is_error is True
+
 
 # =============================================================================
 # Session Management Tools
@@ -500,6 +532,7 @@ class TestMCPServer:
             "remove_breakpoint",
             "list_breakpoints",
             "get_registers",
+            "profile",
         ]
 
         for tool_name in expected_tools:
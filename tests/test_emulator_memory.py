@@ -182,6 +182,92 @@ class TestMemory:
         assert memory.read(0x0400) == 0x42
         assert memory.read(0x1000) == 0x55
 
+    def test_snapshot_into_matches_list(self, memory):
+        """Bytes snapshot has the same layout as the list snapshot."""
+        memory.write(0x0400, 0x42)
+        out = bytearray()
+        memory.snapshot_into(out)
+
+        assert list(out) == memory.get_snapshot_data()
+
+        memory.write(0x0400, 0x00)
+        memory.apply_snapshot_data(bytes(out))
+        assert memory.read(0x0400) == 0x42
+
+
+# =============================================================================
+# Page Map Tests
+# =============================================================================
+
+class TestPageMap:
+    """Page-mapped accesses must match the Ram/Rom range checks."""
+
+    @staticmethod
+    def slow_read(memory, address):
+        """Reference read through the Ram/Rom address decoding."""
+        if address >= 0x8000:
+            return memory.rom.read(address)
+        return memory.ram.read(address)
+
+    def test_matches_ram_rom_across_banks(self):
+        """Every mapped address reads the same as the slow path."""
+        rom_data = bytes((i * 7 + (i >> 14)) & 0xFF for i in range(0x10000))
+        memory = Memory(64, rom_data)
+        for address in range(0x0400, 0x8000):
+            memory.write(address, address ^ (address >> 8))
+
+        for _ in range(3):
+            for address in range(0x0400, 0x10000):
+                assert memory.read(address) == self.slow_read(memory, address)
+            memory.next_ram()
+            memory.next_rom()
+
+    def test_bank_switch_remaps_writes(self):
+        """Writes follow the RAM bank mapped at $4000."""
+        memory = Memory(64, bytes(0x8000))
+        memory.write(0x5000, 0x11)
+        memory.next_ram()
+        memory.write(0x5000, 0x22)
+        assert memory.read(0x5000) == 0x22
+
+        memory.reset_bank()
+        assert memory.read(0x5000) == 0x11
+
+    def test_unpopulated_ram(self):
+        """Pages outside the RAM configuration read $FF and drop writes."""
+        memory = Memory(8, bytes(0x8000))
+        memory.write(0x5000, 0x42)
+        assert memory.read(0x5000) == 0xFF
+        assert memory.read(0x0400) == 0xFF
+
+    def test_code_page_writes_reported(self):
+        """Marked pages report writes before they land."""
+        memory = Memory(32, bytes(0x8000))
+        reported = []
+        memory.on_code_write = reported.append
+
+        memory.mark_code_page(0x20)
+        memory.write(0x2005, 0x42)
+        assert reported == [0x2005]
+        assert memory.read(0x2005) == 0x42
+
+        memory.clear_code_page(0x20)
+        memory.write(0x2006, 0x43)
+        assert reported == [0x2005]
+        assert memory.read(0x2006) == 0x43
+
+    def test_snapshot_remaps(self):
+        """Restoring a snapshot points the map at the restored RAM."""
+        memory = Memory(64, bytes(0x8000))
+        memory.write(0x0400, 0x42)
+        snapshot = memory.get_snapshot_data()
+
+        memory.apply_snapshot_data(snapshot)
+        memory.write(0x0401, 0x43)
+
+        assert memory.read(0x0400) == 0x42
+        assert memory.ram.read(0x0401) == 0x43
+
 
 # =============================================================================
 # Address Range Tests
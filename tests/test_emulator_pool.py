@@ -0,0 +1,172 @@
+"""
+Emulator Pool Tests
+===================
+
+Tests for capturing emulator state and forking independent copies.
+
+These tests ensure:
+- A fork behaves exactly like the emulator it was taken from
+- Forks do not share mutable state
+- The pool prepares its template only once
+- Multiprocess map() gives the same results as sequential map()
+
+Copyright (c) 2025 Hugo José Pinto & Contributors
+"""
+
+import pytest
+from pathlib import Path
+import tempfile
+
+from psion_sdk.emulator import Emulator, EmulatorConfig, EmulatorPool
+
+
+# Count $2100 upwards forever
+COUNTER_PROGRAM = bytes([
+    0x0F,              # $2000 SEI
+    0x7C, 0x21, 0x00,  # $2001 INC $2100
+    0x20, 0xFB,        # $2004 BRA $2001
+])
+
+
+@pytest.fixture
+def rom_path():
+    """Minimal ROM whose reset vector points at $2000."""
+    rom_data = bytearray([0x00] * 0x8000)
+    rom_data[0x7FFE] = 0x20
+    rom_data[0x7FFF] = 0x00
+
+    with tempfile.NamedTemporaryFile(suffix='.rom', delete=False) as f:
+        f.write(bytes(rom_data))
+        path = Path(f.name)
+    try:
+        yield path
+    finally:
+        path.unlink()
+
+
+def inject_counter(emu: Emulator) -> None:
+    """Pool prepare callback: start the counter program."""
+    emu.inject_program(COUNTER_PROGRAM, entry_point=0x2000)
+
+
+def run_and_count(emu: Emulator, cycles: int) -> tuple:
+    """map() task: run a fork and report where it ended up."""
+    emu.run(cycles)
+    return (emu.total_cycles, emu.cpu.pc, emu.read_byte(0x2100))
+
+
+def machine_state(emu: Emulator) -> tuple:
+    """Registers, cycle count and low memory."""
+    cpu = emu.cpu
+    return (
+        emu.total_cycles, cpu.pc, cpu.a, cpu.b, cpu.x, cpu.sp, cpu.state.flags,
+        emu.read_bytes(0x0000, 0x4000),
+    )
+
+
+# =============================================================================
+# Fork Tests
+# =============================================================================
+
+class TestFork:
+    """Emulator.fork() and capture_image()."""
+
+    def test_fork_matches_original(self, rom_path):
+        """Fork and original stay in lockstep."""
+        emu = Emulator(EmulatorConfig(rom_path=rom_path))
+        emu.reset()
+        inject_counter(emu)
+        emu.run(1000)
+
+        fork = emu.fork()
+        assert machine_state(fork) == machine_state(emu)
+
+        emu.run(5000)
+        fork.run(5000)
+        assert machine_state(fork) == machine_state(emu)
+
+    def test_fork_is_independent(self, rom_path):
+        """Changing a fork leaves the original alone."""
+        emu = Emulator(EmulatorConfig(rom_path=rom_path))
+        emu.reset()
+        inject_counter(emu)
+
+        fork = emu.fork()
+        fork.write_byte(0x2100, 0x55)
+        fork.run(1000)
+
+        assert emu.read_byte(0x2100) == 0x00
+        assert emu.total_cycles == 0
+
+    def test_load_image_in_place(self, rom_path):
+        """An existing emulator can be put into a captured state."""
+        emu = Emulator(EmulatorConfig(rom_path=rom_path))
+        emu.reset()
+        inject_counter(emu)
+        emu.run(2000)
+        image = emu.capture_image()
+
+        other = Emulator(EmulatorConfig(rom_path=rom_path))
+        other.reset()
+        other.load_image(image)
+
+        assert machine_state(other) == machine_state(emu)
+
+    def test_packs_are_copied(self, rom_path):
+        """Pack contents belong to each fork."""
+        emu = Emulator(EmulatorConfig(rom_path=rom_path))
+        emu.reset()
+        fork = emu.fork()
+
+        for slot in range(3):
+            assert fork._packs[slot] is not emu._packs[slot]
+            assert fork.bus._packs[slot] is fork._packs[slot]
+
+
+# =============================================================================
+# Pool Tests
+# =============================================================================
+
+class TestEmulatorPool:
+    """EmulatorPool behavior."""
+
+    def test_prepares_once_lazily(self, rom_path):
+        """Template is prepared on first fork and reused."""
+        pool = EmulatorPool(EmulatorConfig(rom_path=rom_path), prepare=inject_counter)
+        assert pool.boots == 0
+
+        first = pool.fork()
+        second = pool.fork()
+
+        assert pool.boots == 1
+        assert pool.forks == 2
+        assert first is not second
+        assert first.cpu.pc == second.cpu.pc == 0x2000
+
+    def test_from_emulator(self, rom_path):
+        """Pool forks start from the emulator's current state."""
+        emu = Emulator(EmulatorConfig(rom_path=rom_path))
+        emu.reset()
+        inject_counter(emu)
+        emu.run(3000)
+
+        pool = EmulatorPool.from_emulator(emu)
+        assert machine_state(pool.fork()) == machine_state(emu)
+        assert pool.boots == 0
+
+    def test_map_sequential(self, rom_path):
+        """Every item gets a fork in the template state."""
+        pool = EmulatorPool(EmulatorConfig(rom_path=rom_path), prepare=inject_counter)
+
+        results = pool.map(run_and_count, [100, 100, 400], processes=1)
+
+        assert results[0] == results[1]
+        assert results[2][2] > results[0][2]
+
+    def test_map_processes_match_sequential(self, rom_path):
+        """Worker processes produce the same results as this process."""
+        pool = EmulatorPool(EmulatorConfig(rom_path=rom_path), prepare=inject_counter)
+        items = [50, 300, 1000, 2500]
+
+        assert pool.map(run_and_count, items, processes=2) == \
+            pool.map(run_and_count, items, processes=1)
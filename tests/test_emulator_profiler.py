@@ -0,0 +1,252 @@
+"""
+Cycle Profiler Tests
+====================
+
+Tests for the emulator's cycle profiler.
+
+These tests ensure:
+- Profiling does not change execution or cycle counts
+- Inclusive/exclusive cycles and call counts follow JSR/BSR/RTS
+- Function names come from assembler debug symbols
+- Flat, call-graph and collapsed reports are produced
+
+Copyright (c) 2025 Hugo José Pinto & Contributors
+"""
+
+import pytest
+from pathlib import Path
+import tempfile
+
+from psion_sdk.assembler import Assembler
+from psion_sdk.emulator import Emulator, EmulatorConfig, BreakReason, SymbolTable
+
+
+# main calls outer forever; outer calls inner three times
+NESTED_SOURCE = """
+        ORG $2000
+start:  SEI
+        LDS #$7F00
+loop:   JSR outer
+        BRA loop
+outer:  LDAB #3
+o1:     BSR inner
+        DECB
+        BNE o1
+        RTS
+inner:  LDAA #10
+i1:     DECA
+        BNE i1
+        RTS
+"""
+
+
+@pytest.fixture
+def rom_path():
+    """Minimal ROM whose reset vector points at $2000."""
+    rom_data = bytearray([0x00] * 0x8000)
+    rom_data[0x7FFE] = 0x20
+    rom_data[0x7FFF] = 0x00
+
+    with tempfile.NamedTemporaryFile(suffix='.rom', delete=False) as f:
+        f.write(bytes(rom_data))
+        path = Path(f.name)
+    try:
+        yield path
+    finally:
+        path.unlink()
+
+
+@pytest.fixture
+def program():
+    """NESTED_SOURCE assembled, with its debug symbol file."""
+    asm = Assembler(debug=True)
+    asm.assemble_string(NESTED_SOURCE)
+
+    with tempfile.NamedTemporaryFile(suffix='.dbg', delete=False) as f:
+        debug_path = Path(f.name)
+    try:
+        asm.write_debug(debug_path)
+        yield asm.get_code(), debug_path
+    finally:
+        debug_path.unlink()
+
+
+def make_emulator(rom_path: Path, code: bytes) -> Emulator:
+    """Create an emulator with a program injected at $2000."""
+    emu = Emulator(EmulatorConfig(rom_path=rom_path))
+    emu.reset()
+    emu.inject_program(code, entry_point=0x2000)
+    return emu
+
+
+def by_name(profiler) -> dict:
+    """Function profiles keyed by name."""
+    return {func.name: func for func in profiler.functions()}
+
+
+# =============================================================================
+# Accuracy Tests
+# =============================================================================
+
+class TestProfilerAccuracy:
+    """Profiling must not change what the emulator does."""
+
+    def test_same_state_and_cycles(self, rom_path, program):
+        """Profiled run matches an unprofiled one."""
+        code, _ = program
+        plain = make_emulator(rom_path, code)
+        profiled = make_emulator(rom_path, code)
+        profiler = profiled.start_profiling()
+
+        plain.run(50_000)
+        profiled.run(50_000)
+
+        assert profiled.total_cycles == plain.total_cycles
+        assert (profiled.cpu.pc, profiled.cpu.a, profiled.cpu.b, profiled.cpu.sp) == \
+            (plain.cpu.pc, plain.cpu.a, plain.cpu.b, plain.cpu.sp)
+        assert profiler.total_cycles == profiled.total_cycles
+        assert sum(profiler.pc_cycles) == profiled.total_cycles
+
+    def test_breakpoints_still_stop(self, rom_path, program):
+        """Breakpoints work while profiling."""
+        code, _ = program
+        emu = make_emulator(rom_path, code)
+        emu.start_profiling()
+        emu.add_breakpoint(0x2011)
+
+        event = emu.run(50_000)
+
+        assert event.reason == BreakReason.PC_BREAKPOINT
+        assert emu.cpu.pc == 0x2011
+
+    def test_step_is_recorded(self, rom_path, program):
+        """Single steps are profiled too."""
+        code, _ = program
+        emu = make_emulator(rom_path, code)
+        profiler = emu.start_profiling()
+
+        emu.step()
+        emu.step()
+
+        assert profiler.pc_counts[0x2000] == 1
+        assert profiler.pc_counts[0x2001] == 1
+        assert profiler.total_cycles == emu.total_cycles
+
+    def test_stop_profiling(self, rom_path, program):
+        """After stop_profiling() nothing more is recorded."""
+        code, _ = program
+        emu = make_emulator(rom_path, code)
+        emu.start_profiling()
+        emu.run(1000)
+
+        profiler = emu.stop_profiling()
+        recorded = profiler.total_cycles
+        emu.run(1000)
+
+        assert emu.profiler is None
+        assert recorded > 0
+        assert profiler.total_cycles == recorded
+
+
+# =============================================================================
+# Call Tracking Tests
+# =============================================================================
+
+class TestCallTracking:
+    """Inclusive and exclusive cycles through calls."""
+
+    def test_inclusive_exclusive(self, rom_path, program):
+        """Callers include their callees' cycles."""
+        code, debug_path = program
+        emu = make_emulator(rom_path, code)
+        profiler = emu.start_profiling(debug_path)
+        emu.run(100_000)
+
+        funcs = by_name(profiler)
+        outer, inner, root = funcs["OUTER"], funcs["INNER"], funcs["<root>"]
+
+        assert inner.exclusive == inner.inclusive
+        assert outer.inclusive == outer.exclusive + inner.inclusive
+        assert root.inclusive == profiler.total_cycles
+        assert root.exclusive + outer.exclusive + inner.exclusive == profiler.total_cycles
+        assert inner.exclusive > outer.exclusive > root.exclusive
+
+    def test_call_counts(self, rom_path, program):
+        """Each call to outer makes three calls to inner."""
+        code, debug_path = program
+        emu = make_emulator(rom_path, code)
+        profiler = emu.start_profiling(debug_path)
+        # Stop at the JSR outer and step over it five times
+        emu.add_breakpoint(0x2004)
+        for _ in range(5):
+            emu.run(100_000)
+            emu.step()
+        emu.run(100_000)
+
+        funcs = by_name(profiler)
+        assert funcs["OUTER"].calls == 5
+        assert funcs["INNER"].calls == 15
+
+    def test_collapsed_stacks(self, rom_path, program):
+        """Collapsed output has one line per stack with its cycles."""
+        code, debug_path = program
+        emu = make_emulator(rom_path, code)
+        profiler = emu.start_profiling(debug_path)
+        emu.run(20_000)
+
+        stacks = dict(
+            line.rsplit(" ", 1) for line in profiler.report_collapsed().splitlines()
+        )
+
+        assert set(stacks) == {"<root>", "<root>;OUTER", "<root>;OUTER;INNER"}
+        assert sum(int(cycles) for cycles in stacks.values()) == profiler.total_cycles
+
+
+# =============================================================================
+# Report Tests
+# =============================================================================
+
+class TestReports:
+    """Report formats and symbols."""
+
+    def test_flat_and_callgraph(self, rom_path, program):
+        """Reports name functions and addresses."""
+        code, debug_path = program
+        emu = make_emulator(rom_path, code)
+        profiler = emu.start_profiling(debug_path)
+        emu.run(20_000)
+
+        flat = profiler.report("flat")
+        assert "INNER" in flat
+        assert "I1+1" in flat  # BNE inside inner's loop
+
+        graph = profiler.report("callgraph")
+        assert "-> INNER" in graph
+        assert "<- OUTER" in graph
+
+        with pytest.raises(ValueError):
+            profiler.report("pie")
+
+    def test_without_symbols(self, rom_path, program):
+        """Functions are named by address without symbols."""
+        code, _ = program
+        emu = make_emulator(rom_path, code)
+        profiler = emu.start_profiling()
+        emu.run(20_000)
+
+        assert "$2011" in by_name(profiler)
+
+    def test_relocatable_symbols(self):
+        """Relocatable debug symbols are moved to the load address."""
+        text = (
+            "VERSION 1.0\nRELOCATABLE true\n\n[SYMBOLS]\n"
+            "_main $0010 CODE main.asm:3\nCOUNT $0005 EQU main.asm:1\n"
+        )
+
+        with pytest.raises(ValueError):
+            SymbolTable.parse(text)
+
+        symbols = SymbolTable.parse(text, load_address=0x3000)
+        assert symbols.symbols == [(0x3010, "_main")]
+        assert symbols.name_at(0x3014) == "_main+4"
+        assert symbols.name_at(0x2000) == "$2000"
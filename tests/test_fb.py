@@ -0,0 +1,201 @@
+# =============================================================================
+# test_fb.py - Display Frame Buffer Library Tests
+# =============================================================================
+# Tests for the fb.h/fbruntime.inc optional library functions:
+#   - fb_begin, fb_put, fb_putc: Drawing into the frame
+#   - fb_flush, fb_invalidate: Showing it (see also
+#     tests/testkit/integration/test_fb_benchmarks.py, which runs them
+#     on a booted machine and checks the display)
+#
+# These functions are OPTIONAL - they're only included when the user
+# explicitly includes fb.h in their C source.
+#
+# Test Approach:
+#   - Compilation tests: Verify C code using these functions compiles
+#   - Assembly tests: Verify fbruntime.inc assembles for both display sizes
+#   - Result tests: Run the drawing routines on the emulator and check
+#     the frame
+#
+# Copyright (c) 2025 Hugo José Pinto & Contributors
+# =============================================================================
+
+import pytest
+from pathlib import Path
+
+from psion_sdk.assembler import Assembler
+from psion_sdk.smallc.compiler import SmallCCompiler, CompilerOptions
+from psion_sdk.testkit.benchmark import RuntimeBenchmark, DATA_BASE
+
+
+# =============================================================================
+# Paths and Fixtures
+# =============================================================================
+
+INCLUDE_DIR = Path(__file__).parent.parent / "include"
+
+# String argument
+TEXT = DATA_BASE
+
+
+@pytest.fixture
+def compiler():
+    """Create a Small-C compiler with include paths configured."""
+    options = CompilerOptions(
+        include_paths=[str(INCLUDE_DIR)],
+        target_model="XP",
+    )
+    return SmallCCompiler(options)
+
+
+@pytest.fixture(scope="module")
+def bench():
+    """Load runtime.inc and fbruntime.inc (drawing needs no boot)."""
+    return RuntimeBenchmark(("runtime.inc", "fbruntime.inc"))
+
+
+def compile_c(source: str, compiler) -> str:
+    """Compile C source to assembly."""
+    result = compiler.compile_source(source, "test.c")
+    if result.success:
+        return result.assembly
+    raise Exception(f"Compilation failed: {result.errors}")
+
+
+def assemble(source: str, model: str = "XP") -> Assembler:
+    """Assemble source with the runtime and frame buffer included."""
+    asm = Assembler(include_paths=[str(INCLUDE_DIR)], target_model=model)
+    asm.assemble(
+        '        INCLUDE "psion.inc"\n'
+        '        INCLUDE "runtime.inc"\n'
+        '        INCLUDE "fbruntime.inc"\n'
+        + source
+    )
+    return asm
+
+
+def frame(bench) -> list[str]:
+    """The frame being drawn, one string per row."""
+    data = bytes(bench.emulator.read_bytes(bench.address("__fb_back"), 32))
+    return [data[:16].decode("latin-1"), data[16:].decode("latin-1")]
+
+
+def put(bench, col: int, row: int, text: str) -> None:
+    """fb_put(col, row, text)."""
+    bench.emulator.write_bytes(TEXT, text.encode("latin-1") + b"\0")
+    bench.call("_fb_put", (col & 0xFFFF, row & 0xFFFF, TEXT))
+
+
+# =============================================================================
+# Compilation Tests
+# =============================================================================
+
+class TestFbCompilation:
+    """Tests that programs using fb.h compile."""
+
+    def test_fb_program_compiles(self, compiler):
+        """All fb.h functions compile and pull in fbruntime.inc."""
+        source = """
+        #include <psion.h>
+        #include <fb.h>
+
+        void main() {
+            int runs;
+            fb_begin();
+            fb_put(0, 0, "Hello");
+            fb_putc(15, 1, '*');
+            runs = fb_flush();
+            fb_invalidate();
+        }
+        """
+        asm = compile_c(source, compiler)
+        assert 'INCLUDE "fbruntime.inc"' in asm
+        for name in ("_fb_begin", "_fb_put", "_fb_putc", "_fb_flush", "_fb_invalidate"):
+            assert name in asm
+
+    def test_runtime_only_with_fb_h(self, compiler):
+        """fbruntime.inc is not included without fb.h."""
+        source = """
+        #include <psion.h>
+
+        void main() {
+            print("Hello");
+        }
+        """
+        asm = compile_c(source, compiler)
+        assert "fbruntime.inc" not in asm
+
+    def test_include_guard(self, compiler):
+        """fb.h may be included twice."""
+        source = """
+        #include <psion.h>
+        #include <fb.h>
+        #include <fb.h>
+
+        void main() {
+            fb_begin();
+        }
+        """
+        asm = compile_c(source, compiler)
+        assert asm.count('INCLUDE "fbruntime.inc"') == 1
+
+
+# =============================================================================
+# Assembly Tests
+# =============================================================================
+
+class TestFbAssembly:
+    """Tests that fbruntime.inc assembles for each display size."""
+
+    @pytest.mark.parametrize("model,cells", [("XP", 32), ("LZ", 80)])
+    def test_frame_matches_display(self, model, cells):
+        """Each frame has a cell per display position, plus a sentinel."""
+        asm = assemble("        ORG $2100\n        RTS\n", model)
+        symbols = asm.get_symbols()
+        assert symbols["__FB_FRONT"] - symbols["__FB_BACK"] == cells + 2
+        assert symbols["FB_FRONT"] == cells + 2
+
+
+# =============================================================================
+# Drawing Tests
+# =============================================================================
+
+class TestFbDrawing:
+    """Run the drawing routines on the emulator and check the frame."""
+
+    def test_begin_clears_to_spaces(self, bench):
+        bench.reset()
+        put(bench, 0, 0, "x" * 16)
+        bench.call("_fb_begin")
+        assert frame(bench) == [" " * 16, " " * 16]
+
+    def test_put(self, bench):
+        bench.reset()
+        bench.call("_fb_begin")
+        put(bench, 0, 0, "Hello")
+        put(bench, 3, 1, "World")
+        assert frame(bench) == ["Hello           ", "   World        "]
+
+    def test_put_cut_at_row_end(self, bench):
+        bench.reset()
+        bench.call("_fb_begin")
+        put(bench, 12, 0, "ABCDEFGH")
+        assert frame(bench) == ["            ABCD", " " * 16]
+
+    @pytest.mark.parametrize("col,row", [(16, 0), (0, 2), (-1, 0), (0, -1), (300, 0)])
+    def test_put_off_display_ignored(self, bench, col, row):
+        bench.reset()
+        bench.call("_fb_begin")
+        put(bench, col, row, "X")
+        assert frame(bench) == [" " * 16, " " * 16]
+
+    def test_putc(self, bench):
+        bench.reset()
+        bench.call("_fb_begin")
+        bench.call("_fb_putc", (15, 1, ord("*")))
+        bench.call("_fb_putc", (16, 1, ord("#")))
+        assert frame(bench) == [" " * 16, " " * 15 + "*"]
+
+    def test_put_keeps_frame_pointer(self, bench):
+        bench.reset()
+        bench.emulator.write_bytes(TEXT, b"Hi\0")
+        assert bench.call("_fb_put", (0, 0, TEXT), x=0x1234).x == 0x1234
@@ -0,0 +1,361 @@
+# =============================================================================
+# test_fixed.py - Fixed Point Library Tests
+# =============================================================================
+# Tests for the fixed.h/fixedruntime.inc optional library functions:
+#   - fx_from_int, fx_to_int, fx_from_str, fx_to_str: Q16.16 conversion
+#   - fx_add, fx_sub, fx_mul, fx_div, fx_neg, fx_cmp: Q16.16 arithmetic
+#   - fx_sqrt, fx_sin, fx_cos: Q16.16 functions
+#   - q8_mul, q8_div, q8_sqrt, q8_sin, q8_cos and conversions: Q8.8
+#   - fx_to_fp, fx_from_fp: Floating point conversion (with float.h)
+#
+# These functions are OPTIONAL - they're only included when the user
+# explicitly includes fixed.h in their C source.
+#
+# Test Approach:
+#   - Compilation tests: Verify C code using these functions compiles
+#   - Assembly tests: Verify fixedruntime.inc assembles correctly
+#   - Result tests: Run the routines on the emulator against Python maths
+#
+# Copyright (c) 2025 Hugo José Pinto & Contributors
+# =============================================================================
+
+import math
+import struct
+
+import pytest
+from pathlib import Path
+
+from psion_sdk.assembler import Assembler
+from psion_sdk.smallc.compiler import SmallCCompiler, CompilerOptions
+from psion_sdk.testkit.benchmark import RuntimeBenchmark, DATA_BASE
+
+
+# =============================================================================
+# Paths and Fixtures
+# =============================================================================
+
+INCLUDE_DIR = Path(__file__).parent.parent / "include"
+
+# Operands and result (4 bytes each), string buffer
+A = DATA_BASE
+B = DATA_BASE + 4
+R = DATA_BASE + 8
+TEXT = DATA_BASE + 0x100
+
+# One Q16.16 unit
+ULP = 1 / 65536
+
+
+@pytest.fixture
+def compiler():
+    """Create a Small-C compiler with include paths configured."""
+    options = CompilerOptions(
+        include_paths=[str(INCLUDE_DIR)],
+        target_model="XP",
+    )
+    return SmallCCompiler(options)
+
+
+@pytest.fixture
+def assembler():
+    """Create an assembler with include paths configured."""
+    return Assembler(include_paths=[str(INCLUDE_DIR)])
+
+
+@pytest.fixture(scope="module")
+def bench():
+    """fixedruntime.inc loaded on an emulator (it needs no OS services)."""
+    return RuntimeBenchmark(("runtime.inc", "fixedruntime.inc"))
+
+
+def compile_c(source: str, compiler) -> str:
+    """Compile C source to assembly, raising on failure."""
+    result = compiler.compile_source(source, "test.c")
+    if result.success:
+        return result.assembly
+    raise Exception(f"Compilation failed: {result.errors}")
+
+
+def fx(value: float) -> bytes:
+    """A Q16.16 value as stored, rounded to the nearest unit."""
+    return struct.pack(">i", round(value * 65536))
+
+
+def q8(value: float) -> int:
+    """A Q8.8 value as a 16-bit argument."""
+    return round(value * 256) & 0xFFFF
+
+
+def signed(d: int) -> int:
+    """A 16-bit register value as a signed int."""
+    return d - 0x10000 if d & 0x8000 else d
+
+
+def read_fx(bench, address: int) -> float:
+    """The Q16.16 value stored at an address."""
+    return struct.unpack(">i", bench.emulator.read_bytes(address, 4))[0] / 65536
+
+
+def read_text(bench, address: int) -> str:
+    """The null-terminated string at an address."""
+    return bench.emulator.read_bytes(address, 24).split(b"\x00")[0].decode()
+
+
+def binary(bench, routine: str, a: float, b: float) -> float:
+    """Run a Q16.16 routine(result, a, b) and read the result."""
+    bench.emulator.write_bytes(A, fx(a))
+    bench.emulator.write_bytes(B, fx(b))
+    bench.call(routine, (R, A, B))
+    return read_fx(bench, R)
+
+
+def unary(bench, routine: str, a: float) -> float:
+    """Run a Q16.16 routine(result, a) and read the result."""
+    bench.emulator.write_bytes(A, fx(a))
+    bench.call(routine, (R, A))
+    return read_fx(bench, R)
+
+
+# =============================================================================
+# Compilation Tests
+# =============================================================================
+
+class TestFixedCompilation:
+    """Tests that C code using fixed.h compiles."""
+
+    def test_fixed_program_compiles(self, compiler):
+        """The Q16.16 and Q8.8 API should compile."""
+        source = '''
+        #include <psion.h>
+        #include <fixed.h>
+
+        void main() {
+            fx_t a, b, r;
+            q8_t q;
+            char buf[14];
+            fx_from_str(&a, "3.14159");
+            fx_from_int(&b, 2);
+            fx_mul(&r, &a, &b);
+            fx_sin(&r, &r);
+            fx_to_str(buf, &r, 4);
+            q = q8_mul(q8_from_int(3), q8_from_str("1.5"));
+            print_int(fx_cmp(&a, &b) + q8_to_int(q));
+        }
+        '''
+        asm = compile_c(source, compiler)
+        assert "JSR     _fx_mul" in asm or "JSR _fx_mul" in asm
+        assert "INCLUDE \"fixedruntime.inc\"" in asm
+
+    def test_runtime_only_with_fixed_h(self, compiler):
+        """fixedruntime.inc is only included when fixed.h is."""
+        source = '''
+        #include <psion.h>
+        void main() { print("Hi"); }
+        '''
+        assert "fixedruntime.inc" not in compile_c(source, compiler)
+
+    def test_fixedruntime_after_fpruntime(self, compiler):
+        """With float.h, fixedruntime.inc follows fpruntime.inc."""
+        source = '''
+        #include <psion.h>
+        #include <float.h>
+        #include <fixed.h>
+
+        void main() {
+            fx_t a;
+            fp_t f;
+            fx_from_int(&a, 5);
+            fx_to_fp(&f, &a);
+            fx_from_fp(&a, &f);
+        }
+        '''
+        asm = compile_c(source, compiler)
+        assert asm.index("fpruntime.inc") < asm.index("fixedruntime.inc")
+
+    def test_no_fpruntime_without_float_h(self, compiler):
+        """fixed.h alone does not pull in the floating point runtime."""
+        source = '''
+        #include <psion.h>
+        #include <fixed.h>
+
+        void main() {
+            fx_t a;
+            fx_from_int(&a, 5);
+        }
+        '''
+        assert "fpruntime.inc" not in compile_c(source, compiler)
+
+    def test_include_guard(self, compiler):
+        """Including fixed.h twice should not redefine fx_t."""
+        source = '''
+        #include <psion.h>
+        #include <fixed.h>
+        #include <fixed.h>
+
+        void main() {
+            fx_t a;
+            fx_from_int(&a, 1);
+        }
+        '''
+        compile_c(source, compiler)
+
+
+# =============================================================================
+# Assembly Tests
+# =============================================================================
+
+class TestFixedAssembly:
+    """Tests that fixedruntime.inc assembles correctly."""
+
+    def test_fixedruntime_assembles(self, assembler):
+        """fixedruntime.inc should assemble after runtime.inc."""
+        source = '''
+            ORG $2100
+            INCLUDE "psion.inc"
+            INCLUDE "runtime.inc"
+            INCLUDE "fixedruntime.inc"
+        '''
+        assembler.assemble(source)
+        assert len(assembler.get_code()) > 0
+
+    def test_fp_conversions_only_with_fpruntime(self, assembler):
+        """fx_to_fp and fx_from_fp are assembled only after fpruntime.inc."""
+        source = '''
+            ORG $2100
+            INCLUDE "psion.inc"
+            INCLUDE "runtime.inc"
+            INCLUDE "fixedruntime.inc"
+        '''
+        assembler.assemble(source)
+        assert "_FX_TO_FP" not in assembler.get_symbols()
+
+        with_fp = Assembler(include_paths=[str(INCLUDE_DIR)])
+        with_fp.assemble('''
+            ORG $2100
+            INCLUDE "psion.inc"
+            INCLUDE "runtime.inc"
+            INCLUDE "float.inc"
+            INCLUDE "fpruntime.inc"
+            INCLUDE "fixedruntime.inc"
+        ''')
+        assert "_FX_TO_FP" in with_fp.get_symbols()
+        assert "_FX_FROM_FP" in with_fp.get_symbols()
+
+
+# =============================================================================
+# Result Tests
+# =============================================================================
+
+OPERANDS = [(7, 5), (1234, 56), (-3.25, 2.5), (100.5, -0.75), (-2, -3.5), (0.1, 0.2)]
+
+
+class TestFixedArithmetic:
+    """Q16.16 arithmetic against exact results (operands rounded to Q16.16)."""
+
+    @pytest.mark.parametrize("a,b", OPERANDS)
+    def test_add_sub_exact(self, bench, a, b):
+        """Sums and differences are exact."""
+        a_fx, b_fx = round(a * 65536) / 65536, round(b * 65536) / 65536
+        assert binary(bench, "_fx_add", a, b) == a_fx + b_fx
+        assert binary(bench, "_fx_sub", a, b) == a_fx - b_fx
+
+    @pytest.mark.parametrize("a,b", OPERANDS)
+    def test_mul_div_rounded(self, bench, a, b):
+        """Products and quotients are within half a unit."""
+        a_fx, b_fx = round(a * 65536) / 65536, round(b * 65536) / 65536
+        if abs(a_fx * b_fx) < 32767:
+            assert binary(bench, "_fx_mul", a, b) == pytest.approx(a_fx * b_fx, abs=ULP / 2)
+        assert binary(bench, "_fx_div", a, b) == pytest.approx(a_fx / b_fx, abs=ULP / 2)
+
+    def test_div_by_zero_saturates(self, bench):
+        """Dividing by zero gives the largest value with the dividend's sign."""
+        assert binary(bench, "_fx_div", 5, 0) == pytest.approx(32768, abs=ULP)
+        assert binary(bench, "_fx_div", -5, 0) == pytest.approx(-32768, abs=ULP)
+
+    def test_neg_and_cmp(self, bench):
+        """fx_neg negates in place; fx_cmp orders signed values."""
+        bench.emulator.write_bytes(A, fx(-1.5))
+        bench.call("_fx_neg", (A,))
+        assert read_fx(bench, A) == 1.5
+        for a, b, expected in [(3, 3.5, -1), (3.5, 3, 1), (-1, 1, -1), (2, 2, 0), (-1.5, -1.25, -1)]:
+            bench.emulator.write_bytes(A, fx(a))
+            bench.emulator.write_bytes(B, fx(b))
+            assert signed(bench.call("_fx_cmp", (A, B)).d) == expected
+
+    @pytest.mark.parametrize("x", [0, 0.5, 1, 2, 100, 30000])
+    def test_sqrt(self, bench, x):
+        """Square roots are within half a unit."""
+        assert unary(bench, "_fx_sqrt", x) == pytest.approx(math.sqrt(x), abs=ULP / 2)
+
+    def test_sqrt_negative_is_zero(self, bench):
+        assert unary(bench, "_fx_sqrt", -4) == 0
+
+    @pytest.mark.parametrize("x", [0, 0.5, 1, 1.5707963, 2, 3.14159, -1, -4, 10, -100, 1000, -32000])
+    def test_sin_cos(self, bench, x):
+        """sin and cos are within 0.0003 over the whole range."""
+        x_fx = round(x * 65536) / 65536
+        assert unary(bench, "_fx_sin", x) == pytest.approx(math.sin(x_fx), abs=3e-4)
+        assert unary(bench, "_fx_cos", x) == pytest.approx(math.cos(x_fx), abs=3e-4)
+
+
+class TestFixedConversion:
+    """Q16.16 conversion to and from int and text."""
+
+    @pytest.mark.parametrize("value,expected", [(3.75, 3), (-3.75, -3), (-4, -4), (0.5, 0)])
+    def test_to_int_truncates(self, bench, value, expected):
+        bench.emulator.write_bytes(A, fx(value))
+        assert signed(bench.call("_fx_to_int", (A,)).d) == expected
+
+    def test_from_int(self, bench):
+        bench.call("_fx_from_int", (A, -100 & 0xFFFF))
+        assert read_fx(bench, A) == -100
+
+    @pytest.mark.parametrize("text,expected", [
+        ("3.14159", 3.14159), ("-0.5", -0.5), ("  12", 12), ("+7.25", 7.25),
+        ("-32768", -32768), ("1.999999", 1.99999), ("42abc", 42),
+    ])
+    def test_from_str(self, bench, text, expected):
+        """Parsed values are within one unit of the decimal."""
+        bench.emulator.write_bytes(TEXT, text.encode() + b"\x00")
+        bench.call("_fx_from_str", (A, TEXT))
+        assert read_fx(bench, A) == pytest.approx(expected, abs=ULP)
+
+    @pytest.mark.parametrize("value,places,expected", [
+        (3.14159, 2, "3.14"), (-0.5, 1, "-0.5"), (1234, 0, "1234"), (1.999, 2, "2.00"),
+        (-32768, 3, "-32768.000"), (0, 0, "0"), (12.0625, 4, "12.0625"), (0.1, 9, "0.10000"),
+    ])
+    def test_to_str(self, bench, value, places, expected):
+        """Text is rounded to the requested places (at most 5)."""
+        bench.emulator.write_bytes(A, fx(value))
+        bench.call("_fx_to_str", (TEXT, A, places))
+        assert read_text(bench, TEXT) == expected
+
+
+class TestQ8:
+    """Q8.8 functions against Python maths."""
+
+    @pytest.mark.parametrize("a,b", [(3, 2), (-1.5, 2.25), (0.5, -0.5), (10, 3)])
+    def test_mul_div(self, bench, a, b):
+        assert signed(bench.call("_q8_mul", (q8(a), q8(b))).d) / 256 == pytest.approx(a * b, abs=1 / 512)
+        assert signed(bench.call("_q8_div", (q8(a), q8(b))).d) / 256 == pytest.approx(a / b, abs=1 / 512)
+
+    @pytest.mark.parametrize("x", [0, 0.5, 2, 100])
+    def test_sqrt(self, bench, x):
+        assert bench.call("_q8_sqrt", (q8(x),)).d / 256 == pytest.approx(math.sqrt(x), abs=1 / 512)
+
+    @pytest.mark.parametrize("x", [0, 0.5, 1, 2, -2, 3.14, 100, -127])
+    def test_sin_cos(self, bench, x):
+        x_q8 = round(x * 256) / 256
+        assert signed(bench.call("_q8_sin", (q8(x),)).d) / 256 == pytest.approx(math.sin(x_q8), abs=1.5 / 256)
+        assert signed(bench.call("_q8_cos", (q8(x),)).d) / 256 == pytest.approx(math.cos(x_q8), abs=1.5 / 256)
+
+    def test_conversions(self, bench):
+        """Q8.8 to and from Q16.16 and text."""
+        bench.call("_q8_to_fx", (A, q8(-2.5)))
+        assert read_fx(bench, A) == -2.5
+        bench.emulator.write_bytes(A, fx(-1.3))
+        assert signed(bench.call("_q8_from_fx", (A,)).d) == round(-1.3 * 256)
+        bench.emulator.write_bytes(TEXT, b"-2.5\x00")
+        assert signed(bench.call("_q8_from_str", (TEXT,)).d) == -640
+        bench.call("_q8_to_str", (TEXT, q8(-2.5), 2))
+        assert read_text(bench, TEXT) == "-2.50"
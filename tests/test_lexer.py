@@ -11,8 +11,11 @@
 #   - Comments (semicolon and asterisk forms)
 #   - Line continuation and whitespace handling
 #   - Error conditions
+#   - The regular expression fast path agrees with the character scanner
 # =============================================================================
 
+import pickle
+
 import pytest
 from psion_sdk.assembler.lexer import Lexer, TokenType, Token
 from psion_sdk.errors import AssemblySyntaxError
@@ -557,3 +560,55 @@ class TestPsionSpecific:
         tokens = tokenize("RMB 10")
         assert tokens[0].value == "RMB"
         assert tokens[1].value == 10
+
+# =============================================================================
+# Fast Path Tests
+# =============================================================================
+
+def scan_slowly(source: str) -> list:
+    """Tokenize with the character scanner alone, as tokenize() used to."""
+    lexer = Lexer(source, "<test>")
+    tokens = []
+    while not lexer._at_end():
+        if lexer._skip_whitespace() or lexer._skip_comment():
+            continue
+        token = lexer._scan_token()
+        if token is not None:
+            tokens.append(token)
+    tokens.append(lexer._make_token(TokenType.EOF, None))
+    return tokens
+
+
+class TestFastPath:
+    """The regular expression fast path must match the character scanner."""
+
+    @pytest.mark.parametrize("source", [
+        "start: LDAA #$41  ; load 'A'\n\tRTS\n",
+        "* comment\n  * indented comment\nX EQU 2*3\n",
+        "\tFCB 0x1F,0b101,0o17,@17,%0110,$,%,@18,0b102\n",
+        ".loop: BNE .loop\n@L1 BRA @L1\n",
+        "\tFCC \"plain\",\"esc\\n\\x41\",'a','\\t',''',';'\n",
+        "MAC MACRO\n\tLDAA \\arg\nL\\@ NOP\n\tENDM\n",
+        "#IF A<<2 <= B>>1 <> C >= D != E < F > G\n#ENDIF",
+        "X = 1+2-3/4&5|6^~7",
+        "",
+    ])
+    def test_same_tokens(self, source):
+        """Tokens, values and positions are the same on both paths."""
+        assert list(Lexer(source, "<test>").tokenize()) == scan_slowly(source)
+
+    @pytest.mark.parametrize("source", ["LDAA 0x", "LDAA @8", ". X", "A ! B",
+                                        'FCC "open', "FCB 'ab'", "\\ X", "LDAA ?"])
+    def test_same_errors(self, source):
+        """Malformed input is reported as the character scanner reports it."""
+        with pytest.raises(AssemblySyntaxError) as fast:
+            list(Lexer(source, "<test>").tokenize())
+        with pytest.raises(AssemblySyntaxError) as slow:
+            scan_slowly(source)
+        assert str(fast.value) == str(slow.value)
+
+    def test_token_uses_slots(self):
+        """Tokens have no per-instance dict but still pickle (build cache)."""
+        token = tokenize("LDAA")[0]
+        assert not hasattr(token, "__dict__")
+        assert pickle.loads(pickle.dumps(token)) == token
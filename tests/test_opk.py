@@ -38,8 +38,12 @@ from psion_sdk.opk import (
     parse_opk_header,
     # Parser
     PackParser,
+    compare_records,
     validate_ob3,
     parse_ob3,
+    # Data file import
+    encode_record,
+    read_table,
     # Builder
     PackBuilder,
     validate_procedure_name,
@@ -697,6 +701,62 @@ class TestPackParser:
             PackParser.from_bytes(b"OPK")
 
 
+# =============================================================================
+# Record Checksum Tests
+# =============================================================================
+
+class TestRecordChecksums:
+    """Tests for per-record checksums and comparing packs."""
+
+    @staticmethod
+    def records(*procedures):
+        """Record checksums of a pack with the given (name, code) procedures."""
+        return PackParser.from_bytes(create_opk(list(procedures))).record_checksums()
+
+    def test_spans_cover_records(self, sample_opk_data: bytes):
+        """Each record's bytes are where its span says, summed into the checksum."""
+        parser = PackParser.from_bytes(sample_opk_data)
+        main, record = parser.record_checksums()
+        assert (main.record_type, main.name) == (RecordType.DATA_FILE, "MAIN")
+        assert main.offset == 10  # Right after the pack header
+        assert record.name == "TEST"
+        assert record.record_type == RecordType.PROCEDURE
+        assert record.offset == main.offset + main.size
+        assert record.size == parser.records[1].get_size()
+        image = sample_opk_data[6:]
+        assert record.checksum == sum(image[record.offset:record.offset + record.size]) & 0xFFFF
+
+    def test_identical_packs(self):
+        """Packs with the same procedures have no differences."""
+        old = self.records(("ONE", b"\x39"), ("TWO", b"\x86\x41\x39"))
+        new = self.records(("ONE", b"\x39"), ("TWO", b"\x86\x41\x39"))
+        delta = compare_records(old, new)
+        assert delta.is_empty
+        assert delta.transfer_bytes == 0
+        assert delta.common_prefix == new[-1].offset + new[-1].size
+
+    def test_changed_added_removed(self):
+        """Records are matched by name; moved but equal records are unchanged."""
+        old = self.records(("ONE", b"\x39"), ("TWO", b"\x86\x41\x39"), ("GONE", b"\x39"))
+        new = self.records(("ONE", b"\x01\x39"), ("TWO", b"\x86\x41\x39"), ("NEW", b"\x39"))
+        delta = compare_records(old, new)
+        assert [r.name for r in delta.changed] == ["ONE"]
+        assert [r.name for r in delta.unchanged] == ["MAIN", "TWO"]
+        assert [r.name for r in delta.added] == ["NEW"]
+        assert [r.name for r in delta.removed] == ["GONE"]
+        assert delta.common_prefix == new[1].offset  # Only MAIN comes before ONE
+        assert delta.transfer_bytes == delta.changed[0].size + delta.added[0].size
+        assert delta.summary() == "2 unchanged, 1 changed (ONE), 1 added (NEW), 1 removed (GONE)"
+
+    def test_appended_record_keeps_prefix(self):
+        """Adding a procedure at the end leaves the earlier records as a shared prefix."""
+        old = self.records(("ONE", b"\x39"))
+        new = self.records(("ONE", b"\x39"), ("TWO", b"\x39"))
+        delta = compare_records(old, new)
+        assert [r.name for r in delta.added] == ["TWO"]
+        assert delta.common_prefix == new[2].offset
+
+
 # =============================================================================
 # Pack Builder Tests
 # =============================================================================
@@ -781,6 +841,91 @@ class TestPackBuilder:
             builder.build()
 
 
+class TestDataFiles:
+    """Tests for data files written with their records."""
+
+    def test_record_format(self):
+        """Header and records use the on-pack layout the Organiser writes."""
+        builder = PackBuilder(size_kb=8)
+        builder.add_data_file("REF", [("ab", 1), "cde\t22"])
+        records = builder.build()[16 + 11:]     # After the MAIN header
+
+        assert records == (b"\x09\x81REF     \x91"
+                           b"\x04\x91ab\t1"
+                           b"\x06\x91cde\t22"
+                           b"\xff\xff")
+
+    def test_round_trip(self):
+        """The parser reads the records of each file back."""
+        builder = PackBuilder(size_kb=8)
+        builder.add_data_file("ONE", [("a", 1), ("b", 2)])
+        builder.add_data_file("TWO", [("x",)])
+        parser = PackParser.from_bytes(builder.build())
+
+        assert [r.data for r in parser.get_data_records("one")] == [b"a\t1", b"b\t2"]
+        assert [r.data for r in parser.get_data_records("TWO")] == [b"x"]
+        assert builder.list_data_files() == [("ONE", 2), ("TWO", 1)]
+
+    def test_file_ids_in_order(self):
+        """Each file gets the next free record type; names must differ."""
+        builder = PackBuilder()
+        builder.add_data_file("A", file_id=0x92).add_data_file("B").add_data_file("C")
+        parser = PackParser.from_bytes(builder.build())
+        assert [r.file_id for r in parser.iter_data_files()] == [0x90, 0x92, 0x91, 0x93]
+
+        with pytest.raises(OPKError):
+            builder.add_data_file("B")
+        with pytest.raises(OPKError):
+            builder.add_data_file("D", file_id=0x93)
+
+    def test_field_formatting(self):
+        """Numbers become decimal text; None an empty field."""
+        assert encode_record(["x", 42, -7, 1.5, 0.1 + 0.2, True, None]) == \
+            b"x\t42\t-7\t1.5\t0.3\t1\t"
+
+    @pytest.mark.parametrize("fields", [
+        ["a\tb"],                  # TAB inside a field
+        ["line\nbreak"],
+        ["caf\u00e9"],             # Not ASCII
+        ["x"] * 17,                 # Too many fields
+        ["x" * 255],                # Record too long
+        [[1, 2]],                   # Not a field value
+    ])
+    def test_bad_records_rejected(self, fields):
+        """Records the Organiser cannot store raise OPKError."""
+        builder = PackBuilder()
+        with pytest.raises(OPKError):
+            builder.add_data_file("BAD", [("ok",), fields])
+        assert builder.get_record_count() == 0
+
+    def test_import_csv(self, tmp_path):
+        """CSV rows become records; the header row is skipped."""
+        table = tmp_path / "contacts.csv"
+        table.write_text('name,phone\nAlice,555-0101\n"Smith, J",555-0102\n\n')
+        builder = PackBuilder().import_data_file(table)
+
+        assert builder.list_data_files() == [("CONTACTS", 2)]
+        assert read_table(table) == [b"Alice\t555-0101", b"Smith, J\t555-0102"]
+        assert len(read_table(table, header=False)) == 3
+
+    def test_import_json(self, tmp_path):
+        """JSON lists and objects become records, objects in key order."""
+        table = tmp_path / "stock.json"
+        table.write_text('[{"code": "A1", "qty": 10}, {"qty": 5, "code": "B2"}, {"code": "C3"}, ["D4", 1]]')
+
+        assert read_table(table) == [b"A1\t10", b"B2\t5", b"C3\t", b"D4\t1"]
+        assert read_table(table, fields=["qty"])[:2] == [b"10", b"5"]
+
+    def test_import_errors_name_the_row(self, tmp_path):
+        """Errors in a table give the file and line."""
+        table = tmp_path / "bad.csv"
+        table.write_text("name\nok\n" + "x" * 300 + "\n")
+        with pytest.raises(OPKError, match="Line 3"):
+            read_table(table)
+        with pytest.raises(OPKError, match="Unknown table format"):
+            read_table(tmp_path / "bad.txt")
+
+
 class TestValidateProcedureName:
     """Tests for procedure name validation."""
 
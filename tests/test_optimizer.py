@@ -15,7 +15,12 @@
 import pytest
 from psion_sdk.assembler import Assembler, PeepholeOptimizer, OptimizationStats
 from psion_sdk.assembler.parser import parse_source, Instruction, LabelDef
-from psion_sdk.assembler.optimizer import optimize_statements
+from psion_sdk.assembler.optimizer import (
+    optimize_statements,
+    ControlFlowGraph,
+    DataflowOptimizer,
+    _closed_labels,
+)
 
 
 # =============================================================================
@@ -600,6 +605,317 @@ class TestEdgeCases:
         assert instructions[0].mnemonic == "CMPA"
 
 
+# =============================================================================
+# Dataflow Optimization Tests
+# =============================================================================
+
+def dataflow_optimize(source: str) -> tuple[list[str], OptimizationStats]:
+    """Optimize with the dataflow stage on; return the code as text lines."""
+    optimizer = PeepholeOptimizer(dataflow=True)
+    result = optimizer.optimize(parse_source(source))
+    lines = []
+    for stmt in result:
+        if isinstance(stmt, LabelDef):
+            lines.append(f"{stmt.name}:")
+        elif isinstance(stmt, Instruction):
+            operand = ""
+            if stmt.operand is not None:
+                operand = "".join(str(token.value) for token in stmt.operand.tokens)
+                if "INDEXED" in stmt.operand.mode.name:
+                    operand += ",X"
+            lines.append(f"{stmt.mnemonic} {operand}".strip())
+    return lines, optimizer.stats
+
+
+class TestControlFlowGraph:
+    """Test basic blocks, edges and liveness."""
+
+    SOURCE = """
+start:
+    TSTA
+    BEQ skip
+    INCA
+skip:
+    RTS
+table:
+    FDB start
+    """
+
+    def test_closed_labels(self):
+        """Only labels used solely as branch targets are closed."""
+        assert _closed_labels(parse_source(self.SOURCE)) == {"SKIP"}
+
+    def test_blocks_and_edges(self):
+        """Blocks split at labels and branches, with both branch edges."""
+        statements = parse_source(self.SOURCE)
+        cfg = ControlFlowGraph(statements, frozenset(_closed_labels(statements)))
+
+        first, fall, target = cfg.blocks[:3]
+        assert first.entry_unknown  # START is referenced by data
+        assert first.successors == {1, 2}
+        assert fall.successors == {2}
+        assert target.predecessors == {0, 1}
+        assert not target.entry_unknown
+
+    def test_liveness(self):
+        """Registers are live up to the RTS that may read them."""
+        statements = parse_source(self.SOURCE)
+        cfg = ControlFlowGraph(statements, frozenset(_closed_labels(statements)))
+        live_out = cfg.liveness()
+
+        assert {"A", "B", "X", "Z"} <= live_out[0]
+        assert live_out[2] == frozenset()  # Ends in RTS
+
+
+class TestDataflowKnownValues:
+    """Test rewrites based on known register and flag values."""
+
+    def test_load_after_store_removed(self):
+        """A load of the slot just stored is redundant."""
+        lines, stats = dataflow_optimize("""
+start:
+    TSX
+    LDD #5
+    STD 2,X
+    LDD 2,X
+    RTS
+        """)
+        assert lines == ["start:", "TSX", "LDD 5", "STD 2,X", "RTS"]
+        assert stats.redundant_load == 1
+
+    def test_tsx_across_labels_removed(self):
+        """TSX is redundant on every path where X still holds SP."""
+        lines, stats = dataflow_optimize("""
+start:
+    TSX
+    LDD 2,X
+    BEQ skip
+    TSX
+    LDD 4,X
+skip:
+    TSX
+    STD 6,X
+    RTS
+        """)
+        assert lines.count("TSX") == 1
+        assert stats.redundant_tsx == 2
+
+    def test_open_label_keeps_tsx(self):
+        """A label referenced other than by a branch may be reached with any X."""
+        lines, stats = dataflow_optimize("""
+start:
+    TSX
+    LDD 2,X
+    BEQ skip
+    LDD 4,X
+skip:
+    TSX
+    STD 6,X
+    RTS
+    FDB skip
+        """)
+        assert lines.count("TSX") == 2
+        assert stats.redundant_tsx == 0
+
+    def test_redundant_test_removed(self):
+        """SUBD #0 after LDD is redundant once the carry is overwritten."""
+        lines, stats = dataflow_optimize("""
+start:
+    LDD 2,X
+    SUBD #0
+    BEQ done
+    INCB
+done:
+    CLC
+    RTS
+        """)
+        assert "SUBD 0" not in lines
+        assert stats.redundant_test == 1
+
+    def test_test_kept_when_carry_live(self):
+        """SUBD #0 clears C, so it stays when C may be read."""
+        lines, stats = dataflow_optimize("""
+start:
+    LDD 2,X
+    SUBD #0
+    RTS
+        """)
+        assert "SUBD 0" in lines
+        assert stats.redundant_test == 0
+
+    def test_known_branch_folded(self):
+        """A branch on a known value becomes BRA and the dead path goes."""
+        lines, stats = dataflow_optimize("""
+start:
+    LDAA #1
+    TSTA
+    BNE yes
+    LDAB #2
+    RTS
+yes:
+    LDAB #3
+    RTS
+        """)
+        assert "LDAB 2" not in lines
+        assert "LDAB 3" in lines
+        assert stats.branch_fold == 1
+
+    def test_call_forgets_values(self):
+        """Nothing is known about registers after a JSR."""
+        lines, _ = dataflow_optimize("""
+start:
+    LDAA #1
+    JSR sub
+    LDAA #1
+    STAA $40
+    RTS
+sub:
+    RTS
+        """)
+        assert lines.count("LDAA 1") == 2
+
+
+class TestDataflowBranches:
+    """Test branch collapsing and threading."""
+
+    def test_branch_to_next_removed(self):
+        """A branch to the following instruction does nothing."""
+        lines, stats = dataflow_optimize("""
+start:
+    TSTA
+    BEQ next
+next:
+    RTS
+        """)
+        assert lines == ["start:", "TSTA", "next:", "RTS"]
+        assert stats.branch_thread == 1
+
+    def test_branch_over_bra_inverted(self):
+        """Bcc L1 / BRA L2 / L1: becomes one inverted branch."""
+        lines, _ = dataflow_optimize("""
+start:
+    TSTA
+    BEQ skip
+    BRA other
+skip:
+    INCA
+other:
+    RTS
+        """)
+        assert lines == ["start:", "TSTA", "BNE other", "skip:", "INCA", "other:", "RTS"]
+
+    def test_bra_to_rts(self):
+        """A jump to a lone RTS returns directly."""
+        lines, _ = dataflow_optimize("""
+start:
+    TSTA
+    BEQ skip
+    INCA
+    BRA done
+skip:
+    DECA
+done:
+    RTS
+        """)
+        assert lines == ["start:", "TSTA", "BEQ skip", "INCA", "RTS",
+                         "skip:", "DECA", "done:", "RTS"]
+
+
+class TestDataflowDeadCode:
+    """Test removal of dead register writes."""
+
+    def test_overwritten_load_removed(self):
+        """A load overwritten before any read is dead."""
+        lines, stats = dataflow_optimize("""
+start:
+    LDAA #1
+    LDAA #2
+    STAA $40
+    RTS
+        """)
+        assert lines == ["start:", "LDAA 2", "STAA 64", "RTS"]
+        assert stats.dead_store == 1
+
+    def test_dead_pull_becomes_ins(self):
+        """Pulling into a dead register only needs to move SP."""
+        lines, stats = dataflow_optimize("""
+start:
+    PSHA
+    LDAA #1
+    STAA $40
+    PULA
+    LDAA #2
+    RTS
+        """)
+        assert "PULA" not in lines
+        assert "INS" in lines
+        assert stats.dead_store == 1
+
+    def test_value_live_at_rts_kept(self):
+        """Registers are live at RTS and JSR: the caller or callee may read them."""
+        lines, stats = dataflow_optimize("""
+start:
+    LDAB #1
+    JSR sub
+    LDAA #1
+    RTS
+sub:
+    RTS
+        """)
+        assert lines == ["start:", "LDAB 1", "JSR sub", "LDAA 1", "RTS", "sub:", "RTS"]
+        assert stats.dead_store == 0
+
+
+class TestDataflowControl:
+    """Test when the dataflow stage runs."""
+
+    def test_off_by_default(self):
+        """PeepholeOptimizer runs no dataflow stage unless asked."""
+        optimizer = PeepholeOptimizer()
+        optimizer.optimize(parse_source("LDAA #1\nLDAA #2\nRTS"))
+        assert optimizer.stats.dead_store == 0
+
+    def test_macros_disable_dataflow(self):
+        """Files with macros are not analysed."""
+        statements = parse_source("""
+MACRO M1
+    NOP
+    ENDM
+    LDAA #1
+    LDAA #2
+    RTS
+        """)
+        assert not DataflowOptimizer.applicable(statements)
+
+    def test_savings_estimated(self):
+        """Savings are totalled in bytes and cycles."""
+        _, stats = dataflow_optimize("""
+start:
+    LDAA #1
+    LDAA #2
+    STAA $40
+    RTS
+        """)
+        assert stats.bytes_saved == 2
+        assert stats.cycles_saved == 2
+        assert "Estimated savings: 2 bytes, 2 cycles" in str(stats)
+
+    def test_assembler_uses_dataflow(self):
+        """The assembler runs the dataflow stage when optimizing."""
+        source = """
+    ORG $2100
+start:
+    LDAA #1
+    LDAA #2
+    STAA $40
+    RTS
+        """
+        asm = Assembler(optimize=True)
+        asm.assemble_string(source)
+        assert asm.get_optimization_stats().dead_store == 1
+        assert asm.get_code() == bytes([0x86, 0x02, 0x97, 0x40, 0x39])
+
+
 # =============================================================================
 # Example File Test
 # =============================================================================
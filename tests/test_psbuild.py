@@ -20,6 +20,9 @@ from psion_sdk.cli.psbuild import (
     classify_input_files,
     find_main_file,
     concatenate_assembly_files,
+    compile_c_to_asm,
+    assemble_to_ob3,
+    build_include_paths,
     ClassifiedFiles,
     MainFileResult,
 )
@@ -448,6 +451,29 @@ class TestFindMainFile:
             assert result.found
 
 
+class TestStripUnusedRoutines:
+    """Tests for unused routine removal in the assembly stage."""
+
+    def test_strip_unused_shrinks_ob3(self):
+        """A C program without unused runtime routines is much smaller."""
+        with tempfile.TemporaryDirectory() as tmpdir:
+            tmp = Path(tmpdir)
+            source = tmp / "small.c"
+            source.write_text('void main() { print("Hi"); getkey(); }')
+            paths = build_include_paths((), [source])
+            compile_c_to_asm(source, tmp / "small.asm", paths, None, False)
+
+            sizes = {}
+            for strip_unused in (False, True):
+                ob3 = tmp / f"small_{strip_unused}.ob3"
+                assemble_to_ob3(tmp / "small.asm", ob3, paths, None,
+                                relocatable=True, optimize=True, verbose=False,
+                                strip_unused=strip_unused)
+                sizes[strip_unused] = ob3.stat().st_size
+
+            assert sizes[True] * 2 < sizes[False]
+
+
 class TestConcatenateAssemblyFiles:
     """Tests for concatenate_assembly_files()."""
 
@@ -654,6 +680,25 @@ void main() {
             assert result.exit_code == 0, f"Build failed: {result.output}"
             assert Path("TEST.opk").exists()
 
+    def test_mixed_build_keeps_unused_by_default(self):
+        """Routines are only stripped by default when every input is C."""
+        from click.testing import CliRunner
+        from psion_sdk.cli.psbuild import main
+
+        runner = CliRunner()
+        with runner.isolated_filesystem():
+            Path("helper.asm").write_text("_helper:\n        LDD     #42\n        RTS\n")
+            Path("other.c").write_text("int other() { return 1; }\n")
+            Path("main.c").write_text("#include <psion.h>\nvoid main() { cls(); }\n")
+
+            result = runner.invoke(main, ["-v", "helper.asm", "main.c", "-o", "MIX.opk"])
+            assert result.exit_code == 0, f"Build failed: {result.output}"
+            assert "Strip unused routines: False" in result.output
+
+            result = runner.invoke(main, ["-v", "other.c", "main.c", "-o", "C.opk"])
+            assert result.exit_code == 0, f"Build failed: {result.output}"
+            assert "Strip unused routines: True" in result.output
+
     def test_extern_function_called(self):
         """Should correctly call extern function from another file."""
         from click.testing import CliRunner
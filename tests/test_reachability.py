@@ -0,0 +1,251 @@
+# =============================================================================
+# test_reachability.py - Unused Routine Removal Tests
+# =============================================================================
+# Tests for the routine reachability analysis and the assembler's
+# strip_unused mode.
+#
+# These tests verify:
+#   - Routines nothing references are left out, referenced ones are kept
+#   - Fall-through, data tables, macros and EQU references keep code live
+#   - Includes and conditional blocks are followed
+#   - Local labels of removed routines do not clash
+#   - C programs drop the runtime routines they do not call
+# =============================================================================
+
+from pathlib import Path
+
+import pytest
+from psion_sdk.assembler import Assembler
+from psion_sdk.assembler.parser import parse_source
+from psion_sdk.assembler.reachability import ReachabilityAnalyzer
+from psion_sdk.smallc import SmallCCompiler, CompilerOptions
+
+
+INCLUDE_DIR = Path(__file__).parent.parent / "include"
+
+
+def live_sections(source: str) -> dict:
+    """Section label -> live for a source without includes."""
+    return ReachabilityAnalyzer(lambda directive: None).analyze(parse_source(source))
+
+
+def strip(source: str, **kwargs) -> Assembler:
+    """Assemble source with unused routines removed."""
+    asm = Assembler(strip_unused=True, optimize=False, **kwargs)
+    asm.assemble_string(source)
+    return asm
+
+
+# =============================================================================
+# Analysis Tests
+# =============================================================================
+
+class TestReachabilityAnalysis:
+    """Tests for which sections are live."""
+
+    def test_unreferenced_routine_is_dead(self):
+        """Only routines reached from the entry are live."""
+        live = live_sections("""
+_entry: JSR _used
+        RTS
+_used:  RTS
+_unused: RTS
+        """)
+        assert live == {"_ENTRY": True, "_USED": True, "_UNUSED": False}
+
+    def test_references_are_transitive(self):
+        """A routine called from a live routine is live."""
+        live = live_sections("""
+_entry: BSR _a
+        RTS
+_a:     JMP _b
+_b:     RTS
+_c:     JSR _b
+        RTS
+        """)
+        assert live["_B"] and not live["_C"]
+
+    def test_fall_through_keeps_next(self):
+        """A routine that runs on into the next keeps it."""
+        live = live_sections("""
+_entry: JSR _a
+        RTS
+_a:     LDAA #1
+_b:     RTS
+_c:     RTS
+        """)
+        assert live["_B"] and not live["_C"]
+
+    def test_conditional_branch_falls_through(self):
+        """Only unconditional transfers end a section's flow."""
+        live = live_sections("""
+_entry: TSTA
+        BEQ _entry
+_next:  RTS
+        """)
+        assert live["_NEXT"]
+
+    def test_data_runs_into_data_not_code(self):
+        """A table spanning labels stays whole but does not keep code."""
+        live = live_sections("""
+_entry: LDX #_tab
+        RTS
+_tab:   FCB 1,2
+_tab2:  FCB 3
+_code:  RTS
+        """)
+        assert live["_TAB2"] and not live["_CODE"]
+
+    def test_macro_body_references(self):
+        """A macro call references what the macro body references."""
+        live = live_sections("""
+        MACRO CALLIT
+        JSR _target
+        ENDM
+_entry: CALLIT
+        RTS
+_target: RTS
+_other: RTS
+        """)
+        assert live["_TARGET"] and not live["_OTHER"]
+
+    def test_equ_reference_is_root(self):
+        """Labels named in EQU expressions are always kept."""
+        live = live_sections("""
+_entry: RTS
+_a:     RTS
+SIZE    EQU _a+1
+        """)
+        assert live["_A"]
+
+    def test_conditional_block_with_labels(self):
+        """Routines inside a conditional block are tracked separately."""
+        live = live_sections("""
+_entry: JSR _one
+        RTS
+#IFDEF FAST
+_one:   RTS
+_two:   RTS
+#ELSE
+_one:   NOP
+        RTS
+#ENDIF
+_three: RTS
+        """)
+        assert live["_ONE"]
+        assert not live["_TWO"]
+        assert not live["_THREE"]
+
+
+# =============================================================================
+# Assembler Tests
+# =============================================================================
+
+class TestStripUnused:
+    """Tests for Assembler(strip_unused=True)."""
+
+    SOURCE = """
+_entry: JSR _used
+        RTS
+_used:  LDAA #1
+        RTS
+_unused: LDAA #2
+        LDAB #3
+        RTS
+    """
+
+    def test_dead_code_not_emitted(self):
+        """The unused routine contributes no bytes."""
+        full = Assembler(optimize=False)
+        full.assemble_string(self.SOURCE)
+        stripped = strip(self.SOURCE)
+        assert len(full.get_code()) - len(stripped.get_code()) == 5
+        assert stripped.get_removed_routines() == ["_UNUSED"]
+        assert "_UNUSED" not in stripped.get_symbols()
+
+    def test_disabled_by_default(self):
+        """Without strip_unused every routine is assembled."""
+        asm = Assembler(optimize=False)
+        asm.assemble_string(self.SOURCE)
+        assert asm.get_removed_routines() == []
+        assert "_UNUSED" in asm.get_symbols()
+
+    def test_local_labels_of_dead_routines(self):
+        """Local labels in a removed routine are not defined."""
+        asm = strip("""
+_entry: BSR _a
+        RTS
+_a:
+.loop:  DECA
+        BNE .loop
+        RTS
+_b:
+.loop:  DECB
+        BNE .loop
+        JSR _missing
+        RTS
+        """)
+        assert asm.get_removed_routines() == ["_B"]
+
+    def test_dead_routine_in_conditional(self):
+        """A removed routine inside a conditional block is skipped."""
+        asm = strip("""
+_entry: RTS
+#IFNDEF NOTHING
+_gone:  JSR _missing
+        RTS
+#ENDIF
+_also:  RTS
+        """)
+        assert asm.get_removed_routines() == ["_ALSO", "_GONE"]
+        assert asm.get_code().endswith(b"\x39")
+
+    def test_include_followed(self, tmp_path):
+        """Routines in included files are removed when unused."""
+        (tmp_path / "lib.inc").write_text(
+            "_libused: RTS\n_libunused: LDAA #1\n        RTS\n")
+        asm = strip("""
+_entry: JSR _libused
+        RTS
+        INCLUDE "lib.inc"
+        """, include_paths=[tmp_path])
+        assert asm.get_removed_routines() == ["_LIBUNUSED"]
+
+
+# =============================================================================
+# C Program Tests
+# =============================================================================
+
+class TestCProgramStripping:
+    """Tests for unused runtime removal in compiled C programs."""
+
+    SOURCE = """
+int unused_helper(int a) { return a * 3; }
+int main() { return strlen("abc"); }
+    """
+
+    def _assemble(self, strip_unused: bool) -> Assembler:
+        asm_source = SmallCCompiler(
+            CompilerOptions(include_paths=[str(INCLUDE_DIR)])
+        ).compile_source(self.SOURCE).assembly
+        asm = Assembler(relocatable=True, strip_unused=strip_unused,
+                        include_paths=[INCLUDE_DIR])
+        asm.assemble_string(asm_source)
+        return asm
+
+    def test_runtime_routines_removed(self):
+        """Runtime routines main does not reach are left out."""
+        asm = self._assemble(True)
+        removed = asm.get_removed_routines()
+        symbols = asm.get_symbols()
+        assert "_STRCPY" in removed
+        assert "_UNUSED_HELPER" in removed
+        assert "_STRLEN" in symbols
+        assert "_MAIN" in symbols
+
+    def test_program_much_smaller(self):
+        """Most of the runtime goes away for a small program."""
+        full = self._assemble(False)
+        stripped = self._assemble(True)
+        assert len(stripped.get_code()) * 4 < len(full.get_code())
+        assert stripped.get_fixup_count() < full.get_fixup_count()
@@ -0,0 +1,305 @@
+"""
+Runtime Library Benchmarks
+==========================
+
+Cycle and code-size benchmarks for the routines in include/runtime.inc,
+checked against the baseline in runtime_benchmarks.json.
+
+These tests ensure:
+- Every benchmarked routine still returns correct results
+- No routine gets slower or larger than its stored baseline
+- The benchmark harness times calls exactly
+
+To accept new numbers after an optimization, rewrite the baseline:
+
+    PSION_BENCH_UPDATE=1 pytest tests/test_runtime_benchmarks.py
+
+Copyright (c) 2025 Hugo José Pinto & Contributors
+"""
+
+import os
+import pytest
+from pathlib import Path
+from unittest.mock import patch
+
+from psion_sdk.testkit.benchmark import (
+    BenchmarkBaseline,
+    BenchmarkCase,
+    BenchmarkResult,
+    RuntimeBenchmark,
+    DATA_BASE,
+)
+from psion_sdk.testkit.exceptions import TestAssertionError
+
+
+BASELINE_PATH = Path(__file__).parent / "runtime_benchmarks.json"
+
+# Case data areas
+SRC = DATA_BASE
+DST = DATA_BASE + 0x400
+BUF = DATA_BASE + 0x800
+
+
+def c_div(a: int, b: int) -> int:
+    """C division (truncates toward zero)."""
+    q = abs(a) // abs(b)
+    return q if (a < 0) == (b < 0) else -q
+
+
+def c_mod(a: int, b: int) -> int:
+    """C remainder (sign of the dividend)."""
+    return a - c_div(a, b) * b
+
+
+def text(length: int, char: str = "a") -> bytes:
+    """Null-terminated string of the given length."""
+    return (char * length).encode() + b"\x00"
+
+
+def pattern(length: int) -> bytes:
+    """Non-repeating test bytes."""
+    return bytes((i * 7 + 1) & 0xFF for i in range(length))
+
+
+def arithmetic_cases() -> list:
+    """__mul16, __div16, __udiv16, __mod16, __umulh16 over a spread of operands."""
+    cases = []
+    for a, b in [(0, 1234), (3, 7), (255, 255), (1234, -5), (-1, -1), (32767, 2), (1000, 1000)]:
+        cases.append(BenchmarkCase(
+            f"mul16/{a}*{b}", "__mul16", d=a, x=b, expect_d=(a * b) & 0xFFFF,
+        ))
+    for a, b in [(1000, 7), (-1000, 7), (1000, -7), (7, 1000), (32767, 1), (12345, 100)]:
+        cases.append(BenchmarkCase(
+            f"div16/{a}/{b}", "__div16", d=a, x=b, expect_d=c_div(a, b),
+        ))
+    for a, b in [(65535, 3), (1000, 7), (1, 1), (40000, 200)]:
+        cases.append(BenchmarkCase(
+            f"udiv16/{a}/{b}", "__udiv16", d=a, x=b, expect_d=a // b,
+        ))
+    for a, b in [(1000, 7), (12345, 100), (5, 10), (-1000, 7)]:
+        cases.append(BenchmarkCase(
+            f"mod16/{a}%{b}", "__mod16", d=a, x=b, expect_d=c_mod(a, b) & 0xFFFF,
+        ))
+    for a, b in [(1000, 0x2493), (65535, 65535), (12345, 0xCCCD)]:
+        cases.append(BenchmarkCase(
+            f"umulh16/{a}*{b}", "__umulh16", d=a, x=b, expect_d=(a * b) >> 16,
+        ))
+    return cases
+
+
+def memory_cases() -> list:
+    """memcpy, memset, memcmp, struct_copy over a sweep of sizes."""
+    cases = []
+    for n in (0, 1, 8, 64, 256):
+        data = pattern(n)
+        cases.append(BenchmarkCase(
+            f"memcpy/n={n}", "_memcpy", args=(DST, SRC, n),
+            memory={SRC: data}, expect_d=DST, expect_memory={DST: data},
+        ))
+        cases.append(BenchmarkCase(
+            f"memset/n={n}", "_memset", args=(DST, 0x41, n),
+            expect_d=DST, expect_memory={DST: b"A" * n},
+        ))
+    for n in (8, 64):
+        data = pattern(n)
+        cases.append(BenchmarkCase(
+            f"memcmp/n={n}", "_memcmp", args=(SRC, DST, n),
+            memory={SRC: data, DST: data}, expect_d=0,
+        ))
+    data = pattern(16)
+    cases.append(BenchmarkCase(
+        "struct_copy/size=16", "_struct_copy", args=(DST, SRC, 16),
+        memory={SRC: data}, expect_d=DST, expect_memory={DST: data},
+    ))
+    return cases
+
+
+def string_cases() -> list:
+    """String routines over a sweep of lengths."""
+    cases = []
+    for n in (0, 1, 16, 64, 255):
+        cases.append(BenchmarkCase(
+            f"strlen/len={n}", "_strlen", args=(SRC,),
+            memory={SRC: text(n)}, expect_d=n,
+        ))
+    for n in (0, 16, 64):
+        cases.append(BenchmarkCase(
+            f"strcpy/len={n}", "_strcpy", args=(DST, SRC),
+            memory={SRC: text(n, "b")}, expect_d=DST, expect_memory={DST: text(n, "b")},
+        ))
+    for n in (1, 16, 64):
+        cases.append(BenchmarkCase(
+            f"strcmp/equal/len={n}", "_strcmp", args=(SRC, DST),
+            memory={SRC: text(n), DST: text(n)}, expect_d=0,
+        ))
+    cases.append(BenchmarkCase(
+        "strcmp/differ-first", "_strcmp", args=(SRC, DST),
+        memory={SRC: text(16, "a"), DST: text(16, "b")},
+    ))
+    cases.append(BenchmarkCase(
+        "strcat/16+16", "_strcat", args=(DST, SRC),
+        memory={DST: text(16, "a"), SRC: text(16, "b")}, expect_d=DST,
+        expect_memory={DST: b"a" * 16 + text(16, "b")},
+    ))
+    for n in (16, 64):
+        cases.append(BenchmarkCase(
+            f"strchr/at={n}", "_strchr", args=(SRC, ord("z")),
+            memory={SRC: b"a" * n + text(8, "z")}, expect_d=SRC + n,
+        ))
+    cases.append(BenchmarkCase(
+        "strchr/missing/len=64", "_strchr", args=(SRC, ord("z")),
+        memory={SRC: text(64)}, expect_d=0,
+    ))
+    cases.append(BenchmarkCase(
+        "strncpy/n=16/len=8", "_strncpy", args=(DST, SRC, 16),
+        memory={SRC: text(8, "c"), DST: b"\xFF" * 16}, expect_d=DST,
+        expect_memory={DST: b"c" * 8 + b"\x00" * 8},
+    ))
+    cases.append(BenchmarkCase(
+        "strncmp/n=16/equal", "_strncmp", args=(SRC, DST, 16),
+        memory={SRC: text(32), DST: text(32)}, expect_d=0,
+    ))
+    return cases
+
+
+def conversion_cases() -> list:
+    """atoi and itoa over numbers of different lengths."""
+    cases = []
+    for s, value in [("0", 0), ("7", 7), ("42", 42), ("-12345", -12345), ("  +78", 78), ("32767", 32767)]:
+        cases.append(BenchmarkCase(
+            f"atoi/{s.strip()}", "_atoi", args=(SRC,),
+            memory={SRC: s.encode() + b"\x00"}, expect_d=value & 0xFFFF,
+        ))
+    for value in (0, 7, 42, -12345, 32767):
+        cases.append(BenchmarkCase(
+            f"itoa/{value}", "_itoa", args=(value & 0xFFFF, BUF),
+            expect_d=BUF, expect_memory={BUF: str(value).encode() + b"\x00"},
+        ))
+    return cases
+
+
+def misc_cases() -> list:
+    """abs, min, max."""
+    return [
+        BenchmarkCase("abs/-16", "_abs", args=(-16 & 0xFFFF,), expect_d=16),
+        BenchmarkCase("min/5,3", "_min", args=(5, 3), expect_d=3),
+        BenchmarkCase("max/5,3", "_max", args=(5, 3), expect_d=5),
+    ]
+
+
+# Shift helpers are left out: they currently lose the shift count and
+# unbalance the stack when called as documented.
+RUNTIME_CASES = (
+    arithmetic_cases() + memory_cases() + string_cases()
+    + conversion_cases() + misc_cases()
+)
+
+
+@pytest.fixture(scope="module")
+def bench():
+    """runtime.inc assembled and loaded on a bare CPU."""
+    return RuntimeBenchmark()
+
+
+@pytest.fixture(scope="module")
+def results(bench):
+    """All runtime cases, measured once per module."""
+    return bench.run(RUNTIME_CASES)
+
+
+# =============================================================================
+# Harness Tests
+# =============================================================================
+
+class TestBenchmarkHarness:
+    """The harness itself."""
+
+    def test_call_cycles_exact(self, bench):
+        """A leaf routine costs exactly its instruction cycles."""
+        bench.reset()
+        # _abs with a positive argument: PSHX, TSX, LDD 4,X, BPL, PULX, RTS
+        result = bench.call("_abs", (5,))
+        assert result.d == 5
+        assert result.cycles == 5 + 1 + 5 + 3 + 4 + 5
+
+    def test_routine_size_follows_wrapper(self, bench):
+        """A JMP wrapper is counted together with its target."""
+        assert bench.routine_size("_memcpy") == 3 + bench.routine_size("__memcpy")
+        assert bench.routine_size("__memcpy") > 3
+
+    def test_wrong_result_fails(self, bench):
+        """A case whose expectation is not met raises."""
+        case = BenchmarkCase("bad", "__mul16", d=3, x=7, expect_d=22)
+        with pytest.raises(TestAssertionError):
+            bench.measure(case)
+
+    def test_cases_are_independent(self, bench):
+        """Running a case twice gives the same numbers."""
+        case = BenchmarkCase("itoa", "_itoa", args=(123, BUF), expect_d=BUF)
+        assert bench.measure(case) == bench.measure(case)
+
+
+class TestBenchmarkBaseline:
+    """Baseline comparison and storage."""
+
+    def test_regressions(self):
+        """Slower or larger results are regressions; new cases are not."""
+        baseline = BenchmarkBaseline.from_results([
+            BenchmarkResult("a", "_a", 100, 10),
+            BenchmarkResult("b", "_b", 100, 10),
+        ])
+        results = [
+            BenchmarkResult("a", "_a", 101, 10),
+            BenchmarkResult("b", "_b", 90, 11),
+            BenchmarkResult("c", "_c", 500, 50),
+        ]
+
+        found = baseline.regressions(results)
+        assert [(r.name, r.metric) for r in found] == [("a", "cycles"), ("b", "bytes")]
+        assert baseline.regressions(results[:1], tolerance=0.05) == []
+        assert "new" in baseline.report(results)
+
+    def test_save_load(self, tmp_path):
+        """Baselines survive a round trip through the file."""
+        path = tmp_path / "baseline.json"
+        results = [BenchmarkResult("x/n=1", "_x", 42, 7)]
+        BenchmarkBaseline.from_results(results).save(path)
+
+        assert BenchmarkBaseline.load(path).entries == {"x/n=1": results[0]}
+        assert len(BenchmarkBaseline.load(tmp_path / "missing.json")) == 0
+
+    def test_check(self, tmp_path):
+        """check() fails on missing cases and regressions, and can update."""
+        path = tmp_path / "baseline.json"
+        BenchmarkBaseline.from_results([BenchmarkResult("a", "_a", 100, 10)]).save(path)
+        slower = [BenchmarkResult("a", "_a", 101, 10)]
+
+        with patch.dict(os.environ, {"PSION_BENCH_UPDATE": ""}):
+            report = BenchmarkBaseline.check([BenchmarkResult("a", "_a", 90, 10)], path)
+            assert "-10.0%" in report
+            with pytest.raises(TestAssertionError, match="a: cycles"):
+                BenchmarkBaseline.check(slower, path)
+            with pytest.raises(TestAssertionError, match="Not in baseline.json"):
+                BenchmarkBaseline.check([BenchmarkResult("b", "_b", 1, 1)], path)
+
+        with patch.dict(os.environ, {"PSION_BENCH_UPDATE": "1"}):
+            BenchmarkBaseline.check(slower, path)
+        assert BenchmarkBaseline.load(path).entries["a"].cycles == 101
+
+
+# =============================================================================
+# Runtime Benchmarks
+# =============================================================================
+
+class TestRuntimeBenchmarks:
+    """runtime.inc against the stored baseline."""
+
+    def test_no_regressions(self, results):
+        """No routine is slower or larger than its baseline."""
+        BenchmarkBaseline.check(results, BASELINE_PATH)
+
+    def test_baseline_covers_cases(self, results):
+        """Every case has a stored baseline."""
+        baseline = BenchmarkBaseline.load(BASELINE_PATH)
+        missing = [r.name for r in results if r.name not in baseline.entries]
+        assert not missing, f"Not in {BASELINE_PATH.name}: {missing}"
@@ -33,7 +33,9 @@ from psion_sdk.smallc.ast import (
     ASTPrinter,
 )
 from psion_sdk.smallc.types import CType, BaseType, TYPE_INT, TYPE_CHAR
-from psion_sdk.smallc.errors import CSyntaxError, CPreprocessorError, SmallCError, CTypeError
+from psion_sdk.smallc.errors import (
+    CSyntaxError, CPreprocessorError, SmallCError, CTypeError, CCodeGenError,
+)
 
 
 # =============================================================================
@@ -540,7 +542,10 @@ class TestCodeGen:
         gen = CodeGenerator()
         asm = gen.generate(ast)
 
-        assert "JMP" in asm  # Loop back (uses JMP for long jumps)
+        # Short branches only: the assembler widens them when out of range
+        assert "BEQ" in asm
+        assert "BRA" in asm
+        assert "JMP" not in asm
 
 
 # =============================================================================
@@ -692,6 +697,19 @@ class TestIntegration:
         asm = compile_c(source)
         assert "_sum:" in asm
 
+    def test_long_loop_assembles(self):
+        """A while body too long for a short branch still assembles."""
+        from pathlib import Path
+        from psion_sdk.assembler import Assembler
+
+        body = "".join(f"x = x + {i}; " for i in range(1, 40))
+        asm = compile_c(f"int x; void main() {{ while (x) {{ {body} }} }}")
+
+        include_dir = Path(__file__).parent.parent / "include"
+        assembler = Assembler(include_paths=[str(include_dir)])
+        assembler.assemble_string(asm, "loop.asm")
+        assert not assembler.has_errors()
+
     def test_compiler_class(self):
         """SmallCCompiler class should work correctly."""
         compiler = SmallCCompiler()
@@ -2095,6 +2113,18 @@ class TestFloatSupportConditional:
         included = pp.get_included_files()
         assert "psion.h" in included
 
+    def test_dependencies_are_resolved_paths(self):
+        """get_dependencies() lists each header read, nested ones included."""
+        from pathlib import Path
+
+        source = '#include "float.h"\n#include "psion.h"\n#include "psion.h"\nint x;'
+        pp = Preprocessor(source, "test.c", include_paths=["include"])
+        pp.process()
+        names = [Path(dep).name for dep in pp.get_dependencies()]
+        assert "float.h" in names and "psion.h" in names
+        assert len(names) == len(set(names))
+        assert all(Path(dep).is_absolute() for dep in pp.get_dependencies())
+
     def test_codegen_with_float_support(self):
         """CodeGenerator should include fpruntime.inc when has_float_support=True."""
         source = "void main() { }"
@@ -2396,8 +2426,8 @@ class TestPowerOf2Optimization:
         assert asld_count >= 3
 
     def test_divide_by_2_uses_lsrd(self):
-        """x / 2 should use LSRD instead of __div16."""
-        source = "void main() { int x; int y; x = 10; y = x / 2; }"
+        """unsigned x / 2 should use LSRD instead of __div16."""
+        source = "void main() { unsigned int x; unsigned int y; x = 10; y = x / 2; }"
         ast = parse_source(source)
         gen = CodeGenerator()
         asm = gen.generate(ast)
@@ -2407,8 +2437,8 @@ class TestPowerOf2Optimization:
         assert "__div16" not in asm
 
     def test_divide_by_4_uses_two_lsrd(self):
-        """x / 4 should use two LSRD instructions."""
-        source = "void main() { int x; int y; x = 10; y = x / 4; }"
+        """unsigned x / 4 should use two LSRD instructions."""
+        source = "void main() { unsigned int x; unsigned int y; x = 10; y = x / 4; }"
         ast = parse_source(source)
         gen = CodeGenerator()
         asm = gen.generate(ast)
@@ -2416,29 +2446,34 @@ class TestPowerOf2Optimization:
         assert lsrd_count >= 2
 
     def test_divide_by_8_uses_three_lsrd(self):
-        """x / 8 should use three LSRD instructions."""
-        source = "void main() { int x; int y; x = 10; y = x / 8; }"
+        """unsigned x / 8 should use three LSRD instructions."""
+        source = "void main() { unsigned int x; unsigned int y; x = 10; y = x / 8; }"
         ast = parse_source(source)
         gen = CodeGenerator()
         asm = gen.generate(ast)
         lsrd_count = asm.count("LSRD")
         assert lsrd_count >= 3
 
-    def test_multiply_by_non_power_of_2_uses_mul16(self):
-        """x * 3 should still use __mul16 (3 is not power of 2)."""
+    def test_multiply_by_non_power_of_2_shifts_and_adds(self):
+        """x * 3 is (x << 1) + x, without __mul16."""
         source = "void main() { int x; int y; x = 10; y = x * 3; }"
         ast = parse_source(source)
         gen = CodeGenerator()
         asm = gen.generate(ast)
-        assert "__mul16" in asm
+        assert "__mul16" not in asm
+        assert asm.count("ASLD") == 1
+        assert "ADDD    2,X" in asm
 
-    def test_divide_by_non_power_of_2_uses_div16(self):
-        """x / 5 should still use __div16 (5 is not power of 2)."""
-        source = "void main() { int x; int y; x = 10; y = x / 5; }"
+    def test_signed_divide_by_4_rounds_toward_zero(self):
+        """int x / 4 biases negative values, then shifts arithmetically."""
+        source = "void main() { int x; int y; x = -10; y = x / 4; }"
         ast = parse_source(source)
         gen = CodeGenerator()
         asm = gen.generate(ast)
-        assert "__div16" in asm
+        assert "ADDD    #3" in asm
+        assert asm.count("ASRA") == 2
+        assert "LSRD" not in asm
+        assert "__div16" not in asm
 
     def test_multiply_by_1_is_noop(self):
         """x * 1 should not emit any shifts (1 = 2^0)."""
@@ -2469,14 +2504,131 @@ class TestPowerOf2Optimization:
         assert asld_count >= 8
         assert "__mul16" not in asm
 
-    def test_multiply_by_512_uses_mul16(self):
-        """x * 512 should use __mul16 (9 shifts > 8 limit)."""
+    def test_multiply_by_512_shifts(self):
+        """x * 512 is nine shifts, still far cheaper than __mul16."""
         source = "void main() { int x; int y; x = 1; y = x * 512; }"
         ast = parse_source(source)
         gen = CodeGenerator()
         asm = gen.generate(ast)
-        # 512 = 2^9, exceeds 8-shift limit
-        assert "__mul16" in asm
+        assert "__mul16" not in asm
+        assert asm.count("ASLD") == 9
+
+
+# =============================================================================
+# Division by Constant Tests
+# =============================================================================
+
+class TestConstantDivision:
+    """
+    Tests for division and modulo by a constant.
+
+    x / c compiles to a multiply by a reciprocal via __umulh16 plus shifts,
+    and x % c to x - (x / c) * c, so no __div16 or __mod16 call is made.
+    """
+
+    @pytest.mark.parametrize("divisor", [3, 5, 7, 10, 11, 100, 641, 1000, 32767])
+    def test_signed_magic_is_exact(self, divisor):
+        """The reciprocal gives exact quotients for every |x| <= 32768."""
+        m, s = CodeGenerator._division_magic(divisor, 0x8000)
+        assert m <= 0xFFFF
+        assert all((x * m) >> (16 + s) == x // divisor for x in range(0x8001))
+
+    @pytest.mark.parametrize("divisor", [3, 7, 10, 100, 40000, 65535])
+    def test_unsigned_magic_is_exact(self, divisor):
+        """The reciprocal gives exact quotients for every unsigned x."""
+        m, s = CodeGenerator._division_magic(divisor, 0xFFFF)
+        assert m < 0x20000
+        assert all((x * m) >> (16 + s) == x // divisor for x in range(0x10000))
+
+    def test_divide_by_5_uses_reciprocal(self):
+        """x / 5 multiplies by a reciprocal instead of calling __div16."""
+        source = "void main() { int x; int y; x = 10; y = x / 5; }"
+        ast = parse_source(source)
+        gen = CodeGenerator()
+        asm = gen.generate(ast)
+        assert "JSR     __umulh16" in asm
+        assert "__div16" not in asm
+
+    def test_modulo_by_10(self):
+        """x % 10 is x - (x / 10) * 10, without __mod16."""
+        source = "void main() { int x; int y; x = 1234; y = x % 10; }"
+        ast = parse_source(source)
+        gen = CodeGenerator()
+        asm = gen.generate(ast)
+        assert "JSR     __umulh16" in asm
+        assert "__mul16" not in asm  # (x / 10) * 10 is shifts and an add
+        assert "__mod16" not in asm
+
+    def test_unsigned_modulo_by_8_masks(self):
+        """unsigned x % 8 is a mask."""
+        source = "void main() { unsigned int x; unsigned int y; x = 99; y = x % 8; }"
+        ast = parse_source(source)
+        gen = CodeGenerator()
+        asm = gen.generate(ast)
+        assert "ANDB    #7" in asm
+        assert "__mod16" not in asm
+        assert "__umulh16" not in asm
+
+    def test_variable_divisor_uses_div16(self):
+        """A divisor that is not constant still calls __div16."""
+        source = "void main() { int x; int y; x = 10; y = 3; y = x / y; }"
+        ast = parse_source(source)
+        gen = CodeGenerator()
+        asm = gen.generate(ast)
+        assert "JSR     __div16" in asm
+
+    def test_unsigned_variable_divisor_uses_udiv16(self):
+        """An unsigned operand on either side divides with __udiv16."""
+        for decl in ("unsigned int x; int y;", "int x; unsigned int y;"):
+            for op in ("/", "%"):
+                source = f"void main() {{ {decl} int r; x = 10; y = 3; r = x {op} y; }}"
+                asm = CodeGenerator().generate(parse_source(source))
+                assert "JSR     __udiv16" in asm
+                assert "__mod16" not in asm
+                assert "JSR     __div16" not in asm
+
+    def test_results(self, tmp_path):
+        """Constant and variable divisors give the same, C, results."""
+        from pathlib import Path
+        import shutil
+        from psion_sdk.testkit.benchmark import RuntimeBenchmark
+
+        include = Path(__file__).parent.parent / "include"
+        for inc in include.glob("*.inc"):
+            shutil.copy(inc, tmp_path)
+        asm = CodeGenerator(emit_runtime=False).generate(parse_source(DIVISION_PROGRAM))
+        (tmp_path / "prog.inc").write_text("\n".join(
+            l for l in asm.splitlines()
+            if "INCLUDE" not in l and ".MODEL" not in l and l.strip() != "END"))
+        bench = RuntimeBenchmark(("runtime.inc", "prog.inc"), include_dir=tmp_path)
+
+        def call(name, *args):
+            bench.reset()
+            return bench.call(name, tuple(v & 0xFFFF for v in args)).d
+
+        for u in (0, 3, 39999, 40000, 40003, 65535):
+            assert call("_udiv_c", u) == call("_udiv_v", u, 7) == u // 7, u
+            assert call("_umod_c", u) == call("_umod_v", u, 10) == u % 10, u
+            # int / unsigned is unsigned
+            assert call("_mixed_v", u, 7) == u // 7, u
+        for x in (-32768, -40, -3, 0, 3, 40, 32767):
+            q = abs(x) // 7 * (1 if x >= 0 else -1)
+            r = abs(x) % 10 * (1 if x >= 0 else -1)
+            assert call("_sdiv_c", x) == call("_sdiv_v", x, 7) == q & 0xFFFF, x
+            assert call("_smod_c", x) == call("_smod_v", x, 10) == r & 0xFFFF, x
+
+
+DIVISION_PROGRAM = """
+unsigned int udiv_c(unsigned int u) { return u / 7; }
+unsigned int udiv_v(unsigned int u, unsigned int v) { return u / v; }
+unsigned int umod_c(unsigned int u) { return u % 10; }
+unsigned int umod_v(unsigned int u, unsigned int v) { return u % v; }
+unsigned int mixed_v(int x, unsigned int v) { return x / v; }
+int sdiv_c(int x) { return x / 7; }
+int sdiv_v(int x, int v) { return x / v; }
+int smod_c(int x) { return x % 10; }
+int smod_v(int x, int v) { return x % v; }
+"""
 
 
 # =============================================================================
@@ -2711,21 +2863,22 @@ class TestCharPromotionOperations:
         asm = gen.generate(ast)
         assert "__mul16" in asm
 
-    def test_char_divide_char_uses_div16(self):
-        """char / char promotes to 16-bit and uses __div16."""
+    def test_char_divide_char_uses_udiv16(self):
+        """char / char promotes to 16-bit and, zero-extended, uses __udiv16."""
         source = "void main() { char a, b; int r; r = a / b; }"
         ast = parse_source(source)
         gen = CodeGenerator()
         asm = gen.generate(ast)
-        assert "__div16" in asm
+        assert "JSR     __udiv16" in asm
 
-    def test_char_modulo_char_uses_mod16(self):
-        """char % char promotes to 16-bit and uses __mod16."""
+    def test_char_modulo_char_uses_udiv16(self):
+        """char % char takes the remainder __udiv16 leaves."""
         source = "void main() { char a, b; int r; r = a % b; }"
         ast = parse_source(source)
         gen = CodeGenerator()
         asm = gen.generate(ast)
-        assert "__mod16" in asm
+        assert "JSR     __udiv16" in asm
+        assert "LDD     __div16_rem" in asm
 
     def test_char_comparison_produces_int(self):
         """char == char comparison produces int result (0 or 1)."""
@@ -3056,7 +3209,7 @@ class TestStructCopy:
     """Tests for struct copying."""
 
     def test_struct_copy_call(self):
-        """struct_copy function call should compile."""
+        """struct_copy with a runtime size should call _struct_copy."""
         source = """
             struct Point {
                 int x;
@@ -3064,7 +3217,9 @@ class TestStructCopy:
             };
             void main() {
                 struct Point p1, p2;
-                struct_copy(&p2, &p1, 4);
+                int n;
+                n = 4;
+                struct_copy(&p2, &p1, n);
             }
         """
         ast = parse_source(source)
@@ -3073,6 +3228,59 @@ class TestStructCopy:
         # Should generate a call to _struct_copy
         assert "JSR     _struct_copy" in asm
 
+    def test_small_struct_copy_inline(self):
+        """struct_copy with a small constant size is expanded as word moves."""
+        source = """
+            struct Point {
+                int x;
+                int y;
+                char tag;
+            };
+            struct Point p1, p2;
+            void main() {
+                struct_copy(&p2, &p1, sizeof(struct Point));
+            }
+        """
+        ast = parse_source(source)
+        gen = CodeGenerator()
+        asm = gen.generate(ast)
+        lines = [l.split(";")[0].split() for l in asm.splitlines()]
+        lines = [l for l in lines if l]
+        assert "JSR     _struct_copy" not in asm
+        # Two words and the odd byte, stored in order
+        assert ["STD", "0,X"] in lines
+        assert ["STD", "2,X"] in lines
+        assert ["STAB", "4,X"] in lines
+
+    def test_large_memcpy_calls_runtime(self):
+        """memcpy above the inline limit still calls _memcpy."""
+        source = """
+            char a[64];
+            char b[64];
+            void main() {
+                memcpy(a, b, 64);
+            }
+        """
+        ast = parse_source(source)
+        gen = CodeGenerator()
+        asm = gen.generate(ast)
+        assert "JSR     _memcpy" in asm
+
+    def test_user_memcpy_not_inlined(self):
+        """A program's own memcpy is always called."""
+        source = """
+            char a[4];
+            char b[4];
+            void *memcpy(void *d, void *s, int n) { return d; }
+            void main() {
+                memcpy(a, b, 4);
+            }
+        """
+        ast = parse_source(source)
+        gen = CodeGenerator()
+        asm = gen.generate(ast)
+        assert "JSR     _memcpy" in asm
+
 
 class TestStructErrors:
     """Tests for struct error handling."""
@@ -3497,7 +3705,8 @@ class TestFramePointerRefresh:
     Bug fix: XGDX (used for local array address computation) corrupts X.
     Subsequent local accesses (both array and scalar) must emit TSX to
     refresh the frame pointer. Also adjusts offset by _arg_push_depth
-    when args are on the stack.
+    when args are on the stack. Tests that count TSX use opt_level 0,
+    since register-aware code drops the refreshes X does not need.
     """
 
     def test_local_array_emits_tsx_before_xgdx(self):
@@ -3526,7 +3735,7 @@ class TestFramePointerRefresh:
             }
         """
         ast = parse_source(source)
-        gen = CodeGenerator()
+        gen = CodeGenerator(opt_level=0)
         asm = gen.generate(ast)
 
         # The read of x for `result = x` should be preceded by TSX
@@ -3552,7 +3761,7 @@ class TestFramePointerRefresh:
             }
         """
         ast = parse_source(source)
-        gen = CodeGenerator()
+        gen = CodeGenerator(opt_level=0)
         asm = gen.generate(ast)
 
         # Count TSX+XGDX pairs (one per array address computation)
@@ -3641,7 +3850,7 @@ class TestFramePointerRefresh:
             }
         """
         ast = parse_source(source)
-        gen = CodeGenerator()
+        gen = CodeGenerator(opt_level=0)
         asm = gen.generate(ast)
 
         # Should see TSX before LDAB for the char read
@@ -3685,3 +3894,568 @@ class TestFramePointerRefresh:
 
         # Should use direct addressing
         assert "LDD     _gvar" in asm
+
+# =============================================================================
+# Register-Aware Codegen Tests
+# =============================================================================
+
+def _asm_lines(source: str, opt_level: int = 1) -> list:
+    """Instruction lines of the code generated for source."""
+    asm = CodeGenerator(opt_level=opt_level).generate(parse_source(source))
+    return [" ".join(l.split()) for l in asm.splitlines()
+            if l.startswith("        ") and not l.strip().startswith(";")]
+
+
+class TestRegisterAwareCodegen:
+    """Tests for X tracking and direct operands in register-aware mode."""
+
+    def test_consecutive_locals_share_one_tsx(self):
+        """Back-to-back local accesses reuse the frame pointer in X."""
+        lines = _asm_lines("""
+            int f() { int a; int b; a = 1; b = 2; return a + b; }
+        """)
+        body = lines[lines.index("TSX"):]
+        assert body.count("TSX") == 1
+        assert "LDD 2,X" in body and "ADDD 4,X" in body
+
+    def test_variable_operand_not_pushed(self):
+        """x + y with variable operands needs no stack temporary."""
+        lines = _asm_lines("""
+            int g;
+            int f(int x) { return x - g; }
+        """)
+        assert "SUBD _g" in lines
+        assert "PSHB" not in lines
+
+    def test_commutative_operands_swap(self):
+        """n * f() evaluates f() first and multiplies by n in place."""
+        lines = _asm_lines("""
+            int n;
+            int f() { return 3; }
+            int h() { return n * f(); }
+        """)
+        call = lines.index("JSR _f")
+        assert lines[call + 1:call + 3] == ["LDX _n", "JSR __mul16"]
+
+    def test_offset_adjusted_for_pushes(self):
+        """A frame pointer taken before a push is reused at a shifted offset."""
+        lines = _asm_lines("""
+            int f(int a) { return g(a, a); }
+        """)
+        # a is at 4,X; after the first push the same X still reaches it
+        assert lines.count("LDD 4,X") == 2
+        assert lines.count("TSX") == 1
+
+    def test_call_to_local_function_keeps_x(self):
+        """Functions compiled here preserve X, so no reload follows the call."""
+        lines = _asm_lines("""
+            int one() { return 1; }
+            int f() { int a; a = one(); return a; }
+        """)
+        call = lines.index("JSR _one")
+        assert "TSX" not in lines[call:call + 3]
+
+    def test_call_to_external_function_reloads_x(self):
+        """Library calls may change X, so the next local access reloads it."""
+        lines = _asm_lines("""
+            int f() { int a; a = strlen("x"); return a; }
+        """)
+        call = lines.index("JSR _strlen")
+        assert lines[call + 1:call + 4] == ["INS", "INS", "TSX"]
+
+    def test_constant_subscript_folds(self):
+        """Constant indexes fold into the element address."""
+        lines = _asm_lines("""
+            int tab[4];
+            int f() { return tab[3]; }
+        """)
+        assert "LDX #_tab+6" in lines
+        assert "PSHX" not in lines[lines.index("LDX #_tab+6") - 1:]
+
+    def test_inline_asm_gets_frame_pointer(self):
+        """Inline asm naming a local starts with X at the frame."""
+        lines = _asm_lines("""
+            void f() { int a; strlen("x"); asm("        LDD     %a"); }
+        """)
+        call = lines.index("JSR _strlen")
+        assert lines[call + 3:call + 5] == ["TSX", "LDD 2,X"]
+
+    def test_disabled_matches_plain_codegen(self):
+        """opt_level 0 keeps the push/pop code."""
+        source = "int f(int x, int y) { return x + y; }"
+        plain = _asm_lines(source, opt_level=0)
+        assert plain.count("TSX") == 4
+        assert "ADDD 0,X" in plain
+        assert len(_asm_lines(source)) < len(plain)
+
+
+# =============================================================================
+# Switch Lowering Tests
+# =============================================================================
+
+SWITCH_PROGRAM = """
+int tab(int a) {
+    int r;
+    r = 100;
+    switch (a) {
+    case 3: r = 1; break;
+    case 4: r = 2; break;
+    case 5: r = 3;
+    case 6: r = r + 4; break;
+    case 8: r = 5; break;
+    case 10: return a * 2;
+    }
+    return r;
+}
+int tree(int a) {
+    int i;
+    int r;
+    r = 0;
+    switch (a) {
+    case 1: r = 11; break;
+    case 100: r = 12; break;
+    case 200: r = 13; break;
+    case 300: r = 14; break;
+    case 1000: r = 15; break;
+    case -5: r = 16; break;
+    case 5000: r = 17; break;
+    case -30000: r = 19; break;
+    default:
+        for (i = 0; i < 10; i = i + 1) {
+            if (i == 3) break;
+            r = r + 1;
+        }
+        r = r + 1000;
+    }
+    return r;
+}
+int var(int a, int b) {
+    switch (a) {
+    case 7: return 70;
+    case b: return 99;
+    }
+    return b;
+}
+"""
+
+
+def _switch_lines(cases: str, value: str = "a") -> list:
+    """Instruction lines of a function switching on value."""
+    return _asm_lines(f"int f(int a, int b) {{ switch ({value}) {{ {cases} }} return 0; }}")
+
+
+class TestSwitchLowering:
+    """Tests for the choice of switch dispatch code."""
+
+    def test_few_cases_compare_in_register(self):
+        """Up to four cases subtract the differences between case values."""
+        lines = _switch_lines("case 1: return 5; case 2: return 6; case 9: return 7;")
+        first = lines.index("SUBD #1")
+        assert lines[first + 1].startswith("BEQ")
+        assert lines[first + 2:first + 4] == ["SUBD #1", lines[first + 3]]
+        assert "SUBD #7" in lines
+        assert "PSHB" not in lines
+
+    def test_dense_cases_use_jump_table(self):
+        """Dense case values index an address table."""
+        lines = _switch_lines(" ".join(f"case {n}: return {n * 3};" for n in range(10, 16)))
+        assert "SUBD #10" in lines
+        assert "CMPB #5" in lines
+        assert "JMP 0,X" in lines
+        assert sum(1 for l in lines if l.startswith("FDB")) == 6
+
+    def test_table_holes_go_to_default(self):
+        """Missing values in a table range jump to the default label."""
+        lines = _switch_lines("case 0: return 1; case 1: return 2; case 3: return 3; "
+                              "case 4: return 4; case 5: return 5; default: return 9;")
+        slots = [l.split()[1] for l in lines if l.startswith("FDB")]
+        miss = next(l.split()[1] for l in lines if l.startswith("BNE"))
+        assert len(slots) == 6
+        assert slots[2] == miss
+        assert miss not in slots[:2] + slots[3:]
+
+    def test_sparse_cases_use_search_tree(self):
+        """Sparse case values are found by a binary search on X."""
+        lines = _switch_lines(" ".join(f"case {n}: return {n};" for n in (1, 50, 999, 2000, 7000, 30000)))
+        assert "XGDX" in lines
+        assert any(l.startswith("BHI") for l in lines)
+        assert not any(l.startswith("FDB") for l in lines)
+
+    def test_non_constant_case_compares_on_stack(self):
+        """A case that is not a constant falls back to a compare chain."""
+        lines = _switch_lines("case 7: return 1; case b: return 2;")
+        assert "PSHB" in lines
+        assert any(l.startswith("SUBD") and ",X" in l for l in lines)
+
+    def test_case_bodies_run_with_frame_balanced(self):
+        """Nothing stays pushed while a case body addresses locals."""
+        lines = _asm_lines("""
+            int f(int a) { int r; switch (a) { case 1: r = a; break; case 2: r = 4; break; } return r; }
+        """)
+        assert "PSHB" not in lines
+        assert "PSHA" not in lines
+
+    def test_break_in_loop_inside_switch(self):
+        """break in a loop inside a case leaves the loop, not the switch."""
+        asm = CodeGenerator().generate(parse_source("""
+            int f(int a) {
+                int i;
+                switch (a) { case 1: while (a) { break; } return 1; }
+                return 0;
+            }
+        """))
+        lines = [" ".join(l.split()) for l in asm.splitlines()]
+        loop_end = next(l for l in lines if l.startswith("BEQ _wend"))
+        assert "BRA " + loop_end.split()[1] in lines
+
+    def test_switch_results(self, tmp_path):
+        """Every lowering reaches the right case on the CPU."""
+        from pathlib import Path
+        import shutil
+        from psion_sdk.testkit.benchmark import RuntimeBenchmark
+
+        include = Path(__file__).parent.parent / "include"
+        for inc in include.glob("*.inc"):
+            shutil.copy(inc, tmp_path)
+        asm = CodeGenerator(emit_runtime=False).generate(parse_source(SWITCH_PROGRAM))
+        (tmp_path / "prog.inc").write_text("\n".join(
+            l for l in asm.splitlines()
+            if "INCLUDE" not in l and ".MODEL" not in l and l.strip() != "END"))
+        bench = RuntimeBenchmark(("runtime.inc", "prog.inc"), include_dir=tmp_path)
+
+        def tab(a):
+            return {3: 1, 4: 2, 5: 7, 6: 104, 8: 5, 10: 20}.get(a, 100)
+
+        def tree(a):
+            return {1: 11, 100: 12, 200: 13, 300: 14, 1000: 15, -5: 16,
+                    5000: 17, -30000: 19}.get(a, 1003)
+
+        def call(name, *args):
+            bench.reset()
+            d = bench.call(name, tuple(v & 0xFFFF for v in args)).d
+            return d - 0x10000 if d & 0x8000 else d
+
+        for v in (-30000, -5, -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 100, 259, 300, 1000, 5000):
+            assert call("_tab", v) == tab(v), v
+            assert call("_tree", v) == tree(v), v
+        assert call("_var", 7, 3) == 70
+        assert call("_var", 3, 3) == 99
+        assert call("_var", 0, 5) == 5
+
+
+# =============================================================================
+# Inlining and Leaf Function Tests
+# =============================================================================
+
+INLINE_PROGRAM = """
+int g;
+int tab[4];
+int twice(int a) { return a + a; }
+char low(int v) { return v; }
+int second(int *p) { return p[1]; }
+void setg(int v) { g = v; }
+int sq(char c) { return c * c; }
+int fact(int n) { if (n < 2) return 1; return n * fact(n - 1); }
+int loop(int x, int y) { int i; int m; m = 0;
+    for (i = 0; i < 5; i++) { m = max(m, i + x); }
+    return m + min(x, y) * 3 - abs(x - y); }
+int mix(int x, int y) { int *p; tab[1] = y; p = tab; setg(twice(x));
+    return second(p) + second(tab) + low(x + 300) + g + twice(max(x, 2)) + sq(x + 1); }
+int shadow(int x, int y) { int g; g = 1; setg(x); return g + fact(3) + max(max(x, y + 1), abs(y)); }
+"""
+
+
+def _function_lines(source: str, name: str, opt_level: int = 2) -> list:
+    """Instruction lines of one function at an optimization level."""
+    asm = CodeGenerator(opt_level=opt_level).generate(parse_source(source))
+    lines = []
+    for line in asm.split(f"\n_{name}:\n", 1)[1].splitlines():
+        if line.startswith(("; Function:", "; ---")):
+            break
+        if line.startswith("        ") and not line.strip().startswith(";"):
+            lines.append(" ".join(line.split()))
+    return lines
+
+
+class TestInlining:
+    """Tests for function inlining and frameless leaf functions (opt_level 2)."""
+
+    def test_small_function_inlined(self):
+        """A one-expression function costs no call at level 2."""
+        source = "int add3(int a) { return a + 3; } int f(int x) { return add3(x); }"
+        assert "JSR _add3" in _function_lines(source, "f", opt_level=1)
+        lines = _function_lines(source, "f")
+        assert "JSR _add3" not in lines
+        assert "ADDD #3" in lines
+
+    def test_runtime_helpers_inlined(self):
+        """abs(), min() and max() from the runtime are inlined too."""
+        lines = _function_lines("int f(int a, int b) { return max(a, b) + min(a, abs(b)); }", "f")
+        assert not any(l.startswith("JSR") for l in lines)
+
+    def test_own_definition_wins(self):
+        """A program's own max() is inlined instead of the runtime's."""
+        lines = _function_lines("int max(int a, int b) { return 7; } "
+                                "int f(int a, int b) { return max(a, b); }", "f")
+        assert "LDD #7" in lines
+        assert "SUBD 0,X" not in lines
+
+    def test_argument_used_twice_evaluated_once(self):
+        """An expression argument for a parameter used twice is pushed once."""
+        lines = _function_lines("int sq(int c) { return c * c; } "
+                                "int f(int x) { return sq(x + 1); }", "f")
+        assert "JSR _sq" not in lines
+        assert lines.count("ADDD #1") == 1
+        assert lines.count("PSHB") == 1
+
+    def test_side_effect_argument_keeps_call(self):
+        """An argument with side effects is not moved into the body."""
+        lines = _function_lines("int f(int x) { return max(x++, 3); }", "f")
+        assert "JSR _max" in lines
+
+    def test_shadowed_global_keeps_call(self):
+        """A caller's local with the name of a global used by the body blocks inlining."""
+        source = "int g; void setg(int v) { g = v; } int f(int x) { int g; setg(x); return g; }"
+        assert "JSR _setg" in _function_lines(source, "f")
+
+    def test_array_for_pointer_keeps_call(self):
+        """An array passed for a pointer parameter is not substituted."""
+        source = "int tab[3]; int second(int *p) { return p[1]; } int f() { return second(tab); }"
+        assert "JSR _second" in _function_lines(source, "f")
+
+    def test_leaf_function_has_no_frame(self):
+        """A function that calls nothing and has no locals skips PSHX/TSX/PULX."""
+        source = "int add(int a, int b) { return a + b; }"
+        lines = _function_lines(source, "add")
+        assert "PSHX" not in lines and "PULX" not in lines
+        assert lines[:3] == ["TSX", "LDD 2,X", "ADDD 4,X"]
+        assert lines[-1] == "RTS"
+        assert "PSHX" in _function_lines(source, "add", opt_level=1)
+
+    def test_inlined_calls_leave_a_leaf(self):
+        """Calls that are inlined do not stop a function being a leaf."""
+        lines = _function_lines("int f(int a, int b) { return max(a, b); }", "f")
+        assert "PSHX" not in lines
+
+    def test_non_leaf_keeps_frame(self):
+        """Functions with calls or locals still get a frame."""
+        assert "PSHX" in _function_lines("int f(int a) { return strlen(a); }", "f")
+        assert "PSHX" in _function_lines("int f(int a) { int t; t = a; return t; }", "f")
+
+    def test_call_to_leaf_reloads_frame_pointer(self):
+        """A frameless callee does not restore X, so the caller reloads it."""
+        lines = _function_lines("""
+            int peek(int *p) { return *p + p[1] + p[2] + p[3] + p[4] + p[5]; }
+            int f(int *q) { int t; t = peek(q); return t + 1; }
+        """, "f")
+        call = lines.index("JSR _peek")
+        assert "TSX" in lines[call:call + 6]
+
+    def test_char_parameter_is_low_byte(self):
+        """Every argument is pushed as a word; a char is its low byte."""
+        lines = _function_lines("int f(char a, int b) { return b + a; }", "f", opt_level=1)
+        assert "LDAB 5,X" in lines or "ADDB 5,X" in lines
+        assert "LDD 6,X" in lines
+
+    def test_level_zero_is_stack_code(self):
+        """opt_level 0 turns register-aware code generation off."""
+        source = "int f(int a, int b) { return a + b; }"
+        plain = SmallCCompiler(CompilerOptions(opt_level=0)).compile_source(source).assembly
+        default = SmallCCompiler(CompilerOptions()).compile_source(source).assembly
+        assert plain.count("TSX") > default.count("TSX")
+
+    def test_inlined_results_match_calls(self, tmp_path):
+        """Level 2 computes what level 1 computes, in fewer cycles."""
+        from pathlib import Path
+        import shutil
+        from psion_sdk.testkit.benchmark import RuntimeBenchmark
+
+        include = Path(__file__).parent.parent / "include"
+        runs = {}
+        for level in (1, 2):
+            build = tmp_path / f"O{level}"
+            build.mkdir()
+            for inc in include.glob("*.inc"):
+                shutil.copy(inc, build)
+            asm = CodeGenerator(emit_runtime=False, opt_level=level).generate(
+                parse_source(INLINE_PROGRAM))
+            (build / "prog.inc").write_text("\n".join(
+                l for l in asm.splitlines()
+                if "INCLUDE" not in l and ".MODEL" not in l and l.strip() != "END"))
+            bench = RuntimeBenchmark(("runtime.inc", "prog.inc"), include_dir=build)
+            results, cycles = [], 0
+            for name in ("_loop", "_mix", "_shadow"):
+                for x, y in ((0, 0), (3, -4), (-7, 2), (100, 255), (-300, 9)):
+                    bench.reset()
+                    r = bench.call(name, (x & 0xFFFF, y & 0xFFFF))
+                    results.append(r.d)
+                    cycles += r.cycles
+            runs[level] = (results, cycles)
+        assert runs[2][0] == runs[1][0]
+        assert runs[2][1] < runs[1][1] * 0.85
+
+
+# =============================================================================
+# Constant Propagation and Strength Reduction Tests
+# =============================================================================
+
+STRENGTH_PROGRAM = """
+struct P { int x; int y; int z; };
+struct P pts[8];
+const int N = 8;
+int fill(int s, int k) {
+    int i; int t;
+    for (i = 0; i < N; i++) { pts[i].x = i * s; pts[i].y = i + k; pts[i].z = 0; }
+    t = 0;
+    for (i = 0; i < N; i++) { t += pts[i].x + pts[i].y; pts[i].z = t; }
+    for (i = N - 1; i >= 0; i -= 2) t = t + pts[i].z;
+    return t;
+}
+int comp(int x, int y) {
+    x *= 3; x += y; x -= 1; x &= 0x7FF; x |= 0x100; x ^= y; x <<= 2; x >>= 1;
+    if (y != 0) { x %= y; }
+    return x;
+}
+int mul(int x, int y) { return x * 10 + 7 * x - x * 3 + x * -5 + x * 1000 + y % 10; }
+"""
+
+
+def _s16(value: int) -> int:
+    value &= 0xFFFF
+    return value - 0x10000 if value & 0x8000 else value
+
+
+def _strength_expected(name: str, x: int, y: int) -> int:
+    """What STRENGTH_PROGRAM's functions return, computed in Python."""
+    if name == "_fill":
+        pts = [[_s16(i * x), _s16(i + y), 0] for i in range(8)]
+        t = 0
+        for i in range(8):
+            t = _s16(t + pts[i][0] + pts[i][1])
+            pts[i][2] = t
+        for i in range(7, -1, -2):
+            t = _s16(t + pts[i][2])
+        return t & 0xFFFF
+    if name == "_comp":
+        v = _s16(_s16(x * 3) + y - 1) & 0x7FF | 0x100
+        v = _s16(_s16(v ^ y) << 2) >> 1
+        if y:
+            v = int(abs(v) % abs(y) * (1 if v >= 0 else -1))
+        return v & 0xFFFF
+    rem = int(abs(y) % 10 * (1 if y >= 0 else -1))
+    return (x * 10 + 7 * x - x * 3 + x * -5 + x * 1000 + rem) & 0xFFFF
+
+
+class TestStrengthReduction:
+    """Tests for const globals, whole-expression folding and cheap multiplies."""
+
+    def test_signed_division_folds_signed(self):
+        """-6 / 2 folds to -3, as the generated code computes it."""
+        lines = _function_lines("int f() { return -6 / 2 + (-7 % 2); }", "f", opt_level=1)
+        assert "LDD #65532" in lines
+
+    def test_unsigned_division_folds_unsigned(self):
+        """An unsigned dividend folds with unsigned division."""
+        lines = _function_lines("int f() { return (unsigned)-6 / 2; }", "f", opt_level=1)
+        assert "LDD #32765" in lines
+
+    def test_const_globals_fold(self):
+        """A const global with a constant initializer is a constant."""
+        source = """
+            struct E { int a; char b; };
+            const int N = 4, M = N * 3;
+            int f() { return M + sizeof(struct E) * N + (N > 2 ? 1 : 2); }
+        """
+        asm = CodeGenerator().generate(parse_source(source))
+        assert "LDD     #25" in asm
+        assert "LDD     _M" not in asm
+        assert "FDB     12" in asm  # Storage still holds the value
+
+    def test_define_expressions_fold(self):
+        """#define expressions fold like any other constant."""
+        source = "#define W 10\n#define H (W * 2)\nint f() { return W * H + 1; }"
+        asm = SmallCCompiler(CompilerOptions()).compile_source(source).assembly
+        assert "LDD     #201" in asm
+
+    def test_assign_to_const_is_error(self):
+        """A const global cannot be assigned or incremented."""
+        for body in ("N = 5;", "N++;", "N += 1;"):
+            with pytest.raises(CCodeGenError, match="const"):
+                CodeGenerator().generate(parse_source(
+                    f"const int N = 4; void main() {{ {body} }}"))
+
+    def test_const_without_constant_initializer_is_variable(self):
+        """const on a pointer qualifies what it points to; p is a variable."""
+        asm = CodeGenerator().generate(parse_source(
+            'const char *p; void main() { p = "hi"; }'))
+        assert "STD     _p" in asm
+
+    def test_multiply_either_side_shift_add(self):
+        """Constant multipliers on either side avoid __mul16."""
+        lines = _function_lines("int f(int x) { return 10 * x + x * 7 + x * -3; }", "f",
+                                opt_level=1)
+        assert "JSR __mul16" not in lines
+        assert "SUBD 4,X" in lines      # x * 7 = (x << 3) - x
+        assert "COMA" in lines          # x * -3 is negated
+
+    def test_multiplier_with_many_bits_uses_mul16(self):
+        """Constants needing more than MAX_MULTIPLY_ADDS additions call __mul16."""
+        lines = _function_lines("int f(int x) { return x * 0x5555; }", "f", opt_level=1)
+        assert "JSR __mul16" in lines
+
+    def test_constant_shifts_inline(self):
+        """Shifts by a constant are ASLD, ASRA/RORB or LSRD in line."""
+        lines = _function_lines("int f(int x) { unsigned u; u = x; "
+                                "return (x << 9) + (x >> 2) + (u >> 1); }", "f", opt_level=1)
+        assert not any("__shl16" in l or "__shr16" in l for l in lines)
+        assert lines.count("TBA") == 1 and lines.count("ASLD") == 1
+        assert lines.count("ASRA") == 2 and lines.count("LSRD") == 1
+
+    def test_struct_array_index_scaled(self):
+        """Indexes into arrays of 6-byte structs are multiplied by 6."""
+        lines = _function_lines("struct P { int x; int y; int z; }; struct P a[4]; "
+                                "int f(int i) { return a[i].y; }", "f", opt_level=1)
+        assert lines[2:9] == ["LDD 4,X", "ASLD", "ADDD 4,X", "ASLD",
+                              "ADDD #_a", "XGDX", "LDD 2,X"]
+
+    def test_compound_target_with_side_effects_rejected(self):
+        """x op= v evaluates x twice, so x must be free of side effects."""
+        with pytest.raises(CCodeGenError, match="side effects"):
+            CodeGenerator().generate(parse_source(
+                "int t[4]; void main() { int i; i = 0; t[i++] += 2; }"))
+
+    def test_loop_counter_kept_scaled(self):
+        """At level 2 a counter indexing struct arrays is kept multiplied."""
+        assert "ADDD #6" not in _function_lines(STRENGTH_PROGRAM, "fill", opt_level=1)
+        lines = _function_lines(STRENGTH_PROGRAM, "fill")
+        assert lines.count("ADDD #6") == 2       # i++ loops step the copy by 6
+        # The i -= 2 loop indexes once per pass, which is cheaper to scale
+        assert "ADDD #65524" not in lines
+
+    def test_results_match_python(self, tmp_path):
+        """Every level computes the C results; level 2 needs fewer cycles."""
+        from pathlib import Path
+        import shutil
+        from psion_sdk.testkit.benchmark import RuntimeBenchmark
+
+        include = Path(__file__).parent.parent / "include"
+        cycles = {}
+        for level in (0, 1, 2):
+            build = tmp_path / f"O{level}"
+            build.mkdir()
+            for inc in include.glob("*.inc"):
+                shutil.copy(inc, build)
+            asm = CodeGenerator(emit_runtime=False, opt_level=level).generate(
+                parse_source(STRENGTH_PROGRAM))
+            (build / "prog.inc").write_text("\n".join(
+                l for l in asm.splitlines()
+                if "INCLUDE" not in l and ".MODEL" not in l and l.strip() != "END"))
+            bench = RuntimeBenchmark(("runtime.inc", "prog.inc"), include_dir=build)
+            cycles[level] = 0
+            for name in ("_fill", "_comp", "_mul"):
+                for x, y in ((0, 0), (3, -4), (-7, 2), (100, 255), (-300, 9), (32767, 7)):
+                    bench.reset()
+                    r = bench.call(name, (x & 0xFFFF, y & 0xFFFF))
+                    assert r.d == _strength_expected(name, x, y), (level, name, x, y)
+                    cycles[level] += r.cycles
+        assert cycles[2] < cycles[1] < cycles[0]
@@ -14,17 +14,21 @@
 #   - Compilation tests: Verify C code using these functions compiles
 #   - Assembly tests: Verify stdio.inc assembles correctly
 #   - Assembly behavior tests: Test assembly logic patterns
+#   - Result tests: Run sprintf on the emulator and check the output
 #   - Integration tests: End-to-end compile + assemble pipeline
 #
 # Copyright (c) 2025 Hugo José Pinto & Contributors
 # =============================================================================
 
+import struct
+
 import pytest
 from pathlib import Path
 
 from psion_sdk.assembler import Assembler
 from psion_sdk.smallc.compiler import SmallCCompiler, CompilerOptions
 from psion_sdk.errors import AssemblerError
+from psion_sdk.testkit.benchmark import RuntimeBenchmark, DATA_BASE
 
 
 # =============================================================================
@@ -50,6 +54,34 @@ def assembler():
     return Assembler(include_paths=[str(INCLUDE_DIR)])
 
 
+@pytest.fixture(scope="module")
+def bench():
+    """Load runtime.inc and stdio.inc into the emulator (no boot needed)."""
+    return RuntimeBenchmark(("runtime.inc", "stdio.inc"))
+
+
+# Output buffer, format string, string and long arguments
+BUF = DATA_BASE
+FMT = DATA_BASE + 0x100
+TEXT = DATA_BASE + 0x200
+LONG = DATA_BASE + 0x300
+
+
+def run_sprintf(bench, fmt: str, *args, routine: str = "_sprintf") -> str:
+    """Run sprintf(BUF, fmt, args...) and return the text it wrote."""
+    bench.emulator.write_bytes(FMT, fmt.encode("ascii") + b"\0")
+    result = bench.call(routine, (BUF, FMT) + tuple(a & 0xFFFF for a in args))
+    text = bytes(bench.emulator.read_bytes(BUF, 80)).split(b"\0")[0]
+    assert result.d == len(text)
+    return text.decode("ascii")
+
+
+def long_arg(bench, value: int) -> int:
+    """Store a 32-bit value for %ld and return its address."""
+    bench.emulator.write_bytes(LONG, struct.pack(">I", value & 0xFFFFFFFF))
+    return LONG
+
+
 def compile_c(source: str, compiler) -> str:
     """Compile C source to assembly."""
     result = compiler.compile_source(source, "test.c")
@@ -544,6 +576,71 @@ FMT1:       FCC "N=%d"
         assert result is not None
 
 
+# =============================================================================
+# sprintf Result Tests
+# =============================================================================
+
+class TestSprintfResults:
+    """Run sprintf on the emulator and compare with C printf."""
+
+    @pytest.mark.parametrize("fmt,args,expected", [
+        ("Hello", (), "Hello"),
+        ("", (), ""),
+        ("%d", (42,), "42"),
+        ("%d", (0,), "0"),
+        ("Score: %d", (-12345,), "Score: -12345"),
+        ("%d", (-32768,), "-32768"),
+        ("%u", (65535,), "65535"),
+        ("%x", (255,), "ff"),
+        ("%X", (0xBEEF,), "BEEF"),
+        ("%04x", (255,), "00ff"),
+        ("%c%c", (65, 66), "AB"),
+        ("100%%", (), "100%"),
+    ])
+    def test_conversions(self, bench, fmt, args, expected):
+        assert run_sprintf(bench, fmt, *args) == expected
+
+    def test_string(self, bench):
+        bench.emulator.write_bytes(TEXT, b"abc\0")
+        assert run_sprintf(bench, "%s=%d", TEXT, 1234) == "abc=1234"
+        assert run_sprintf(bench, "[%8s]", TEXT) == "[     abc]"
+        assert run_sprintf(bench, "[%-8s]", TEXT) == "[abc     ]"
+
+    @pytest.mark.parametrize("fmt,value,expected", [
+        ("[%5d]", 42, "[   42]"),
+        ("[%-5d]", 42, "[42   ]"),
+        ("[%05d]", -42, "[-0042]"),
+        ("[%12d]", 7, "[           7]"),
+        ("[%2d]", 12345, "[12345]"),
+    ])
+    def test_width_and_flags(self, bench, fmt, value, expected):
+        assert run_sprintf(bench, fmt, value) == expected
+
+    def test_any_number_of_args(self, bench):
+        assert run_sprintf(bench, "%d %d %d %d %d %d", 1, 2, 3, 4, 5, 6) == "1 2 3 4 5 6"
+
+    @pytest.mark.parametrize("fmt,value,expected", [
+        ("%ld", 123456789, "123456789"),
+        ("%ld", -2147483648, "-2147483648"),
+        ("%ld", 65536, "65536"),
+        ("%ld", -1, "-1"),
+        ("%lu", 4294967295, "4294967295"),
+        ("%lx", 0xDEADBEEF, "deadbeef"),
+        ("%lX", 0x1000F, "1000F"),
+        ("%010ld", -1000000, "-001000000"),
+    ])
+    def test_long(self, bench, fmt, value, expected):
+        assert run_sprintf(bench, fmt, long_arg(bench, value)) == expected
+
+    def test_unknown_specifier_skipped(self, bench):
+        assert run_sprintf(bench, "%q%d", 5) == "5"
+        assert run_sprintf(bench, "%d%", 5) == "5"
+
+    def test_variants_share_sprintf(self, bench):
+        assert run_sprintf(bench, "N=%d", 9, routine="_sprintf1") == "N=9"
+        assert run_sprintf(bench, "%d+%d=%d", 1, 2, 3, routine="_sprintf3") == "1+2=3"
+
+
 # =============================================================================
 # Integration Tests
 # =============================================================================
@@ -648,8 +745,8 @@ class TestAssemblyQuality:
         assert result is not None
 
     def test_sprintf_uses_itoa(self, assembler):
-        """sprintf for %d should reference itoa internal."""
-        # The sprintf implementation should call _itoa_internal for %d
+        """sprintf for %d should assemble with the shared formatter."""
+        # The sprintf implementation writes %d through __fmt_dec (runtime.inc)
         source = """
             INCLUDE "psion.inc"
             INCLUDE "runtime.inc"
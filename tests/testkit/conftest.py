@@ -21,9 +21,11 @@ from psion_sdk.testkit.fixtures import (
     test_config,
     fresh_emulator,
     booted_emulator,
+    booted_fork,
     psion_ctx,
     unbooted_ctx,
     compiled_program,
+    pytest_addoption,
     pytest_configure,
     pytest_collection_modifyitems,
 )
@@ -34,6 +36,7 @@ __all__ = [
     "test_config",
     "fresh_emulator",
     "booted_emulator",
+    "booted_fork",
     "psion_ctx",
     "unbooted_ctx",
     "compiled_program",
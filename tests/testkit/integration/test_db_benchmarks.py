@@ -0,0 +1,163 @@
+"""
+Integration Tests - Database Benchmarks
+=======================================
+
+Cycle and code-size benchmarks for the routines in include/dbruntime.inc,
+checked against the baseline in db_benchmarks.json.
+
+The DB routines call the ROM FL$ file services, so they run on an
+emulator booted to the main menu, with a data file created on A: (RAM)
+for each case. Cycles include the ROM services but not the interrupt
+handlers that run meanwhile.
+
+To accept new numbers after an optimization, rewrite the baseline:
+
+    PSION_BENCH_UPDATE=1 pytest -m testkit tests/testkit/integration/test_db_benchmarks.py
+
+Copyright (c) 2025-2026 Hugo José Pinto & Contributors
+"""
+
+import pytest
+from pathlib import Path
+
+from psion_sdk.opk import PackBuilder
+from psion_sdk.testkit.benchmark import (
+    BenchmarkBaseline,
+    BenchmarkCase,
+    RuntimeBenchmark,
+    DATA_BASE,
+)
+
+
+pytestmark = pytest.mark.testkit
+
+BASELINE_PATH = Path(__file__).parent / "db_benchmarks.json"
+
+# File name, schema and field names, value buffer, record blocks
+NAME = DATA_BASE
+SCHEMA = DATA_BASE + 0x10
+F_NAME = DATA_BASE + 0x30
+F_AGE = DATA_BASE + 0x38
+VALUE = DATA_BASE + 0x40
+KEY = DATA_BASE + 0x48
+BLOCK = DATA_BASE + 0x100
+OUT = DATA_BASE + 0x400
+
+RECORDS = [b"user%d\t%d" % (i, i * 7) for i in range(10)]
+RECORD_BLOCK = b"".join(bytes([len(r)]) + r for r in RECORDS)
+
+STRINGS = {
+    NAME: b"BENCH\x00",
+    SCHEMA: b"name$,age%\x00",
+    F_NAME: b"name\x00",
+    F_AGE: b"age\x00",
+    VALUE: b"user0\x00",
+    KEY: b"user7\x00",
+    BLOCK: RECORD_BLOCK,
+}
+
+CREATE = ("_db_create", (ord("A"), NAME, SCHEMA))
+FILLED = (CREATE, ("_db_append_many", (BLOCK, len(RECORDS))), ("_db_first", ()))
+INDEXED = FILLED + (("_db_index_build", (0, 1)),)
+
+
+def db_cases() -> list:
+    """Writing, reading and field access on a ten-record file."""
+    built = (CREATE, ("_db_clear", ()), ("_db_set_str", (F_NAME, VALUE)),
+             ("_db_set_int", (F_AGE, 0)))
+    loaded = FILLED + (("_db_read", ()),)
+    return [
+        BenchmarkCase("db_set_str", "_db_set_str", args=(F_NAME, VALUE),
+                      memory=STRINGS, prepare=(CREATE, ("_db_clear", ())), expect_d=0),
+        BenchmarkCase("db_append", "_db_append", memory=STRINGS,
+                      prepare=built, expect_d=0),
+        BenchmarkCase("db_append_many/10", "_db_append_many", args=(BLOCK, len(RECORDS)),
+                      memory=STRINGS, prepare=(CREATE,), expect_d=len(RECORDS)),
+        BenchmarkCase("db_read", "_db_read", memory=STRINGS,
+                      prepare=FILLED, expect_d=0),
+        BenchmarkCase("db_next", "_db_next", memory=STRINGS,
+                      prepare=FILLED, expect_d=0),
+        BenchmarkCase("db_read_block/10", "_db_read_block", args=(OUT, 0x200),
+                      memory=STRINGS, prepare=FILLED, expect_d=len(RECORDS),
+                      expect_memory={OUT: RECORD_BLOCK}),
+        BenchmarkCase("db_get_str/name", "_db_get_str", args=(F_NAME, OUT, 16),
+                      memory=STRINGS, prepare=loaded, expect_d=0,
+                      expect_memory={OUT: b"user0\x00"}),
+        BenchmarkCase("db_get_int/age", "_db_get_int", args=(F_AGE,),
+                      memory=STRINGS, prepare=FILLED + (("_db_next", ()), ("_db_read", ())),
+                      expect_d=7),
+        BenchmarkCase("db_load_rec", "_db_load_rec", args=(BLOCK,),
+                      memory=STRINGS, prepare=(CREATE,), expect_d=len(RECORDS[0]) + 1),
+        BenchmarkCase("db_count/10", "_db_count", memory=STRINGS,
+                      prepare=FILLED, expect_d=len(RECORDS)),
+        BenchmarkCase("db_index_build/10", "_db_index_build", args=(0, 1),
+                      memory=STRINGS, prepare=FILLED, expect_d=0, max_cycles=10_000_000),
+        BenchmarkCase("db_seek_key/10", "_db_seek_key", args=(KEY,),
+                      memory=STRINGS, prepare=INDEXED, expect_d=0, max_cycles=10_000_000),
+    ]
+
+
+def test_db_benchmarks():
+    """No DB routine is slower or larger than its baseline."""
+    bench = RuntimeBenchmark(("runtime.inc", "dbruntime.inc"), booted=True)
+    results = bench.run(db_cases())
+
+    BenchmarkBaseline.check(results, BASELINE_PATH)
+
+
+def test_db_seek_key_finds_first_record():
+    """db_seek_key moves to the first record with a key, and sees new records."""
+    bench = RuntimeBenchmark(("runtime.inc", "dbruntime.inc"), booted=True)
+    emu = bench.emulator
+    names = [b"user%d" % (i * 7 % 5) for i in range(20)]
+    records = b"".join(bytes([len(n) + 2]) + n + b"\t%d" % (i % 10)
+                       for i, n in enumerate(names))
+    for address, data in STRINGS.items():
+        emu.write_bytes(address, data)
+    emu.write_bytes(BLOCK, records)
+    call = lambda routine, *args: bench.call(routine, args, max_cycles=20_000_000).d
+
+    def seek(key: bytes) -> int:
+        emu.write_bytes(KEY, key + b"\x00")
+        return call("_db_seek_key", KEY)
+
+    assert call("_db_create", ord("A"), NAME, SCHEMA) == 0
+    assert seek(b"user1") == 5                          # DB_E_INV: no index
+    assert call("_db_append_many", BLOCK, len(names)) == len(names)
+    assert call("_db_index_build", 0, 17) == 11          # DB_E_FLD
+    assert call("_db_index_build", 0, 1) == 0
+
+    for key in set(names):
+        assert seek(key) == 0
+        assert call("_db_pos") == names.index(key) + 1
+    assert seek(b"user") == 1                           # DB_E_NFND
+    assert seek(b"zzz") == 1
+
+    # A new record is found after the lazy rebuild
+    call("_db_clear")
+    call("_db_set_str", F_NAME, KEY)
+    assert call("_db_append") == 0
+    assert seek(b"zzz") == 0
+    assert call("_db_pos") == len(names) + 1
+
+
+def test_db_reads_data_file_built_on_host(tmp_path):
+    """A data file PackBuilder writes is read by db_open on B:."""
+    rows = [("user%d" % i, i * 7) for i in range(300)]
+    pack = tmp_path / "REF.opk"
+    PackBuilder(size_kb=32).add_data_file("BENCH", rows).build_to_file(pack)
+
+    bench = RuntimeBenchmark(("runtime.inc", "dbruntime.inc"), booted=True)
+    emu = bench.emulator
+    emu.load_opk(pack, slot=0)
+    for address, data in STRINGS.items():
+        emu.write_bytes(address, data)
+    call = lambda routine, *args: bench.call(routine, args, max_cycles=20_000_000).d
+
+    assert call("_db_open", ord("B"), NAME, SCHEMA) == 0
+    assert call("_db_count") == len(rows)
+    assert call("_db_first") == 0
+    for _ in range(len(rows) - 1):
+        call("_db_next")
+    assert call("_db_read") == 0
+    assert call("_db_get_int", F_AGE) == rows[-1][1]
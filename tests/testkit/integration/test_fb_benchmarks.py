@@ -0,0 +1,210 @@
+"""
+Integration Tests - Frame Buffer Display and Benchmarks
+=======================================================
+
+Runs the routines in include/fbruntime.inc on an emulator booted to the
+main menu, where fb_flush can call the ROM display routines:
+
+- What fb_flush puts on the display, and with how many DP_PRNT calls
+- Cycle and code-size benchmarks, checked against fb_benchmarks.json
+- A one-field update through the frame buffer against redrawing the
+  screen with at()
+
+To accept new numbers after an optimization, rewrite the baseline:
+
+    PSION_BENCH_UPDATE=1 pytest -m testkit tests/testkit/integration/test_fb_benchmarks.py
+
+Copyright (c) 2025-2026 Hugo José Pinto & Contributors
+"""
+
+import pytest
+from pathlib import Path
+
+from psion_sdk.testkit.benchmark import (
+    BenchmarkBaseline,
+    BenchmarkCase,
+    RuntimeBenchmark,
+    DATA_BASE,
+)
+
+
+pytestmark = pytest.mark.testkit
+
+BASELINE_PATH = Path(__file__).parent / "fb_benchmarks.json"
+
+# String arguments
+TEXT = DATA_BASE
+TEXT2 = DATA_BASE + 0x40
+
+
+def put(bench, col: int, row: int, text: str) -> None:
+    """fb_put(col, row, text)."""
+    bench.emulator.write_bytes(TEXT, text.encode("ascii") + b"\0")
+    bench.call("_fb_put", (col, row, TEXT))
+
+
+def flush(bench) -> int:
+    """fb_flush(); returns the number of DP_PRNT calls."""
+    return bench.call("_fb_flush").d
+
+
+@pytest.fixture(scope="module")
+def xp():
+    return RuntimeBenchmark(("runtime.inc", "fbruntime.inc"), booted=True)
+
+
+@pytest.fixture(scope="module")
+def lz():
+    return RuntimeBenchmark(("runtime.inc", "fbruntime.inc"), booted=True, model="LZ")
+
+
+# ═══════════════════════════════════════════════════════════════════════════════
+# DISPLAY
+# ═══════════════════════════════════════════════════════════════════════════════
+
+
+class TestFlushDisplay:
+    """fb_flush shows the frame, and sends only what changed."""
+
+    def test_first_flush_draws_everything(self, xp):
+        xp.reset()
+        xp.call("_fb_begin")
+        put(xp, 0, 0, "Hello world")
+        put(xp, 10, 1, "ABCDEF")
+        assert flush(xp) == 1
+        assert xp.emulator.display_lines == ["Hello world     ", "          ABCDEF"]
+
+    def test_unchanged_frame_prints_nothing(self, xp):
+        xp.reset()
+        xp.call("_fb_begin")
+        put(xp, 0, 0, "Hello")
+        flush(xp)
+        xp.call("_fb_begin")
+        put(xp, 0, 0, "Hello")
+        assert flush(xp) == 0
+        assert xp.emulator.display_lines == ["Hello           ", " " * 16]
+
+    def test_runs(self, xp):
+        xp.reset()
+        xp.call("_fb_begin")
+        put(xp, 0, 0, "Hello world")
+        flush(xp)
+        # One unchanged cell between changes is printed, two start a run
+        put(xp, 1, 0, "a-l")
+        assert flush(xp) == 1
+        put(xp, 1, 0, "b")
+        put(xp, 4, 0, "c")
+        assert flush(xp) == 2
+        assert xp.emulator.display_lines == ["Hb-lc world     ", " " * 16]
+
+    def test_run_wraps_to_next_row(self, xp):
+        xp.reset()
+        xp.call("_fb_begin")
+        flush(xp)
+        put(xp, 14, 0, "AB")
+        put(xp, 0, 1, "CD")
+        assert flush(xp) == 1
+        assert xp.emulator.display_lines == [" " * 14 + "AB", "CD" + " " * 14]
+
+    def test_last_cell_does_not_scroll(self, xp):
+        xp.reset()
+        xp.call("_fb_begin")
+        put(xp, 0, 0, "Top")
+        flush(xp)
+        xp.call("_fb_putc", (15, 1, ord("*")))
+        assert flush(xp) == 1
+        assert xp.emulator.display_lines == ["Top             ", " " * 15 + "*"]
+
+    def test_invalidate_redraws(self, xp):
+        xp.reset()
+        xp.call("_fb_begin")
+        put(xp, 0, 0, "Frame")
+        flush(xp)
+        xp.call("_cls")
+        xp.call("_fb_invalidate")
+        assert flush(xp) == 1
+        assert xp.emulator.display_lines == ["Frame           ", " " * 16]
+
+    def test_four_line_display(self, lz):
+        lz.reset()
+        lz.call("_fb_begin")
+        for row in range(4):
+            put(lz, 0, row, f"Line {row} of the LZ screen")
+        assert flush(lz) == 1
+        put(lz, 5, 1, "ABC")
+        put(lz, 18, 2, "zz")
+        put(lz, 0, 3, "Q")
+        assert flush(lz) == 2
+        assert lz.emulator.display_lines == [
+            "Line 0 of the LZ scr",
+            "Line ABCf the LZ scr",
+            "Line 2 of the LZ szz",
+            "Qine 3 of the LZ scr",
+        ]
+
+
+# ═══════════════════════════════════════════════════════════════════════════════
+# BENCHMARKS
+# ═══════════════════════════════════════════════════════════════════════════════
+
+
+def fb_cases() -> list:
+    """Drawing and flushing a 2x16 status screen."""
+    status = {TEXT: b"Counter: 41\0", TEXT2: b"Counter: 42\0"}
+    drawn = (("_fb_begin", ()), ("_fb_put", (0, 0, TEXT)), ("_fb_flush", ()))
+    return [
+        BenchmarkCase("fb_begin", "_fb_begin"),
+        BenchmarkCase("fb_put/11", "_fb_put", args=(0, 0, TEXT), memory=status),
+        BenchmarkCase("fb_putc", "_fb_putc", args=(15, 1, ord("*"))),
+        BenchmarkCase(
+            "fb_flush/first", "_fb_flush", memory=status,
+            prepare=drawn[:2], expect_d=1,
+        ),
+        BenchmarkCase(
+            "fb_flush/unchanged", "_fb_flush", memory=status,
+            prepare=drawn, expect_d=0,
+        ),
+        BenchmarkCase(
+            "fb_flush/one_cell", "_fb_flush", memory=status,
+            prepare=drawn + (("_fb_put", (0, 0, TEXT2)),), expect_d=1,
+        ),
+        BenchmarkCase(
+            "fb_flush/two_runs", "_fb_flush", memory=status,
+            prepare=drawn + (("_fb_put", (0, 0, TEXT2)), ("_fb_put", (4, 1, TEXT2))),
+            expect_d=2,
+        ),
+    ]
+
+
+@pytest.fixture(scope="module")
+def results(xp):
+    return xp.run(fb_cases())
+
+
+def test_fb_benchmarks(results):
+    """No frame buffer routine is slower or larger than its baseline."""
+    BenchmarkBaseline.check(results, BASELINE_PATH)
+
+
+def test_update_beats_at_redraw(xp):
+    """Redrawing a status screen through the frame is cheaper than with at()."""
+    xp.reset()
+    xp.emulator.write_bytes(TEXT, b"Counter: 42     \0")
+    xp.emulator.write_bytes(TEXT2, b"Press a key     \0")
+    at_cycles = (xp.call("_at", (0, TEXT)).cycles
+                 + xp.call("_at", (16, TEXT2)).cycles)
+
+    xp.call("_fb_begin")
+    xp.call("_fb_put", (0, 0, TEXT))
+    xp.call("_fb_put", (0, 1, TEXT2))
+    xp.call("_fb_flush")
+    xp.emulator.write_bytes(TEXT, b"Counter: 43     \0")
+    fb_cycles = sum(xp.call(routine, args).cycles for routine, args in (
+        ("_fb_begin", ()),
+        ("_fb_put", (0, 0, TEXT)),
+        ("_fb_put", (0, 1, TEXT2)),
+        ("_fb_flush", ()),
+    ))
+    assert xp.emulator.display_lines == ["Counter: 43     ", "Press a key     "]
+    assert fb_cycles * 2 < at_cycles, (
+        f"frame buffer: {fb_cycles} cycles, at() redraw: {at_cycles} cycles")
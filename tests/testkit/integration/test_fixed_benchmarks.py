@@ -0,0 +1,150 @@
+"""
+Integration Tests - Fixed Point Benchmarks
+==========================================
+
+Cycle and code-size benchmarks for the routines in include/fixedruntime.inc,
+checked against the baseline in fixed_benchmarks.json, and against the
+floating point routines they replace (fp_benchmarks.json).
+
+The fixed point routines are integer code, but fx_to_fp and fx_from_fp
+call the ROM maths package, so all of them run on an emulator booted to
+the main menu.
+
+To accept new numbers after an optimization, rewrite the baseline:
+
+    PSION_BENCH_UPDATE=1 pytest -m testkit tests/testkit/integration/test_fixed_benchmarks.py
+
+Copyright (c) 2025-2026 Hugo José Pinto & Contributors
+"""
+
+import struct
+
+import pytest
+from pathlib import Path
+
+from psion_sdk.testkit.benchmark import (
+    BenchmarkBaseline,
+    BenchmarkCase,
+    RuntimeBenchmark,
+    DATA_BASE,
+)
+
+
+pytestmark = pytest.mark.testkit
+
+BASELINE_PATH = Path(__file__).parent / "fixed_benchmarks.json"
+FP_BASELINE_PATH = Path(__file__).parent / "fp_benchmarks.json"
+
+# Operands and result (8 bytes each, room for an fp_t), string buffer
+A = DATA_BASE
+B = DATA_BASE + 8
+R = DATA_BASE + 16
+TEXT = DATA_BASE + 0x100
+
+
+def fx(value: float) -> bytes:
+    """Q16.16 value as stored: integer word, then fraction word."""
+    return struct.pack(">i", round(value * 65536))
+
+
+def q8(value: float) -> int:
+    """Q8.8 value as a 16-bit argument."""
+    return round(value * 256) & 0xFFFF
+
+
+def fixed_cases() -> list:
+    """The fp benchmarks' cases in fixed point, plus the Q8.8 routines."""
+    cases = []
+    for n in (7, 1234, -30000):
+        cases.append(BenchmarkCase(
+            f"fx_from_int/{n}", "_fx_from_int", args=(A, n & 0xFFFF),
+            expect_memory={A: fx(n)},
+        ))
+    cases.append(BenchmarkCase(
+        "fx_from_str/3.14159", "_fx_from_str", args=(A, TEXT),
+        memory={TEXT: b"3.14159\x00"}, expect_memory={A: fx(3.14159)},
+    ))
+
+    for a, b in [(7, 5), (1234, 56), (30000, -29999)]:
+        cases.append(BenchmarkCase(
+            f"fx_add/{a}+{b}", "_fx_add", args=(R, A, B),
+            memory={A: fx(a), B: fx(b)}, expect_memory={R: fx(a + b)},
+        ))
+    for a, b in [(7, 5), (12.5, -3.25), (181, 181)]:
+        cases.append(BenchmarkCase(
+            f"fx_mul/{a}*{b}", "_fx_mul", args=(R, A, B),
+            memory={A: fx(a), B: fx(b)}, expect_memory={R: fx(a * b)},
+        ))
+    cases.append(BenchmarkCase(
+        "fx_sub/1234-56", "_fx_sub", args=(R, A, B),
+        memory={A: fx(1234), B: fx(56)}, expect_memory={R: fx(1178)},
+    ))
+    cases.append(BenchmarkCase(
+        "fx_div/1234/56", "_fx_div", args=(R, A, B),
+        memory={A: fx(1234), B: fx(56)}, expect_memory={R: fx(1234 / 56)},
+    ))
+    cases.append(BenchmarkCase(
+        "fx_cmp/1234,56", "_fx_cmp", args=(A, B),
+        memory={A: fx(1234), B: fx(56)}, expect_d=1,
+    ))
+    cases.append(BenchmarkCase(
+        "fx_neg/1234", "_fx_neg", args=(A,),
+        memory={A: fx(1234)}, expect_memory={A: fx(-1234)},
+    ))
+
+    for func in ("sqrt", "sin", "cos"):
+        cases.append(BenchmarkCase(
+            f"fx_{func}/2", f"_fx_{func}", args=(R, A), memory={A: fx(2)},
+        ))
+    cases[-3].expect_memory = {R: fx(2 ** 0.5)}
+
+    cases.append(BenchmarkCase(
+        "fx_to_str/1234/2dp", "_fx_to_str", args=(TEXT, A, 2),
+        memory={A: fx(1234)}, expect_memory={TEXT: b"1234.00\x00"},
+    ))
+    cases.append(BenchmarkCase(
+        "fx_to_fp/1234", "_fx_to_fp", args=(R, A), memory={A: fx(1234)},
+    ))
+    cases.append(BenchmarkCase(
+        "fx_from_fp/1234", "_fx_from_fp", args=(R, A),
+        prepare=(("_fp_from_int", (A, 1234)),), expect_memory={R: fx(1234)},
+    ))
+
+    cases.append(BenchmarkCase(
+        "q8_mul/1.5*-2.25", "_q8_mul", args=(q8(1.5), q8(-2.25)),
+        expect_d=q8(-3.375),
+    ))
+    cases.append(BenchmarkCase(
+        "q8_div/10/3", "_q8_div", args=(q8(10), q8(3)), expect_d=q8(10 / 3),
+    ))
+    for func in ("sqrt", "sin", "cos"):
+        cases.append(BenchmarkCase(
+            f"q8_{func}/2", f"_q8_{func}", args=(q8(2),),
+        ))
+    return cases
+
+
+@pytest.fixture(scope="module")
+def results():
+    bench = RuntimeBenchmark(("runtime.inc", "fpruntime.inc", "fixedruntime.inc"),
+                             booted=True)
+    return bench.run(fixed_cases())
+
+
+def test_fixed_benchmarks(results):
+    """No fixed point routine is slower or larger than its baseline."""
+    BenchmarkBaseline.check(results, BASELINE_PATH)
+
+
+def test_fixed_faster_than_fp(results):
+    """Every fx_ case with an fp_ benchmark of the same name beats it."""
+    fp = BenchmarkBaseline.load(FP_BASELINE_PATH).entries
+    compared = 0
+    for result in results:
+        entry = fp.get("fp_" + result.name[3:])
+        if result.name.startswith("fx_") and entry is not None:
+            compared += 1
+            assert result.cycles < entry.cycles, (
+                f"{result.name}: {result.cycles} cycles, fp {entry.cycles}"
+            )
+    assert compared >= 10
@@ -0,0 +1,110 @@
+"""
+Integration Tests - Floating Point Benchmarks
+=============================================
+
+Cycle and code-size benchmarks for the routines in include/fpruntime.inc,
+checked against the baseline in fp_benchmarks.json.
+
+The FP routines call the ROM maths package, so they run on an emulator
+booted to the main menu. Cycles include the ROM services but not the
+interrupt handlers that run meanwhile.
+
+To accept new numbers after an optimization, rewrite the baseline:
+
+    PSION_BENCH_UPDATE=1 pytest -m testkit tests/testkit/integration/test_fp_benchmarks.py
+
+Copyright (c) 2025-2026 Hugo José Pinto & Contributors
+"""
+
+import pytest
+from pathlib import Path
+
+from psion_sdk.testkit.benchmark import (
+    BenchmarkBaseline,
+    BenchmarkCase,
+    RuntimeBenchmark,
+    DATA_BASE,
+)
+
+
+pytestmark = pytest.mark.testkit
+
+BASELINE_PATH = Path(__file__).parent / "fp_benchmarks.json"
+
+# Operands and result (8 bytes each), string buffer
+A = DATA_BASE
+B = DATA_BASE + 8
+R = DATA_BASE + 16
+TEXT = DATA_BASE + 0x100
+
+
+def psion_float(digits: str, exponent: int, negative: bool = False) -> bytes:
+    """
+    Psion FP value as stored: 12 BCD mantissa digits (least significant
+    byte first), exponent, sign byte.
+    """
+    mantissa = bytes.fromhex(digits.ljust(12, "0"))
+    return mantissa[::-1] + bytes([exponent & 0xFF, 0x80 if negative else 0x00])
+
+
+def operands(a: int, b: int) -> tuple:
+    """prepare calls that load A and B from integers."""
+    return (("_fp_from_int", (A, a & 0xFFFF)), ("_fp_from_int", (B, b & 0xFFFF)))
+
+
+def fp_cases() -> list:
+    """Conversions, arithmetic and functions over a few operand sizes."""
+    cases = []
+    for n, expected in [(7, psion_float("7", 0)), (1234, psion_float("1234", 3)),
+                        (-30000, psion_float("3", 4, negative=True))]:
+        cases.append(BenchmarkCase(
+            f"fp_from_int/{n}", "_fp_from_int", args=(A, n & 0xFFFF),
+            expect_memory={A: expected},
+        ))
+    cases.append(BenchmarkCase(
+        "fp_from_str/3.14159", "_fp_from_str", args=(A, TEXT),
+        memory={TEXT: b"3.14159\x00"}, expect_memory={A: psion_float("314159", 0)},
+    ))
+
+    for a, b in [(7, 5), (1234, 56), (30000, -29999)]:
+        cases.append(BenchmarkCase(
+            f"fp_add/{a}+{b}", "_fp_add", args=(R, A, B), prepare=operands(a, b),
+        ))
+        cases.append(BenchmarkCase(
+            f"fp_mul/{a}*{b}", "_fp_mul", args=(R, A, B), prepare=operands(a, b),
+        ))
+    cases[-2].expect_memory = {R: psion_float("1", 0)}
+    cases.append(BenchmarkCase(
+        "fp_sub/1234-56", "_fp_sub", args=(R, A, B), prepare=operands(1234, 56),
+        expect_memory={R: psion_float("1178", 3)},
+    ))
+    cases.append(BenchmarkCase(
+        "fp_div/1234/56", "_fp_div", args=(R, A, B), prepare=operands(1234, 56),
+    ))
+    # Results not checked: fp_cmp tests the first accumulator byte, which
+    # is mantissa rather than sign/exponent, and fp_neg leaves n unchanged
+    cases.append(BenchmarkCase(
+        "fp_cmp/1234,56", "_fp_cmp", args=(A, B), prepare=operands(1234, 56),
+    ))
+    cases.append(BenchmarkCase(
+        "fp_neg/1234", "_fp_neg", args=(A,), prepare=operands(1234, 0),
+    ))
+
+    for func in ("sqrt", "sin", "exp", "ln"):
+        cases.append(BenchmarkCase(
+            f"fp_{func}/2", f"_fp_{func}", args=(R, A), prepare=operands(2, 0),
+        ))
+
+    cases.append(BenchmarkCase(
+        "fp_to_str/1234/2dp", "_fp_to_str", args=(TEXT, A, 2), prepare=operands(1234, 0),
+        expect_memory={TEXT: b"1234.00\x00"},
+    ))
+    return cases
+
+
+def test_fp_benchmarks():
+    """No FP routine is slower or larger than its baseline."""
+    bench = RuntimeBenchmark(("runtime.inc", "fpruntime.inc"), booted=True)
+    results = bench.run(fp_cases())
+
+    BenchmarkBaseline.check(results, BASELINE_PATH)